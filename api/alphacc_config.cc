@@ -1,4 +1,5 @@
 #include <fstream>
+#include <vector>
 
 #include "api/alphacc_config.h"
 #include "rtc_base/strings/json.h"
@@ -19,6 +20,34 @@ const AlphaCCConfig* GetAlphaCCConfig() {
   return config;
 }
 
+// Reads the optional "estimator" and "onnx" entries of |value|.
+static bool ParseEstimatorConfig(const Json::Value& value,
+                                 AlphaCCConfig::EstimatorConfig* estimator) {
+  Json::Value onnx;
+  std::string name;
+  if (::rtc::GetStringFromJsonObject(value, "estimator", &name)) {
+    if (name == "heuristic") {
+      estimator->estimator = AlphaCCConfig::Estimator::kHeuristic;
+    } else if (name != "pyinfer") {
+      return false;
+    }
+  }
+
+  if (::rtc::GetValueFromJsonObject(value, "onnx", &onnx)) {
+    ::rtc::GetStringFromJsonObject(onnx, "onnx_model_path",
+                                   &estimator->onnx_model_path);
+    std::string backend;
+    if (::rtc::GetStringFromJsonObject(onnx, "backend", &backend)) {
+      if (backend == "builtin") {
+        estimator->onnx_backend = AlphaCCConfig::OnnxBackend::kBuiltin;
+      } else if (backend != "onnxinfer") {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 bool ParseAlphaCCConfig(const std::string& file_path) {
   if (!config) {
     config = new AlphaCCConfig();
@@ -67,9 +96,18 @@ bool ParseAlphaCCConfig(const std::string& file_path) {
 
   RETURN_ON_FAIL(
       GetInt(top, "bwe_feedback_duration", &config->bwe_feedback_duration_ms));
-
-  if (GetValue(top, "onnx", &second)) {
-    GetString(second, "onnx_model_path", &config->onnx_model_path);
+  // Optional.
+  GetBool(top, "ecn", &config->ecn);
+  RETURN_ON_FAIL(ParseEstimatorConfig(top, &config->bwe_estimator));
+  if (GetValue(top, "shadow_estimators", &second)) {
+    std::vector<Json::Value> shadow_estimators;
+    RETURN_ON_FAIL(::rtc::JsonArrayToValueVector(second, &shadow_estimators));
+    config->shadow_estimators.clear();
+    for (const Json::Value& shadow_estimator : shadow_estimators) {
+      config->shadow_estimators.emplace_back();
+      RETURN_ON_FAIL(ParseEstimatorConfig(shadow_estimator,
+                                          &config->shadow_estimators.back()));
+    }
     second.clear();
   }
 
@@ -12,6 +12,7 @@
 #define API_ALPHACC_CONFIG_H_
 
 #include <string>
+#include <vector>
 
 namespace webrtc {
 
@@ -42,7 +43,24 @@ struct AlphaCCConfig {
   int listening_port = 0;
 
   int bwe_feedback_duration_ms = 0;
-  std::string onnx_model_path;
+  // Send media ECN-capable and report CE marks to the bandwidth estimator.
+  bool ecn = false;
+  // Runtime for the ONNX model: the onnxinfer library (Linux only) or the
+  // built-in engine in modules/remote_bitrate_estimator/bwe_nn.
+  enum class OnnxBackend { kOnnxInfer, kBuiltin };
+  // Estimator used without an ONNX model: the Python estimator of PyInfer or
+  // the REMB heuristics in modules/remote_bitrate_estimator.
+  enum class Estimator { kPyInfer, kHeuristic };
+  struct EstimatorConfig {
+    std::string onnx_model_path;
+    OnnxBackend onnx_backend = OnnxBackend::kOnnxInfer;
+    Estimator estimator = Estimator::kPyInfer;
+  };
+  // The receive side estimator whose estimates are sent to the sender.
+  EstimatorConfig bwe_estimator;
+  // Estimators fed the same packets whose estimates are only logged, see
+  // modules/remote_bitrate_estimator/shadow_estimators.h.
+  std::vector<EstimatorConfig> shadow_estimators;
 
   enum class VideoSourceOption {
     kVideoDisabled,
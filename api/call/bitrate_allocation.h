@@ -28,6 +28,9 @@ struct BitrateAllocationUpdate {
   // should be used to change encoder configuration when the cost of change is
   // high.
   DataRate stable_target_bitrate = DataRate::Zero();
+  // The link capacity estimate the allocation is made from, before it's shared
+  // between the streams. Zero when unknown.
+  DataRate network_estimate = DataRate::Zero();
   // Predicted packet loss ratio.
   double packet_loss_ratio = 0;
   // Predicted round trip time.
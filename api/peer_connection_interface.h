@@ -305,6 +305,9 @@ class RTC_EXPORT PeerConnectionInterface : public rtc::RefCountInterface {
     bool dscp() const { return media_config.enable_dscp; }
     void set_dscp(bool enable) { media_config.enable_dscp = enable; }
 
+    bool ecn() const { return media_config.enable_ecn; }
+    void set_ecn(bool enable) { media_config.enable_ecn = enable; }
+
     bool cpu_adaptation() const {
       return media_config.video.enable_cpu_adaptation;
     }
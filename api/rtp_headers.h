@@ -119,6 +119,9 @@ struct RTPHeaderExtension {
   bool hasAbsoluteSendTime;
   uint32_t absoluteSendTime;
   absl::optional<AbsoluteCaptureTime> absolute_capture_time;
+  // Sender's time in microseconds when the packet was sent, see
+  // http://www.webrtc.org/experiments/rtp-hdrext/transport-send-time
+  absl::optional<int64_t> transport_send_time_us;
   bool hasTransportSequenceNumber;
   uint16_t transportSequenceNumber;
   absl::optional<FeedbackRequest> feedback_request;
@@ -101,6 +101,7 @@ constexpr char RtpExtension::kEncryptHeaderExtensionsUri[];
 constexpr char RtpExtension::kAudioLevelUri[];
 constexpr char RtpExtension::kTimestampOffsetUri[];
 constexpr char RtpExtension::kAbsSendTimeUri[];
+constexpr char RtpExtension::kTransportSendTimeUri[];
 constexpr char RtpExtension::kAbsoluteCaptureTimeUri[];
 constexpr char RtpExtension::kVideoRotationUri[];
 constexpr char RtpExtension::kVideoContentTypeUri[];
@@ -125,6 +126,7 @@ constexpr int RtpExtension::kOneByteHeaderExtensionMaxValueSize;
 bool RtpExtension::IsSupportedForAudio(absl::string_view uri) {
   return uri == webrtc::RtpExtension::kAudioLevelUri ||
          uri == webrtc::RtpExtension::kAbsSendTimeUri ||
+         uri == webrtc::RtpExtension::kTransportSendTimeUri ||
          uri == webrtc::RtpExtension::kAbsoluteCaptureTimeUri ||
          uri == webrtc::RtpExtension::kTransportSequenceNumberUri ||
          uri == webrtc::RtpExtension::kTransportSequenceNumberV2Uri ||
@@ -136,6 +138,7 @@ bool RtpExtension::IsSupportedForAudio(absl::string_view uri) {
 bool RtpExtension::IsSupportedForVideo(absl::string_view uri) {
   return uri == webrtc::RtpExtension::kTimestampOffsetUri ||
          uri == webrtc::RtpExtension::kAbsSendTimeUri ||
+         uri == webrtc::RtpExtension::kTransportSendTimeUri ||
          uri == webrtc::RtpExtension::kAbsoluteCaptureTimeUri ||
          uri == webrtc::RtpExtension::kVideoRotationUri ||
          uri == webrtc::RtpExtension::kTransportSequenceNumberUri ||
@@ -163,6 +166,7 @@ bool RtpExtension::IsEncryptionSupported(absl::string_view uri) {
          // encrypted (which can't be done by Chromium).
          uri == webrtc::RtpExtension::kAbsSendTimeUri ||
 #endif
+         uri == webrtc::RtpExtension::kTransportSendTimeUri ||
          uri == webrtc::RtpExtension::kAbsoluteCaptureTimeUri ||
          uri == webrtc::RtpExtension::kVideoRotationUri ||
          uri == webrtc::RtpExtension::kTransportSequenceNumberUri ||
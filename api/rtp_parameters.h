@@ -296,6 +296,11 @@ struct RTC_EXPORT RtpExtension {
   static constexpr char kAbsSendTimeUri[] =
       "http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time";
 
+  // Header extension for the send time of a packet in microseconds, written
+  // when the packet is handed to the transport.
+  static constexpr char kTransportSendTimeUri[] =
+      "http://www.webrtc.org/experiments/rtp-hdrext/transport-send-time";
+
   // Header extension for absolute capture time, see url for details:
   // http://www.webrtc.org/experiments/rtp-hdrext/abs-capture-time
   static constexpr char kAbsoluteCaptureTimeUri[] =
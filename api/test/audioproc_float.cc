@@ -34,5 +34,13 @@ int AudioprocFloat(std::unique_ptr<AudioProcessingBuilder> ap_builder,
                             processed_capture_samples);
 }
 
+int AudioprocFloat(
+    std::function<std::unique_ptr<AudioProcessingBuilder>()>
+        ap_builder_factory,
+    int argc,
+    char* argv[]) {
+  return AudioprocFloatImpl(std::move(ap_builder_factory), argc, argv);
+}
+
 }  // namespace test
 }  // namespace webrtc
@@ -11,6 +11,7 @@
 #ifndef API_TEST_AUDIOPROC_FLOAT_H_
 #define API_TEST_AUDIOPROC_FLOAT_H_
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -49,6 +50,17 @@ int AudioprocFloat(std::unique_ptr<AudioProcessingBuilder> ap_builder,
                    char* argv[],
                    absl::string_view input_aecdump,
                    std::vector<float>* processed_capture_samples);
+
+// Interface for the audio processing simulation utility, which is similar to
+// the first one above, but which creates the AudioProcessingBuilder with
+// |ap_builder_factory|. This is needed to run a batch of simulations, listed
+// in the file given by the '--batch_manifest' flag, in parallel: each of them
+// gets its own AudioProcessing instance.
+int AudioprocFloat(
+    std::function<std::unique_ptr<AudioProcessingBuilder>()>
+        ap_builder_factory,
+    int argc,
+    char* argv[]);
 }  // namespace test
 }  // namespace webrtc
 
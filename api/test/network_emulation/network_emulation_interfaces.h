@@ -16,6 +16,7 @@
 #include "api/units/timestamp.h"
 #include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/ip_address.h"
+#include "rtc_base/network/ecn_marking.h"
 #include "rtc_base/socket_address.h"
 
 namespace webrtc {
@@ -45,6 +46,8 @@ struct EmulatedIpPacket {
   rtc::CopyOnWriteBuffer data;
   uint16_t headers_size;
   Timestamp arrival_time;
+  // ECN codepoint in the IP header.
+  rtc::EcnMarking ecn = rtc::EcnMarking::kNotEct;
 };
 
 // Interface for handling IP packets from an emulated network. This is used with
@@ -97,10 +100,12 @@ class EmulatedEndpoint : public EmulatedNetworkReceiverInterface {
   // socket.
   // |to| will be used for routing verification and picking right socket by port
   // on destination endpoint.
-  virtual void SendPacket(const rtc::SocketAddress& from,
-                          const rtc::SocketAddress& to,
-                          rtc::CopyOnWriteBuffer packet_data,
-                          uint16_t application_overhead = 0) = 0;
+  virtual void SendPacket(
+      const rtc::SocketAddress& from,
+      const rtc::SocketAddress& to,
+      rtc::CopyOnWriteBuffer packet_data,
+      uint16_t application_overhead = 0,
+      rtc::EcnMarking ecn = rtc::EcnMarking::kNotEct) = 0;
 
   // Binds receiver to this endpoint to send and receive data.
   // |desired_port| is a port that should be used. If it is equal to 0,
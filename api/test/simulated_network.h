@@ -20,6 +20,7 @@
 
 #include "absl/types/optional.h"
 #include "rtc_base/critical_section.h"
+#include "rtc_base/network/ecn_marking.h"
 #include "rtc_base/random.h"
 #include "rtc_base/thread_annotations.h"
 
@@ -27,20 +28,36 @@ namespace webrtc {
 
 struct PacketInFlightInfo {
   PacketInFlightInfo(size_t size, int64_t send_time_us, uint64_t packet_id)
-      : size(size), send_time_us(send_time_us), packet_id(packet_id) {}
+      : PacketInFlightInfo(size,
+                           send_time_us,
+                           packet_id,
+                           rtc::EcnMarking::kNotEct) {}
+  PacketInFlightInfo(size_t size,
+                     int64_t send_time_us,
+                     uint64_t packet_id,
+                     rtc::EcnMarking ecn)
+      : size(size),
+        send_time_us(send_time_us),
+        packet_id(packet_id),
+        ecn(ecn) {}
 
   size_t size;
   int64_t send_time_us;
   // Unique identifier for the packet in relation to other packets in flight.
   uint64_t packet_id;
+  // ECN codepoint of the packet, which the network may change to kCe.
+  rtc::EcnMarking ecn;
 };
 
 struct PacketDeliveryInfo {
   static constexpr int kNotReceived = -1;
   PacketDeliveryInfo(PacketInFlightInfo source, int64_t receive_time_us)
-      : receive_time_us(receive_time_us), packet_id(source.packet_id) {}
+      : receive_time_us(receive_time_us),
+        packet_id(source.packet_id),
+        ecn(source.ecn) {}
   int64_t receive_time_us;
   uint64_t packet_id;
+  rtc::EcnMarking ecn;
 };
 
 // BuiltInNetworkBehaviorConfig is a built-in network behavior configuration
@@ -66,6 +83,9 @@ struct BuiltInNetworkBehaviorConfig {
   int packet_overhead = 0;
   // Enable CoDel active queue management.
   bool codel_active_queue_management = false;
+  // If positive, ECN-capable packets that were queued for longer than this
+  // before leaving the capacity link are marked Congestion Experienced.
+  int ecn_marking_threshold_ms = 0;
 };
 
 class NetworkBehaviorInterface {
@@ -20,6 +20,7 @@
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
 #include "rtc_base/deprecation.h"
+#include "rtc_base/network/ecn_marking.h"
 
 namespace webrtc {
 
@@ -161,6 +162,9 @@ struct PacketResult {
 
   SentPacket sent_packet;
   Timestamp receive_time = Timestamp::PlusInfinity();
+  // ECN codepoint the packet was received with. Only reported by RFC 8888
+  // congestion control feedback.
+  rtc::EcnMarking ecn = rtc::EcnMarking::kNotEct;
 };
 
 struct TransportPacketsFeedback {
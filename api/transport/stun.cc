@@ -62,6 +62,32 @@ const char EMPTY_TRANSACTION_ID[] = "0000000000000000";
 const uint32_t STUN_FINGERPRINT_XOR_VALUE = 0x5354554E;
 const int SERVER_NOT_REACHABLE_ERROR = 701;
 
+// StunMessageIntegrityKey
+
+StunMessageIntegrityKey::StunMessageIntegrityKey() = default;
+
+StunMessageIntegrityKey::StunMessageIntegrityKey(absl::string_view password)
+    : password_(password) {}
+
+StunMessageIntegrityKey::~StunMessageIntegrityKey() = default;
+
+void StunMessageIntegrityKey::SetPassword(absl::string_view password) {
+  if (password == password_) {
+    return;
+  }
+  password_ = std::string(password);
+  hmac_.reset();
+}
+
+rtc::MessageDigest* StunMessageIntegrityKey::hmac() {
+  if (!hmac_) {
+    hmac_.reset(rtc::MessageDigestFactory::CreateHmac(
+        rtc::DIGEST_SHA_1, password_.data(), password_.size()));
+    RTC_DCHECK(hmac_);
+  }
+  return hmac_.get();
+}
+
 // StunMessage
 
 StunMessage::StunMessage()
@@ -204,17 +230,31 @@ const StunUInt16ListAttribute* StunMessage::GetUnknownAttributes() const {
 bool StunMessage::ValidateMessageIntegrity(const char* data,
                                            size_t size,
                                            const std::string& password) {
+  StunMessageIntegrityKey key(password);
+  return ValidateMessageIntegrity(data, size, &key);
+}
+
+bool StunMessage::ValidateMessageIntegrity32(const char* data,
+                                             size_t size,
+                                             const std::string& password) {
+  StunMessageIntegrityKey key(password);
+  return ValidateMessageIntegrity32(data, size, &key);
+}
+
+bool StunMessage::ValidateMessageIntegrity(const char* data,
+                                           size_t size,
+                                           StunMessageIntegrityKey* key) {
   return ValidateMessageIntegrityOfType(STUN_ATTR_MESSAGE_INTEGRITY,
                                         kStunMessageIntegritySize, data, size,
-                                        password);
+                                        key->hmac());
 }
 
 bool StunMessage::ValidateMessageIntegrity32(const char* data,
                                              size_t size,
-                                             const std::string& password) {
+                                             StunMessageIntegrityKey* key) {
   return ValidateMessageIntegrityOfType(STUN_ATTR_GOOG_MESSAGE_INTEGRITY_32,
                                         kStunMessageIntegrity32Size, data, size,
-                                        password);
+                                        key->hmac());
 }
 
 // Verifies a STUN message has a valid MESSAGE-INTEGRITY attribute, using the
@@ -223,7 +263,7 @@ bool StunMessage::ValidateMessageIntegrityOfType(int mi_attr_type,
                                                  size_t mi_attr_size,
                                                  const char* data,
                                                  size_t size,
-                                                 const std::string& password) {
+                                                 rtc::MessageDigest* hmac) {
   RTC_DCHECK(mi_attr_size <= kStunMessageIntegritySize);
 
   // Verifying the size of the message.
@@ -268,61 +308,64 @@ bool StunMessage::ValidateMessageIntegrityOfType(int mi_attr_type,
     return false;
   }
 
-  // Getting length of the message to calculate Message Integrity.
+  // The HMAC covers the message up to the Message Integrity attribute, with
+  // the length in the header adjusted as if the attribute was the last one.
+  // Rather than patching a copy of the message, the adjusted length is hashed
+  // in place of the original one.
+  //      0                   1                   2                   3
+  //      0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+  //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  //     |0 0|     STUN Message Type     |         Message Length        |
+  //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
   size_t mi_pos = current_pos;
-  std::unique_ptr<char[]> temp_data(new char[current_pos]);
-  memcpy(temp_data.get(), data, current_pos);
-  if (size > mi_pos + kStunAttributeHeaderSize + mi_attr_size) {
-    // Stun message has other attributes after message integrity.
-    // Adjust the length parameter in stun message to calculate HMAC.
-    size_t extra_offset =
-        size - (mi_pos + kStunAttributeHeaderSize + mi_attr_size);
-    size_t new_adjusted_len = size - extra_offset - kStunHeaderSize;
-
-    // Writing new length of the STUN message @ Message Length in temp buffer.
-    //      0                   1                   2                   3
-    //      0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
-    //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-    //     |0 0|     STUN Message Type     |         Message Length        |
-    //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-    rtc::SetBE16(temp_data.get() + 2, static_cast<uint16_t>(new_adjusted_len));
-  }
-
-  char hmac[kStunMessageIntegritySize];
-  size_t ret =
-      rtc::ComputeHmac(rtc::DIGEST_SHA_1, password.c_str(), password.size(),
-                       temp_data.get(), mi_pos, hmac, sizeof(hmac));
-  RTC_DCHECK(ret == sizeof(hmac));
-  if (ret != sizeof(hmac)) {
+  size_t adjusted_len =
+      mi_pos + kStunAttributeHeaderSize + mi_attr_size - kStunHeaderSize;
+  char adjusted_len_data[2];
+  rtc::SetBE16(adjusted_len_data, static_cast<uint16_t>(adjusted_len));
+  hmac->Update(data, 2);
+  hmac->Update(adjusted_len_data, sizeof(adjusted_len_data));
+  hmac->Update(data + 4, mi_pos - 4);
+
+  char hmac_value[kStunMessageIntegritySize];
+  size_t ret = hmac->Finish(hmac_value, sizeof(hmac_value));
+  RTC_DCHECK(ret == sizeof(hmac_value));
+  if (ret != sizeof(hmac_value)) {
     return false;
   }
 
   // Comparing the calculated HMAC with the one present in the message.
-  return memcmp(data + current_pos + kStunAttributeHeaderSize, hmac,
+  return memcmp(data + current_pos + kStunAttributeHeaderSize, hmac_value,
                 mi_attr_size) == 0;
 }
 
 bool StunMessage::AddMessageIntegrity(const std::string& password) {
-  return AddMessageIntegrityOfType(STUN_ATTR_MESSAGE_INTEGRITY,
-                                   kStunMessageIntegritySize, password.c_str(),
-                                   password.size());
+  StunMessageIntegrityKey key(password);
+  return AddMessageIntegrity(&key);
 }
 
 bool StunMessage::AddMessageIntegrity(const char* key, size_t keylen) {
+  StunMessageIntegrityKey integrity_key(absl::string_view(key, keylen));
+  return AddMessageIntegrity(&integrity_key);
+}
+
+bool StunMessage::AddMessageIntegrity(StunMessageIntegrityKey* key) {
   return AddMessageIntegrityOfType(STUN_ATTR_MESSAGE_INTEGRITY,
-                                   kStunMessageIntegritySize, key, keylen);
+                                   kStunMessageIntegritySize, key->hmac());
 }
 
 bool StunMessage::AddMessageIntegrity32(absl::string_view password) {
+  StunMessageIntegrityKey key(password);
+  return AddMessageIntegrity32(&key);
+}
+
+bool StunMessage::AddMessageIntegrity32(StunMessageIntegrityKey* key) {
   return AddMessageIntegrityOfType(STUN_ATTR_GOOG_MESSAGE_INTEGRITY_32,
-                                   kStunMessageIntegrity32Size, password.data(),
-                                   password.length());
+                                   kStunMessageIntegrity32Size, key->hmac());
 }
 
 bool StunMessage::AddMessageIntegrityOfType(int attr_type,
                                             size_t attr_size,
-                                            const char* key,
-                                            size_t keylen) {
+                                            rtc::MessageDigest* hmac) {
   // Add the attribute with a dummy value. Since this is a known attribute, it
   // can't fail.
   RTC_DCHECK(attr_size <= kStunMessageIntegritySize);
@@ -338,18 +381,18 @@ bool StunMessage::AddMessageIntegrityOfType(int attr_type,
 
   int msg_len_for_hmac = static_cast<int>(
       buf.Length() - kStunAttributeHeaderSize - msg_integrity_attr->length());
-  char hmac[kStunMessageIntegritySize];
-  size_t ret = rtc::ComputeHmac(rtc::DIGEST_SHA_1, key, keylen, buf.Data(),
-                                msg_len_for_hmac, hmac, sizeof(hmac));
-  RTC_DCHECK(ret == sizeof(hmac));
-  if (ret != sizeof(hmac)) {
+  char hmac_value[kStunMessageIntegritySize];
+  size_t ret = rtc::ComputeDigest(hmac, buf.Data(), msg_len_for_hmac,
+                                  hmac_value, sizeof(hmac_value));
+  RTC_DCHECK(ret == sizeof(hmac_value));
+  if (ret != sizeof(hmac_value)) {
     RTC_LOG(LS_ERROR) << "HMAC computation failed. Message-Integrity "
                          "has dummy value.";
     return false;
   }
 
   // Insert correct HMAC into the attribute.
-  msg_integrity_attr->CopyBytes(hmac, attr_size);
+  msg_integrity_attr->CopyBytes(hmac_value, attr_size);
   return true;
 }
 
@@ -23,6 +23,7 @@
 
 #include "rtc_base/byte_buffer.h"
 #include "rtc_base/ip_address.h"
+#include "rtc_base/message_digest.h"
 #include "rtc_base/socket_address.h"
 
 namespace cricket {
@@ -139,6 +140,29 @@ class StunUInt32Attribute;
 class StunUInt64Attribute;
 class StunXorAddressAttribute;
 
+// Holds the HMAC-SHA1 key schedule of a STUN password, so that computing the
+// MESSAGE-INTEGRITY of many messages with the same password, as the checks and
+// responses of an ICE connection do, hashes the HMAC key pads only once.
+class StunMessageIntegrityKey {
+ public:
+  StunMessageIntegrityKey();
+  explicit StunMessageIntegrityKey(absl::string_view password);
+  ~StunMessageIntegrityKey();
+
+  const std::string& password() const { return password_; }
+  // The key schedule is only recomputed if |password| differs from the
+  // current password.
+  void SetPassword(absl::string_view password);
+
+ private:
+  friend class StunMessage;
+
+  rtc::MessageDigest* hmac();
+
+  std::string password_;
+  std::unique_ptr<rtc::MessageDigest> hmac_;
+};
+
 // Records a complete STUN/TURN message.  Each message consists of a type and
 // any number of attributes.  Each attribute is parsed into an instance of an
 // appropriate class (see above).  The Get* methods will return instances of
@@ -199,14 +223,22 @@ class StunMessage {
   static bool ValidateMessageIntegrity32(const char* data,
                                          size_t size,
                                          const std::string& password);
+  static bool ValidateMessageIntegrity(const char* data,
+                                       size_t size,
+                                       StunMessageIntegrityKey* key);
+  static bool ValidateMessageIntegrity32(const char* data,
+                                         size_t size,
+                                         StunMessageIntegrityKey* key);
 
   // Adds a MESSAGE-INTEGRITY attribute that is valid for the current message.
   bool AddMessageIntegrity(const std::string& password);
   bool AddMessageIntegrity(const char* key, size_t keylen);
+  bool AddMessageIntegrity(StunMessageIntegrityKey* key);
 
   // Adds a STUN_ATTR_GOOG_MESSAGE_INTEGRITY_32 attribute that is valid for the
   // current message.
   bool AddMessageIntegrity32(absl::string_view password);
+  bool AddMessageIntegrity32(StunMessageIntegrityKey* key);
 
   // Verify that a buffer has stun magic cookie and one of the specified
   // methods. Note that it does not check for the existance of FINGERPRINT.
@@ -255,13 +287,12 @@ class StunMessage {
   static bool IsValidTransactionId(const std::string& transaction_id);
   bool AddMessageIntegrityOfType(int mi_attr_type,
                                  size_t mi_attr_size,
-                                 const char* key,
-                                 size_t keylen);
+                                 rtc::MessageDigest* hmac);
   static bool ValidateMessageIntegrityOfType(int mi_attr_type,
                                              size_t mi_attr_size,
                                              const char* data,
                                              size_t size,
-                                             const std::string& password);
+                                             rtc::MessageDigest* hmac);
 
   uint16_t type_;
   uint16_t length_;
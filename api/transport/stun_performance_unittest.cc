@@ -0,0 +1,104 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "api/transport/stun.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace cricket {
+namespace {
+
+constexpr int kNumChecks = 100000;
+const char kPassword[] = "TESTICEPWD00000000000000";
+
+// Returns a STUN binding request with the attributes of an ICE connectivity
+// check.
+std::string CreateConnectivityCheck() {
+  IceMessage request;
+  request.SetType(STUN_BINDING_REQUEST);
+  request.SetTransactionID("0123456789ab");
+  request.AddAttribute(
+      std::make_unique<StunByteStringAttribute>(STUN_ATTR_USERNAME, "U:R"));
+  request.AddAttribute(
+      std::make_unique<StunUInt32Attribute>(STUN_ATTR_PRIORITY, 0x6e001eff));
+  request.AddAttribute(std::make_unique<StunUInt64Attribute>(
+      STUN_ATTR_ICE_CONTROLLING, 0x0123456789abcdef));
+  request.AddAttribute(
+      std::make_unique<StunByteStringAttribute>(STUN_ATTR_USE_CANDIDATE));
+  EXPECT_TRUE(request.AddMessageIntegrity(kPassword));
+  EXPECT_TRUE(request.AddFingerprint());
+  rtc::ByteBufferWriter buf;
+  EXPECT_TRUE(request.Write(&buf));
+  return std::string(buf.Data(), buf.Length());
+}
+
+// Handles a check the way Port and Connection do: validates and parses the
+// request, and serializes a response with MESSAGE-INTEGRITY and FINGERPRINT.
+// Uses |key| if it is not null, and the password otherwise.
+void HandleCheck(const std::string& check, StunMessageIntegrityKey* key) {
+  const bool valid =
+      StunMessage::ValidateFingerprint(check.data(), check.size()) &&
+      (key ? StunMessage::ValidateMessageIntegrity(check.data(), check.size(),
+                                                   key)
+           : StunMessage::ValidateMessageIntegrity(check.data(), check.size(),
+                                                   kPassword));
+  IceMessage request;
+  rtc::ByteBufferReader reader(check.data(), check.size());
+  if (!valid || !request.Read(&reader)) {
+    ADD_FAILURE() << "Invalid check";
+    return;
+  }
+
+  StunMessage response;
+  response.SetType(STUN_BINDING_RESPONSE);
+  response.SetTransactionID(request.transaction_id());
+  auto mapped_address =
+      StunAttribute::CreateXorAddress(STUN_ATTR_XOR_MAPPED_ADDRESS);
+  mapped_address->SetAddress(rtc::SocketAddress("192.168.1.2", 5000));
+  response.AddAttribute(std::move(mapped_address));
+  if (key) {
+    response.AddMessageIntegrity(key);
+  } else {
+    response.AddMessageIntegrity(kPassword);
+  }
+  response.AddFingerprint();
+  rtc::ByteBufferWriter writer;
+  response.Write(&writer);
+}
+
+// Returns the number of checks handled per second.
+double ChecksPerSecond(StunMessageIntegrityKey* key) {
+  const std::string check = CreateConnectivityCheck();
+  const int64_t start_time_nanos = rtc::TimeNanos();
+  for (int i = 0; i < kNumChecks; ++i) {
+    HandleCheck(check, key);
+  }
+  return kNumChecks * static_cast<double>(rtc::kNumNanosecsPerSec) /
+         (rtc::TimeNanos() - start_time_nanos);
+}
+
+}  // namespace
+
+TEST(StunPerformanceTest, ConnectivityChecks) {
+  webrtc::test::PrintResult("stun_checks", "_per_second", "password",
+                            ChecksPerSecond(nullptr), "checks/s", false);
+  StunMessageIntegrityKey key(kPassword);
+  webrtc::test::PrintResult("stun_checks", "_per_second", "integrity_key",
+                            ChecksPerSecond(&key), "checks/s", false);
+}
+
+}  // namespace cricket
@@ -1314,6 +1314,45 @@ TEST_F(StunTest, AddMessageIntegrity) {
       kRfc5769SampleMsgPassword));
 }
 
+// Validate that a StunMessageIntegrityKey gives the same results as the
+// password, when it is reused for several messages and when the password
+// changes.
+TEST_F(StunTest, MessageIntegrityKey) {
+  StunMessageIntegrityKey key(kRfc5769SampleMsgPassword);
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_TRUE(StunMessage::ValidateMessageIntegrity(
+        reinterpret_cast<const char*>(kRfc5769SampleRequest),
+        sizeof(kRfc5769SampleRequest), &key));
+    EXPECT_TRUE(StunMessage::ValidateMessageIntegrity(
+        reinterpret_cast<const char*>(kRfc5769SampleResponse),
+        sizeof(kRfc5769SampleResponse), &key));
+    EXPECT_FALSE(StunMessage::ValidateMessageIntegrity(
+        reinterpret_cast<const char*>(kStunMessageWithBadHmacAtEnd),
+        sizeof(kStunMessageWithBadHmacAtEnd), &key));
+  }
+
+  IceMessage msg;
+  rtc::ByteBufferReader buf(
+      reinterpret_cast<const char*>(kRfc5769SampleRequestWithoutMI),
+      sizeof(kRfc5769SampleRequestWithoutMI));
+  EXPECT_TRUE(msg.Read(&buf));
+  EXPECT_TRUE(msg.AddMessageIntegrity(&key));
+  const StunByteStringAttribute* mi_attr =
+      msg.GetByteString(STUN_ATTR_MESSAGE_INTEGRITY);
+  EXPECT_EQ(
+      0, memcmp(mi_attr->bytes(), kCalculatedHmac1, sizeof(kCalculatedHmac1)));
+
+  key.SetPassword("InvalidPassword");
+  EXPECT_EQ("InvalidPassword", key.password());
+  EXPECT_FALSE(StunMessage::ValidateMessageIntegrity(
+      reinterpret_cast<const char*>(kRfc5769SampleRequest),
+      sizeof(kRfc5769SampleRequest), &key));
+  key.SetPassword(kRfc5769SampleMsgPassword);
+  EXPECT_TRUE(StunMessage::ValidateMessageIntegrity(
+      reinterpret_cast<const char*>(kRfc5769SampleRequest),
+      sizeof(kRfc5769SampleRequest), &key));
+}
+
 // Check our STUN message validation code against the RFC5769 test messages.
 TEST_F(StunTest, ValidateMessageIntegrity32) {
   // Try the messages from RFC 5769.
@@ -0,0 +1,232 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/video/frame_processing_pool.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+
+namespace {
+
+std::atomic<FrameProcessingPool*> g_default_pool_for_testing{nullptr};
+
+int GreatestCommonDivisor(int a, int b) {
+  while (b != 0) {
+    const int remainder = a % b;
+    a = b;
+    b = remainder;
+  }
+  return a;
+}
+
+class FrameProcessingPoolImpl : public FrameProcessingPool {
+ public:
+  FrameProcessingPoolImpl(int num_threads, int min_parallel_pixels);
+  ~FrameProcessingPoolImpl() override;
+
+  int num_threads() const override { return num_threads_; }
+
+  void ProcessRows(int num_pixels,
+                   int num_rows,
+                   int row_alignment,
+                   rtc::FunctionView<void(int, int)> process_rows) override;
+
+ private:
+  struct Worker {
+    FrameProcessingPoolImpl* pool;
+    rtc::Event wake_up;
+    std::unique_ptr<rtc::PlatformThread> thread;
+  };
+
+  static void RunWorker(void* obj);
+  void WorkerLoop(Worker* worker);
+  // Processes bands of the current frame until all of them are taken.
+  void ProcessBands();
+
+  const int num_threads_;
+  const int min_parallel_pixels_;
+  // Set while a frame is split over the workers. Other frames are processed
+  // on their calling thread in the meantime.
+  std::atomic<bool> busy_{false};
+  std::atomic<bool> quit_{false};
+  // Only accessed by the thread that set |busy_|.
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  // The current frame. Written before the workers are woken up, and not
+  // touched again until all of them are done.
+  rtc::FunctionView<void(int, int)>* process_rows_ = nullptr;
+  int num_rows_ = 0;
+  int band_rows_ = 0;
+  int num_bands_ = 0;
+  std::atomic<int> next_band_{0};
+  std::atomic<int> num_active_workers_{0};
+  rtc::Event workers_done_;
+};
+
+FrameProcessingPoolImpl::FrameProcessingPoolImpl(int num_threads,
+                                                 int min_parallel_pixels)
+    : num_threads_(num_threads), min_parallel_pixels_(min_parallel_pixels) {
+  RTC_DCHECK_GE(num_threads, 1);
+  RTC_DCHECK_GE(min_parallel_pixels, 0);
+}
+
+FrameProcessingPoolImpl::~FrameProcessingPoolImpl() {
+  RTC_DCHECK(!busy_.load());
+  quit_.store(true);
+  for (auto& worker : workers_) {
+    worker->wake_up.Set();
+    worker->thread->Stop();
+  }
+}
+
+void FrameProcessingPoolImpl::ProcessRows(
+    int num_pixels,
+    int num_rows,
+    int row_alignment,
+    rtc::FunctionView<void(int, int)> process_rows) {
+  RTC_DCHECK_GT(row_alignment, 0);
+  const int num_units = (num_rows + row_alignment - 1) / row_alignment;
+  const int num_bands = std::min(num_threads_, num_units);
+  bool idle = false;
+  if (num_bands < 2 || num_pixels < min_parallel_pixels_ ||
+      !busy_.compare_exchange_strong(idle, true)) {
+    process_rows(0, num_rows);
+    return;
+  }
+
+  // Start the workers with the first frame that is split.
+  while (static_cast<int>(workers_.size()) < num_threads_ - 1) {
+    auto worker = std::make_unique<Worker>();
+    worker->pool = this;
+    worker->thread = std::make_unique<rtc::PlatformThread>(
+        &FrameProcessingPoolImpl::RunWorker, worker.get(), "FrameProcessing");
+    worker->thread->Start();
+    workers_.push_back(std::move(worker));
+  }
+
+  process_rows_ = &process_rows;
+  num_rows_ = num_rows;
+  band_rows_ = (num_units + num_bands - 1) / num_bands * row_alignment;
+  num_bands_ = num_bands;
+  next_band_.store(0);
+  num_active_workers_.store(num_bands - 1);
+  for (int i = 0; i < num_bands - 1; ++i) {
+    workers_[i]->wake_up.Set();
+  }
+  ProcessBands();
+  // Wait until the workers are done with the frame, not only its bands, so
+  // that none of them reads the state of this frame after returning.
+  workers_done_.Wait(rtc::Event::kForever);
+  process_rows_ = nullptr;
+  busy_.store(false);
+}
+
+// static
+void FrameProcessingPoolImpl::RunWorker(void* obj) {
+  Worker* worker = static_cast<Worker*>(obj);
+  worker->pool->WorkerLoop(worker);
+}
+
+void FrameProcessingPoolImpl::WorkerLoop(Worker* worker) {
+  while (true) {
+    worker->wake_up.Wait(rtc::Event::kForever);
+    if (quit_.load()) {
+      return;
+    }
+    ProcessBands();
+    if (num_active_workers_.fetch_sub(1) == 1) {
+      workers_done_.Set();
+    }
+  }
+}
+
+void FrameProcessingPoolImpl::ProcessBands() {
+  for (int band = next_band_.fetch_add(1); band < num_bands_;
+       band = next_band_.fetch_add(1)) {
+    const int first_row = band * band_rows_;
+    const int num_rows = std::min(band_rows_, num_rows_ - first_row);
+    if (num_rows > 0) {
+      (*process_rows_)(first_row, num_rows);
+    }
+  }
+}
+
+}  // namespace
+
+// static
+FrameProcessingPool* FrameProcessingPool::Default() {
+  FrameProcessingPool* pool_for_testing = g_default_pool_for_testing.load();
+  if (pool_for_testing) {
+    return pool_for_testing;
+  }
+  static FrameProcessingPool* const default_pool =
+      Create(std::min(static_cast<int>(CpuInfo::DetectNumberOfCores()),
+                      kMaxDefaultThreads),
+             kDefaultMinParallelPixels)
+          .release();
+  return default_pool;
+}
+
+// static
+void FrameProcessingPool::SetDefaultForTesting(FrameProcessingPool* pool) {
+  g_default_pool_for_testing.store(pool);
+}
+
+// static
+std::unique_ptr<FrameProcessingPool> FrameProcessingPool::Create(
+    int num_threads,
+    int min_parallel_pixels) {
+  return std::make_unique<FrameProcessingPoolImpl>(
+      std::max(num_threads, 1), min_parallel_pixels);
+}
+
+void FrameProcessingPool::ProcessScaledRows(
+    int num_pixels,
+    int src_rows,
+    int dst_rows,
+    rtc::FunctionView<void(int, int, int, int)> process_bands) {
+  if (dst_rows > 0 && dst_rows <= src_rows && src_rows % 2 == 0 &&
+      dst_rows % 2 == 0) {
+    // |dst_unit| rows scale from exactly |src_unit| rows, and both are even,
+    // so bands made of whole units also cover whole chroma rows.
+    const int common_divisor =
+        GreatestCommonDivisor(src_rows / 2, dst_rows / 2);
+    const int src_unit = src_rows / common_divisor;
+    const int dst_unit = dst_rows / common_divisor;
+    // libyuv steps through the source rows in 16.16 fixed point, truncating
+    // the step. Unless the step is exact, the rounding error accumulates down
+    // the frame, and a band starting at its exact first row would differ.
+    if ((int64_t{src_unit} << 16) % dst_unit != 0) {
+      process_bands(0, src_rows, 0, dst_rows);
+      return;
+    }
+    ProcessRows(num_pixels, dst_rows, dst_unit,
+                [&](int first_row, int num_rows) {
+                  process_bands(first_row / dst_unit * src_unit,
+                                num_rows / dst_unit * src_unit, first_row,
+                                num_rows);
+                });
+    return;
+  }
+  process_bands(0, src_rows, 0, dst_rows);
+}
+
+}  // namespace webrtc
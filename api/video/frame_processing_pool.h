@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_VIDEO_FRAME_PROCESSING_POOL_H_
+#define API_VIDEO_FRAME_PROCESSING_POOL_H_
+
+#include <memory>
+
+#include "api/function_view.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// Splits per-frame pixel work, such as color conversion and scaling, into
+// bands of rows that are processed in parallel on a pool of worker threads.
+// The calling thread processes bands too, and the calls block until the whole
+// frame is done. Frames smaller than a threshold are processed on the calling
+// thread only, since waking the workers costs more than it saves for them.
+class RTC_EXPORT FrameProcessingPool {
+ public:
+  // Frames with fewer pixels than this are not split by the default pool.
+  static constexpr int kDefaultMinParallelPixels = 1280 * 720;
+  // Upper limit on the number of threads, including the calling thread, used
+  // by the default pool.
+  static constexpr int kMaxDefaultThreads = 4;
+
+  // Returns the pool shared by the video frame buffers and capture modules.
+  // It uses one thread per core, up to |kMaxDefaultThreads|. The worker
+  // threads are started when the first frame is split.
+  static FrameProcessingPool* Default();
+
+  // Makes Default() return |pool| instead, or the shared pool again if |pool|
+  // is null. Must not be called while frames are processed.
+  static void SetDefaultForTesting(FrameProcessingPool* pool);
+
+  // Creates a pool that uses up to |num_threads| threads, including the
+  // calling thread, for frames with at least |min_parallel_pixels| pixels.
+  static std::unique_ptr<FrameProcessingPool> Create(int num_threads,
+                                                     int min_parallel_pixels);
+
+  virtual ~FrameProcessingPool() = default;
+
+  // Returns the number of threads work is split over, including the calling
+  // thread.
+  virtual int num_threads() const = 0;
+
+  // Calls |process_rows(first_row, num_rows)| for bands of rows that together
+  // cover rows [0, |num_rows|) once. Band boundaries are multiples of
+  // |row_alignment|, e.g. 2 for a 4:2:0 plane. All rows are processed in a
+  // single call on the calling thread if |num_pixels| is below the threshold,
+  // or if the pool is busy with another frame.
+  virtual void ProcessRows(int num_pixels,
+                           int num_rows,
+                           int row_alignment,
+                           rtc::FunctionView<void(int, int)> process_rows) = 0;
+
+  // Like ProcessRows(), for a vertical downscale of |src_rows| 4:2:0 rows to
+  // |dst_rows| rows. Calls
+  // |process_bands(src_first_row, src_num_rows, dst_first_row, dst_num_rows)|
+  // with bands whose boundaries map exactly between source and destination,
+  // in both luma and chroma rows, so that each band scales independently.
+  // Upscales, sizes without such boundaries, and ratios whose 16.16 fixed
+  // point row step is inexact are processed in one call.
+  void ProcessScaledRows(
+      int num_pixels,
+      int src_rows,
+      int dst_rows,
+      rtc::FunctionView<void(int, int, int, int)> process_bands);
+};
+
+}  // namespace webrtc
+
+#endif  // API_VIDEO_FRAME_PROCESSING_POOL_H_
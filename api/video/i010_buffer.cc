@@ -11,6 +11,7 @@
 
 #include <utility>
 
+#include "api/video/frame_processing_pool.h"
 #include "api/video/i420_buffer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/ref_counted_object.h"
@@ -150,11 +151,21 @@ rtc::scoped_refptr<I010Buffer> I010Buffer::Rotate(
 rtc::scoped_refptr<I420BufferInterface> I010Buffer::ToI420() {
   rtc::scoped_refptr<I420Buffer> i420_buffer =
       I420Buffer::Create(width(), height());
-  libyuv::I010ToI420(DataY(), StrideY(), DataU(), StrideU(), DataV(), StrideV(),
-                     i420_buffer->MutableDataY(), i420_buffer->StrideY(),
-                     i420_buffer->MutableDataU(), i420_buffer->StrideU(),
-                     i420_buffer->MutableDataV(), i420_buffer->StrideV(),
-                     width(), height());
+  // Large frames are converted in bands of rows in parallel.
+  FrameProcessingPool::Default()->ProcessRows(
+      width() * height(), height(), /*row_alignment=*/2,
+      [&](int row, int num_rows) {
+        libyuv::I010ToI420(
+            DataY() + StrideY() * row, StrideY(),
+            DataU() + StrideU() * (row / 2), StrideU(),
+            DataV() + StrideV() * (row / 2), StrideV(),
+            i420_buffer->MutableDataY() + i420_buffer->StrideY() * row,
+            i420_buffer->StrideY(),
+            i420_buffer->MutableDataU() + i420_buffer->StrideU() * (row / 2),
+            i420_buffer->StrideU(),
+            i420_buffer->MutableDataV() + i420_buffer->StrideV() * (row / 2),
+            i420_buffer->StrideV(), width(), num_rows);
+      });
   return i420_buffer;
 }
 
@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <utility>
 
+#include "api/video/frame_processing_pool.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/ref_counted_object.h"
 #include "third_party/libyuv/include/libyuv/convert.h"
@@ -204,13 +205,20 @@ void I420Buffer::CropAndScaleFrom(const I420BufferInterface& src,
       src.DataU() + src.StrideU() * uv_offset_y + uv_offset_x;
   const uint8_t* v_plane =
       src.DataV() + src.StrideV() * uv_offset_y + uv_offset_x;
-  int res =
-      libyuv::I420Scale(y_plane, src.StrideY(), u_plane, src.StrideU(), v_plane,
-                        src.StrideV(), crop_width, crop_height, MutableDataY(),
-                        StrideY(), MutableDataU(), StrideU(), MutableDataV(),
-                        StrideV(), width(), height(), libyuv::kFilterBox);
-
-  RTC_DCHECK_EQ(res, 0);
+  // Large frames are scaled in bands of rows in parallel.
+  FrameProcessingPool::Default()->ProcessScaledRows(
+      crop_width * crop_height, crop_height, height(),
+      [&](int src_row, int src_rows, int dst_row, int dst_rows) {
+        int res = libyuv::I420Scale(
+            y_plane + src.StrideY() * src_row, src.StrideY(),
+            u_plane + src.StrideU() * (src_row / 2), src.StrideU(),
+            v_plane + src.StrideV() * (src_row / 2), src.StrideV(), crop_width,
+            src_rows, MutableDataY() + StrideY() * dst_row, StrideY(),
+            MutableDataU() + StrideU() * (dst_row / 2), StrideU(),
+            MutableDataV() + StrideV() * (dst_row / 2), StrideV(), width(),
+            dst_rows, libyuv::kFilterBox);
+        RTC_DCHECK_EQ(res, 0);
+      });
 }
 
 void I420Buffer::CropAndScaleFrom(const I420BufferInterface& src) {
@@ -0,0 +1,255 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "api/video/nv12_buffer.h"
+
+#include <string.h>
+
+#include <memory>
+#include <vector>
+
+#include "api/video/frame_processing_pool.h"
+#include "api/video/i420_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/ref_counted_object.h"
+#include "third_party/libyuv/include/libyuv/convert.h"
+#include "third_party/libyuv/include/libyuv/planar_functions.h"
+#include "third_party/libyuv/include/libyuv/scale.h"
+
+namespace webrtc {
+
+namespace {
+
+// Aligning pointer to 64 bytes for improved performance, e.g. use SIMD.
+constexpr int kBufferAlignment = 64;
+
+int NV12DataSize(int height, int stride_y, int stride_uv) {
+  return stride_y * height + stride_uv * ((height + 1) / 2);
+}
+
+// Returns at least |size| bytes for the split U and V planes of a scale. The
+// buffer is kept per thread, so that it is allocated once rather than for
+// every frame.
+uint8_t* SplitPlanesBuffer(size_t size) {
+  thread_local std::vector<uint8_t> buffer;
+  if (buffer.size() < size) {
+    buffer.resize(size);
+  }
+  return buffer.data();
+}
+
+}  // namespace
+
+NV12Buffer::NV12Buffer(int width, int height, int stride_y, int stride_uv)
+    : width_(width),
+      height_(height),
+      stride_y_(stride_y),
+      stride_uv_(stride_uv),
+      data_(static_cast<uint8_t*>(
+          AlignedMalloc(NV12DataSize(height, stride_y, stride_uv),
+                        kBufferAlignment))) {
+  RTC_DCHECK_GT(width, 0);
+  RTC_DCHECK_GT(height, 0);
+  RTC_DCHECK_GE(stride_y, width);
+  RTC_DCHECK_GE(stride_uv, (width + 1) / 2 * 2);
+}
+
+NV12Buffer::~NV12Buffer() = default;
+
+// static
+rtc::scoped_refptr<NV12Buffer> NV12Buffer::Create(int width, int height) {
+  return new rtc::RefCountedObject<NV12Buffer>(width, height, width,
+                                               (width + 1) / 2 * 2);
+}
+
+// static
+rtc::scoped_refptr<NV12Buffer> NV12Buffer::Create(int width,
+                                                  int height,
+                                                  int stride_y,
+                                                  int stride_uv) {
+  return new rtc::RefCountedObject<NV12Buffer>(width, height, stride_y,
+                                               stride_uv);
+}
+
+// static
+rtc::scoped_refptr<NV12Buffer> NV12Buffer::Copy(
+    const NV12BufferInterface& source) {
+  return Copy(source.width(), source.height(), source.DataY(), source.StrideY(),
+              source.DataUV(), source.StrideUV());
+}
+
+// static
+rtc::scoped_refptr<NV12Buffer> NV12Buffer::Copy(int width,
+                                                int height,
+                                                const uint8_t* data_y,
+                                                int stride_y,
+                                                const uint8_t* data_uv,
+                                                int stride_uv) {
+  // Note: May use different strides than the input data.
+  rtc::scoped_refptr<NV12Buffer> buffer = Create(width, height);
+  RTC_CHECK_EQ(0, libyuv::NV12Copy(data_y, stride_y, data_uv, stride_uv,
+                                   buffer->MutableDataY(), buffer->StrideY(),
+                                   buffer->MutableDataUV(), buffer->StrideUV(),
+                                   width, height));
+  return buffer;
+}
+
+// static
+rtc::scoped_refptr<NV12Buffer> NV12Buffer::Copy(
+    const I420BufferInterface& i420_buffer) {
+  rtc::scoped_refptr<NV12Buffer> buffer =
+      Create(i420_buffer.width(), i420_buffer.height());
+  RTC_CHECK_EQ(0, libyuv::I420ToNV12(
+                      i420_buffer.DataY(), i420_buffer.StrideY(),
+                      i420_buffer.DataU(), i420_buffer.StrideU(),
+                      i420_buffer.DataV(), i420_buffer.StrideV(),
+                      buffer->MutableDataY(), buffer->StrideY(),
+                      buffer->MutableDataUV(), buffer->StrideUV(),
+                      buffer->width(), buffer->height()));
+  return buffer;
+}
+
+rtc::scoped_refptr<I420BufferInterface> NV12Buffer::ToI420() {
+  rtc::scoped_refptr<I420Buffer> i420_buffer =
+      I420Buffer::Create(width(), height());
+  // Large frames are converted in bands of rows in parallel.
+  FrameProcessingPool::Default()->ProcessRows(
+      width() * height(), height(), /*row_alignment=*/2,
+      [&](int row, int num_rows) {
+        libyuv::NV12ToI420(
+            DataY() + StrideY() * row, StrideY(),
+            DataUV() + StrideUV() * (row / 2), StrideUV(),
+            i420_buffer->MutableDataY() + i420_buffer->StrideY() * row,
+            i420_buffer->StrideY(),
+            i420_buffer->MutableDataU() + i420_buffer->StrideU() * (row / 2),
+            i420_buffer->StrideU(),
+            i420_buffer->MutableDataV() + i420_buffer->StrideV() * (row / 2),
+            i420_buffer->StrideV(), width(), num_rows);
+      });
+  return i420_buffer;
+}
+
+int NV12Buffer::width() const {
+  return width_;
+}
+
+int NV12Buffer::height() const {
+  return height_;
+}
+
+int NV12Buffer::StrideY() const {
+  return stride_y_;
+}
+
+int NV12Buffer::StrideUV() const {
+  return stride_uv_;
+}
+
+const uint8_t* NV12Buffer::DataY() const {
+  return data_.get();
+}
+
+const uint8_t* NV12Buffer::DataUV() const {
+  return data_.get() + UVOffset();
+}
+
+uint8_t* NV12Buffer::MutableDataY() {
+  return data_.get();
+}
+
+uint8_t* NV12Buffer::MutableDataUV() {
+  return data_.get() + UVOffset();
+}
+
+size_t NV12Buffer::UVOffset() const {
+  return stride_y_ * height_;
+}
+
+void NV12Buffer::InitializeData() {
+  memset(data_.get(), 0, NV12DataSize(height_, stride_y_, stride_uv_));
+}
+
+void NV12Buffer::CropAndScaleFrom(const NV12BufferInterface& src,
+                                  int offset_x,
+                                  int offset_y,
+                                  int crop_width,
+                                  int crop_height) {
+  RTC_CHECK_LE(crop_width, src.width());
+  RTC_CHECK_LE(crop_height, src.height());
+  RTC_CHECK_LE(crop_width + offset_x, src.width());
+  RTC_CHECK_LE(crop_height + offset_y, src.height());
+  RTC_CHECK_GE(offset_x, 0);
+  RTC_CHECK_GE(offset_y, 0);
+
+  // Make sure offset is even so that u/v plane becomes aligned.
+  const int uv_offset_x = offset_x / 2;
+  const int uv_offset_y = offset_y / 2;
+  offset_x = uv_offset_x * 2;
+  offset_y = uv_offset_y * 2;
+
+  const uint8_t* y_plane = src.DataY() + src.StrideY() * offset_y + offset_x;
+  const uint8_t* uv_plane =
+      src.DataUV() + src.StrideUV() * uv_offset_y + uv_offset_x * 2;
+  const int src_chroma_width = (crop_width + 1) / 2;
+
+  if (crop_width == width() && crop_height == height()) {
+    // Cropping only.
+    libyuv::CopyPlane(y_plane, src.StrideY(), MutableDataY(), StrideY(),
+                      crop_width, crop_height);
+    libyuv::CopyPlane(uv_plane, src.StrideUV(), MutableDataUV(), StrideUV(),
+                      src_chroma_width * 2, (crop_height + 1) / 2);
+    return;
+  }
+
+  // The U and V samples are split into separate planes for scaling, and then
+  // merged into the destination.
+  const int dst_chroma_width = ChromaWidth();
+  const size_t src_plane_size =
+      src_chroma_width * static_cast<size_t>((crop_height + 1) / 2);
+  const size_t dst_plane_size = dst_chroma_width * ChromaHeight();
+  uint8_t* const src_u_plane =
+      SplitPlanesBuffer(2 * (src_plane_size + dst_plane_size));
+  uint8_t* const src_v_plane = src_u_plane + src_plane_size;
+  uint8_t* const dst_u_plane = src_v_plane + src_plane_size;
+  uint8_t* const dst_v_plane = dst_u_plane + dst_plane_size;
+
+  // Large frames are scaled in bands of rows in parallel. The bands start at
+  // even rows, so each uses its own rows of the split planes.
+  FrameProcessingPool::Default()->ProcessScaledRows(
+      crop_width * crop_height, crop_height, height(),
+      [&](int src_row, int src_rows, int dst_row, int dst_rows) {
+        const int src_chroma_height = (src_rows + 1) / 2;
+        const int dst_chroma_height = (dst_rows + 1) / 2;
+        uint8_t* const src_u = src_u_plane + src_chroma_width * (src_row / 2);
+        uint8_t* const src_v = src_v_plane + src_chroma_width * (src_row / 2);
+        uint8_t* const dst_u = dst_u_plane + dst_chroma_width * (dst_row / 2);
+        uint8_t* const dst_v = dst_v_plane + dst_chroma_width * (dst_row / 2);
+
+        libyuv::SplitUVPlane(uv_plane + src.StrideUV() * (src_row / 2),
+                             src.StrideUV(), src_u, src_chroma_width, src_v,
+                             src_chroma_width, src_chroma_width,
+                             src_chroma_height);
+        int res = libyuv::I420Scale(
+            y_plane + src.StrideY() * src_row, src.StrideY(), src_u,
+            src_chroma_width, src_v, src_chroma_width, crop_width, src_rows,
+            MutableDataY() + StrideY() * dst_row, StrideY(), dst_u,
+            dst_chroma_width, dst_v, dst_chroma_width, width(), dst_rows,
+            libyuv::kFilterBox);
+        RTC_DCHECK_EQ(res, 0);
+        libyuv::MergeUVPlane(dst_u, dst_chroma_width, dst_v, dst_chroma_width,
+                             MutableDataUV() + StrideUV() * (dst_row / 2),
+                             StrideUV(), dst_chroma_width, dst_chroma_height);
+      });
+}
+
+void NV12Buffer::ScaleFrom(const NV12BufferInterface& src) {
+  CropAndScaleFrom(src, 0, 0, src.width(), src.height());
+}
+
+}  // namespace webrtc
@@ -0,0 +1,260 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/video/frame_processing_pool.h"
+
+#include <string.h>
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
+#include "rtc_base/platform_thread_types.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr int kNumThreads = 4;
+
+rtc::scoped_refptr<I420Buffer> CreatePattern(int width, int height) {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width, height);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      buffer->MutableDataY()[y * buffer->StrideY() + x] = x * 7 + y * 3;
+    }
+  }
+  for (int y = 0; y < buffer->ChromaHeight(); ++y) {
+    for (int x = 0; x < buffer->ChromaWidth(); ++x) {
+      buffer->MutableDataU()[y * buffer->StrideU() + x] = x * 5 + y;
+      buffer->MutableDataV()[y * buffer->StrideV() + x] = x + y * 5;
+    }
+  }
+  return buffer;
+}
+
+bool PlaneEquals(const uint8_t* a,
+                 int stride_a,
+                 const uint8_t* b,
+                 int stride_b,
+                 int width,
+                 int height) {
+  for (int y = 0; y < height; ++y) {
+    if (memcmp(a + y * stride_a, b + y * stride_b, width) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool BufferEquals(const I420BufferInterface& a, const I420BufferInterface& b) {
+  return a.width() == b.width() && a.height() == b.height() &&
+         PlaneEquals(a.DataY(), a.StrideY(), b.DataY(), b.StrideY(), a.width(),
+                     a.height()) &&
+         PlaneEquals(a.DataU(), a.StrideU(), b.DataU(), b.StrideU(),
+                     a.ChromaWidth(), a.ChromaHeight()) &&
+         PlaneEquals(a.DataV(), a.StrideV(), b.DataV(), b.StrideV(),
+                     a.ChromaWidth(), a.ChromaHeight());
+}
+
+// Scales |src| with a single thread and with |kNumThreads| threads.
+void ExpectParallelScaleBitExact(const I420BufferInterface& src,
+                                 int dst_width,
+                                 int dst_height) {
+  std::unique_ptr<FrameProcessingPool> serial_pool =
+      FrameProcessingPool::Create(1, 0);
+  std::unique_ptr<FrameProcessingPool> parallel_pool =
+      FrameProcessingPool::Create(kNumThreads, 0);
+  rtc::scoped_refptr<I420Buffer> serial =
+      I420Buffer::Create(dst_width, dst_height);
+  rtc::scoped_refptr<I420Buffer> parallel =
+      I420Buffer::Create(dst_width, dst_height);
+
+  FrameProcessingPool::SetDefaultForTesting(serial_pool.get());
+  serial->ScaleFrom(src);
+  FrameProcessingPool::SetDefaultForTesting(parallel_pool.get());
+  parallel->ScaleFrom(src);
+  FrameProcessingPool::SetDefaultForTesting(nullptr);
+
+  EXPECT_TRUE(BufferEquals(*serial, *parallel))
+      << src.width() << "x" << src.height() << " to " << dst_width << "x"
+      << dst_height;
+}
+
+}  // namespace
+
+TEST(FrameProcessingPoolTest, ProcessesEachRowOnce) {
+  std::unique_ptr<FrameProcessingPool> pool =
+      FrameProcessingPool::Create(kNumThreads, 0);
+  constexpr int kNumRows = 1081;
+  std::vector<std::atomic<int>> row_counts(kNumRows);
+  std::atomic<int> num_calls(0);
+  pool->ProcessRows(1920 * kNumRows, kNumRows, /*row_alignment=*/2,
+                    [&](int first_row, int num_rows) {
+                      EXPECT_EQ(first_row % 2, 0);
+                      ++num_calls;
+                      for (int i = first_row; i < first_row + num_rows; ++i) {
+                        ++row_counts[i];
+                      }
+                    });
+  EXPECT_EQ(num_calls.load(), kNumThreads);
+  for (int i = 0; i < kNumRows; ++i) {
+    EXPECT_EQ(row_counts[i].load(), 1) << "row " << i;
+  }
+}
+
+TEST(FrameProcessingPoolTest, ProcessesSmallFramesOnCallingThread) {
+  std::unique_ptr<FrameProcessingPool> pool =
+      FrameProcessingPool::Create(kNumThreads, 1280 * 720);
+  const rtc::PlatformThreadRef caller = rtc::CurrentThreadRef();
+  int num_calls = 0;
+  pool->ProcessRows(640 * 480, 480, /*row_alignment=*/2,
+                    [&](int first_row, int num_rows) {
+                      EXPECT_TRUE(rtc::IsThreadRefEqual(
+                          caller, rtc::CurrentThreadRef()));
+                      EXPECT_EQ(first_row, 0);
+                      EXPECT_EQ(num_rows, 480);
+                      ++num_calls;
+                    });
+  EXPECT_EQ(num_calls, 1);
+}
+
+TEST(FrameProcessingPoolTest, ProcessesNestedFramesInOneCall) {
+  std::unique_ptr<FrameProcessingPool> pool =
+      FrameProcessingPool::Create(kNumThreads, 0);
+  std::atomic<int> num_nested_calls(0);
+  pool->ProcessRows(1920 * 1080, 1080, /*row_alignment=*/2, [&](int, int) {
+    // The pool is busy with the outer frame.
+    pool->ProcessRows(1920 * 1080, 1080, /*row_alignment=*/2,
+                      [&](int first_row, int num_rows) {
+                        EXPECT_EQ(first_row, 0);
+                        EXPECT_EQ(num_rows, 1080);
+                        ++num_nested_calls;
+                      });
+  });
+  EXPECT_EQ(num_nested_calls.load(), kNumThreads);
+}
+
+TEST(FrameProcessingPoolTest, ScaledBandsMapExactly) {
+  std::unique_ptr<FrameProcessingPool> pool =
+      FrameProcessingPool::Create(kNumThreads, 0);
+  std::atomic<int> num_calls(0);
+  std::atomic<int> num_src_rows(0);
+  std::atomic<int> num_dst_rows(0);
+  pool->ProcessScaledRows(
+      1920 * 1080, 1080, 720,
+      [&](int src_row, int src_rows, int dst_row, int dst_rows) {
+        EXPECT_EQ(src_row * 720, dst_row * 1080);
+        EXPECT_EQ(src_rows * 720, dst_rows * 1080);
+        EXPECT_EQ(src_row % 2, 0);
+        EXPECT_EQ(dst_row % 2, 0);
+        ++num_calls;
+        num_src_rows += src_rows;
+        num_dst_rows += dst_rows;
+      });
+  EXPECT_EQ(num_calls.load(), kNumThreads);
+  EXPECT_EQ(num_src_rows.load(), 1080);
+  EXPECT_EQ(num_dst_rows.load(), 720);
+}
+
+TEST(FrameProcessingPoolTest, ScalesUpInOneCall) {
+  std::unique_ptr<FrameProcessingPool> pool =
+      FrameProcessingPool::Create(kNumThreads, 0);
+  int num_calls = 0;
+  pool->ProcessScaledRows(
+      1920 * 1080, 540, 1080,
+      [&](int src_row, int src_rows, int dst_row, int dst_rows) {
+        EXPECT_EQ(src_row, 0);
+        EXPECT_EQ(src_rows, 540);
+        EXPECT_EQ(dst_row, 0);
+        EXPECT_EQ(dst_rows, 1080);
+        ++num_calls;
+      });
+  EXPECT_EQ(num_calls, 1);
+}
+
+TEST(FrameProcessingPoolTest, ParallelI420ScaleIsBitExact) {
+  rtc::scoped_refptr<I420Buffer> src = CreatePattern(1920, 1080);
+  ExpectParallelScaleBitExact(*src, 1920, 1080);
+  ExpectParallelScaleBitExact(*src, 1280, 720);
+  ExpectParallelScaleBitExact(*src, 960, 540);
+  ExpectParallelScaleBitExact(*src, 640, 360);
+  ExpectParallelScaleBitExact(*src, 320, 180);
+  // Ratios whose fixed point row step is inexact.
+  ExpectParallelScaleBitExact(*src, 1080, 600);
+  ExpectParallelScaleBitExact(*src, 1440, 810);
+}
+
+TEST(FrameProcessingPoolTest, ScalesInexactStepsInOneCall) {
+  std::unique_ptr<FrameProcessingPool> pool =
+      FrameProcessingPool::Create(kNumThreads, 0);
+  for (int dst_rows : {600, 810}) {
+    int num_calls = 0;
+    pool->ProcessScaledRows(1920 * 1080, 1080, dst_rows,
+                            [&](int src_row, int src_rows, int dst_row,
+                                int num_dst_rows) {
+                              EXPECT_EQ(src_row, 0);
+                              EXPECT_EQ(src_rows, 1080);
+                              EXPECT_EQ(dst_row, 0);
+                              EXPECT_EQ(num_dst_rows, dst_rows);
+                              ++num_calls;
+                            });
+    EXPECT_EQ(num_calls, 1) << "1080 to " << dst_rows;
+  }
+}
+
+TEST(FrameProcessingPoolTest, ParallelNV12ConversionIsBitExact) {
+  std::unique_ptr<FrameProcessingPool> serial_pool =
+      FrameProcessingPool::Create(1, 0);
+  std::unique_ptr<FrameProcessingPool> parallel_pool =
+      FrameProcessingPool::Create(kNumThreads, 0);
+  rtc::scoped_refptr<NV12Buffer> src =
+      NV12Buffer::Copy(*CreatePattern(1920, 1080));
+
+  FrameProcessingPool::SetDefaultForTesting(serial_pool.get());
+  rtc::scoped_refptr<I420BufferInterface> serial = src->ToI420();
+  FrameProcessingPool::SetDefaultForTesting(parallel_pool.get());
+  rtc::scoped_refptr<I420BufferInterface> parallel = src->ToI420();
+  FrameProcessingPool::SetDefaultForTesting(nullptr);
+
+  EXPECT_TRUE(BufferEquals(*serial, *parallel));
+}
+
+TEST(FrameProcessingPoolTest, ParallelNV12CropAndScaleIsBitExact) {
+  std::unique_ptr<FrameProcessingPool> serial_pool =
+      FrameProcessingPool::Create(1, 0);
+  std::unique_ptr<FrameProcessingPool> parallel_pool =
+      FrameProcessingPool::Create(kNumThreads, 0);
+  rtc::scoped_refptr<NV12Buffer> src =
+      NV12Buffer::Copy(*CreatePattern(1920, 1080));
+  for (const auto& size : {std::make_pair(1280, 720), std::make_pair(960, 540),
+                           std::make_pair(1080, 600),
+                           std::make_pair(1440, 810)}) {
+    rtc::scoped_refptr<NV12Buffer> serial =
+        NV12Buffer::Create(size.first, size.second);
+    rtc::scoped_refptr<NV12Buffer> parallel =
+        NV12Buffer::Create(size.first, size.second);
+
+    FrameProcessingPool::SetDefaultForTesting(serial_pool.get());
+    serial->CropAndScaleFrom(*src, 40, 0, 1800, 1080);
+    FrameProcessingPool::SetDefaultForTesting(parallel_pool.get());
+    parallel->CropAndScaleFrom(*src, 40, 0, 1800, 1080);
+    FrameProcessingPool::SetDefaultForTesting(nullptr);
+
+    EXPECT_TRUE(BufferEquals(*serial->ToI420(), *parallel->ToI420()))
+        << size.first << "x" << size.second;
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,167 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/video/nv12_buffer.h"
+
+#include <string.h>
+
+#include "api/video/i420_buffer.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+int GetY(rtc::scoped_refptr<NV12BufferInterface> buf, int col, int row) {
+  return buf->DataY()[row * buf->StrideY() + col];
+}
+
+int GetU(rtc::scoped_refptr<NV12BufferInterface> buf, int col, int row) {
+  return buf->DataUV()[(row / 2) * buf->StrideUV() + (col / 2) * 2];
+}
+
+int GetV(rtc::scoped_refptr<NV12BufferInterface> buf, int col, int row) {
+  return buf->DataUV()[(row / 2) * buf->StrideUV() + (col / 2) * 2 + 1];
+}
+
+// Returns a buffer with Y = 128(x/w + y/h), U = 256 x/w and V = 256 y/h.
+rtc::scoped_refptr<NV12Buffer> CreateGradient(int width, int height) {
+  rtc::scoped_refptr<NV12Buffer> buffer = NV12Buffer::Create(width, height);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      buffer->MutableDataY()[y * buffer->StrideY() + x] =
+          128 * (x * height + y * width) / (width * height);
+    }
+  }
+  const int chroma_width = buffer->ChromaWidth();
+  const int chroma_height = buffer->ChromaHeight();
+  for (int y = 0; y < chroma_height; ++y) {
+    for (int x = 0; x < chroma_width; ++x) {
+      uint8_t* uv = buffer->MutableDataUV() + y * buffer->StrideUV() + x * 2;
+      uv[0] = 255 * x / (chroma_width - 1);
+      uv[1] = 255 * y / (chroma_height - 1);
+    }
+  }
+  return buffer;
+}
+
+// The offsets and sizes describe the rectangle extracted from the original
+// (gradient) frame, in relative coordinates where the original frame
+// corresponds to the unit square, 0.0 <= x, y < 1.0.
+void CheckCrop(rtc::scoped_refptr<NV12BufferInterface> frame,
+               double offset_x,
+               double offset_y,
+               double rel_width,
+               double rel_height) {
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      // Pixel coordinates of the corner.
+      const int x = i * (frame->width() - 1);
+      const int y = j * (frame->height() - 1);
+      // Relative coordinates, range 0.0 - 1.0 correspond to the size of the
+      // uncropped input frame.
+      const double orig_x = offset_x + i * rel_width;
+      const double orig_y = offset_y + j * rel_height;
+      EXPECT_NEAR(GetY(frame, x, y) / 256.0, (orig_x + orig_y) / 2, 0.02);
+      EXPECT_NEAR(GetU(frame, x, y) / 256.0, orig_x, 0.02);
+      EXPECT_NEAR(GetV(frame, x, y) / 256.0, orig_y, 0.02);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(NV12BufferTest, InitialData) {
+  constexpr int kWidth = 3;
+  constexpr int kHeight = 3;
+  rtc::scoped_refptr<NV12Buffer> buffer = NV12Buffer::Create(kWidth, kHeight);
+  EXPECT_EQ(kWidth, buffer->width());
+  EXPECT_EQ(kHeight, buffer->height());
+  EXPECT_EQ(kWidth, buffer->StrideY());
+  EXPECT_EQ(4, buffer->StrideUV());
+  EXPECT_EQ(2, buffer->ChromaWidth());
+  EXPECT_EQ(2, buffer->ChromaHeight());
+  EXPECT_EQ(VideoFrameBuffer::Type::kNV12, buffer->type());
+  EXPECT_EQ(buffer.get(), buffer->GetNV12());
+}
+
+TEST(NV12BufferTest, CopiesFromI420AndConvertsBack) {
+  constexpr int kWidth = 6;
+  constexpr int kHeight = 4;
+  rtc::scoped_refptr<I420Buffer> i420_buffer =
+      I420Buffer::Create(kWidth, kHeight);
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    i420_buffer->MutableDataY()[i] = i;
+  }
+  for (int i = 0; i < kWidth * kHeight / 4; ++i) {
+    i420_buffer->MutableDataU()[i] = 100 + i;
+    i420_buffer->MutableDataV()[i] = 200 + i;
+  }
+
+  rtc::scoped_refptr<NV12Buffer> nv12_buffer = NV12Buffer::Copy(*i420_buffer);
+  for (int row = 0; row < kHeight; ++row) {
+    for (int col = 0; col < kWidth; ++col) {
+      EXPECT_EQ(row * kWidth + col, GetY(nv12_buffer, col, row));
+      EXPECT_EQ(100 + row / 2 * kWidth / 2 + col / 2,
+                GetU(nv12_buffer, col, row));
+      EXPECT_EQ(200 + row / 2 * kWidth / 2 + col / 2,
+                GetV(nv12_buffer, col, row));
+    }
+  }
+
+  rtc::scoped_refptr<I420BufferInterface> converted = nv12_buffer->ToI420();
+  EXPECT_EQ(0, memcmp(i420_buffer->DataY(), converted->DataY(),
+                      kWidth * kHeight));
+  EXPECT_EQ(0, memcmp(i420_buffer->DataU(), converted->DataU(),
+                      kWidth * kHeight / 4));
+  EXPECT_EQ(0, memcmp(i420_buffer->DataV(), converted->DataV(),
+                      kWidth * kHeight / 4));
+}
+
+TEST(NV12BufferTest, CopiesWithDifferentStrides) {
+  rtc::scoped_refptr<NV12Buffer> source =
+      NV12Buffer::Create(/*width=*/30, /*height=*/20, /*stride_y=*/64,
+                         /*stride_uv=*/64);
+  source->InitializeData();
+  source->MutableDataY()[19 * 64 + 29] = 1;
+  source->MutableDataUV()[9 * 64 + 29] = 2;
+
+  rtc::scoped_refptr<NV12Buffer> copy = NV12Buffer::Copy(*source);
+  EXPECT_EQ(30, copy->StrideY());
+  EXPECT_EQ(30, copy->StrideUV());
+  EXPECT_EQ(1, GetY(copy, 29, 19));
+  EXPECT_EQ(2, GetV(copy, 29, 19));
+}
+
+TEST(NV12BufferTest, Scales) {
+  rtc::scoped_refptr<NV12Buffer> scaled_buffer = NV12Buffer::Create(150, 75);
+  scaled_buffer->ScaleFrom(*CreateGradient(200, 100));
+  CheckCrop(scaled_buffer, 0.0, 0.0, 1.0, 1.0);
+}
+
+TEST(NV12BufferTest, CropsXNotCenter) {
+  rtc::scoped_refptr<NV12Buffer> cropped_buffer = NV12Buffer::Create(100, 100);
+  cropped_buffer->CropAndScaleFrom(*CreateGradient(200, 100), 25, 0, 100, 100);
+  CheckCrop(cropped_buffer, 0.125, 0.0, 0.5, 1.0);
+}
+
+TEST(NV12BufferTest, CropsYCenter) {
+  rtc::scoped_refptr<NV12Buffer> cropped_buffer = NV12Buffer::Create(100, 100);
+  cropped_buffer->CropAndScaleFrom(*CreateGradient(100, 200), 0, 50, 100, 100);
+  CheckCrop(cropped_buffer, 0.0, 0.25, 1.0, 0.5);
+}
+
+TEST(NV12BufferTest, CropsAndScales16x9) {
+  rtc::scoped_refptr<NV12Buffer> scaled_buffer = NV12Buffer::Create(320, 180);
+  scaled_buffer->CropAndScaleFrom(*CreateGradient(640, 480), 0, 60, 640, 360);
+  CheckCrop(scaled_buffer, 0.0, 0.125, 1.0, 0.75);
+}
+
+}  // namespace webrtc
@@ -23,6 +23,7 @@ class I420BufferInterface;
 class I420ABufferInterface;
 class I444BufferInterface;
 class I010BufferInterface;
+class NV12BufferInterface;
 
 // Base class for frame buffers of different types of pixel format and storage.
 // The tag in type() indicates how the data is represented, and each type is
@@ -50,6 +51,7 @@ class RTC_EXPORT VideoFrameBuffer : public rtc::RefCountInterface {
     kI420A,
     kI444,
     kI010,
+    kNV12,
   };
 
   // This function specifies in what pixel format the data is stored in.
@@ -79,11 +81,16 @@ class RTC_EXPORT VideoFrameBuffer : public rtc::RefCountInterface {
   const I420ABufferInterface* GetI420A() const;
   const I444BufferInterface* GetI444() const;
   const I010BufferInterface* GetI010() const;
+  const NV12BufferInterface* GetNV12() const;
 
  protected:
   ~VideoFrameBuffer() override {}
 };
 
+// Returns a human readable name of |type|, for logging.
+RTC_EXPORT const char* VideoFrameBufferTypeToString(
+    VideoFrameBuffer::Type type);
+
 // This interface represents planar formats.
 class PlanarYuvBuffer : public VideoFrameBuffer {
  public:
@@ -175,6 +182,47 @@ class I010BufferInterface : public PlanarYuv16BBuffer {
   ~I010BufferInterface() override {}
 };
 
+// This interface represents formats with a full resolution luma plane and a
+// single chroma plane holding interleaved U and V samples.
+class BiPlanarYuvBuffer : public VideoFrameBuffer {
+ public:
+  virtual int ChromaWidth() const = 0;
+  virtual int ChromaHeight() const = 0;
+
+  // Returns the number of steps(in terms of Data*() return type) between
+  // successive rows for a given plane.
+  virtual int StrideY() const = 0;
+  virtual int StrideUV() const = 0;
+
+ protected:
+  ~BiPlanarYuvBuffer() override {}
+};
+
+// This interface represents 8-bit color depth bi-planar formats: Type::kNV12.
+class BiPlanarYuv8Buffer : public BiPlanarYuvBuffer {
+ public:
+  // Returns pointer to the pixel data for a given plane. The memory is owned by
+  // the VideoFrameBuffer object and must not be freed by the caller.
+  virtual const uint8_t* DataY() const = 0;
+  virtual const uint8_t* DataUV() const = 0;
+
+ protected:
+  ~BiPlanarYuv8Buffer() override {}
+};
+
+// Represents Type::kNV12. The UV plane is subsampled by two in both
+// directions, and holds ChromaWidth() pairs of U and V samples per row.
+class RTC_EXPORT NV12BufferInterface : public BiPlanarYuv8Buffer {
+ public:
+  Type type() const override;
+
+  int ChromaWidth() const final;
+  int ChromaHeight() const final;
+
+ protected:
+  ~NV12BufferInterface() override {}
+};
+
 }  // namespace webrtc
 
 #endif  // API_VIDEO_VIDEO_FRAME_BUFFER_H_
@@ -96,6 +96,7 @@ VideoEncoder::EncoderInfo::EncoderInfo()
       requested_resolution_alignment(1),
       supports_native_handle(false),
       implementation_name("unknown"),
+      preferred_pixel_formats{VideoFrameBuffer::Type::kI420},
       has_trusted_rate_controller(false),
       is_hardware_accelerated(true),
       has_internal_source(false),
@@ -126,6 +127,14 @@ std::string VideoEncoder::EncoderInfo::ToString() const {
       << ", supports_native_handle = " << supports_native_handle
       << ", implementation_name = '" << implementation_name
       << "'"
+         ", preferred_pixel_formats = [";
+  for (size_t i = 0; i < preferred_pixel_formats.size(); ++i) {
+    if (i > 0) {
+      oss << ", ";
+    }
+    oss << VideoFrameBufferTypeToString(preferred_pixel_formats[i]);
+  }
+  oss << "]"
          ", has_trusted_rate_controller = "
       << has_trusted_rate_controller
       << ", is_hardware_accelerated = " << is_hardware_accelerated
@@ -189,6 +198,7 @@ bool VideoEncoder::EncoderInfo::operator==(const EncoderInfo& rhs) const {
 
   if (supports_native_handle != rhs.supports_native_handle ||
       implementation_name != rhs.implementation_name ||
+      preferred_pixel_formats != rhs.preferred_pixel_formats ||
       has_trusted_rate_controller != rhs.has_trusted_rate_controller ||
       is_hardware_accelerated != rhs.is_hardware_accelerated ||
       has_internal_source != rhs.has_internal_source) {
@@ -24,6 +24,7 @@
 #include "api/video/video_bitrate_allocation.h"
 #include "api/video/video_codec_constants.h"
 #include "api/video/video_frame.h"
+#include "api/video/video_frame_buffer.h"
 #include "api/video_codecs/video_codec.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/system/rtc_export.h"
@@ -196,6 +197,13 @@ class RTC_EXPORT VideoEncoder {
     // especially in hardware codecs. Disable media opt at your own risk.
     bool has_trusted_rate_controller;
 
+    // The pixel formats of input frames that the encoder takes without any
+    // conversion, in order of preference. Frames of other types, except native
+    // frames if |supports_native_handle| is set, are converted to I420 before
+    // they are passed to Encode().
+    absl::InlinedVector<VideoFrameBuffer::Type, kMaxPreferredPixelFormats>
+        preferred_pixel_formats;
+
     // If this field is true, the encoder uses hardware support and different
     // thresholds will be used in CPU adaptation.
     bool is_hardware_accelerated;
@@ -272,6 +272,14 @@ class TransportFeedbackProxy : public TransportFeedbackObserver {
       feedback_observer_->OnTransportFeedback(feedback);
   }
 
+  void OnCongestionControlFeedback(
+      const rtcp::CongestionControlFeedback& feedback) override {
+    RTC_DCHECK(network_thread_.IsCurrent());
+    rtc::CritScope lock(&crit_);
+    if (feedback_observer_)
+      feedback_observer_->OnCongestionControlFeedback(feedback);
+  }
+
  private:
   rtc::CriticalSection crit_;
   rtc::ThreadChecker thread_checker_;
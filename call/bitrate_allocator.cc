@@ -356,6 +356,7 @@ BitrateAllocator::BitrateAllocator(LimitObserver* limit_observer)
     : limit_observer_(limit_observer),
       last_target_bps_(0),
       last_stable_target_bps_(0),
+      last_network_estimate_bps_(0),
       last_non_zero_bitrate_bps_(kDefaultBitrateBps),
       last_fraction_loss_(0),
       last_rtt_(0),
@@ -379,6 +380,7 @@ void BitrateAllocator::OnNetworkEstimateChanged(TargetTransferRate msg) {
   RTC_DCHECK_RUN_ON(&sequenced_checker_);
   last_target_bps_ = msg.target_rate.bps();
   last_stable_target_bps_ = msg.stable_target_rate.bps();
+  last_network_estimate_bps_ = msg.network_estimate.bandwidth.bps_or(0);
   last_non_zero_bitrate_bps_ =
       last_target_bps_ > 0 ? last_target_bps_ : last_non_zero_bitrate_bps_;
 
@@ -407,6 +409,7 @@ void BitrateAllocator::OnNetworkEstimateChanged(TargetTransferRate msg) {
     update.target_bitrate = DataRate::BitsPerSec(allocated_bitrate);
     update.stable_target_bitrate =
         DataRate::BitsPerSec(allocated_stable_target_rate);
+    update.network_estimate = DataRate::BitsPerSec(last_network_estimate_bps_);
     update.packet_loss_ratio = last_fraction_loss_ / 256.0;
     update.round_trip_time = TimeDelta::Millis(last_rtt_);
     update.bwe_period = TimeDelta::Millis(last_bwe_period_ms_);
@@ -473,6 +476,8 @@ void BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
       update.target_bitrate = DataRate::BitsPerSec(allocated_bitrate);
       update.stable_target_bitrate =
           DataRate::BitsPerSec(allocated_stable_bitrate);
+      update.network_estimate =
+          DataRate::BitsPerSec(last_network_estimate_bps_);
       update.packet_loss_ratio = last_fraction_loss_ / 256.0;
       update.round_trip_time = TimeDelta::Millis(last_rtt_);
       update.bwe_period = TimeDelta::Millis(last_bwe_period_ms_);
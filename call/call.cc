@@ -51,6 +51,7 @@
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/synchronization/rw_lock_wrapper.h"
 #include "rtc_base/synchronization/sequence_checker.h"
+#include "rtc_base/task_utils/repeating_task.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
@@ -220,6 +221,8 @@ class Call final : public webrtc::Call,
   DeliveryStatus DeliverPacket(MediaType media_type,
                                rtc::CopyOnWriteBuffer packet,
                                int64_t packet_time_us) override;
+  DeliveryStatus DeliverRtpPacket(MediaType media_type,
+                                  RtpPacketReceived packet) override;
 
   // Implements RecoveredPacketReceiver.
   void OnRecoveredPacket(const uint8_t* packet, size_t length) override;
@@ -247,6 +250,9 @@ class Call final : public webrtc::Call,
   DeliveryStatus DeliverRtp(MediaType media_type,
                             rtc::CopyOnWriteBuffer packet,
                             int64_t packet_time_us);
+  DeliveryStatus DeliverParsedRtp(MediaType media_type,
+                                  RtpPacketReceived parsed_packet,
+                                  int64_t packet_time_us);
   void ConfigureSync(const std::string& sync_group)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(receive_crit_);
 
@@ -371,6 +377,9 @@ class Call final : public webrtc::Call,
   AvgCounter pacer_bitrate_kbps_counter_ RTC_GUARDED_BY(&bitrate_crit_);
 
   ReceiveSideCongestionController receive_side_cc_;
+  // Runs receive_side_cc_.MaybeProcess() on the thread the call was created
+  // on, with the deadlines of the estimators instead of ProcessThread polling.
+  RepeatingTaskHandle receive_side_cc_periodic_task_;
 
   const std::unique_ptr<ReceiveTimeCalculator> receive_time_calculator_;
 
@@ -465,7 +474,10 @@ Call::Call(Clock* clock,
       configured_max_padding_bitrate_bps_(0),
       estimated_send_bitrate_kbps_counter_(clock_, nullptr, true),
       pacer_bitrate_kbps_counter_(clock_, nullptr, true),
-      receive_side_cc_(clock_, transport_send->packet_router()),
+      receive_side_cc_(clock_,
+                       transport_send->packet_router(),
+                       /*network_state_estimator=*/nullptr,
+                       task_queue_factory_),
       receive_time_calculator_(ReceiveTimeCalculator::CreateFromFieldTrial()),
       video_send_delay_stats_(new SendDelayStats(clock_)),
       start_ms_(clock_->TimeInMilliseconds()),
@@ -477,9 +489,9 @@ Call::Call(Clock* clock,
 
   call_stats_->RegisterStatsObserver(&receive_side_cc_);
 
-  module_process_thread_->RegisterModule(
-      receive_side_cc_.GetRemoteBitrateEstimator(true), RTC_FROM_HERE);
-  module_process_thread_->RegisterModule(&receive_side_cc_, RTC_FROM_HERE);
+  receive_side_cc_periodic_task_ = RepeatingTaskHandle::Start(
+      GetCurrentTaskQueueOrThread(),
+      [this] { return receive_side_cc_.MaybeProcess(); });
 }
 
 Call::~Call() {
@@ -492,9 +504,7 @@ Call::~Call() {
   RTC_CHECK(video_receive_streams_.empty());
 
   module_process_thread_->Stop();
-  module_process_thread_->DeRegisterModule(
-      receive_side_cc_.GetRemoteBitrateEstimator(true));
-  module_process_thread_->DeRegisterModule(&receive_side_cc_);
+  receive_side_cc_periodic_task_.Stop();
   call_stats_->DeregisterStatsObserver(&receive_side_cc_);
 
   absl::optional<Timestamp> first_sent_packet_ms =
@@ -1239,6 +1249,14 @@ PacketReceiver::DeliveryStatus Call::DeliverRtp(MediaType media_type,
   if (!parsed_packet.Parse(std::move(packet)))
     return DELIVERY_PACKET_ERROR;
 
+  return DeliverParsedRtp(media_type, std::move(parsed_packet),
+                          packet_time_us);
+}
+
+PacketReceiver::DeliveryStatus Call::DeliverParsedRtp(
+    MediaType media_type,
+    RtpPacketReceived parsed_packet,
+    int64_t packet_time_us) {
   if (packet_time_us != -1) {
     if (receive_time_calculator_) {
       // Repair packet_time_us for clock resets by comparing a new read of
@@ -1322,6 +1340,16 @@ PacketReceiver::DeliveryStatus Call::DeliverPacket(
   return DeliverRtp(media_type, std::move(packet), packet_time_us);
 }
 
+PacketReceiver::DeliveryStatus Call::DeliverRtpPacket(
+    MediaType media_type,
+    RtpPacketReceived packet) {
+  RTC_DCHECK_RUN_ON(&configuration_sequence_checker_);
+  TRACE_EVENT0("webrtc", "Call::DeliverRtpPacket");
+  const int64_t packet_time_us =
+      packet.arrival_time_ms() > 0 ? packet.arrival_time_ms() * 1000 : -1;
+  return DeliverParsedRtp(media_type, std::move(packet), packet_time_us);
+}
+
 void Call::OnRecoveredPacket(const uint8_t* packet, size_t length) {
   RtpPacketReceived parsed_packet;
   if (!parsed_packet.Parse(packet, length))
@@ -1381,7 +1409,7 @@ void Call::NotifyBweOfReceivedPacket(const RtpPacketReceived& packet,
       (use_send_side_bwe && header.extension.hasTransportSequenceNumber)) {
     receive_side_cc_.OnReceivedPacket(
         packet.arrival_time_ms(), packet.payload_size() + packet.padding_size(),
-        header);
+        header, packet.ecn());
   }
 }
 
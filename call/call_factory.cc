@@ -14,11 +14,15 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "absl/types/optional.h"
 #include "api/test/simulated_network.h"
 #include "call/call.h"
 #include "call/degraded_call.h"
+#include "call/link_capacity_trace.h"
+#include "call/simulated_network.h"
+#include "call/trace_based_network.h"
 #include "rtc_base/checks.h"
 #include "system_wrappers/include/field_trial.h"
 
@@ -68,17 +72,39 @@ absl::optional<webrtc::BuiltInNetworkBehaviorConfig> ParseDegradationConfig(
              ? absl::optional<webrtc::BuiltInNetworkBehaviorConfig>(config)
              : absl::nullopt;
 }
+
+// Creates the network used to degrade one direction of the call, or null if
+// that direction isn't configured. A capacity trace, given as a
+// LinkCapacityTrace spec, replaces the fixed link capacity.
+std::unique_ptr<NetworkBehaviorInterface> CreateDegradedNetwork(bool send) {
+  std::string trace_spec = field_trial::FindFullName(
+      send ? "WebRTCFakeNetworkSendCapacityTrace"
+           : "WebRTCFakeNetworkReceiveCapacityTrace");
+  absl::optional<webrtc::BuiltInNetworkBehaviorConfig> config =
+      ParseDegradationConfig(send);
+  if (!trace_spec.empty()) {
+    absl::optional<LinkCapacityTrace> trace =
+        LinkCapacityTrace::FromSpec(trace_spec);
+    RTC_CHECK(trace) << "Invalid capacity trace: " << trace_spec;
+    return std::make_unique<TraceBasedNetwork>(
+        *trace, config.value_or(webrtc::BuiltInNetworkBehaviorConfig()));
+  }
+  if (config)
+    return std::make_unique<SimulatedNetwork>(*config);
+  return nullptr;
+}
 }  // namespace
 
 Call* CallFactory::CreateCall(const Call::Config& config) {
-  absl::optional<webrtc::BuiltInNetworkBehaviorConfig> send_degradation_config =
-      ParseDegradationConfig(true);
-  absl::optional<webrtc::BuiltInNetworkBehaviorConfig>
-      receive_degradation_config = ParseDegradationConfig(false);
+  std::unique_ptr<NetworkBehaviorInterface> send_network =
+      CreateDegradedNetwork(true);
+  std::unique_ptr<NetworkBehaviorInterface> receive_network =
+      CreateDegradedNetwork(false);
 
-  if (send_degradation_config || receive_degradation_config) {
+  if (send_network || receive_network) {
     return new DegradedCall(std::unique_ptr<Call>(Call::Create(config)),
-                            send_degradation_config, receive_degradation_config,
+                            std::move(send_network),
+                            std::move(receive_network),
                             config.task_queue_factory);
   }
 
@@ -0,0 +1,162 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "api/rtc_event_log/rtc_event_log.h"
+#include "api/task_queue/default_task_queue_factory.h"
+#include "api/test/mock_audio_mixer.h"
+#include "api/transport/field_trial_based_config.h"
+#include "call/audio_receive_stream.h"
+#include "call/audio_state.h"
+#include "call/call.h"
+#include "modules/audio_device/include/mock_audio_device.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/mock_transport.h"
+#include "test/run_loop.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kRemoteSsrc = 0x1234;
+constexpr int kPayloadType = 0;  // PCMU.
+constexpr int kTransportSequenceNumberId = 1;
+constexpr int kAbsSendTimeId = 2;
+constexpr size_t kPayloadSize = 160;
+constexpr int kNumPackets = 20000;
+
+// Loopback call receiving a single audio stream, used to compare the cost of
+// delivering raw packets with delivering packets already parsed by the
+// transport.
+class LoopbackAudioReceiveCall {
+ public:
+  LoopbackAudioReceiveCall()
+      : task_queue_factory_(CreateDefaultTaskQueueFactory()) {
+    AudioState::Config audio_state_config;
+    audio_state_config.audio_mixer =
+        new rtc::RefCountedObject<test::MockAudioMixer>();
+    audio_state_config.audio_device_module =
+        new rtc::RefCountedObject<test::MockAudioDeviceModule>();
+    Call::Config config(&event_log_);
+    config.audio_state = AudioState::Create(audio_state_config);
+    config.task_queue_factory = task_queue_factory_.get();
+    config.trials = &field_trials_;
+    call_.reset(Call::Create(config));
+
+    AudioReceiveStream::Config stream_config;
+    stream_config.rtp.remote_ssrc = kRemoteSsrc;
+    stream_config.rtp.transport_cc = true;
+    stream_config.rtp.extensions = {
+        RtpExtension(RtpExtension::kTransportSequenceNumberUri,
+                     kTransportSequenceNumberId),
+        RtpExtension(RtpExtension::kAbsSendTimeUri, kAbsSendTimeId)};
+    stream_config.rtcp_send_transport = &rtcp_send_transport_;
+    stream_config.decoder_factory = CreateBuiltinAudioDecoderFactory();
+    stream_config.decoder_map = {{kPayloadType, {"PCMU", 8000, 1}}};
+    receive_stream_ = call_->CreateAudioReceiveStream(stream_config);
+  }
+
+  ~LoopbackAudioReceiveCall() {
+    call_->DestroyAudioReceiveStream(receive_stream_);
+  }
+
+  PacketReceiver* receiver() { return call_->Receiver(); }
+
+ private:
+  test::RunLoop loop_;
+  RtcEventLogNull event_log_;
+  FieldTrialBasedConfig field_trials_;
+  MockTransport rtcp_send_transport_;
+  std::unique_ptr<TaskQueueFactory> task_queue_factory_;
+  std::unique_ptr<Call> call_;
+  AudioReceiveStream* receive_stream_ = nullptr;
+};
+
+std::vector<RtpPacketReceived> CreatePackets(int64_t first_arrival_time_ms) {
+  RtpHeaderExtensionMap extensions;
+  extensions.Register<TransportSequenceNumber>(kTransportSequenceNumberId);
+  extensions.Register<AbsoluteSendTime>(kAbsSendTimeId);
+  std::vector<RtpPacketReceived> packets;
+  packets.reserve(kNumPackets);
+  for (int i = 0; i < kNumPackets; ++i) {
+    RtpPacketToSend packet(&extensions);
+    packet.SetPayloadType(kPayloadType);
+    packet.SetSequenceNumber(static_cast<uint16_t>(i));
+    packet.SetTimestamp(i * kPayloadSize);
+    packet.SetSsrc(kRemoteSsrc);
+    packet.SetExtension<TransportSequenceNumber>(static_cast<uint16_t>(i));
+    packet.SetExtension<AbsoluteSendTime>(
+        AbsoluteSendTime::MsTo24Bits(first_arrival_time_ms + 20 * i));
+    packet.AllocatePayload(kPayloadSize);
+
+    RtpPacketReceived received(&extensions);
+    RTC_CHECK(received.Parse(packet.Buffer()));
+    received.set_arrival_time_ms(first_arrival_time_ms + 20 * i);
+    packets.push_back(std::move(received));
+  }
+  return packets;
+}
+
+void ReportResults(const std::string& modifier,
+                   int64_t cpu_time_ns,
+                   int64_t wall_time_ns) {
+  test::PrintResult("rtp_receive_cpu_time_per_packet_", modifier,
+                    "loopback_audio_call",
+                    static_cast<double>(cpu_time_ns) / kNumPackets / 1000.0,
+                    "us", false, test::ImproveDirection::kSmallerIsBetter);
+  test::PrintResult("rtp_receive_latency_per_packet_", modifier,
+                    "loopback_audio_call",
+                    static_cast<double>(wall_time_ns) / kNumPackets / 1000.0,
+                    "us", false, test::ImproveDirection::kSmallerIsBetter);
+}
+
+}  // namespace
+
+// Measures the per-packet cost of Call receive processing when the call has to
+// parse the raw packet, versus when the transport hands over the packet it has
+// already parsed.
+TEST(CallReceivePerfTest, DeliverRawVersusParsedRtpPackets) {
+  LoopbackAudioReceiveCall call;
+  std::vector<RtpPacketReceived> packets =
+      CreatePackets(rtc::TimeMillis());
+
+  int64_t start_cpu_ns = rtc::GetThreadCpuTimeNanos();
+  int64_t start_wall_ns = rtc::TimeNanos();
+  for (const RtpPacketReceived& packet : packets) {
+    EXPECT_EQ(PacketReceiver::DELIVERY_OK,
+              call.receiver()->DeliverPacket(MediaType::AUDIO, packet.Buffer(),
+                                             packet.arrival_time_ms() * 1000));
+  }
+  ReportResults("raw_packet", rtc::GetThreadCpuTimeNanos() - start_cpu_ns,
+                rtc::TimeNanos() - start_wall_ns);
+
+  LoopbackAudioReceiveCall parsed_call;
+  packets = CreatePackets(rtc::TimeMillis());
+  start_cpu_ns = rtc::GetThreadCpuTimeNanos();
+  start_wall_ns = rtc::TimeNanos();
+  for (RtpPacketReceived& packet : packets) {
+    EXPECT_EQ(PacketReceiver::DELIVERY_OK,
+              parsed_call.receiver()->DeliverRtpPacket(MediaType::AUDIO,
+                                                       std::move(packet)));
+  }
+  ReportResults("parsed_packet", rtc::GetThreadCpuTimeNanos() - start_cpu_ns,
+                rtc::TimeNanos() - start_wall_ns);
+}
+
+}  // namespace webrtc
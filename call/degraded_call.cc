@@ -127,27 +127,20 @@ bool DegradedCall::FakeNetworkPipeTransportAdapter::SendRtcp(
 
 DegradedCall::DegradedCall(
     std::unique_ptr<Call> call,
-    absl::optional<BuiltInNetworkBehaviorConfig> send_config,
-    absl::optional<BuiltInNetworkBehaviorConfig> receive_config,
+    std::unique_ptr<NetworkBehaviorInterface> send_network,
+    std::unique_ptr<NetworkBehaviorInterface> receive_network,
     TaskQueueFactory* task_queue_factory)
     : clock_(Clock::GetRealTimeClock()),
       call_(std::move(call)),
-      task_queue_factory_(task_queue_factory),
-      send_config_(send_config),
-      send_simulated_network_(nullptr),
-      receive_config_(receive_config) {
-  if (receive_config_) {
-    auto network = std::make_unique<SimulatedNetwork>(*receive_config_);
-    receive_simulated_network_ = network.get();
-    receive_pipe_ =
-        std::make_unique<webrtc::FakeNetworkPipe>(clock_, std::move(network));
+      task_queue_factory_(task_queue_factory) {
+  if (receive_network) {
+    receive_pipe_ = std::make_unique<webrtc::FakeNetworkPipe>(
+        clock_, std::move(receive_network));
     receive_pipe_->SetReceiver(call_->Receiver());
   }
-  if (send_config_) {
-    auto network = std::make_unique<SimulatedNetwork>(*send_config_);
-    send_simulated_network_ = network.get();
+  if (send_network) {
     send_pipe_ = std::make_unique<FakeNetworkPipeOnTaskQueue>(
-        task_queue_factory_, clock_, std::move(network));
+        task_queue_factory_, clock_, std::move(send_network));
   }
 }
 
@@ -155,7 +148,7 @@ DegradedCall::~DegradedCall() = default;
 
 AudioSendStream* DegradedCall::CreateAudioSendStream(
     const AudioSendStream::Config& config) {
-  if (send_config_) {
+  if (send_pipe_) {
     auto transport_adapter = std::make_unique<FakeNetworkPipeTransportAdapter>(
         send_pipe_.get(), call_.get(), clock_, config.send_transport);
     AudioSendStream::Config degrade_config = config;
@@ -189,7 +182,7 @@ VideoSendStream* DegradedCall::CreateVideoSendStream(
     VideoSendStream::Config config,
     VideoEncoderConfig encoder_config) {
   std::unique_ptr<FakeNetworkPipeTransportAdapter> transport_adapter;
-  if (send_config_) {
+  if (send_pipe_) {
     transport_adapter = std::make_unique<FakeNetworkPipeTransportAdapter>(
         send_pipe_.get(), call_.get(), clock_, config.send_transport);
     config.send_transport = transport_adapter.get();
@@ -207,7 +200,7 @@ VideoSendStream* DegradedCall::CreateVideoSendStream(
     VideoEncoderConfig encoder_config,
     std::unique_ptr<FecController> fec_controller) {
   std::unique_ptr<FakeNetworkPipeTransportAdapter> transport_adapter;
-  if (send_config_) {
+  if (send_pipe_) {
     transport_adapter = std::make_unique<FakeNetworkPipeTransportAdapter>(
         send_pipe_.get(), call_.get(), clock_, config.send_transport);
     config.send_transport = transport_adapter.get();
@@ -246,7 +239,7 @@ void DegradedCall::DestroyFlexfecReceiveStream(
 }
 
 PacketReceiver* DegradedCall::Receiver() {
-  if (receive_config_) {
+  if (receive_pipe_) {
     return this;
   }
   return call_->Receiver();
@@ -272,7 +265,7 @@ void DegradedCall::OnAudioTransportOverheadChanged(
 }
 
 void DegradedCall::OnSentPacket(const rtc::SentPacket& sent_packet) {
-  if (send_config_) {
+  if (send_pipe_) {
     // If we have a degraded send-transport, we have already notified call
     // about the supposed network send time. Discard the actual network send
     // time in order to properly fool the BWE.
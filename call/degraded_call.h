@@ -31,7 +31,6 @@
 #include "call/flexfec_receive_stream.h"
 #include "call/packet_receiver.h"
 #include "call/rtp_transport_controller_send_interface.h"
-#include "call/simulated_network.h"
 #include "call/video_receive_stream.h"
 #include "call/video_send_stream.h"
 #include "modules/utility/include/process_thread.h"
@@ -43,11 +42,13 @@
 namespace webrtc {
 class DegradedCall : public Call, private PacketReceiver {
  public:
-  explicit DegradedCall(
-      std::unique_ptr<Call> call,
-      absl::optional<BuiltInNetworkBehaviorConfig> send_config,
-      absl::optional<BuiltInNetworkBehaviorConfig> receive_config,
-      TaskQueueFactory* task_queue_factory);
+  // Packets sent and received by |call| pass through |send_network| and
+  // |receive_network| respectively. Either may be null, in which case that
+  // direction isn't degraded.
+  DegradedCall(std::unique_ptr<Call> call,
+               std::unique_ptr<NetworkBehaviorInterface> send_network,
+               std::unique_ptr<NetworkBehaviorInterface> receive_network,
+               TaskQueueFactory* task_queue_factory);
   ~DegradedCall() override;
 
   // Implements Call.
@@ -153,16 +154,12 @@ class DegradedCall : public Call, private PacketReceiver {
   void SetClientBitratePreferences(
       const webrtc::BitrateSettings& preferences) override {}
 
-  const absl::optional<BuiltInNetworkBehaviorConfig> send_config_;
-  SimulatedNetwork* send_simulated_network_;
   std::unique_ptr<FakeNetworkPipeOnTaskQueue> send_pipe_;
   std::map<AudioSendStream*, std::unique_ptr<FakeNetworkPipeTransportAdapter>>
       audio_send_transport_adapters_;
   std::map<VideoSendStream*, std::unique_ptr<FakeNetworkPipeTransportAdapter>>
       video_send_transport_adapters_;
 
-  const absl::optional<BuiltInNetworkBehaviorConfig> receive_config_;
-  SimulatedNetwork* receive_simulated_network_;
   std::unique_ptr<FakeNetworkPipe> receive_pipe_;
 };
 
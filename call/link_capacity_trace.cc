@@ -0,0 +1,222 @@
+/*
+ *  Copyright 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/link_capacity_trace.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/string_encode.h"
+#include "rtc_base/string_to_number.h"
+#include "rtc_base/string_utils.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/system/file_wrapper.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int64_t kBitsPerOpportunity =
+    LinkCapacityTrace::kBytesPerOpportunity * 8;
+
+// Turns a piecewise description of the link rate into delivery opportunities.
+// Capacity that doesn't add up to a full opportunity carries over to the next
+// millisecond, so that low rates are represented accurately.
+class OpportunityGenerator {
+ public:
+  void AddMillisecond(DataRate rate) {
+    RTC_CHECK(rate.IsFinite());
+    ++time_ms_;
+    // In bits per second times milliseconds, to avoid rounding.
+    credit_ += rate.bps();
+    while (credit_ >= kBitsPerOpportunity * 1000) {
+      opportunities_ms_.push_back(time_ms_);
+      credit_ -= kBitsPerOpportunity * 1000;
+    }
+  }
+
+  void Add(DataRate rate, TimeDelta duration) {
+    RTC_CHECK(duration.IsFinite());
+    for (int64_t i = 0; i < duration.ms(); ++i)
+      AddMillisecond(rate);
+  }
+
+  int64_t time_ms() const { return time_ms_; }
+  std::vector<int64_t> TakeOpportunities() {
+    return std::move(opportunities_ms_);
+  }
+
+ private:
+  std::vector<int64_t> opportunities_ms_;
+  int64_t time_ms_ = 0;
+  int64_t credit_ = 0;
+};
+
+absl::optional<DataRate> ParseRate(const std::string& kbps) {
+  absl::optional<int64_t> value = rtc::StringToNumber<int64_t>(kbps);
+  if (!value || *value < 0)
+    return absl::nullopt;
+  return DataRate::KilobitsPerSec(*value);
+}
+
+absl::optional<TimeDelta> ParseDuration(const std::string& ms) {
+  absl::optional<int64_t> value = rtc::StringToNumber<int64_t>(ms);
+  if (!value || *value <= 0)
+    return absl::nullopt;
+  return TimeDelta::Millis(*value);
+}
+
+}  // namespace
+
+LinkCapacityTrace::LinkCapacityTrace(std::vector<int64_t> opportunities_ms,
+                                     int64_t period_ms)
+    : opportunities_ms_(std::move(opportunities_ms)), period_ms_(period_ms) {
+  RTC_CHECK_GT(period_ms_, 0);
+}
+
+LinkCapacityTrace::LinkCapacityTrace(const LinkCapacityTrace&) = default;
+LinkCapacityTrace::LinkCapacityTrace(LinkCapacityTrace&&) = default;
+LinkCapacityTrace& LinkCapacityTrace::operator=(const LinkCapacityTrace&) =
+    default;
+LinkCapacityTrace& LinkCapacityTrace::operator=(LinkCapacityTrace&&) = default;
+LinkCapacityTrace::~LinkCapacityTrace() = default;
+
+absl::optional<LinkCapacityTrace> LinkCapacityTrace::ParseMahimahi(
+    const std::string& trace) {
+  std::vector<std::string> lines;
+  rtc::split(trace, '\n', &lines);
+  std::vector<int64_t> opportunities_ms;
+  for (const std::string& line : lines) {
+    std::string entry = rtc::string_trim(line);
+    if (entry.empty())
+      continue;
+    absl::optional<int64_t> time_ms = rtc::StringToNumber<int64_t>(entry);
+    if (!time_ms || *time_ms < 0)
+      return absl::nullopt;
+    if (!opportunities_ms.empty() && *time_ms < opportunities_ms.back())
+      return absl::nullopt;
+    opportunities_ms.push_back(*time_ms);
+  }
+  if (opportunities_ms.empty() || opportunities_ms.back() <= 0)
+    return absl::nullopt;
+  int64_t period_ms = opportunities_ms.back();
+  return LinkCapacityTrace(std::move(opportunities_ms), period_ms);
+}
+
+absl::optional<LinkCapacityTrace> LinkCapacityTrace::LoadMahimahiFile(
+    const std::string& path) {
+  FileWrapper file = FileWrapper::OpenReadOnly(path);
+  if (!file.is_open())
+    return absl::nullopt;
+  std::string contents;
+  char buffer[4096];
+  size_t read;
+  while ((read = file.Read(buffer, sizeof(buffer))) > 0)
+    contents.append(buffer, read);
+  return ParseMahimahi(contents);
+}
+
+LinkCapacityTrace LinkCapacityTrace::Constant(DataRate rate) {
+  // Long enough for the rate to be matched exactly for any whole kbps value.
+  return Steps({{rate, TimeDelta::Seconds(12)}});
+}
+
+LinkCapacityTrace LinkCapacityTrace::Steps(
+    const std::vector<std::pair<DataRate, TimeDelta>>& steps) {
+  OpportunityGenerator generator;
+  for (const auto& step : steps)
+    generator.Add(step.first, step.second);
+  int64_t period_ms = generator.time_ms();
+  return LinkCapacityTrace(generator.TakeOpportunities(), period_ms);
+}
+
+LinkCapacityTrace LinkCapacityTrace::SquareWave(DataRate high,
+                                                DataRate low,
+                                                TimeDelta half_period) {
+  return Steps({{high, half_period}, {low, half_period}});
+}
+
+LinkCapacityTrace LinkCapacityTrace::Ramp(DataRate from,
+                                          DataRate to,
+                                          TimeDelta duration) {
+  RTC_CHECK(duration.IsFinite());
+  OpportunityGenerator generator;
+  const int64_t duration_ms = duration.ms();
+  for (int64_t i = 0; i < duration_ms; ++i) {
+    generator.AddMillisecond(DataRate::BitsPerSec(
+        from.bps() + (to.bps() - from.bps()) * i / duration_ms));
+  }
+  return LinkCapacityTrace(generator.TakeOpportunities(), duration_ms);
+}
+
+LinkCapacityTrace LinkCapacityTrace::Outage(DataRate rate,
+                                            TimeDelta up_time,
+                                            TimeDelta down_time) {
+  return Steps({{rate, up_time}, {DataRate::Zero(), down_time}});
+}
+
+absl::optional<LinkCapacityTrace> LinkCapacityTrace::FromSpec(
+    const std::string& spec) {
+  const std::string kFilePrefix = "file:";
+  if (spec.compare(0, kFilePrefix.size(), kFilePrefix) == 0)
+    return LoadMahimahiFile(spec.substr(kFilePrefix.size()));
+
+  std::vector<std::string> fields;
+  rtc::split(spec, ':', &fields);
+  const std::string& type = fields[0];
+  if (type == "constant" && fields.size() == 2) {
+    absl::optional<DataRate> rate = ParseRate(fields[1]);
+    if (rate)
+      return Constant(*rate);
+  } else if (type == "steps" && fields.size() >= 3 && fields.size() % 2 == 1) {
+    std::vector<std::pair<DataRate, TimeDelta>> steps;
+    for (size_t i = 1; i < fields.size(); i += 2) {
+      absl::optional<DataRate> rate = ParseRate(fields[i]);
+      absl::optional<TimeDelta> duration = ParseDuration(fields[i + 1]);
+      if (!rate || !duration)
+        return absl::nullopt;
+      steps.emplace_back(*rate, *duration);
+    }
+    return Steps(steps);
+  } else if (type == "square" && fields.size() == 4) {
+    absl::optional<DataRate> high = ParseRate(fields[1]);
+    absl::optional<DataRate> low = ParseRate(fields[2]);
+    absl::optional<TimeDelta> half_period = ParseDuration(fields[3]);
+    if (high && low && half_period)
+      return SquareWave(*high, *low, *half_period);
+  } else if (type == "ramp" && fields.size() == 4) {
+    absl::optional<DataRate> from = ParseRate(fields[1]);
+    absl::optional<DataRate> to = ParseRate(fields[2]);
+    absl::optional<TimeDelta> duration = ParseDuration(fields[3]);
+    if (from && to && duration)
+      return Ramp(*from, *to, *duration);
+  } else if (type == "outage" && fields.size() == 4) {
+    absl::optional<DataRate> rate = ParseRate(fields[1]);
+    absl::optional<TimeDelta> up_time = ParseDuration(fields[2]);
+    absl::optional<TimeDelta> down_time = ParseDuration(fields[3]);
+    if (rate && up_time && down_time)
+      return Outage(*rate, *up_time, *down_time);
+  }
+  return absl::nullopt;
+}
+
+DataRate LinkCapacityTrace::AverageRate() const {
+  int64_t num_opportunities = opportunities_ms_.size();
+  return DataRate::BitsPerSec(num_opportunities * kBitsPerOpportunity * 1000 /
+                              period_ms_);
+}
+
+std::string LinkCapacityTrace::ToMahimahi() const {
+  rtc::StringBuilder trace;
+  for (int64_t time_ms : opportunities_ms_)
+    trace << time_ms << "\n";
+  return trace.Release();
+}
+
+}  // namespace webrtc
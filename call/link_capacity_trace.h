@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef CALL_LINK_CAPACITY_TRACE_H_
+#define CALL_LINK_CAPACITY_TRACE_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
+
+namespace webrtc {
+
+// Link capacity described as a list of packet delivery opportunities, using
+// the same semantics as Mahimahi link traces: every entry is a timestamp in
+// milliseconds, relative to the start of the trace, at which the link may
+// deliver kBytesPerOpportunity bytes. Several entries may share a timestamp.
+// The trace repeats with a period of period_ms().
+class LinkCapacityTrace {
+ public:
+  static constexpr int kBytesPerOpportunity = 1500;
+
+  // Parses a Mahimahi trace: one non-decreasing integer timestamp per line.
+  // The period of the trace is its last timestamp, which must be positive.
+  static absl::optional<LinkCapacityTrace> ParseMahimahi(
+      const std::string& trace);
+  static absl::optional<LinkCapacityTrace> LoadMahimahiFile(
+      const std::string& path);
+
+  // Synthetic traces. Opportunities are spread over each millisecond so that
+  // the average rate matches the requested rate.
+  static LinkCapacityTrace Constant(DataRate rate);
+  // Plays each (rate, duration) step in turn before starting over.
+  static LinkCapacityTrace Steps(
+      const std::vector<std::pair<DataRate, TimeDelta>>& steps);
+  static LinkCapacityTrace SquareWave(DataRate high,
+                                      DataRate low,
+                                      TimeDelta half_period);
+  // Changes the rate linearly from |from| to |to| over |duration|.
+  static LinkCapacityTrace Ramp(DataRate from, DataRate to, TimeDelta duration);
+  // Alternates between |rate| during |up_time| and no capacity during
+  // |down_time|.
+  static LinkCapacityTrace Outage(DataRate rate,
+                                  TimeDelta up_time,
+                                  TimeDelta down_time);
+
+  // Creates a trace from a compact description, as used by field trials.
+  // Rates are in kbps and durations in milliseconds:
+  //   constant:<rate>
+  //   steps:<rate>:<duration>[:<rate>:<duration>...]
+  //   square:<high rate>:<low rate>:<half period>
+  //   ramp:<from rate>:<to rate>:<duration>
+  //   outage:<rate>:<up time>:<down time>
+  //   file:<path to Mahimahi trace>
+  static absl::optional<LinkCapacityTrace> FromSpec(const std::string& spec);
+
+  LinkCapacityTrace(const LinkCapacityTrace&);
+  LinkCapacityTrace(LinkCapacityTrace&&);
+  LinkCapacityTrace& operator=(const LinkCapacityTrace&);
+  LinkCapacityTrace& operator=(LinkCapacityTrace&&);
+  ~LinkCapacityTrace();
+
+  const std::vector<int64_t>& opportunities_ms() const {
+    return opportunities_ms_;
+  }
+  int64_t period_ms() const { return period_ms_; }
+  // Average capacity over one period of the trace.
+  DataRate AverageRate() const;
+
+  // Serializes the trace in Mahimahi format. Trailing time without any
+  // opportunities is lost, as Mahimahi takes the last entry as the period.
+  std::string ToMahimahi() const;
+
+ private:
+  LinkCapacityTrace(std::vector<int64_t> opportunities_ms, int64_t period_ms);
+
+  std::vector<int64_t> opportunities_ms_;
+  int64_t period_ms_;
+};
+
+}  // namespace webrtc
+
+#endif  // CALL_LINK_CAPACITY_TRACE_H_
@@ -0,0 +1,148 @@
+/*
+ *  Copyright 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "call/link_capacity_trace.h"
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+
+using ::testing::ElementsAre;
+
+TEST(LinkCapacityTraceTest, ParsesMahimahiTrace) {
+  absl::optional<LinkCapacityTrace> trace =
+      LinkCapacityTrace::ParseMahimahi("1\n1\n3\r\n\n7\n");
+  ASSERT_TRUE(trace);
+  EXPECT_THAT(trace->opportunities_ms(), ElementsAre(1, 1, 3, 7));
+  EXPECT_EQ(trace->period_ms(), 7);
+  // 4 * 1500 bytes over 7 ms.
+  EXPECT_EQ(trace->AverageRate().bps(), 4 * 12000 * 1000 / 7);
+}
+
+TEST(LinkCapacityTraceTest, RejectsInvalidMahimahiTraces) {
+  EXPECT_FALSE(LinkCapacityTrace::ParseMahimahi(""));
+  EXPECT_FALSE(LinkCapacityTrace::ParseMahimahi("0\n0\n"));
+  EXPECT_FALSE(LinkCapacityTrace::ParseMahimahi("5\n3\n"));
+  EXPECT_FALSE(LinkCapacityTrace::ParseMahimahi("1\n-2\n"));
+  EXPECT_FALSE(LinkCapacityTrace::ParseMahimahi("1\nabc\n"));
+}
+
+TEST(LinkCapacityTraceTest, LoadsMahimahiFile) {
+  std::string path = test::TempFilename(test::OutputPath(), "mahimahi_trace");
+  FILE* file = fopen(path.c_str(), "w");
+  ASSERT_TRUE(file);
+  fputs("2\n4\n4\n", file);
+  fclose(file);
+
+  absl::optional<LinkCapacityTrace> trace =
+      LinkCapacityTrace::LoadMahimahiFile(path);
+  ASSERT_TRUE(trace);
+  EXPECT_THAT(trace->opportunities_ms(), ElementsAre(2, 4, 4));
+  EXPECT_EQ(trace->period_ms(), 4);
+  remove(path.c_str());
+
+  EXPECT_FALSE(LinkCapacityTrace::LoadMahimahiFile(path));
+}
+
+TEST(LinkCapacityTraceTest, ConstantTraceMatchesRate) {
+  for (int kbps : {1, 300, 1000, 12000, 25000}) {
+    LinkCapacityTrace trace =
+        LinkCapacityTrace::Constant(DataRate::KilobitsPerSec(kbps));
+    EXPECT_EQ(trace.AverageRate().kbps(), kbps);
+  }
+  // 12 Mbps is exactly one opportunity per millisecond.
+  LinkCapacityTrace trace =
+      LinkCapacityTrace::Constant(DataRate::KilobitsPerSec(12000));
+  for (size_t i = 0; i < trace.opportunities_ms().size(); ++i)
+    EXPECT_EQ(trace.opportunities_ms()[i], static_cast<int64_t>(i + 1));
+}
+
+TEST(LinkCapacityTraceTest, SyntheticTraces) {
+  LinkCapacityTrace square = LinkCapacityTrace::SquareWave(
+      DataRate::KilobitsPerSec(3000), DataRate::KilobitsPerSec(1000),
+      TimeDelta::Seconds(3));
+  EXPECT_EQ(square.period_ms(), 6000);
+  EXPECT_EQ(square.AverageRate().kbps(), 2000);
+  // All of the low capacity opportunities are in the second half.
+  EXPECT_EQ(square.opportunities_ms()[749], 3000);
+  EXPECT_GT(square.opportunities_ms()[750], 3000);
+
+  LinkCapacityTrace outage = LinkCapacityTrace::Outage(
+      DataRate::KilobitsPerSec(1200), TimeDelta::Seconds(1),
+      TimeDelta::Seconds(1));
+  EXPECT_EQ(outage.period_ms(), 2000);
+  EXPECT_EQ(outage.AverageRate().kbps(), 600);
+  EXPECT_LE(outage.opportunities_ms().back(), 1000);
+
+  LinkCapacityTrace ramp =
+      LinkCapacityTrace::Ramp(DataRate::KilobitsPerSec(0),
+                              DataRate::KilobitsPerSec(2000),
+                              TimeDelta::Seconds(12));
+  EXPECT_EQ(ramp.period_ms(), 12000);
+  EXPECT_NEAR(ramp.AverageRate().kbps(), 1000, 1);
+
+  LinkCapacityTrace steps = LinkCapacityTrace::Steps(
+      {{DataRate::KilobitsPerSec(120), TimeDelta::Millis(500)},
+       {DataRate::KilobitsPerSec(240), TimeDelta::Millis(500)}});
+  EXPECT_THAT(steps.opportunities_ms(),
+              ElementsAre(100, 200, 300, 400, 500, 550, 600, 650, 700, 750,
+                          800, 850, 900, 950, 1000));
+}
+
+TEST(LinkCapacityTraceTest, ParsesSpec) {
+  absl::optional<LinkCapacityTrace> trace =
+      LinkCapacityTrace::FromSpec("constant:500");
+  ASSERT_TRUE(trace);
+  EXPECT_EQ(trace->AverageRate().kbps(), 500);
+
+  trace = LinkCapacityTrace::FromSpec("steps:120:500:240:500");
+  ASSERT_TRUE(trace);
+  EXPECT_EQ(trace->period_ms(), 1000);
+  EXPECT_EQ(trace->opportunities_ms().size(), 15u);
+
+  trace = LinkCapacityTrace::FromSpec("square:3000:1000:3000");
+  ASSERT_TRUE(trace);
+  EXPECT_EQ(trace->AverageRate().kbps(), 2000);
+
+  trace = LinkCapacityTrace::FromSpec("ramp:0:2000:12000");
+  ASSERT_TRUE(trace);
+  EXPECT_EQ(trace->period_ms(), 12000);
+
+  trace = LinkCapacityTrace::FromSpec("outage:1200:1000:1000");
+  ASSERT_TRUE(trace);
+  EXPECT_EQ(trace->AverageRate().kbps(), 600);
+
+  EXPECT_FALSE(LinkCapacityTrace::FromSpec(""));
+  EXPECT_FALSE(LinkCapacityTrace::FromSpec("constant"));
+  EXPECT_FALSE(LinkCapacityTrace::FromSpec("constant:-1"));
+  EXPECT_FALSE(LinkCapacityTrace::FromSpec("steps:100"));
+  EXPECT_FALSE(LinkCapacityTrace::FromSpec("square:3000:1000:0"));
+  EXPECT_FALSE(LinkCapacityTrace::FromSpec("sine:1000"));
+  EXPECT_FALSE(LinkCapacityTrace::FromSpec("file:/nonexistent/trace"));
+}
+
+TEST(LinkCapacityTraceTest, MahimahiRoundTrip) {
+  LinkCapacityTrace trace = LinkCapacityTrace::SquareWave(
+      DataRate::KilobitsPerSec(2400), DataRate::KilobitsPerSec(600),
+      TimeDelta::Millis(100));
+  absl::optional<LinkCapacityTrace> parsed =
+      LinkCapacityTrace::ParseMahimahi(trace.ToMahimahi());
+  ASSERT_TRUE(parsed);
+  EXPECT_EQ(parsed->opportunities_ms(), trace.opportunities_ms());
+  EXPECT_EQ(parsed->period_ms(), trace.period_ms());
+}
+
+}  // namespace webrtc
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "api/media_types.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "rtc_base/copy_on_write_buffer.h"
 
 namespace webrtc {
@@ -32,6 +33,18 @@ class PacketReceiver {
                                        rtc::CopyOnWriteBuffer packet,
                                        int64_t packet_time_us) = 0;
 
+  // Delivers an RTP packet that has already been parsed by the transport, so
+  // that the receiver does not have to parse it again. The arrival time of
+  // |packet| is used as receive time; an arrival time of zero or less means
+  // that it is unknown. Header extensions are re-identified by the receiver
+  // according to the configuration of the receive stream.
+  virtual DeliveryStatus DeliverRtpPacket(MediaType media_type,
+                                          RtpPacketReceived packet) {
+    const int64_t packet_time_us =
+        packet.arrival_time_ms() > 0 ? packet.arrival_time_ms() * 1000 : -1;
+    return DeliverPacket(media_type, packet.Buffer(), packet_time_us);
+  }
+
  protected:
   virtual ~PacketReceiver() {}
 };
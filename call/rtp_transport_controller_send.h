@@ -120,6 +120,8 @@ class RtpTransportControllerSend final
   // Implements TransportFeedbackObserver interface
   void OnAddPacket(const RtpPacketSendInfo& packet_info) override;
   void OnTransportFeedback(const rtcp::TransportFeedback& feedback) override;
+  void OnCongestionControlFeedback(
+      const rtcp::CongestionControlFeedback& feedback) override;
   void OnApplicationPacket(const rtcp::App& app) override;
 
   // Implements NetworkStateEstimateObserver interface
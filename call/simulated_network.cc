@@ -211,6 +211,12 @@ void SimulatedNetwork::UpdateCapacityQueue(ConfigState state,
     RTC_DCHECK(time_us >= packet.packet.send_time_us);
     packet.arrival_time_us =
         std::max(state.pause_transmission_until_us, time_us);
+    if (state.config.ecn_marking_threshold_ms > 0 &&
+        rtc::IsEcnCapable(packet.packet.ecn) &&
+        time_us - packet.packet.send_time_us >
+            state.config.ecn_marking_threshold_ms * 1000) {
+      packet.packet.ecn = rtc::EcnMarking::kCe;
+    }
     queue_size_bytes_ -= packet.packet.size;
     pending_drain_bits_ -= packet.packet.size * 8;
     RTC_DCHECK(pending_drain_bits_ >= 0);
@@ -146,4 +146,36 @@ TEST(SimulatedNetworkTest, CodelLimitsDelayAndDropsPacketsOnOverload) {
   }
   EXPECT_EQ(send_times_us.size(), 0u);
 }
+
+TEST(SimulatedNetworkTest, MarksEcnCapablePacketsQueuedAboveThreshold) {
+  SimulatedNetwork::Config config;
+  config.link_capacity_kbps = 1000;
+  config.ecn_marking_threshold_ms = 20;
+  SimulatedNetwork network(config);
+
+  // Each 1000 byte packet takes 8 ms on the link, so the third packet sent at
+  // once is the first to be queued for more than 20 ms.
+  for (uint64_t id = 0; id < 5; ++id) {
+    ASSERT_TRUE(network.EnqueuePacket(
+        PacketInFlightInfo(1000, 0, id, rtc::EcnMarking::kEct1)));
+  }
+  ASSERT_TRUE(network.EnqueuePacket(
+      PacketInFlightInfo(1000, 0, 5, rtc::EcnMarking::kNotEct)));
+
+  std::vector<PacketDeliveryInfo> delivered;
+  while (network.NextDeliveryTimeUs()) {
+    for (const PacketDeliveryInfo& packet :
+         network.DequeueDeliverablePackets(*network.NextDeliveryTimeUs())) {
+      delivered.push_back(packet);
+    }
+  }
+  ASSERT_EQ(delivered.size(), 6u);
+  EXPECT_EQ(delivered[0].ecn, rtc::EcnMarking::kEct1);
+  EXPECT_EQ(delivered[1].ecn, rtc::EcnMarking::kEct1);
+  EXPECT_EQ(delivered[2].ecn, rtc::EcnMarking::kCe);
+  EXPECT_EQ(delivered[3].ecn, rtc::EcnMarking::kCe);
+  EXPECT_EQ(delivered[4].ecn, rtc::EcnMarking::kCe);
+  // Packets that are not ECN-capable are never marked.
+  EXPECT_EQ(delivered[5].ecn, rtc::EcnMarking::kNotEct);
+}
 }  // namespace webrtc
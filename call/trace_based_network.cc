@@ -0,0 +1,250 @@
+/*
+ *  Copyright 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/trace_based_network.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+constexpr size_t kMinRingCapacity = 16;
+}  // namespace
+
+TraceBasedNetwork::PacketRing::PacketRing() = default;
+TraceBasedNetwork::PacketRing::~PacketRing() = default;
+
+void TraceBasedNetwork::PacketRing::push_back(const PacketInfo& packet) {
+  if (size_ == buffer_.size())
+    Reserve(std::max(kMinRingCapacity, 2 * buffer_.size()));
+  buffer_[(head_ + size_) & (buffer_.size() - 1)] = packet;
+  ++size_;
+}
+
+void TraceBasedNetwork::PacketRing::pop_front() {
+  RTC_DCHECK(!empty());
+  head_ = (head_ + 1) & (buffer_.size() - 1);
+  --size_;
+}
+
+void TraceBasedNetwork::PacketRing::Reserve(size_t capacity) {
+  size_t new_size = kMinRingCapacity;
+  while (new_size < capacity)
+    new_size *= 2;
+  if (new_size <= buffer_.size())
+    return;
+  std::vector<PacketInfo> buffer(new_size);
+  for (size_t i = 0; i < size_; ++i)
+    buffer[i] = buffer_[(head_ + i) & (buffer_.size() - 1)];
+  buffer_.swap(buffer);
+  head_ = 0;
+}
+
+TraceBasedNetwork::TraceBasedNetwork(LinkCapacityTrace trace,
+                                     Config config,
+                                     uint64_t random_seed)
+    : trace_(std::move(trace)),
+      period_us_(trace_.period_ms() * 1000),
+      random_(random_seed) {
+  SetConfig(config);
+  capacity_link_.Reserve(config.queue_length_packets);
+}
+
+TraceBasedNetwork::~TraceBasedNetwork() = default;
+
+void TraceBasedNetwork::SetConfig(const Config& config) {
+  rtc::CritScope crit(&config_lock_);
+  config_state_.config = config;
+  double prob_loss = config.loss_percent / 100.0;
+  if (config.avg_burst_loss_length == -1) {
+    // Uniform loss
+    config_state_.prob_loss_bursting = prob_loss;
+    config_state_.prob_start_bursting = prob_loss;
+  } else {
+    // Lose packets according to a gilbert-elliot model.
+    int avg_burst_loss_length = config.avg_burst_loss_length;
+    int min_avg_burst_loss_length = std::ceil(prob_loss / (1 - prob_loss));
+
+    RTC_CHECK_GT(avg_burst_loss_length, min_avg_burst_loss_length)
+        << "For a total packet loss of " << config.loss_percent
+        << "%% then"
+           " avg_burst_loss_length must be "
+        << min_avg_burst_loss_length + 1 << " or higher.";
+
+    config_state_.prob_loss_bursting = (1.0 - 1.0 / avg_burst_loss_length);
+    config_state_.prob_start_bursting =
+        prob_loss / (1 - prob_loss) / avg_burst_loss_length;
+  }
+}
+
+void TraceBasedNetwork::UpdateConfig(
+    std::function<void(BuiltInNetworkBehaviorConfig*)> config_modifier) {
+  rtc::CritScope crit(&config_lock_);
+  config_modifier(&config_state_.config);
+}
+
+void TraceBasedNetwork::PauseTransmissionUntil(int64_t until_us) {
+  rtc::CritScope crit(&config_lock_);
+  config_state_.pause_transmission_until_us = until_us;
+}
+
+TraceBasedNetwork::ConfigState TraceBasedNetwork::GetConfigState() const {
+  rtc::CritScope crit(&config_lock_);
+  return config_state_;
+}
+
+int64_t TraceBasedNetwork::FirstOpportunityAtOrAfter(int64_t time_us) const {
+  const std::vector<int64_t>& opportunities_ms = trace_.opportunities_ms();
+  int64_t elapsed_us = std::max<int64_t>(time_us - *trace_start_us_, 0);
+  int64_t cycle = elapsed_us / period_us_;
+  int64_t offset_ms = (elapsed_us - cycle * period_us_ + 999) / 1000;
+  size_t index = std::lower_bound(opportunities_ms.begin(),
+                                  opportunities_ms.end(), offset_ms) -
+                 opportunities_ms.begin();
+  return cycle * opportunities_ms.size() + index;
+}
+
+int64_t TraceBasedNetwork::OpportunityTimeUs(int64_t index) const {
+  const std::vector<int64_t>& opportunities_ms = trace_.opportunities_ms();
+  const int64_t num_opportunities = opportunities_ms.size();
+  return *trace_start_us_ + (index / num_opportunities) * period_us_ +
+         opportunities_ms[index % num_opportunities] * 1000;
+}
+
+bool TraceBasedNetwork::EnqueuePacket(PacketInFlightInfo packet) {
+  RTC_DCHECK_RUNS_SERIALIZED(&process_checker_);
+  ConfigState state = GetConfigState();
+
+  if (!trace_start_us_)
+    trace_start_us_ = packet.send_time_us;
+  UpdateCapacityLink(state, packet.send_time_us);
+
+  packet.size += state.config.packet_overhead;
+
+  if (state.config.queue_length_packets > 0 &&
+      capacity_link_.size() >= state.config.queue_length_packets) {
+    // Too many packet on the link, drop this one.
+    return false;
+  }
+
+  if (capacity_link_.empty()) {
+    // Opportunities are wasted while there is nothing to send.
+    next_opportunity_ = FirstOpportunityAtOrAfter(packet.send_time_us);
+    front_bytes_left_ = packet.size;
+  }
+  capacity_link_.push_back(PacketInfo(packet, packet.send_time_us));
+  UpdateNextProcessTime(packet.send_time_us);
+  return true;
+}
+
+void TraceBasedNetwork::UpdateCapacityLink(const ConfigState& state,
+                                           int64_t time_now_us) {
+  // Catch for thread races.
+  if (time_now_us < last_capacity_link_visit_us_.value_or(time_now_us))
+    return;
+  last_capacity_link_visit_us_ = time_now_us;
+  if (trace_.opportunities_ms().empty())
+    return;
+
+  while (!capacity_link_.empty()) {
+    int64_t opportunity_time_us = OpportunityTimeUs(next_opportunity_);
+    if (opportunity_time_us > time_now_us)
+      break;
+    ++next_opportunity_;
+
+    int64_t budget = LinkCapacityTrace::kBytesPerOpportunity;
+    while (budget > 0 && !capacity_link_.empty()) {
+      int64_t sent = std::min(budget, front_bytes_left_);
+      budget -= sent;
+      front_bytes_left_ -= sent;
+      if (front_bytes_left_ > 0)
+        break;
+      PacketInfo packet = capacity_link_.front();
+      capacity_link_.pop_front();
+      if (!capacity_link_.empty())
+        front_bytes_left_ = capacity_link_.front().packet.size;
+      AddToDelayLink(state, packet, opportunity_time_us);
+    }
+  }
+}
+
+void TraceBasedNetwork::AddToDelayLink(const ConfigState& state,
+                                       PacketInfo packet,
+                                       int64_t exit_time_us) {
+  if (state.config.ecn_marking_threshold_ms > 0 &&
+      rtc::IsEcnCapable(packet.packet.ecn) &&
+      exit_time_us - packet.packet.send_time_us >
+          state.config.ecn_marking_threshold_ms * 1000) {
+    packet.packet.ecn = rtc::EcnMarking::kCe;
+  }
+  // Drop packets at an average rate of |state.config.loss_percent| with
+  // and average loss burst length of |state.config.avg_burst_loss_length|.
+  double loss_probability =
+      bursting_ ? state.prob_loss_bursting : state.prob_start_bursting;
+  if (loss_probability > 0 && random_.Rand<double>() < loss_probability) {
+    bursting_ = true;
+    packet.arrival_time_us = PacketDeliveryInfo::kNotReceived;
+    delay_link_.push_back(packet);
+    return;
+  }
+  bursting_ = false;
+
+  int64_t delay_us = state.config.queue_delay_ms * 1000;
+  if (state.config.delay_standard_deviation_ms > 0) {
+    delay_us = std::max(
+        random_.Gaussian(state.config.queue_delay_ms * 1000,
+                         state.config.delay_standard_deviation_ms * 1000),
+        0.0);
+  }
+  // Packets are kept in order, so they can't overtake the previous packet.
+  packet.arrival_time_us =
+      std::max(std::max(state.pause_transmission_until_us, exit_time_us) +
+                   delay_us,
+               last_arrival_time_us_);
+  last_arrival_time_us_ = packet.arrival_time_us;
+  delay_link_.push_back(packet);
+}
+
+void TraceBasedNetwork::UpdateNextProcessTime(int64_t time_now_us) {
+  if (!delay_link_.empty()) {
+    next_process_time_us_ =
+        std::max(delay_link_.front().arrival_time_us, time_now_us);
+  } else if (!capacity_link_.empty() && !trace_.opportunities_ms().empty()) {
+    next_process_time_us_ = OpportunityTimeUs(next_opportunity_);
+  } else {
+    next_process_time_us_.reset();
+  }
+}
+
+std::vector<PacketDeliveryInfo> TraceBasedNetwork::DequeueDeliverablePackets(
+    int64_t receive_time_us) {
+  RTC_DCHECK_RUNS_SERIALIZED(&process_checker_);
+  UpdateCapacityLink(GetConfigState(), receive_time_us);
+  std::vector<PacketDeliveryInfo> packets_to_deliver;
+  while (!delay_link_.empty() &&
+         receive_time_us >= delay_link_.front().arrival_time_us) {
+    const PacketInfo& packet_info = delay_link_.front();
+    packets_to_deliver.emplace_back(packet_info.packet,
+                                    packet_info.arrival_time_us);
+    delay_link_.pop_front();
+  }
+  UpdateNextProcessTime(receive_time_us);
+  return packets_to_deliver;
+}
+
+absl::optional<int64_t> TraceBasedNetwork::NextDeliveryTimeUs() const {
+  RTC_DCHECK_RUNS_SERIALIZED(&process_checker_);
+  return next_process_time_us_;
+}
+
+}  // namespace webrtc
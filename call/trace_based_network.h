@@ -0,0 +1,147 @@
+/*
+ *  Copyright 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef CALL_TRACE_BASED_NETWORK_H_
+#define CALL_TRACE_BASED_NETWORK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/test/simulated_network.h"
+#include "call/link_capacity_trace.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/race_checker.h"
+#include "rtc_base/random.h"
+#include "rtc_base/synchronization/sequence_checker.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Network link whose capacity follows a LinkCapacityTrace, in the way
+// Mahimahi emulates links: queued packets only leave the bottleneck at the
+// delivery opportunities of the trace, and capacity that isn't used at an
+// opportunity is lost. The trace starts with the first packet sent.
+//
+// Delay, jitter, loss, queue length, packet overhead and ECN marking are taken
+// from the BuiltInNetworkBehaviorConfig as in SimulatedNetwork. The link
+// capacity of the config is ignored, packets are never reordered and CoDel is
+// not supported.
+//
+// Packets are held in ring buffers that only grow to the peak queue length,
+// so that long runs at high packet rates don't allocate per packet.
+class TraceBasedNetwork : public SimulatedNetworkInterface {
+ public:
+  using Config = BuiltInNetworkBehaviorConfig;
+  TraceBasedNetwork(LinkCapacityTrace trace,
+                    Config config,
+                    uint64_t random_seed = 1);
+  ~TraceBasedNetwork() override;
+
+  // SimulatedNetworkInterface
+  void SetConfig(const Config& config) override;
+  void UpdateConfig(std::function<void(BuiltInNetworkBehaviorConfig*)>
+                        config_modifier) override;
+  void PauseTransmissionUntil(int64_t until_us) override;
+
+  // NetworkBehaviorInterface
+  bool EnqueuePacket(PacketInFlightInfo packet) override;
+  std::vector<PacketDeliveryInfo> DequeueDeliverablePackets(
+      int64_t receive_time_us) override;
+  absl::optional<int64_t> NextDeliveryTimeUs() const override;
+
+ private:
+  struct PacketInfo {
+    PacketInfo() : packet(0, 0, 0), arrival_time_us(0) {}
+    PacketInfo(PacketInFlightInfo packet, int64_t arrival_time_us)
+        : packet(packet), arrival_time_us(arrival_time_us) {}
+    PacketInFlightInfo packet;
+    int64_t arrival_time_us;
+  };
+
+  // FIFO queue of packets on top of a power-of-two sized ring buffer.
+  class PacketRing {
+   public:
+    PacketRing();
+    ~PacketRing();
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+    PacketInfo& front() { return buffer_[head_]; }
+    const PacketInfo& front() const { return buffer_[head_]; }
+    void push_back(const PacketInfo& packet);
+    void pop_front();
+    void Reserve(size_t capacity);
+
+   private:
+    std::vector<PacketInfo> buffer_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+  };
+
+  struct ConfigState {
+    Config config;
+    // The probability to drop the packet if we are currently dropping a
+    // burst of packet
+    double prob_loss_bursting = 0;
+    // The probability to drop a burst of packets.
+    double prob_start_bursting = 0;
+    // Used for temporary delay spikes.
+    int64_t pause_transmission_until_us = 0;
+  };
+
+  ConfigState GetConfigState() const;
+  // Returns the absolute index of the first delivery opportunity at or after
+  // |time_us|.
+  int64_t FirstOpportunityAtOrAfter(int64_t time_us) const
+      RTC_RUN_ON(&process_checker_);
+  int64_t OpportunityTimeUs(int64_t index) const
+      RTC_RUN_ON(&process_checker_);
+  // Lets the capacity link use all delivery opportunities up to |time_now_us|.
+  void UpdateCapacityLink(const ConfigState& state, int64_t time_now_us)
+      RTC_RUN_ON(&process_checker_);
+  void AddToDelayLink(const ConfigState& state,
+                      PacketInfo packet,
+                      int64_t exit_time_us) RTC_RUN_ON(&process_checker_);
+  void UpdateNextProcessTime(int64_t time_now_us)
+      RTC_RUN_ON(&process_checker_);
+
+  const LinkCapacityTrace trace_;
+  const int64_t period_us_;
+
+  rtc::CriticalSection config_lock_;
+  ConfigState config_state_ RTC_GUARDED_BY(config_lock_);
+
+  // |process_checker_| guards the data structures involved in delay and loss
+  // processes, such as the packet queues.
+  rtc::RaceChecker process_checker_;
+  Random random_ RTC_GUARDED_BY(process_checker_);
+  // Are we currently dropping a burst of packets?
+  bool bursting_ RTC_GUARDED_BY(process_checker_) = false;
+
+  PacketRing capacity_link_ RTC_GUARDED_BY(process_checker_);
+  PacketRing delay_link_ RTC_GUARDED_BY(process_checker_);
+  // Bytes of the packet at the front of |capacity_link_| still to be sent.
+  int64_t front_bytes_left_ RTC_GUARDED_BY(process_checker_) = 0;
+  absl::optional<int64_t> trace_start_us_ RTC_GUARDED_BY(process_checker_);
+  // Absolute index, counting over repetitions of the trace, of the next
+  // delivery opportunity the capacity link can use.
+  int64_t next_opportunity_ RTC_GUARDED_BY(process_checker_) = 0;
+  absl::optional<int64_t> last_capacity_link_visit_us_
+      RTC_GUARDED_BY(process_checker_);
+  int64_t last_arrival_time_us_ RTC_GUARDED_BY(process_checker_) = 0;
+  absl::optional<int64_t> next_process_time_us_
+      RTC_GUARDED_BY(process_checker_);
+};
+
+}  // namespace webrtc
+
+#endif  // CALL_TRACE_BASED_NETWORK_H_
@@ -0,0 +1,178 @@
+/*
+ *  Copyright 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "call/trace_based_network.h"
+
+#include <vector>
+
+#include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+constexpr int kNotReceived = PacketDeliveryInfo::kNotReceived;
+
+// Delivers packets whenever the network asks to be processed, until it is
+// empty, and returns them in delivery order.
+std::vector<PacketDeliveryInfo> DeliverAll(TraceBasedNetwork* network) {
+  std::vector<PacketDeliveryInfo> delivered;
+  while (network->NextDeliveryTimeUs()) {
+    for (const PacketDeliveryInfo& packet :
+         network->DequeueDeliverablePackets(*network->NextDeliveryTimeUs())) {
+      delivered.push_back(packet);
+    }
+  }
+  return delivered;
+}
+
+LinkCapacityTrace ParseTrace(const std::string& trace) {
+  return *LinkCapacityTrace::ParseMahimahi(trace);
+}
+}  // namespace
+
+TEST(TraceBasedNetworkTest, DeliversAtOpportunities) {
+  TraceBasedNetwork network(ParseTrace("10\n20\n20\n40\n"),
+                            TraceBasedNetwork::Config());
+  for (uint64_t id = 0; id < 5; ++id)
+    ASSERT_TRUE(network.EnqueuePacket(PacketInFlightInfo(1500, 0, id)));
+
+  std::vector<PacketDeliveryInfo> delivered = DeliverAll(&network);
+  ASSERT_EQ(delivered.size(), 5u);
+  // The trace repeats after 40 ms.
+  const int64_t kExpectedArrivalMs[] = {10, 20, 20, 40, 50};
+  for (size_t i = 0; i < delivered.size(); ++i) {
+    EXPECT_EQ(delivered[i].packet_id, i);
+    EXPECT_EQ(delivered[i].receive_time_us, kExpectedArrivalMs[i] * 1000);
+  }
+}
+
+TEST(TraceBasedNetworkTest, MarksEcnCapablePacketsQueuedAboveThreshold) {
+  TraceBasedNetwork::Config config;
+  config.ecn_marking_threshold_ms = 15;
+  TraceBasedNetwork network(ParseTrace("10\n20\n"), config);
+  for (uint64_t id = 0; id < 3; ++id) {
+    ASSERT_TRUE(network.EnqueuePacket(
+        PacketInFlightInfo(1500, 0, id, rtc::EcnMarking::kEct0)));
+  }
+
+  std::vector<PacketDeliveryInfo> delivered = DeliverAll(&network);
+  ASSERT_EQ(delivered.size(), 3u);
+  EXPECT_EQ(delivered[0].ecn, rtc::EcnMarking::kEct0);
+  EXPECT_EQ(delivered[1].ecn, rtc::EcnMarking::kCe);
+  EXPECT_EQ(delivered[2].ecn, rtc::EcnMarking::kCe);
+}
+
+TEST(TraceBasedNetworkTest, SharesOpportunityBetweenSmallPackets) {
+  TraceBasedNetwork network(ParseTrace("10\n20\n"),
+                            TraceBasedNetwork::Config());
+  // Three 500 byte packets fit in one opportunity, the fourth has to wait.
+  for (uint64_t id = 0; id < 4; ++id)
+    ASSERT_TRUE(network.EnqueuePacket(PacketInFlightInfo(500, 0, id)));
+
+  std::vector<PacketDeliveryInfo> delivered = DeliverAll(&network);
+  ASSERT_EQ(delivered.size(), 4u);
+  EXPECT_EQ(delivered[0].receive_time_us, 10000);
+  EXPECT_EQ(delivered[1].receive_time_us, 10000);
+  EXPECT_EQ(delivered[2].receive_time_us, 10000);
+  EXPECT_EQ(delivered[3].receive_time_us, 20000);
+}
+
+TEST(TraceBasedNetworkTest, LargePacketsSpanOpportunities) {
+  TraceBasedNetwork::Config config;
+  config.packet_overhead = 100;
+  TraceBasedNetwork network(ParseTrace("1\n2\n3\n4\n"), config);
+  // 3000 bytes plus overhead needs three opportunities.
+  ASSERT_TRUE(network.EnqueuePacket(PacketInFlightInfo(3000, 0, 0)));
+  std::vector<PacketDeliveryInfo> delivered = DeliverAll(&network);
+  ASSERT_EQ(delivered.size(), 1u);
+  EXPECT_EQ(delivered[0].receive_time_us, 3000);
+}
+
+TEST(TraceBasedNetworkTest, WastesOpportunitiesOnEmptyQueue) {
+  TraceBasedNetwork::Config config;
+  config.queue_delay_ms = 5;
+  TraceBasedNetwork network(ParseTrace("10\n20\n30\n40\n"), config);
+  ASSERT_TRUE(network.EnqueuePacket(PacketInFlightInfo(100, 0, 0)));
+  // The link is idle for the opportunities at 20 and 30 ms.
+  ASSERT_TRUE(network.EnqueuePacket(PacketInFlightInfo(100, 35000, 1)));
+  std::vector<PacketDeliveryInfo> delivered = DeliverAll(&network);
+  ASSERT_EQ(delivered.size(), 2u);
+  EXPECT_EQ(delivered[0].receive_time_us, 15000);
+  EXPECT_EQ(delivered[1].receive_time_us, 45000);
+}
+
+TEST(TraceBasedNetworkTest, DropsPacketsWhenQueueIsFull) {
+  TraceBasedNetwork::Config config;
+  config.queue_length_packets = 10;
+  TraceBasedNetwork network(ParseTrace("100\n"), config);
+  for (uint64_t id = 0; id < 10; ++id)
+    EXPECT_TRUE(network.EnqueuePacket(PacketInFlightInfo(1500, 0, id)));
+  EXPECT_FALSE(network.EnqueuePacket(PacketInFlightInfo(1500, 0, 10)));
+  // One packet leaves at every opportunity, which makes room for another.
+  network.DequeueDeliverablePackets(100000);
+  EXPECT_TRUE(network.EnqueuePacket(PacketInFlightInfo(1500, 100000, 11)));
+  EXPECT_FALSE(network.EnqueuePacket(PacketInFlightInfo(1500, 100000, 12)));
+}
+
+TEST(TraceBasedNetworkTest, AppliesLoss) {
+  TraceBasedNetwork::Config config;
+  config.loss_percent = 50;
+  TraceBasedNetwork network(
+      LinkCapacityTrace::Constant(DataRate::KilobitsPerSec(12000)), config);
+  const int kNumPackets = 10000;
+  for (int i = 0; i < kNumPackets; ++i)
+    ASSERT_TRUE(network.EnqueuePacket(PacketInFlightInfo(1000, i * 1000, i)));
+
+  int lost = 0;
+  int64_t last_receive_time_us = 0;
+  for (const PacketDeliveryInfo& packet : DeliverAll(&network)) {
+    if (packet.receive_time_us == kNotReceived) {
+      ++lost;
+    } else {
+      EXPECT_GE(packet.receive_time_us, last_receive_time_us);
+      last_receive_time_us = packet.receive_time_us;
+    }
+  }
+  EXPECT_NEAR(lost, kNumPackets / 2, kNumPackets / 20);
+}
+
+TEST(TraceBasedNetworkTest, ThroughputFollowsTrace) {
+  // Keep the link saturated through one period of a square wave trace and
+  // check that the delivered rate follows each half of it.
+  const TimeDelta kHalfPeriod = TimeDelta::Seconds(2);
+  TraceBasedNetwork network(
+      LinkCapacityTrace::SquareWave(DataRate::KilobitsPerSec(2000),
+                                    DataRate::KilobitsPerSec(500),
+                                    kHalfPeriod),
+      TraceBasedNetwork::Config());
+  const size_t kPacketSize = 1000;
+  int64_t bytes_in_first_half = 0;
+  int64_t bytes_in_second_half = 0;
+  uint64_t next_id = 0;
+  for (int64_t time_us = 0; time_us < 2 * kHalfPeriod.us(); time_us += 1000) {
+    // 4 Mbps offered load.
+    ASSERT_TRUE(network.EnqueuePacket(
+        PacketInFlightInfo(kPacketSize, time_us, next_id++)));
+    ASSERT_TRUE(network.EnqueuePacket(
+        PacketInFlightInfo(kPacketSize, time_us, next_id++)));
+    for (const PacketDeliveryInfo& packet :
+         network.DequeueDeliverablePackets(time_us)) {
+      if (packet.receive_time_us < kHalfPeriod.us()) {
+        bytes_in_first_half += kPacketSize;
+      } else {
+        bytes_in_second_half += kPacketSize;
+      }
+    }
+  }
+  EXPECT_NEAR(bytes_in_first_half * 8 / kHalfPeriod.seconds(), 2000000, 10000);
+  EXPECT_NEAR(bytes_in_second_half * 8 / kHalfPeriod.seconds(), 500000, 10000);
+}
+
+}  // namespace webrtc
@@ -11,14 +11,14 @@
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 
 #include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
 
 size_t WebRtcSpl_AutoCorrelation(const int16_t* in_vector,
                                  size_t in_vector_length,
                                  size_t order,
                                  int32_t* result,
                                  int* scale) {
-  int32_t sum = 0;
-  size_t i = 0, j = 0;
+  size_t i = 0;
   int16_t smax = 0;
   int scaling = 0;
 
@@ -45,8 +45,17 @@ size_t WebRtcSpl_AutoCorrelation(const int16_t* in_vector,
   }
 
   // Perform the actual correlation calculation.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  // The x86 versions of WebRtcSpl_CrossCorrelation() are vectorized and
+  // bit-exact with the loop below. The NEON version isn't bit-exact.
   for (i = 0; i < order + 1; i++) {
-    sum = 0;
+    WebRtcSpl_CrossCorrelation(&result[i], in_vector, &in_vector[i],
+                               in_vector_length - i, 1, scaling, 0);
+  }
+#else
+  for (i = 0; i < order + 1; i++) {
+    int32_t sum = 0;
+    size_t j = 0;
     /* Unroll the loop to improve performance. */
     for (j = 0; i + j + 3 < in_vector_length; j += 4) {
       sum += (in_vector[j + 0] * in_vector[i + j + 0]) >> scaling;
@@ -59,6 +68,7 @@ size_t WebRtcSpl_AutoCorrelation(const int16_t* in_vector,
     }
     *result++ = sum;
   }
+#endif
 
   *scale = scaling;
   return order + 1;
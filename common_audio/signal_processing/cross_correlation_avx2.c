@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+// Sums (vector1[i] * vector2[i]) >> scaling like the C version does, i.e.
+// each product is shifted on its own and the sum wraps around in 32 bits.
+static inline int32_t DotProductWithScaleAvx2(const int16_t* vector1,
+                                              const int16_t* vector2,
+                                              size_t length,
+                                              int scaling) {
+  __m256i sum = _mm256_setzero_si256();
+  __m128i sum128;
+  size_t i = 0;
+
+  if (scaling == 0) {
+    // Without a shift, adding the products in pairs is exact modulo 2^32.
+    for (; i + 16 <= length; i += 16) {
+      __m256i a = _mm256_loadu_si256((const __m256i*)&vector1[i]);
+      __m256i b = _mm256_loadu_si256((const __m256i*)&vector2[i]);
+      sum = _mm256_add_epi32(sum, _mm256_madd_epi16(a, b));
+    }
+    sum128 = _mm_add_epi32(_mm256_castsi256_si128(sum),
+                           _mm256_extracti128_si256(sum, 1));
+    if (i + 8 <= length) {
+      __m128i a = _mm_loadu_si128((const __m128i*)&vector1[i]);
+      __m128i b = _mm_loadu_si128((const __m128i*)&vector2[i]);
+      sum128 = _mm_add_epi32(sum128, _mm_madd_epi16(a, b));
+      i += 8;
+    }
+  } else {
+    const __m128i shift = _mm_cvtsi32_si128(scaling);
+    for (; i + 16 <= length; i += 16) {
+      __m256i a = _mm256_loadu_si256((const __m256i*)&vector1[i]);
+      __m256i b = _mm256_loadu_si256((const __m256i*)&vector2[i]);
+      __m256i lo = _mm256_mullo_epi16(a, b);
+      __m256i hi = _mm256_mulhi_epi16(a, b);
+      __m256i prod0 = _mm256_sra_epi32(_mm256_unpacklo_epi16(lo, hi), shift);
+      __m256i prod1 = _mm256_sra_epi32(_mm256_unpackhi_epi16(lo, hi), shift);
+      sum = _mm256_add_epi32(sum, _mm256_add_epi32(prod0, prod1));
+    }
+    sum128 = _mm_add_epi32(_mm256_castsi256_si128(sum),
+                           _mm256_extracti128_si256(sum, 1));
+    if (i + 8 <= length) {
+      __m128i a = _mm_loadu_si128((const __m128i*)&vector1[i]);
+      __m128i b = _mm_loadu_si128((const __m128i*)&vector2[i]);
+      __m128i lo = _mm_mullo_epi16(a, b);
+      __m128i hi = _mm_mulhi_epi16(a, b);
+      __m128i prod0 = _mm_sra_epi32(_mm_unpacklo_epi16(lo, hi), shift);
+      __m128i prod1 = _mm_sra_epi32(_mm_unpackhi_epi16(lo, hi), shift);
+      sum128 = _mm_add_epi32(sum128, _mm_add_epi32(prod0, prod1));
+      i += 8;
+    }
+  }
+
+  sum128 = _mm_add_epi32(sum128,
+                         _mm_shuffle_epi32(sum128, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum128 = _mm_add_epi32(sum128,
+                         _mm_shuffle_epi32(sum128, _MM_SHUFFLE(2, 3, 0, 1)));
+  uint32_t result = (uint32_t)_mm_cvtsi128_si32(sum128);
+
+  // Calculate the rest of the samples.
+  for (; i < length; i++) {
+    result += (uint32_t)((vector1[i] * vector2[i]) >> scaling);
+  }
+  return (int32_t)result;
+}
+
+// AVX2 version of WebRtcSpl_CrossCorrelation() for x86 platforms.
+// Bit-exact with WebRtcSpl_CrossCorrelationC().
+void WebRtcSpl_CrossCorrelationAvx2(int32_t* cross_correlation,
+                                    const int16_t* seq1,
+                                    const int16_t* seq2,
+                                    size_t dim_seq,
+                                    size_t dim_cross_correlation,
+                                    int right_shifts,
+                                    int step_seq2) {
+  size_t i = 0;
+
+  for (i = 0; i < dim_cross_correlation; i++) {
+    *cross_correlation++ =
+        DotProductWithScaleAvx2(seq1, seq2, dim_seq, right_shifts);
+    seq2 += step_seq2;
+  }
+}
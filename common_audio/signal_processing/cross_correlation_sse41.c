@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <smmintrin.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+// Sums (vector1[i] * vector2[i]) >> scaling like the C version does, i.e.
+// each product is shifted on its own and the sum wraps around in 32 bits.
+static inline int32_t DotProductWithScaleSse41(const int16_t* vector1,
+                                               const int16_t* vector2,
+                                               size_t length,
+                                               int scaling) {
+  __m128i sum = _mm_setzero_si128();
+  size_t i = 0;
+
+  if (scaling == 0) {
+    // Without a shift, adding the products in pairs is exact modulo 2^32.
+    for (; i + 8 <= length; i += 8) {
+      __m128i a = _mm_loadu_si128((const __m128i*)&vector1[i]);
+      __m128i b = _mm_loadu_si128((const __m128i*)&vector2[i]);
+      sum = _mm_add_epi32(sum, _mm_madd_epi16(a, b));
+    }
+  } else {
+    const __m128i shift = _mm_cvtsi32_si128(scaling);
+    for (; i + 8 <= length; i += 8) {
+      __m128i a = _mm_loadu_si128((const __m128i*)&vector1[i]);
+      __m128i b = _mm_loadu_si128((const __m128i*)&vector2[i]);
+      __m128i lo = _mm_mullo_epi16(a, b);
+      __m128i hi = _mm_mulhi_epi16(a, b);
+      __m128i prod0 = _mm_sra_epi32(_mm_unpacklo_epi16(lo, hi), shift);
+      __m128i prod1 = _mm_sra_epi32(_mm_unpackhi_epi16(lo, hi), shift);
+      sum = _mm_add_epi32(sum, _mm_add_epi32(prod0, prod1));
+    }
+  }
+
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  uint32_t result = (uint32_t)_mm_cvtsi128_si32(sum);
+
+  // Calculate the rest of the samples.
+  for (; i < length; i++) {
+    result += (uint32_t)((vector1[i] * vector2[i]) >> scaling);
+  }
+  return (int32_t)result;
+}
+
+// SSE4.1 version of WebRtcSpl_CrossCorrelation() for x86 platforms.
+// Bit-exact with WebRtcSpl_CrossCorrelationC().
+void WebRtcSpl_CrossCorrelationSse41(int32_t* cross_correlation,
+                                     const int16_t* seq1,
+                                     const int16_t* seq2,
+                                     size_t dim_seq,
+                                     size_t dim_cross_correlation,
+                                     int right_shifts,
+                                     int step_seq2) {
+  size_t i = 0;
+
+  for (i = 0; i < dim_cross_correlation; i++) {
+    *cross_correlation++ =
+        DotProductWithScaleSse41(seq1, seq2, dim_seq, right_shifts);
+    seq2 += step_seq2;
+  }
+}
@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <smmintrin.h>
+#include <stddef.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+// Longer filters are left to the C version.
+enum { kMaxCoefficientBlocks = 4 };
+
+// SSE4.1 version of WebRtcSpl_DownsampleFast() for x86 platforms.
+// Bit-exact with WebRtcSpl_DownsampleFastC().
+int WebRtcSpl_DownsampleFastSse41(const int16_t* data_in,
+                                  size_t data_in_length,
+                                  int16_t* data_out,
+                                  size_t data_out_length,
+                                  const int16_t* __restrict coefficients,
+                                  size_t coefficients_length,
+                                  int factor,
+                                  size_t delay) {
+  int16_t reversed[kMaxCoefficientBlocks * 8] = {0};
+  __m128i coefficient_blocks[kMaxCoefficientBlocks];
+  size_t num_blocks = (coefficients_length + 7) / 8;
+  // Samples read past the current one, which are multiplied by zero.
+  size_t overread = num_blocks * 8 - coefficients_length;
+  size_t endpos = delay + factor * (data_out_length - 1) + 1;
+  size_t i = delay;
+  size_t j = 0;
+  size_t n = 0;
+
+  // Return error if any of the running conditions doesn't meet.
+  if (data_out_length == 0 || coefficients_length == 0
+                           || data_in_length < endpos) {
+    return -1;
+  }
+  if (num_blocks > kMaxCoefficientBlocks) {
+    return WebRtcSpl_DownsampleFastC(data_in, data_in_length, data_out,
+                                     data_out_length, coefficients,
+                                     coefficients_length, factor, delay);
+  }
+
+  // With the coefficients reversed, each output is the dot product of the
+  // coefficients and the |coefficients_length| samples ending at data_in[i].
+  for (j = 0; j < coefficients_length; j++) {
+    reversed[j] = coefficients[coefficients_length - 1 - j];
+  }
+  for (j = 0; j < num_blocks; j++) {
+    coefficient_blocks[j] = _mm_loadu_si128((const __m128i*)&reversed[j * 8]);
+  }
+
+  // Four outputs at a time, as long as all the samples read are in
+  // |data_in|. Negative positions are permitted, as in the C version.
+  for (; n + 4 <= data_out_length &&
+         i + 3 * factor + overread < data_in_length;
+       n += 4, i += 4 * factor) {
+    const int16_t* window =
+        &data_in[(ptrdiff_t)i - (ptrdiff_t)coefficients_length + 1];
+    __m128i sums[4];
+    __m128i out_s32;
+    size_t k = 0;
+
+    for (k = 0; k < 4; k++) {
+      sums[k] = _mm_setzero_si128();
+    }
+    for (j = 0; j < num_blocks; j++) {
+      for (k = 0; k < 4; k++) {
+        __m128i in =
+            _mm_loadu_si128((const __m128i*)&window[k * factor + j * 8]);
+        sums[k] = _mm_add_epi32(sums[k],
+                                _mm_madd_epi16(in, coefficient_blocks[j]));
+      }
+    }
+
+    out_s32 = _mm_hadd_epi32(_mm_hadd_epi32(sums[0], sums[1]),
+                             _mm_hadd_epi32(sums[2], sums[3]));
+    // Round, 0.5 in Q12, and go to Q0.
+    out_s32 = _mm_srai_epi32(_mm_add_epi32(out_s32, _mm_set1_epi32(2048)), 12);
+    // Saturate and store the output.
+    _mm_storel_epi64((__m128i*)&data_out[n], _mm_packs_epi32(out_s32, out_s32));
+  }
+
+  if (n < data_out_length) {
+    return WebRtcSpl_DownsampleFastC(data_in, data_in_length, &data_out[n],
+                                     data_out_length - n, coefficients,
+                                     coefficients_length, factor, i);
+  }
+  return 0;
+}
@@ -11,7 +11,10 @@
 #include <algorithm>
 
 #include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "rtc_base/random.h"
 #include "rtc_base/strings/string_builder.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 #include "test/gtest.h"
 
 static const size_t kVector16Size = 9;
@@ -491,18 +494,155 @@ TEST(SplTest, CrossCorrelationTest) {
   const int32_t kExpected[kCrossCorrelationDimension] = {-266947903, -15579555,
                                                          -171282001};
   const int32_t* expected = kExpected;
-#if !defined(MIPS32_LE)
+#if defined(WEBRTC_HAS_NEON)
   const int32_t kExpectedNeon[kCrossCorrelationDimension] = {
       -266947901, -15579553, -171281999};
-  if (WebRtcSpl_CrossCorrelation != WebRtcSpl_CrossCorrelationC) {
-    expected = kExpectedNeon;
-  }
+  expected = kExpectedNeon;
 #endif
   for (size_t i = 0; i < kCrossCorrelationDimension; ++i) {
     EXPECT_EQ(expected[i], vector32[i]);
   }
 }
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+namespace {
+
+// Full scale samples now and then make the sums wrap around and saturate.
+void FillRandom(webrtc::Random* random, int16_t* vector, size_t length) {
+  for (size_t i = 0; i < length; ++i) {
+    vector[i] = random->Rand(0, 9) == 0
+                    ? (random->Rand<bool>() ? WEBRTC_SPL_WORD16_MAX
+                                            : WEBRTC_SPL_WORD16_MIN)
+                    : random->Rand<int16_t>();
+  }
+}
+
+void VerifyCrossCorrelationIsBitExact(CrossCorrelation cross_correlation) {
+  webrtc::Random random(42);
+  const size_t kMaxSeqDimension = 100;
+  const size_t kMaxCrossCorrelationDimension = 20;
+  const int kMaxStep = 2;
+  const size_t kSeq2Offset = kMaxStep * kMaxCrossCorrelationDimension;
+  int16_t seq1[kMaxSeqDimension];
+  int16_t seq2[kSeq2Offset + kMaxSeqDimension + kSeq2Offset];
+  int32_t expected[kMaxCrossCorrelationDimension];
+  int32_t actual[kMaxCrossCorrelationDimension];
+  for (int trial = 0; trial < 2000; ++trial) {
+    const size_t dim_seq = random.Rand(0u, kMaxSeqDimension);
+    const size_t dim_cross_correlation =
+        random.Rand(1u, kMaxCrossCorrelationDimension);
+    const int right_shifts = random.Rand(0, 12);
+    const int step_seq2 = random.Rand(-kMaxStep, kMaxStep);
+    FillRandom(&random, seq1, kMaxSeqDimension);
+    FillRandom(&random, seq2, sizeof(seq2) / sizeof(seq2[0]));
+
+    WebRtcSpl_CrossCorrelationC(expected, seq1, &seq2[kSeq2Offset], dim_seq,
+                                dim_cross_correlation, right_shifts,
+                                step_seq2);
+    cross_correlation(actual, seq1, &seq2[kSeq2Offset], dim_seq,
+                      dim_cross_correlation, right_shifts, step_seq2);
+    for (size_t i = 0; i < dim_cross_correlation; ++i) {
+      ASSERT_EQ(expected[i], actual[i])
+          << "dim_seq=" << dim_seq << " right_shifts=" << right_shifts
+          << " step_seq2=" << step_seq2 << " lag=" << i;
+    }
+  }
+}
+
+void VerifyDownsampleFastIsBitExact(DownsampleFast downsample_fast) {
+  webrtc::Random random(42);
+  // Longer filters than the vectorized versions take are tested too.
+  const size_t kMaxCoefficientsLength = 40;
+  const size_t kMaxOutLength = 40;
+  const int kMaxFactor = 12;
+  const size_t kMaxDelay = 4;
+  const size_t kMaxExtraLength = 10;
+  // Room for the filter state before |data_in|.
+  const size_t kHistoryLength = kMaxCoefficientsLength;
+  int16_t coefficients[kMaxCoefficientsLength];
+  int16_t data_in[kHistoryLength + kMaxDelay + kMaxFactor * kMaxOutLength +
+                  kMaxExtraLength];
+  int16_t expected[kMaxOutLength];
+  int16_t actual[kMaxOutLength];
+  for (int trial = 0; trial < 2000; ++trial) {
+    const size_t coefficients_length =
+        random.Rand(1u, kMaxCoefficientsLength);
+    const size_t data_out_length = random.Rand(1u, kMaxOutLength);
+    const int factor = random.Rand(1, kMaxFactor);
+    const size_t delay = random.Rand(0u, kMaxDelay);
+    const size_t data_in_length = delay + factor * (data_out_length - 1) + 1 +
+                                  random.Rand(0u, kMaxExtraLength);
+    FillRandom(&random, coefficients, coefficients_length);
+    FillRandom(&random, data_in, sizeof(data_in) / sizeof(data_in[0]));
+
+    ASSERT_EQ(0, WebRtcSpl_DownsampleFastC(
+                     &data_in[kHistoryLength], data_in_length, expected,
+                     data_out_length, coefficients, coefficients_length,
+                     factor, delay));
+    ASSERT_EQ(0, downsample_fast(&data_in[kHistoryLength], data_in_length,
+                                 actual, data_out_length, coefficients,
+                                 coefficients_length, factor, delay));
+    for (size_t i = 0; i < data_out_length; ++i) {
+      ASSERT_EQ(expected[i], actual[i])
+          << "coefficients_length=" << coefficients_length
+          << " factor=" << factor << " delay=" << delay
+          << " data_in_length=" << data_in_length << " output=" << i;
+    }
+  }
+
+  // Too short input.
+  EXPECT_EQ(-1, downsample_fast(&data_in[kHistoryLength], 8, actual, 4,
+                                coefficients, 4, 3, 0));
+}
+
+}  // namespace
+
+TEST(SplTest, CrossCorrelationSse41IsBitExact) {
+  if (WebRtc_GetCPUInfo(kSSE4_1) != 0) {
+    VerifyCrossCorrelationIsBitExact(WebRtcSpl_CrossCorrelationSse41);
+  }
+}
+
+TEST(SplTest, CrossCorrelationAvx2IsBitExact) {
+  if (WebRtc_GetCPUInfo(kAVX2) != 0) {
+    VerifyCrossCorrelationIsBitExact(WebRtcSpl_CrossCorrelationAvx2);
+  }
+}
+
+TEST(SplTest, DownsampleFastSse41IsBitExact) {
+  if (WebRtc_GetCPUInfo(kSSE4_1) != 0) {
+    VerifyDownsampleFastIsBitExact(WebRtcSpl_DownsampleFastSse41);
+  }
+}
+
+TEST(SplTest, DownsampleFastAvx2IsBitExact) {
+  if (WebRtc_GetCPUInfo(kAVX2) != 0) {
+    VerifyDownsampleFastIsBitExact(WebRtcSpl_DownsampleFastAvx2);
+  }
+}
+
+TEST(SplTest, AutoCorrelationIsBitExact) {
+  webrtc::Random random(42);
+  const size_t kMaxLength = 200;
+  int16_t in_vector[kMaxLength];
+  int32_t result[kMaxLength];
+  for (int trial = 0; trial < 200; ++trial) {
+    const size_t length = random.Rand(1u, kMaxLength);
+    const size_t order = random.Rand(0u, length - 1);
+    FillRandom(&random, in_vector, length);
+    int scale = 0;
+    ASSERT_EQ(order + 1, WebRtcSpl_AutoCorrelation(in_vector, length, order,
+                                                   result, &scale));
+    int32_t expected = 0;
+    for (size_t i = 0; i <= order; ++i) {
+      WebRtcSpl_CrossCorrelationC(&expected, in_vector, &in_vector[i],
+                                  length - i, 1, scale, 0);
+      ASSERT_EQ(expected, result[i]) << "length=" << length << " lag=" << i;
+    }
+  }
+}
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
+
 TEST(SplTest, AutoCorrelationTest) {
   int scale = 0;
   int32_t vector32[kVector16Size];
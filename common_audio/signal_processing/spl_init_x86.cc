@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Runtime dispatch of the SPL functions with SSE4.1 and AVX2 versions. The
+// CPU is only queried on the first call, since cpuid is slow.
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+namespace {
+
+CrossCorrelation SelectCrossCorrelation() {
+  if (WebRtc_GetCPUInfo(kAVX2) != 0) {
+    return WebRtcSpl_CrossCorrelationAvx2;
+  }
+  if (WebRtc_GetCPUInfo(kSSE4_1) != 0) {
+    return WebRtcSpl_CrossCorrelationSse41;
+  }
+  return WebRtcSpl_CrossCorrelationC;
+}
+
+DownsampleFast SelectDownsampleFast() {
+  if (WebRtc_GetCPUInfo(kAVX2) != 0) {
+    return WebRtcSpl_DownsampleFastAvx2;
+  }
+  if (WebRtc_GetCPUInfo(kSSE4_1) != 0) {
+    return WebRtcSpl_DownsampleFastSse41;
+  }
+  return WebRtcSpl_DownsampleFastC;
+}
+
+}  // namespace
+
+void WebRtcSpl_CrossCorrelationX86(int32_t* cross_correlation,
+                                   const int16_t* seq1,
+                                   const int16_t* seq2,
+                                   size_t dim_seq,
+                                   size_t dim_cross_correlation,
+                                   int right_shifts,
+                                   int step_seq2) {
+  static const CrossCorrelation cross_correlation_impl =
+      SelectCrossCorrelation();
+  cross_correlation_impl(cross_correlation, seq1, seq2, dim_seq,
+                         dim_cross_correlation, right_shifts, step_seq2);
+}
+
+int WebRtcSpl_DownsampleFastX86(const int16_t* data_in,
+                                size_t data_in_length,
+                                int16_t* data_out,
+                                size_t data_out_length,
+                                const int16_t* __restrict coefficients,
+                                size_t coefficients_length,
+                                int factor,
+                                size_t delay) {
+  static const DownsampleFast downsample_fast_impl = SelectDownsampleFast();
+  return downsample_fast_impl(data_in, data_in_length, data_out,
+                              data_out_length, coefficients,
+                              coefficients_length, factor, delay);
+}
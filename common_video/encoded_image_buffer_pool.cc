@@ -0,0 +1,145 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/encoded_image_buffer_pool.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "system_wrappers/include/metrics.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kDefaultMaxNumberOfBuffers = 10;
+// About 10 seconds at 30 fps, so that the size of a key frame is remembered
+// for a while after it.
+constexpr size_t kNumRecentFrames = 300;
+// Free buffers larger than this many times the size of new buffers are purged.
+constexpr size_t kPurgeFactor = 4;
+constexpr size_t kMinRequestsForMetrics = 200;
+
+}  // namespace
+
+EncodedImageBufferPool::PooledBuffer::PooledBuffer(size_t capacity)
+    : capacity_(capacity), buffer_(new uint8_t[capacity]) {}
+
+EncodedImageBufferPool::PooledBuffer::~PooledBuffer() = default;
+
+void EncodedImageBufferPool::PooledBuffer::set_size(size_t size) {
+  RTC_DCHECK_LE(size, capacity_);
+  size_ = size;
+}
+
+EncodedImageBufferPool::EncodedImageBufferPool()
+    : EncodedImageBufferPool(kDefaultMaxNumberOfBuffers) {}
+
+EncodedImageBufferPool::EncodedImageBufferPool(size_t max_number_of_buffers)
+    : max_number_of_buffers_(max_number_of_buffers) {}
+
+EncodedImageBufferPool::~EncodedImageBufferPool() {
+  if (num_requests_ < kMinRequestsForMetrics) {
+    return;
+  }
+  RTC_HISTOGRAM_PERCENTAGE(
+      "WebRTC.Video.Encoder.EncodedBufferAllocationPercent",
+      static_cast<int>(100 * num_allocations_ / num_requests_));
+  RTC_HISTOGRAM_COUNTS_100000("WebRTC.Video.Encoder.EncodedBufferPoolPeakKb",
+                              static_cast<int>(max_pooled_bytes_ / 1024));
+}
+
+void EncodedImageBufferPool::Release() {
+  buffers_.clear();
+  pooled_bytes_ = 0;
+}
+
+rtc::scoped_refptr<EncodedImageBufferInterface>
+EncodedImageBufferPool::CreateBuffer(size_t size) {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  ++num_requests_;
+  const size_t recent_max_size = UpdateRecentMaxSize(size);
+  const size_t new_capacity = recent_max_size + recent_max_size / 8;
+
+  // Purge the free buffers that are much larger than the recent frames, and
+  // look for the smallest free buffer that is large enough for this one.
+  RefCountedPooledBuffer* best_buffer = nullptr;
+  for (auto it = buffers_.begin(); it != buffers_.end();) {
+    // If the buffer is in use, the ref count will be >= 2, one from the list we
+    // are looping over and one from the application. If the ref count is 1,
+    // then the list we are looping over holds the only reference and it's safe
+    // to reuse.
+    if (!(*it)->HasOneRef()) {
+      ++it;
+      continue;
+    }
+    const size_t capacity = (*it)->capacity();
+    if (capacity > kPurgeFactor * new_capacity) {
+      pooled_bytes_ -= capacity;
+      it = buffers_.erase(it);
+      continue;
+    }
+    if (capacity >= size &&
+        (!best_buffer || capacity < best_buffer->capacity())) {
+      best_buffer = it->get();
+    }
+    ++it;
+  }
+  if (best_buffer) {
+    best_buffer->set_size(size);
+    return best_buffer;
+  }
+
+  ++num_allocations_;
+  if (buffers_.size() >= max_number_of_buffers_) {
+    // Make room by dropping a free buffer, which is too small for this frame.
+    auto it = std::find_if(
+        buffers_.begin(), buffers_.end(),
+        [](const rtc::scoped_refptr<RefCountedPooledBuffer>& buffer) {
+          return buffer->HasOneRef();
+        });
+    if (it == buffers_.end()) {
+      return EncodedImageBuffer::Create(size);
+    }
+    pooled_bytes_ -= (*it)->capacity();
+    buffers_.erase(it);
+  }
+  rtc::scoped_refptr<RefCountedPooledBuffer> buffer =
+      new RefCountedPooledBuffer(new_capacity);
+  buffer->set_size(size);
+  buffers_.push_back(buffer);
+  pooled_bytes_ += new_capacity;
+  max_pooled_bytes_ = std::max(max_pooled_bytes_, pooled_bytes_);
+  return buffer;
+}
+
+rtc::scoped_refptr<EncodedImageBufferInterface>
+EncodedImageBufferPool::CreateBuffer(const uint8_t* data, size_t size) {
+  rtc::scoped_refptr<EncodedImageBufferInterface> buffer = CreateBuffer(size);
+  if (size > 0) {
+    memcpy(buffer->data(), data, size);
+  }
+  return buffer;
+}
+
+size_t EncodedImageBufferPool::UpdateRecentMaxSize(size_t size) {
+  while (!recent_max_sizes_.empty() &&
+         recent_max_sizes_.back().second <= size) {
+    recent_max_sizes_.pop_back();
+  }
+  recent_max_sizes_.emplace_back(num_requests_, size);
+  while (recent_max_sizes_.front().first + kNumRecentFrames <= num_requests_) {
+    recent_max_sizes_.pop_front();
+  }
+  return recent_max_sizes_.front().second;
+}
+
+}  // namespace webrtc
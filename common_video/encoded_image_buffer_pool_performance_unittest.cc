@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include <deque>
+#include <utility>
+
+#include "api/scoped_refptr.h"
+#include "api/video/encoded_image.h"
+#include "common_video/include/encoded_image_buffer_pool.h"
+#include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+// Ten minutes of 30 fps video, with a key frame every ten seconds.
+constexpr int kNumFrames = 30 * 60 * 10;
+constexpr int kKeyFrameInterval = 300;
+constexpr int kKeyFrameSize = 150000;
+constexpr int kMinDeltaFrameSize = 4000;
+constexpr int kMaxDeltaFrameSize = 20000;
+// The number of frames whose encoded data is still referenced downstream,
+// e.g. by a frame transformer, when the next frame is encoded.
+constexpr size_t kNumFramesInFlight = 3;
+
+// Encodes a long run of frames into buffers from |pool|, or into newly
+// allocated buffers if |pool| is null, and returns the average time per frame
+// in microseconds.
+double EncodeFramesUs(EncodedImageBufferPool* pool) {
+  Random random(42);
+  std::deque<EncodedImage> frames_in_flight;
+  const int64_t start_time_nanos = rtc::TimeNanos();
+  for (int i = 0; i < kNumFrames; ++i) {
+    const size_t size =
+        i % kKeyFrameInterval == 0
+            ? kKeyFrameSize
+            : random.Rand(kMinDeltaFrameSize, kMaxDeltaFrameSize);
+    rtc::scoped_refptr<EncodedImageBufferInterface> buffer;
+    if (pool) {
+      buffer = pool->CreateBuffer(size);
+    } else {
+      buffer = EncodedImageBuffer::Create(size);
+    }
+    // Stands in for the copy of the encoder output.
+    memset(buffer->data(), i, size);
+    EncodedImage frame;
+    frame.SetEncodedData(buffer);
+    frames_in_flight.push_back(std::move(frame));
+    if (frames_in_flight.size() > kNumFramesInFlight) {
+      frames_in_flight.pop_front();
+    }
+  }
+  return (rtc::TimeNanos() - start_time_nanos) /
+         static_cast<double>(rtc::kNumNanosecsPerMicrosec * kNumFrames);
+}
+
+}  // namespace
+
+TEST(EncodedImageBufferPoolPerformanceTest, LongRun) {
+  webrtc::test::PrintResult("encoded_buffer_time", "_per_frame", "allocate",
+                            EncodeFramesUs(nullptr), "us", false);
+  webrtc::test::PrintResult("encoded_buffer_allocations", "_per_1000_frames",
+                            "allocate", 1000.0, "count", false);
+
+  EncodedImageBufferPool pool;
+  webrtc::test::PrintResult("encoded_buffer_time", "_per_frame", "pool",
+                            EncodeFramesUs(&pool), "us", false);
+  webrtc::test::PrintResult(
+      "encoded_buffer_allocations", "_per_1000_frames", "pool",
+      1000.0 * pool.num_allocations() / pool.num_requests(), "count", false);
+}
+
+}  // namespace webrtc
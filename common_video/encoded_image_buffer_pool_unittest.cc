@@ -0,0 +1,131 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/encoded_image_buffer_pool.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "api/video/encoded_image.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+TEST(TestEncodedImageBufferPool, SimpleBufferReuse) {
+  EncodedImageBufferPool pool;
+  auto buffer = pool.CreateBuffer(1000);
+  EXPECT_EQ(1000u, buffer->size());
+  // Extract non-refcounted pointer for testing.
+  const uint8_t* data = buffer->data();
+  // Release buffer so that it is returned to the pool.
+  buffer = nullptr;
+  // Check that the memory is reused, for a smaller frame too.
+  buffer = pool.CreateBuffer(500);
+  EXPECT_EQ(500u, buffer->size());
+  EXPECT_EQ(data, buffer->data());
+  EXPECT_EQ(2u, pool.num_requests());
+  EXPECT_EQ(1u, pool.num_allocations());
+}
+
+TEST(TestEncodedImageBufferPool, FailToReuseWhenInUse) {
+  EncodedImageBufferPool pool;
+  auto buffer = pool.CreateBuffer(1000);
+  auto other_buffer = pool.CreateBuffer(1000);
+  EXPECT_NE(buffer->data(), other_buffer->data());
+  EXPECT_EQ(2u, pool.num_allocations());
+}
+
+TEST(TestEncodedImageBufferPool, BufferReturnsWhenEncodedImageIsDestroyed) {
+  EncodedImageBufferPool pool;
+  const uint8_t* data;
+  {
+    EncodedImage encoded_image;
+    encoded_image.SetEncodedData(pool.CreateBuffer(1000));
+    data = encoded_image.data();
+  }
+  EXPECT_EQ(data, pool.CreateBuffer(1000)->data());
+  EXPECT_EQ(1u, pool.num_allocations());
+}
+
+TEST(TestEncodedImageBufferPool, CopiesData) {
+  EncodedImageBufferPool pool;
+  const std::vector<uint8_t> data = {1, 2, 3, 4, 5};
+  auto buffer = pool.CreateBuffer(data.data(), data.size());
+  EXPECT_EQ(data, std::vector<uint8_t>(buffer->data(),
+                                       buffer->data() + buffer->size()));
+}
+
+TEST(TestEncodedImageBufferPool, DeltaFrameBufferFitsNextKeyFrame) {
+  EncodedImageBufferPool pool;
+  // A key frame followed by delta frames. The buffers allocated for the delta
+  // frames are sized for the recent key frame, so the next one fits.
+  auto key_frame = pool.CreateBuffer(100000);
+  auto delta_frame = pool.CreateBuffer(5000);
+  key_frame = nullptr;
+  delta_frame = nullptr;
+  for (int i = 0; i < 100; ++i) {
+    delta_frame = pool.CreateBuffer(5000);
+    delta_frame = nullptr;
+  }
+  key_frame = pool.CreateBuffer(110000);
+  EXPECT_EQ(110000u, key_frame->size());
+  EXPECT_EQ(2u, pool.num_allocations());
+}
+
+TEST(TestEncodedImageBufferPool, PurgesLargeBuffersAfterSizeDrop) {
+  EncodedImageBufferPool pool;
+  auto buffer = pool.CreateBuffer(1000000);
+  const uint8_t* large_data = buffer->data();
+  buffer = nullptr;
+  // Once the large frame is no longer recent, its buffer is purged.
+  for (int i = 0; i < 1000; ++i) {
+    buffer = pool.CreateBuffer(1000);
+    buffer = nullptr;
+  }
+  EXPECT_EQ(2u, pool.num_allocations());
+  buffer = pool.CreateBuffer(1000);
+  EXPECT_NE(large_data, buffer->data());
+}
+
+TEST(TestEncodedImageBufferPool, AllocatesOutsideOfFullPool) {
+  EncodedImageBufferPool pool(1);
+  auto buffer = pool.CreateBuffer(1000);
+  auto other_buffer = pool.CreateBuffer(1000);
+  ASSERT_TRUE(other_buffer);
+  EXPECT_EQ(1000u, other_buffer->size());
+  other_buffer = nullptr;
+  // The buffer allocated outside of the pool does not return to it.
+  EXPECT_NE(buffer->data(), pool.CreateBuffer(1000)->data());
+  EXPECT_EQ(3u, pool.num_allocations());
+}
+
+TEST(TestEncodedImageBufferPool, BuffersOutliveTheirPool) {
+  // Encoders recreate their pools in InitEncode() and release them in
+  // Release(), while encoded images may still be in flight.
+  std::vector<EncodedImageBufferPool> pools(2);
+  const std::vector<uint8_t> data = {1, 2, 3, 4, 5};
+  EncodedImage encoded_image;
+  encoded_image.SetEncodedData(pools[1].CreateBuffer(data.data(), data.size()));
+  auto buffer = pools[0].CreateBuffer(1000);
+  pools[0].Release();
+  pools = std::vector<EncodedImageBufferPool>(3);
+
+  EXPECT_EQ(data, std::vector<uint8_t>(encoded_image.data(),
+                                       encoded_image.data() +
+                                           encoded_image.size()));
+  EXPECT_EQ(1000u, buffer->size());
+  buffer = nullptr;
+  EXPECT_EQ(1000u, pools[0].CreateBuffer(1000)->size());
+  EXPECT_EQ(1u, pools[0].num_allocations());
+}
+
+}  // namespace webrtc
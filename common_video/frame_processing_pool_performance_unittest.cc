@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include "api/function_view.h"
+#include "api/scoped_refptr.h"
+#include "api/video/frame_processing_pool.h"
+#include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumFrames = 100;
+constexpr int kThreadCounts[] = {1, 2, 4, 8};
+
+struct Resolution {
+  const char* name;
+  int width;
+  int height;
+};
+
+constexpr Resolution kResolutions[] = {{"1080p", 1920, 1080},
+                                       {"4k", 3840, 2160}};
+
+rtc::scoped_refptr<I420Buffer> CreateFrame(int width, int height) {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width, height);
+  I420Buffer::SetBlack(buffer);
+  return buffer;
+}
+
+// Runs |process_frame| |kNumFrames| times on a pool with |num_threads|
+// threads, and prints the latency per frame and the throughput.
+void MeasureFrames(const std::string& graph_name,
+                   const Resolution& resolution,
+                   int num_threads,
+                   rtc::FunctionView<void()> process_frame) {
+  std::unique_ptr<FrameProcessingPool> pool =
+      FrameProcessingPool::Create(num_threads, /*min_parallel_pixels=*/0);
+  FrameProcessingPool::SetDefaultForTesting(pool.get());
+  // Starts the worker threads.
+  process_frame();
+  const int64_t start_time_nanos = rtc::TimeNanos();
+  for (int i = 0; i < kNumFrames; ++i) {
+    process_frame();
+  }
+  const double elapsed_us =
+      static_cast<double>(rtc::TimeNanos() - start_time_nanos) /
+      rtc::kNumNanosecsPerMicrosec;
+  FrameProcessingPool::SetDefaultForTesting(nullptr);
+
+  rtc::StringBuilder story;
+  story << resolution.name << "_" << num_threads << "_threads";
+  webrtc::test::PrintResult(graph_name, "_latency", story.str(),
+                            elapsed_us / kNumFrames, "us", false);
+  webrtc::test::PrintResult(graph_name, "_throughput", story.str(),
+                            kNumFrames * rtc::kNumMicrosecsPerSec / elapsed_us,
+                            "fps", false);
+}
+
+}  // namespace
+
+TEST(FrameProcessingPoolPerformanceTest, NV12ToI420) {
+  for (const Resolution& resolution : kResolutions) {
+    rtc::scoped_refptr<NV12Buffer> frame =
+        NV12Buffer::Copy(*CreateFrame(resolution.width, resolution.height));
+    for (int num_threads : kThreadCounts) {
+      MeasureFrames("nv12_to_i420", resolution, num_threads,
+                    [&] { frame->ToI420(); });
+    }
+  }
+}
+
+TEST(FrameProcessingPoolPerformanceTest, I420ScaleToHalf) {
+  for (const Resolution& resolution : kResolutions) {
+    rtc::scoped_refptr<I420Buffer> frame =
+        CreateFrame(resolution.width, resolution.height);
+    rtc::scoped_refptr<I420Buffer> scaled =
+        I420Buffer::Create(resolution.width / 2, resolution.height / 2);
+    for (int num_threads : kThreadCounts) {
+      MeasureFrames("i420_scale_to_half", resolution, num_threads,
+                    [&] { scaled->ScaleFrom(*frame); });
+    }
+  }
+}
+
+TEST(FrameProcessingPoolPerformanceTest, I420ScaleTo720p) {
+  for (const Resolution& resolution : kResolutions) {
+    rtc::scoped_refptr<I420Buffer> frame =
+        CreateFrame(resolution.width, resolution.height);
+    rtc::scoped_refptr<I420Buffer> scaled = I420Buffer::Create(1280, 720);
+    for (int num_threads : kThreadCounts) {
+      MeasureFrames("i420_scale_to_720p", resolution, num_threads,
+                    [&] { scaled->ScaleFrom(*frame); });
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
+#define COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <list>
+#include <memory>
+#include <utility>
+
+#include "api/scoped_refptr.h"
+#include "api/video/encoded_image.h"
+#include "rtc_base/race_checker.h"
+#include "rtc_base/ref_counted_object.h"
+
+namespace webrtc {
+
+// Buffer pool for the output of a video encoder, to avoid allocating a new
+// EncodedImageBuffer for every encoded frame. A buffer returns to the pool when
+// the last reference to it, e.g. held by an EncodedImage or a frame
+// transformer, is dropped.
+// New buffers are sized for the largest of the recent frames, so that a buffer
+// allocated for a delta frame can take the next key frame too. Free buffers
+// that are much larger than the recent frames, e.g. after a resolution drop,
+// are purged.
+class EncodedImageBufferPool {
+ public:
+  EncodedImageBufferPool();
+  explicit EncodedImageBufferPool(size_t max_number_of_buffers);
+  ~EncodedImageBufferPool();
+
+  // Returns a buffer of |size| bytes. If no free buffer in the pool is large
+  // enough and |max_number_of_buffers| buffers are pending, the buffer is
+  // allocated outside of the pool.
+  rtc::scoped_refptr<EncodedImageBufferInterface> CreateBuffer(size_t size);
+  // Returns a buffer that holds a copy of |size| bytes from |data|.
+  rtc::scoped_refptr<EncodedImageBufferInterface> CreateBuffer(
+      const uint8_t* data,
+      size_t size);
+
+  // Clears buffers_, so that their memory is freed when they are no longer in
+  // use.
+  void Release();
+
+  // The number of buffers returned by CreateBuffer(), and the number of them
+  // that needed a memory allocation.
+  size_t num_requests() const { return num_requests_; }
+  size_t num_allocations() const { return num_allocations_; }
+
+ private:
+  // An encoded buffer whose size can be set up to the capacity it was
+  // allocated with.
+  class PooledBuffer : public EncodedImageBufferInterface {
+   public:
+    explicit PooledBuffer(size_t capacity);
+    ~PooledBuffer() override;
+
+    const uint8_t* data() const override { return buffer_.get(); }
+    uint8_t* data() override { return buffer_.get(); }
+    size_t size() const override { return size_; }
+
+    size_t capacity() const { return capacity_; }
+    void set_size(size_t size);
+
+   private:
+    const size_t capacity_;
+    size_t size_ = 0;
+    const std::unique_ptr<uint8_t[]> buffer_;
+  };
+  // Explicitly use a RefCountedObject to get access to HasOneRef,
+  // needed by the pool to check exclusive access.
+  using RefCountedPooledBuffer = rtc::RefCountedObject<PooledBuffer>;
+
+  // Adds |size| to the recent frame sizes and returns the largest of them.
+  size_t UpdateRecentMaxSize(size_t size);
+
+  rtc::RaceChecker race_checker_;
+  std::list<rtc::scoped_refptr<RefCountedPooledBuffer>> buffers_;
+  // Max number of buffers this pool can have pending.
+  const size_t max_number_of_buffers_;
+
+  // The candidates for the max of the recent frame sizes, as pairs of request
+  // number and size, with decreasing sizes.
+  std::deque<std::pair<size_t, size_t>> recent_max_sizes_;
+
+  size_t num_requests_ = 0;
+  size_t num_allocations_ = 0;
+  size_t pooled_bytes_ = 0;
+  size_t max_pooled_bytes_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
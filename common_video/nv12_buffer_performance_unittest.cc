@@ -0,0 +1,161 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+#include "third_party/libyuv/include/libyuv/convert.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumFrames = 100;
+
+struct Resolution {
+  const char* name;
+  int width;
+  int height;
+};
+
+constexpr Resolution kResolutions[] = {{"1080p", 1920, 1080},
+                                       {"4k", 3840, 2160}};
+
+// Returns a contiguous NV12 frame as delivered by a capture device.
+std::vector<uint8_t> CreateCapturedFrame(int width, int height) {
+  std::vector<uint8_t> frame(width * height + (width + 1) / 2 * 2 *
+                                                  ((height + 1) / 2));
+  for (size_t i = 0; i < frame.size(); ++i) {
+    frame[i] = static_cast<uint8_t>(i * 7);
+  }
+  return frame;
+}
+
+// Stands in for the capture module: wraps the device memory in a frame
+// buffer, either converted to I420 as before or kept as NV12.
+rtc::scoped_refptr<VideoFrameBuffer> Capture(const std::vector<uint8_t>& frame,
+                                             int width,
+                                             int height,
+                                             bool keep_nv12) {
+  const uint8_t* data_y = frame.data();
+  const uint8_t* data_uv = data_y + width * height;
+  const int stride_uv = (width + 1) / 2 * 2;
+  if (keep_nv12) {
+    return NV12Buffer::Copy(width, height, data_y, width, data_uv, stride_uv);
+  }
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width, height);
+  libyuv::NV12ToI420(data_y, width, data_uv, stride_uv,
+                     buffer->MutableDataY(), buffer->StrideY(),
+                     buffer->MutableDataU(), buffer->StrideU(),
+                     buffer->MutableDataV(), buffer->StrideV(), width, height);
+  return buffer;
+}
+
+// Stands in for the adaptation in VideoStreamEncoder: crops to 4:3 and scales
+// to half the height, keeping the input pixel format.
+rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(
+    rtc::scoped_refptr<VideoFrameBuffer> buffer) {
+  const int crop_width = buffer->height() * 4 / 3;
+  const int offset_x = (buffer->width() - crop_width) / 2;
+  const int out_width = crop_width / 2;
+  const int out_height = buffer->height() / 2;
+  if (buffer->type() == VideoFrameBuffer::Type::kNV12) {
+    rtc::scoped_refptr<NV12Buffer> scaled =
+        NV12Buffer::Create(out_width, out_height);
+    scaled->CropAndScaleFrom(*buffer->GetNV12(), offset_x, 0, crop_width,
+                             buffer->height());
+    return scaled;
+  }
+  rtc::scoped_refptr<I420Buffer> scaled =
+      I420Buffer::Create(out_width, out_height);
+  scaled->CropAndScaleFrom(*buffer->ToI420(), offset_x, 0, crop_width,
+                           buffer->height());
+  return scaled;
+}
+
+// Returns the average time per frame in microseconds of running |kNumFrames|
+// frames through capture, adaptation (if |scale|) and encoder input.
+// |encoder_takes_nv12| tells whether the encoder reads NV12 frames directly;
+// otherwise they are converted to I420 as before.
+double RunPipelineUs(const Resolution& resolution,
+                     bool keep_nv12,
+                     bool scale,
+                     bool encoder_takes_nv12) {
+  const std::vector<uint8_t> captured_frame =
+      CreateCapturedFrame(resolution.width, resolution.height);
+  int64_t checksum = 0;
+  const int64_t start_time_nanos = rtc::TimeNanos();
+  for (int i = 0; i < kNumFrames; ++i) {
+    rtc::scoped_refptr<VideoFrameBuffer> buffer = Capture(
+        captured_frame, resolution.width, resolution.height, keep_nv12);
+    if (scale) {
+      buffer = CropAndScale(buffer);
+    }
+    if (buffer->type() == VideoFrameBuffer::Type::kNV12 &&
+        encoder_takes_nv12) {
+      checksum += buffer->GetNV12()->DataUV()[0];
+    } else {
+      checksum += buffer->ToI420()->DataV()[0];
+    }
+  }
+  const int64_t elapsed_nanos = rtc::TimeNanos() - start_time_nanos;
+  // Keeps the frames from being optimized away.
+  EXPECT_GE(checksum, 0);
+  return elapsed_nanos /
+         static_cast<double>(rtc::kNumNanosecsPerMicrosec * kNumFrames);
+}
+
+}  // namespace
+
+TEST(NV12BufferPerformanceTest, CaptureToEncoder) {
+  for (const Resolution& resolution : kResolutions) {
+    const std::string story = resolution.name;
+    webrtc::test::PrintResult(
+        "capture_to_encoder_time", "_i420", story,
+        RunPipelineUs(resolution, /*keep_nv12=*/false, /*scale=*/false,
+                      /*encoder_takes_nv12=*/false),
+        "us", false);
+    webrtc::test::PrintResult(
+        "capture_to_encoder_time", "_nv12", story,
+        RunPipelineUs(resolution, /*keep_nv12=*/true, /*scale=*/false,
+                      /*encoder_takes_nv12=*/true),
+        "us", false);
+  }
+}
+
+TEST(NV12BufferPerformanceTest, CaptureCropAndScaleToEncoder) {
+  for (const Resolution& resolution : kResolutions) {
+    const std::string story = resolution.name;
+    webrtc::test::PrintResult(
+        "capture_scale_to_encoder_time", "_i420", story,
+        RunPipelineUs(resolution, /*keep_nv12=*/false, /*scale=*/true,
+                      /*encoder_takes_nv12=*/false),
+        "us", false);
+    webrtc::test::PrintResult(
+        "capture_scale_to_encoder_time", "_nv12_i420_encoder", story,
+        RunPipelineUs(resolution, /*keep_nv12=*/true, /*scale=*/true,
+                      /*encoder_takes_nv12=*/false),
+        "us", false);
+    webrtc::test::PrintResult(
+        "capture_scale_to_encoder_time", "_nv12", story,
+        RunPipelineUs(resolution, /*keep_nv12=*/true, /*scale=*/true,
+                      /*encoder_takes_nv12=*/true),
+        "us", false);
+  }
+}
+
+}  // namespace webrtc
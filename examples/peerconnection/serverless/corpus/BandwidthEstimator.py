@@ -5,14 +5,22 @@ class Estimator(object):
         stats is a dict with the following items
         {
             "send_time_ms": uint,
+            "send_time_us": int,
             "arrival_time_ms": uint,
             "payload_type": int,
             "sequence_number": uint,
             "ssrc": int,
             "padding_length": uint,
             "header_length": uint,
-            "payload_size": uint
+            "payload_size": uint,
+            "ecn_ce_count": uint
         }
+        ecn_ce_count is the number of packets received so far that were marked
+        Congestion Experienced, which needs "ecn" enabled in the config.
+        send_time_us is the send time on the sender's clock in microseconds.
+        It is only sub-millisecond accurate if the sender writes the
+        transport send time header extension, see
+        WebRTC-TransportSendTimeAdvertised.
         '''
         pass
 
@@ -17,9 +17,9 @@ VideoOptions::VideoOptions()
 VideoOptions::~VideoOptions() = default;
 
 MediaChannel::MediaChannel(const MediaConfig& config)
-    : enable_dscp_(config.enable_dscp) {}
+    : enable_dscp_(config.enable_dscp), enable_ecn_(config.enable_ecn) {}
 
-MediaChannel::MediaChannel() : enable_dscp_(false) {}
+MediaChannel::MediaChannel() : enable_dscp_(false), enable_ecn_(false) {}
 
 MediaChannel::~MediaChannel() {}
 
@@ -30,6 +30,16 @@ void MediaChannel::SetInterface(
   network_interface_ = iface;
   media_transport_config_ = media_transport_config;
   UpdateDscp();
+  UpdateEcn();
+}
+
+void MediaChannel::OnRtpPacketReceived(
+    const webrtc::RtpPacketReceived& packet) {
+  int64_t packet_time_us = -1;
+  if (packet.arrival_time_ms() > 0) {
+    packet_time_us = packet.arrival_time_ms() * 1000;
+  }
+  OnPacketReceived(packet.Buffer(), packet_time_us);
 }
 
 int MediaChannel::GetRtpSendTimeExtnId() const {
@@ -42,6 +42,7 @@
 #include "media/base/stream_params.h"
 #include "modules/audio_processing/include/audio_processing_statistics.h"
 #include "modules/rtp_rtcp/include/report_block_data.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/callback.h"
@@ -49,6 +50,7 @@
 #include "rtc_base/critical_section.h"
 #include "rtc_base/dscp.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/network/ecn_marking.h"
 #include "rtc_base/network_route.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/string_encode.h"
@@ -207,6 +209,11 @@ class MediaChannel : public sigslot::has_slots<> {
   // Called when a RTP packet is received.
   virtual void OnPacketReceived(rtc::CopyOnWriteBuffer packet,
                                 int64_t packet_time_us) = 0;
+  // Called when a RTP packet that has already been parsed by the transport is
+  // received. The default implementation forwards the raw packet to
+  // OnPacketReceived(); channels delivering to a webrtc::Call override it to
+  // avoid parsing the packet a second time.
+  virtual void OnRtpPacketReceived(const webrtc::RtpPacketReceived& packet);
   // Called when the socket's ability to send has changed.
   virtual void OnReadyToSend(bool ready) = 0;
   // Called when the network route used for sending packets changed.
@@ -299,6 +306,7 @@ class MediaChannel : public sigslot::has_slots<> {
 
  protected:
   bool DscpEnabled() const { return enable_dscp_; }
+  bool EcnEnabled() const { return enable_ecn_; }
 
   // This is the DSCP value used for both RTP and RTCP channels if DSCP is
   // enabled. It can be changed at any time via |SetPreferredDscp|.
@@ -329,6 +337,24 @@ class MediaChannel : public sigslot::has_slots<> {
     return ret;
   }
 
+  // Mark outgoing RTP and RTCP packets ECT(1) and report the ECN codepoint of
+  // incoming ones, if ECN is enabled.
+  int UpdateEcn() RTC_EXCLUSIVE_LOCKS_REQUIRED(network_interface_crit_) {
+    if (!enable_ecn_)
+      return 0;
+    int ret = 0;
+    for (NetworkInterface::SocketType type :
+         {NetworkInterface::ST_RTP, NetworkInterface::ST_RTCP}) {
+      if (ret == 0) {
+        ret = SetOption(type, rtc::Socket::OPT_SEND_ECN,
+                        static_cast<int>(rtc::EcnMarking::kEct1));
+      }
+      if (ret == 0)
+        ret = SetOption(type, rtc::Socket::OPT_RECV_ECN, 1);
+    }
+    return ret;
+  }
+
   bool DoSendPacket(rtc::CopyOnWriteBuffer* packet,
                     bool rtcp,
                     const rtc::PacketOptions& options) {
@@ -341,6 +367,7 @@ class MediaChannel : public sigslot::has_slots<> {
   }
 
   const bool enable_dscp_;
+  const bool enable_ecn_;
   // |network_interface_| can be accessed from the worker_thread and
   // from any MediaEngine threads. This critical section is to protect accessing
   // of network_interface_ object.
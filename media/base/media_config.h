@@ -20,6 +20,10 @@ struct MediaConfig {
   // PeerConnection constraint 'googDscp'.
   bool enable_dscp = false;
 
+  // Send packets as ECN-capable, marked ECT(1), and report the ECN marks of
+  // received packets to the bandwidth estimator.
+  bool enable_ecn = false;
+
   // Video-specific config.
   struct Video {
     // Enable WebRTC CPU Overuse Detection. This flag comes from the
@@ -65,7 +69,7 @@ struct MediaConfig {
   } audio;
 
   bool operator==(const MediaConfig& o) const {
-    return enable_dscp == o.enable_dscp &&
+    return enable_dscp == o.enable_dscp && enable_ecn == o.enable_ecn &&
            video.enable_cpu_adaptation == o.video.enable_cpu_adaptation &&
            video.suspend_below_min_bitrate ==
                o.video.suspend_below_min_bitrate &&
@@ -615,10 +615,15 @@ WebRtcVideoEngine::GetRtpHeaderExtensions() const {
     result.emplace_back(uri, id++, webrtc::RtpTransceiverDirection::kSendRecv);
   }
   result.emplace_back(
-      webrtc::RtpExtension::kGenericFrameDescriptorUri00, id,
+      webrtc::RtpExtension::kGenericFrameDescriptorUri00, id++,
       webrtc::field_trial::IsEnabled("WebRTC-GenericDescriptorAdvertised")
           ? webrtc::RtpTransceiverDirection::kSendRecv
           : webrtc::RtpTransceiverDirection::kStopped);
+  result.emplace_back(
+      webrtc::RtpExtension::kTransportSendTimeUri, id,
+      webrtc::field_trial::IsEnabled("WebRTC-TransportSendTimeAdvertised")
+          ? webrtc::RtpTransceiverDirection::kSendRecv
+          : webrtc::RtpTransceiverDirection::kStopped);
   return result;
 }
 
@@ -1642,7 +1647,31 @@ void WebRtcVideoChannel::OnPacketReceived(rtc::CopyOnWriteBuffer packet,
     case webrtc::PacketReceiver::DELIVERY_UNKNOWN_SSRC:
       break;
   }
+  OnUnknownSsrcPacket(std::move(packet), packet_time_us);
+}
+
+void WebRtcVideoChannel::OnRtpPacketReceived(
+    const webrtc::RtpPacketReceived& packet) {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  const webrtc::PacketReceiver::DeliveryStatus delivery_result =
+      call_->Receiver()->DeliverRtpPacket(webrtc::MediaType::VIDEO, packet);
+  switch (delivery_result) {
+    case webrtc::PacketReceiver::DELIVERY_OK:
+      return;
+    case webrtc::PacketReceiver::DELIVERY_PACKET_ERROR:
+      return;
+    case webrtc::PacketReceiver::DELIVERY_UNKNOWN_SSRC:
+      break;
+  }
+  int64_t packet_time_us = -1;
+  if (packet.arrival_time_ms() > 0) {
+    packet_time_us = packet.arrival_time_ms() * 1000;
+  }
+  OnUnknownSsrcPacket(packet.Buffer(), packet_time_us);
+}
 
+void WebRtcVideoChannel::OnUnknownSsrcPacket(rtc::CopyOnWriteBuffer packet,
+                                             int64_t packet_time_us) {
   uint32_t ssrc = 0;
   if (!GetRtpSsrc(packet.cdata(), packet.size(), &ssrc)) {
     return;
@@ -166,6 +166,7 @@ class WebRtcVideoChannel : public VideoMediaChannel,
 
   void OnPacketReceived(rtc::CopyOnWriteBuffer packet,
                         int64_t packet_time_us) override;
+  void OnRtpPacketReceived(const webrtc::RtpPacketReceived& packet) override;
   void OnReadyToSend(bool ready) override;
   void OnNetworkRouteChanged(const std::string& transport_name,
                              const rtc::NetworkRoute& network_route) override;
@@ -256,6 +257,11 @@ class WebRtcVideoChannel : public VideoMediaChannel,
   WebRtcVideoReceiveStream* FindReceiveStream(uint32_t ssrc)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(thread_checker_);
 
+  // Buffers, drops or creates an unsignalled receive stream for a packet that
+  // the call could not deliver because of an unknown SSRC.
+  void OnUnknownSsrcPacket(rtc::CopyOnWriteBuffer packet,
+                           int64_t packet_time_us);
+
   struct VideoCodecSettings {
     VideoCodecSettings();
 
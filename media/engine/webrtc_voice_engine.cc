@@ -559,6 +559,11 @@ WebRtcVoiceEngine::GetRtpHeaderExtensions() const {
         webrtc::RtpExtension::kRepairedRidUri}) {
     result.emplace_back(uri, id++, webrtc::RtpTransceiverDirection::kSendRecv);
   }
+  result.emplace_back(
+      webrtc::RtpExtension::kTransportSendTimeUri, id,
+      webrtc::field_trial::IsEnabled("WebRTC-TransportSendTimeAdvertised")
+          ? webrtc::RtpTransceiverDirection::kSendRecv
+          : webrtc::RtpTransceiverDirection::kStopped);
   return result;
 }
 
@@ -2078,7 +2083,29 @@ void WebRtcVoiceMediaChannel::OnPacketReceived(rtc::CopyOnWriteBuffer packet,
   if (delivery_result != webrtc::PacketReceiver::DELIVERY_UNKNOWN_SSRC) {
     return;
   }
+  OnUnknownSsrcPacket(std::move(packet), packet_time_us);
+}
+
+void WebRtcVoiceMediaChannel::OnRtpPacketReceived(
+    const webrtc::RtpPacketReceived& packet) {
+  RTC_DCHECK(worker_thread_checker_.IsCurrent());
+
+  webrtc::PacketReceiver::DeliveryStatus delivery_result =
+      call_->Receiver()->DeliverRtpPacket(webrtc::MediaType::AUDIO, packet);
+
+  if (delivery_result != webrtc::PacketReceiver::DELIVERY_UNKNOWN_SSRC) {
+    return;
+  }
+  int64_t packet_time_us = -1;
+  if (packet.arrival_time_ms() > 0) {
+    packet_time_us = packet.arrival_time_ms() * 1000;
+  }
+  OnUnknownSsrcPacket(packet.Buffer(), packet_time_us);
+}
 
+void WebRtcVoiceMediaChannel::OnUnknownSsrcPacket(
+    rtc::CopyOnWriteBuffer packet,
+    int64_t packet_time_us) {
   // Create an unsignaled receive stream for this previously not received ssrc.
   // If there already is N unsignaled receive streams, delete the oldest.
   // See: https://bugs.chromium.org/p/webrtc/issues/detail?id=5208
@@ -2125,8 +2152,9 @@ void WebRtcVoiceMediaChannel::OnPacketReceived(rtc::CopyOnWriteBuffer packet,
     SetRawAudioSink(ssrc, std::move(proxy_sink));
   }
 
-  delivery_result = call_->Receiver()->DeliverPacket(webrtc::MediaType::AUDIO,
-                                                     packet, packet_time_us);
+  webrtc::PacketReceiver::DeliveryStatus delivery_result =
+      call_->Receiver()->DeliverPacket(webrtc::MediaType::AUDIO, packet,
+                                       packet_time_us);
   RTC_DCHECK_NE(webrtc::PacketReceiver::DELIVERY_UNKNOWN_SSRC, delivery_result);
 }
 
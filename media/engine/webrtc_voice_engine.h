@@ -193,6 +193,7 @@ class WebRtcVoiceMediaChannel final : public VoiceMediaChannel,
 
   void OnPacketReceived(rtc::CopyOnWriteBuffer packet,
                         int64_t packet_time_us) override;
+  void OnRtpPacketReceived(const webrtc::RtpPacketReceived& packet) override;
   void OnNetworkRouteChanged(const std::string& transport_name,
                              const rtc::NetworkRoute& network_route) override;
   void OnReadyToSend(bool ready) override;
@@ -260,6 +261,10 @@ class WebRtcVoiceMediaChannel final : public VoiceMediaChannel,
   bool DeleteVoEChannel(int channel);
   bool SetMaxSendBitrate(int bps);
   void SetupRecording();
+  // Creates an unsignaled receive stream for a packet that the call could not
+  // deliver because of an unknown SSRC, and re-delivers the packet.
+  void OnUnknownSsrcPacket(rtc::CopyOnWriteBuffer packet,
+                           int64_t packet_time_us);
   // Check if 'ssrc' is an unsignaled stream, and if so mark it as not being
   // unsignaled anymore (i.e. it is now removed, or signaled), and return true.
   bool MaybeDeregisterUnsignaledRecvStream(uint32_t ssrc);
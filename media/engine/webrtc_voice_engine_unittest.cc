@@ -30,6 +30,7 @@
 #include "media/engine/fake_webrtc_call.h"
 #include "modules/audio_device/include/mock_audio_device.h"
 #include "modules/audio_processing/include/mock_audio_processing.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "rtc_base/arraysize.h"
 #include "rtc_base/byte_order.h"
 #include "rtc_base/numerics/safe_conversions.h"
@@ -2601,6 +2602,22 @@ TEST_P(WebRtcVoiceEngineTestFake, RecvUnsignaled) {
       GetRecvStream(kSsrc1).VerifyLastPacket(kPcmuFrame, sizeof(kPcmuFrame)));
 }
 
+// Tests that a packet parsed by the transport creates an unsignaled receive
+// stream in the same way as a raw packet.
+TEST_P(WebRtcVoiceEngineTestFake, RecvUnsignaledParsedPacket) {
+  EXPECT_TRUE(SetupChannel());
+  EXPECT_EQ(0u, call_.GetAudioReceiveStreams().size());
+
+  webrtc::RtpPacketReceived parsed_packet;
+  ASSERT_TRUE(parsed_packet.Parse(kPcmuFrame, sizeof(kPcmuFrame)));
+  parsed_packet.set_arrival_time_ms(1234);
+  channel_->OnRtpPacketReceived(parsed_packet);
+
+  EXPECT_EQ(1u, call_.GetAudioReceiveStreams().size());
+  EXPECT_TRUE(
+      GetRecvStream(kSsrc1).VerifyLastPacket(kPcmuFrame, sizeof(kPcmuFrame)));
+}
+
 // Tests that when we add a stream without SSRCs, but contains a stream_id
 // that it is stored and its stream id is later used when the first packet
 // arrives to properly create a receive stream with a sync label.
@@ -0,0 +1,132 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/audio_network_adaptor/alpha_cc_controller.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace audio_network_adaptor {
+
+AlphaCcController::Config::Config() = default;
+
+AlphaCcController::Config::~Config() = default;
+
+AlphaCcController::AlphaCcController(const Config& config)
+    : config_(config),
+      fec_enabled_(config_.initial_fec_enabled),
+      bitrate_bps_(config_.initial_bitrate_bps) {
+  RTC_DCHECK_GT(config_.frame_length_ms, 0);
+  RTC_DCHECK_GT(config_.protected_frame_length_ms, 0);
+  RTC_DCHECK_LE(config_.fec_disabling_packet_loss_fraction,
+                config_.fec_enabling_packet_loss_fraction);
+  RTC_DCHECK_LE(config_.protection_enabling_bandwidth_bps,
+                config_.protection_disabling_bandwidth_bps);
+}
+
+AlphaCcController::~AlphaCcController() = default;
+
+void AlphaCcController::UpdateNetworkMetrics(
+    const NetworkMetrics& network_metrics) {
+  if (network_metrics.network_estimate_bps) {
+    RTC_DCHECK(network_metrics.network_estimate_time_ms);
+    OnNetworkEstimate(network_metrics.network_estimate_time_ms.value_or(0),
+                      *network_metrics.network_estimate_bps);
+  }
+  if (network_metrics.uplink_packet_loss_fraction)
+    packet_loss_fraction_ = network_metrics.uplink_packet_loss_fraction;
+  if (network_metrics.target_audio_bitrate_bps)
+    target_audio_bitrate_bps_ = network_metrics.target_audio_bitrate_bps;
+  if (network_metrics.overhead_bytes_per_packet) {
+    RTC_DCHECK_GT(*network_metrics.overhead_bytes_per_packet, 0);
+    overhead_bytes_per_packet_ = network_metrics.overhead_bytes_per_packet;
+  }
+}
+
+void AlphaCcController::MakeDecision(AudioEncoderRuntimeConfig* config) {
+  // Decisions on |frame_length_ms|, |enable_fec| and |bitrate_bps| should not
+  // have been made.
+  RTC_DCHECK(!config->frame_length_ms);
+  RTC_DCHECK(!config->enable_fec);
+  RTC_DCHECK(!config->bitrate_bps);
+
+  if (packet_loss_fraction_) {
+    if (fec_enabled_ && *packet_loss_fraction_ <=
+                            config_.fec_disabling_packet_loss_fraction) {
+      fec_enabled_ = false;
+    } else if (!fec_enabled_ && *packet_loss_fraction_ >=
+                                    config_.fec_enabling_packet_loss_fraction) {
+      fec_enabled_ = true;
+    }
+  }
+  config->enable_fec = fec_enabled_ || protecting_;
+  // The encoder only spends bits on FEC for the loss it's told to expect, so
+  // while protected it's told to expect at least the loss that switches FEC
+  // on.
+  float packet_loss_fraction = packet_loss_fraction_.value_or(0.0f);
+  if (protecting_) {
+    packet_loss_fraction = std::max(
+        packet_loss_fraction, config_.fec_enabling_packet_loss_fraction);
+  }
+  config->uplink_packet_loss_fraction = packet_loss_fraction;
+
+  const int frame_length_ms = protecting_ ? config_.protected_frame_length_ms
+                                          : config_.frame_length_ms;
+  config->frame_length_ms = frame_length_ms;
+  config->last_fl_change_increase = protecting_;
+
+  if (target_audio_bitrate_bps_) {
+    const int overhead_rate_bps =
+        overhead_bytes_per_packet_
+            ? static_cast<int>(*overhead_bytes_per_packet_ * 8 * 1000 /
+                               frame_length_ms)
+            : 0;
+    bitrate_bps_ = std::max(0, *target_audio_bitrate_bps_ - overhead_rate_bps);
+    if (protecting_ && network_estimate_bps_) {
+      bitrate_bps_ =
+          std::min(bitrate_bps_,
+                   static_cast<int>(config_.protected_max_estimate_fraction *
+                                    *network_estimate_bps_));
+    }
+  }
+  config->bitrate_bps = bitrate_bps_;
+}
+
+void AlphaCcController::OnNetworkEstimate(int64_t now_ms,
+                                          int network_estimate_bps) {
+  network_estimate_bps_ = network_estimate_bps;
+  while (!window_.empty() &&
+         window_.front().first <= now_ms - config_.collapse_window_ms) {
+    window_.pop_front();
+  }
+  while (!window_.empty() && window_.back().second <= network_estimate_bps)
+    window_.pop_back();
+  window_.emplace_back(now_ms, network_estimate_bps);
+
+  const int max_estimate_bps = window_.front().second;
+  const bool collapsed = network_estimate_bps <
+                         (1.0f - config_.collapse_drop_fraction) *
+                             max_estimate_bps;
+  if (collapsed ||
+      network_estimate_bps <= config_.protection_enabling_bandwidth_bps) {
+    protecting_ = true;
+    last_collapse_ms_ = now_ms;
+  } else if (protecting_ &&
+             network_estimate_bps >=
+                 config_.protection_disabling_bandwidth_bps &&
+             now_ms - last_collapse_ms_ >= config_.hold_time_ms) {
+    protecting_ = false;
+  }
+}
+
+}  // namespace audio_network_adaptor
+}  // namespace webrtc
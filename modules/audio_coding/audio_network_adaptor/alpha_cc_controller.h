@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_ALPHA_CC_CONTROLLER_H_
+#define MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_ALPHA_CC_CONTROLLER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <utility>
+
+#include "absl/types/optional.h"
+#include "modules/audio_coding/audio_network_adaptor/controller.h"
+#include "modules/audio_coding/audio_network_adaptor/include/audio_network_adaptor_config.h"
+#include "rtc_base/constructor_magic.h"
+
+namespace webrtc {
+namespace audio_network_adaptor {
+
+// Decides frame length, FEC and bitrate from the estimate of the AlphaCC
+// bandwidth estimator, its rate of change and the packet loss reported by the
+// receiver. When the estimate collapses, which is when the video rate
+// collapses too, audio is protected: FEC is switched on, the frame length is
+// increased to cut the per-packet overhead, and the bitrate is capped to a
+// share of the estimate. Protection is held for a while after the last
+// collapse, so that the encoder doesn't flap while the estimate recovers.
+// Takes the place of the frame length, FEC and bitrate controllers.
+class AlphaCcController final : public Controller {
+ public:
+  struct Config {
+    Config();
+    ~Config();
+    int initial_bitrate_bps = 32000;
+    bool initial_fec_enabled = false;
+    int frame_length_ms = 20;
+    // Frame length while audio is protected.
+    int protected_frame_length_ms = 60;
+    // Packet loss above which FEC is switched on, and below which it's
+    // switched off again when audio isn't protected.
+    float fec_enabling_packet_loss_fraction = 0.05f;
+    float fec_disabling_packet_loss_fraction = 0.02f;
+    // The estimate has collapsed when it has fallen by more than this fraction
+    // of its maximum in the last |collapse_window_ms|.
+    float collapse_drop_fraction = 0.4f;
+    int collapse_window_ms = 2000;
+    // Estimates below which audio is protected, and above which protection may
+    // end.
+    int protection_enabling_bandwidth_bps = 80000;
+    int protection_disabling_bandwidth_bps = 150000;
+    // Least time audio stays protected after the last collapse.
+    int hold_time_ms = 5000;
+    // Largest share of the estimate the encoder may use while protected.
+    float protected_max_estimate_fraction = 0.25f;
+  };
+
+  explicit AlphaCcController(const Config& config);
+
+  ~AlphaCcController() override;
+
+  void UpdateNetworkMetrics(const NetworkMetrics& network_metrics) override;
+
+  void MakeDecision(AudioEncoderRuntimeConfig* config) override;
+
+  bool protecting() const { return protecting_; }
+
+ private:
+  void OnNetworkEstimate(int64_t now_ms, int network_estimate_bps);
+
+  const Config config_;
+  bool protecting_ = false;
+  bool fec_enabled_;
+  int bitrate_bps_;
+  int64_t last_collapse_ms_ = 0;
+  // Estimates in the last |collapse_window_ms|, by time, with decreasing
+  // estimates so that the first is the maximum.
+  std::deque<std::pair<int64_t, int>> window_;
+  absl::optional<int> network_estimate_bps_;
+  absl::optional<float> packet_loss_fraction_;
+  absl::optional<int> target_audio_bitrate_bps_;
+  absl::optional<size_t> overhead_bytes_per_packet_;
+  RTC_DISALLOW_COPY_AND_ASSIGN(AlphaCcController);
+};
+
+}  // namespace audio_network_adaptor
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_ALPHA_CC_CONTROLLER_H_
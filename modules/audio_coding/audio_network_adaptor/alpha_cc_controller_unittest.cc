@@ -0,0 +1,186 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/audio_network_adaptor/alpha_cc_controller.h"
+
+#include "rtc_base/fake_clock.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace audio_network_adaptor {
+
+namespace {
+
+constexpr int kInitialBitrateBps = 32000;
+constexpr int kTargetAudioBitrateBps = 40000;
+constexpr size_t kOverheadBytesPerPacket = 50;
+constexpr int kHighEstimateBps = 1000000;
+
+AlphaCcController::Config CreateConfig() {
+  AlphaCcController::Config config;
+  config.initial_bitrate_bps = kInitialBitrateBps;
+  config.initial_fec_enabled = false;
+  config.frame_length_ms = 20;
+  config.protected_frame_length_ms = 60;
+  config.fec_enabling_packet_loss_fraction = 0.05f;
+  config.fec_disabling_packet_loss_fraction = 0.02f;
+  config.collapse_drop_fraction = 0.4f;
+  config.collapse_window_ms = 2000;
+  config.protection_enabling_bandwidth_bps = 80000;
+  config.protection_disabling_bandwidth_bps = 150000;
+  config.hold_time_ms = 5000;
+  config.protected_max_estimate_fraction = 0.25f;
+  return config;
+}
+
+void UpdateNetworkEstimate(AlphaCcController* controller,
+                           const rtc::FakeClock& clock,
+                           int network_estimate_bps) {
+  Controller::NetworkMetrics network_metrics;
+  network_metrics.network_estimate_bps = network_estimate_bps;
+  network_metrics.network_estimate_time_ms =
+      clock.TimeNanos() / rtc::kNumNanosecsPerMillisec;
+  controller->UpdateNetworkMetrics(network_metrics);
+}
+
+void UpdatePacketLoss(AlphaCcController* controller,
+                      float packet_loss_fraction) {
+  Controller::NetworkMetrics network_metrics;
+  network_metrics.uplink_packet_loss_fraction = packet_loss_fraction;
+  controller->UpdateNetworkMetrics(network_metrics);
+}
+
+void UpdateTargetBitrate(AlphaCcController* controller) {
+  Controller::NetworkMetrics network_metrics;
+  network_metrics.target_audio_bitrate_bps = kTargetAudioBitrateBps;
+  network_metrics.overhead_bytes_per_packet = kOverheadBytesPerPacket;
+  controller->UpdateNetworkMetrics(network_metrics);
+}
+
+void CheckDecision(AlphaCcController* controller,
+                   int expected_frame_length_ms,
+                   bool expected_fec_enabled,
+                   int expected_bitrate_bps) {
+  AudioEncoderRuntimeConfig config;
+  controller->MakeDecision(&config);
+  EXPECT_EQ(expected_frame_length_ms, config.frame_length_ms);
+  EXPECT_EQ(expected_fec_enabled, config.enable_fec);
+  EXPECT_EQ(expected_bitrate_bps, config.bitrate_bps);
+}
+
+int BitrateWithoutOverhead(int frame_length_ms) {
+  return kTargetAudioBitrateBps -
+         kOverheadBytesPerPacket * 8 * 1000 / frame_length_ms;
+}
+
+}  // namespace
+
+TEST(AlphaCcControllerTest, OutputInitValuesWhenMetricsUnknown) {
+  AlphaCcController controller(CreateConfig());
+  CheckDecision(&controller, 20, false, kInitialBitrateBps);
+}
+
+TEST(AlphaCcControllerTest, SubtractsOverheadFromTargetBitrate) {
+  rtc::FakeClock fake_clock;
+  AlphaCcController controller(CreateConfig());
+  UpdateNetworkEstimate(&controller, fake_clock, kHighEstimateBps);
+  UpdateTargetBitrate(&controller);
+  CheckDecision(&controller, 20, false, BitrateWithoutOverhead(20));
+}
+
+TEST(AlphaCcControllerTest, EnablesFecWithHysteresisOnPacketLoss) {
+  AlphaCcController controller(CreateConfig());
+  UpdatePacketLoss(&controller, 0.04f);
+  CheckDecision(&controller, 20, false, kInitialBitrateBps);
+  UpdatePacketLoss(&controller, 0.05f);
+  CheckDecision(&controller, 20, true, kInitialBitrateBps);
+  UpdatePacketLoss(&controller, 0.03f);
+  CheckDecision(&controller, 20, true, kInitialBitrateBps);
+  UpdatePacketLoss(&controller, 0.02f);
+  CheckDecision(&controller, 20, false, kInitialBitrateBps);
+}
+
+TEST(AlphaCcControllerTest, ProtectsAudioWhenEstimateCollapses) {
+  rtc::FakeClock fake_clock;
+  AlphaCcController controller(CreateConfig());
+  UpdateTargetBitrate(&controller);
+  UpdateNetworkEstimate(&controller, fake_clock, kHighEstimateBps);
+  EXPECT_FALSE(controller.protecting());
+
+  // Still well above the protection threshold, but 50 % down in a second.
+  fake_clock.AdvanceTime(TimeDelta::Millis(1000));
+  UpdateNetworkEstimate(&controller, fake_clock, kHighEstimateBps / 2);
+  EXPECT_TRUE(controller.protecting());
+  AudioEncoderRuntimeConfig config;
+  controller.MakeDecision(&config);
+  EXPECT_EQ(60, config.frame_length_ms);
+  EXPECT_EQ(true, config.enable_fec);
+  EXPECT_EQ(BitrateWithoutOverhead(60), config.bitrate_bps);
+  // The encoder is told to expect loss so that it spends bits on FEC.
+  EXPECT_EQ(0.05f, config.uplink_packet_loss_fraction);
+}
+
+TEST(AlphaCcControllerTest, DoesNotProtectAudioOnSlowDecrease) {
+  rtc::FakeClock fake_clock;
+  AlphaCcController controller(CreateConfig());
+  int estimate_bps = kHighEstimateBps;
+  for (int i = 0; i < 50; ++i) {
+    UpdateNetworkEstimate(&controller, fake_clock, estimate_bps);
+    EXPECT_FALSE(controller.protecting());
+    fake_clock.AdvanceTime(TimeDelta::Millis(1000));
+    estimate_bps = estimate_bps * 9 / 10;
+    if (estimate_bps < 200000)
+      break;
+  }
+}
+
+TEST(AlphaCcControllerTest, CapsBitrateToShareOfLowEstimate) {
+  rtc::FakeClock fake_clock;
+  AlphaCcController controller(CreateConfig());
+  UpdateTargetBitrate(&controller);
+  UpdateNetworkEstimate(&controller, fake_clock, 60000);
+  EXPECT_TRUE(controller.protecting());
+  CheckDecision(&controller, 60, true, 15000);
+}
+
+TEST(AlphaCcControllerTest, HoldsProtectionAfterCollapse) {
+  rtc::FakeClock fake_clock;
+  AlphaCcController controller(CreateConfig());
+  UpdateNetworkEstimate(&controller, fake_clock, kHighEstimateBps);
+  UpdateNetworkEstimate(&controller, fake_clock, 60000);
+  EXPECT_TRUE(controller.protecting());
+
+  // Recovered, but not for long enough.
+  fake_clock.AdvanceTime(TimeDelta::Millis(4000));
+  UpdateNetworkEstimate(&controller, fake_clock, kHighEstimateBps);
+  EXPECT_TRUE(controller.protecting());
+
+  fake_clock.AdvanceTime(TimeDelta::Millis(1000));
+  UpdateNetworkEstimate(&controller, fake_clock, kHighEstimateBps);
+  EXPECT_FALSE(controller.protecting());
+  CheckDecision(&controller, 20, false, kInitialBitrateBps);
+}
+
+TEST(AlphaCcControllerTest, KeepsProtectionBetweenThresholds) {
+  rtc::FakeClock fake_clock;
+  AlphaCcController controller(CreateConfig());
+  UpdateNetworkEstimate(&controller, fake_clock, 60000);
+  EXPECT_TRUE(controller.protecting());
+  fake_clock.AdvanceTime(TimeDelta::Millis(10000));
+  UpdateNetworkEstimate(&controller, fake_clock, 100000);
+  EXPECT_TRUE(controller.protecting());
+  fake_clock.AdvanceTime(TimeDelta::Millis(1000));
+  UpdateNetworkEstimate(&controller, fake_clock, 150000);
+  EXPECT_FALSE(controller.protecting());
+}
+
+}  // namespace audio_network_adaptor
+}  // namespace webrtc
@@ -100,6 +100,16 @@ void AudioNetworkAdaptorImpl::SetOverhead(size_t overhead_bytes_per_packet) {
   UpdateNetworkMetrics(network_metrics);
 }
 
+void AudioNetworkAdaptorImpl::SetNetworkEstimate(int network_estimate_bps) {
+  last_metrics_.network_estimate_bps = network_estimate_bps;
+  DumpNetworkMetrics();
+
+  Controller::NetworkMetrics network_metrics;
+  network_metrics.network_estimate_bps = network_estimate_bps;
+  network_metrics.network_estimate_time_ms = rtc::TimeMillis();
+  UpdateNetworkMetrics(network_metrics);
+}
+
 AudioEncoderRuntimeConfig AudioNetworkAdaptorImpl::GetEncoderRuntimeConfig() {
   AudioEncoderRuntimeConfig config;
   for (auto& controller :
@@ -54,6 +54,8 @@ class AudioNetworkAdaptorImpl final : public AudioNetworkAdaptor {
 
   void SetOverhead(size_t overhead_bytes_per_packet) override;
 
+  void SetNetworkEstimate(int network_estimate_bps) override;
+
   AudioEncoderRuntimeConfig GetEncoderRuntimeConfig() override;
 
   void StartDebugDump(FILE* file_handle) override;
@@ -41,7 +41,10 @@ MATCHER_P(NetworkMetricsIs, metric, "") {
          arg.target_audio_bitrate_bps == metric.target_audio_bitrate_bps &&
          arg.rtt_ms == metric.rtt_ms &&
          arg.overhead_bytes_per_packet == metric.overhead_bytes_per_packet &&
-         arg.uplink_packet_loss_fraction == metric.uplink_packet_loss_fraction;
+         arg.uplink_packet_loss_fraction ==
+             metric.uplink_packet_loss_fraction &&
+         arg.network_estimate_bps == metric.network_estimate_bps &&
+         arg.network_estimate_time_ms == metric.network_estimate_time_ms;
 }
 
 MATCHER_P(IsRtcEventAnaConfigEqualTo, config, "") {
@@ -145,6 +148,19 @@ TEST(AudioNetworkAdaptorImplTest, UpdateNetworkMetricsIsCalledOnSetRtt) {
   states.audio_network_adaptor->SetRtt(kRtt);
 }
 
+TEST(AudioNetworkAdaptorImplTest,
+     UpdateNetworkMetricsIsCalledOnSetNetworkEstimate) {
+  rtc::ScopedFakeClock fake_clock;
+  fake_clock.AdvanceTime(TimeDelta::Millis(kClockInitialTimeMs));
+  auto states = CreateAudioNetworkAdaptor();
+  constexpr int kNetworkEstimate = 500000;
+  Controller::NetworkMetrics check;
+  check.network_estimate_bps = kNetworkEstimate;
+  check.network_estimate_time_ms = kClockInitialTimeMs;
+  SetExpectCallToUpdateNetworkMetrics(states.mock_controllers, check);
+  states.audio_network_adaptor->SetNetworkEstimate(kNetworkEstimate);
+}
+
 TEST(AudioNetworkAdaptorImplTest,
      UpdateNetworkMetricsIsCalledOnSetTargetAudioBitrate) {
   auto states = CreateAudioNetworkAdaptor();
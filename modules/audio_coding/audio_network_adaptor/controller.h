@@ -26,6 +26,10 @@ class Controller {
     absl::optional<int> target_audio_bitrate_bps;
     absl::optional<int> rtt_ms;
     absl::optional<size_t> overhead_bytes_per_packet;
+    // Estimate of the bandwidth estimator, before it's shared between the
+    // streams, and the time in ms it was set. Both are set together.
+    absl::optional<int> network_estimate_bps;
+    absl::optional<int64_t> network_estimate_time_ms;
   };
 
   virtual ~Controller() = default;
@@ -11,9 +11,12 @@
 #include "modules/audio_coding/audio_network_adaptor/controller_manager.h"
 
 #include <cmath>
+#include <memory>
 #include <string>
 #include <utility>
 
+#include "absl/algorithm/container.h"
+#include "modules/audio_coding/audio_network_adaptor/alpha_cc_controller.h"
 #include "modules/audio_coding/audio_network_adaptor/bitrate_controller.h"
 #include "modules/audio_coding/audio_network_adaptor/channel_controller.h"
 #include "modules/audio_coding/audio_network_adaptor/debug_dump_writer.h"
@@ -197,6 +200,56 @@ std::unique_ptr<BitrateController> CreateBitrateController(
           initial_bitrate_bps, initial_frame_length_ms,
           fl_increase_overhead_offset, fl_decrease_overhead_offset)));
 }
+
+using audio_network_adaptor::AlphaCcController;
+std::unique_ptr<AlphaCcController> CreateAlphaCcController(
+    const audio_network_adaptor::config::AlphaCcController& alpha_cc_config,
+    rtc::ArrayView<const int> encoder_frame_lengths_ms,
+    int initial_frame_length_ms,
+    int initial_bitrate_bps,
+    bool initial_fec_enabled) {
+  AlphaCcController::Config config;
+  config.initial_bitrate_bps = initial_bitrate_bps;
+  config.initial_fec_enabled = initial_fec_enabled;
+  config.frame_length_ms = initial_frame_length_ms;
+  if (alpha_cc_config.has_frame_length_ms())
+    config.frame_length_ms = alpha_cc_config.frame_length_ms();
+  if (alpha_cc_config.has_protected_frame_length_ms()) {
+    config.protected_frame_length_ms =
+        alpha_cc_config.protected_frame_length_ms();
+  }
+  RTC_CHECK(absl::c_linear_search(encoder_frame_lengths_ms,
+                                  config.frame_length_ms));
+  RTC_CHECK(absl::c_linear_search(encoder_frame_lengths_ms,
+                                  config.protected_frame_length_ms));
+  if (alpha_cc_config.has_fec_enabling_packet_loss_fraction()) {
+    config.fec_enabling_packet_loss_fraction =
+        alpha_cc_config.fec_enabling_packet_loss_fraction();
+  }
+  if (alpha_cc_config.has_fec_disabling_packet_loss_fraction()) {
+    config.fec_disabling_packet_loss_fraction =
+        alpha_cc_config.fec_disabling_packet_loss_fraction();
+  }
+  if (alpha_cc_config.has_collapse_drop_fraction())
+    config.collapse_drop_fraction = alpha_cc_config.collapse_drop_fraction();
+  if (alpha_cc_config.has_collapse_window_ms())
+    config.collapse_window_ms = alpha_cc_config.collapse_window_ms();
+  if (alpha_cc_config.has_protection_enabling_bandwidth_bps()) {
+    config.protection_enabling_bandwidth_bps =
+        alpha_cc_config.protection_enabling_bandwidth_bps();
+  }
+  if (alpha_cc_config.has_protection_disabling_bandwidth_bps()) {
+    config.protection_disabling_bandwidth_bps =
+        alpha_cc_config.protection_disabling_bandwidth_bps();
+  }
+  if (alpha_cc_config.has_hold_time_ms())
+    config.hold_time_ms = alpha_cc_config.hold_time_ms();
+  if (alpha_cc_config.has_protected_max_estimate_fraction()) {
+    config.protected_max_estimate_fraction =
+        alpha_cc_config.protected_max_estimate_fraction();
+  }
+  return std::make_unique<AlphaCcController>(config);
+}
 #endif  // WEBRTC_ENABLE_PROTOBUF
 
 }  // namespace
@@ -277,6 +330,11 @@ std::unique_ptr<ControllerManager> ControllerManagerImpl::Create(
             controller_config.bitrate_controller(), initial_bitrate_bps,
             initial_frame_length_ms);
         break;
+      case audio_network_adaptor::config::Controller::kAlphaCcController:
+        controller = CreateAlphaCcController(
+            controller_config.alpha_cc_controller(), encoder_frame_lengths_ms,
+            initial_frame_length_ms, initial_bitrate_bps, initial_fec_enabled);
+        break;
       default:
         RTC_NOTREACHED();
     }
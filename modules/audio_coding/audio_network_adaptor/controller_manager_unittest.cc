@@ -410,6 +410,29 @@ TEST(ControllerManagerTest, CreateCharPointFreeConfigAndCheckDefaultOrder) {
                                   ControllerType::BIT_RATE});
 }
 
+TEST(ControllerManagerTest, CreateAlphaCcControllerFromConfigString) {
+  audio_network_adaptor::config::ControllerManager config;
+  AddDtxControllerConfig(&config);
+  auto alpha_cc_config =
+      config.add_controllers()->mutable_alpha_cc_controller();
+  alpha_cc_config->set_protected_frame_length_ms(60);
+
+  std::string config_string;
+  config.SerializeToString(&config_string);
+
+  auto states = CreateControllerManager(config_string);
+  auto controllers = states.controller_manager->GetControllers();
+  ASSERT_EQ(2u, controllers.size());
+
+  // Without network metrics, the AlphaCC controller decides on the initial
+  // frame length, FEC and bitrate.
+  AudioEncoderRuntimeConfig encoder_config;
+  controllers[1]->MakeDecision(&encoder_config);
+  EXPECT_EQ(kInitialFrameLengthMs, encoder_config.frame_length_ms);
+  EXPECT_EQ(kInitialFecEnabled, encoder_config.enable_fec);
+  EXPECT_EQ(kInitialBitrateBps, encoder_config.bitrate_bps);
+}
+
 TEST(ControllerManagerTest, CreateFromConfigStringAndCheckReordering) {
   rtc::ScopedFakeClock fake_clock;
   audio_network_adaptor::config::ControllerManager config;
@@ -105,6 +105,9 @@ void DebugDumpWriterImpl::DumpNetworkMetrics(
   if (metrics.rtt_ms)
     dump_metrics->set_rtt_ms(*metrics.rtt_ms);
 
+  if (metrics.network_estimate_bps)
+    dump_metrics->set_network_estimate_bps(*metrics.network_estimate_bps);
+
   DumpEventToFile(event, &dump_file_);
 #endif  // WEBRTC_ENABLE_PROTOBUF
 }
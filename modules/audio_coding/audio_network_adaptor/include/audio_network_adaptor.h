@@ -35,6 +35,8 @@ class AudioNetworkAdaptor {
 
   virtual void SetOverhead(size_t overhead_bytes_per_packet) = 0;
 
+  virtual void SetNetworkEstimate(int network_estimate_bps) = 0;
+
   virtual AudioEncoderRuntimeConfig GetEncoderRuntimeConfig() = 0;
 
   virtual void StartDebugDump(FILE* file_handle) = 0;
@@ -609,6 +609,8 @@ void AudioEncoderOpusImpl::OnReceivedUplinkBandwidth(
 
 void AudioEncoderOpusImpl::OnReceivedUplinkAllocation(
     BitrateAllocationUpdate update) {
+  if (audio_network_adaptor_ && !update.network_estimate.IsZero())
+    audio_network_adaptor_->SetNetworkEstimate(update.network_estimate.bps());
   OnReceivedUplinkBandwidth(update.target_bitrate.bps(), update.bwe_period.ms(),
                             update.stable_target_bitrate.bps());
 }
@@ -47,3 +47,21 @@ TEST(NetEqPerformanceTest, RunClean) {
   webrtc::test::PrintResult("neteq_performance", "", "0_pl_0_drift", runtime,
                             "ms", true);
 }
+
+// Runs a test with 10% packet losses, 10% clock drift and up to 100 ms of
+// jitter, which makes NetEq expand, accelerate and merge a lot.
+TEST(NetEqPerformanceTest, RunJitter) {
+  const int kSimulationTimeMs = 10000000;
+  const int kQuickSimulationTimeMs = 100000;
+  const int kLossPeriod = 10;  // Drop every 10th packet.
+  const double kDriftFactor = 0.1;
+  const int kMaxJitterMs = 100;
+  int64_t runtime = webrtc::test::NetEqPerformanceTest::Run(
+      webrtc::field_trial::IsEnabled("WebRTC-QuickPerfTest")
+          ? kQuickSimulationTimeMs
+          : kSimulationTimeMs,
+      kLossPeriod, kDriftFactor, kMaxJitterMs);
+  ASSERT_GT(runtime, 0);
+  webrtc::test::PrintResult("neteq_performance", "",
+                            "10_pl_10_drift_100_jitter", runtime, "ms", true);
+}
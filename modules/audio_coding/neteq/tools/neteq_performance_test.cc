@@ -10,6 +10,10 @@
 
 #include "modules/audio_coding/neteq/tools/neteq_performance_test.h"
 
+#include <map>
+#include <utility>
+#include <vector>
+
 #include "api/audio/audio_frame.h"
 #include "api/audio_codecs/builtin_audio_decoder_factory.h"
 #include "api/neteq/neteq.h"
@@ -18,6 +22,7 @@
 #include "modules/audio_coding/neteq/tools/audio_loop.h"
 #include "modules/audio_coding/neteq/tools/rtp_generator.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/random.h"
 #include "system_wrappers/include/clock.h"
 #include "test/testsupport/file_utils.h"
 
@@ -31,6 +36,13 @@ namespace test {
 int64_t NetEqPerformanceTest::Run(int runtime_ms,
                                   int lossrate,
                                   double drift_factor) {
+  return Run(runtime_ms, lossrate, drift_factor, /*max_jitter_ms=*/0);
+}
+
+int64_t NetEqPerformanceTest::Run(int runtime_ms,
+                                  int lossrate,
+                                  double drift_factor,
+                                  int max_jitter_ms) {
   const std::string kInputFileName =
       webrtc::test::ResourcePath("audio_coding/testfile32kHz", "pcm");
   const int kSampRateHz = 32000;
@@ -75,6 +87,11 @@ int64_t NetEqPerformanceTest::Run(int runtime_ms,
                                            input_samples.size(), input_payload);
   RTC_CHECK_EQ(sizeof(input_payload), payload_len);
 
+  // Packets sent but not yet arrived, by arrival time.
+  std::multimap<int32_t, std::pair<RTPHeader, std::vector<uint8_t>>>
+      packets_in_flight;
+  Random random(0x12345678);
+
   // Main loop.
   int64_t start_time_ms = clock->TimeInMilliseconds();
   AudioFrame out_frame;
@@ -86,10 +103,15 @@ int64_t NetEqPerformanceTest::Run(int runtime_ms,
         lost = ((rtp_header.sequenceNumber - 1) % lossrate) == 0;
       }
       if (!lost) {
-        // Insert packet.
-        int error = neteq->InsertPacket(rtp_header, input_payload);
-        if (error != NetEq::kOK)
-          return -1;
+        const int32_t arrival_time_ms =
+            packet_input_time_ms +
+            (max_jitter_ms > 0 ? random.Rand(0, max_jitter_ms) : 0);
+        packets_in_flight.emplace(
+            arrival_time_ms,
+            std::make_pair(rtp_header,
+                           std::vector<uint8_t>(
+                               input_payload,
+                               input_payload + sizeof(input_payload))));
       }
 
       // Get next packet.
@@ -103,6 +125,16 @@ int64_t NetEqPerformanceTest::Run(int runtime_ms,
       RTC_DCHECK_EQ(payload_len, kInputBlockSizeSamples * sizeof(int16_t));
     }
 
+    // Insert the packets that have arrived.
+    while (!packets_in_flight.empty() &&
+           packets_in_flight.begin()->first <= time_now_ms) {
+      const auto& packet = packets_in_flight.begin()->second;
+      int error = neteq->InsertPacket(packet.first, packet.second);
+      if (error != NetEq::kOK)
+        return -1;
+      packets_in_flight.erase(packets_in_flight.begin());
+    }
+
     // Get output audio, but don't do anything with it.
     bool muted;
     int error = neteq->GetAudio(&out_frame, &muted);
@@ -24,6 +24,14 @@ class NetEqPerformanceTest {
   //   |drift_factor|: clock drift in [0, 1].
   // Returns the runtime in ms.
   static int64_t Run(int runtime_ms, int lossrate, double drift_factor);
+
+  // As above, but each packet is also delayed by a random time of up to
+  // |max_jitter_ms|, so that packets arrive late and out of order, and NetEq
+  // has to expand and accelerate more.
+  static int64_t Run(int runtime_ms,
+                     int lossrate,
+                     double drift_factor,
+                     int max_jitter_ms);
 };
 
 }  // namespace test
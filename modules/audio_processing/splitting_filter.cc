@@ -16,6 +16,7 @@
 #include "common_audio/channel_buffer.h"
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 #include "rtc_base/checks.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 namespace {
@@ -23,12 +24,43 @@ namespace {
 constexpr size_t kSamplesPerBand = 160;
 constexpr size_t kTwoBandFilterSamplesPerFrame = 320;
 
+// The all-pass filter coefficients of WebRtcSpl_AnalysisQMF() and
+// WebRtcSpl_SynthesisQMF(), which are in Q16.
+constexpr float kAllPassFilter1[3] = {6418 / 65536.f, 36982 / 65536.f,
+                                      57261 / 65536.f};
+constexpr float kAllPassFilter2[3] = {21333 / 65536.f, 49062 / 65536.f,
+                                      63010 / 65536.f};
+
+// Filters |data| in place with three cascaded first order all-pass filters,
+//   y[n] = x[n - 1] + a * (x[n] - y[n - 1]),
+// as WebRtcSpl_AllPassQMF() does. For each filter, |state| holds x[-1]
+// followed by y[-1].
+void AllPassQmf(const float (&coefficients)[3],
+                rtc::ArrayView<float, kSamplesPerBand> data,
+                float (&state)[TwoBandsStates::kStateSize]) {
+  for (size_t i = 0; i < 3; ++i) {
+    const float a = coefficients[i];
+    float x_prev = state[2 * i];
+    float y_prev = state[2 * i + 1];
+    for (float& x : data) {
+      const float y = x_prev + a * (x - y_prev);
+      x_prev = x;
+      y_prev = y;
+      x = y;
+    }
+    state[2 * i] = x_prev;
+    state[2 * i + 1] = y_prev;
+  }
+}
+
 }  // namespace
 
 SplittingFilter::SplittingFilter(size_t num_channels,
                                  size_t num_bands,
                                  size_t num_frames)
     : num_bands_(num_bands),
+      use_float_two_bands_(
+          field_trial::IsEnabled("WebRTC-FloatTwoBandSplittingFilter")),
       two_bands_states_(num_bands_ == 2 ? num_channels : 0),
       three_band_filter_banks_(num_bands_ == 3 ? num_channels : 0) {
   RTC_CHECK(num_bands_ == 2 || num_bands_ == 3);
@@ -43,7 +75,11 @@ void SplittingFilter::Analysis(const ChannelBuffer<float>* data,
   RTC_DCHECK_EQ(data->num_frames(),
                 bands->num_frames_per_band() * bands->num_bands());
   if (bands->num_bands() == 2) {
-    TwoBandsAnalysis(data, bands);
+    if (use_float_two_bands_) {
+      FloatTwoBandsAnalysis(data, bands);
+    } else {
+      TwoBandsAnalysis(data, bands);
+    }
   } else if (bands->num_bands() == 3) {
     ThreeBandsAnalysis(data, bands);
   }
@@ -56,7 +92,11 @@ void SplittingFilter::Synthesis(const ChannelBuffer<float>* bands,
   RTC_DCHECK_EQ(data->num_frames(),
                 bands->num_frames_per_band() * bands->num_bands());
   if (bands->num_bands() == 2) {
-    TwoBandsSynthesis(bands, data);
+    if (use_float_two_bands_) {
+      FloatTwoBandsSynthesis(bands, data);
+    } else {
+      TwoBandsSynthesis(bands, data);
+    }
   } else if (bands->num_bands() == 3) {
     ThreeBandsSynthesis(bands, data);
   }
@@ -97,6 +137,62 @@ void SplittingFilter::TwoBandsSynthesis(const ChannelBuffer<float>* bands,
   }
 }
 
+void SplittingFilter::FloatTwoBandsAnalysis(const ChannelBuffer<float>* data,
+                                            ChannelBuffer<float>* bands) {
+  RTC_DCHECK_EQ(two_bands_states_.size(), data->num_channels());
+  RTC_DCHECK_EQ(data->num_frames(), kTwoBandFilterSamplesPerFrame);
+
+  for (size_t i = 0; i < two_bands_states_.size(); ++i) {
+    const float* full_band = data->channels(0)[i];
+    std::array<float, kSamplesPerBand> even;
+    std::array<float, kSamplesPerBand> odd;
+    for (size_t k = 0; k < kSamplesPerBand; ++k) {
+      even[k] = full_band[2 * k];
+      odd[k] = full_band[2 * k + 1];
+    }
+
+    AllPassQmf(kAllPassFilter1, odd,
+               two_bands_states_[i].float_analysis_state1);
+    AllPassQmf(kAllPassFilter2, even,
+               two_bands_states_[i].float_analysis_state2);
+
+    float* low_band = bands->channels(0)[i];
+    float* high_band = bands->channels(1)[i];
+    for (size_t k = 0; k < kSamplesPerBand; ++k) {
+      low_band[k] = 0.5f * (odd[k] + even[k]);
+      high_band[k] = 0.5f * (odd[k] - even[k]);
+    }
+  }
+}
+
+void SplittingFilter::FloatTwoBandsSynthesis(const ChannelBuffer<float>* bands,
+                                             ChannelBuffer<float>* data) {
+  RTC_DCHECK_LE(data->num_channels(), two_bands_states_.size());
+  RTC_DCHECK_EQ(data->num_frames(), kTwoBandFilterSamplesPerFrame);
+
+  for (size_t i = 0; i < data->num_channels(); ++i) {
+    const float* low_band = bands->channels(0)[i];
+    const float* high_band = bands->channels(1)[i];
+    std::array<float, kSamplesPerBand> sum;
+    std::array<float, kSamplesPerBand> difference;
+    for (size_t k = 0; k < kSamplesPerBand; ++k) {
+      sum[k] = low_band[k] + high_band[k];
+      difference[k] = low_band[k] - high_band[k];
+    }
+
+    AllPassQmf(kAllPassFilter2, sum,
+               two_bands_states_[i].float_synthesis_state1);
+    AllPassQmf(kAllPassFilter1, difference,
+               two_bands_states_[i].float_synthesis_state2);
+
+    float* full_band = data->channels(0)[i];
+    for (size_t k = 0; k < kSamplesPerBand; ++k) {
+      full_band[2 * k] = difference[k];
+      full_band[2 * k + 1] = sum[k];
+    }
+  }
+}
+
 void SplittingFilter::ThreeBandsAnalysis(const ChannelBuffer<float>* data,
                                          ChannelBuffer<float>* bands) {
   RTC_DCHECK_EQ(three_band_filter_banks_.size(), data->num_channels());
@@ -26,6 +26,10 @@ struct TwoBandsStates {
     memset(analysis_state2, 0, sizeof(analysis_state2));
     memset(synthesis_state1, 0, sizeof(synthesis_state1));
     memset(synthesis_state2, 0, sizeof(synthesis_state2));
+    memset(float_analysis_state1, 0, sizeof(float_analysis_state1));
+    memset(float_analysis_state2, 0, sizeof(float_analysis_state2));
+    memset(float_synthesis_state1, 0, sizeof(float_synthesis_state1));
+    memset(float_synthesis_state2, 0, sizeof(float_synthesis_state2));
   }
 
   static const int kStateSize = 6;
@@ -33,6 +37,12 @@ struct TwoBandsStates {
   int analysis_state2[kStateSize];
   int synthesis_state1[kStateSize];
   int synthesis_state2[kStateSize];
+
+  // States of the floating point version of the filters.
+  float float_analysis_state1[kStateSize];
+  float float_analysis_state2[kStateSize];
+  float float_synthesis_state1[kStateSize];
+  float float_synthesis_state2[kStateSize];
 };
 
 // Splitting filter which is able to split into and merge from 2 or 3 frequency
@@ -42,6 +52,11 @@ struct TwoBandsStates {
 // to merge these bands again. The input and output signals are contained in
 // ChannelBuffers and for the different bands an array of ChannelBuffers is
 // used.
+//
+// The two bands are split with the fixed point QMF of the signal processing
+// library, unless the "WebRTC-FloatTwoBandSplittingFilter" field trial is
+// enabled, in which case the same filters are run in floating point. This
+// avoids converting the signal to int16 and back but is not bit-exact.
 class SplittingFilter {
  public:
   SplittingFilter(size_t num_channels, size_t num_bands, size_t num_frames);
@@ -56,6 +71,10 @@ class SplittingFilter {
                         ChannelBuffer<float>* bands);
   void TwoBandsSynthesis(const ChannelBuffer<float>* bands,
                          ChannelBuffer<float>* data);
+  void FloatTwoBandsAnalysis(const ChannelBuffer<float>* data,
+                             ChannelBuffer<float>* bands);
+  void FloatTwoBandsSynthesis(const ChannelBuffer<float>* bands,
+                              ChannelBuffer<float>* data);
   void ThreeBandsAnalysis(const ChannelBuffer<float>* data,
                           ChannelBuffer<float>* bands);
   void ThreeBandsSynthesis(const ChannelBuffer<float>* bands,
@@ -63,6 +82,7 @@ class SplittingFilter {
   void InitBuffers();
 
   const size_t num_bands_;
+  const bool use_float_two_bands_;
   std::vector<TwoBandsStates> two_bands_states_;
   std::vector<ThreeBandFilterBank> three_band_filter_banks_;
 };
@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <array>
+#include <string>
+
+#include "common_audio/channel_buffer.h"
+#include "modules/audio_processing/splitting_filter.h"
+#include "modules/audio_processing/three_band_filter_bank.h"
+#include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
+#include "test/field_trial.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumFrames = 10000;
+
+std::string OptimizationName(ThreeBandFilterBank::Optimization optimization) {
+  switch (optimization) {
+    case ThreeBandFilterBank::Optimization::kNone:
+      return "generic";
+    case ThreeBandFilterBank::Optimization::kSse2:
+      return "sse2";
+    case ThreeBandFilterBank::Optimization::kAvx2:
+      return "avx2";
+    case ThreeBandFilterBank::Optimization::kNeon:
+      return "neon";
+  }
+  return "";
+}
+
+// Returns the average time, in microseconds, of splitting a frame of
+// |num_bands| * 160 samples and merging it back.
+double TimeSplittingFilter(size_t num_bands) {
+  const size_t num_frames = num_bands * 160;
+  SplittingFilter splitting_filter(1, num_bands, num_frames);
+  ChannelBuffer<float> data(num_frames, 1, num_bands);
+  ChannelBuffer<float> bands(num_frames, 1, num_bands);
+  Random random(42);
+  for (size_t k = 0; k < num_frames; ++k) {
+    data.channels()[0][k] = random.Rand(-32768, 32767);
+  }
+
+  const int64_t start_time_nanos = rtc::TimeNanos();
+  for (int i = 0; i < kNumFrames; ++i) {
+    splitting_filter.Analysis(&data, &bands);
+    splitting_filter.Synthesis(&bands, &data);
+  }
+  return (rtc::TimeNanos() - start_time_nanos) /
+         static_cast<double>(rtc::kNumNanosecsPerMicrosec * kNumFrames);
+}
+
+}  // namespace
+
+TEST(SplittingFilterPerformanceTest, ThreeBands) {
+  using Optimization = ThreeBandFilterBank::Optimization;
+  for (Optimization optimization :
+       {Optimization::kNone, ThreeBandFilterBank::DetectOptimization()}) {
+    ThreeBandFilterBank filter_bank(optimization);
+    std::array<float, ThreeBandFilterBank::kFullBandSize> data;
+    std::array<std::array<float, ThreeBandFilterBank::kSplitBandSize>,
+               ThreeBandFilterBank::kNumBands>
+        bands;
+    std::array<rtc::ArrayView<float>, ThreeBandFilterBank::kNumBands>
+        band_views;
+    for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
+      band_views[band] = bands[band];
+    }
+    Random random(42);
+    for (float& x : data) {
+      x = random.Rand(-32768, 32767);
+    }
+
+    const int64_t start_time_nanos = rtc::TimeNanos();
+    for (int i = 0; i < kNumFrames; ++i) {
+      filter_bank.Analysis(data, band_views);
+      filter_bank.Synthesis(band_views, data);
+    }
+    const double duration_us =
+        (rtc::TimeNanos() - start_time_nanos) /
+        static_cast<double>(rtc::kNumNanosecsPerMicrosec * kNumFrames);
+    webrtc::test::PrintResult("splitting_filter_time", "_48kHz",
+                              OptimizationName(optimization), duration_us,
+                              "us", false);
+  }
+}
+
+TEST(SplittingFilterPerformanceTest, TwoBands) {
+  webrtc::test::PrintResult("splitting_filter_time", "_32kHz", "fixed_point",
+                            TimeSplittingFilter(2), "us", false);
+
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-FloatTwoBandSplittingFilter/Enabled/");
+  webrtc::test::PrintResult("splitting_filter_time", "_32kHz", "float",
+                            TimeSplittingFilter(2), "us", false);
+}
+
+}  // namespace webrtc
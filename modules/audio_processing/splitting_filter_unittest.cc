@@ -16,14 +16,33 @@
 #include <cmath>
 
 #include "common_audio/channel_buffer.h"
+#include "test/field_trial.h"
 #include "test/gtest.h"
 
 namespace webrtc {
 namespace {
 
 const size_t kSamplesPer16kHzChannel = 160;
+const size_t kSamplesPer32kHzChannel = 320;
 const size_t kSamplesPer48kHzChannel = 480;
 
+// Fills |data| with the sum of two sine waves, at |sample_rate_hz|, starting
+// at sample |offset|.
+void GenerateTwoTones(int sample_rate_hz,
+                      size_t offset,
+                      ChannelBuffer<float>* data) {
+  static const float kFrequenciesHz[] = {1000, 12000};
+  static const float kAmplitude = 8192.f;
+  for (size_t k = 0; k < data->num_frames(); ++k) {
+    data->channels()[0][k] = 0.f;
+    for (float frequency_hz : kFrequenciesHz) {
+      data->channels()[0][k] +=
+          kAmplitude *
+          sin(2.f * M_PI * frequency_hz * (offset + k) / sample_rate_hz);
+    }
+  }
+}
+
 }  // namespace
 
 // Generates a signal from presence or absence of sine waves of different
@@ -100,4 +119,47 @@ TEST(SplittingFilterTest, SplitsIntoThreeBandsAndReconstructs) {
   }
 }
 
+// Verifies that the floating point two band splitting filter, enabled by a
+// field trial, matches the fixed point one up to the int16 rounding of the
+// latter.
+TEST(SplittingFilterTest, FloatTwoBandsMatchFixedPoint) {
+  static const int kChannels = 1;
+  static const int kSampleRateHz = 32000;
+  static const size_t kNumBands = 2;
+  static const size_t kChunks = 20;
+  static const float kTolerance = 3.f;
+  SplittingFilter fixed_point_filter(kChannels, kNumBands,
+                                     kSamplesPer32kHzChannel);
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-FloatTwoBandSplittingFilter/Enabled/");
+  SplittingFilter float_filter(kChannels, kNumBands, kSamplesPer32kHzChannel);
+  ChannelBuffer<float> in_data(kSamplesPer32kHzChannel, kChannels, kNumBands);
+  ChannelBuffer<float> fixed_point_bands(kSamplesPer32kHzChannel, kChannels,
+                                         kNumBands);
+  ChannelBuffer<float> float_bands(kSamplesPer32kHzChannel, kChannels,
+                                   kNumBands);
+  ChannelBuffer<float> fixed_point_out(kSamplesPer32kHzChannel, kChannels,
+                                       kNumBands);
+  ChannelBuffer<float> float_out(kSamplesPer32kHzChannel, kChannels,
+                                 kNumBands);
+  for (size_t i = 0; i < kChunks; ++i) {
+    GenerateTwoTones(kSampleRateHz, i * kSamplesPer32kHzChannel, &in_data);
+    fixed_point_filter.Analysis(&in_data, &fixed_point_bands);
+    float_filter.Analysis(&in_data, &float_bands);
+    for (size_t j = 0; j < kNumBands; ++j) {
+      for (size_t k = 0; k < kSamplesPer16kHzChannel; ++k) {
+        EXPECT_NEAR(fixed_point_bands.channels(j)[0][k],
+                    float_bands.channels(j)[0][k], kTolerance);
+      }
+    }
+
+    fixed_point_filter.Synthesis(&fixed_point_bands, &fixed_point_out);
+    float_filter.Synthesis(&float_bands, &float_out);
+    for (size_t k = 0; k < kSamplesPer32kHzChannel; ++k) {
+      EXPECT_NEAR(fixed_point_out.channels()[0][k],
+                  float_out.channels()[0][k], kTolerance);
+    }
+  }
+}
+
 }  // namespace webrtc
@@ -25,6 +25,27 @@ void ApiCallStatistics::Add(int64_t duration_nanos, CallType call_type) {
   calls_.push_back(CallData(duration_nanos, call_type));
 }
 
+void ApiCallStatistics::Add(const ApiCallStatistics& other) {
+  calls_.insert(calls_.end(), other.calls_.begin(), other.calls_.end());
+}
+
+int64_t ApiCallStatistics::NumCalls(CallType call_type) const {
+  return std::count_if(calls_.begin(), calls_.end(),
+                       [call_type](const CallData& v) {
+                         return v.call_type == call_type;
+                       });
+}
+
+int64_t ApiCallStatistics::TotalDurationNanos(CallType call_type) const {
+  int64_t sum = 0;
+  for (auto v : calls_) {
+    if (v.call_type == call_type) {
+      sum += v.duration_nanos;
+    }
+  }
+  return sum;
+}
+
 void ApiCallStatistics::PrintReport() const {
   int64_t min_render = std::numeric_limits<int64_t>::max();
   int64_t min_capture = std::numeric_limits<int64_t>::max();
@@ -25,6 +25,13 @@ class ApiCallStatistics {
   // Adds a new datapoint.
   void Add(int64_t duration_nanos, CallType call_type);
 
+  // Adds the datapoints of |other|.
+  void Add(const ApiCallStatistics& other);
+
+  // Returns the number of calls of |call_type| and their total duration.
+  int64_t NumCalls(CallType call_type) const;
+  int64_t TotalDurationNanos(CallType call_type) const;
+
   // Prints out a report of the statistics.
   void PrintReport() const;
 
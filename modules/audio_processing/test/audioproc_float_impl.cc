@@ -12,6 +12,7 @@
 
 #include <string.h>
 
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -24,9 +25,11 @@
 #include "modules/audio_processing/include/audio_processing.h"
 #include "modules/audio_processing/test/aec_dump_based_simulator.h"
 #include "modules/audio_processing/test/audio_processing_simulator.h"
+#include "modules/audio_processing/test/batch_simulator.h"
 #include "modules/audio_processing/test/wav_based_simulator.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/strings/string_builder.h"
+#include "system_wrappers/include/cpu_info.h"
 #include "system_wrappers/include/field_trial.h"
 
 constexpr int kParameterNotSpecifiedValue = -10000;
@@ -257,6 +260,23 @@ ABSL_FLAG(bool,
           false,
           "Produce floating point wav output files.");
 
+ABSL_FLAG(std::string,
+          batch_manifest,
+          "",
+          "File listing the files of one simulation per line, e.g. "
+          "\"-i in.wav -o out.wav\". The simulations are run in parallel "
+          "with the other settings given on the command line");
+ABSL_FLAG(int,
+          batch_threads,
+          0,
+          "Number of threads to run the simulations of --batch_manifest on "
+          "(0 means one per core)");
+ABSL_FLAG(std::string,
+          batch_report_output_file,
+          "",
+          "Generate a CSV file with the statistics of each simulation of "
+          "--batch_manifest");
+
 ABSL_FLAG(std::string,
           force_fieldtrials,
           "",
@@ -272,6 +292,8 @@ const char kUsageDescription[] =
     "Usage: audioproc_f [options] -i <input.wav>\n"
     "                   or\n"
     "       audioproc_f [options] -dump_input <aec_dump>\n"
+    "                   or\n"
+    "       audioproc_f [options] -batch_manifest <manifest>\n"
     "\n\n"
     "Command-line tool to simulate a call using the audio "
     "processing module, either based on wav files or "
@@ -626,31 +648,28 @@ void PerformBasicParameterSanityChecks(const SimulationSettings& settings) {
       "specified and set.\n");
 }
 
-}  // namespace
+// Checks for settings that act on the whole process, or on shared state, and
+// hence cannot be used by simulations run in parallel.
+void PerformBatchParameterSanityChecks(const SimulationSettings& settings) {
+  ReportConditionalErrorAndExit(
+      settings.use_verbose_logging,
+      "Error: --verbose cannot be used in batch mode.\n");
 
-int AudioprocFloatImpl(std::unique_ptr<AudioProcessingBuilder> ap_builder,
-                       int argc,
-                       char* argv[],
-                       absl::string_view input_aecdump,
-                       std::vector<float>* processed_capture_samples) {
-  std::vector<char*> args = absl::ParseCommandLine(argc, argv);
-  if (args.size() != 1) {
-    printf("%s", kUsageDescription);
-    return 1;
-  }
+  ReportConditionalErrorAndExit(
+      settings.dump_internal_data,
+      "Error: --dump_data cannot be used in batch mode.\n");
 
-  // InitFieldTrialsFromString stores the char*, so the char array must
-  // outlive the application.
-  const std::string field_trials = absl::GetFlag(FLAGS_force_fieldtrials);
-  webrtc::field_trial::InitFieldTrialsFromString(field_trials.c_str());
+  ReportConditionalErrorAndExit(
+      settings.store_intermediate_output,
+      "Error: --store_intermediate_output cannot be used in batch mode.\n");
 
-  SimulationSettings settings = CreateSettings();
-  if (!input_aecdump.empty()) {
-    settings.aec_dump_input_string = input_aecdump;
-    settings.processed_capture_samples = processed_capture_samples;
-    RTC_CHECK(settings.processed_capture_samples);
-  }
-  PerformBasicParameterSanityChecks(settings);
+  ReportConditionalErrorAndExit(
+      settings.call_order_input_filename || settings.call_order_output_filename,
+      "Error: The call order files cannot be used in batch mode.\n");
+}
+
+int RunSimulation(const SimulationSettings& settings,
+                  std::unique_ptr<AudioProcessingBuilder> ap_builder) {
   std::unique_ptr<AudioProcessingSimulator> processor;
 
   if (settings.aec_dump_input_filename || settings.aec_dump_input_string) {
@@ -680,5 +699,101 @@ int AudioprocFloatImpl(std::unique_ptr<AudioProcessingBuilder> ap_builder,
   return 0;
 }
 
+int RunBatch(const SimulationSettings& batch_settings,
+             const std::function<std::unique_ptr<AudioProcessingBuilder>()>&
+                 ap_builder_factory) {
+  PerformBatchParameterSanityChecks(batch_settings);
+  const std::string manifest_filename = absl::GetFlag(FLAGS_batch_manifest);
+  std::ifstream manifest(manifest_filename);
+  ReportConditionalErrorAndExit(
+      !manifest.is_open(), "Error: Cannot open " + manifest_filename + "\n");
+  std::vector<BatchSimulator::Job> jobs;
+  std::string error;
+  ReportConditionalErrorAndExit(
+      !ReadBatchManifest(manifest, manifest_filename, batch_settings,
+                         ap_builder_factory, &jobs, &error),
+      "Error: " + error + "\n");
+  ReportConditionalErrorAndExit(jobs.empty(),
+                                "Error: The batch manifest is empty.\n");
+  for (const BatchSimulator::Job& job : jobs) {
+    PerformBasicParameterSanityChecks(job.settings);
+  }
+
+  int num_threads = absl::GetFlag(FLAGS_batch_threads);
+  ReportConditionalErrorAndExit(
+      num_threads < 0, "Error: --batch_threads cannot be negative.\n");
+  if (num_threads == 0) {
+    num_threads = CpuInfo::DetectNumberOfCores();
+  }
+
+  BatchSimulator batch_simulator(std::move(jobs), num_threads);
+  batch_simulator.Process();
+  batch_simulator.PrintReport();
+  const std::string report_filename =
+      absl::GetFlag(FLAGS_batch_report_output_file);
+  if (!report_filename.empty()) {
+    batch_simulator.WriteReportToFile(report_filename);
+  }
+  return 0;
+}
+
+// Parses the command line flags and sets up the field trials they ask for.
+// Returns false, after printing the usage, if there are positional arguments.
+bool ParseCommandLineAndInitFieldTrials(int argc, char* argv[]) {
+  std::vector<char*> args = absl::ParseCommandLine(argc, argv);
+  if (args.size() != 1) {
+    printf("%s", kUsageDescription);
+    return false;
+  }
+
+  // InitFieldTrialsFromString stores the char*, so the char array must
+  // outlive the application.
+  static std::string* const field_trials = new std::string();
+  *field_trials = absl::GetFlag(FLAGS_force_fieldtrials);
+  webrtc::field_trial::InitFieldTrialsFromString(field_trials->c_str());
+  return true;
+}
+
+}  // namespace
+
+int AudioprocFloatImpl(std::unique_ptr<AudioProcessingBuilder> ap_builder,
+                       int argc,
+                       char* argv[],
+                       absl::string_view input_aecdump,
+                       std::vector<float>* processed_capture_samples) {
+  if (!ParseCommandLineAndInitFieldTrials(argc, argv)) {
+    return 1;
+  }
+  ReportConditionalErrorAndExit(
+      !absl::GetFlag(FLAGS_batch_manifest).empty(),
+      "Error: --batch_manifest needs an AudioProcessingBuilder factory.\n");
+
+  SimulationSettings settings = CreateSettings();
+  if (!input_aecdump.empty()) {
+    settings.aec_dump_input_string = input_aecdump;
+    settings.processed_capture_samples = processed_capture_samples;
+    RTC_CHECK(settings.processed_capture_samples);
+  }
+  PerformBasicParameterSanityChecks(settings);
+  return RunSimulation(settings, std::move(ap_builder));
+}
+
+int AudioprocFloatImpl(
+    std::function<std::unique_ptr<AudioProcessingBuilder>()>
+        ap_builder_factory,
+    int argc,
+    char* argv[]) {
+  if (!ParseCommandLineAndInitFieldTrials(argc, argv)) {
+    return 1;
+  }
+
+  SimulationSettings settings = CreateSettings();
+  if (!absl::GetFlag(FLAGS_batch_manifest).empty()) {
+    return RunBatch(settings, ap_builder_factory);
+  }
+  PerformBasicParameterSanityChecks(settings);
+  return RunSimulation(settings, ap_builder_factory());
+}
+
 }  // namespace test
 }  // namespace webrtc
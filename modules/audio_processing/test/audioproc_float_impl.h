@@ -11,6 +11,7 @@
 #ifndef MODULES_AUDIO_PROCESSING_TEST_AUDIOPROC_FLOAT_IMPL_H_
 #define MODULES_AUDIO_PROCESSING_TEST_AUDIOPROC_FLOAT_IMPL_H_
 
+#include <functional>
 #include <memory>
 
 #include "modules/audio_processing/include/audio_processing.h"
@@ -30,6 +31,15 @@ int AudioprocFloatImpl(std::unique_ptr<AudioProcessingBuilder> ap_builder,
                        absl::string_view input_aecdump,
                        std::vector<float>* processed_capture_samples);
 
+// Like the function above, but creates the AudioProcessingBuilder instances
+// with |ap_builder_factory|, one per simulation. This also allows running a
+// batch of simulations in parallel via the --batch_manifest flag.
+int AudioprocFloatImpl(
+    std::function<std::unique_ptr<AudioProcessingBuilder>()>
+        ap_builder_factory,
+    int argc,
+    char* argv[]);
+
 }  // namespace test
 }  // namespace webrtc
 
@@ -0,0 +1,257 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/test/batch_simulator.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <utility>
+
+#include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
+#include "modules/audio_processing/test/aec_dump_based_simulator.h"
+#include "modules/audio_processing/test/wav_based_simulator.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+using CallType = ApiCallStatistics::CallType;
+
+int64_t AverageDurationMicros(const ApiCallStatistics& statistics,
+                              CallType call_type) {
+  const int64_t num_calls = statistics.NumCalls(call_type);
+  return num_calls > 0 ? statistics.TotalDurationNanos(call_type) /
+                             num_calls / rtc::kNumNanosecsPerMicrosec
+                       : 0;
+}
+
+double AudioDurationSeconds(int64_t num_capture_frames) {
+  return num_capture_frames * AudioProcessing::kChunkSizeMs * 1e-3;
+}
+
+// Sets the file of |settings| named by the manifest flag |name|. Returns false
+// if there is no such flag.
+bool SetBatchFilename(const std::string& name,
+                      const std::string& filename,
+                      SimulationSettings* settings) {
+  absl::optional<std::string>* setting = nullptr;
+  if (name == "i") {
+    setting = &settings->input_filename;
+  } else if (name == "o") {
+    setting = &settings->output_filename;
+  } else if (name == "ri") {
+    setting = &settings->reverse_input_filename;
+  } else if (name == "ro") {
+    setting = &settings->reverse_output_filename;
+  } else if (name == "dump_input") {
+    setting = &settings->aec_dump_input_filename;
+  } else if (name == "dump_output") {
+    setting = &settings->aec_dump_output_filename;
+  } else if (name == "linear_aec_output") {
+    setting = &settings->linear_aec_output_filename;
+  } else if (name == "ed_graph") {
+    setting = &settings->ed_graph_output_filename;
+  } else if (name == "performance_report_output_file") {
+    setting = &settings->performance_report_output_filename;
+  } else {
+    return false;
+  }
+  *setting = filename;
+  return true;
+}
+
+}  // namespace
+
+BatchSimulator::Job::Job(std::string name,
+                         const SimulationSettings& settings,
+                         std::unique_ptr<AudioProcessingBuilder> ap_builder)
+    : name(std::move(name)),
+      settings(settings),
+      ap_builder(std::move(ap_builder)) {}
+
+BatchSimulator::Job::Job(Job&&) = default;
+
+BatchSimulator::Job::~Job() = default;
+
+BatchSimulator::BatchSimulator(std::vector<Job> jobs, int num_threads)
+    : jobs_(std::move(jobs)),
+      results_(jobs_.size()),
+      num_threads_(std::max(
+          1, std::min(num_threads, static_cast<int>(jobs_.size())))) {}
+
+BatchSimulator::~BatchSimulator() = default;
+
+void BatchSimulator::Process() {
+  const int64_t start_time_nanos = rtc::TimeNanos();
+  std::vector<std::unique_ptr<rtc::PlatformThread>> workers;
+  for (int i = 0; i < num_threads_; ++i) {
+    workers.push_back(std::make_unique<rtc::PlatformThread>(
+        &BatchSimulator::RunWorker, this, "apm_batch_worker"));
+    workers.back()->Start();
+  }
+  for (auto& worker : workers) {
+    worker->Stop();
+  }
+  wall_time_nanos_ = rtc::TimeNanos() - start_time_nanos;
+}
+
+void BatchSimulator::RunWorker(void* obj) {
+  static_cast<BatchSimulator*>(obj)->ProcessJobs();
+}
+
+void BatchSimulator::ProcessJobs() {
+  // Each job, and its result, is only touched by the worker that takes it.
+  for (size_t i = next_job_++; i < jobs_.size(); i = next_job_++) {
+    Job& job = jobs_[i];
+    const int64_t start_time_nanos = rtc::TimeNanos();
+    std::unique_ptr<AudioProcessingSimulator> simulator;
+    if (job.settings.aec_dump_input_filename) {
+      simulator.reset(
+          new AecDumpBasedSimulator(job.settings, std::move(job.ap_builder)));
+    } else {
+      simulator.reset(
+          new WavBasedSimulator(job.settings, std::move(job.ap_builder)));
+    }
+    simulator->Process();
+
+    Result& result = results_[i];
+    result.api_call_statistics = simulator->GetApiCallStatistics();
+    result.num_capture_frames = simulator->get_num_process_stream_calls();
+    result.bitexact = simulator->OutputWasBitexact();
+    simulator.reset();
+    result.wall_time_nanos = rtc::TimeNanos() - start_time_nanos;
+  }
+}
+
+void BatchSimulator::PrintReport() const {
+  ApiCallStatistics all_api_call_statistics;
+  int64_t num_capture_frames = 0;
+  for (size_t i = 0; i < jobs_.size(); ++i) {
+    const SimulationSettings& settings = jobs_[i].settings;
+    const Result& result = results_[i];
+    all_api_call_statistics.Add(result.api_call_statistics);
+    num_capture_frames += result.num_capture_frames;
+
+    std::cout << jobs_[i].name << ": "
+              << AudioDurationSeconds(result.num_capture_frames)
+              << " s of audio in " << result.wall_time_nanos * 1e-9 << " s"
+              << ", capture avg: "
+              << AverageDurationMicros(result.api_call_statistics,
+                                       CallType::kCapture)
+              << " us, render avg: "
+              << AverageDurationMicros(result.api_call_statistics,
+                                       CallType::kRender)
+              << " us" << std::endl;
+    if (settings.report_performance) {
+      result.api_call_statistics.PrintReport();
+    }
+    if (settings.performance_report_output_filename) {
+      result.api_call_statistics.WriteReportToFile(
+          *settings.performance_report_output_filename);
+    }
+    if (settings.report_bitexactness) {
+      std::cout << (result.bitexact ? " The processing was bitexact."
+                                    : " The processing was not bitexact.")
+                << std::endl;
+    }
+  }
+
+  const double audio_duration_s = AudioDurationSeconds(num_capture_frames);
+  const double wall_time_s = wall_time_nanos_ * 1e-9;
+  std::cout << std::endl
+            << jobs_.size() << " simulations on " << num_threads_
+            << " threads: " << audio_duration_s << " s of audio in "
+            << wall_time_s << " s ("
+            << (wall_time_s > 0 ? audio_duration_s / wall_time_s : 0)
+            << " times real time)" << std::endl;
+  all_api_call_statistics.PrintReport();
+}
+
+void BatchSimulator::WriteReportToFile(const std::string& filename) const {
+  std::ofstream out(filename);
+  out << "name, audio_s, wall_time_s, capture_calls, capture_avg_us, "
+         "render_calls, render_avg_us"
+      << std::endl;
+  for (size_t i = 0; i < jobs_.size(); ++i) {
+    const Result& result = results_[i];
+    const ApiCallStatistics& statistics = result.api_call_statistics;
+    out << jobs_[i].name << ", "
+        << AudioDurationSeconds(result.num_capture_frames) << ", "
+        << result.wall_time_nanos * 1e-9 << ", "
+        << statistics.NumCalls(CallType::kCapture) << ", "
+        << AverageDurationMicros(statistics, CallType::kCapture) << ", "
+        << statistics.NumCalls(CallType::kRender) << ", "
+        << AverageDurationMicros(statistics, CallType::kRender) << std::endl;
+  }
+}
+
+bool ReadBatchManifest(
+    std::istream& manifest,
+    const std::string& manifest_name,
+    const SimulationSettings& batch_settings,
+    const std::function<std::unique_ptr<AudioProcessingBuilder>()>&
+        ap_builder_factory,
+    std::vector<BatchSimulator::Job>* jobs,
+    std::string* error) {
+  std::set<std::string> output_filenames;
+  std::string line;
+  for (int line_number = 1; std::getline(manifest, line); ++line_number) {
+    std::vector<std::string> tokens =
+        absl::StrSplit(line, absl::ByAnyChar(" \t\r"), absl::SkipEmpty());
+    if (tokens.empty() || tokens[0][0] == '#') {
+      continue;
+    }
+    const std::string line_name =
+        manifest_name + ":" + std::to_string(line_number);
+    if (tokens.size() % 2 != 0) {
+      *error = "Flag without a filename on line " + line_name;
+      return false;
+    }
+
+    SimulationSettings settings = batch_settings;
+    settings.input_filename = absl::nullopt;
+    settings.output_filename = absl::nullopt;
+    settings.reverse_input_filename = absl::nullopt;
+    settings.reverse_output_filename = absl::nullopt;
+    settings.aec_dump_input_filename = absl::nullopt;
+    for (size_t k = 0; k < tokens.size(); k += 2) {
+      const std::string name = std::string(absl::StripPrefix(
+          absl::StripPrefix(tokens[k], "-"), "-"));
+      if (tokens[k][0] != '-' ||
+          !SetBatchFilename(name, tokens[k + 1], &settings)) {
+        *error = "Unknown flag " + tokens[k] + " on line " + line_name;
+        return false;
+      }
+    }
+
+    for (const absl::optional<std::string>* filename :
+         {&settings.output_filename, &settings.reverse_output_filename,
+          &settings.linear_aec_output_filename,
+          &settings.ed_graph_output_filename,
+          &settings.aec_dump_output_filename,
+          &settings.performance_report_output_filename}) {
+      if (*filename && !output_filenames.insert(**filename).second) {
+        *error = **filename + " is written by several simulations";
+        return false;
+      }
+    }
+    jobs->emplace_back(line_name, settings, ap_builder_factory());
+  }
+  return true;
+}
+
+}  // namespace test
+}  // namespace webrtc
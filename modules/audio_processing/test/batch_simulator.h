@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_TEST_BATCH_SIMULATOR_H_
+#define MODULES_AUDIO_PROCESSING_TEST_BATCH_SIMULATOR_H_
+
+#include <atomic>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modules/audio_processing/include/audio_processing.h"
+#include "modules/audio_processing/test/api_call_statistics.h"
+#include "modules/audio_processing/test/audio_processing_simulator.h"
+#include "rtc_base/constructor_magic.h"
+
+namespace webrtc {
+namespace test {
+
+// Runs independent audio processing simulations on a pool of threads, each
+// with its own AudioProcessing instance, and aggregates their statistics.
+class BatchSimulator {
+ public:
+  struct Job {
+    Job(std::string name,
+        const SimulationSettings& settings,
+        std::unique_ptr<AudioProcessingBuilder> ap_builder);
+    Job(Job&&);
+    ~Job();
+    std::string name;
+    SimulationSettings settings;
+    std::unique_ptr<AudioProcessingBuilder> ap_builder;
+  };
+
+  BatchSimulator(std::vector<Job> jobs, int num_threads);
+  ~BatchSimulator();
+
+  // Runs all the simulations and returns when they are done.
+  void Process();
+
+  // Prints, or writes to their files, the reports asked for by the
+  // simulations, in the order of the jobs. Then prints the statistics of the
+  // batch.
+  void PrintReport() const;
+
+  // Writes the statistics of each simulation to a CSV file.
+  void WriteReportToFile(const std::string& filename) const;
+
+ private:
+  struct Result {
+    int64_t wall_time_nanos = 0;
+    int64_t num_capture_frames = 0;
+    bool bitexact = true;
+    ApiCallStatistics api_call_statistics;
+  };
+
+  static void RunWorker(void* obj);
+  void ProcessJobs();
+
+  std::vector<Job> jobs_;
+  std::vector<Result> results_;
+  const int num_threads_;
+  std::atomic<size_t> next_job_{0};
+  int64_t wall_time_nanos_ = 0;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(BatchSimulator);
+};
+
+// Reads the simulations to run from |manifest|. Each line holds the files of
+// one simulation, as pairs of a flag and a filename separated by whitespace,
+// e.g. "-i in.wav -o out.wav". The other settings are taken from
+// |batch_settings|, and each simulation gets a builder from
+// |ap_builder_factory|. Empty lines and lines starting with '#' are skipped.
+// Returns false, with the reason in |error|, for an unknown flag, a flag
+// without a filename, or an output file written by several simulations.
+// |manifest_name| identifies the lines in the job names and errors.
+bool ReadBatchManifest(
+    std::istream& manifest,
+    const std::string& manifest_name,
+    const SimulationSettings& batch_settings,
+    const std::function<std::unique_ptr<AudioProcessingBuilder>()>&
+        ap_builder_factory,
+    std::vector<BatchSimulator::Job>* jobs,
+    std::string* error);
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_TEST_BATCH_SIMULATOR_H_
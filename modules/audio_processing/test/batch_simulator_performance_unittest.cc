@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common_audio/wav_file.h"
+#include "modules/audio_processing/test/batch_simulator.h"
+#include "rtc_base/random.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr int kSampleRateHz = 48000;
+constexpr int kDurationS = 5;
+constexpr int kNumJobs = 8;
+constexpr int kThreadCounts[] = {1, 2, 4, 8};
+
+std::string CreateNoiseFile(const std::string& name, Random* random) {
+  const std::string filename = TempFilename(OutputPath(), name);
+  WavWriter writer(filename, kSampleRateHz, 1);
+  std::vector<int16_t> samples(kSampleRateHz * kDurationS);
+  for (int16_t& sample : samples) {
+    sample = random->Rand(-8000, 8000);
+  }
+  writer.WriteSamples(samples.data(), samples.size());
+  return filename;
+}
+
+}  // namespace
+
+// Runs |kNumJobs| simulations with echo cancellation and noise suppression on
+// 1 to 8 threads, and prints how many times faster than real time the batch
+// is processed.
+TEST(BatchSimulatorPerformanceTest, Throughput) {
+  Random random(42);
+  const std::string capture_input = CreateNoiseFile("batch_capture", &random);
+  const std::string render_input = CreateNoiseFile("batch_render", &random);
+
+  for (int num_threads : kThreadCounts) {
+    std::vector<std::string> output_filenames;
+    std::vector<BatchSimulator::Job> jobs;
+    for (int i = 0; i < kNumJobs; ++i) {
+      SimulationSettings settings;
+      settings.input_filename = capture_input;
+      settings.reverse_input_filename = render_input;
+      output_filenames.push_back(TempFilename(OutputPath(), "batch_out"));
+      settings.output_filename = output_filenames.back();
+      settings.initial_mic_level = 100;
+      settings.use_aec = true;
+      settings.use_ns = true;
+      settings.use_quiet_output = true;
+      jobs.emplace_back("job" + std::to_string(i), settings,
+                        std::make_unique<AudioProcessingBuilder>());
+    }
+
+    BatchSimulator batch_simulator(std::move(jobs), num_threads);
+    const int64_t start_time_nanos = rtc::TimeNanos();
+    batch_simulator.Process();
+    const double wall_time_s =
+        static_cast<double>(rtc::TimeNanos() - start_time_nanos) /
+        rtc::kNumNanosecsPerSec;
+
+    rtc::StringBuilder story;
+    story << num_threads << "_threads";
+    webrtc::test::PrintResult("apm_batch", "_throughput", story.str(),
+                              kNumJobs * kDurationS / wall_time_s,
+                              "x_real_time", false);
+    for (const std::string& filename : output_filenames) {
+      RemoveFile(filename);
+    }
+  }
+
+  RemoveFile(capture_input);
+  RemoveFile(render_input);
+}
+
+}  // namespace test
+}  // namespace webrtc
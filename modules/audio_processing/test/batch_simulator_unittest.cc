@@ -0,0 +1,170 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/test/batch_simulator.h"
+
+#include <math.h>
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common_audio/wav_file.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr int kSampleRateHz = 16000;
+
+// Counts the builders it creates.
+class BuilderFactory {
+ public:
+  std::unique_ptr<AudioProcessingBuilder> operator()() {
+    ++num_builders_;
+    return std::make_unique<AudioProcessingBuilder>();
+  }
+  int num_builders() const { return num_builders_; }
+
+ private:
+  int num_builders_ = 0;
+};
+
+bool ReadManifest(const std::string& manifest,
+                  std::vector<BatchSimulator::Job>* jobs,
+                  std::string* error) {
+  std::istringstream stream(manifest);
+  return ReadBatchManifest(
+      stream, "manifest", SimulationSettings(),
+      [] { return std::make_unique<AudioProcessingBuilder>(); }, jobs, error);
+}
+
+// Writes |duration_s| of a mono tone to a temporary file and returns its name.
+std::string CreateInputFile(const std::string& name, int duration_s) {
+  const std::string filename = TempFilename(OutputPath(), name);
+  WavWriter writer(filename, kSampleRateHz, 1);
+  std::vector<int16_t> samples(kSampleRateHz * duration_s);
+  for (size_t i = 0; i < samples.size(); ++i) {
+    samples[i] =
+        static_cast<int16_t>(8000 * sin(2 * M_PI * 440 * i / kSampleRateHz));
+  }
+  writer.WriteSamples(samples.data(), samples.size());
+  return filename;
+}
+
+}  // namespace
+
+TEST(ReadBatchManifestTest, ReadsTheFilesOfEachLine) {
+  SimulationSettings batch_settings;
+  batch_settings.input_filename = "ignored.wav";
+  batch_settings.use_ns = true;
+  BuilderFactory factory;
+  std::istringstream manifest(
+      "# Comment\n"
+      "-i a.wav -o a_out.wav\n"
+      "\n"
+      "\t--i b.wav  --ri b_render.wav -o b_out.wav\r\n");
+  std::vector<BatchSimulator::Job> jobs;
+  std::string error;
+  ASSERT_TRUE(ReadBatchManifest(manifest, "manifest", batch_settings,
+                                std::ref(factory), &jobs, &error));
+
+  ASSERT_EQ(jobs.size(), 2u);
+  EXPECT_EQ(factory.num_builders(), 2);
+  EXPECT_EQ(jobs[0].name, "manifest:2");
+  EXPECT_EQ(jobs[0].settings.input_filename, "a.wav");
+  EXPECT_EQ(jobs[0].settings.output_filename, "a_out.wav");
+  EXPECT_FALSE(jobs[0].settings.reverse_input_filename);
+  EXPECT_EQ(jobs[0].settings.use_ns, true);
+  EXPECT_TRUE(jobs[0].ap_builder);
+  EXPECT_EQ(jobs[1].name, "manifest:4");
+  EXPECT_EQ(jobs[1].settings.input_filename, "b.wav");
+  EXPECT_EQ(jobs[1].settings.reverse_input_filename, "b_render.wav");
+  EXPECT_EQ(jobs[1].settings.output_filename, "b_out.wav");
+}
+
+TEST(ReadBatchManifestTest, RejectsFlagWithoutFilename) {
+  std::vector<BatchSimulator::Job> jobs;
+  std::string error;
+  EXPECT_FALSE(ReadManifest("-i a.wav\n-i b.wav -o\n", &jobs, &error));
+  EXPECT_EQ(error, "Flag without a filename on line manifest:2");
+}
+
+TEST(ReadBatchManifestTest, RejectsUnknownFlags) {
+  std::vector<BatchSimulator::Job> jobs;
+  std::string error;
+  EXPECT_FALSE(ReadManifest("-i a.wav -agc 1\n", &jobs, &error));
+  EXPECT_EQ(error, "Unknown flag -agc on line manifest:1");
+  EXPECT_FALSE(ReadManifest("i a.wav\n", &jobs, &error));
+  EXPECT_EQ(error, "Unknown flag i on line manifest:1");
+}
+
+TEST(ReadBatchManifestTest, RejectsOutputFileOfSeveralSimulations) {
+  std::vector<BatchSimulator::Job> jobs;
+  std::string error;
+  EXPECT_FALSE(ReadManifest("-i a.wav -o out.wav\n-i b.wav -ro out.wav\n",
+                            &jobs, &error));
+  EXPECT_EQ(error, "out.wav is written by several simulations");
+}
+
+TEST(BatchSimulatorTest, RunsEachSimulation) {
+  const std::string first_input = CreateInputFile("batch_first", 1);
+  const std::string second_input = CreateInputFile("batch_second", 2);
+  const std::string first_output = TempFilename(OutputPath(), "batch_out");
+  const std::string second_output = TempFilename(OutputPath(), "batch_out");
+  const std::string report = TempFilename(OutputPath(), "batch_report");
+
+  SimulationSettings settings;
+  settings.initial_mic_level = 100;
+  settings.use_ns = true;
+  settings.use_quiet_output = true;
+  std::vector<BatchSimulator::Job> jobs;
+  std::string error;
+  ASSERT_TRUE(ReadManifest("-i " + first_input + " -o " + first_output +
+                               "\n-i " + second_input + " -o " +
+                               second_output + "\n",
+                           &jobs, &error));
+  for (BatchSimulator::Job& job : jobs) {
+    job.settings.initial_mic_level = settings.initial_mic_level;
+    job.settings.use_ns = settings.use_ns;
+    job.settings.use_quiet_output = settings.use_quiet_output;
+  }
+  BatchSimulator batch_simulator(std::move(jobs), /*num_threads=*/2);
+  batch_simulator.Process();
+  batch_simulator.WriteReportToFile(report);
+
+  EXPECT_EQ(WavReader(first_output).num_samples(),
+            static_cast<size_t>(kSampleRateHz));
+  EXPECT_EQ(WavReader(second_output).num_samples(),
+            static_cast<size_t>(2 * kSampleRateHz));
+
+  // A header and a line per simulation, in the order of the manifest.
+  std::ifstream report_file(report);
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(report_file, line);) {
+    lines.push_back(line);
+  }
+  ASSERT_EQ(lines.size(), 3u);
+  EXPECT_EQ(lines[1].find("manifest:1, 1, "), 0u);
+  EXPECT_EQ(lines[2].find("manifest:2, 2, "), 0u);
+
+  for (const std::string& filename :
+       {first_input, second_input, first_output, second_output, report}) {
+    RemoveFile(filename);
+  }
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -32,9 +32,22 @@
 
 #include "modules/audio_processing/three_band_filter_bank.h"
 
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
 #include <array>
 
+#include "modules/audio_processing/three_band_filter_bank_avx2.h"
 #include "rtc_base/checks.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 
 namespace webrtc {
 namespace {
@@ -100,6 +113,93 @@ const float kDctModulation[ThreeBandFilterBank::kNumNonZeroFilters][kDctSize] =
      {1.f, -2.f, 1.f},
      {1.73205077f, 0.f, -1.73205077f}};
 
+using Optimization = ThreeBandFilterBank::Optimization;
+
+// Computes out[k] as the sum over the taps i of in[k - i * kStride] *
+// filter[i]. |in| must be preceded by kMemorySize readable samples.
+void SparseFilter(
+    rtc::ArrayView<const float, kFilterSize> filter,
+    const float* in,
+    rtc::ArrayView<float, ThreeBandFilterBank::kSplitBandSize> out,
+    Optimization optimization) {
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Optimization::kAvx2:
+      SparseFilterAvx2(filter, kStride, in, out);
+      break;
+    case Optimization::kSse2:
+      for (int k = 0; k < ThreeBandFilterBank::kSplitBandSize; k += 4) {
+        __m128 sum = _mm_setzero_ps();
+        for (int i = 0; i < kFilterSize; ++i) {
+          const __m128 x = _mm_loadu_ps(&in[k - i * kStride]);
+          sum = _mm_add_ps(sum, _mm_mul_ps(x, _mm_set1_ps(filter[i])));
+        }
+        _mm_storeu_ps(&out[k], sum);
+      }
+      break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Optimization::kNeon:
+      for (int k = 0; k < ThreeBandFilterBank::kSplitBandSize; k += 4) {
+        float32x4_t sum = vdupq_n_f32(0.f);
+        for (int i = 0; i < kFilterSize; ++i) {
+          const float32x4_t x = vld1q_f32(&in[k - i * kStride]);
+          sum = vaddq_f32(sum, vmulq_n_f32(x, filter[i]));
+        }
+        vst1q_f32(&out[k], sum);
+      }
+      break;
+#endif
+    default:
+      for (int k = 0; k < ThreeBandFilterBank::kSplitBandSize; ++k) {
+        float sum = 0.f;
+        for (int i = 0; i < kFilterSize; ++i) {
+          sum += in[k - i * kStride] * filter[i];
+        }
+        out[k] = sum;
+      }
+  }
+}
+static_assert(ThreeBandFilterBank::kSplitBandSize % 4 == 0,
+              "The vectorized filters do not handle partial vectors");
+
+// Computes out[k] += scale * in[k].
+void ScaleAndAccumulate(
+    float scale,
+    rtc::ArrayView<const float, ThreeBandFilterBank::kSplitBandSize> in,
+    rtc::ArrayView<float> out,
+    Optimization optimization) {
+  RTC_DCHECK_EQ(out.size(), ThreeBandFilterBank::kSplitBandSize);
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Optimization::kAvx2:
+      ScaleAndAccumulateAvx2(scale, in, out);
+      break;
+    case Optimization::kSse2: {
+      const __m128 scale_128 = _mm_set1_ps(scale);
+      for (int k = 0; k < ThreeBandFilterBank::kSplitBandSize; k += 4) {
+        const __m128 x = _mm_loadu_ps(&in[k]);
+        const __m128 y = _mm_loadu_ps(&out[k]);
+        _mm_storeu_ps(&out[k], _mm_add_ps(y, _mm_mul_ps(scale_128, x)));
+      }
+    } break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Optimization::kNeon:
+      for (int k = 0; k < ThreeBandFilterBank::kSplitBandSize; k += 4) {
+        const float32x4_t x = vld1q_f32(&in[k]);
+        const float32x4_t y = vld1q_f32(&out[k]);
+        vst1q_f32(&out[k], vaddq_f32(y, vmulq_n_f32(x, scale)));
+      }
+      break;
+#endif
+    default:
+      for (int k = 0; k < ThreeBandFilterBank::kSplitBandSize; ++k) {
+        out[k] += scale * in[k];
+      }
+  }
+}
+
 // Filters the input signal |in| with the filter |filter| using a shift by
 // |in_shift|, taking into account the previous state.
 void FilterCore(
@@ -107,37 +207,20 @@ void FilterCore(
     rtc::ArrayView<const float, ThreeBandFilterBank::kSplitBandSize> in,
     const int in_shift,
     rtc::ArrayView<float, ThreeBandFilterBank::kSplitBandSize> out,
-    rtc::ArrayView<float, kMemorySize> state) {
+    rtc::ArrayView<float, kMemorySize> state,
+    Optimization optimization) {
   constexpr int kMaxInShift = (kStride - 1);
   RTC_DCHECK_GE(in_shift, 0);
   RTC_DCHECK_LE(in_shift, kMaxInShift);
-  std::fill(out.begin(), out.end(), 0.f);
-
-  for (int k = 0; k < in_shift; ++k) {
-    for (int i = 0, j = kMemorySize + k - in_shift; i < kFilterSize;
-         ++i, j -= kStride) {
-      out[k] += state[j] * filter[i];
-    }
-  }
-
-  for (int k = in_shift, shift = 0; k < kFilterSize * kStride; ++k, ++shift) {
-    RTC_DCHECK_GE(shift, 0);
-    const int loop_limit = std::min(kFilterSize, 1 + (shift >> kStrideLog2));
-    for (int i = 0, j = shift; i < loop_limit; ++i, j -= kStride) {
-      out[k] += in[j] * filter[i];
-    }
-    for (int i = loop_limit, j = kMemorySize + shift - loop_limit * kStride;
-         i < kFilterSize; ++i, j -= kStride) {
-      out[k] += state[j] * filter[i];
-    }
-  }
 
-  for (int k = kFilterSize * kStride, shift = kFilterSize * kStride - in_shift;
-       k < ThreeBandFilterBank::kSplitBandSize; ++k, ++shift) {
-    for (int i = 0, j = shift; i < kFilterSize; ++i, j -= kStride) {
-      out[k] += in[j] * filter[i];
-    }
-  }
+  // Place the state before the input, so that the filter reads both from a
+  // contiguous signal.
+  std::array<float, kMemorySize + ThreeBandFilterBank::kSplitBandSize>
+      extended_in;
+  std::copy(state.begin(), state.end(), extended_in.begin());
+  std::copy(in.begin(), in.end(), extended_in.begin() + kMemorySize);
+  SparseFilter(filter, &extended_in[kMemorySize - in_shift], out,
+               optimization);
 
   // Update current state.
   std::copy(in.begin() + ThreeBandFilterBank::kSplitBandSize - kMemorySize,
@@ -149,7 +232,11 @@ void FilterCore(
 // Because the low-pass filter prototype has half bandwidth it is possible to
 // use a DCT to shift it in both directions at the same time, to the center
 // frequencies [1 / 12, 3 / 12, 5 / 12].
-ThreeBandFilterBank::ThreeBandFilterBank() {
+ThreeBandFilterBank::ThreeBandFilterBank()
+    : ThreeBandFilterBank(DetectOptimization()) {}
+
+ThreeBandFilterBank::ThreeBandFilterBank(Optimization optimization)
+    : optimization_(optimization) {
   RTC_DCHECK_EQ(state_analysis_.size(), kNumNonZeroFilters);
   RTC_DCHECK_EQ(state_synthesis_.size(), kNumNonZeroFilters);
   for (int k = 0; k < kNumNonZeroFilters; ++k) {
@@ -163,6 +250,22 @@ ThreeBandFilterBank::ThreeBandFilterBank() {
 
 ThreeBandFilterBank::~ThreeBandFilterBank() = default;
 
+ThreeBandFilterBank::Optimization ThreeBandFilterBank::DetectOptimization() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kAVX2) != 0) {
+    return Optimization::kAvx2;
+  }
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    return Optimization::kSse2;
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  return Optimization::kNeon;
+#else
+  return Optimization::kNone;
+#endif
+}
+
 // The analysis can be separated in these steps:
 //   1. Serial to parallel downsampling by a factor of |kNumBands|.
 //   2. Filtering of |kSparsity| different delayed signals with polyphase
@@ -207,13 +310,13 @@ void ThreeBandFilterBank::Analysis(
 
       // Filter.
       std::array<float, kSplitBandSize> out_subsampled;
-      FilterCore(filter, in_subsampled, in_shift, out_subsampled, state);
+      FilterCore(filter, in_subsampled, in_shift, out_subsampled, state,
+                 optimization_);
 
       // Band and modulate the output.
       for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
-        for (int n = 0; n < kSplitBandSize; ++n) {
-          out[band][n] += dct_modulation[band] * out_subsampled[n];
-        }
+        ScaleAndAccumulate(dct_modulation[band], out_subsampled, out[band],
+                           optimization_);
       }
     }
   }
@@ -254,14 +357,17 @@ void ThreeBandFilterBank::Synthesis(
       std::fill(in_subsampled.begin(), in_subsampled.end(), 0.f);
       for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
         RTC_DCHECK_EQ(in[band].size(), kSplitBandSize);
-        for (int n = 0; n < kSplitBandSize; ++n) {
-          in_subsampled[n] += dct_modulation[band] * in[band][n];
-        }
+        ScaleAndAccumulate(
+            dct_modulation[band],
+            rtc::ArrayView<const float, kSplitBandSize>(in[band].data(),
+                                                        kSplitBandSize),
+            in_subsampled, optimization_);
       }
 
       // Filter.
       std::array<float, kSplitBandSize> out_subsampled;
-      FilterCore(filter, in_subsampled, in_shift, out_subsampled, state);
+      FilterCore(filter, in_subsampled, in_shift, out_subsampled, state,
+                 optimization_);
 
       // Upsample.
       constexpr float kUpsamplingScaling = kSubSampling;
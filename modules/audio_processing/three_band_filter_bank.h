@@ -52,9 +52,18 @@ class ThreeBandFilterBank final {
   static const int kNumNonZeroFilters =
       kSparsity * ThreeBandFilterBank::kNumBands - kNumZeroFilters;
 
+  // Implementations of the filtering and modulation kernels. All of them
+  // perform the same floating point operations, in the same order.
+  enum class Optimization { kNone, kSse2, kAvx2, kNeon };
+
   ThreeBandFilterBank();
+  // Uses |optimization| instead of the best one supported by the CPU.
+  explicit ThreeBandFilterBank(Optimization optimization);
   ~ThreeBandFilterBank();
 
+  // Returns the best optimization supported by the CPU.
+  static Optimization DetectOptimization();
+
   // Splits |in| of size kFullBandSize into 3 downsampled frequency bands in
   // |out|, each of size 160.
   void Analysis(rtc::ArrayView<const float, kFullBandSize> in,
@@ -66,6 +75,7 @@ class ThreeBandFilterBank final {
                  rtc::ArrayView<float, kFullBandSize> out);
 
  private:
+  const Optimization optimization_;
   std::array<std::array<float, kMemorySize>, kNumNonZeroFilters>
       state_analysis_;
   std::array<std::array<float, kMemorySize>, kNumNonZeroFilters>
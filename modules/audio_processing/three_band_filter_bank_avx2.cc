@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/three_band_filter_bank_avx2.h"
+
+#include <immintrin.h>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+// The products and sums are not fused, so that the outputs are bit-exact with
+// the generic version.
+void SparseFilterAvx2(rtc::ArrayView<const float> filter,
+                      int stride,
+                      const float* in,
+                      rtc::ArrayView<float> out) {
+  const int out_size = static_cast<int>(out.size());
+  const int vector_limit = out_size >> 3;
+  int k = 0;
+  for (; k < vector_limit * 8; k += 8) {
+    __m256 sum = _mm256_setzero_ps();
+    for (size_t i = 0; i < filter.size(); ++i) {
+      const __m256 x = _mm256_loadu_ps(&in[k - static_cast<int>(i) * stride]);
+      sum = _mm256_add_ps(sum, _mm256_mul_ps(x, _mm256_set1_ps(filter[i])));
+    }
+    _mm256_storeu_ps(&out[k], sum);
+  }
+
+  for (; k < out_size; ++k) {
+    float sum = 0.f;
+    for (size_t i = 0; i < filter.size(); ++i) {
+      sum += in[k - static_cast<int>(i) * stride] * filter[i];
+    }
+    out[k] = sum;
+  }
+}
+
+void ScaleAndAccumulateAvx2(float scale,
+                            rtc::ArrayView<const float> in,
+                            rtc::ArrayView<float> out) {
+  RTC_DCHECK_EQ(in.size(), out.size());
+  const int size = static_cast<int>(out.size());
+  const int vector_limit = size >> 3;
+  const __m256 scale_256 = _mm256_set1_ps(scale);
+  int k = 0;
+  for (; k < vector_limit * 8; k += 8) {
+    const __m256 x = _mm256_loadu_ps(&in[k]);
+    const __m256 y = _mm256_loadu_ps(&out[k]);
+    _mm256_storeu_ps(&out[k], _mm256_add_ps(y, _mm256_mul_ps(scale_256, x)));
+  }
+
+  for (; k < size; ++k) {
+    out[k] += scale * in[k];
+  }
+}
+
+}  // namespace webrtc
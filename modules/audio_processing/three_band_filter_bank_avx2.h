@@ -0,0 +1,35 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_THREE_BAND_FILTER_BANK_AVX2_H_
+#define MODULES_AUDIO_PROCESSING_THREE_BAND_FILTER_BANK_AVX2_H_
+
+#include "api/array_view.h"
+
+namespace webrtc {
+
+// AVX2 versions of the ThreeBandFilterBank kernels. They perform the same
+// floating point operations, in the same order, as the generic versions.
+
+// Computes out[k] as the sum over the taps i of in[k - i * stride] * filter[i].
+// |in| must be preceded by (filter.size() - 1) * stride readable samples.
+void SparseFilterAvx2(rtc::ArrayView<const float> filter,
+                      int stride,
+                      const float* in,
+                      rtc::ArrayView<float> out);
+
+// Computes out[k] += scale * in[k].
+void ScaleAndAccumulateAvx2(float scale,
+                            rtc::ArrayView<const float> in,
+                            rtc::ArrayView<float> out);
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_THREE_BAND_FILTER_BANK_AVX2_H_
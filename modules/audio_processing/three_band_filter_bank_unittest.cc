@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/three_band_filter_bank.h"
+
+#include <array>
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using Optimization = ThreeBandFilterBank::Optimization;
+
+// The optimized kernels perform the same operations as the generic ones, so
+// only the contraction of multiply-adds by the compiler may differ.
+constexpr float kTolerance = 0.01f;
+constexpr int kNumFrames = 20;
+
+std::vector<Optimization> AvailableOptimizations() {
+  std::vector<Optimization> optimizations;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    optimizations.push_back(Optimization::kSse2);
+  }
+  if (WebRtc_GetCPUInfo(kAVX2) != 0) {
+    optimizations.push_back(Optimization::kAvx2);
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  optimizations.push_back(Optimization::kNeon);
+#endif
+  return optimizations;
+}
+
+void FillRandom(Random* random, rtc::ArrayView<float> x) {
+  for (float& v : x) {
+    v = random->Rand(-32768, 32767);
+  }
+}
+
+// Holds the bands of a frame, with the views that the filter bank works on.
+struct Bands {
+  Bands() {
+    for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
+      views[band] = rtc::ArrayView<float>(data[band]);
+    }
+  }
+
+  std::array<std::array<float, ThreeBandFilterBank::kSplitBandSize>,
+             ThreeBandFilterBank::kNumBands>
+      data;
+  std::array<rtc::ArrayView<float>, ThreeBandFilterBank::kNumBands> views;
+};
+
+}  // namespace
+
+// Verifies that the optimized analysis matches the generic one.
+TEST(ThreeBandFilterBankTest, OptimizedAnalysisMatchesGeneric) {
+  for (Optimization optimization : AvailableOptimizations()) {
+    SCOPED_TRACE(static_cast<int>(optimization));
+    Random random(42);
+    ThreeBandFilterBank generic(Optimization::kNone);
+    ThreeBandFilterBank optimized(optimization);
+    std::array<float, ThreeBandFilterBank::kFullBandSize> in;
+    Bands generic_out;
+    Bands optimized_out;
+    for (int frame = 0; frame < kNumFrames; ++frame) {
+      FillRandom(&random, in);
+      generic.Analysis(in, generic_out.views);
+      optimized.Analysis(in, optimized_out.views);
+      for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
+        for (int k = 0; k < ThreeBandFilterBank::kSplitBandSize; ++k) {
+          EXPECT_NEAR(generic_out.data[band][k], optimized_out.data[band][k],
+                      kTolerance);
+        }
+      }
+    }
+  }
+}
+
+// Verifies that the optimized synthesis matches the generic one.
+TEST(ThreeBandFilterBankTest, OptimizedSynthesisMatchesGeneric) {
+  for (Optimization optimization : AvailableOptimizations()) {
+    SCOPED_TRACE(static_cast<int>(optimization));
+    Random random(42);
+    ThreeBandFilterBank generic(Optimization::kNone);
+    ThreeBandFilterBank optimized(optimization);
+    Bands in;
+    std::array<float, ThreeBandFilterBank::kFullBandSize> generic_out;
+    std::array<float, ThreeBandFilterBank::kFullBandSize> optimized_out;
+    for (int frame = 0; frame < kNumFrames; ++frame) {
+      for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
+        FillRandom(&random, in.data[band]);
+      }
+      generic.Synthesis(in.views, generic_out);
+      optimized.Synthesis(in.views, optimized_out);
+      for (int k = 0; k < ThreeBandFilterBank::kFullBandSize; ++k) {
+        EXPECT_NEAR(generic_out[k], optimized_out[k], kTolerance);
+      }
+    }
+  }
+}
+
+}  // namespace webrtc
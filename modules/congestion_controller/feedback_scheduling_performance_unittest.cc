@@ -0,0 +1,236 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Compares driving periodic feedback of many calls from a ProcessThread, which
+// polls every registered Module for its next deadline, with running it as
+// repeating tasks on a task queue, as ReceiveSideCongestionController now
+// does. The callbacks keep the schedule of RemoteEstimatorProxy's periodic
+// transport feedback but do no work, so only the scheduling is measured.
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/task_queue/default_task_queue_factory.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "api/units/time_delta.h"
+#include "modules/include/module.h"
+#include "modules/utility/include/process_thread.h"
+#include "rtc_base/event.h"
+#include "rtc_base/location.h"
+#include "rtc_base/task_utils/repeating_task.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+#if defined(WEBRTC_LINUX)
+#include <sys/resource.h>
+#endif
+
+namespace webrtc {
+namespace {
+
+// RemoteEstimatorProxy's default feedback interval.
+constexpr TimeDelta kFeedbackInterval = TimeDelta::Millis(100);
+constexpr TimeDelta kDuration = TimeDelta::Seconds(2);
+constexpr int kNumCalls[] = {1, 10, 100, 500};
+
+struct ThreadUsage {
+  int64_t context_switches = 0;
+  int64_t cpu_time_us = 0;
+};
+
+// Wakeups and CPU time of the calling thread so far, where the OS reports
+// them per thread.
+ThreadUsage GetThreadUsage() {
+  ThreadUsage usage;
+#if defined(WEBRTC_LINUX)
+  rusage ru;
+  if (getrusage(RUSAGE_THREAD, &ru) == 0) {
+    usage.context_switches = ru.ru_nvcsw + ru.ru_nivcsw;
+    usage.cpu_time_us = (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1000000 +
+                        ru.ru_utime.tv_usec + ru.ru_stime.tv_usec;
+  }
+#endif
+  return usage;
+}
+
+ThreadUsage GetThreadUsageOn(TaskQueueBase* task_queue) {
+  ThreadUsage usage;
+  rtc::Event done;
+  task_queue->PostTask(ToQueuedTask([&usage, &done] {
+    usage = GetThreadUsage();
+    done.Set();
+  }));
+  done.Wait(rtc::Event::kForever);
+  return usage;
+}
+
+// Feedback times of one call.
+class FeedbackRecorder {
+ public:
+  void OnFeedback() { feedback_times_us_.push_back(rtc::TimeMicros()); }
+
+  // Appends how far each interval between two feedbacks is off the feedback
+  // interval.
+  void AppendIntervalErrorsUs(std::vector<int64_t>* errors_us) const {
+    for (size_t i = 1; i < feedback_times_us_.size(); ++i) {
+      errors_us->push_back(std::abs(feedback_times_us_[i] -
+                                    feedback_times_us_[i - 1] -
+                                    kFeedbackInterval.us()));
+    }
+  }
+
+ private:
+  std::vector<int64_t> feedback_times_us_;
+};
+
+// Follows RemoteEstimatorProxy's Module implementation: the next deadline is
+// an interval after the last Process() call.
+class FeedbackModule : public Module {
+ public:
+  FeedbackModule(FeedbackRecorder* recorder, TimeDelta first_delay)
+      : recorder_(recorder),
+        next_process_time_ms_(rtc::TimeMillis() + first_delay.ms()) {}
+
+  int64_t TimeUntilNextProcess() override {
+    return std::max<int64_t>(next_process_time_ms_ - rtc::TimeMillis(), 0);
+  }
+
+  void Process() override {
+    recorder_->OnFeedback();
+    next_process_time_ms_ = rtc::TimeMillis() + kFeedbackInterval.ms();
+  }
+
+ private:
+  FeedbackRecorder* const recorder_;
+  int64_t next_process_time_ms_;
+};
+
+struct SchedulingResult {
+  std::vector<FeedbackRecorder> recorders;
+  ThreadUsage usage;
+};
+
+// Calls start evenly spread over the first interval, like calls that were set
+// up at different times.
+TimeDelta FirstDelay(int call, int num_calls) {
+  return kFeedbackInterval * call / num_calls;
+}
+
+SchedulingResult RunOnProcessThread(int num_calls) {
+  SchedulingResult result;
+  result.recorders.resize(num_calls);
+  std::unique_ptr<ProcessThread> process_thread =
+      ProcessThread::Create("FeedbackProcessThread");
+  std::vector<std::unique_ptr<FeedbackModule>> modules;
+  for (int i = 0; i < num_calls; ++i) {
+    modules.push_back(std::make_unique<FeedbackModule>(
+        &result.recorders[i], FirstDelay(i, num_calls)));
+    process_thread->RegisterModule(modules.back().get(), RTC_FROM_HERE);
+  }
+  process_thread->Start();
+  const ThreadUsage start_usage = GetThreadUsageOn(process_thread.get());
+  rtc::Event().Wait(kDuration.ms());
+  const ThreadUsage end_usage = GetThreadUsageOn(process_thread.get());
+  process_thread->Stop();
+  for (const auto& module : modules)
+    process_thread->DeRegisterModule(module.get());
+
+  result.usage.context_switches =
+      end_usage.context_switches - start_usage.context_switches;
+  result.usage.cpu_time_us = end_usage.cpu_time_us - start_usage.cpu_time_us;
+  return result;
+}
+
+SchedulingResult RunOnTaskQueue(int num_calls) {
+  SchedulingResult result;
+  result.recorders.resize(num_calls);
+  std::unique_ptr<TaskQueueFactory> task_queue_factory =
+      CreateDefaultTaskQueueFactory();
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> task_queue =
+      task_queue_factory->CreateTaskQueue("FeedbackTaskQueue",
+                                          TaskQueueFactory::Priority::NORMAL);
+  std::vector<RepeatingTaskHandle> tasks;
+  for (int i = 0; i < num_calls; ++i) {
+    FeedbackRecorder* recorder = &result.recorders[i];
+    tasks.push_back(RepeatingTaskHandle::DelayedStart(
+        task_queue.get(), FirstDelay(i, num_calls), [recorder] {
+          recorder->OnFeedback();
+          return kFeedbackInterval;
+        }));
+  }
+  const ThreadUsage start_usage = GetThreadUsageOn(task_queue.get());
+  rtc::Event().Wait(kDuration.ms());
+  const ThreadUsage end_usage = GetThreadUsageOn(task_queue.get());
+  rtc::Event stopped;
+  task_queue->PostTask(ToQueuedTask([&tasks, &stopped] {
+    for (RepeatingTaskHandle& task : tasks)
+      task.Stop();
+    stopped.Set();
+  }));
+  stopped.Wait(rtc::Event::kForever);
+
+  result.usage.context_switches =
+      end_usage.context_switches - start_usage.context_switches;
+  result.usage.cpu_time_us = end_usage.cpu_time_us - start_usage.cpu_time_us;
+  return result;
+}
+
+void PrintResults(const std::string& scheduler,
+                  int num_calls,
+                  const SchedulingResult& result) {
+  const std::string story = scheduler + "_" + std::to_string(num_calls) +
+                            (num_calls == 1 ? "_call" : "_calls");
+  std::vector<int64_t> errors_us;
+  for (const FeedbackRecorder& recorder : result.recorders)
+    recorder.AppendIntervalErrorsUs(&errors_us);
+  ASSERT_FALSE(errors_us.empty());
+  std::sort(errors_us.begin(), errors_us.end());
+  int64_t sum_us = 0;
+  for (int64_t error_us : errors_us)
+    sum_us += error_us;
+
+  webrtc::test::PrintResult(
+      "feedback_interval_error_mean", "", story,
+      static_cast<double>(sum_us) / errors_us.size() / 1000, "ms", false,
+      webrtc::test::ImproveDirection::kSmallerIsBetter);
+  webrtc::test::PrintResult(
+      "feedback_interval_error_p99", "", story,
+      errors_us[errors_us.size() * 99 / 100] / 1000.0, "ms", false,
+      webrtc::test::ImproveDirection::kSmallerIsBetter);
+#if defined(WEBRTC_LINUX)
+  webrtc::test::PrintResult(
+      "scheduler_wakeups", "", story,
+      result.usage.context_switches / kDuration.seconds<double>(), "count/s",
+      false, webrtc::test::ImproveDirection::kSmallerIsBetter);
+  webrtc::test::PrintResult(
+      "scheduler_cpu_time", "", story,
+      result.usage.cpu_time_us / kDuration.seconds<double>() / 1000,
+      "ms/s", false, webrtc::test::ImproveDirection::kSmallerIsBetter);
+#endif
+}
+
+}  // namespace
+
+TEST(FeedbackSchedulingPerformanceTest, ProcessThreadVersusRepeatingTasks) {
+  for (int num_calls : kNumCalls) {
+    PrintResults("process_thread", num_calls, RunOnProcessThread(num_calls));
+    PrintResults("repeating_task", num_calls, RunOnTaskQueue(num_calls));
+  }
+}
+
+}  // namespace webrtc
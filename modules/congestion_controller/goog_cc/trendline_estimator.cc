@@ -51,32 +51,6 @@ size_t ReadTrendlineFilterWindowSize(
   return TrendlineEstimatorSettings::kDefaultTrendlineWindowSize;
 }
 
-absl::optional<double> LinearFitSlope(
-    const std::deque<TrendlineEstimator::PacketTiming>& packets) {
-  RTC_DCHECK(packets.size() >= 2);
-  // Compute the "center of mass".
-  double sum_x = 0;
-  double sum_y = 0;
-  for (const auto& packet : packets) {
-    sum_x += packet.arrival_time_ms;
-    sum_y += packet.smoothed_delay_ms;
-  }
-  double x_avg = sum_x / packets.size();
-  double y_avg = sum_y / packets.size();
-  // Compute the slope k = \sum (x_i-x_avg)(y_i-y_avg) / \sum (x_i-x_avg)^2
-  double numerator = 0;
-  double denominator = 0;
-  for (const auto& packet : packets) {
-    double x = packet.arrival_time_ms;
-    double y = packet.smoothed_delay_ms;
-    numerator += (x - x_avg) * (y - y_avg);
-    denominator += (x - x_avg) * (x - x_avg);
-  }
-  if (denominator == 0)
-    return absl::nullopt;
-  return numerator / denominator;
-}
-
 absl::optional<double> ComputeSlopeCap(
     const std::deque<TrendlineEstimator::PacketTiming>& packets,
     const TrendlineEstimatorSettings& settings) {
@@ -170,6 +144,7 @@ TrendlineEstimator::TrendlineEstimator(
       accumulated_delay_(0),
       smoothed_delay_(0),
       delay_hist_(),
+      delay_regression_(settings_.window_size),
       k_up_(0.0087),
       k_down_(0.039),
       overusing_time_threshold_(kOverUsingTimeThreshold),
@@ -215,16 +190,28 @@ void TrendlineEstimator::UpdateTrendline(double recv_delta_ms,
   delay_hist_.emplace_back(
       static_cast<double>(arrival_time_ms - first_arrival_time_ms_),
       smoothed_delay_, accumulated_delay_);
+  delay_regression_.AddSample(delay_hist_.back().arrival_time_ms,
+                              delay_hist_.back().smoothed_delay_ms);
+  bool reordered = false;
   if (settings_.enable_sort) {
     for (size_t i = delay_hist_.size() - 1;
          i > 0 &&
          delay_hist_[i].arrival_time_ms < delay_hist_[i - 1].arrival_time_ms;
          --i) {
       std::swap(delay_hist_[i], delay_hist_[i - 1]);
+      reordered = true;
     }
   }
   if (delay_hist_.size() > settings_.window_size)
     delay_hist_.pop_front();
+  if (reordered) {
+    // The regression pushes out the oldest sample rather than the earliest
+    // arrival, so it's refilled in arrival order.
+    delay_regression_.Reset();
+    for (const PacketTiming& packet : delay_hist_)
+      delay_regression_.AddSample(packet.arrival_time_ms,
+                                  packet.smoothed_delay_ms);
+  }
 
   // Simple linear regression.
   double trend = prev_trend_;
@@ -234,7 +221,7 @@ void TrendlineEstimator::UpdateTrendline(double recv_delta_ms,
     // 0 < trend < 1   ->  the delay increases, queues are filling up
     //   trend == 0    ->  the delay does not change
     //   trend < 0     ->  the delay decreases, queues are being emptied
-    trend = LinearFitSlope(delay_hist_).value_or(trend);
+    trend = delay_regression_.Slope().value_or(trend);
     if (settings_.enable_cap) {
       absl::optional<double> cap = ComputeSlopeCap(delay_hist_, settings_);
       // We only use the cap to filter out overuse detections, not
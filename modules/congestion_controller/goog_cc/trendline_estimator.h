@@ -23,6 +23,7 @@
 #include "modules/remote_bitrate_estimator/include/bwe_defines.h"
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/experiments/struct_parameters_parser.h"
+#include "rtc_base/numerics/sliding_linear_regression.h"
 
 namespace webrtc {
 
@@ -106,6 +107,7 @@ class TrendlineEstimator : public DelayIncreaseDetectorInterface {
   double smoothed_delay_;
   // Linear least squares regression.
   std::deque<PacketTiming> delay_hist_;
+  rtc::SlidingLinearRegression delay_regression_;
 
   const double k_up_;
   const double k_down_;
@@ -14,12 +14,15 @@
 #include <memory>
 #include <vector>
 
+#include "api/task_queue/task_queue_factory.h"
 #include "api/transport/field_trial_based_config.h"
 #include "api/transport/network_control.h"
+#include "api/units/time_delta.h"
 #include "modules/include/module.h"
 #include "modules/remote_bitrate_estimator/remote_estimator_proxy.h"
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/critical_section.h"
+#include "rtc_base/network/ecn_marking.h"
 
 namespace webrtc {
 class RemoteBitrateEstimator;
@@ -38,12 +41,24 @@ class ReceiveSideCongestionController : public CallStatsObserver,
       Clock* clock,
       PacketRouter* packet_router,
       NetworkStateEstimator* network_state_estimator);
+  // |task_queue_factory|, if not null, runs the shadow estimators of the
+  // AlphaCC config.
+  ReceiveSideCongestionController(
+      Clock* clock,
+      PacketRouter* packet_router,
+      NetworkStateEstimator* network_state_estimator,
+      TaskQueueFactory* task_queue_factory);
 
   ~ReceiveSideCongestionController() override {}
 
   virtual void OnReceivedPacket(int64_t arrival_time_ms,
                                 size_t payload_size,
                                 const RTPHeader& header);
+  // As above, for a packet received with the IP ECN codepoint |ecn|.
+  void OnReceivedPacket(int64_t arrival_time_ms,
+                        size_t payload_size,
+                        const RTPHeader& header,
+                        rtc::EcnMarking ecn);
 
   void SetSendPeriodicFeedback(bool send_periodic_feedback);
   // TODO(nisse): Delete these methods, design a more specific interface.
@@ -61,6 +76,12 @@ class ReceiveSideCongestionController : public CallStatsObserver,
   int64_t TimeUntilNextProcess() override;
   void Process() override;
 
+  // Runs the periodic work of both estimators that is due, i.e. Process() of
+  // this and of GetRemoteBitrateEstimator(true), and returns the delay until
+  // more is. Meant to be called from a repeating task instead of registering
+  // the two with a ProcessThread.
+  TimeDelta MaybeProcess();
+
  private:
   class WrappingBitrateEstimator : public RemoteBitrateEstimator {
    public:
@@ -100,6 +121,7 @@ class ReceiveSideCongestionController : public CallStatsObserver,
     RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(WrappingBitrateEstimator);
   };
 
+  Clock* const clock_;
   const FieldTrialBasedConfig field_trial_config_;
   WrappingBitrateEstimator remote_bitrate_estimator_;
   RemoteEstimatorProxy remote_estimator_proxy_;
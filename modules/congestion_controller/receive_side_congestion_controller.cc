@@ -10,12 +10,15 @@
 
 #include "modules/congestion_controller/include/receive_side_congestion_controller.h"
 
+#include <algorithm>
+
 #include "api/alphacc_config.h"
 #include "modules/pacing/packet_router.h"
 #include "modules/remote_bitrate_estimator/include/bwe_defines.h"
 #include "modules/remote_bitrate_estimator/remote_bitrate_estimator_abs_send_time.h"
 #include "modules/remote_bitrate_estimator/remote_bitrate_estimator_single_stream.h"
 #include "rtc_base/logging.h"
+#include "system_wrappers/include/clock.h"
 
 namespace webrtc {
 
@@ -128,17 +131,39 @@ ReceiveSideCongestionController::ReceiveSideCongestionController(
     Clock* clock,
     PacketRouter* packet_router,
     NetworkStateEstimator* network_state_estimator)
-    : remote_bitrate_estimator_(packet_router, clock),
+    : ReceiveSideCongestionController(clock,
+                                      packet_router,
+                                      network_state_estimator,
+                                      nullptr) {}
+
+ReceiveSideCongestionController::ReceiveSideCongestionController(
+    Clock* clock,
+    PacketRouter* packet_router,
+    NetworkStateEstimator* network_state_estimator,
+    TaskQueueFactory* task_queue_factory)
+    : clock_(clock),
+      remote_bitrate_estimator_(packet_router, clock),
       remote_estimator_proxy_(clock,
                               packet_router,
                               &field_trial_config_,
-                              network_state_estimator) {}
+                              network_state_estimator,
+                              task_queue_factory) {}
 
 void ReceiveSideCongestionController::OnReceivedPacket(
     int64_t arrival_time_ms,
     size_t payload_size,
     const RTPHeader& header) {
-  remote_estimator_proxy_.IncomingPacket(arrival_time_ms, payload_size, header);
+  OnReceivedPacket(arrival_time_ms, payload_size, header,
+                   rtc::EcnMarking::kNotEct);
+}
+
+void ReceiveSideCongestionController::OnReceivedPacket(
+    int64_t arrival_time_ms,
+    size_t payload_size,
+    const RTPHeader& header,
+    rtc::EcnMarking ecn) {
+  remote_estimator_proxy_.IncomingPacket(arrival_time_ms, payload_size, header,
+                                         ecn);
   if (!header.extension.hasTransportSequenceNumber) {
     // Receive-side BWE.
     remote_bitrate_estimator_.IncomingPacket(arrival_time_ms, payload_size,
@@ -173,6 +198,7 @@ ReceiveSideCongestionController::GetRemoteBitrateEstimator(
 void ReceiveSideCongestionController::OnRttUpdate(int64_t avg_rtt_ms,
                                                   int64_t max_rtt_ms) {
   remote_bitrate_estimator_.OnRttUpdate(avg_rtt_ms, max_rtt_ms);
+  remote_estimator_proxy_.OnRttUpdate(avg_rtt_ms, max_rtt_ms);
 }
 
 void ReceiveSideCongestionController::OnBitrateChanged(int bitrate_bps) {
@@ -187,4 +213,17 @@ void ReceiveSideCongestionController::Process() {
   remote_bitrate_estimator_.Process();
 }
 
+TimeDelta ReceiveSideCongestionController::MaybeProcess() {
+  const Timestamp now = clock_->CurrentTime();
+  int64_t time_until_rbe_ms = remote_bitrate_estimator_.TimeUntilNextProcess();
+  if (time_until_rbe_ms <= 0) {
+    remote_bitrate_estimator_.Process();
+    time_until_rbe_ms = remote_bitrate_estimator_.TimeUntilNextProcess();
+  }
+  const TimeDelta time_until_rep = remote_estimator_proxy_.Process(now);
+  return std::max(
+      std::min(TimeDelta::Millis(time_until_rbe_ms), time_until_rep),
+      TimeDelta::Zero());
+}
+
 }  // namespace webrtc
@@ -10,7 +10,11 @@
 
 #include "modules/congestion_controller/include/receive_side_congestion_controller.h"
 
+#include <memory>
+
 #include "modules/pacing/packet_router.h"
+#include "modules/remote_bitrate_estimator/receive_side_estimator.h"
+#include "modules/remote_bitrate_estimator/remote_estimator_proxy.h"
 #include "system_wrappers/include/clock.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -43,6 +47,20 @@ class MockPacketRouter : public PacketRouter {
 
 const uint32_t kInitialBitrateBps = 60000;
 
+// Records the RTT it's told about.
+class RttRecordingEstimator : public ReceiveSideEstimator {
+ public:
+  explicit RttRecordingEstimator(int64_t* avg_rtt_ms)
+      : avg_rtt_ms_(avg_rtt_ms) {}
+
+  void OnReceived(const Packet& packet) override {}
+  float GetBweEstimate(int64_t now_ms) override { return 0.f; }
+  void OnRttUpdate(int64_t avg_rtt_ms) override { *avg_rtt_ms_ = avg_rtt_ms; }
+
+ private:
+  int64_t* const avg_rtt_ms_;
+};
+
 }  // namespace
 
 namespace test {
@@ -73,6 +91,21 @@ TEST(ReceiveSideCongestionControllerTest, OnReceivedPacketWithAbsSendTime) {
   EXPECT_EQ(header.ssrc, ssrcs[0]);
 }
 
+TEST(ReceiveSideCongestionControllerTest, ForwardsRttToSendSideEstimator) {
+  StrictMock<MockPacketRouter> packet_router;
+  SimulatedClock clock_(123456);
+
+  ReceiveSideCongestionController controller(&clock_, &packet_router);
+  int64_t avg_rtt_ms = -1;
+  static_cast<RemoteEstimatorProxy*>(
+      controller.GetRemoteBitrateEstimator(/*send_side_bwe=*/true))
+      ->SetEstimatorForTesting(
+          std::make_unique<RttRecordingEstimator>(&avg_rtt_ms));
+
+  controller.OnRttUpdate(30, 40);
+  EXPECT_EQ(avg_rtt_ms, 30);
+}
+
 TEST(ReceiveSideCongestionControllerTest, ConvergesToCapacity) {
   Scenario s("recieve_cc_unit/converge");
   NetworkSimulationConfig net_conf;
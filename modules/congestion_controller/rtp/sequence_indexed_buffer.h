@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_RTP_SEQUENCE_INDEXED_BUFFER_H_
+#define MODULES_CONGESTION_CONTROLLER_RTP_SEQUENCE_INDEXED_BUFFER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+// Values keyed by an unwrapped sequence number, stored in a ring buffer
+// instead of a tree so that inserting, finding and erasing don't allocate or
+// search. Every key in [begin_key(), end_key()) has a slot, and the first and
+// last slot always hold a value. Erasing a key in between leaves its slot
+// empty until the front of the buffer passes it.
+//
+// The buffer grows to the range of keys in use and keeps its capacity after
+// that, so keys should be dense and mostly increasing, like transport or RTP
+// sequence numbers of sent packets.
+template <typename T>
+class SequenceIndexedBuffer {
+ public:
+  SequenceIndexedBuffer() = default;
+  SequenceIndexedBuffer(SequenceIndexedBuffer&&) = default;
+  SequenceIndexedBuffer& operator=(SequenceIndexedBuffer&&) = default;
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+  // Number of slots, values included.
+  size_t capacity() const { return slots_.size(); }
+  // Valid if not empty.
+  int64_t begin_key() const { return begin_key_; }
+  int64_t end_key() const { return end_key_; }
+
+  // Returns false, leaving the buffer unchanged, if |key| already has a value.
+  bool Insert(int64_t key, T value) {
+    if (empty()) {
+      if (slots_.empty())
+        slots_.resize(kMinCapacity);
+      begin_key_ = key;
+      end_key_ = key + 1;
+    } else {
+      const int64_t begin_key = std::min(begin_key_, key);
+      const int64_t end_key = std::max(end_key_, key + 1);
+      if (end_key - begin_key > static_cast<int64_t>(slots_.size()))
+        Reserve(end_key - begin_key);
+      begin_key_ = begin_key;
+      end_key_ = end_key;
+    }
+    absl::optional<T>& slot = Slot(key);
+    if (slot)
+      return false;
+    slot = std::move(value);
+    ++size_;
+    return true;
+  }
+
+  T* Find(int64_t key) {
+    if (key < begin_key_ || key >= end_key_)
+      return nullptr;
+    absl::optional<T>& slot = Slot(key);
+    return slot ? &*slot : nullptr;
+  }
+  const T* Find(int64_t key) const {
+    return const_cast<SequenceIndexedBuffer*>(this)->Find(key);
+  }
+
+  // Value of begin_key(). Must not be empty.
+  T& front() {
+    RTC_DCHECK(!empty());
+    return *Slot(begin_key_);
+  }
+
+  void Erase(int64_t key) {
+    if (key < begin_key_ || key >= end_key_)
+      return;
+    absl::optional<T>& slot = Slot(key);
+    if (!slot)
+      return;
+    slot.reset();
+    --size_;
+    if (empty()) {
+      begin_key_ = end_key_;
+      return;
+    }
+    while (!Slot(begin_key_))
+      ++begin_key_;
+    while (!Slot(end_key_ - 1))
+      --end_key_;
+  }
+
+  void PopFront() { Erase(begin_key_); }
+
+  // Calls |function(key, value)| for the keys in [first_key, end_key) that
+  // have a value, in order.
+  template <typename Function>
+  void ForEachInRange(int64_t first_key, int64_t end_key, Function function) {
+    if (empty())
+      return;
+    first_key = std::max(first_key, begin_key_);
+    end_key = std::min(end_key, end_key_);
+    for (int64_t key = first_key; key < end_key; ++key) {
+      absl::optional<T>& slot = Slot(key);
+      if (slot)
+        function(key, *slot);
+    }
+  }
+
+ private:
+  static constexpr size_t kMinCapacity = 64;
+
+  absl::optional<T>& Slot(int64_t key) {
+    // The capacity is a power of two, so this is the key modulo the capacity,
+    // also for negative keys.
+    return slots_[static_cast<uint64_t>(key) & (slots_.size() - 1)];
+  }
+
+  // Grows the capacity to a power of two of at least |range| slots.
+  void Reserve(int64_t range) {
+    size_t capacity = slots_.size();
+    while (static_cast<int64_t>(capacity) < range)
+      capacity *= 2;
+    std::vector<absl::optional<T>> slots(capacity);
+    for (int64_t key = begin_key_; key < end_key_; ++key) {
+      absl::optional<T>& slot = Slot(key);
+      if (slot)
+        slots[static_cast<uint64_t>(key) & (capacity - 1)] = std::move(slot);
+    }
+    slots_ = std::move(slots);
+  }
+
+  std::vector<absl::optional<T>> slots_;
+  int64_t begin_key_ = 0;
+  int64_t end_key_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_RTP_SEQUENCE_INDEXED_BUFFER_H_
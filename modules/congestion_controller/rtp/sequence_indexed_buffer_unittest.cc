@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/rtp/sequence_indexed_buffer.h"
+
+#include <map>
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+std::vector<int64_t> Keys(SequenceIndexedBuffer<int>* buffer) {
+  std::vector<int64_t> keys;
+  buffer->ForEachInRange(buffer->begin_key(), buffer->end_key(),
+                         [&](int64_t key, int) { keys.push_back(key); });
+  return keys;
+}
+
+}  // namespace
+
+TEST(SequenceIndexedBufferTest, InsertsAndFinds) {
+  SequenceIndexedBuffer<int> buffer;
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.Find(0), nullptr);
+
+  EXPECT_TRUE(buffer.Insert(10, 1));
+  EXPECT_TRUE(buffer.Insert(12, 2));
+  EXPECT_FALSE(buffer.Insert(10, 3));
+  EXPECT_EQ(buffer.size(), 2u);
+  EXPECT_EQ(buffer.begin_key(), 10);
+  EXPECT_EQ(buffer.end_key(), 13);
+  ASSERT_NE(buffer.Find(10), nullptr);
+  EXPECT_EQ(*buffer.Find(10), 1);
+  EXPECT_EQ(buffer.Find(11), nullptr);
+  EXPECT_EQ(*buffer.Find(12), 2);
+  EXPECT_EQ(buffer.front(), 1);
+}
+
+TEST(SequenceIndexedBufferTest, EraseTrimsBothEnds) {
+  SequenceIndexedBuffer<int> buffer;
+  for (int64_t key = 0; key < 5; ++key)
+    buffer.Insert(key, 0);
+
+  buffer.Erase(2);
+  EXPECT_EQ(Keys(&buffer), std::vector<int64_t>({0, 1, 3, 4}));
+  buffer.Erase(4);
+  EXPECT_EQ(buffer.end_key(), 4);
+  buffer.PopFront();
+  buffer.PopFront();
+  EXPECT_EQ(buffer.begin_key(), 3);
+  EXPECT_EQ(buffer.size(), 1u);
+  buffer.Erase(3);
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.Find(3), nullptr);
+}
+
+TEST(SequenceIndexedBufferTest, GrowsKeepingValues) {
+  SequenceIndexedBuffer<int> buffer;
+  // Inserted below the first key as well as above it.
+  for (int key = 0; key < 1000; ++key)
+    EXPECT_TRUE(buffer.Insert(key % 2 ? 500 + key : 500 - key, key));
+  EXPECT_GE(buffer.capacity(), 2000u);
+  for (int key = 0; key < 1000; ++key)
+    EXPECT_EQ(*buffer.Find(key % 2 ? 500 + key : 500 - key), key);
+}
+
+TEST(SequenceIndexedBufferTest, KeepsCapacityWhenSliding) {
+  SequenceIndexedBuffer<int> buffer;
+  for (int64_t key = 0; key < 100; ++key)
+    buffer.Insert(key, 0);
+  const size_t capacity = buffer.capacity();
+  for (int64_t key = 100; key < 100000; ++key) {
+    buffer.Insert(key, 0);
+    buffer.PopFront();
+  }
+  EXPECT_EQ(buffer.capacity(), capacity);
+  EXPECT_EQ(buffer.begin_key(), 99900);
+}
+
+TEST(SequenceIndexedBufferTest, ForEachInRangeSkipsMissingKeys) {
+  SequenceIndexedBuffer<int> buffer;
+  buffer.Insert(5, 0);
+  buffer.Insert(7, 0);
+  buffer.Insert(9, 0);
+  std::vector<int64_t> keys;
+  buffer.ForEachInRange(0, 9, [&](int64_t key, int) { keys.push_back(key); });
+  EXPECT_EQ(keys, std::vector<int64_t>({5, 7}));
+}
+
+TEST(SequenceIndexedBufferTest, MatchesMap) {
+  Random random(0x1234);
+  SequenceIndexedBuffer<int> buffer;
+  std::map<int64_t, int> map;
+  int64_t next_key = 0;
+  for (int i = 0; i < 10000; ++i) {
+    if (random.Rand(2) == 0 || map.empty()) {
+      int64_t key = next_key - random.Rand(20);
+      next_key += random.Rand(3);
+      int value = random.Rand(1000);
+      EXPECT_EQ(buffer.Insert(key, value), map.insert({key, value}).second);
+    } else {
+      int64_t key = map.begin()->first + random.Rand(30);
+      buffer.Erase(key);
+      map.erase(key);
+    }
+    ASSERT_EQ(buffer.size(), map.size());
+    if (!map.empty()) {
+      EXPECT_EQ(buffer.begin_key(), map.begin()->first);
+      EXPECT_EQ(buffer.end_key(), map.rbegin()->first + 1);
+    }
+  }
+  for (const auto& key_and_value : map)
+    EXPECT_EQ(*buffer.Find(key_and_value.first), key_and_value.second);
+}
+
+}  // namespace webrtc
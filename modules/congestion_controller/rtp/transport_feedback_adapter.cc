@@ -19,6 +19,7 @@
 #include "absl/algorithm/container.h"
 #include "api/units/timestamp.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/congestion_control_feedback.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -28,9 +29,30 @@ namespace webrtc {
 
 constexpr TimeDelta kSendTimeHistoryWindow = TimeDelta::Seconds(60);
 
+void InFlightBytesTracker::SetCurrentRoute(
+    const rtc::NetworkRoute& network_route) {
+  if (IsCurrentRoute(network_route)) {
+    current_route_ = network_route;
+    return;
+  }
+  if (!current_route_in_flight_.IsZero())
+    in_flight_data_.insert({current_route_, current_route_in_flight_});
+  current_route_ = network_route;
+  current_route_in_flight_ = DataSize::Zero();
+  auto it = in_flight_data_.find(network_route);
+  if (it != in_flight_data_.end()) {
+    current_route_in_flight_ = it->second;
+    in_flight_data_.erase(it);
+  }
+}
+
 void InFlightBytesTracker::AddInFlightPacketBytes(
     const PacketFeedback& packet) {
   RTC_DCHECK(packet.sent.send_time.IsFinite());
+  if (IsCurrentRoute(packet.network_route)) {
+    current_route_in_flight_ += packet.sent.size;
+    return;
+  }
   auto it = in_flight_data_.find(packet.network_route);
   if (it != in_flight_data_.end()) {
     it->second += packet.sent.size;
@@ -43,6 +65,11 @@ void InFlightBytesTracker::RemoveInFlightPacketBytes(
     const PacketFeedback& packet) {
   if (packet.sent.send_time.IsInfinite())
     return;
+  if (IsCurrentRoute(packet.network_route)) {
+    RTC_DCHECK_GE(current_route_in_flight_, packet.sent.size);
+    current_route_in_flight_ -= packet.sent.size;
+    return;
+  }
   auto it = in_flight_data_.find(packet.network_route);
   if (it != in_flight_data_.end()) {
     RTC_DCHECK_GE(it->second, packet.sent.size);
@@ -54,6 +81,8 @@ void InFlightBytesTracker::RemoveInFlightPacketBytes(
 
 DataSize InFlightBytesTracker::GetOutstandingData(
     const rtc::NetworkRoute& network_route) const {
+  if (IsCurrentRoute(network_route))
+    return current_route_in_flight_;
   auto it = in_flight_data_.find(network_route);
   if (it != in_flight_data_.end()) {
     return it->second;
@@ -84,6 +113,13 @@ bool InFlightBytesTracker::NetworkRouteComparator::operator()(
   return a.connected < b.connected;
 }
 
+bool InFlightBytesTracker::IsCurrentRoute(
+    const rtc::NetworkRoute& network_route) const {
+  NetworkRouteComparator less;
+  return !less(network_route, current_route_) &&
+         !less(current_route_, network_route);
+}
+
 TransportFeedbackAdapter::TransportFeedbackAdapter() = default;
 
 
@@ -98,16 +134,45 @@ void TransportFeedbackAdapter::AddPacket(const RtpPacketSendInfo& packet_info,
   packet.sent.audio = packet_info.packet_type == RtpPacketMediaType::kAudio;
   packet.network_route = network_route_;
   packet.sent.pacing_info = packet_info.pacing_info;
+  packet.rtp_ssrc = packet_info.rtp_ssrc;
+  packet.rtp_sequence_number = packet_info.rtp_sequence_number;
 
+  while (!lost_history_.empty() &&
+         creation_time - lost_history_.begin()->second.creation_time >
+             kSendTimeHistoryWindow) {
+    EraseFromHistory(lost_history_.begin()->first);
+  }
   while (!history_.empty() &&
-         creation_time - history_.begin()->second.creation_time >
+         creation_time - history_.front().creation_time >
              kSendTimeHistoryWindow) {
     // TODO(sprang): Warn if erasing (too many) old items?
-    if (history_.begin()->second.sent.sequence_number > last_ack_seq_num_)
-      in_flight_.RemoveInFlightPacketBytes(history_.begin()->second);
-    history_.erase(history_.begin());
+    if (history_.front().sent.sequence_number > last_ack_seq_num_)
+      in_flight_.RemoveInFlightPacketBytes(history_.front());
+    EraseFromHistory(history_.begin_key());
+  }
+  if (!history_.Insert(packet.sent.sequence_number, packet) ||
+      packet.rtp_ssrc == 0) {
+    return;
   }
-  history_.insert(std::make_pair(packet.sent.sequence_number, packet));
+
+  RtpSequenceNumberIndex& index = rtp_seq_num_indexes_[packet.rtp_ssrc];
+  const int64_t rtp_seq_num =
+      index.unwrapper.Unwrap(packet.rtp_sequence_number);
+  if (int64_t* seq_num = index.transport_sequence_numbers.Find(rtp_seq_num)) {
+    *seq_num = packet.sent.sequence_number;
+  } else {
+    index.transport_sequence_numbers.Insert(rtp_seq_num,
+                                            packet.sent.sequence_number);
+  }
+  // Entries are normally erased with the packets in |history_|, but ones that
+  // were overwritten, or too far from the last RTP sequence number to be
+  // unwrapped on erase, are dropped once they fall out of the history.
+  const int64_t oldest_seq_num =
+      lost_history_.empty()
+          ? history_.begin_key()
+          : std::min(history_.begin_key(), lost_history_.begin()->first);
+  while (index.transport_sequence_numbers.front() < oldest_seq_num)
+    index.transport_sequence_numbers.PopFront();
 }
 
 absl::optional<SentPacket> TransportFeedbackAdapter::ProcessSentPacket(
@@ -117,10 +182,10 @@ absl::optional<SentPacket> TransportFeedbackAdapter::ProcessSentPacket(
   if (sent_packet.info.included_in_feedback || sent_packet.packet_id != -1) {
     int64_t unwrapped_seq_num =
         seq_num_unwrapper_.Unwrap(sent_packet.packet_id);
-    auto it = history_.find(unwrapped_seq_num);
-    if (it != history_.end()) {
-      bool packet_retransmit = it->second.sent.send_time.IsFinite();
-      it->second.sent.send_time = send_time;
+    PacketFeedback* packet = FindInHistory(unwrapped_seq_num);
+    if (packet) {
+      bool packet_retransmit = packet->sent.send_time.IsFinite();
+      packet->sent.send_time = send_time;
       last_send_time_ = std::max(last_send_time_, send_time);
       // TODO(srte): Don't do this on retransmit.
       if (!pending_untracked_size_.IsZero()) {
@@ -128,14 +193,14 @@ absl::optional<SentPacket> TransportFeedbackAdapter::ProcessSentPacket(
           RTC_LOG(LS_WARNING)
               << "appending acknowledged data for out of order packet. (Diff: "
               << ToString(last_untracked_send_time_ - send_time) << " ms.)";
-        it->second.sent.prior_unacked_data += pending_untracked_size_;
+        packet->sent.prior_unacked_data += pending_untracked_size_;
         pending_untracked_size_ = DataSize::Zero();
       }
       if (!packet_retransmit) {
-        if (it->second.sent.sequence_number > last_ack_seq_num_)
-          in_flight_.AddInFlightPacketBytes(it->second);
-        it->second.sent.data_in_flight = GetOutstandingData();
-        return it->second.sent;
+        if (packet->sent.sequence_number > last_ack_seq_num_)
+          in_flight_.AddInFlightPacketBytes(*packet);
+        packet->sent.data_in_flight = GetOutstandingData();
+        return packet->sent;
       }
     }
   } else if (sent_packet.info.included_in_allocation) {
@@ -162,15 +227,159 @@ TransportFeedbackAdapter::ProcessTransportFeedback(
   msg.feedback_time = feedback_receive_time;
 
   msg.prior_in_flight = in_flight_.GetOutstandingData(network_route_);
-  msg.packet_feedbacks =
-      ProcessTransportFeedbackInner(feedback, feedback_receive_time);
+  ProcessTransportFeedbackInner(feedback, feedback_receive_time,
+                                &msg.packet_feedbacks);
+  MoveLostPacketsOutOfHistory();
   if (msg.packet_feedbacks.empty())
     return absl::nullopt;
 
-  auto it = history_.find(last_ack_seq_num_);
-  if (it != history_.end()) {
-    msg.first_unacked_send_time = it->second.sent.send_time;
+  if (const PacketFeedback* packet = FindInHistory(last_ack_seq_num_))
+    msg.first_unacked_send_time = packet->sent.send_time;
+  msg.data_in_flight = in_flight_.GetOutstandingData(network_route_);
+
+  return msg;
+}
+
+absl::optional<TransportPacketsFeedback>
+TransportFeedbackAdapter::ProcessCongestionControlFeedback(
+    const rtcp::CongestionControlFeedback& feedback,
+    Timestamp feedback_receive_time) {
+  if (feedback.packets().empty()) {
+    RTC_LOG(LS_INFO) << "Empty congestion control feedback packet received.";
+    return absl::nullopt;
+  }
+
+  // Like transport feedback, report timestamps are placed on a local time base
+  // selected on the first report. Compact NTP wraps every 18 hours, so the
+  // difference to the previous report is taken as signed.
+  const uint32_t report_timestamp = feedback.report_timestamp_compact_ntp();
+  if (!last_report_timestamp_compact_ntp_) {
+    report_time_base_ = feedback_receive_time;
+  } else {
+    report_time_units_ += static_cast<int32_t>(
+        report_timestamp - *last_report_timestamp_compact_ntp_);
+  }
+  last_report_timestamp_compact_ntp_ = report_timestamp;
+  const Timestamp report_time =
+      report_time_base_ +
+      TimeDelta::Micros(report_time_units_ * 1000000 / (1 << 16));
+
+  TransportPacketsFeedback msg;
+  msg.feedback_time = feedback_receive_time;
+  msg.prior_in_flight = in_flight_.GetOutstandingData(network_route_);
+
+  // Reports are grouped by SSRC, results are ordered by transport sequence
+  // number like for transport feedback.
+  const std::vector<rtcp::CongestionControlFeedback::PacketInfo>& packets =
+      feedback.packets();
+  reported_packets_.clear();
+  size_t failed_lookups = 0;
+  RtpSequenceNumberIndex* index = nullptr;
+  for (size_t i = 0; i < packets.size(); ++i) {
+    if (i == 0 || packets[i].ssrc != packets[i - 1].ssrc)
+      index = FindRtpSequenceNumberIndex(packets[i].ssrc);
+    const int64_t* seq_num =
+        index ? index->transport_sequence_numbers.Find(
+                    index->unwrapper.UnwrapWithoutUpdate(
+                        packets[i].sequence_number))
+              : nullptr;
+    if (!seq_num) {
+      ++failed_lookups;
+      continue;
+    }
+    reported_packets_.emplace_back(*seq_num, i);
   }
+  // Duplicate or overlapping report blocks may report a packet more than
+  // once. Keep one report per packet, preferring one that says it was
+  // received.
+  absl::c_sort(reported_packets_, [&packets](const auto& a, const auto& b) {
+    if (a.first != b.first)
+      return a.first < b.first;
+    return packets[a.second].received() && !packets[b.second].received();
+  });
+  reported_packets_.erase(
+      std::unique(reported_packets_.begin(), reported_packets_.end(),
+                  [](const auto& a, const auto& b) {
+                    return a.first == b.first;
+                  }),
+      reported_packets_.end());
+
+  // Acknowledge the packets up to the first one in flight that the report
+  // doesn't cover. Packets of other SSRCs, or beyond the packets a report can
+  // hold, are reported by later feedback.
+  if (!reported_packets_.empty()) {
+    int64_t ack_seq_num = reported_packets_.back().first;
+    if (!history_.empty()) {
+      auto reported = reported_packets_.begin();
+      const int64_t end_seq_num =
+          std::min(ack_seq_num + 1, history_.end_key());
+      for (int64_t seq_num = std::max(last_ack_seq_num_ + 1,
+                                      history_.begin_key());
+           seq_num < end_seq_num; ++seq_num) {
+        while (reported->first < seq_num)
+          ++reported;
+        if (reported->first != seq_num && history_.Find(seq_num)) {
+          ack_seq_num = seq_num - 1;
+          break;
+        }
+      }
+    }
+    AcknowledgeUpTo(ack_seq_num);
+  }
+
+  size_t ignored = 0;
+  msg.packet_feedbacks.reserve(reported_packets_.size());
+  for (const auto& seq_and_index : reported_packets_) {
+    const auto& packet = packets[seq_and_index.second];
+    PacketFeedback* sent_packet = FindInHistory(seq_and_index.first);
+    if (!sent_packet) {
+      ++failed_lookups;
+      continue;
+    }
+    if (sent_packet->sent.send_time.IsInfinite()) {
+      RTC_DLOG(LS_ERROR)
+          << "Received feedback before packet was indicated as sent";
+      continue;
+    }
+    // Received, but the arrival time offset is too large to be useful.
+    if (packet.received() && packet.arrival_time_offset.IsPlusInfinity())
+      continue;
+
+    if (sent_packet->network_route == network_route_) {
+      PacketResult result;
+      result.sent_packet = sent_packet->sent;
+      result.receive_time = sent_packet->receive_time;
+      if (packet.received())
+        result.receive_time = report_time - packet.arrival_time_offset;
+      result.ecn = packet.ecn;
+      msg.packet_feedbacks.push_back(result);
+    } else {
+      ++ignored;
+    }
+    // Lost packets are kept, they might be reported as received later.
+    if (packet.received()) {
+      // Packets after an uncovered one are still counted in flight.
+      if (seq_and_index.first > last_ack_seq_num_)
+        in_flight_.RemoveInFlightPacketBytes(*sent_packet);
+      EraseFromHistory(seq_and_index.first);
+    }
+  }
+  MoveLostPacketsOutOfHistory();
+
+  if (failed_lookups > 0) {
+    RTC_LOG(LS_WARNING) << "Failed to lookup send time for " << failed_lookups
+                        << " packet" << (failed_lookups > 1 ? "s" : "")
+                        << ". Send time history too small?";
+  }
+  if (ignored > 0) {
+    RTC_LOG(LS_INFO) << "Ignoring " << ignored
+                     << " packets because they were sent on a different route.";
+  }
+  if (msg.packet_feedbacks.empty())
+    return absl::nullopt;
+
+  if (const PacketFeedback* packet = FindInHistory(last_ack_seq_num_))
+    msg.first_unacked_send_time = packet->sent.send_time;
   msg.data_in_flight = in_flight_.GetOutstandingData(network_route_);
 
   return msg;
@@ -179,16 +388,74 @@ TransportFeedbackAdapter::ProcessTransportFeedback(
 void TransportFeedbackAdapter::SetNetworkRoute(
     const rtc::NetworkRoute& network_route) {
   network_route_ = network_route;
+  in_flight_.SetCurrentRoute(network_route);
 }
 
 DataSize TransportFeedbackAdapter::GetOutstandingData() const {
   return in_flight_.GetOutstandingData(network_route_);
 }
 
-std::vector<PacketResult>
-TransportFeedbackAdapter::ProcessTransportFeedbackInner(
+void TransportFeedbackAdapter::AcknowledgeUpTo(int64_t seq_num) {
+  if (seq_num <= last_ack_seq_num_)
+    return;
+  // Starts at the first packet in |history_| if last_ack_seq_num_ < 0, since
+  // any valid sequence number is >= 0.
+  history_.ForEachInRange(last_ack_seq_num_ + 1, seq_num + 1,
+                          [this](int64_t, const PacketFeedback& packet) {
+                            in_flight_.RemoveInFlightPacketBytes(packet);
+                          });
+  last_ack_seq_num_ = seq_num;
+}
+
+TransportFeedbackAdapter::RtpSequenceNumberIndex*
+TransportFeedbackAdapter::FindRtpSequenceNumberIndex(uint32_t ssrc) {
+  auto it = rtp_seq_num_indexes_.find(ssrc);
+  return it != rtp_seq_num_indexes_.end() ? &it->second : nullptr;
+}
+
+PacketFeedback* TransportFeedbackAdapter::FindInHistory(int64_t seq_num) {
+  if (PacketFeedback* packet = history_.Find(seq_num))
+    return packet;
+  if (lost_history_.empty() || seq_num > lost_history_.rbegin()->first)
+    return nullptr;
+  auto it = lost_history_.find(seq_num);
+  return it != lost_history_.end() ? &it->second : nullptr;
+}
+
+void TransportFeedbackAdapter::EraseFromHistory(int64_t seq_num) {
+  const PacketFeedback* packet = FindInHistory(seq_num);
+  if (!packet)
+    return;
+  RtpSequenceNumberIndex* index =
+      packet->rtp_ssrc != 0 ? FindRtpSequenceNumberIndex(packet->rtp_ssrc)
+                            : nullptr;
+  if (index) {
+    const int64_t rtp_seq_num =
+        index->unwrapper.UnwrapWithoutUpdate(packet->rtp_sequence_number);
+    const int64_t* indexed_seq_num =
+        index->transport_sequence_numbers.Find(rtp_seq_num);
+    if (indexed_seq_num && *indexed_seq_num == seq_num)
+      index->transport_sequence_numbers.Erase(rtp_seq_num);
+  }
+  if (history_.Find(seq_num)) {
+    history_.Erase(seq_num);
+  } else {
+    lost_history_.erase(seq_num);
+  }
+}
+
+void TransportFeedbackAdapter::MoveLostPacketsOutOfHistory() {
+  while (!history_.empty() && history_.begin_key() <= last_ack_seq_num_) {
+    lost_history_.emplace_hint(lost_history_.end(), history_.begin_key(),
+                               std::move(history_.front()));
+    history_.PopFront();
+  }
+}
+
+void TransportFeedbackAdapter::ProcessTransportFeedbackInner(
     const rtcp::TransportFeedback& feedback,
-    Timestamp feedback_receive_time) {
+    Timestamp feedback_receive_time,
+    std::vector<PacketResult>* packet_results) {
   // Add timestamp deltas to a local time base selected on first packet arrival.
   // This won't be the true time base, but makes it easier to manually inspect
   // time stamps.
@@ -208,8 +475,7 @@ TransportFeedbackAdapter::ProcessTransportFeedbackInner(
   }
   last_timestamp_ = feedback.GetBaseTime();
 
-  std::vector<PacketResult> packet_result_vector;
-  packet_result_vector.reserve(feedback.GetPacketStatusCount());
+  packet_results->reserve(feedback.GetPacketStatusCount());
 
   size_t failed_lookups = 0;
   size_t ignored = 0;
@@ -217,23 +483,15 @@ TransportFeedbackAdapter::ProcessTransportFeedbackInner(
   for (const auto& packet : feedback.GetAllPackets()) {
     int64_t seq_num = seq_num_unwrapper_.Unwrap(packet.sequence_number());
 
-    if (seq_num > last_ack_seq_num_) {
-      // Starts at history_.begin() if last_ack_seq_num_ < 0, since any valid
-      // sequence number is >= 0.
-      for (auto it = history_.upper_bound(last_ack_seq_num_);
-           it != history_.upper_bound(seq_num); ++it) {
-        in_flight_.RemoveInFlightPacketBytes(it->second);
-      }
-      last_ack_seq_num_ = seq_num;
-    }
+    AcknowledgeUpTo(seq_num);
 
-    auto it = history_.find(seq_num);
-    if (it == history_.end()) {
+    const PacketFeedback* sent_packet = FindInHistory(seq_num);
+    if (!sent_packet) {
       ++failed_lookups;
       continue;
     }
 
-    if (it->second.sent.send_time.IsInfinite()) {
+    if (sent_packet->sent.send_time.IsInfinite()) {
       // TODO(srte): Fix the tests that makes this happen and make this a
       // DCHECK.
       RTC_DLOG(LS_ERROR)
@@ -241,23 +499,24 @@ TransportFeedbackAdapter::ProcessTransportFeedbackInner(
       continue;
     }
 
-    PacketFeedback packet_feedback = it->second;
+    Timestamp receive_time = sent_packet->receive_time;
     if (packet.received()) {
       packet_offset += packet.delta();
-      packet_feedback.receive_time =
+      receive_time =
           current_offset_ + packet_offset.RoundDownTo(TimeDelta::Millis(1));
-      // Note: Lost packets are not removed from history because they might be
-      // reported as received by a later feedback.
-      history_.erase(it);
     }
-    if (packet_feedback.network_route == network_route_) {
+    if (sent_packet->network_route == network_route_) {
       PacketResult result;
-      result.sent_packet = packet_feedback.sent;
-      result.receive_time = packet_feedback.receive_time;
-      packet_result_vector.push_back(result);
+      result.sent_packet = sent_packet->sent;
+      result.receive_time = receive_time;
+      packet_results->push_back(result);
     } else {
       ++ignored;
     }
+    // Note: Lost packets are not removed from history because they might be
+    // reported as received by a later feedback.
+    if (packet.received())
+      EraseFromHistory(seq_num);
   }
 
   if (failed_lookups > 0) {
@@ -269,8 +528,6 @@ TransportFeedbackAdapter::ProcessTransportFeedbackInner(
     RTC_LOG(LS_INFO) << "Ignoring " << ignored
                      << " packets because they were sent on a different route.";
   }
-
-  return packet_result_vector;
 }
 
 }  // namespace webrtc
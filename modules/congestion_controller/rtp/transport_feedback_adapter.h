@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "api/transport/network_types.h"
+#include "modules/congestion_controller/rtp/sequence_indexed_buffer.h"
 #include "modules/include/module_common_types_public.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "rtc_base/critical_section.h"
@@ -40,15 +41,24 @@ struct PacketFeedback {
 
   // The network route that this packet is associated with.
   rtc::NetworkRoute network_route;
+
+  // SSRC and RTP sequence number the packet was sent with, used to look up
+  // packets reported by RFC 8888 congestion control feedback.
+  uint32_t rtp_ssrc = 0;
+  uint16_t rtp_sequence_number = 0;
 };
 
 namespace rtcp {
+  class CongestionControlFeedback;
   class TransportFeedback;
   class App;
 }  // namespace rtcp
 
+// Bytes in flight per network route. Packets are almost always sent and
+// acknowledged on the current route, so its bytes are kept outside of the map.
 class InFlightBytesTracker {
  public:
+  void SetCurrentRoute(const rtc::NetworkRoute& network_route);
   void AddInFlightPacketBytes(const PacketFeedback& packet);
   void RemoveInFlightPacketBytes(const PacketFeedback& packet);
   DataSize GetOutstandingData(const rtc::NetworkRoute& network_route) const;
@@ -58,6 +68,11 @@ class InFlightBytesTracker {
     bool operator()(const rtc::NetworkRoute& a,
                     const rtc::NetworkRoute& b) const;
   };
+  bool IsCurrentRoute(const rtc::NetworkRoute& network_route) const;
+
+  rtc::NetworkRoute current_route_;
+  DataSize current_route_in_flight_ = DataSize::Zero();
+  // Other routes with data in flight.
   std::map<rtc::NetworkRoute, DataSize, NetworkRouteComparator> in_flight_data_;
 };
 
@@ -75,6 +90,10 @@ class TransportFeedbackAdapter {
       const rtcp::TransportFeedback& feedback,
       Timestamp feedback_receive_time);
 
+  absl::optional<TransportPacketsFeedback> ProcessCongestionControlFeedback(
+      const rtcp::CongestionControlFeedback& feedback,
+      Timestamp feedback_receive_time);
+
   void SetNetworkRoute(const rtc::NetworkRoute& network_route);
 
   DataSize GetOutstandingData() const;
@@ -82,15 +101,44 @@ class TransportFeedbackAdapter {
  private:
   enum class SendTimeHistoryStatus { kNotAdded, kOk, kDuplicate };
 
-  std::vector<PacketResult> ProcessTransportFeedbackInner(
-      const rtcp::TransportFeedback& feedback,
-      Timestamp feedback_receive_time);
+  // Unwrapped transport sequence numbers of the packets in |history_| sent
+  // with an SSRC, indexed by unwrapped RTP sequence number.
+  struct RtpSequenceNumberIndex {
+    SequenceNumberUnwrapper unwrapper;
+    SequenceIndexedBuffer<int64_t> transport_sequence_numbers;
+  };
+
+  void ProcessTransportFeedbackInner(const rtcp::TransportFeedback& feedback,
+                                     Timestamp feedback_receive_time,
+                                     std::vector<PacketResult>* packet_results);
+
+  // Removes the packets in (last_ack_seq_num_, seq_num] from the bytes in
+  // flight and advances |last_ack_seq_num_|.
+  void AcknowledgeUpTo(int64_t seq_num);
+
+  RtpSequenceNumberIndex* FindRtpSequenceNumberIndex(uint32_t ssrc);
+
+  PacketFeedback* FindInHistory(int64_t seq_num);
+  // Removes |seq_num| from the history and from the RTP sequence number index.
+  void EraseFromHistory(int64_t seq_num);
+  // Moves the packets up to |last_ack_seq_num_| that are left in |history_|
+  // to |lost_history_|.
+  void MoveLostPacketsOutOfHistory();
 
   DataSize pending_untracked_size_ = DataSize::Zero();
   Timestamp last_send_time_ = Timestamp::MinusInfinity();
   Timestamp last_untracked_send_time_ = Timestamp::MinusInfinity();
   SequenceNumberUnwrapper seq_num_unwrapper_;
-  std::map<int64_t, PacketFeedback> history_;
+  // Sent packets, indexed by unwrapped transport sequence number.
+  SequenceIndexedBuffer<PacketFeedback> history_;
+  // Packets up to |last_ack_seq_num_| that weren't reported as received,
+  // mostly lost ones. They are few but kept for the whole history window,
+  // which would keep |history_| large.
+  std::map<int64_t, PacketFeedback> lost_history_;
+  std::map<uint32_t, RtpSequenceNumberIndex> rtp_seq_num_indexes_;
+  // Transport sequence number and index of the packets reported by a
+  // congestion control feedback, reused between reports.
+  std::vector<std::pair<int64_t, size_t>> reported_packets_;
 
   // Sequence numbers are never negative, using -1 as it always < a real
   // sequence number.
@@ -100,6 +148,12 @@ class TransportFeedbackAdapter {
   Timestamp current_offset_ = Timestamp::MinusInfinity();
   TimeDelta last_timestamp_ = TimeDelta::MinusInfinity();
 
+  // Time base of congestion control feedback, selected on the first report,
+  // and the report timestamp in 1/65536 s relative to it.
+  Timestamp report_time_base_ = Timestamp::MinusInfinity();
+  absl::optional<uint32_t> last_report_timestamp_compact_ntp_;
+  int64_t report_time_units_ = 0;
+
   rtc::NetworkRoute network_route_;
 };
 
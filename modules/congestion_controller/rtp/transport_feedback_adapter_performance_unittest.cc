@@ -0,0 +1,210 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Feeds TransportFeedbackAdapter one hour of synthetic traffic: packets are
+// sent at a constant rate, 1% of them are lost, and every 50 ms all packets
+// sent since the previous report are reported, either with transport-wide
+// feedback or with RFC 8888 congestion control feedback. Only the time spent
+// in the adapter is measured, not building the feedback.
+
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/congestion_controller/rtp/transport_feedback_adapter.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/congestion_control_feedback.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+#include "rtc_base/network/sent_packet.h"
+#include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr TimeDelta kTraceDuration = TimeDelta::Seconds(3600);
+constexpr TimeDelta kFeedbackInterval = TimeDelta::Millis(50);
+constexpr TimeDelta kPropagationDelay = TimeDelta::Millis(30);
+constexpr size_t kPacketSize = 1200;
+constexpr double kLossRate = 0.01;
+// Roughly 5, 20 and 50 Mbps.
+constexpr int kPacketRates[] = {500, 2000, 5000};
+// Every tenth packet is audio, sent with its own SSRC.
+constexpr uint32_t kVideoSsrc = 1234;
+constexpr uint32_t kAudioSsrc = 5678;
+
+enum class FeedbackFormat { kTransportFeedback, kCongestionControlFeedback };
+
+struct TracePacket {
+  uint16_t transport_sequence_number = 0;
+  uint32_t ssrc = 0;
+  uint16_t rtp_sequence_number = 0;
+  Timestamp send_time = Timestamp::MinusInfinity();
+  bool received = false;
+};
+
+struct TraceResult {
+  int64_t num_packets = 0;
+  int64_t num_reported = 0;
+  int64_t send_time_ns = 0;
+  int64_t feedback_time_ns = 0;
+};
+
+rtcp::TransportFeedback CreateTransportFeedback(
+    const std::vector<TracePacket>& packets) {
+  rtcp::TransportFeedback feedback;
+  feedback.SetBase(packets.front().transport_sequence_number,
+                   (packets.front().send_time + kPropagationDelay).us());
+  for (const TracePacket& packet : packets) {
+    if (packet.received) {
+      feedback.AddReceivedPacket(packet.transport_sequence_number,
+                                 (packet.send_time + kPropagationDelay).us());
+    }
+  }
+  return feedback;
+}
+
+rtcp::CongestionControlFeedback CreateCongestionControlFeedback(
+    const std::vector<TracePacket>& packets,
+    Timestamp report_time) {
+  std::vector<rtcp::CongestionControlFeedback::PacketInfo> infos;
+  infos.reserve(packets.size());
+  // Grouped by SSRC, like report blocks.
+  for (uint32_t ssrc : {kVideoSsrc, kAudioSsrc}) {
+    for (const TracePacket& packet : packets) {
+      if (packet.ssrc != ssrc)
+        continue;
+      rtcp::CongestionControlFeedback::PacketInfo info;
+      info.ssrc = packet.ssrc;
+      info.sequence_number = packet.rtp_sequence_number;
+      if (packet.received) {
+        info.arrival_time_offset =
+            report_time - (packet.send_time + kPropagationDelay);
+      }
+      infos.push_back(info);
+    }
+  }
+  return rtcp::CongestionControlFeedback(
+      std::move(infos), static_cast<uint32_t>(report_time.us() * 65536 /
+                                              rtc::kNumMicrosecsPerSec));
+}
+
+TraceResult RunTrace(int packets_per_second, FeedbackFormat format) {
+  TraceResult result;
+  TransportFeedbackAdapter adapter;
+  Random random(0x5eed);
+  const TimeDelta send_interval = TimeDelta::Seconds(1) / packets_per_second;
+  Timestamp now = Timestamp::Seconds(1);
+  const Timestamp end_time = now + kTraceDuration;
+  uint16_t transport_sequence_number = 0;
+  uint16_t video_sequence_number = 0;
+  uint16_t audio_sequence_number = 0;
+  std::vector<TracePacket> packets;
+
+  while (now < end_time) {
+    const Timestamp report_time = now + kFeedbackInterval;
+    packets.clear();
+    for (Timestamp send_time = now; send_time < report_time;
+         send_time += send_interval) {
+      TracePacket packet;
+      packet.transport_sequence_number = transport_sequence_number++;
+      if (packet.transport_sequence_number % 10 == 0) {
+        packet.ssrc = kAudioSsrc;
+        packet.rtp_sequence_number = audio_sequence_number++;
+      } else {
+        packet.ssrc = kVideoSsrc;
+        packet.rtp_sequence_number = video_sequence_number++;
+      }
+      packet.send_time = send_time;
+      packet.received = random.Rand<double>() >= kLossRate;
+      packets.push_back(packet);
+    }
+
+    int64_t start_ns = rtc::TimeNanos();
+    for (const TracePacket& packet : packets) {
+      RtpPacketSendInfo packet_info;
+      packet_info.transport_sequence_number = packet.transport_sequence_number;
+      packet_info.ssrc = packet.ssrc;
+      packet_info.rtp_ssrc = packet.ssrc;
+      packet_info.rtp_sequence_number = packet.rtp_sequence_number;
+      packet_info.length = kPacketSize;
+      packet_info.packet_type = packet.ssrc == kAudioSsrc
+                                    ? RtpPacketMediaType::kAudio
+                                    : RtpPacketMediaType::kVideo;
+      adapter.AddPacket(packet_info, 0, packet.send_time);
+      adapter.ProcessSentPacket(rtc::SentPacket(
+          packet.transport_sequence_number, packet.send_time.ms()));
+    }
+    result.send_time_ns += rtc::TimeNanos() - start_ns;
+    result.num_packets += packets.size();
+
+    absl::optional<TransportPacketsFeedback> feedback;
+    if (format == FeedbackFormat::kTransportFeedback) {
+      rtcp::TransportFeedback rtcp_feedback = CreateTransportFeedback(packets);
+      start_ns = rtc::TimeNanos();
+      feedback = adapter.ProcessTransportFeedback(rtcp_feedback, report_time);
+      result.feedback_time_ns += rtc::TimeNanos() - start_ns;
+    } else {
+      rtcp::CongestionControlFeedback rtcp_feedback =
+          CreateCongestionControlFeedback(packets, report_time);
+      start_ns = rtc::TimeNanos();
+      feedback =
+          adapter.ProcessCongestionControlFeedback(rtcp_feedback, report_time);
+      result.feedback_time_ns += rtc::TimeNanos() - start_ns;
+    }
+    if (feedback)
+      result.num_reported += feedback->packet_feedbacks.size();
+    now = report_time;
+  }
+  EXPECT_NEAR(result.num_reported, result.num_packets,
+              result.num_packets * 0.001);
+  return result;
+}
+
+void PrintResults(int packets_per_second,
+                  FeedbackFormat format,
+                  const TraceResult& result) {
+  const std::string story =
+      std::string(format == FeedbackFormat::kTransportFeedback ? "twcc"
+                                                                : "ccfb") +
+      "_" + std::to_string(packets_per_second) + "_packets_per_second";
+  webrtc::test::PrintResult(
+      "send_time_per_packet", "", story,
+      static_cast<double>(result.send_time_ns) / result.num_packets, "ns",
+      false, webrtc::test::ImproveDirection::kSmallerIsBetter);
+  webrtc::test::PrintResult(
+      "feedback_time_per_packet", "", story,
+      static_cast<double>(result.feedback_time_ns) / result.num_packets, "ns",
+      false, webrtc::test::ImproveDirection::kSmallerIsBetter);
+  webrtc::test::PrintResult(
+      "adapter_time_per_hour", "", story,
+      (result.send_time_ns + result.feedback_time_ns) / 1e9, "s", false,
+      webrtc::test::ImproveDirection::kSmallerIsBetter);
+}
+
+}  // namespace
+
+TEST(TransportFeedbackAdapterPerformanceTest, OneHourTrace) {
+  for (int packets_per_second : kPacketRates) {
+    for (FeedbackFormat format : {FeedbackFormat::kTransportFeedback,
+                                  FeedbackFormat::kCongestionControlFeedback}) {
+      PrintResults(packets_per_second, format,
+                   RunTrace(packets_per_second, format));
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/congestion_control_feedback.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_conversions.h"
@@ -104,12 +105,15 @@ class TransportFeedbackAdapterTest : public ::testing::Test {
                                     int64_t rtt,
                                     int64_t now_ms) {}
 
-  void OnSentPacket(const PacketResult& packet_feedback) {
+  void OnSentPacket(const PacketResult& packet_feedback,
+                    uint32_t ssrc = kSsrc) {
     RtpPacketSendInfo packet_info;
-    packet_info.ssrc = kSsrc;
+    packet_info.ssrc = ssrc;
     packet_info.transport_sequence_number =
         packet_feedback.sent_packet.sequence_number;
-    packet_info.rtp_sequence_number = 0;
+    packet_info.rtp_ssrc = ssrc;
+    packet_info.rtp_sequence_number =
+        static_cast<uint16_t>(packet_feedback.sent_packet.sequence_number);
     packet_info.length = packet_feedback.sent_packet.size.bytes();
     packet_info.pacing_info = packet_feedback.sent_packet.pacing_info;
     packet_info.packet_type = RtpPacketMediaType::kVideo;
@@ -410,6 +414,200 @@ TEST_F(TransportFeedbackAdapterTest, IgnoreDuplicatePacketSentCalls) {
   EXPECT_FALSE(duplicate_packet.has_value());
 }
 
+TEST_F(TransportFeedbackAdapterTest, AdaptsCongestionControlFeedback) {
+  // Arrival times are before the report, keep them non-negative.
+  clock_.AdvanceTimeMilliseconds(1000);
+  std::vector<PacketResult> packets;
+  packets.push_back(CreatePacket(100, 200, 0, 1500, kPacingInfo0));
+  packets.push_back(CreatePacket(110, 210, 1, 1500, kPacingInfo0));
+  packets.push_back(CreatePacket(120, 220, 2, 1500, kPacingInfo0));
+  packets.push_back(CreatePacket(130, 230, 3, 1500, kPacingInfo1));
+  for (const auto& packet : packets)
+    OnSentPacket(packet);
+
+  // Packet 1 is reported lost, the others as received 10 ms apart.
+  std::vector<rtcp::CongestionControlFeedback::PacketInfo> reports(4);
+  for (int i = 0; i < 4; ++i) {
+    reports[i].ssrc = kSsrc;
+    reports[i].sequence_number = i;
+    reports[i].arrival_time_offset = TimeDelta::Millis(30 - 10 * i);
+  }
+  reports[1].arrival_time_offset = TimeDelta::MinusInfinity();
+  reports[2].ecn = rtc::EcnMarking::kCe;
+  rtcp::CongestionControlFeedback feedback(reports, 0x10000);
+
+  auto result = adapter_->ProcessCongestionControlFeedback(
+      feedback, clock_.CurrentTime());
+  ASSERT_TRUE(result);
+  ASSERT_EQ(result->packet_feedbacks.size(), 4u);
+  EXPECT_TRUE(result->packet_feedbacks[1].receive_time.IsPlusInfinity());
+  ComparePacketFeedbackVectors(packets, result->packet_feedbacks);
+  EXPECT_EQ(result->packet_feedbacks[0].ecn, rtc::EcnMarking::kNotEct);
+  EXPECT_EQ(result->packet_feedbacks[2].ecn, rtc::EcnMarking::kCe);
+
+  // A report half a second later says packet 1 arrived 100 ms before it.
+  std::vector<rtcp::CongestionControlFeedback::PacketInfo> late_report(1);
+  late_report[0].ssrc = kSsrc;
+  late_report[0].sequence_number = 1;
+  late_report[0].arrival_time_offset = TimeDelta::Millis(100);
+  result = adapter_->ProcessCongestionControlFeedback(
+      rtcp::CongestionControlFeedback(late_report, 0x10000 + 0x8000),
+      clock_.CurrentTime());
+  ASSERT_TRUE(result);
+  ASSERT_EQ(result->packet_feedbacks.size(), 1u);
+  EXPECT_EQ(result->packet_feedbacks[0].sent_packet.sequence_number, 1);
+  EXPECT_EQ(result->packet_feedbacks[0].receive_time,
+            clock_.CurrentTime() + TimeDelta::Millis(400));
+  EXPECT_EQ(adapter_->GetOutstandingData(), DataSize::Zero());
+}
+
+TEST_F(TransportFeedbackAdapterTest,
+       CongestionControlFeedbackIgnoresUnknownPackets) {
+  OnSentPacket(CreatePacket(100, 200, 0, 1500, kPacingInfo0));
+
+  std::vector<rtcp::CongestionControlFeedback::PacketInfo> reports(1);
+  reports[0].ssrc = kSsrc + 1;
+  reports[0].sequence_number = 0;
+  reports[0].arrival_time_offset = TimeDelta::Zero();
+  EXPECT_FALSE(adapter_->ProcessCongestionControlFeedback(
+      rtcp::CongestionControlFeedback(reports, 0), clock_.CurrentTime()));
+  EXPECT_EQ(adapter_->GetOutstandingData(), DataSize::Bytes(1500));
+}
+
+TEST_F(TransportFeedbackAdapterTest,
+       CongestionControlFeedbackHandlesDuplicatedBlocks) {
+  clock_.AdvanceTimeMilliseconds(1000);
+  std::vector<PacketResult> packets;
+  packets.push_back(CreatePacket(100, 200, 0, 1500, kPacingInfo0));
+  packets.push_back(CreatePacket(110, 210, 1, 1500, kPacingInfo0));
+  packets.push_back(CreatePacket(120, 220, 2, 1500, kPacingInfo0));
+  for (const auto& packet : packets)
+    OnSentPacket(packet);
+
+  // The same block twice, except that the first copy reports packet 1 lost.
+  std::vector<rtcp::CongestionControlFeedback::PacketInfo> reports(6);
+  for (int i = 0; i < 6; ++i) {
+    reports[i].ssrc = kSsrc;
+    reports[i].sequence_number = i % 3;
+    reports[i].arrival_time_offset = TimeDelta::Millis(20 - 10 * (i % 3));
+  }
+  reports[1].arrival_time_offset = TimeDelta::MinusInfinity();
+
+  auto result = adapter_->ProcessCongestionControlFeedback(
+      rtcp::CongestionControlFeedback(reports, 0x10000), clock_.CurrentTime());
+  ASSERT_TRUE(result);
+  ASSERT_EQ(result->packet_feedbacks.size(), 3u);
+  ComparePacketFeedbackVectors(packets, result->packet_feedbacks);
+  EXPECT_EQ(adapter_->GetOutstandingData(), DataSize::Zero());
+
+  // Reports of packets that were already acknowledged are ignored.
+  EXPECT_FALSE(adapter_->ProcessCongestionControlFeedback(
+      rtcp::CongestionControlFeedback(reports, 0x10000), clock_.CurrentTime()));
+}
+
+TEST_F(TransportFeedbackAdapterTest,
+       CongestionControlFeedbackKeepsUnreportedPacketsInFlight) {
+  clock_.AdvanceTimeMilliseconds(1000);
+  // Packets of two SSRCs, alternating.
+  std::vector<PacketResult> packets;
+  for (int i = 0; i < 4; ++i) {
+    packets.push_back(
+        CreatePacket(100 + 10 * i, 200 + 10 * i, i, 1000 + i, kPacingInfo0));
+    OnSentPacket(packets.back(), kSsrc + i % 2);
+  }
+  EXPECT_EQ(adapter_->GetOutstandingData(), DataSize::Bytes(4006));
+
+  // The report is missing the second SSRC, whose packets stay in flight.
+  std::vector<rtcp::CongestionControlFeedback::PacketInfo> reports(2);
+  for (int i = 0; i < 2; ++i) {
+    reports[i].ssrc = kSsrc;
+    reports[i].sequence_number = 2 * i;
+    reports[i].arrival_time_offset = TimeDelta::Millis(20 - 10 * i);
+  }
+  auto result = adapter_->ProcessCongestionControlFeedback(
+      rtcp::CongestionControlFeedback(reports, 0x10000), clock_.CurrentTime());
+  ASSERT_TRUE(result);
+  ASSERT_EQ(result->packet_feedbacks.size(), 2u);
+  EXPECT_EQ(result->prior_in_flight, DataSize::Bytes(4006));
+  EXPECT_EQ(result->data_in_flight, DataSize::Bytes(1001 + 1003));
+
+  for (int i = 0; i < 2; ++i) {
+    reports[i].ssrc = kSsrc + 1;
+    reports[i].sequence_number = 2 * i + 1;
+  }
+  result = adapter_->ProcessCongestionControlFeedback(
+      rtcp::CongestionControlFeedback(reports, 0x10000), clock_.CurrentTime());
+  ASSERT_TRUE(result);
+  ASSERT_EQ(result->packet_feedbacks.size(), 2u);
+  EXPECT_EQ(result->data_in_flight, DataSize::Zero());
+}
+
+TEST_F(TransportFeedbackAdapterTest, TracksOutstandingDataPerRoute) {
+  rtc::NetworkRoute wifi_route;
+  wifi_route.connected = true;
+  wifi_route.local = rtc::RouteEndpoint(rtc::ADAPTER_TYPE_WIFI, 1, 1, false);
+  rtc::NetworkRoute cellular_route = wifi_route;
+  cellular_route.local =
+      rtc::RouteEndpoint(rtc::ADAPTER_TYPE_CELLULAR, 2, 2, false);
+
+  adapter_->SetNetworkRoute(wifi_route);
+  OnSentPacket(CreatePacket(100, 200, 0, 1500, kPacingInfo0));
+  adapter_->SetNetworkRoute(cellular_route);
+  EXPECT_EQ(adapter_->GetOutstandingData(), DataSize::Zero());
+  OnSentPacket(CreatePacket(110, 210, 1, 1000, kPacingInfo0));
+  EXPECT_EQ(adapter_->GetOutstandingData(), DataSize::Bytes(1000));
+  adapter_->SetNetworkRoute(wifi_route);
+  EXPECT_EQ(adapter_->GetOutstandingData(), DataSize::Bytes(1500));
+
+  // Acknowledging both packets empties both routes.
+  rtcp::TransportFeedback feedback;
+  feedback.SetBase(0, 100000);
+  EXPECT_TRUE(feedback.AddReceivedPacket(0, 100000));
+  EXPECT_TRUE(feedback.AddReceivedPacket(1, 110000));
+  feedback.Build();
+  auto result =
+      adapter_->ProcessTransportFeedback(feedback, clock_.CurrentTime());
+  ASSERT_TRUE(result);
+  EXPECT_EQ(result->prior_in_flight, DataSize::Bytes(1500));
+  EXPECT_EQ(adapter_->GetOutstandingData(), DataSize::Zero());
+  adapter_->SetNetworkRoute(cellular_route);
+  EXPECT_EQ(adapter_->GetOutstandingData(), DataSize::Zero());
+}
+
+TEST_F(TransportFeedbackAdapterTest, LostPacketCanBeReportedReceivedLater) {
+  std::vector<PacketResult> packets = {
+      CreatePacket(100, 200, 0, 1500, kPacingInfo0),
+      CreatePacket(110, 210, 1, 1500, kPacingInfo0),
+      CreatePacket(120, 220, 2, 1500, kPacingInfo0)};
+  for (const auto& packet : packets)
+    OnSentPacket(packet);
+
+  rtcp::TransportFeedback feedback;
+  feedback.SetBase(0, packets[0].receive_time.us());
+  EXPECT_TRUE(feedback.AddReceivedPacket(0, packets[0].receive_time.us()));
+  EXPECT_TRUE(feedback.AddReceivedPacket(2, packets[2].receive_time.us()));
+  feedback.Build();
+  auto result =
+      adapter_->ProcessTransportFeedback(feedback, clock_.CurrentTime());
+  ASSERT_TRUE(result);
+  ASSERT_EQ(result->packet_feedbacks.size(), 3u);
+  EXPECT_TRUE(result->packet_feedbacks[1].receive_time.IsPlusInfinity());
+
+  rtcp::TransportFeedback late_feedback;
+  late_feedback.SetBase(1, packets[1].receive_time.us());
+  EXPECT_TRUE(
+      late_feedback.AddReceivedPacket(1, packets[1].receive_time.us()));
+  late_feedback.Build();
+  result =
+      adapter_->ProcessTransportFeedback(late_feedback, clock_.CurrentTime());
+  ASSERT_TRUE(result);
+  ASSERT_EQ(result->packet_feedbacks.size(), 1u);
+  EXPECT_EQ(result->packet_feedbacks[0].sent_packet.sequence_number, 1);
+  EXPECT_TRUE(result->packet_feedbacks[0].receive_time.IsFinite());
+  EXPECT_EQ(result->packet_feedbacks[0].sent_packet.send_time,
+            packets[1].sent_packet.send_time);
+}
+
 }  // namespace test
 }  // namespace webrtc_cc
 }  // namespace webrtc
@@ -0,0 +1,32 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_NN_COMMON_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_NN_COMMON_H_
+
+#include <stddef.h>
+
+namespace webrtc {
+namespace bwe_nn {
+
+// Weights and activations are aligned to this many bytes, enough for aligned
+// AVX loads.
+constexpr size_t kAlignmentBytes = 32;
+constexpr size_t kAlignmentFloats = kAlignmentBytes / sizeof(float);
+
+enum class Optimization { kNone, kSse2, kAvx2 };
+
+// Detects what kind of optimizations to use for the code.
+Optimization DetectOptimization();
+
+}  // namespace bwe_nn
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_NN_COMMON_H_
@@ -0,0 +1,1741 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/bwe_nn/inference_session.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <set>
+#include <utility>
+
+#include "modules/remote_bitrate_estimator/bwe_nn/kernels.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/random.h"
+
+namespace webrtc {
+namespace bwe_nn {
+
+class InferenceSession::Operation {
+ public:
+  virtual ~Operation() = default;
+  virtual void Run() = 0;
+};
+
+namespace {
+
+// TensorProto::DataType.
+constexpr int64_t kDataTypeFloat = 1;
+constexpr int64_t kDataTypeDouble = 11;
+
+using Dims = std::vector<int64_t>;
+
+size_t NumElements(const Dims& dims) {
+  size_t num_elements = 1;
+  for (int64_t dim : dims)
+    num_elements *= static_cast<size_t>(dim);
+  return num_elements;
+}
+
+// Elements between consecutive indices of each dimension, row major.
+std::vector<size_t> Strides(const Dims& dims) {
+  std::vector<size_t> strides(dims.size());
+  size_t stride = 1;
+  for (size_t d = dims.size(); d-- > 0;) {
+    strides[d] = stride;
+    stride *= static_cast<size_t>(dims[d]);
+  }
+  return strides;
+}
+
+// Resolves a negative |axis| counting from the back. Returns false if |axis|
+// is out of range for |rank| dimensions.
+bool NormalizeAxis(int64_t axis, size_t rank, size_t* normalized) {
+  const int64_t signed_rank = static_cast<int64_t>(rank);
+  if (axis < -signed_rank || axis >= signed_rank)
+    return false;
+  *normalized = static_cast<size_t>(axis < 0 ? axis + signed_rank : axis);
+  return true;
+}
+
+float Sigmoid(float x) {
+  return 1.f / (1.f + std::exp(-x));
+}
+
+template <typename T>
+void SliceCopy(const T* input,
+               const Dims& input_dims,
+               const Dims& starts,
+               const Dims& steps,
+               const Dims& output_dims,
+               T* output) {
+  const size_t rank = input_dims.size();
+  const std::vector<size_t> strides = Strides(input_dims);
+  const size_t num_elements = NumElements(output_dims);
+  Dims index(rank, 0);
+  for (size_t i = 0; i < num_elements; ++i) {
+    size_t offset = 0;
+    for (size_t d = 0; d < rank; ++d)
+      offset += static_cast<size_t>(starts[d] + index[d] * steps[d]) *
+                strides[d];
+    output[i] = input[offset];
+    for (size_t d = rank; d-- > 0;) {
+      if (++index[d] < output_dims[d])
+        break;
+      index[d] = 0;
+    }
+  }
+}
+
+// Copies |outer| chunks from every input in turn.
+template <typename T>
+void ConcatCopy(const std::vector<const T*>& inputs,
+                const std::vector<size_t>& chunk_sizes,
+                size_t outer,
+                T* output) {
+  for (size_t o = 0; o < outer; ++o) {
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      const T* chunk = inputs[i] + o * chunk_sizes[i];
+      output = std::copy(chunk, chunk + chunk_sizes[i], output);
+    }
+  }
+}
+
+// Strides of |input_dims| for indexing with an index of |output_dims|, which
+// |input_dims| is broadcast to. Broadcast dimensions have a stride of 0.
+std::vector<size_t> BroadcastStrides(const Dims& input_dims,
+                                     const Dims& output_dims) {
+  std::vector<size_t> strides(output_dims.size(), 0);
+  const std::vector<size_t> input_strides = Strides(input_dims);
+  const size_t offset = output_dims.size() - input_dims.size();
+  for (size_t d = 0; d < input_dims.size(); ++d) {
+    if (input_dims[d] != 1)
+      strides[offset + d] = input_strides[d];
+  }
+  return strides;
+}
+
+bool BroadcastDims(const Dims& a, const Dims& b, Dims* output) {
+  const size_t rank = std::max(a.size(), b.size());
+  output->assign(rank, 1);
+  for (size_t d = 0; d < rank; ++d) {
+    const int64_t a_dim = d < rank - a.size() ? 1 : a[d - (rank - a.size())];
+    const int64_t b_dim = d < rank - b.size() ? 1 : b[d - (rank - b.size())];
+    if (a_dim != b_dim && a_dim != 1 && b_dim != 1)
+      return false;
+    (*output)[d] = a_dim == 1 ? b_dim : a_dim;
+  }
+  return true;
+}
+
+enum class BinaryKind { kAdd, kSub, kMul, kDiv };
+
+template <typename T>
+T ApplyBinary(BinaryKind kind, T a, T b) {
+  switch (kind) {
+    case BinaryKind::kAdd:
+      return a + b;
+    case BinaryKind::kSub:
+      return a - b;
+    case BinaryKind::kMul:
+      return a * b;
+    case BinaryKind::kDiv:
+      return b == 0 && std::numeric_limits<T>::is_integer ? 0 : a / b;
+  }
+  RTC_NOTREACHED();
+  return a;
+}
+
+template <typename T>
+void BroadcastBinary(BinaryKind kind,
+                     const T* a,
+                     const std::vector<size_t>& a_strides,
+                     const T* b,
+                     const std::vector<size_t>& b_strides,
+                     const Dims& output_dims,
+                     T* output) {
+  const size_t rank = output_dims.size();
+  const size_t num_elements = NumElements(output_dims);
+  Dims index(rank, 0);
+  size_t a_offset = 0;
+  size_t b_offset = 0;
+  for (size_t i = 0; i < num_elements; ++i) {
+    output[i] = ApplyBinary(kind, a[a_offset], b[b_offset]);
+    for (size_t d = rank; d-- > 0;) {
+      a_offset += a_strides[d];
+      b_offset += b_strides[d];
+      if (++index[d] < output_dims[d])
+        break;
+      a_offset -= a_strides[d] * index[d];
+      b_offset -= b_strides[d] * index[d];
+      index[d] = 0;
+    }
+  }
+}
+
+enum class UnaryKind { kRelu, kLeakyRelu, kTanh, kSigmoid, kClip };
+
+struct UnaryParameters {
+  UnaryKind kind;
+  // Slope of LeakyRelu, or the lower bound of Clip.
+  float alpha = 0.f;
+  // The upper bound of Clip.
+  float beta = 0.f;
+};
+
+void ApplyUnary(const UnaryParameters& parameters,
+                const float* input,
+                size_t size,
+                float* output) {
+  switch (parameters.kind) {
+    case UnaryKind::kRelu:
+      for (size_t i = 0; i < size; ++i)
+        output[i] = std::max(input[i], 0.f);
+      break;
+    case UnaryKind::kLeakyRelu:
+      for (size_t i = 0; i < size; ++i)
+        output[i] = input[i] < 0.f ? parameters.alpha * input[i] : input[i];
+      break;
+    case UnaryKind::kTanh:
+      for (size_t i = 0; i < size; ++i)
+        output[i] = std::tanh(input[i]);
+      break;
+    case UnaryKind::kSigmoid:
+      for (size_t i = 0; i < size; ++i)
+        output[i] = Sigmoid(input[i]);
+      break;
+    case UnaryKind::kClip:
+      for (size_t i = 0; i < size; ++i)
+        output[i] = std::min(std::max(input[i], parameters.alpha),
+                             parameters.beta);
+      break;
+  }
+}
+
+class SliceOperation : public InferenceSession::Operation {
+ public:
+  SliceOperation(const float* input,
+                 Dims input_dims,
+                 Dims starts,
+                 Dims steps,
+                 Dims output_dims,
+                 float* output)
+      : input_(input),
+        input_dims_(std::move(input_dims)),
+        starts_(std::move(starts)),
+        steps_(std::move(steps)),
+        output_dims_(std::move(output_dims)),
+        output_(output) {}
+  void Run() override {
+    SliceCopy(input_, input_dims_, starts_, steps_, output_dims_, output_);
+  }
+
+ private:
+  const float* const input_;
+  const Dims input_dims_;
+  const Dims starts_;
+  const Dims steps_;
+  const Dims output_dims_;
+  float* const output_;
+};
+
+class ConcatOperation : public InferenceSession::Operation {
+ public:
+  ConcatOperation(std::vector<const float*> inputs,
+                  std::vector<size_t> chunk_sizes,
+                  size_t outer,
+                  float* output)
+      : inputs_(std::move(inputs)),
+        chunk_sizes_(std::move(chunk_sizes)),
+        outer_(outer),
+        output_(output) {}
+  void Run() override { ConcatCopy(inputs_, chunk_sizes_, outer_, output_); }
+
+ private:
+  const std::vector<const float*> inputs_;
+  const std::vector<size_t> chunk_sizes_;
+  const size_t outer_;
+  float* const output_;
+};
+
+class BinaryOperation : public InferenceSession::Operation {
+ public:
+  BinaryOperation(BinaryKind kind,
+                  const float* a,
+                  Dims a_dims,
+                  const float* b,
+                  Dims b_dims,
+                  Dims output_dims,
+                  float* output)
+      : kind_(kind),
+        a_(a),
+        b_(b),
+        a_size_(NumElements(a_dims)),
+        b_size_(NumElements(b_dims)),
+        size_(NumElements(output_dims)),
+        a_strides_(BroadcastStrides(a_dims, output_dims)),
+        b_strides_(BroadcastStrides(b_dims, output_dims)),
+        output_dims_(std::move(output_dims)),
+        output_(output) {}
+  void Run() override {
+    if (a_size_ == size_ && b_size_ == size_) {
+      for (size_t i = 0; i < size_; ++i)
+        output_[i] = ApplyBinary(kind_, a_[i], b_[i]);
+    } else if (a_size_ == size_ && b_size_ == 1) {
+      const float b = b_[0];
+      for (size_t i = 0; i < size_; ++i)
+        output_[i] = ApplyBinary(kind_, a_[i], b);
+    } else if (a_size_ == 1 && b_size_ == size_) {
+      const float a = a_[0];
+      for (size_t i = 0; i < size_; ++i)
+        output_[i] = ApplyBinary(kind_, a, b_[i]);
+    } else {
+      BroadcastBinary(kind_, a_, a_strides_, b_, b_strides_, output_dims_,
+                      output_);
+    }
+  }
+
+ private:
+  const BinaryKind kind_;
+  const float* const a_;
+  const float* const b_;
+  const size_t a_size_;
+  const size_t b_size_;
+  const size_t size_;
+  const std::vector<size_t> a_strides_;
+  const std::vector<size_t> b_strides_;
+  const Dims output_dims_;
+  float* const output_;
+};
+
+class UnaryOperation : public InferenceSession::Operation {
+ public:
+  UnaryOperation(const UnaryParameters& parameters,
+                 const float* input,
+                 size_t size,
+                 float* output)
+      : parameters_(parameters), input_(input), size_(size), output_(output) {}
+  void Run() override { ApplyUnary(parameters_, input_, size_, output_); }
+
+ private:
+  const UnaryParameters parameters_;
+  const float* const input_;
+  const size_t size_;
+  float* const output_;
+};
+
+// Computes |rows| rows of y = x W + b, with W packed as MatVec expects.
+class FullyConnectedOperation : public InferenceSession::Operation {
+ public:
+  FullyConnectedOperation(Optimization optimization,
+                          const float* input,
+                          size_t rows,
+                          size_t input_size,
+                          const float* weights,
+                          const float* bias,
+                          bool bias_per_row,
+                          size_t output_size,
+                          float* output)
+      : optimization_(optimization),
+        input_(input),
+        rows_(rows),
+        input_size_(input_size),
+        weights_(weights),
+        bias_(bias),
+        bias_per_row_(bias_per_row),
+        output_size_(output_size),
+        output_(output) {}
+  void Run() override {
+    const size_t stride = PackedStride(input_size_);
+    const rtc::ArrayView<const float> weights(weights_, output_size_ * stride);
+    for (size_t r = 0; r < rows_; ++r) {
+      rtc::ArrayView<const float> bias;
+      if (bias_)
+        bias = {bias_ + (bias_per_row_ ? r * output_size_ : 0), output_size_};
+      MatVec(optimization_, weights, stride, bias,
+             {input_ + r * input_size_, input_size_},
+             {output_ + r * output_size_, output_size_});
+    }
+  }
+
+ private:
+  const Optimization optimization_;
+  const float* const input_;
+  const size_t rows_;
+  const size_t input_size_;
+  const float* const weights_;
+  const float* const bias_;
+  const bool bias_per_row_;
+  const size_t output_size_;
+  float* const output_;
+};
+
+// Weights of one direction of a GRU or LSTM, packed for MatVec.
+struct RecurrentWeights {
+  size_t input_size;
+  size_t hidden_size;
+  size_t num_gates;
+  // |num_gates| * |hidden_size| rows each.
+  const float* input_weights;
+  const float* recurrent_weights;
+  const float* input_bias;
+  const float* recurrent_bias;
+};
+
+// Sizes and buffers of a GRU or LSTM run. Optional inputs and outputs are
+// null.
+struct RecurrentIo {
+  size_t sequence_length;
+  size_t batch_size;
+  const float* input;
+  const float* initial_hidden;
+  const float* initial_cell;
+  float* output;
+  float* hidden;
+  float* cell;
+};
+
+class GruOperation : public InferenceSession::Operation {
+ public:
+  GruOperation(Optimization optimization,
+               const RecurrentWeights& weights,
+               const RecurrentIo& io,
+               bool linear_before_reset,
+               float* input_gates,
+               float* recurrent_gates,
+               float* reset_hidden)
+      : optimization_(optimization),
+        weights_(weights),
+        io_(io),
+        linear_before_reset_(linear_before_reset),
+        input_gates_(input_gates),
+        recurrent_gates_(recurrent_gates),
+        reset_hidden_(reset_hidden) {}
+
+  void Run() override {
+    const size_t hidden_size = weights_.hidden_size;
+    const size_t state_size = io_.batch_size * hidden_size;
+    if (io_.initial_hidden) {
+      memcpy(io_.hidden, io_.initial_hidden, state_size * sizeof(float));
+    } else {
+      std::fill(io_.hidden, io_.hidden + state_size, 0.f);
+    }
+    for (size_t t = 0; t < io_.sequence_length; ++t) {
+      for (size_t b = 0; b < io_.batch_size; ++b) {
+        Step(io_.input + (t * io_.batch_size + b) * weights_.input_size,
+             io_.hidden + b * hidden_size);
+      }
+      if (io_.output) {
+        memcpy(io_.output + t * state_size, io_.hidden,
+               state_size * sizeof(float));
+      }
+    }
+  }
+
+ private:
+  // Gates are ordered update (z), reset (r) and hidden (h), as in ONNX.
+  void Step(const float* x, float* h) {
+    const size_t hidden_size = weights_.hidden_size;
+    const size_t input_stride = PackedStride(weights_.input_size);
+    const size_t hidden_stride = PackedStride(hidden_size);
+    const rtc::ArrayView<const float> hidden(h, hidden_size);
+    rtc::ArrayView<float> xw(input_gates_, 3 * hidden_size);
+    rtc::ArrayView<float> rh(recurrent_gates_, 3 * hidden_size);
+    MatVec(optimization_,
+           {weights_.input_weights, 3 * hidden_size * input_stride},
+           input_stride, {weights_.input_bias, 3 * hidden_size},
+           {x, weights_.input_size}, xw);
+    if (linear_before_reset_) {
+      MatVec(optimization_,
+             {weights_.recurrent_weights, 3 * hidden_size * hidden_stride},
+             hidden_stride, {weights_.recurrent_bias, 3 * hidden_size}, hidden,
+             rh);
+      for (size_t j = 0; j < hidden_size; ++j) {
+        const float z = Sigmoid(xw[j] + rh[j]);
+        const float r = Sigmoid(xw[hidden_size + j] + rh[hidden_size + j]);
+        const float candidate =
+            std::tanh(xw[2 * hidden_size + j] + r * rh[2 * hidden_size + j]);
+        h[j] = (1.f - z) * candidate + z * h[j];
+      }
+      return;
+    }
+    // The reset gate applies to the hidden state before the recurrent weights
+    // of the candidate, which need a second pass.
+    MatVec(optimization_,
+           {weights_.recurrent_weights, 2 * hidden_size * hidden_stride},
+           hidden_stride, {weights_.recurrent_bias, 2 * hidden_size}, hidden,
+           rh.subview(0, 2 * hidden_size));
+    for (size_t j = 0; j < hidden_size; ++j) {
+      rh[j] = Sigmoid(xw[j] + rh[j]);
+      reset_hidden_[j] =
+          Sigmoid(xw[hidden_size + j] + rh[hidden_size + j]) * h[j];
+    }
+    MatVec(optimization_,
+           {weights_.recurrent_weights + 2 * hidden_size * hidden_stride,
+            hidden_size * hidden_stride},
+           hidden_stride,
+           {weights_.recurrent_bias + 2 * hidden_size, hidden_size},
+           {reset_hidden_, hidden_size}, rh.subview(2 * hidden_size));
+    for (size_t j = 0; j < hidden_size; ++j) {
+      const float z = rh[j];
+      const float candidate =
+          std::tanh(xw[2 * hidden_size + j] + rh[2 * hidden_size + j]);
+      h[j] = (1.f - z) * candidate + z * h[j];
+    }
+  }
+
+  const Optimization optimization_;
+  const RecurrentWeights weights_;
+  const RecurrentIo io_;
+  const bool linear_before_reset_;
+  float* const input_gates_;
+  float* const recurrent_gates_;
+  float* const reset_hidden_;
+};
+
+class LstmOperation : public InferenceSession::Operation {
+ public:
+  // |weights.input_bias| holds the sum of both biases, |gates| has room for
+  // every gate.
+  LstmOperation(Optimization optimization,
+                const RecurrentWeights& weights,
+                const RecurrentIo& io,
+                float* gates)
+      : optimization_(optimization),
+        weights_(weights),
+        io_(io),
+        gates_(gates) {}
+
+  void Run() override {
+    const size_t hidden_size = weights_.hidden_size;
+    const size_t state_size = io_.batch_size * hidden_size;
+    if (io_.initial_hidden) {
+      memcpy(io_.hidden, io_.initial_hidden, state_size * sizeof(float));
+    } else {
+      std::fill(io_.hidden, io_.hidden + state_size, 0.f);
+    }
+    if (io_.initial_cell) {
+      memcpy(io_.cell, io_.initial_cell, state_size * sizeof(float));
+    } else {
+      std::fill(io_.cell, io_.cell + state_size, 0.f);
+    }
+    for (size_t t = 0; t < io_.sequence_length; ++t) {
+      for (size_t b = 0; b < io_.batch_size; ++b) {
+        Step(io_.input + (t * io_.batch_size + b) * weights_.input_size,
+             io_.hidden + b * hidden_size, io_.cell + b * hidden_size);
+      }
+      if (io_.output) {
+        memcpy(io_.output + t * state_size, io_.hidden,
+               state_size * sizeof(float));
+      }
+    }
+  }
+
+ private:
+  // Gates are ordered input (i), output (o), forget (f) and cell (c), as in
+  // ONNX.
+  void Step(const float* x, float* h, float* c) {
+    const size_t hidden_size = weights_.hidden_size;
+    const size_t input_stride = PackedStride(weights_.input_size);
+    const size_t hidden_stride = PackedStride(hidden_size);
+    rtc::ArrayView<float> gates(gates_, 4 * hidden_size);
+    MatVec(optimization_,
+           {weights_.input_weights, 4 * hidden_size * input_stride},
+           input_stride, {weights_.input_bias, 4 * hidden_size},
+           {x, weights_.input_size}, gates);
+    MatVec(optimization_,
+           {weights_.recurrent_weights, 4 * hidden_size * hidden_stride},
+           hidden_stride, gates, {h, hidden_size}, gates);
+    for (size_t j = 0; j < hidden_size; ++j) {
+      const float i = Sigmoid(gates[j]);
+      const float o = Sigmoid(gates[hidden_size + j]);
+      const float f = Sigmoid(gates[2 * hidden_size + j]);
+      const float candidate = std::tanh(gates[3 * hidden_size + j]);
+      c[j] = f * c[j] + i * candidate;
+      h[j] = o * std::tanh(c[j]);
+    }
+  }
+
+  const Optimization optimization_;
+  const RecurrentWeights weights_;
+  const RecurrentIo io_;
+  float* const gates_;
+};
+
+class RandomNormalOperation : public InferenceSession::Operation {
+ public:
+  RandomNormalOperation(float mean,
+                        float scale,
+                        uint64_t seed,
+                        size_t size,
+                        float* output)
+      : mean_(mean),
+        scale_(scale),
+        random_(seed),
+        size_(size),
+        output_(output) {}
+  void Run() override {
+    for (size_t i = 0; i < size_; ++i)
+      output_[i] = static_cast<float>(random_.Gaussian(mean_, scale_));
+  }
+
+ private:
+  const float mean_;
+  const float scale_;
+  Random random_;
+  const size_t size_;
+  float* const output_;
+};
+
+}  // namespace
+
+// Turns the nodes of a model into operations of a session.
+class InferenceSession::Builder {
+ public:
+  Builder(InferenceSession* session, const OnnxModel& model)
+      : session_(session), model_(model) {}
+
+  bool Build();
+
+ private:
+  struct Value {
+    Dims dims;
+    // Constants are known when the session is created. They only get a
+    // buffer if an operation reads them at run time.
+    bool constant = false;
+    bool is_int = false;
+    std::vector<float> float_data;
+    std::vector<int64_t> int_data;
+    float* data = nullptr;
+  };
+
+  bool AddNode(const OnnxNode& node);
+  bool AddConstant(const OnnxNode& node);
+  bool AddAlias(const OnnxNode& node);
+  bool AddCast(const OnnxNode& node);
+  bool AddReshape(const OnnxNode& node);
+  bool AddFlatten(const OnnxNode& node);
+  bool AddSqueeze(const OnnxNode& node);
+  bool AddUnsqueeze(const OnnxNode& node);
+  bool AddShape(const OnnxNode& node);
+  bool AddGather(const OnnxNode& node);
+  bool AddSlice(const OnnxNode& node);
+  bool AddConcat(const OnnxNode& node);
+  bool AddBinary(const OnnxNode& node, BinaryKind kind);
+  bool AddUnary(const OnnxNode& node, UnaryKind kind);
+  bool AddGemm(const OnnxNode& node);
+  bool AddMatMul(const OnnxNode& node);
+  bool AddGru(const OnnxNode& node);
+  bool AddLstm(const OnnxNode& node);
+  bool AddRandomNormalLike(const OnnxNode& node);
+
+  bool Unsupported(const OnnxNode& node, const char* reason) const;
+
+  // Returns null for inputs that are left out.
+  const Value* Input(const OnnxNode& node, size_t index) const;
+  // Returns the integers of a constant input, or of the attribute |name| if
+  // the node has it instead. Returns false if neither is available.
+  bool IntsFromInputOrAttribute(const OnnxNode& node,
+                                size_t index,
+                                const char* name,
+                                Dims* ints) const;
+  // Returns null if the output is left out.
+  Value* Output(const OnnxNode& node, size_t index);
+  // Creates an output with a buffer for run time results.
+  float* AddRuntimeOutput(const OnnxNode& node, size_t index, Dims dims);
+  // Returns the buffer of |value|, copying constants into a buffer.
+  const float* Data(const Value* value);
+
+  float* Allocate(size_t size);
+  float* PackWeights(rtc::ArrayView<const float> weights,
+                     size_t rows,
+                     size_t columns,
+                     bool transpose,
+                     float scale);
+  float* PackVector(rtc::ArrayView<const float> values);
+
+  InferenceSession* const session_;
+  const OnnxModel& model_;
+  std::map<std::string, Value> values_;
+};
+
+bool InferenceSession::Builder::Build() {
+  for (const OnnxTensor& initializer : model_.initializers) {
+    Value& value = values_[initializer.name];
+    value.dims = initializer.dims;
+    value.constant = true;
+    value.is_int = !initializer.is_float;
+    value.float_data = initializer.float_data;
+    value.int_data = initializer.int_data;
+  }
+
+  for (const OnnxValueInfo& info : model_.inputs) {
+    if (values_.count(info.name) > 0)
+      continue;
+    if (info.elem_type != kDataTypeFloat) {
+      RTC_LOG(LS_WARNING) << "Input " << info.name << " isn't float.";
+      return false;
+    }
+    Port port;
+    port.name = info.name;
+    for (int64_t dim : info.dims)
+      port.dims.push_back(dim < 0 ? 1 : dim);
+    port.size = NumElements(port.dims);
+    port.data = Allocate(port.size);
+    Value& value = values_[info.name];
+    value.dims = port.dims;
+    value.data = port.data;
+    session_->inputs_.push_back(std::move(port));
+  }
+
+  // Only nodes that the outputs depend on are run.
+  std::set<std::string> needed;
+  for (const OnnxValueInfo& info : model_.outputs)
+    needed.insert(info.name);
+  std::vector<bool> node_needed(model_.nodes.size(), false);
+  for (size_t n = model_.nodes.size(); n-- > 0;) {
+    const OnnxNode& node = model_.nodes[n];
+    for (const std::string& output : node.outputs) {
+      if (needed.count(output) > 0)
+        node_needed[n] = true;
+    }
+    if (node_needed[n])
+      needed.insert(node.inputs.begin(), node.inputs.end());
+  }
+
+  for (size_t n = 0; n < model_.nodes.size(); ++n) {
+    if (node_needed[n] && !AddNode(model_.nodes[n]))
+      return false;
+  }
+
+  for (const OnnxValueInfo& info : model_.outputs) {
+    auto it = values_.find(info.name);
+    if (it == values_.end() || it->second.is_int) {
+      RTC_LOG(LS_WARNING) << "Output " << info.name
+                          << " isn't a float tensor.";
+      return false;
+    }
+    Port port;
+    port.name = info.name;
+    port.dims = it->second.dims;
+    port.size = NumElements(port.dims);
+    port.data = const_cast<float*>(Data(&it->second));
+    session_->outputs_.push_back(std::move(port));
+  }
+  return true;
+}
+
+bool InferenceSession::Builder::AddNode(const OnnxNode& node) {
+  if (!node.domain.empty() && node.domain != "ai.onnx")
+    return Unsupported(node, "custom domain");
+  for (size_t i = 0; i < node.inputs.size(); ++i) {
+    if (!node.inputs[i].empty() && values_.count(node.inputs[i]) == 0)
+      return Unsupported(node, "unknown input");
+  }
+  const std::string& op = node.op_type;
+  if (op == "Constant")
+    return AddConstant(node);
+  if (op == "Identity" || op == "Dropout")
+    return AddAlias(node);
+  if (op == "Cast")
+    return AddCast(node);
+  if (op == "Reshape")
+    return AddReshape(node);
+  if (op == "Flatten")
+    return AddFlatten(node);
+  if (op == "Squeeze")
+    return AddSqueeze(node);
+  if (op == "Unsqueeze")
+    return AddUnsqueeze(node);
+  if (op == "Shape")
+    return AddShape(node);
+  if (op == "Gather")
+    return AddGather(node);
+  if (op == "Slice")
+    return AddSlice(node);
+  if (op == "Concat")
+    return AddConcat(node);
+  if (op == "Add")
+    return AddBinary(node, BinaryKind::kAdd);
+  if (op == "Sub")
+    return AddBinary(node, BinaryKind::kSub);
+  if (op == "Mul")
+    return AddBinary(node, BinaryKind::kMul);
+  if (op == "Div")
+    return AddBinary(node, BinaryKind::kDiv);
+  if (op == "Relu")
+    return AddUnary(node, UnaryKind::kRelu);
+  if (op == "LeakyRelu")
+    return AddUnary(node, UnaryKind::kLeakyRelu);
+  if (op == "Tanh")
+    return AddUnary(node, UnaryKind::kTanh);
+  if (op == "Sigmoid")
+    return AddUnary(node, UnaryKind::kSigmoid);
+  if (op == "Clip")
+    return AddUnary(node, UnaryKind::kClip);
+  if (op == "Gemm")
+    return AddGemm(node);
+  if (op == "MatMul")
+    return AddMatMul(node);
+  if (op == "GRU")
+    return AddGru(node);
+  if (op == "LSTM")
+    return AddLstm(node);
+  if (op == "RandomNormalLike")
+    return AddRandomNormalLike(node);
+  return Unsupported(node, "unknown operator");
+}
+
+bool InferenceSession::Builder::AddConstant(const OnnxNode& node) {
+  Value* output = Output(node, 0);
+  if (!output)
+    return Unsupported(node, "no output");
+  output->constant = true;
+  const OnnxAttribute* attribute;
+  if ((attribute = node.FindAttribute("value")) && attribute->t.size() == 1) {
+    const OnnxTensor& tensor = attribute->t[0];
+    output->dims = tensor.dims;
+    output->is_int = !tensor.is_float;
+    output->float_data = tensor.float_data;
+    output->int_data = tensor.int_data;
+  } else if ((attribute = node.FindAttribute("value_float"))) {
+    output->float_data = {attribute->f};
+  } else if ((attribute = node.FindAttribute("value_floats"))) {
+    output->dims = {static_cast<int64_t>(attribute->floats.size())};
+    output->float_data = attribute->floats;
+  } else if ((attribute = node.FindAttribute("value_int"))) {
+    output->is_int = true;
+    output->int_data = {attribute->i};
+  } else if ((attribute = node.FindAttribute("value_ints"))) {
+    output->dims = {static_cast<int64_t>(attribute->ints.size())};
+    output->is_int = true;
+    output->int_data = attribute->ints;
+  } else {
+    return Unsupported(node, "unsupported value");
+  }
+  return true;
+}
+
+bool InferenceSession::Builder::AddAlias(const OnnxNode& node) {
+  const Value* input = Input(node, 0);
+  Value* output = Output(node, 0);
+  if (!input || !output)
+    return Unsupported(node, "missing input or output");
+  if (node.outputs.size() > 1 && !node.outputs[1].empty())
+    return Unsupported(node, "dropout mask");
+  *output = *input;
+  return true;
+}
+
+bool InferenceSession::Builder::AddCast(const OnnxNode& node) {
+  const Value* input = Input(node, 0);
+  const OnnxAttribute* to = node.FindAttribute("to");
+  if (!input || !to)
+    return Unsupported(node, "missing input or type");
+  const bool to_float = to->i == kDataTypeFloat || to->i == kDataTypeDouble;
+  if (!input->constant) {
+    if (!to_float)
+      return Unsupported(node, "cast of activations to integers");
+    return AddAlias(node);
+  }
+  Value* output = Output(node, 0);
+  if (!output)
+    return Unsupported(node, "no output");
+  *output = *input;
+  if (to_float && input->is_int) {
+    output->is_int = false;
+    output->float_data.assign(input->int_data.begin(), input->int_data.end());
+    output->int_data.clear();
+  } else if (!to_float && !input->is_int) {
+    output->is_int = true;
+    output->int_data.clear();
+    for (float value : input->float_data)
+      output->int_data.push_back(static_cast<int64_t>(value));
+    output->float_data.clear();
+  }
+  output->data = nullptr;
+  return true;
+}
+
+bool InferenceSession::Builder::AddReshape(const OnnxNode& node) {
+  const Value* input = Input(node, 0);
+  const Value* shape = Input(node, 1);
+  Dims new_dims;
+  if (shape) {
+    if (!shape->constant || !shape->is_int)
+      return Unsupported(node, "shape isn't a constant");
+    new_dims = shape->int_data;
+  } else if (const OnnxAttribute* attribute = node.FindAttribute("shape")) {
+    new_dims = attribute->ints;
+  }
+  if (!input)
+    return Unsupported(node, "no input");
+  const size_t num_elements = NumElements(input->dims);
+  size_t known_elements = 1;
+  int inferred = -1;
+  for (size_t d = 0; d < new_dims.size(); ++d) {
+    if (new_dims[d] == 0 && d < input->dims.size()) {
+      new_dims[d] = input->dims[d];
+    } else if (new_dims[d] == -1) {
+      if (inferred >= 0)
+        return Unsupported(node, "more than one inferred dimension");
+      inferred = static_cast<int>(d);
+      continue;
+    }
+    known_elements *= static_cast<size_t>(new_dims[d]);
+  }
+  if (inferred >= 0 && known_elements > 0)
+    new_dims[inferred] = static_cast<int64_t>(num_elements / known_elements);
+  if (NumElements(new_dims) != num_elements)
+    return Unsupported(node, "shape doesn't match the input");
+  if (!AddAlias(node))
+    return false;
+  Output(node, 0)->dims = new_dims;
+  return true;
+}
+
+bool InferenceSession::Builder::AddFlatten(const OnnxNode& node) {
+  const Value* input = Input(node, 0);
+  if (!input)
+    return Unsupported(node, "no input");
+  const OnnxAttribute* attribute = node.FindAttribute("axis");
+  const int64_t axis_attribute = attribute ? attribute->i : 1;
+  size_t axis = input->dims.size();
+  if (axis_attribute != static_cast<int64_t>(input->dims.size()) &&
+      !NormalizeAxis(axis_attribute, input->dims.size(), &axis)) {
+    return Unsupported(node, "invalid axis");
+  }
+  const Dims outer(input->dims.begin(), input->dims.begin() + axis);
+  const Dims inner(input->dims.begin() + axis, input->dims.end());
+  const Dims new_dims = {static_cast<int64_t>(NumElements(outer)),
+                         static_cast<int64_t>(NumElements(inner))};
+  if (!AddAlias(node))
+    return false;
+  Output(node, 0)->dims = new_dims;
+  return true;
+}
+
+bool InferenceSession::Builder::AddSqueeze(const OnnxNode& node) {
+  const Value* input = Input(node, 0);
+  if (!input)
+    return Unsupported(node, "no input");
+  Dims axes;
+  IntsFromInputOrAttribute(node, 1, "axes", &axes);
+  std::vector<bool> squeezed(input->dims.size(), false);
+  if (axes.empty()) {
+    for (size_t d = 0; d < input->dims.size(); ++d)
+      squeezed[d] = input->dims[d] == 1;
+  }
+  for (int64_t axis : axes) {
+    size_t d;
+    if (!NormalizeAxis(axis, input->dims.size(), &d) || input->dims[d] != 1)
+      return Unsupported(node, "invalid axis");
+    squeezed[d] = true;
+  }
+  Dims new_dims;
+  for (size_t d = 0; d < input->dims.size(); ++d) {
+    if (!squeezed[d])
+      new_dims.push_back(input->dims[d]);
+  }
+  if (!AddAlias(node))
+    return false;
+  Output(node, 0)->dims = new_dims;
+  return true;
+}
+
+bool InferenceSession::Builder::AddUnsqueeze(const OnnxNode& node) {
+  const Value* input = Input(node, 0);
+  Dims axes;
+  if (!input || !IntsFromInputOrAttribute(node, 1, "axes", &axes))
+    return Unsupported(node, "missing input or axes");
+  const size_t rank = input->dims.size() + axes.size();
+  std::vector<bool> inserted(rank, false);
+  for (int64_t axis : axes) {
+    size_t d;
+    if (!NormalizeAxis(axis, rank, &d) || inserted[d])
+      return Unsupported(node, "invalid axis");
+    inserted[d] = true;
+  }
+  Dims new_dims;
+  auto input_dim = input->dims.begin();
+  for (size_t d = 0; d < rank; ++d)
+    new_dims.push_back(inserted[d] ? 1 : *input_dim++);
+  if (!AddAlias(node))
+    return false;
+  Output(node, 0)->dims = new_dims;
+  return true;
+}
+
+bool InferenceSession::Builder::AddShape(const OnnxNode& node) {
+  const Value* input = Input(node, 0);
+  Value* output = Output(node, 0);
+  if (!input || !output)
+    return Unsupported(node, "missing input or output");
+  Dims shape = input->dims;
+  output->dims = {static_cast<int64_t>(shape.size())};
+  output->constant = true;
+  output->is_int = true;
+  output->int_data = std::move(shape);
+  return true;
+}
+
+bool InferenceSession::Builder::AddGather(const OnnxNode& node) {
+  const Value* data = Input(node, 0);
+  const Value* indices = Input(node, 1);
+  if (!data || !indices || !data->constant || !indices->constant ||
+      !indices->is_int) {
+    return Unsupported(node, "only constants can be gathered");
+  }
+  const OnnxAttribute* attribute = node.FindAttribute("axis");
+  size_t axis;
+  if (!NormalizeAxis(attribute ? attribute->i : 0, data->dims.size(), &axis))
+    return Unsupported(node, "invalid axis");
+  const Dims outer_dims(data->dims.begin(), data->dims.begin() + axis);
+  const Dims inner_dims(data->dims.begin() + axis + 1, data->dims.end());
+  const size_t outer = NumElements(outer_dims);
+  const size_t inner = NumElements(inner_dims);
+  const int64_t axis_size = data->dims[axis];
+  Value gathered;
+  gathered.constant = true;
+  gathered.is_int = data->is_int;
+  gathered.dims = outer_dims;
+  gathered.dims.insert(gathered.dims.end(), indices->dims.begin(),
+                       indices->dims.end());
+  gathered.dims.insert(gathered.dims.end(), inner_dims.begin(),
+                       inner_dims.end());
+  for (size_t o = 0; o < outer; ++o) {
+    for (int64_t index : indices->int_data) {
+      if (index < -axis_size || index >= axis_size)
+        return Unsupported(node, "index out of range");
+      if (index < 0)
+        index += axis_size;
+      const size_t offset =
+          (o * static_cast<size_t>(axis_size) + static_cast<size_t>(index)) *
+          inner;
+      if (data->is_int) {
+        gathered.int_data.insert(gathered.int_data.end(),
+                                 data->int_data.begin() + offset,
+                                 data->int_data.begin() + offset + inner);
+      } else {
+        gathered.float_data.insert(gathered.float_data.end(),
+                                   data->float_data.begin() + offset,
+                                   data->float_data.begin() + offset + inner);
+      }
+    }
+  }
+  Value* output = Output(node, 0);
+  if (!output)
+    return Unsupported(node, "no output");
+  *output = std::move(gathered);
+  return true;
+}
+
+bool InferenceSession::Builder::AddSlice(const OnnxNode& node) {
+  const Value* input = Input(node, 0);
+  Dims starts, ends, axes, steps;
+  if (!input || !IntsFromInputOrAttribute(node, 1, "starts", &starts) ||
+      !IntsFromInputOrAttribute(node, 2, "ends", &ends) ||
+      starts.size() != ends.size()) {
+    return Unsupported(node, "missing input, starts or ends");
+  }
+  IntsFromInputOrAttribute(node, 3, "axes", &axes);
+  IntsFromInputOrAttribute(node, 4, "steps", &steps);
+  if ((!axes.empty() && axes.size() != starts.size()) ||
+      (!steps.empty() && steps.size() != starts.size())) {
+    return Unsupported(node, "mismatching slice parameters");
+  }
+
+  const size_t rank = input->dims.size();
+  Dims all_starts(rank, 0);
+  Dims all_steps(rank, 1);
+  Dims output_dims = input->dims;
+  for (size_t i = 0; i < starts.size(); ++i) {
+    size_t d = i;
+    if (!axes.empty() && !NormalizeAxis(axes[i], rank, &d))
+      return Unsupported(node, "invalid axis");
+    const int64_t step = steps.empty() ? 1 : steps[i];
+    if (step <= 0)
+      return Unsupported(node, "step isn't positive");
+    const int64_t size = input->dims[d];
+    int64_t start = starts[i] < 0 ? starts[i] + size : starts[i];
+    int64_t end = ends[i] < 0 ? ends[i] + size : ends[i];
+    start = std::min(std::max<int64_t>(start, 0), size);
+    end = std::min(std::max<int64_t>(end, 0), size);
+    all_starts[d] = start;
+    all_steps[d] = step;
+    output_dims[d] = end > start ? (end - start + step - 1) / step : 0;
+  }
+
+  if (input->constant) {
+    Value sliced;
+    sliced.constant = true;
+    sliced.is_int = input->is_int;
+    sliced.dims = output_dims;
+    if (input->is_int) {
+      sliced.int_data.resize(NumElements(output_dims));
+      SliceCopy(input->int_data.data(), input->dims, all_starts, all_steps,
+                output_dims, sliced.int_data.data());
+    } else {
+      sliced.float_data.resize(NumElements(output_dims));
+      SliceCopy(input->float_data.data(), input->dims, all_starts, all_steps,
+                output_dims, sliced.float_data.data());
+    }
+    Value* output = Output(node, 0);
+    if (!output)
+      return Unsupported(node, "no output");
+    *output = std::move(sliced);
+    return true;
+  }
+
+  const float* input_data = Data(input);
+  const Dims input_dims = input->dims;
+  float* output = AddRuntimeOutput(node, 0, output_dims);
+  if (!output)
+    return Unsupported(node, "no output");
+  session_->operations_.push_back(std::make_unique<SliceOperation>(
+      input_data, input_dims, all_starts, all_steps, output_dims, output));
+  return true;
+}
+
+bool InferenceSession::Builder::AddConcat(const OnnxNode& node) {
+  std::vector<const Value*> inputs;
+  for (size_t i = 0; i < node.inputs.size(); ++i) {
+    if (const Value* input = Input(node, i))
+      inputs.push_back(input);
+  }
+  const OnnxAttribute* attribute = node.FindAttribute("axis");
+  if (inputs.empty() || !attribute)
+    return Unsupported(node, "missing inputs or axis");
+  const size_t rank = inputs[0]->dims.size();
+  size_t axis;
+  if (!NormalizeAxis(attribute->i, rank, &axis))
+    return Unsupported(node, "invalid axis");
+
+  Dims output_dims = inputs[0]->dims;
+  output_dims[axis] = 0;
+  bool constant = true;
+  bool is_int = inputs[0]->is_int;
+  std::vector<size_t> chunk_sizes;
+  for (const Value* input : inputs) {
+    if (input->dims.size() != rank || input->is_int != is_int)
+      return Unsupported(node, "mismatching inputs");
+    for (size_t d = 0; d < rank; ++d) {
+      if (d != axis && input->dims[d] != output_dims[d])
+        return Unsupported(node, "mismatching inputs");
+    }
+    output_dims[axis] += input->dims[axis];
+    chunk_sizes.push_back(
+        NumElements(Dims(input->dims.begin() + axis, input->dims.end())));
+    constant = constant && input->constant;
+  }
+  const size_t outer =
+      NumElements(Dims(output_dims.begin(), output_dims.begin() + axis));
+
+  if (constant) {
+    Value concatenated;
+    concatenated.constant = true;
+    concatenated.is_int = is_int;
+    concatenated.dims = output_dims;
+    if (is_int) {
+      std::vector<const int64_t*> data;
+      for (const Value* input : inputs)
+        data.push_back(input->int_data.data());
+      concatenated.int_data.resize(NumElements(output_dims));
+      ConcatCopy(data, chunk_sizes, outer, concatenated.int_data.data());
+    } else {
+      std::vector<const float*> data;
+      for (const Value* input : inputs)
+        data.push_back(input->float_data.data());
+      concatenated.float_data.resize(NumElements(output_dims));
+      ConcatCopy(data, chunk_sizes, outer, concatenated.float_data.data());
+    }
+    Value* output = Output(node, 0);
+    if (!output)
+      return Unsupported(node, "no output");
+    *output = std::move(concatenated);
+    return true;
+  }
+
+  if (is_int)
+    return Unsupported(node, "integer activations");
+  std::vector<const float*> data;
+  for (const Value* input : inputs)
+    data.push_back(Data(input));
+  float* output = AddRuntimeOutput(node, 0, output_dims);
+  if (!output)
+    return Unsupported(node, "no output");
+  session_->operations_.push_back(std::make_unique<ConcatOperation>(
+      std::move(data), std::move(chunk_sizes), outer, output));
+  return true;
+}
+
+bool InferenceSession::Builder::AddBinary(const OnnxNode& node,
+                                          BinaryKind kind) {
+  const Value* a = Input(node, 0);
+  const Value* b = Input(node, 1);
+  Dims output_dims;
+  if (!a || !b || a->is_int != b->is_int ||
+      !BroadcastDims(a->dims, b->dims, &output_dims)) {
+    return Unsupported(node, "mismatching inputs");
+  }
+
+  if (a->constant && b->constant) {
+    Value result;
+    result.constant = true;
+    result.is_int = a->is_int;
+    result.dims = output_dims;
+    const std::vector<size_t> a_strides =
+        BroadcastStrides(a->dims, output_dims);
+    const std::vector<size_t> b_strides =
+        BroadcastStrides(b->dims, output_dims);
+    if (a->is_int) {
+      result.int_data.resize(NumElements(output_dims));
+      BroadcastBinary(kind, a->int_data.data(), a_strides, b->int_data.data(),
+                      b_strides, output_dims, result.int_data.data());
+    } else {
+      result.float_data.resize(NumElements(output_dims));
+      BroadcastBinary(kind, a->float_data.data(), a_strides,
+                      b->float_data.data(), b_strides, output_dims,
+                      result.float_data.data());
+    }
+    Value* output = Output(node, 0);
+    if (!output)
+      return Unsupported(node, "no output");
+    *output = std::move(result);
+    return true;
+  }
+
+  if (a->is_int)
+    return Unsupported(node, "integer activations");
+  const float* a_data = Data(a);
+  const float* b_data = Data(b);
+  const Dims a_dims = a->dims;
+  const Dims b_dims = b->dims;
+  float* output = AddRuntimeOutput(node, 0, output_dims);
+  if (!output)
+    return Unsupported(node, "no output");
+  session_->operations_.push_back(std::make_unique<BinaryOperation>(
+      kind, a_data, a_dims, b_data, b_dims, output_dims, output));
+  return true;
+}
+
+bool InferenceSession::Builder::AddUnary(const OnnxNode& node,
+                                         UnaryKind kind) {
+  const Value* input = Input(node, 0);
+  if (!input || input->is_int)
+    return Unsupported(node, "missing or integer input");
+  UnaryParameters parameters;
+  parameters.kind = kind;
+  if (kind == UnaryKind::kLeakyRelu) {
+    const OnnxAttribute* alpha = node.FindAttribute("alpha");
+    parameters.alpha = alpha ? alpha->f : 0.01f;
+  } else if (kind == UnaryKind::kClip) {
+    parameters.alpha = std::numeric_limits<float>::lowest();
+    parameters.beta = std::numeric_limits<float>::max();
+    // Before opset 11 the bounds are attributes, later they are inputs.
+    if (const OnnxAttribute* min = node.FindAttribute("min"))
+      parameters.alpha = min->f;
+    if (const OnnxAttribute* max = node.FindAttribute("max"))
+      parameters.beta = max->f;
+    const Value* min = Input(node, 1);
+    const Value* max = Input(node, 2);
+    for (const Value* bound : {min, max}) {
+      if (bound && (!bound->constant || bound->is_int ||
+                    bound->float_data.size() != 1)) {
+        return Unsupported(node, "bounds aren't scalar constants");
+      }
+    }
+    if (min)
+      parameters.alpha = min->float_data[0];
+    if (max)
+      parameters.beta = max->float_data[0];
+  }
+
+  const Dims dims = input->dims;
+  const size_t size = NumElements(dims);
+  if (input->constant) {
+    Value result;
+    result.constant = true;
+    result.dims = dims;
+    result.float_data.resize(size);
+    ApplyUnary(parameters, input->float_data.data(), size,
+               result.float_data.data());
+    Value* output = Output(node, 0);
+    if (!output)
+      return Unsupported(node, "no output");
+    *output = std::move(result);
+    return true;
+  }
+
+  const float* input_data = Data(input);
+  float* output = AddRuntimeOutput(node, 0, dims);
+  if (!output)
+    return Unsupported(node, "no output");
+  session_->operations_.push_back(
+      std::make_unique<UnaryOperation>(parameters, input_data, size, output));
+  return true;
+}
+
+bool InferenceSession::Builder::AddGemm(const OnnxNode& node) {
+  const Value* a = Input(node, 0);
+  const Value* b = Input(node, 1);
+  const Value* c = Input(node, 2);
+  if (!a || !b || a->is_int || a->dims.size() != 2)
+    return Unsupported(node, "A must be a float matrix");
+  if (!b->constant || b->is_int || b->dims.size() != 2)
+    return Unsupported(node, "B must be a float constant matrix");
+  const OnnxAttribute* trans_a = node.FindAttribute("transA");
+  const OnnxAttribute* trans_b = node.FindAttribute("transB");
+  const OnnxAttribute* alpha = node.FindAttribute("alpha");
+  const OnnxAttribute* beta = node.FindAttribute("beta");
+  if (trans_a && trans_a->i != 0)
+    return Unsupported(node, "transposed A");
+  const bool transpose_b = trans_b && trans_b->i != 0;
+  const size_t rows = static_cast<size_t>(a->dims[0]);
+  const size_t input_size = static_cast<size_t>(a->dims[1]);
+  const size_t output_size =
+      static_cast<size_t>(transpose_b ? b->dims[0] : b->dims[1]);
+  if (static_cast<int64_t>(input_size) !=
+      (transpose_b ? b->dims[1] : b->dims[0])) {
+    return Unsupported(node, "mismatching A and B");
+  }
+  const Dims output_dims = {static_cast<int64_t>(rows),
+                            static_cast<int64_t>(output_size)};
+
+  const float* weights =
+      PackWeights(b->float_data, output_size, input_size, !transpose_b,
+                  alpha ? alpha->f : 1.f);
+  const float* bias = nullptr;
+  bool bias_per_row = false;
+  if (c) {
+    Dims bias_dims;
+    if (!c->constant || c->is_int ||
+        !BroadcastDims(output_dims, c->dims, &bias_dims) ||
+        bias_dims != output_dims) {
+      return Unsupported(node, "C must be a float constant");
+    }
+    // Expand C to one row, or to every row if it differs between rows.
+    bias_per_row = c->dims.size() == 2 && c->dims[0] != 1;
+    const Dims expanded_dims = {bias_per_row ? output_dims[0] : 1,
+                                output_dims[1]};
+    std::vector<float> expanded(NumElements(expanded_dims));
+    const std::vector<float> scale = {beta ? beta->f : 1.f};
+    BroadcastBinary(BinaryKind::kMul, c->float_data.data(),
+                    BroadcastStrides(c->dims, expanded_dims), scale.data(),
+                    BroadcastStrides({1}, expanded_dims), expanded_dims,
+                    expanded.data());
+    bias = PackVector(expanded);
+  }
+
+  const float* input_data = Data(a);
+  float* output = AddRuntimeOutput(node, 0, output_dims);
+  if (!output)
+    return Unsupported(node, "no output");
+  session_->operations_.push_back(std::make_unique<FullyConnectedOperation>(
+      session_->optimization_, input_data, rows, input_size, weights, bias,
+      bias_per_row, output_size, output));
+  return true;
+}
+
+bool InferenceSession::Builder::AddMatMul(const OnnxNode& node) {
+  const Value* a = Input(node, 0);
+  const Value* b = Input(node, 1);
+  if (!a || !b || a->is_int || a->dims.empty())
+    return Unsupported(node, "A must be a float tensor");
+  if (!b->constant || b->is_int || b->dims.size() != 2)
+    return Unsupported(node, "B must be a float constant matrix");
+  const size_t input_size = static_cast<size_t>(a->dims.back());
+  const size_t output_size = static_cast<size_t>(b->dims[1]);
+  if (static_cast<int64_t>(input_size) != b->dims[0])
+    return Unsupported(node, "mismatching A and B");
+  // Leading dimensions of A are rows of one matrix product.
+  Dims output_dims(a->dims.begin(), a->dims.end() - 1);
+  const size_t rows = NumElements(output_dims);
+  output_dims.push_back(static_cast<int64_t>(output_size));
+
+  const float* weights =
+      PackWeights(b->float_data, output_size, input_size, true, 1.f);
+  const float* input_data = Data(a);
+  float* output = AddRuntimeOutput(node, 0, output_dims);
+  if (!output)
+    return Unsupported(node, "no output");
+  session_->operations_.push_back(std::make_unique<FullyConnectedOperation>(
+      session_->optimization_, input_data, rows, input_size, weights, nullptr,
+      false, output_size, output));
+  return true;
+}
+
+bool InferenceSession::Builder::AddGru(const OnnxNode& node) {
+  const Value* x = Input(node, 0);
+  const Value* w = Input(node, 1);
+  const Value* r = Input(node, 2);
+  const Value* b = Input(node, 3);
+  const Value* initial_h = Input(node, 5);
+  const OnnxAttribute* hidden_size_attribute =
+      node.FindAttribute("hidden_size");
+  if (!x || !w || !r || !hidden_size_attribute)
+    return Unsupported(node, "missing inputs or hidden size");
+  if (Input(node, 4))
+    return Unsupported(node, "sequence lengths");
+  const OnnxAttribute* direction = node.FindAttribute("direction");
+  if (direction && direction->s != "forward")
+    return Unsupported(node, "only forward direction is supported");
+  const OnnxAttribute* layout = node.FindAttribute("layout");
+  if (node.FindAttribute("activations") || node.FindAttribute("clip") ||
+      (layout && layout->i != 0)) {
+    return Unsupported(node, "custom activations, clip or layout");
+  }
+  const OnnxAttribute* linear_before_reset =
+      node.FindAttribute("linear_before_reset");
+
+  const size_t hidden_size = static_cast<size_t>(hidden_size_attribute->i);
+  if (x->is_int || x->dims.size() != 3)
+    return Unsupported(node, "X must be a float tensor of rank 3");
+  const size_t sequence_length = static_cast<size_t>(x->dims[0]);
+  const size_t batch_size = static_cast<size_t>(x->dims[1]);
+  const size_t input_size = static_cast<size_t>(x->dims[2]);
+  const int64_t gate_rows = static_cast<int64_t>(3 * hidden_size);
+  if (!w->constant || !r->constant || (b && !b->constant) ||
+      w->dims != Dims({1, gate_rows, static_cast<int64_t>(input_size)}) ||
+      r->dims !=
+          Dims({1, gate_rows, static_cast<int64_t>(hidden_size)}) ||
+      (b && b->dims != Dims({1, 2 * gate_rows}))) {
+    return Unsupported(node, "W, R and B must be constants of matching size");
+  }
+  const Dims state_dims = {1, static_cast<int64_t>(batch_size),
+                           static_cast<int64_t>(hidden_size)};
+  if (initial_h && (initial_h->is_int || initial_h->dims != state_dims))
+    return Unsupported(node, "mismatching initial state");
+
+  RecurrentWeights weights;
+  weights.input_size = input_size;
+  weights.hidden_size = hidden_size;
+  weights.num_gates = 3;
+  weights.input_weights =
+      PackWeights(w->float_data, 3 * hidden_size, input_size, false, 1.f);
+  weights.recurrent_weights =
+      PackWeights(r->float_data, 3 * hidden_size, hidden_size, false, 1.f);
+  std::vector<float> biases(6 * hidden_size, 0.f);
+  if (b)
+    biases = b->float_data;
+  weights.input_bias = PackVector({biases.data(), 3 * hidden_size});
+  weights.recurrent_bias =
+      PackVector({biases.data() + 3 * hidden_size, 3 * hidden_size});
+
+  RecurrentIo io;
+  io.sequence_length = sequence_length;
+  io.batch_size = batch_size;
+  io.input = Data(x);
+  io.initial_hidden = initial_h ? Data(initial_h) : nullptr;
+  io.initial_cell = nullptr;
+  io.output = AddRuntimeOutput(
+      node, 0,
+      {static_cast<int64_t>(sequence_length), 1,
+       static_cast<int64_t>(batch_size), static_cast<int64_t>(hidden_size)});
+  // The final state is updated in place, in the buffer of the Y_h output if
+  // it's used.
+  io.hidden = AddRuntimeOutput(node, 1, state_dims);
+  if (!io.hidden)
+    io.hidden = Allocate(NumElements(state_dims));
+  io.cell = nullptr;
+
+  session_->operations_.push_back(std::make_unique<GruOperation>(
+      session_->optimization_, weights, io,
+      linear_before_reset && linear_before_reset->i != 0,
+      Allocate(3 * hidden_size), Allocate(3 * hidden_size),
+      Allocate(hidden_size)));
+  return true;
+}
+
+bool InferenceSession::Builder::AddLstm(const OnnxNode& node) {
+  const Value* x = Input(node, 0);
+  const Value* w = Input(node, 1);
+  const Value* r = Input(node, 2);
+  const Value* b = Input(node, 3);
+  const Value* initial_h = Input(node, 5);
+  const Value* initial_c = Input(node, 6);
+  const OnnxAttribute* hidden_size_attribute =
+      node.FindAttribute("hidden_size");
+  if (!x || !w || !r || !hidden_size_attribute)
+    return Unsupported(node, "missing inputs or hidden size");
+  if (Input(node, 4) || Input(node, 7))
+    return Unsupported(node, "sequence lengths or peepholes");
+  const OnnxAttribute* direction = node.FindAttribute("direction");
+  if (direction && direction->s != "forward")
+    return Unsupported(node, "only forward direction is supported");
+  const OnnxAttribute* input_forget = node.FindAttribute("input_forget");
+  const OnnxAttribute* layout = node.FindAttribute("layout");
+  if (node.FindAttribute("activations") || node.FindAttribute("clip") ||
+      (input_forget && input_forget->i != 0) || (layout && layout->i != 0)) {
+    return Unsupported(node,
+                       "custom activations, clip, input forget or layout");
+  }
+
+  const size_t hidden_size = static_cast<size_t>(hidden_size_attribute->i);
+  if (x->is_int || x->dims.size() != 3)
+    return Unsupported(node, "X must be a float tensor of rank 3");
+  const size_t sequence_length = static_cast<size_t>(x->dims[0]);
+  const size_t batch_size = static_cast<size_t>(x->dims[1]);
+  const size_t input_size = static_cast<size_t>(x->dims[2]);
+  const int64_t gate_rows = static_cast<int64_t>(4 * hidden_size);
+  if (!w->constant || !r->constant || (b && !b->constant) ||
+      w->dims != Dims({1, gate_rows, static_cast<int64_t>(input_size)}) ||
+      r->dims !=
+          Dims({1, gate_rows, static_cast<int64_t>(hidden_size)}) ||
+      (b && b->dims != Dims({1, 2 * gate_rows}))) {
+    return Unsupported(node, "W, R and B must be constants of matching size");
+  }
+  const Dims state_dims = {1, static_cast<int64_t>(batch_size),
+                           static_cast<int64_t>(hidden_size)};
+  if ((initial_h && (initial_h->is_int || initial_h->dims != state_dims)) ||
+      (initial_c && (initial_c->is_int || initial_c->dims != state_dims))) {
+    return Unsupported(node, "mismatching initial state");
+  }
+
+  RecurrentWeights weights;
+  weights.input_size = input_size;
+  weights.hidden_size = hidden_size;
+  weights.num_gates = 4;
+  weights.input_weights =
+      PackWeights(w->float_data, 4 * hidden_size, input_size, false, 1.f);
+  weights.recurrent_weights =
+      PackWeights(r->float_data, 4 * hidden_size, hidden_size, false, 1.f);
+  // Both biases are added to the same gates, so they're added up front.
+  std::vector<float> bias(4 * hidden_size, 0.f);
+  if (b) {
+    for (size_t i = 0; i < 4 * hidden_size; ++i)
+      bias[i] = b->float_data[i] + b->float_data[4 * hidden_size + i];
+  }
+  weights.input_bias = PackVector(bias);
+  weights.recurrent_bias = nullptr;
+
+  RecurrentIo io;
+  io.sequence_length = sequence_length;
+  io.batch_size = batch_size;
+  io.input = Data(x);
+  io.initial_hidden = initial_h ? Data(initial_h) : nullptr;
+  io.initial_cell = initial_c ? Data(initial_c) : nullptr;
+  io.output = AddRuntimeOutput(
+      node, 0,
+      {static_cast<int64_t>(sequence_length), 1,
+       static_cast<int64_t>(batch_size), static_cast<int64_t>(hidden_size)});
+  io.hidden = AddRuntimeOutput(node, 1, state_dims);
+  if (!io.hidden)
+    io.hidden = Allocate(NumElements(state_dims));
+  io.cell = AddRuntimeOutput(node, 2, state_dims);
+  if (!io.cell)
+    io.cell = Allocate(NumElements(state_dims));
+
+  session_->operations_.push_back(
+      std::make_unique<LstmOperation>(session_->optimization_, weights, io,
+                                      Allocate(4 * hidden_size)));
+  return true;
+}
+
+bool InferenceSession::Builder::AddRandomNormalLike(const OnnxNode& node) {
+  const Value* input = Input(node, 0);
+  if (!input)
+    return Unsupported(node, "no input");
+  const OnnxAttribute* mean = node.FindAttribute("mean");
+  const OnnxAttribute* scale = node.FindAttribute("scale");
+  const OnnxAttribute* seed = node.FindAttribute("seed");
+  // Without a seed the samples are still the same from session to session,
+  // which ONNX leaves up to the implementation. Random doesn't take 0.
+  const uint64_t seed_value = std::max<uint64_t>(
+      seed ? static_cast<uint64_t>(std::fabs(seed->f)) : 0, 1);
+  const Dims dims = input->dims;
+  float* output = AddRuntimeOutput(node, 0, dims);
+  if (!output)
+    return Unsupported(node, "no output");
+  session_->operations_.push_back(std::make_unique<RandomNormalOperation>(
+      mean ? mean->f : 0.f, scale ? scale->f : 1.f, seed_value,
+      NumElements(dims), output));
+  return true;
+}
+
+bool InferenceSession::Builder::Unsupported(const OnnxNode& node,
+                                            const char* reason) const {
+  RTC_LOG(LS_WARNING) << "Can't run " << node.op_type << " node '"
+                      << node.name << "': " << reason;
+  return false;
+}
+
+const InferenceSession::Builder::Value* InferenceSession::Builder::Input(
+    const OnnxNode& node,
+    size_t index) const {
+  if (index >= node.inputs.size() || node.inputs[index].empty())
+    return nullptr;
+  auto it = values_.find(node.inputs[index]);
+  return it == values_.end() ? nullptr : &it->second;
+}
+
+bool InferenceSession::Builder::IntsFromInputOrAttribute(const OnnxNode& node,
+                                                         size_t index,
+                                                         const char* name,
+                                                         Dims* ints) const {
+  if (const Value* input = Input(node, index)) {
+    if (!input->constant || !input->is_int)
+      return false;
+    *ints = input->int_data;
+    return true;
+  }
+  if (const OnnxAttribute* attribute = node.FindAttribute(name)) {
+    *ints = attribute->ints;
+    return true;
+  }
+  return false;
+}
+
+InferenceSession::Builder::Value* InferenceSession::Builder::Output(
+    const OnnxNode& node,
+    size_t index) {
+  if (index >= node.outputs.size() || node.outputs[index].empty())
+    return nullptr;
+  return &values_[node.outputs[index]];
+}
+
+float* InferenceSession::Builder::AddRuntimeOutput(const OnnxNode& node,
+                                                   size_t index,
+                                                   Dims dims) {
+  Value* output = Output(node, index);
+  if (!output)
+    return nullptr;
+  output->data = Allocate(NumElements(dims));
+  output->dims = std::move(dims);
+  return output->data;
+}
+
+const float* InferenceSession::Builder::Data(const Value* value) {
+  if (value->data)
+    return value->data;
+  RTC_DCHECK(value->constant);
+  RTC_DCHECK(!value->is_int);
+  // Constants are shared by every reader, so the buffer is cached.
+  Value* mutable_value = const_cast<Value*>(value);
+  mutable_value->data = PackVector(value->float_data);
+  return mutable_value->data;
+}
+
+float* InferenceSession::Builder::Allocate(size_t size) {
+  // Rounded up so that kernels may read whole vectors.
+  const size_t bytes = PackedStride(std::max<size_t>(size, 1)) * sizeof(float);
+  float* data = AlignedMalloc<float>(bytes, kAlignmentBytes);
+  memset(data, 0, bytes);
+  session_->buffers_.emplace_back(data);
+  session_->memory_bytes_ += bytes;
+  return data;
+}
+
+float* InferenceSession::Builder::PackWeights(
+    rtc::ArrayView<const float> weights,
+    size_t rows,
+    size_t columns,
+    bool transpose,
+    float scale) {
+  RTC_DCHECK_GE(weights.size(), rows * columns);
+  const size_t stride = PackedStride(columns);
+  float* packed = Allocate(rows * stride);
+  for (size_t r = 0; r < rows; ++r) {
+    for (size_t c = 0; c < columns; ++c) {
+      packed[r * stride + c] = scale * (transpose ? weights[c * rows + r]
+                                                  : weights[r * columns + c]);
+    }
+  }
+  return packed;
+}
+
+float* InferenceSession::Builder::PackVector(
+    rtc::ArrayView<const float> values) {
+  float* packed = Allocate(values.size());
+  std::copy(values.begin(), values.end(), packed);
+  return packed;
+}
+
+InferenceSession::Port::Port() = default;
+InferenceSession::Port::Port(const Port&) = default;
+InferenceSession::Port::~Port() = default;
+
+std::unique_ptr<InferenceSession> InferenceSession::Create(
+    const OnnxModel& model,
+    Optimization optimization) {
+  std::unique_ptr<InferenceSession> session(
+      new InferenceSession(optimization));
+  Builder builder(session.get(), model);
+  if (!builder.Build())
+    return nullptr;
+  return session;
+}
+
+InferenceSession::InferenceSession(Optimization optimization)
+    : optimization_(optimization) {}
+
+InferenceSession::~InferenceSession() = default;
+
+const std::string& InferenceSession::input_name(size_t index) const {
+  RTC_DCHECK_LT(index, inputs_.size());
+  return inputs_[index].name;
+}
+
+rtc::ArrayView<const int64_t> InferenceSession::input_shape(
+    size_t index) const {
+  RTC_DCHECK_LT(index, inputs_.size());
+  return inputs_[index].dims;
+}
+
+rtc::ArrayView<float> InferenceSession::input(size_t index) {
+  RTC_DCHECK_LT(index, inputs_.size());
+  return {inputs_[index].data, inputs_[index].size};
+}
+
+absl::optional<size_t> InferenceSession::FindInput(
+    absl::string_view name) const {
+  for (size_t i = 0; i < inputs_.size(); ++i) {
+    if (inputs_[i].name == name)
+      return i;
+  }
+  return absl::nullopt;
+}
+
+const std::string& InferenceSession::output_name(size_t index) const {
+  RTC_DCHECK_LT(index, outputs_.size());
+  return outputs_[index].name;
+}
+
+rtc::ArrayView<const int64_t> InferenceSession::output_shape(
+    size_t index) const {
+  RTC_DCHECK_LT(index, outputs_.size());
+  return outputs_[index].dims;
+}
+
+rtc::ArrayView<const float> InferenceSession::output(size_t index) const {
+  RTC_DCHECK_LT(index, outputs_.size());
+  return {outputs_[index].data, outputs_[index].size};
+}
+
+absl::optional<size_t> InferenceSession::FindOutput(
+    absl::string_view name) const {
+  for (size_t i = 0; i < outputs_.size(); ++i) {
+    if (outputs_[i].name == name)
+      return i;
+  }
+  return absl::nullopt;
+}
+
+void InferenceSession::Run() {
+  for (const auto& operation : operations_)
+    operation->Run();
+}
+
+}  // namespace bwe_nn
+}  // namespace webrtc
@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_NN_INFERENCE_SESSION_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_NN_INFERENCE_SESSION_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "modules/remote_bitrate_estimator/bwe_nn/common.h"
+#include "modules/remote_bitrate_estimator/bwe_nn/onnx_model.h"
+#include "rtc_base/constructor_magic.h"
+#include "rtc_base/memory/aligned_malloc.h"
+
+namespace webrtc {
+namespace bwe_nn {
+
+// Runs a small float ONNX model, e.g. a bandwidth estimation policy, without
+// an external runtime. Everything is prepared when the session is created:
+// weights are packed for the SIMD kernels, subgraphs that only depend on
+// weights are folded and every activation is allocated, so Run() neither
+// allocates nor looks anything up.
+//
+// Supported operators are Gemm, MatMul, Add, Sub, Mul, Div, Relu, LeakyRelu,
+// Tanh, Sigmoid, Clip, Concat, Slice, GRU and LSTM (forward, default
+// activations), RandomNormalLike, and the shape operators Constant, Identity,
+// Cast, Dropout, Reshape, Flatten, Squeeze, Unsqueeze, Shape and Gather.
+// Weights of Gemm, MatMul and the recurrent operators must be initializers.
+// Shapes are static; symbolic input dimensions are taken to be 1.
+class InferenceSession {
+ public:
+  // Returns null if |model| uses something that isn't supported.
+  static std::unique_ptr<InferenceSession> Create(const OnnxModel& model,
+                                                  Optimization optimization);
+  ~InferenceSession();
+
+  // Inputs are the graph inputs that aren't initializers, in graph order.
+  size_t num_inputs() const { return inputs_.size(); }
+  const std::string& input_name(size_t index) const;
+  rtc::ArrayView<const int64_t> input_shape(size_t index) const;
+  rtc::ArrayView<float> input(size_t index);
+  absl::optional<size_t> FindInput(absl::string_view name) const;
+
+  size_t num_outputs() const { return outputs_.size(); }
+  const std::string& output_name(size_t index) const;
+  rtc::ArrayView<const int64_t> output_shape(size_t index) const;
+  // Valid after Run().
+  rtc::ArrayView<const float> output(size_t index) const;
+  absl::optional<size_t> FindOutput(absl::string_view name) const;
+
+  void Run();
+
+  // Bytes allocated for packed weights and activations.
+  size_t memory_bytes() const { return memory_bytes_; }
+  Optimization optimization() const { return optimization_; }
+
+  // A step of Run(), defined with the operators in the .cc file.
+  class Operation;
+
+ private:
+  class Builder;
+
+  struct Port {
+    Port();
+    Port(const Port&);
+    ~Port();
+
+    std::string name;
+    std::vector<int64_t> dims;
+    float* data = nullptr;
+    size_t size = 0;
+  };
+
+  explicit InferenceSession(Optimization optimization);
+
+  const Optimization optimization_;
+  std::vector<std::unique_ptr<float, AlignedFreeDeleter>> buffers_;
+  size_t memory_bytes_ = 0;
+  std::vector<std::unique_ptr<Operation>> operations_;
+  std::vector<Port> inputs_;
+  std::vector<Port> outputs_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(InferenceSession);
+};
+
+}  // namespace bwe_nn
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_NN_INFERENCE_SESSION_H_
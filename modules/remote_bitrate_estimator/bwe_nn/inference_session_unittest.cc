@@ -0,0 +1,360 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/bwe_nn/inference_session.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "modules/remote_bitrate_estimator/bwe_nn/test_utils.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace bwe_nn {
+namespace test {
+namespace {
+
+// Outputs of onnxruntime for the models below, built with the onnx python
+// package from the same weights and inputs.
+constexpr float kGemmOutput[] = {
+    2.6593339f, 1.5279779f, 0.f, 0.f, 1.03389f, 0.75584507f, 0.f, 0.f, 0.f,
+    0.18928152f, 1.783083f, 1.3225373f, 0.f, 0.f, 0.037647307f, 0.36084175f,
+    0.f, 0.f,
+};
+constexpr float kMatMulOutput[] = {
+    -0.29728296f, -0.34438124f, -0.34783337f, -0.30749056f, -0.22560827f,
+    -0.10982888f, -0.41997966f, -0.50911921f, -0.53663021f, -0.50511861f,
+    -0.41167384f, -0.25416926f, -0.32101354f, -0.40472639f, -0.43633738f,
+    -0.41596824f, -0.34343675f, -0.22100189f,
+};
+constexpr float kElementwiseOutput[] = {
+    -1.3429034f, -1.445524f, -1.5f, -1.5f, 1.2982395f, -0.071668215f,
+    -1.3157156f, -1.370864f, -1.5f, -1.5f, 0.97583699f, -0.496869f,
+};
+constexpr float kGruOutput[] = {
+    0.97615421f, -0.38375896f, 0.28475276f, 0.4878251f, -0.76883072f,
+    -0.4979983f, 0.83262932f, -0.97969294f, -0.99432558f, 0.95771295f,
+    -0.53478551f, -0.51232767f, 0.062456109f, -0.41206601f, 0.36762208f,
+    0.89739978f, -0.62025774f, 0.77579349f, 0.96447873f, -0.39947471f,
+    0.18861289f, 0.8925764f, 0.75004095f, 0.27721471f, 0.16628766f, 0.17557436f,
+    -0.22752848f, -0.51915884f, 0.076167107f, -0.31048536f, 0.25098622f,
+    0.19609511f, -0.23870224f, -0.59163457f, 0.028247133f, 0.65932918f,
+    -0.21565117f, 0.79736894f, -0.36741138f, 0.10698032f, 0.658108f,
+    -0.74463356f, 0.81869864f, 0.92402506f, 0.69241512f, -0.078197315f,
+    -0.024878994f, 0.067052007f, -0.58966303f, -0.62836957f, 0.034368005f,
+    -0.22119609f, -0.02084446f, 0.44198564f, 0.57795888f, -0.26599777f,
+    0.40044829f, 0.40676576f, -0.4133417f, 0.79533696f, -0.65821755f,
+    -0.1349628f, 0.74173075f, 0.65760773f, 0.4518401f, 0.68663955f,
+};
+constexpr float kGruLinearBeforeResetOutput[] = {
+    0.98294806f, -0.37079483f, 0.52732253f, 0.50793743f, -0.75816667f,
+    -0.49066454f, 0.83866525f, -0.93487227f, -0.99675953f, 0.95878953f,
+    0.077713199f, -0.1586381f, 0.078987844f, -0.40024057f, 0.39275986f,
+    0.93353236f, -0.59262353f, 0.77654105f, 0.97870034f, -0.19685951f,
+    0.18684226f, 0.85850888f, 0.72194046f, 0.31202298f, 0.37613142f,
+    0.18663439f, 0.010901153f, -0.52025795f, 0.10747024f, -0.15228094f,
+    0.340868f, 0.32397389f, -0.095737085f, -0.27429342f, 0.038754579f,
+    0.64047217f, -0.13256089f, 0.81842029f, -0.066193506f, 0.30526027f,
+    0.60649306f, -0.56462592f, 0.84537244f, 0.89915764f, 0.64304394f,
+    0.023990527f, 0.11193146f, 0.12467125f, -0.40105209f, -0.65010887f,
+    0.14168584f, -0.025826069f, -0.080151454f, 0.43046615f, 0.62049866f,
+    -0.058222711f, 0.41535598f, 0.34533751f, -0.30438387f, 0.87810338f,
+    -0.48439398f, 0.074518889f, 0.83658355f, 0.70125288f, 0.52257681f,
+    0.58919954f,
+};
+constexpr float kLstmOutput[] = {
+    0.53010142f, -0.20072609f, -0.039517529f, -0.59111941f, -0.010316375f,
+    -0.50570655f, -0.073328562f, -0.30525753f, -0.4317216f, 0.0085703246f,
+    0.16023453f, -0.12675206f, 0.038473375f, -0.24131346f, 0.033571921f,
+    -0.017436907f, -0.065548383f, 0.17005791f, -0.13791038f, -0.037623584f,
+    0.21013464f, -0.3349213f, -0.075224981f, -0.11898431f, -0.094564259f,
+    -0.071370713f, -0.0037672976f, -0.08692015f, 0.11112047f, 0.063714564f,
+};
+constexpr float kLstmCellOutput[] = {
+    0.2618252f, -0.86589003f, -0.74403882f, -0.14731485f, -0.38363308f,
+    -0.41837972f, -0.0045368075f, -0.4455775f, 0.32038775f, 0.072890341f,
+};
+// Every 16th value of next_hidden_states.
+constexpr float kCorpusModelHiddenStates[] = {
+    0.22279191f,   0.19584157f,  0.077911094f,  -0.012567924f,
+    -0.23108989f,  -0.26726803f, -0.11685141f,  -0.14962184f,
+    -0.084617101f, -0.16043428f, -0.036286198f, -0.050875314f,
+    -0.040142961f, 0.088247277f, 0.28425562f,   0.33861148f,
+};
+
+constexpr float kTolerance = 1e-5f;
+
+OnnxTensor Initializer(const std::string& name,
+                       std::vector<int64_t> dims,
+                       double seed,
+                       double scale = 0.5) {
+  OnnxTensor tensor;
+  tensor.name = name;
+  size_t size = 1;
+  for (int64_t dim : dims)
+    size *= dim;
+  tensor.dims = std::move(dims);
+  tensor.float_data = TestValues(size, seed, scale);
+  return tensor;
+}
+
+OnnxTensor ScalarInitializer(const std::string& name, float value) {
+  OnnxTensor tensor;
+  tensor.name = name;
+  tensor.float_data = {value};
+  return tensor;
+}
+
+OnnxValueInfo FloatValue(const std::string& name, std::vector<int64_t> dims) {
+  OnnxValueInfo info;
+  info.name = name;
+  info.elem_type = 1;
+  info.dims = std::move(dims);
+  return info;
+}
+
+OnnxAttribute IntAttribute(const std::string& name, int64_t value) {
+  OnnxAttribute attribute;
+  attribute.name = name;
+  attribute.i = value;
+  return attribute;
+}
+
+OnnxAttribute FloatAttribute(const std::string& name, float value) {
+  OnnxAttribute attribute;
+  attribute.name = name;
+  attribute.f = value;
+  return attribute;
+}
+
+OnnxNode Node(const std::string& op_type,
+              std::vector<std::string> inputs,
+              std::vector<std::string> outputs,
+              std::vector<OnnxAttribute> attributes = {}) {
+  OnnxNode node;
+  node.op_type = op_type;
+  node.inputs = std::move(inputs);
+  node.outputs = std::move(outputs);
+  node.attributes = std::move(attributes);
+  return node;
+}
+
+// Runs |model| with every optimization, with TestValues(size, seed, 1) as
+// input, and compares the outputs to |expected_outputs|.
+void ExpectOutputs(
+    const OnnxModel& model,
+    const std::vector<double>& input_seeds,
+    const std::vector<rtc::ArrayView<const float>>& expected_outputs) {
+  for (Optimization optimization : GetAvailableOptimizations()) {
+    SCOPED_TRACE(static_cast<int>(optimization));
+    std::unique_ptr<InferenceSession> session =
+        InferenceSession::Create(model, optimization);
+    ASSERT_TRUE(session);
+    ASSERT_EQ(session->num_inputs(), input_seeds.size());
+    for (size_t i = 0; i < input_seeds.size(); ++i) {
+      rtc::ArrayView<float> input = session->input(i);
+      const std::vector<float> values =
+          TestValues(input.size(), input_seeds[i], 1.0);
+      std::copy(values.begin(), values.end(), input.begin());
+    }
+    session->Run();
+    ASSERT_EQ(session->num_outputs(), expected_outputs.size());
+    for (size_t o = 0; o < expected_outputs.size(); ++o) {
+      rtc::ArrayView<const float> output = session->output(o);
+      ASSERT_EQ(output.size(), expected_outputs[o].size());
+      for (size_t i = 0; i < output.size(); ++i)
+        EXPECT_NEAR(output[i], expected_outputs[o][i], kTolerance) << i;
+    }
+  }
+}
+
+TEST(BweNnInferenceSessionTest, GemmAndRelu) {
+  OnnxModel model;
+  model.nodes = {Node("Gemm", {"x", "w", "c"}, {"g"},
+                      {FloatAttribute("alpha", 0.5f),
+                       FloatAttribute("beta", 2.f), IntAttribute("transB", 1)}),
+                 Node("Relu", {"g"}, {"y"})};
+  model.initializers = {Initializer("w", {9, 13}, 1.0),
+                        Initializer("c", {9}, 2.0)};
+  model.inputs = {FloatValue("x", {2, 13})};
+  model.outputs = {FloatValue("y", {})};
+  ExpectOutputs(model, {0.5}, {kGemmOutput});
+}
+
+TEST(BweNnInferenceSessionTest, MatMulAddAndTanh) {
+  OnnxModel model;
+  model.nodes = {Node("MatMul", {"x", "w"}, {"m"}),
+                 Node("Add", {"m", "b"}, {"a"}), Node("Tanh", {"a"}, {"y"})};
+  model.initializers = {Initializer("w", {10, 6}, 3.0),
+                        Initializer("b", {6}, 4.0)};
+  model.inputs = {FloatValue("x", {1, 3, 10})};
+  model.outputs = {FloatValue("y", {})};
+  ExpectOutputs(model, {0.25}, {kMatMulOutput});
+}
+
+TEST(BweNnInferenceSessionTest, ElementwiseWithBroadcastAndConcat) {
+  OnnxModel model;
+  model.nodes = {
+      Node("Sigmoid", {"x"}, {"s"}),
+      Node("LeakyRelu", {"x"}, {"l"}, {FloatAttribute("alpha", 0.1f)}),
+      Node("Concat", {"s", "l"}, {"c"}, {IntAttribute("axis", 1)}),
+      Node("Sub", {"c", "k"}, {"d"}),
+      Node("Mul", {"d", "x2"}, {"e"}),
+      Node("Div", {"e", "k"}, {"f"}),
+      Node("Clip", {"f", "lo", "hi"}, {"y"})};
+  model.initializers = {Initializer("k", {1, 6}, 5.0, 2.0),
+                        ScalarInitializer("lo", -1.5f),
+                        ScalarInitializer("hi", 1.5f)};
+  model.inputs = {FloatValue("x", {2, 3}), FloatValue("x2", {2, 1})};
+  model.outputs = {FloatValue("y", {})};
+  ExpectOutputs(model, {0.75, 1.5}, {kElementwiseOutput});
+}
+
+OnnxModel GruModel(bool linear_before_reset) {
+  OnnxModel model;
+  model.nodes = {Node("GRU", {"x", "w", "r", "b", "", "h0"}, {"y", "yh"},
+                      {IntAttribute("hidden_size", 11),
+                       IntAttribute("linear_before_reset",
+                                    linear_before_reset ? 1 : 0)})};
+  model.initializers = {Initializer("w", {1, 33, 5}, 6.0),
+                        Initializer("r", {1, 33, 11}, 7.0),
+                        Initializer("b", {1, 66}, 8.0)};
+  model.inputs = {FloatValue("x", {3, 2, 5}), FloatValue("h0", {1, 2, 11})};
+  model.outputs = {FloatValue("y", {}), FloatValue("yh", {})};
+  return model;
+}
+
+TEST(BweNnInferenceSessionTest, Gru) {
+  // The final state is the last step of the output.
+  const rtc::ArrayView<const float> output = kGruOutput;
+  ExpectOutputs(GruModel(false), {1.25, 1.75},
+                {output, output.subview(2 * 2 * 11)});
+}
+
+TEST(BweNnInferenceSessionTest, GruWithLinearBeforeReset) {
+  const rtc::ArrayView<const float> output = kGruLinearBeforeResetOutput;
+  ExpectOutputs(GruModel(true), {1.25, 1.75},
+                {output, output.subview(2 * 2 * 11)});
+}
+
+TEST(BweNnInferenceSessionTest, Lstm) {
+  OnnxModel model;
+  model.nodes = {Node("LSTM", {"x", "w", "r", "b", "", "h0", "c0"},
+                      {"y", "yh", "yc"}, {IntAttribute("hidden_size", 10)})};
+  model.initializers = {Initializer("w", {1, 40, 6}, 9.0),
+                        Initializer("r", {1, 40, 10}, 10.0),
+                        Initializer("b", {1, 80}, 11.0)};
+  model.inputs = {FloatValue("x", {3, 1, 6}), FloatValue("h0", {1, 1, 10}),
+                  FloatValue("c0", {1, 1, 10})};
+  model.outputs = {FloatValue("y", {}), FloatValue("yh", {}),
+                   FloatValue("yc", {})};
+  const rtc::ArrayView<const float> output = kLstmOutput;
+  ExpectOutputs(model, {2.25, 2.5, 2.75},
+                {output, output.subview(2 * 10), kLstmCellOutput});
+}
+
+TEST(BweNnInferenceSessionTest, FoldsConstantSubgraphs) {
+  // Reorders the rows of the weights like the PyTorch GRU export does, and
+  // reshapes the input.
+  OnnxModel model;
+  OnnxAttribute axes;
+  axes.name = "axes";
+  axes.ints = {0};
+  OnnxAttribute starts;
+  starts.name = "starts";
+  starts.ints = {2};
+  OnnxAttribute ends;
+  ends.name = "ends";
+  ends.ints = {4};
+  model.nodes = {
+      Node("Slice", {"w"}, {"w_tail"}, {axes, starts, ends}),
+      Node("Concat", {"w_tail", "w"}, {"w_cat"}, {IntAttribute("axis", 0)}),
+      Node("Flatten", {"x"}, {"x_flat"}, {IntAttribute("axis", 1)}),
+      Node("Gemm", {"x_flat", "w_cat"}, {"y"}, {IntAttribute("transB", 1)})};
+  model.initializers = {Initializer("w", {4, 3}, 12.0)};
+  model.inputs = {FloatValue("x", {1, 1, 3})};
+  model.outputs = {FloatValue("y", {})};
+
+  std::unique_ptr<InferenceSession> session =
+      InferenceSession::Create(model, Optimization::kNone);
+  ASSERT_TRUE(session);
+  const std::vector<float> x = TestValues(3, 3.0, 1.0);
+  std::copy(x.begin(), x.end(), session->input(0).begin());
+  session->Run();
+  const std::vector<float> w = TestValues(12, 12.0, 0.5);
+  const int kRows[] = {2, 3, 0, 1, 2, 3};
+  ASSERT_EQ(session->output(0).size(), 6u);
+  for (size_t i = 0; i < 6; ++i) {
+    float expected = 0.f;
+    for (size_t c = 0; c < 3; ++c)
+      expected += w[kRows[i] * 3 + c] * x[c];
+    EXPECT_NEAR(session->output(0)[i], expected, kTolerance);
+  }
+}
+
+TEST(BweNnInferenceSessionTest, SkipsNodesThatOutputsDontDependOn) {
+  OnnxModel model;
+  model.nodes = {Node("Relu", {"x"}, {"y"}),
+                 Node("NotAnOperator", {"x"}, {"unused"})};
+  model.inputs = {FloatValue("x", {4})};
+  model.outputs = {FloatValue("y", {})};
+  EXPECT_TRUE(InferenceSession::Create(model, Optimization::kNone));
+
+  model.outputs.push_back(FloatValue("unused", {}));
+  EXPECT_FALSE(InferenceSession::Create(model, Optimization::kNone));
+}
+
+TEST(BweNnInferenceSessionTest, RejectsUnsupportedAttributes) {
+  OnnxModel model = GruModel(false);
+  OnnxAttribute direction;
+  direction.name = "direction";
+  direction.s = "bidirectional";
+  model.nodes[0].attributes.push_back(direction);
+  EXPECT_FALSE(InferenceSession::Create(model, Optimization::kNone));
+}
+
+TEST(BweNnInferenceSessionTest, RunsCorpusModel) {
+  absl::optional<OnnxModel> model = ReadOnnxModelFile(GetCorpusModelPath());
+  ASSERT_TRUE(model);
+  for (Optimization optimization : GetAvailableOptimizations()) {
+    SCOPED_TRACE(static_cast<int>(optimization));
+    std::unique_ptr<InferenceSession> session =
+        InferenceSession::Create(*model, optimization);
+    ASSERT_TRUE(session);
+    EXPECT_GT(session->memory_bytes(), 0u);
+    const absl::optional<size_t> states = session->FindInput("states");
+    const absl::optional<size_t> hidden_states =
+        session->FindInput("hidden_states");
+    const absl::optional<size_t> next_hidden_states =
+        session->FindOutput("next_hidden_states");
+    ASSERT_TRUE(states && hidden_states && next_hidden_states);
+    // Weights that are listed as inputs as well aren't inputs of the session.
+    EXPECT_EQ(session->num_inputs(), 2u);
+
+    std::vector<float> values = TestValues(4, 0.5, 1.0);
+    std::copy(values.begin(), values.end(), session->input(*states).begin());
+    values = TestValues(256, 1.0, 0.5);
+    std::copy(values.begin(), values.end(),
+              session->input(*hidden_states).begin());
+    session->Run();
+
+    // The action is sampled, so only the recurrent state is compared.
+    rtc::ArrayView<const float> output = session->output(*next_hidden_states);
+    ASSERT_EQ(output.size(), 256u);
+    for (size_t i = 0; i < 16; ++i)
+      EXPECT_NEAR(output[16 * i], kCorpusModelHiddenStates[i], kTolerance);
+  }
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace bwe_nn
+}  // namespace webrtc
@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/bwe_nn/kernels.h"
+
+#include <stdint.h>
+
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace bwe_nn {
+namespace {
+
+void MatVecScalar(const float* weights,
+                  size_t stride,
+                  const float* bias,
+                  const float* x,
+                  size_t columns,
+                  float* y,
+                  size_t rows) {
+  for (size_t r = 0; r < rows; ++r) {
+    const float* row = weights + r * stride;
+    float sum = bias ? bias[r] : 0.f;
+    for (size_t c = 0; c < columns; ++c) {
+      sum += row[c] * x[c];
+    }
+    y[r] = sum;
+  }
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void MatVecSse2(const float* weights,
+                size_t stride,
+                const float* bias,
+                const float* x,
+                size_t columns,
+                float* y,
+                size_t rows) {
+  const size_t vectorized_columns = columns & ~size_t{3};
+  for (size_t r = 0; r < rows; ++r) {
+    const float* row = weights + r * stride;
+    __m128 accumulator = _mm_setzero_ps();
+    size_t c = 0;
+    for (; c < vectorized_columns; c += 4) {
+      accumulator = _mm_add_ps(
+          accumulator, _mm_mul_ps(_mm_load_ps(row + c), _mm_loadu_ps(x + c)));
+    }
+    // Add the upper and lower halves, then the remaining two lanes.
+    accumulator =
+        _mm_add_ps(accumulator, _mm_movehl_ps(accumulator, accumulator));
+    accumulator = _mm_add_ss(accumulator,
+                             _mm_shuffle_ps(accumulator, accumulator, 0x55));
+    float sum = _mm_cvtss_f32(accumulator);
+    for (; c < columns; ++c) {
+      sum += row[c] * x[c];
+    }
+    y[r] = (bias ? bias[r] : 0.f) + sum;
+  }
+}
+#endif
+
+}  // namespace
+
+void MatVec(Optimization optimization,
+            rtc::ArrayView<const float> weights,
+            size_t stride,
+            rtc::ArrayView<const float> bias,
+            rtc::ArrayView<const float> x,
+            rtc::ArrayView<float> y) {
+  RTC_DCHECK_EQ(stride, PackedStride(x.size()));
+  RTC_DCHECK_GE(weights.size(), (y.size() - 1) * stride + x.size());
+  RTC_DCHECK_EQ(reinterpret_cast<uintptr_t>(weights.data()) % kAlignmentBytes,
+                0);
+  RTC_DCHECK(bias.empty() || bias.size() == y.size());
+  const float* bias_data = bias.empty() ? nullptr : bias.data();
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Optimization::kAvx2:
+      kernels_internal::MatVecAvx2(weights.data(), stride, bias_data, x.data(),
+                                   x.size(), y.data(), y.size());
+      break;
+    case Optimization::kSse2:
+      MatVecSse2(weights.data(), stride, bias_data, x.data(), x.size(),
+                 y.data(), y.size());
+      break;
+#endif
+    default:
+      MatVecScalar(weights.data(), stride, bias_data, x.data(), x.size(),
+                   y.data(), y.size());
+  }
+}
+
+}  // namespace bwe_nn
+}  // namespace webrtc
@@ -0,0 +1,54 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_NN_KERNELS_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_NN_KERNELS_H_
+
+#include <stddef.h>
+
+#include "api/array_view.h"
+#include "modules/remote_bitrate_estimator/bwe_nn/common.h"
+
+namespace webrtc {
+namespace bwe_nn {
+
+// Returns the distance in floats between the rows of a packed matrix with
+// |columns| columns, so that every row is aligned to kAlignmentBytes.
+constexpr size_t PackedStride(size_t columns) {
+  return (columns + kAlignmentFloats - 1) / kAlignmentFloats *
+         kAlignmentFloats;
+}
+
+// Computes y[r] = bias[r] + sum_c(weights[r * stride + c] * x[c]). |weights|
+// holds y.size() rows of x.size() columns; it must be aligned to
+// kAlignmentBytes and |stride| must be PackedStride(x.size()). |bias| is
+// either empty or has the size of |y|, and may be the same array as |y|.
+void MatVec(Optimization optimization,
+            rtc::ArrayView<const float> weights,
+            size_t stride,
+            rtc::ArrayView<const float> bias,
+            rtc::ArrayView<const float> x,
+            rtc::ArrayView<float> y);
+
+namespace kernels_internal {
+
+void MatVecAvx2(const float* weights,
+                size_t stride,
+                const float* bias,
+                const float* x,
+                size_t columns,
+                float* y,
+                size_t rows);
+
+}  // namespace kernels_internal
+}  // namespace bwe_nn
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_NN_KERNELS_H_
@@ -0,0 +1,50 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "modules/remote_bitrate_estimator/bwe_nn/kernels.h"
+
+namespace webrtc {
+namespace bwe_nn {
+namespace kernels_internal {
+
+// Built with AVX2 and FMA enabled, only called when the CPU supports both.
+void MatVecAvx2(const float* weights,
+                size_t stride,
+                const float* bias,
+                const float* x,
+                size_t columns,
+                float* y,
+                size_t rows) {
+  const size_t vectorized_columns = columns & ~size_t{7};
+  for (size_t r = 0; r < rows; ++r) {
+    const float* row = weights + r * stride;
+    __m256 accumulator = _mm256_setzero_ps();
+    size_t c = 0;
+    for (; c < vectorized_columns; c += 8) {
+      accumulator = _mm256_fmadd_ps(_mm256_load_ps(row + c),
+                                    _mm256_loadu_ps(x + c), accumulator);
+    }
+    __m128 sum4 = _mm_add_ps(_mm256_castps256_ps128(accumulator),
+                             _mm256_extractf128_ps(accumulator, 1));
+    sum4 = _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4));
+    sum4 = _mm_add_ss(sum4, _mm_shuffle_ps(sum4, sum4, 0x55));
+    float sum = _mm_cvtss_f32(sum4);
+    for (; c < columns; ++c) {
+      sum += row[c] * x[c];
+    }
+    y[r] = (bias ? bias[r] : 0.f) + sum;
+  }
+}
+
+}  // namespace kernels_internal
+}  // namespace bwe_nn
+}  // namespace webrtc
@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/bwe_nn/kernels.h"
+
+#include <memory>
+#include <vector>
+
+#include "modules/remote_bitrate_estimator/bwe_nn/test_utils.h"
+#include "rtc_base/memory/aligned_malloc.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace bwe_nn {
+namespace test {
+namespace {
+
+std::unique_ptr<float, AlignedFreeDeleter> PackedTestWeights(size_t rows,
+                                                             size_t columns) {
+  const size_t stride = PackedStride(columns);
+  std::unique_ptr<float, AlignedFreeDeleter> weights(
+      AlignedMalloc<float>(rows * stride * sizeof(float), kAlignmentBytes));
+  const std::vector<float> values = TestValues(rows * columns, 0.1, 0.5);
+  for (size_t r = 0; r < rows; ++r) {
+    for (size_t c = 0; c < stride; ++c)
+      weights.get()[r * stride + c] = c < columns ? values[r * columns + c] : 0;
+  }
+  return weights;
+}
+
+TEST(BweNnKernelsTest, PackedStrideIsAlignedAndLargeEnough) {
+  EXPECT_EQ(PackedStride(1), kAlignmentFloats);
+  EXPECT_EQ(PackedStride(kAlignmentFloats), kAlignmentFloats);
+  EXPECT_EQ(PackedStride(kAlignmentFloats + 1), 2 * kAlignmentFloats);
+}
+
+TEST(BweNnKernelsTest, MatVecMatchesReference) {
+  // Sizes that leave a remainder for every vector width.
+  for (size_t columns : {1, 3, 4, 7, 8, 13, 64, 129}) {
+    const size_t rows = 5;
+    const size_t stride = PackedStride(columns);
+    const auto weights = PackedTestWeights(rows, columns);
+    const std::vector<float> x = TestValues(columns, 1.3, 1.0);
+    const std::vector<float> bias = TestValues(rows, 2.7, 1.0);
+    std::vector<float> expected(rows);
+    for (size_t r = 0; r < rows; ++r) {
+      double sum = bias[r];
+      for (size_t c = 0; c < columns; ++c)
+        sum += weights.get()[r * stride + c] * x[c];
+      expected[r] = static_cast<float>(sum);
+    }
+
+    for (Optimization optimization : GetAvailableOptimizations()) {
+      SCOPED_TRACE(static_cast<int>(optimization));
+      SCOPED_TRACE(columns);
+      std::vector<float> y(rows);
+      MatVec(optimization, {weights.get(), rows * stride}, stride, bias, x, y);
+      for (size_t r = 0; r < rows; ++r)
+        EXPECT_NEAR(y[r], expected[r], 1e-5f);
+
+      // Without bias, and with the bias in the output.
+      MatVec(optimization, {weights.get(), rows * stride}, stride, {}, x, y);
+      for (size_t r = 0; r < rows; ++r)
+        EXPECT_NEAR(y[r] + bias[r], expected[r], 1e-5f);
+      y = bias;
+      MatVec(optimization, {weights.get(), rows * stride}, stride, y, x, y);
+      for (size_t r = 0; r < rows; ++r)
+        EXPECT_NEAR(y[r], expected[r], 1e-5f);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace bwe_nn
+}  // namespace webrtc
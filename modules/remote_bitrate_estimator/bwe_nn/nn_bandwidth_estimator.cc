@@ -0,0 +1,195 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/bwe_nn/nn_bandwidth_estimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace bwe_nn {
+namespace {
+
+constexpr size_t kNumFeatures = 4;
+// Range of the log scale, as in the gym.
+constexpr float kMinBandwidthBps = 10000.f;
+constexpr float kMaxBandwidthBps = 8000000.f;
+// Until the first estimate.
+constexpr float kInitialEstimateBps = 300000.f;
+constexpr float kMaxDelayS = 1.f;
+
+bool SameShape(rtc::ArrayView<const int64_t> a,
+               rtc::ArrayView<const int64_t> b) {
+  return std::equal(a.begin(), a.end(), b.begin(), b.end());
+}
+
+}  // namespace
+
+std::unique_ptr<NnBandwidthEstimator> NnBandwidthEstimator::Create(
+    const std::string& model_path) {
+  absl::optional<OnnxModel> model = ReadOnnxModelFile(model_path);
+  if (!model)
+    return nullptr;
+  return Create(*model, DetectOptimization());
+}
+
+std::unique_ptr<NnBandwidthEstimator> NnBandwidthEstimator::Create(
+    const OnnxModel& model,
+    Optimization optimization) {
+  std::unique_ptr<InferenceSession> session =
+      InferenceSession::Create(model, optimization);
+  if (!session)
+    return nullptr;
+
+  // Inputs fed from an output of the same shape are recurrent state, the
+  // remaining input is the state of the gym.
+  std::vector<std::pair<size_t, size_t>> recurrent;
+  std::vector<bool> output_used(session->num_outputs(), false);
+  absl::optional<size_t> state_input;
+  for (size_t i = 0; i < session->num_inputs(); ++i) {
+    bool is_recurrent = false;
+    for (size_t o = 0; o < session->num_outputs() && !is_recurrent; ++o) {
+      if (!output_used[o] && session->output(o).size() > 1 &&
+          SameShape(session->input_shape(i), session->output_shape(o))) {
+        recurrent.emplace_back(o, i);
+        output_used[o] = true;
+        is_recurrent = true;
+      }
+    }
+    if (is_recurrent)
+      continue;
+    if (state_input || session->input(i).size() != kNumFeatures) {
+      RTC_LOG(LS_WARNING) << "Unexpected model input "
+                          << session->input_name(i);
+      return nullptr;
+    }
+    state_input = i;
+  }
+  absl::optional<size_t> action_output;
+  for (size_t o = 0; o < session->num_outputs(); ++o) {
+    if (!output_used[o] && session->output(o).size() == 1) {
+      action_output = o;
+      break;
+    }
+  }
+  if (!state_input || !action_output) {
+    RTC_LOG(LS_WARNING) << "Model has no state input or action output.";
+    return nullptr;
+  }
+  return std::unique_ptr<NnBandwidthEstimator>(
+      new NnBandwidthEstimator(std::move(session), *state_input,
+                               *action_output, std::move(recurrent)));
+}
+
+NnBandwidthEstimator::NnBandwidthEstimator(
+    std::unique_ptr<InferenceSession> session,
+    size_t state_input,
+    size_t action_output,
+    std::vector<std::pair<size_t, size_t>> recurrent)
+    : session_(std::move(session)),
+      state_input_(state_input),
+      action_output_(action_output),
+      recurrent_(std::move(recurrent)),
+      last_estimate_bps_(kInitialEstimateBps) {}
+
+NnBandwidthEstimator::~NnBandwidthEstimator() = default;
+
+void NnBandwidthEstimator::OnReceived(int64_t arrival_time_ms,
+                                      int64_t send_time_ms,
+                                      uint32_t ssrc,
+                                      uint16_t sequence_number,
+                                      size_t payload_size) {
+  // Queuing delay is relative to the first packet, as clocks aren't synced.
+  const int64_t one_way_delay_ms = arrival_time_ms - send_time_ms;
+  if (!base_delay_ms_)
+    base_delay_ms_ = one_way_delay_ms;
+  delay_sum_ms_ += one_way_delay_ms - *base_delay_ms_;
+  received_bytes_ += payload_size;
+  ++received_packets_;
+
+  // Sequence numbers are per SSRC, so is the range they span.
+  Stream& stream = streams_[ssrc];
+  const int64_t unwrapped = stream.unwrapper.Unwrap(sequence_number);
+  if (!stream.first_sequence_number) {
+    stream.first_sequence_number = unwrapped;
+    stream.last_sequence_number = unwrapped;
+  }
+  stream.first_sequence_number =
+      std::min(*stream.first_sequence_number, unwrapped);
+  stream.last_sequence_number =
+      std::max(stream.last_sequence_number, unwrapped);
+  if (!last_estimate_time_ms_)
+    last_estimate_time_ms_ = arrival_time_ms;
+}
+
+float NnBandwidthEstimator::GetBweEstimate(int64_t now_ms) {
+  if (!last_estimate_time_ms_ || now_ms <= *last_estimate_time_ms_)
+    return last_estimate_bps_;
+
+  const float interval_s = (now_ms - *last_estimate_time_ms_) / 1000.f;
+  const float receiving_rate_bps = received_bytes_ * 8 / interval_s;
+  const float delay_s =
+      received_packets_ > 0 ? delay_sum_ms_ / (1000.f * received_packets_)
+                            : 0.f;
+  int64_t expected = 0;
+  for (auto& ssrc_and_stream : streams_) {
+    Stream& stream = ssrc_and_stream.second;
+    if (stream.first_sequence_number) {
+      expected +=
+          stream.last_sequence_number - *stream.first_sequence_number + 1;
+      stream.first_sequence_number.reset();
+    }
+  }
+  float loss_ratio = 0.f;
+  if (expected > 0) {
+    const int64_t lost = expected - static_cast<int64_t>(received_packets_);
+    loss_ratio = std::max<float>(0.f, static_cast<float>(lost) / expected);
+  }
+
+  rtc::ArrayView<float> state = session_->input(state_input_);
+  state[0] = LinearToLog(receiving_rate_bps);
+  state[1] = std::min(std::max(delay_s, 0.f), kMaxDelayS);
+  state[2] = loss_ratio;
+  state[3] = LinearToLog(last_estimate_bps_);
+  session_->Run();
+  for (const auto& output_and_input : recurrent_) {
+    rtc::ArrayView<const float> output =
+        session_->output(output_and_input.first);
+    std::copy(output.begin(), output.end(),
+              session_->input(output_and_input.second).begin());
+  }
+  last_estimate_bps_ = LogToLinear(session_->output(action_output_)[0]);
+
+  last_estimate_time_ms_ = now_ms;
+  received_bytes_ = 0;
+  received_packets_ = 0;
+  delay_sum_ms_ = 0;
+  return last_estimate_bps_;
+}
+
+float NnBandwidthEstimator::LinearToLog(float bps) {
+  const float clamped = std::min(std::max(bps, kMinBandwidthBps),
+                                 kMaxBandwidthBps);
+  return (std::log(clamped) - std::log(kMinBandwidthBps)) /
+         (std::log(kMaxBandwidthBps) - std::log(kMinBandwidthBps));
+}
+
+float NnBandwidthEstimator::LogToLinear(float value) {
+  const float clamped = std::min(std::max(value, 0.f), 1.f);
+  return std::exp(clamped * (std::log(kMaxBandwidthBps) -
+                             std::log(kMinBandwidthBps)) +
+                  std::log(kMinBandwidthBps));
+}
+
+}  // namespace bwe_nn
+}  // namespace webrtc
@@ -0,0 +1,99 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_NN_NN_BANDWIDTH_ESTIMATOR_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_NN_NN_BANDWIDTH_ESTIMATOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "modules/remote_bitrate_estimator/bwe_nn/inference_session.h"
+#include "rtc_base/constructor_magic.h"
+#include "rtc_base/numerics/sequence_number_util.h"
+
+namespace webrtc {
+namespace bwe_nn {
+
+// Receive side bandwidth estimation with a reinforcement learning policy, run
+// by InferenceSession instead of the onnxinfer library. The policy sees the
+// state of the AlphaRTC gym for the packets since the previous estimate:
+// receiving rate and previous estimate on a log scale, average queuing delay
+// in seconds (capped at 1) and loss ratio. Its action is the estimate on the
+// same log scale. Recurrent state, i.e. inputs with an output of the same
+// shape, is carried over from one estimate to the next.
+class NnBandwidthEstimator {
+ public:
+  // Returns null if the model can't be loaded or doesn't have a state input
+  // of 4 features and an action output.
+  static std::unique_ptr<NnBandwidthEstimator> Create(
+      const std::string& model_path);
+  static std::unique_ptr<NnBandwidthEstimator> Create(
+      const OnnxModel& model,
+      Optimization optimization);
+  ~NnBandwidthEstimator();
+
+  void OnReceived(int64_t arrival_time_ms,
+                  int64_t send_time_ms,
+                  uint32_t ssrc,
+                  uint16_t sequence_number,
+                  size_t payload_size);
+
+  // Runs the policy and returns the estimate in bps.
+  float GetBweEstimate(int64_t now_ms);
+
+  const InferenceSession& session() const { return *session_; }
+
+  // Maps between bps and the [0, 1] log scale of the policy.
+  static float LinearToLog(float bps);
+  static float LogToLinear(float value);
+
+ private:
+  // Sequence numbers of one SSRC, for the loss ratio.
+  struct Stream {
+    SeqNumUnwrapper<uint16_t> unwrapper;
+    // Range of the packets since the previous estimate.
+    absl::optional<int64_t> first_sequence_number;
+    int64_t last_sequence_number = 0;
+  };
+
+  NnBandwidthEstimator(std::unique_ptr<InferenceSession> session,
+                       size_t state_input,
+                       size_t action_output,
+                       std::vector<std::pair<size_t, size_t>> recurrent);
+
+  const std::unique_ptr<InferenceSession> session_;
+  const size_t state_input_;
+  const size_t action_output_;
+  // Pairs of output and input indices.
+  const std::vector<std::pair<size_t, size_t>> recurrent_;
+
+  std::map<uint32_t, Stream> streams_;
+  absl::optional<int64_t> base_delay_ms_;
+  // Packets since the previous estimate.
+  size_t received_bytes_ = 0;
+  size_t received_packets_ = 0;
+  int64_t delay_sum_ms_ = 0;
+  absl::optional<int64_t> last_estimate_time_ms_;
+  float last_estimate_bps_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(NnBandwidthEstimator);
+};
+
+}  // namespace bwe_nn
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_NN_NN_BANDWIDTH_ESTIMATOR_H_
@@ -0,0 +1,199 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/bwe_nn/nn_bandwidth_estimator.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modules/remote_bitrate_estimator/bwe_nn/test_utils.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace bwe_nn {
+namespace test {
+namespace {
+
+constexpr float kTolerance = 1e-4f;
+constexpr uint32_t kSsrc = 0x1234;
+
+OnnxValueInfo FloatValue(const std::string& name, std::vector<int64_t> dims) {
+  OnnxValueInfo info;
+  info.name = name;
+  info.elem_type = 1;
+  info.dims = std::move(dims);
+  return info;
+}
+
+OnnxTensor Tensor(const std::string& name,
+                  std::vector<int64_t> dims,
+                  std::vector<float> values) {
+  OnnxTensor tensor;
+  tensor.name = name;
+  tensor.dims = std::move(dims);
+  tensor.float_data = std::move(values);
+  return tensor;
+}
+
+// A policy whose action is one feature of the state.
+OnnxModel FeatureModel(size_t feature) {
+  std::vector<float> weights(4, 0.f);
+  weights[feature] = 1.f;
+  OnnxModel model;
+  OnnxNode gemm;
+  gemm.op_type = "Gemm";
+  gemm.inputs = {"state", "w"};
+  gemm.outputs = {"action"};
+  OnnxAttribute trans_b;
+  trans_b.name = "transB";
+  trans_b.i = 1;
+  gemm.attributes = {trans_b};
+  model.nodes = {gemm};
+  model.initializers = {Tensor("w", {1, 4}, weights)};
+  model.inputs = {FloatValue("state", {1, 4})};
+  model.outputs = {FloatValue("action", {1, 1})};
+  return model;
+}
+
+// Receives 100 packets of 1250 bytes in one second, 1 Mbps, skipping every
+// |loss_period|th sequence number. The one way delay grows by 1 ms per
+// packet.
+void ReceiveOneSecond(NnBandwidthEstimator* estimator,
+                      int64_t start_ms,
+                      int loss_period) {
+  uint16_t sequence_number = 0;
+  for (int i = 0; i < 100; ++i) {
+    if (loss_period > 0 && sequence_number % loss_period == loss_period - 1)
+      ++sequence_number;
+    const int64_t arrival_time_ms = start_ms + 10 * i;
+    estimator->OnReceived(arrival_time_ms, arrival_time_ms - 50 - i, kSsrc,
+                          sequence_number++, 1250);
+  }
+}
+
+TEST(NnBandwidthEstimatorTest, LogScaleRoundTrips) {
+  EXPECT_FLOAT_EQ(NnBandwidthEstimator::LinearToLog(10000), 0.f);
+  EXPECT_FLOAT_EQ(NnBandwidthEstimator::LinearToLog(8000000), 1.f);
+  EXPECT_FLOAT_EQ(NnBandwidthEstimator::LinearToLog(1), 0.f);
+  EXPECT_NEAR(NnBandwidthEstimator::LogToLinear(
+                  NnBandwidthEstimator::LinearToLog(1000000)),
+              1000000, 1);
+}
+
+TEST(NnBandwidthEstimatorTest, ReportsReceivingRate) {
+  auto estimator =
+      NnBandwidthEstimator::Create(FeatureModel(0), Optimization::kNone);
+  ASSERT_TRUE(estimator);
+  ReceiveOneSecond(estimator.get(), 1000, 0);
+  // 99 packets are received after the first one, which starts the interval.
+  EXPECT_NEAR(estimator->GetBweEstimate(2000), 1000000, 1000000 * 0.02);
+}
+
+TEST(NnBandwidthEstimatorTest, ReportsQueuingDelay) {
+  auto estimator =
+      NnBandwidthEstimator::Create(FeatureModel(1), Optimization::kNone);
+  ASSERT_TRUE(estimator);
+  ReceiveOneSecond(estimator.get(), 1000, 0);
+  // The average delay above the first packet is 49.5 ms.
+  EXPECT_NEAR(NnBandwidthEstimator::LinearToLog(
+                  estimator->GetBweEstimate(2000)),
+              0.0495f, kTolerance);
+}
+
+TEST(NnBandwidthEstimatorTest, ReportsLossRatio) {
+  auto estimator =
+      NnBandwidthEstimator::Create(FeatureModel(2), Optimization::kNone);
+  ASSERT_TRUE(estimator);
+  ReceiveOneSecond(estimator.get(), 1000, 10);
+  EXPECT_NEAR(NnBandwidthEstimator::LinearToLog(
+                  estimator->GetBweEstimate(2000)),
+              0.1f, 0.01f);
+}
+
+TEST(NnBandwidthEstimatorTest, ReportsLossRatioAcrossSsrcs) {
+  auto estimator =
+      NnBandwidthEstimator::Create(FeatureModel(2), Optimization::kNone);
+  ASSERT_TRUE(estimator);
+  // Two interleaved streams with unrelated sequence numbers, each skipping
+  // every 10th one.
+  uint16_t sequence_numbers[] = {0, 40000};
+  for (int i = 0; i < 100; ++i) {
+    uint16_t& sequence_number = sequence_numbers[i % 2];
+    if (sequence_number % 10 == 9)
+      ++sequence_number;
+    const int64_t arrival_time_ms = 1000 + 10 * i;
+    estimator->OnReceived(arrival_time_ms, arrival_time_ms - 50, kSsrc + i % 2,
+                          sequence_number++, 1250);
+  }
+  EXPECT_NEAR(NnBandwidthEstimator::LinearToLog(
+                  estimator->GetBweEstimate(2000)),
+              0.1f, 0.02f);
+}
+
+TEST(NnBandwidthEstimatorTest, FeedsBackPreviousEstimate) {
+  auto estimator =
+      NnBandwidthEstimator::Create(FeatureModel(3), Optimization::kNone);
+  ASSERT_TRUE(estimator);
+  ReceiveOneSecond(estimator.get(), 1000, 0);
+  const float first = estimator->GetBweEstimate(2000);
+  ReceiveOneSecond(estimator.get(), 2000, 0);
+  EXPECT_NEAR(estimator->GetBweEstimate(3000), first, first * kTolerance);
+}
+
+TEST(NnBandwidthEstimatorTest, CarriesRecurrentState) {
+  // h_next = h + 1, action = 0.1 * h_next[0].
+  OnnxModel model;
+  OnnxNode add;
+  add.op_type = "Add";
+  add.inputs = {"h", "one"};
+  add.outputs = {"h_next"};
+  OnnxNode gemm;
+  gemm.op_type = "Gemm";
+  gemm.inputs = {"h_next", "w"};
+  gemm.outputs = {"action"};
+  model.nodes = {add, gemm};
+  model.initializers = {Tensor("one", {}, {1.f}),
+                        Tensor("w", {2, 1}, {0.1f, 0.f})};
+  model.inputs = {FloatValue("state", {1, 4}), FloatValue("h", {1, 2})};
+  model.outputs = {FloatValue("action", {1, 1}),
+                   FloatValue("h_next", {1, 2})};
+  auto estimator = NnBandwidthEstimator::Create(model, Optimization::kNone);
+  ASSERT_TRUE(estimator);
+
+  for (int i = 1; i <= 3; ++i) {
+    ReceiveOneSecond(estimator.get(), 1000 * i, 0);
+    EXPECT_NEAR(NnBandwidthEstimator::LinearToLog(
+                    estimator->GetBweEstimate(1000 * (i + 1))),
+                0.1f * i, kTolerance);
+  }
+}
+
+TEST(NnBandwidthEstimatorTest, RejectsModelWithoutState) {
+  OnnxModel model = FeatureModel(0);
+  model.inputs[0].dims = {1, 5};
+  EXPECT_FALSE(NnBandwidthEstimator::Create(model, Optimization::kNone));
+}
+
+TEST(NnBandwidthEstimatorTest, RunsCorpusModel) {
+  auto estimator = NnBandwidthEstimator::Create(GetCorpusModelPath());
+  ASSERT_TRUE(estimator);
+  for (int i = 1; i <= 5; ++i) {
+    ReceiveOneSecond(estimator.get(), 1000 * i, 0);
+    const float estimate = estimator->GetBweEstimate(1000 * (i + 1));
+    EXPECT_GE(estimate, 10000);
+    EXPECT_LE(estimate, 8000000);
+  }
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace bwe_nn
+}  // namespace webrtc
@@ -0,0 +1,160 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include "absl/types/optional.h"
+#include "modules/remote_bitrate_estimator/bwe_nn/inference_session.h"
+#include "modules/remote_bitrate_estimator/bwe_nn/nn_bandwidth_estimator.h"
+#include "modules/remote_bitrate_estimator/bwe_nn/test_utils.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+#if defined(WEBRTC_BWE_NN_COMPARE_ONNXINFER)
+#include <stdio.h>
+#include <unistd.h>
+
+#include "modules/third_party/onnxinfer/ONNXInferInterface.h"
+#endif
+
+namespace webrtc {
+namespace bwe_nn {
+namespace test {
+namespace {
+
+constexpr int kNumEstimates = 2000;
+// Packets between two estimates, 60 ms at 1 Mbps.
+constexpr int kPacketsPerEstimate = 6;
+constexpr int kPacketIntervalMs = 10;
+constexpr size_t kPayloadSize = 1250;
+constexpr uint32_t kSsrc = 0x1234;
+
+#if defined(WEBRTC_BWE_NN_COMPARE_ONNXINFER)
+// Returns the resident set size of the process, if it can be read.
+absl::optional<int64_t> ResidentBytes() {
+  FILE* statm = fopen("/proc/self/statm", "r");
+  if (!statm)
+    return absl::nullopt;
+  long size_pages = 0;
+  long resident_pages = 0;
+  const bool read = fscanf(statm, "%ld %ld", &size_pages, &resident_pages) == 2;
+  fclose(statm);
+  if (!read)
+    return absl::nullopt;
+  return int64_t{resident_pages} * sysconf(_SC_PAGESIZE);
+}
+#endif
+
+// Feeds the packets of one estimate interval and returns the time of the
+// estimate.
+template <typename OnReceived>
+int64_t ReceivePackets(int estimate, OnReceived on_received) {
+  const int64_t start_ms = int64_t{estimate} * kPacketsPerEstimate *
+                           kPacketIntervalMs;
+  for (int i = 0; i < kPacketsPerEstimate; ++i) {
+    const int64_t arrival_time_ms = start_ms + i * kPacketIntervalMs;
+    on_received(arrival_time_ms, arrival_time_ms - 40,
+                static_cast<uint16_t>(estimate * kPacketsPerEstimate + i));
+  }
+  return start_ms + kPacketsPerEstimate * kPacketIntervalMs;
+}
+
+const char* OptimizationName(Optimization optimization) {
+  switch (optimization) {
+    case Optimization::kNone:
+      return "builtin_scalar";
+    case Optimization::kSse2:
+      return "builtin_sse2";
+    case Optimization::kAvx2:
+      return "builtin_avx2";
+  }
+  return "";
+}
+
+}  // namespace
+
+// Time per bandwidth estimate and memory per session of the example policy,
+// run by onnxinfer where the library is available and by InferenceSession with
+// every available optimization. onnxinfer doesn't report its allocations, so
+// its memory is the growth of the resident set while the first session of the
+// process is created; the built-in sessions report what they allocated.
+TEST(BweNnPerformanceTest, CorpusModelInference) {
+  const absl::optional<OnnxModel> model =
+      ReadOnnxModelFile(GetCorpusModelPath());
+  ASSERT_TRUE(model);
+
+#if defined(WEBRTC_BWE_NN_COMPARE_ONNXINFER)
+  const absl::optional<int64_t> resident_before = ResidentBytes();
+  void* onnx_infer =
+      onnxinfer::CreateONNXInferInterface(GetCorpusModelPath().c_str());
+  ASSERT_TRUE(onnxinfer::IsReady(onnx_infer));
+  const absl::optional<int64_t> resident_after = ResidentBytes();
+  if (resident_before && resident_after) {
+    webrtc::test::PrintResult(
+        "bwe_nn_session_memory", "", "onnxinfer",
+        (*resident_after - *resident_before) / 1024.0, "KB", false,
+        webrtc::test::ImproveDirection::kSmallerIsBetter);
+  }
+
+  int64_t onnxinfer_ns = 0;
+  for (int estimate = 0; estimate < kNumEstimates; ++estimate) {
+    ReceivePackets(estimate, [&](int64_t arrival_time_ms, int64_t send_time_ms,
+                                 uint16_t sequence_number) {
+      onnxinfer::OnReceived(onnx_infer, 96, sequence_number, send_time_ms,
+                            0x1234, 0, 12, arrival_time_ms, kPayloadSize, -1,
+                            -1);
+    });
+    const int64_t start_ns = rtc::TimeNanos();
+    EXPECT_GT(onnxinfer::GetBweEstimate(onnx_infer), 0);
+    onnxinfer_ns += rtc::TimeNanos() - start_ns;
+  }
+  onnxinfer::DestroyONNXInferInterface(onnx_infer);
+  webrtc::test::PrintResult(
+      "bwe_nn_inference_latency", "", "onnxinfer",
+      onnxinfer_ns / 1000.0 / kNumEstimates, "us", false,
+      webrtc::test::ImproveDirection::kSmallerIsBetter);
+#endif
+
+  for (Optimization optimization : GetAvailableOptimizations()) {
+    const std::string backend = OptimizationName(optimization);
+    std::unique_ptr<NnBandwidthEstimator> estimator =
+        NnBandwidthEstimator::Create(*model, optimization);
+    ASSERT_TRUE(estimator);
+    webrtc::test::PrintResult(
+        "bwe_nn_session_memory", "", backend,
+        estimator->session().memory_bytes() / 1024.0, "KB", false,
+        webrtc::test::ImproveDirection::kSmallerIsBetter);
+
+    int64_t inference_ns = 0;
+    for (int estimate = 0; estimate < kNumEstimates; ++estimate) {
+      const int64_t now_ms = ReceivePackets(
+          estimate, [&](int64_t arrival_time_ms, int64_t send_time_ms,
+                        uint16_t sequence_number) {
+            estimator->OnReceived(arrival_time_ms, send_time_ms, kSsrc,
+                                  sequence_number, kPayloadSize);
+          });
+      const int64_t start_ns = rtc::TimeNanos();
+      EXPECT_GT(estimator->GetBweEstimate(now_ms), 0);
+      inference_ns += rtc::TimeNanos() - start_ns;
+    }
+    webrtc::test::PrintResult(
+        "bwe_nn_inference_latency", "", backend,
+        inference_ns / 1000.0 / kNumEstimates, "us", false,
+        webrtc::test::ImproveDirection::kSmallerIsBetter);
+  }
+}
+
+}  // namespace test
+}  // namespace bwe_nn
+}  // namespace webrtc
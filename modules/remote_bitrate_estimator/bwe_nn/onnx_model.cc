@@ -0,0 +1,715 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/bwe_nn/onnx_model.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "rtc_base/logging.h"
+#include "rtc_base/system/arch.h"
+#include "rtc_base/system/file_wrapper.h"
+
+#if !defined(WEBRTC_ARCH_LITTLE_ENDIAN)
+#error "Tensor raw data is read assuming a little endian host."
+#endif
+
+namespace webrtc {
+namespace bwe_nn {
+namespace {
+
+// Field numbers from onnx/onnx.proto.
+namespace model_proto {
+constexpr int kGraph = 7;
+constexpr int kOpsetImport = 8;
+}  // namespace model_proto
+namespace opset_proto {
+constexpr int kDomain = 1;
+constexpr int kVersion = 2;
+}  // namespace opset_proto
+namespace graph_proto {
+constexpr int kNode = 1;
+constexpr int kInitializer = 5;
+constexpr int kInput = 11;
+constexpr int kOutput = 12;
+}  // namespace graph_proto
+namespace node_proto {
+constexpr int kInput = 1;
+constexpr int kOutput = 2;
+constexpr int kName = 3;
+constexpr int kOpType = 4;
+constexpr int kAttribute = 5;
+constexpr int kDomain = 7;
+}  // namespace node_proto
+namespace attribute_proto {
+constexpr int kName = 1;
+constexpr int kF = 2;
+constexpr int kI = 3;
+constexpr int kS = 4;
+constexpr int kT = 5;
+constexpr int kFloats = 7;
+constexpr int kInts = 8;
+constexpr int kStrings = 9;
+}  // namespace attribute_proto
+namespace tensor_proto {
+constexpr int kDims = 1;
+constexpr int kDataType = 2;
+constexpr int kFloatData = 4;
+constexpr int kInt32Data = 5;
+constexpr int kInt64Data = 7;
+constexpr int kName = 8;
+constexpr int kRawData = 9;
+constexpr int kDataLocation = 14;
+}  // namespace tensor_proto
+namespace value_info_proto {
+constexpr int kName = 1;
+constexpr int kType = 2;
+}  // namespace value_info_proto
+namespace type_proto {
+constexpr int kTensorType = 1;
+constexpr int kElemType = 1;
+constexpr int kShape = 2;
+constexpr int kDim = 1;
+constexpr int kDimValue = 1;
+}  // namespace type_proto
+
+// TensorProto::DataType.
+constexpr int kDataTypeFloat = 1;
+constexpr int kDataTypeUint8 = 2;
+constexpr int kDataTypeInt8 = 3;
+constexpr int kDataTypeInt32 = 6;
+constexpr int kDataTypeInt64 = 7;
+constexpr int kDataTypeBool = 9;
+
+enum WireType {
+  kVarint = 0,
+  kFixed64 = 1,
+  kLengthDelimited = 2,
+  kFixed32 = 5,
+};
+
+// Reads the protobuf wire format.
+class WireReader {
+ public:
+  explicit WireReader(rtc::ArrayView<const uint8_t> data)
+      : position_(data.data()), end_(data.data() + data.size()) {}
+
+  bool done() const { return position_ == end_; }
+
+  bool ReadTag(int* field, int* wire_type) {
+    uint64_t tag;
+    if (!ReadVarint(&tag))
+      return false;
+    *field = static_cast<int>(tag >> 3);
+    *wire_type = static_cast<int>(tag & 7);
+    return *field > 0;
+  }
+
+  bool ReadVarint(uint64_t* value) {
+    *value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (position_ == end_)
+        return false;
+      const uint8_t byte = *position_++;
+      *value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0)
+        return true;
+    }
+    return false;
+  }
+
+  bool ReadFixed32(uint32_t* value) {
+    if (end_ - position_ < 4)
+      return false;
+    memcpy(value, position_, 4);
+    position_ += 4;
+    return true;
+  }
+
+  bool ReadLengthDelimited(rtc::ArrayView<const uint8_t>* value) {
+    uint64_t length;
+    if (!ReadVarint(&length) ||
+        length > static_cast<uint64_t>(end_ - position_)) {
+      return false;
+    }
+    *value = rtc::ArrayView<const uint8_t>(position_, length);
+    position_ += length;
+    return true;
+  }
+
+  bool Skip(int wire_type) {
+    uint64_t varint;
+    rtc::ArrayView<const uint8_t> bytes;
+    switch (wire_type) {
+      case kVarint:
+        return ReadVarint(&varint);
+      case kFixed64:
+        if (end_ - position_ < 8)
+          return false;
+        position_ += 8;
+        return true;
+      case kLengthDelimited:
+        return ReadLengthDelimited(&bytes);
+      case kFixed32:
+        if (end_ - position_ < 4)
+          return false;
+        position_ += 4;
+        return true;
+      default:
+        return false;
+    }
+  }
+
+ private:
+  const uint8_t* position_;
+  const uint8_t* const end_;
+};
+
+std::string ToString(rtc::ArrayView<const uint8_t> bytes) {
+  return std::string(reinterpret_cast<const char*>(bytes.data()),
+                     bytes.size());
+}
+
+// Reads a repeated varint field, which may be packed.
+bool ReadRepeatedVarint(WireReader* reader,
+                        int wire_type,
+                        std::vector<int64_t>* values) {
+  if (wire_type == kVarint) {
+    uint64_t value;
+    if (!reader->ReadVarint(&value))
+      return false;
+    values->push_back(static_cast<int64_t>(value));
+    return true;
+  }
+  rtc::ArrayView<const uint8_t> packed;
+  if (wire_type != kLengthDelimited || !reader->ReadLengthDelimited(&packed))
+    return false;
+  WireReader packed_reader(packed);
+  while (!packed_reader.done()) {
+    uint64_t value;
+    if (!packed_reader.ReadVarint(&value))
+      return false;
+    values->push_back(static_cast<int64_t>(value));
+  }
+  return true;
+}
+
+// Reads a repeated float field, which may be packed.
+bool ReadRepeatedFloat(WireReader* reader,
+                       int wire_type,
+                       std::vector<float>* values) {
+  if (wire_type == kFixed32) {
+    uint32_t bits;
+    if (!reader->ReadFixed32(&bits))
+      return false;
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    values->push_back(value);
+    return true;
+  }
+  rtc::ArrayView<const uint8_t> packed;
+  if (wire_type != kLengthDelimited || !reader->ReadLengthDelimited(&packed) ||
+      packed.size() % sizeof(float) != 0) {
+    return false;
+  }
+  const size_t offset = values->size();
+  values->resize(offset + packed.size() / sizeof(float));
+  memcpy(values->data() + offset, packed.data(), packed.size());
+  return true;
+}
+
+int64_t NumElements(const std::vector<int64_t>& dims) {
+  int64_t num_elements = 1;
+  for (int64_t dim : dims)
+    num_elements *= dim;
+  return num_elements;
+}
+
+bool ParseTensor(rtc::ArrayView<const uint8_t> data, OnnxTensor* tensor) {
+  WireReader reader(data);
+  int data_type = kDataTypeFloat;
+  rtc::ArrayView<const uint8_t> raw_data;
+  bool has_raw_data = false;
+  while (!reader.done()) {
+    int field, wire_type;
+    if (!reader.ReadTag(&field, &wire_type))
+      return false;
+    uint64_t varint;
+    rtc::ArrayView<const uint8_t> bytes;
+    switch (field) {
+      case tensor_proto::kDims:
+        if (!ReadRepeatedVarint(&reader, wire_type, &tensor->dims))
+          return false;
+        break;
+      case tensor_proto::kDataType:
+        if (!reader.ReadVarint(&varint))
+          return false;
+        data_type = static_cast<int>(varint);
+        break;
+      case tensor_proto::kFloatData:
+        if (!ReadRepeatedFloat(&reader, wire_type, &tensor->float_data))
+          return false;
+        break;
+      case tensor_proto::kInt32Data:
+      case tensor_proto::kInt64Data:
+        if (!ReadRepeatedVarint(&reader, wire_type, &tensor->int_data))
+          return false;
+        break;
+      case tensor_proto::kName:
+        if (!reader.ReadLengthDelimited(&bytes))
+          return false;
+        tensor->name = ToString(bytes);
+        break;
+      case tensor_proto::kRawData:
+        if (!reader.ReadLengthDelimited(&raw_data))
+          return false;
+        has_raw_data = true;
+        break;
+      case tensor_proto::kDataLocation:
+        if (!reader.ReadVarint(&varint))
+          return false;
+        if (varint != 0) {
+          RTC_LOG(LS_WARNING) << "Tensor " << tensor->name
+                              << " uses external data, which isn't supported.";
+          return false;
+        }
+        break;
+      default:
+        if (!reader.Skip(wire_type))
+          return false;
+    }
+  }
+
+  const int64_t num_elements = NumElements(tensor->dims);
+  switch (data_type) {
+    case kDataTypeFloat:
+      tensor->is_float = true;
+      if (has_raw_data) {
+        if (raw_data.size() != num_elements * sizeof(float))
+          return false;
+        tensor->float_data.resize(num_elements);
+        memcpy(tensor->float_data.data(), raw_data.data(), raw_data.size());
+      }
+      return static_cast<int64_t>(tensor->float_data.size()) == num_elements;
+    case kDataTypeInt32:
+    case kDataTypeInt64:
+      tensor->is_float = false;
+      if (has_raw_data) {
+        const size_t element_size =
+            data_type == kDataTypeInt64 ? sizeof(int64_t) : sizeof(int32_t);
+        if (raw_data.size() != num_elements * element_size)
+          return false;
+        tensor->int_data.resize(num_elements);
+        for (int64_t i = 0; i < num_elements; ++i) {
+          if (data_type == kDataTypeInt64) {
+            memcpy(&tensor->int_data[i], &raw_data[i * element_size],
+                   element_size);
+          } else {
+            int32_t value;
+            memcpy(&value, &raw_data[i * element_size], element_size);
+            tensor->int_data[i] = value;
+          }
+        }
+      } else if (data_type == kDataTypeInt32) {
+        // int32_data holds negative values as sign extended varints, which
+        // were read as int64.
+        for (int64_t& value : tensor->int_data)
+          value = static_cast<int32_t>(value);
+      }
+      return static_cast<int64_t>(tensor->int_data.size()) == num_elements;
+    case kDataTypeUint8:
+    case kDataTypeInt8:
+    case kDataTypeBool:
+      tensor->is_float = false;
+      if (has_raw_data) {
+        if (raw_data.size() != static_cast<size_t>(num_elements))
+          return false;
+        tensor->int_data.resize(num_elements);
+        for (int64_t i = 0; i < num_elements; ++i) {
+          tensor->int_data[i] = data_type == kDataTypeInt8
+                                    ? static_cast<int8_t>(raw_data[i])
+                                    : raw_data[i];
+        }
+      }
+      return static_cast<int64_t>(tensor->int_data.size()) == num_elements;
+    default:
+      RTC_LOG(LS_WARNING) << "Tensor " << tensor->name << " has data type "
+                          << data_type << ", which isn't supported.";
+      return false;
+  }
+}
+
+bool ParseAttribute(rtc::ArrayView<const uint8_t> data,
+                    OnnxAttribute* attribute) {
+  WireReader reader(data);
+  while (!reader.done()) {
+    int field, wire_type;
+    if (!reader.ReadTag(&field, &wire_type))
+      return false;
+    uint64_t varint;
+    uint32_t fixed32;
+    rtc::ArrayView<const uint8_t> bytes;
+    switch (field) {
+      case attribute_proto::kName:
+        if (!reader.ReadLengthDelimited(&bytes))
+          return false;
+        attribute->name = ToString(bytes);
+        break;
+      case attribute_proto::kF:
+        if (!reader.ReadFixed32(&fixed32))
+          return false;
+        memcpy(&attribute->f, &fixed32, sizeof(attribute->f));
+        break;
+      case attribute_proto::kI:
+        if (!reader.ReadVarint(&varint))
+          return false;
+        attribute->i = static_cast<int64_t>(varint);
+        break;
+      case attribute_proto::kS:
+        if (!reader.ReadLengthDelimited(&bytes))
+          return false;
+        attribute->s = ToString(bytes);
+        break;
+      case attribute_proto::kT:
+        attribute->t.emplace_back();
+        if (!reader.ReadLengthDelimited(&bytes) ||
+            !ParseTensor(bytes, &attribute->t.back())) {
+          return false;
+        }
+        break;
+      case attribute_proto::kFloats:
+        if (!ReadRepeatedFloat(&reader, wire_type, &attribute->floats))
+          return false;
+        break;
+      case attribute_proto::kInts:
+        if (!ReadRepeatedVarint(&reader, wire_type, &attribute->ints))
+          return false;
+        break;
+      case attribute_proto::kStrings:
+        if (!reader.ReadLengthDelimited(&bytes))
+          return false;
+        attribute->strings.push_back(ToString(bytes));
+        break;
+      default:
+        if (!reader.Skip(wire_type))
+          return false;
+    }
+  }
+  return true;
+}
+
+bool ParseNode(rtc::ArrayView<const uint8_t> data, OnnxNode* node) {
+  WireReader reader(data);
+  while (!reader.done()) {
+    int field, wire_type;
+    if (!reader.ReadTag(&field, &wire_type))
+      return false;
+    rtc::ArrayView<const uint8_t> bytes;
+    switch (field) {
+      case node_proto::kInput:
+        if (!reader.ReadLengthDelimited(&bytes))
+          return false;
+        node->inputs.push_back(ToString(bytes));
+        break;
+      case node_proto::kOutput:
+        if (!reader.ReadLengthDelimited(&bytes))
+          return false;
+        node->outputs.push_back(ToString(bytes));
+        break;
+      case node_proto::kName:
+        if (!reader.ReadLengthDelimited(&bytes))
+          return false;
+        node->name = ToString(bytes);
+        break;
+      case node_proto::kOpType:
+        if (!reader.ReadLengthDelimited(&bytes))
+          return false;
+        node->op_type = ToString(bytes);
+        break;
+      case node_proto::kAttribute:
+        node->attributes.emplace_back();
+        if (!reader.ReadLengthDelimited(&bytes) ||
+            !ParseAttribute(bytes, &node->attributes.back())) {
+          return false;
+        }
+        break;
+      case node_proto::kDomain:
+        if (!reader.ReadLengthDelimited(&bytes))
+          return false;
+        node->domain = ToString(bytes);
+        break;
+      default:
+        if (!reader.Skip(wire_type))
+          return false;
+    }
+  }
+  return true;
+}
+
+bool ParseShape(rtc::ArrayView<const uint8_t> data,
+                std::vector<int64_t>* dims) {
+  WireReader reader(data);
+  while (!reader.done()) {
+    int field, wire_type;
+    if (!reader.ReadTag(&field, &wire_type))
+      return false;
+    if (field != type_proto::kDim) {
+      if (!reader.Skip(wire_type))
+        return false;
+      continue;
+    }
+    rtc::ArrayView<const uint8_t> dim_data;
+    if (!reader.ReadLengthDelimited(&dim_data))
+      return false;
+    // Symbolic dimensions have a dim_param instead of a dim_value.
+    int64_t dim = -1;
+    WireReader dim_reader(dim_data);
+    while (!dim_reader.done()) {
+      int dim_field, dim_wire_type;
+      if (!dim_reader.ReadTag(&dim_field, &dim_wire_type))
+        return false;
+      uint64_t value;
+      if (dim_field == type_proto::kDimValue && dim_wire_type == kVarint) {
+        if (!dim_reader.ReadVarint(&value))
+          return false;
+        dim = static_cast<int64_t>(value);
+      } else if (!dim_reader.Skip(dim_wire_type)) {
+        return false;
+      }
+    }
+    dims->push_back(dim);
+  }
+  return true;
+}
+
+bool ParseValueInfo(rtc::ArrayView<const uint8_t> data, OnnxValueInfo* info) {
+  WireReader reader(data);
+  while (!reader.done()) {
+    int field, wire_type;
+    if (!reader.ReadTag(&field, &wire_type))
+      return false;
+    rtc::ArrayView<const uint8_t> bytes;
+    if (field == value_info_proto::kName) {
+      if (!reader.ReadLengthDelimited(&bytes))
+        return false;
+      info->name = ToString(bytes);
+    } else if (field == value_info_proto::kType) {
+      if (!reader.ReadLengthDelimited(&bytes))
+        return false;
+      WireReader type_reader(bytes);
+      while (!type_reader.done()) {
+        int type_field, type_wire_type;
+        if (!type_reader.ReadTag(&type_field, &type_wire_type))
+          return false;
+        if (type_field != type_proto::kTensorType) {
+          if (!type_reader.Skip(type_wire_type))
+            return false;
+          continue;
+        }
+        rtc::ArrayView<const uint8_t> tensor_type;
+        if (!type_reader.ReadLengthDelimited(&tensor_type))
+          return false;
+        WireReader tensor_reader(tensor_type);
+        while (!tensor_reader.done()) {
+          int tensor_field, tensor_wire_type;
+          if (!tensor_reader.ReadTag(&tensor_field, &tensor_wire_type))
+            return false;
+          uint64_t elem_type;
+          rtc::ArrayView<const uint8_t> shape;
+          if (tensor_field == type_proto::kElemType) {
+            if (!tensor_reader.ReadVarint(&elem_type))
+              return false;
+            info->elem_type = static_cast<int>(elem_type);
+          } else if (tensor_field == type_proto::kShape) {
+            if (!tensor_reader.ReadLengthDelimited(&shape) ||
+                !ParseShape(shape, &info->dims)) {
+              return false;
+            }
+          } else if (!tensor_reader.Skip(tensor_wire_type)) {
+            return false;
+          }
+        }
+      }
+    } else if (!reader.Skip(wire_type)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ParseGraph(rtc::ArrayView<const uint8_t> data, OnnxModel* model) {
+  WireReader reader(data);
+  while (!reader.done()) {
+    int field, wire_type;
+    if (!reader.ReadTag(&field, &wire_type))
+      return false;
+    rtc::ArrayView<const uint8_t> bytes;
+    switch (field) {
+      case graph_proto::kNode:
+        model->nodes.emplace_back();
+        if (!reader.ReadLengthDelimited(&bytes) ||
+            !ParseNode(bytes, &model->nodes.back())) {
+          return false;
+        }
+        break;
+      case graph_proto::kInitializer:
+        model->initializers.emplace_back();
+        if (!reader.ReadLengthDelimited(&bytes) ||
+            !ParseTensor(bytes, &model->initializers.back())) {
+          return false;
+        }
+        break;
+      case graph_proto::kInput:
+        model->inputs.emplace_back();
+        if (!reader.ReadLengthDelimited(&bytes) ||
+            !ParseValueInfo(bytes, &model->inputs.back())) {
+          return false;
+        }
+        break;
+      case graph_proto::kOutput:
+        model->outputs.emplace_back();
+        if (!reader.ReadLengthDelimited(&bytes) ||
+            !ParseValueInfo(bytes, &model->outputs.back())) {
+          return false;
+        }
+        break;
+      default:
+        if (!reader.Skip(wire_type))
+          return false;
+    }
+  }
+  return true;
+}
+
+bool ParseOpsetImport(rtc::ArrayView<const uint8_t> data, OnnxModel* model) {
+  WireReader reader(data);
+  std::string domain;
+  int64_t version = 0;
+  while (!reader.done()) {
+    int field, wire_type;
+    if (!reader.ReadTag(&field, &wire_type))
+      return false;
+    rtc::ArrayView<const uint8_t> bytes;
+    uint64_t varint;
+    if (field == opset_proto::kDomain) {
+      if (!reader.ReadLengthDelimited(&bytes))
+        return false;
+      domain = ToString(bytes);
+    } else if (field == opset_proto::kVersion) {
+      if (!reader.ReadVarint(&varint))
+        return false;
+      version = static_cast<int64_t>(varint);
+    } else if (!reader.Skip(wire_type)) {
+      return false;
+    }
+  }
+  if (domain.empty() || domain == "ai.onnx")
+    model->opset_version = version;
+  return true;
+}
+
+}  // namespace
+
+OnnxTensor::OnnxTensor() = default;
+OnnxTensor::OnnxTensor(const OnnxTensor&) = default;
+OnnxTensor::OnnxTensor(OnnxTensor&&) = default;
+OnnxTensor& OnnxTensor::operator=(const OnnxTensor&) = default;
+OnnxTensor& OnnxTensor::operator=(OnnxTensor&&) = default;
+OnnxTensor::~OnnxTensor() = default;
+
+OnnxAttribute::OnnxAttribute() = default;
+OnnxAttribute::OnnxAttribute(const OnnxAttribute&) = default;
+OnnxAttribute::OnnxAttribute(OnnxAttribute&&) = default;
+OnnxAttribute& OnnxAttribute::operator=(const OnnxAttribute&) = default;
+OnnxAttribute& OnnxAttribute::operator=(OnnxAttribute&&) = default;
+OnnxAttribute::~OnnxAttribute() = default;
+
+OnnxNode::OnnxNode() = default;
+OnnxNode::OnnxNode(const OnnxNode&) = default;
+OnnxNode::OnnxNode(OnnxNode&&) = default;
+OnnxNode& OnnxNode::operator=(const OnnxNode&) = default;
+OnnxNode& OnnxNode::operator=(OnnxNode&&) = default;
+OnnxNode::~OnnxNode() = default;
+
+const OnnxAttribute* OnnxNode::FindAttribute(absl::string_view name) const {
+  for (const OnnxAttribute& attribute : attributes) {
+    if (attribute.name == name)
+      return &attribute;
+  }
+  return nullptr;
+}
+
+OnnxValueInfo::OnnxValueInfo() = default;
+OnnxValueInfo::OnnxValueInfo(const OnnxValueInfo&) = default;
+OnnxValueInfo::OnnxValueInfo(OnnxValueInfo&&) = default;
+OnnxValueInfo& OnnxValueInfo::operator=(const OnnxValueInfo&) = default;
+OnnxValueInfo& OnnxValueInfo::operator=(OnnxValueInfo&&) = default;
+OnnxValueInfo::~OnnxValueInfo() = default;
+
+OnnxModel::OnnxModel() = default;
+OnnxModel::OnnxModel(const OnnxModel&) = default;
+OnnxModel::OnnxModel(OnnxModel&&) = default;
+OnnxModel& OnnxModel::operator=(const OnnxModel&) = default;
+OnnxModel& OnnxModel::operator=(OnnxModel&&) = default;
+OnnxModel::~OnnxModel() = default;
+
+absl::optional<OnnxModel> ParseOnnxModel(rtc::ArrayView<const uint8_t> data) {
+  OnnxModel model;
+  bool has_graph = false;
+  WireReader reader(data);
+  while (!reader.done()) {
+    int field, wire_type;
+    if (!reader.ReadTag(&field, &wire_type)) {
+      RTC_LOG(LS_WARNING) << "Malformed ONNX model.";
+      return absl::nullopt;
+    }
+    rtc::ArrayView<const uint8_t> bytes;
+    bool ok;
+    switch (field) {
+      case model_proto::kGraph:
+        ok = reader.ReadLengthDelimited(&bytes) && ParseGraph(bytes, &model);
+        has_graph = true;
+        break;
+      case model_proto::kOpsetImport:
+        ok = reader.ReadLengthDelimited(&bytes) &&
+             ParseOpsetImport(bytes, &model);
+        break;
+      default:
+        ok = reader.Skip(wire_type);
+    }
+    if (!ok) {
+      RTC_LOG(LS_WARNING) << "Malformed ONNX model.";
+      return absl::nullopt;
+    }
+  }
+  if (!has_graph) {
+    RTC_LOG(LS_WARNING) << "ONNX model without a graph.";
+    return absl::nullopt;
+  }
+  return model;
+}
+
+absl::optional<OnnxModel> ReadOnnxModelFile(const std::string& path) {
+  FileWrapper file = FileWrapper::OpenReadOnly(path);
+  if (!file.is_open()) {
+    RTC_LOG(LS_WARNING) << "Can't open ONNX model " << path;
+    return absl::nullopt;
+  }
+  std::vector<uint8_t> data;
+  uint8_t buffer[64 * 1024];
+  size_t read;
+  while ((read = file.Read(buffer, sizeof(buffer))) > 0)
+    data.insert(data.end(), buffer, buffer + read);
+  return ParseOnnxModel(data);
+}
+
+}  // namespace bwe_nn
+}  // namespace webrtc
@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_NN_ONNX_MODEL_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_NN_ONNX_MODEL_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+
+namespace webrtc {
+namespace bwe_nn {
+
+// The parts of an ONNX model (onnx/onnx.proto) needed to run it, read without
+// depending on protobuf. Only float and integer tensors stored in the model
+// itself are supported.
+
+struct OnnxTensor {
+  OnnxTensor();
+  OnnxTensor(const OnnxTensor&);
+  OnnxTensor(OnnxTensor&&);
+  OnnxTensor& operator=(const OnnxTensor&);
+  OnnxTensor& operator=(OnnxTensor&&);
+  ~OnnxTensor();
+
+  std::string name;
+  std::vector<int64_t> dims;
+  // True for float tensors, which are held in |float_data|. Integer tensors
+  // of any width are held in |int_data|.
+  bool is_float = true;
+  std::vector<float> float_data;
+  std::vector<int64_t> int_data;
+};
+
+struct OnnxAttribute {
+  OnnxAttribute();
+  OnnxAttribute(const OnnxAttribute&);
+  OnnxAttribute(OnnxAttribute&&);
+  OnnxAttribute& operator=(const OnnxAttribute&);
+  OnnxAttribute& operator=(OnnxAttribute&&);
+  ~OnnxAttribute();
+
+  std::string name;
+  float f = 0.0f;
+  int64_t i = 0;
+  std::string s;
+  std::vector<float> floats;
+  std::vector<int64_t> ints;
+  std::vector<std::string> strings;
+  // Set for tensor attributes, e.g. the value of a Constant node.
+  std::vector<OnnxTensor> t;
+};
+
+struct OnnxNode {
+  OnnxNode();
+  OnnxNode(const OnnxNode&);
+  OnnxNode(OnnxNode&&);
+  OnnxNode& operator=(const OnnxNode&);
+  OnnxNode& operator=(OnnxNode&&);
+  ~OnnxNode();
+
+  // Returns null if the node has no attribute |name|.
+  const OnnxAttribute* FindAttribute(absl::string_view name) const;
+
+  std::string name;
+  std::string op_type;
+  std::string domain;
+  // Empty names are optional inputs or outputs that are left out.
+  std::vector<std::string> inputs;
+  std::vector<std::string> outputs;
+  std::vector<OnnxAttribute> attributes;
+};
+
+struct OnnxValueInfo {
+  OnnxValueInfo();
+  OnnxValueInfo(const OnnxValueInfo&);
+  OnnxValueInfo(OnnxValueInfo&&);
+  OnnxValueInfo& operator=(const OnnxValueInfo&);
+  OnnxValueInfo& operator=(OnnxValueInfo&&);
+  ~OnnxValueInfo();
+
+  std::string name;
+  // TensorProto::DataType of the elements, 1 is float.
+  int elem_type = 0;
+  // Symbolic dimensions, e.g. a batch size, are -1.
+  std::vector<int64_t> dims;
+};
+
+struct OnnxModel {
+  OnnxModel();
+  OnnxModel(const OnnxModel&);
+  OnnxModel(OnnxModel&&);
+  OnnxModel& operator=(const OnnxModel&);
+  OnnxModel& operator=(OnnxModel&&);
+  ~OnnxModel();
+
+  // Version of the default operator set.
+  int64_t opset_version = 0;
+  // In topological order, as required by ONNX.
+  std::vector<OnnxNode> nodes;
+  std::vector<OnnxTensor> initializers;
+  // May include initializers, older exporters list the weights as inputs.
+  std::vector<OnnxValueInfo> inputs;
+  std::vector<OnnxValueInfo> outputs;
+};
+
+// Parses a serialized ModelProto. Returns nullopt if |data| isn't a valid
+// model or uses something that isn't supported, e.g. external tensor data.
+absl::optional<OnnxModel> ParseOnnxModel(rtc::ArrayView<const uint8_t> data);
+
+// Reads and parses the model file at |path|.
+absl::optional<OnnxModel> ReadOnnxModelFile(const std::string& path);
+
+}  // namespace bwe_nn
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_NN_ONNX_MODEL_H_
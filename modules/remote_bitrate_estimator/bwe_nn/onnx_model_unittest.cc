@@ -0,0 +1,102 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/bwe_nn/onnx_model.h"
+
+#include <vector>
+
+#include "modules/remote_bitrate_estimator/bwe_nn/test_utils.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace bwe_nn {
+namespace test {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::FloatEq;
+using ::testing::Pointwise;
+
+// A Gemm of input x [1, 3] and initializer w [2, 3] with transB, opset 11, as
+// serialized by the onnx python package.
+constexpr uint8_t kGemmModel[] = {
+    0x08, 0x07, 0x3a, 0x6c, 0x0a, 0x1e, 0x0a, 0x01, 0x78, 0x0a, 0x01, 0x77,
+    0x12, 0x01, 0x79, 0x22, 0x04, 0x47, 0x65, 0x6d, 0x6d, 0x2a, 0x0d, 0x0a,
+    0x06, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x42, 0x18, 0x01, 0xa0, 0x01, 0x02,
+    0x12, 0x05, 0x70, 0x61, 0x72, 0x73, 0x65, 0x2a, 0x23, 0x08, 0x02, 0x08,
+    0x03, 0x10, 0x01, 0x42, 0x01, 0x77, 0x4a, 0x18, 0xd8, 0x5c, 0x89, 0xbe,
+    0x2d, 0xcb, 0xc7, 0xbd, 0x8d, 0xe7, 0xb0, 0x3d, 0x34, 0x6a, 0x84, 0x3e,
+    0x8f, 0xae, 0xca, 0x3e, 0x4f, 0x84, 0xf5, 0x3e, 0x5a, 0x13, 0x0a, 0x01,
+    0x78, 0x12, 0x0e, 0x0a, 0x0c, 0x08, 0x01, 0x12, 0x08, 0x0a, 0x02, 0x08,
+    0x01, 0x0a, 0x02, 0x08, 0x03, 0x62, 0x09, 0x0a, 0x01, 0x79, 0x12, 0x04,
+    0x0a, 0x02, 0x08, 0x01, 0x42, 0x04, 0x0a, 0x00, 0x10, 0x0b,
+};
+// The size of the model up to the end of the graph.
+constexpr size_t kGemmModelGraphEnd = 112;
+
+TEST(BweNnOnnxModelTest, ParsesModel) {
+  absl::optional<OnnxModel> model = ParseOnnxModel(kGemmModel);
+  ASSERT_TRUE(model);
+  EXPECT_EQ(model->opset_version, 11);
+
+  ASSERT_EQ(model->nodes.size(), 1u);
+  const OnnxNode& node = model->nodes[0];
+  EXPECT_EQ(node.op_type, "Gemm");
+  EXPECT_THAT(node.inputs, ElementsAre("x", "w"));
+  EXPECT_THAT(node.outputs, ElementsAre("y"));
+  const OnnxAttribute* trans_b = node.FindAttribute("transB");
+  ASSERT_TRUE(trans_b);
+  EXPECT_EQ(trans_b->i, 1);
+  EXPECT_FALSE(node.FindAttribute("transA"));
+
+  ASSERT_EQ(model->initializers.size(), 1u);
+  const OnnxTensor& w = model->initializers[0];
+  EXPECT_EQ(w.name, "w");
+  EXPECT_THAT(w.dims, ElementsAre(2, 3));
+  EXPECT_TRUE(w.is_float);
+  EXPECT_THAT(w.float_data, Pointwise(FloatEq(), TestValues(6, 12.0, 0.5)));
+
+  ASSERT_EQ(model->inputs.size(), 1u);
+  EXPECT_EQ(model->inputs[0].name, "x");
+  EXPECT_EQ(model->inputs[0].elem_type, 1);
+  EXPECT_THAT(model->inputs[0].dims, ElementsAre(1, 3));
+  ASSERT_EQ(model->outputs.size(), 1u);
+  EXPECT_EQ(model->outputs[0].name, "y");
+  EXPECT_TRUE(model->outputs[0].dims.empty());
+}
+
+TEST(BweNnOnnxModelTest, RejectsTruncatedModel) {
+  for (size_t size = 0; size < kGemmModelGraphEnd; ++size) {
+    EXPECT_FALSE(ParseOnnxModel(
+        rtc::ArrayView<const uint8_t>(kGemmModel, size)))
+        << size;
+  }
+}
+
+TEST(BweNnOnnxModelTest, ReadsCorpusModel) {
+  absl::optional<OnnxModel> model = ReadOnnxModelFile(GetCorpusModelPath());
+  ASSERT_TRUE(model);
+  EXPECT_EQ(model->opset_version, 9);
+  EXPECT_EQ(model->nodes.size(), 115u);
+  ASSERT_EQ(model->outputs.size(), 2u);
+  EXPECT_EQ(model->outputs[0].name, "action");
+  EXPECT_EQ(model->outputs[1].name, "next_hidden_states");
+  EXPECT_THAT(model->outputs[1].dims, ElementsAre(2, 1, 128));
+}
+
+TEST(BweNnOnnxModelTest, FailsToReadMissingFile) {
+  EXPECT_FALSE(ReadOnnxModelFile(GetCorpusModelPath() + ".missing"));
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace bwe_nn
+}  // namespace webrtc
@@ -0,0 +1,49 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/bwe_nn/test_utils.h"
+
+#include <cmath>
+
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace bwe_nn {
+namespace test {
+
+std::vector<Optimization> GetAvailableOptimizations() {
+  std::vector<Optimization> optimizations = {Optimization::kNone};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2) != 0)
+    optimizations.push_back(Optimization::kSse2);
+  if (WebRtc_GetCPUInfo(kAVX2) != 0)
+    optimizations.push_back(Optimization::kAvx2);
+#endif
+  return optimizations;
+}
+
+std::string GetCorpusModelPath() {
+  // The model is checked in with the example rather than under resources/.
+  return webrtc::test::ResourcePath(
+      "../examples/peerconnection/serverless/corpus/onnx-model", "onnx");
+}
+
+std::vector<float> TestValues(size_t size, double seed, double scale) {
+  std::vector<float> values(size);
+  for (size_t i = 0; i < size; ++i)
+    values[i] = static_cast<float>(std::sin(0.37 * i + seed) * scale);
+  return values;
+}
+
+}  // namespace test
+}  // namespace bwe_nn
+}  // namespace webrtc
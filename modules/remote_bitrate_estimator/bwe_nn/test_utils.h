@@ -0,0 +1,39 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_NN_TEST_UTILS_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_NN_TEST_UTILS_H_
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include "modules/remote_bitrate_estimator/bwe_nn/common.h"
+
+namespace webrtc {
+namespace bwe_nn {
+namespace test {
+
+// Returns the optimizations supported by the CPU running the test.
+std::vector<Optimization> GetAvailableOptimizations();
+
+// Returns the path of the policy used by the serverless example.
+std::string GetCorpusModelPath();
+
+// Returns |size| values of sin(0.37 * i + seed) * scale, which the
+// conformance tests use for weights and inputs.
+std::vector<float> TestValues(size_t size, double seed, double scale);
+
+}  // namespace test
+}  // namespace bwe_nn
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_BWE_NN_TEST_UTILS_H_
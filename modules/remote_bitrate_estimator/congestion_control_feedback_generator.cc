@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/congestion_control_feedback_generator.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace webrtc {
+namespace {
+constexpr int64_t kNoPacket = std::numeric_limits<int64_t>::min();
+constexpr int64_t kSlotMask =
+    CongestionControlFeedbackGenerator::kMaxPendingPacketsPerSsrc - 1;
+static_assert((CongestionControlFeedbackGenerator::kMaxPendingPacketsPerSsrc &
+               kSlotMask) == 0,
+              "kMaxPendingPacketsPerSsrc must be a power of two");
+}  // namespace
+
+constexpr size_t CongestionControlFeedbackGenerator::kMaxPendingPacketsPerSsrc;
+constexpr size_t CongestionControlFeedbackGenerator::kMaxPacketsPerReport;
+constexpr TimeDelta CongestionControlFeedbackGenerator::kSsrcTimeout;
+
+CongestionControlFeedbackGenerator::Stream::Stream()
+    : arrivals(kMaxPendingPacketsPerSsrc,
+               Arrival{kNoPacket, Timestamp::MinusInfinity(),
+                       rtc::EcnMarking::kNotEct}) {}
+
+CongestionControlFeedbackGenerator::Stream::~Stream() = default;
+
+CongestionControlFeedbackGenerator::CongestionControlFeedbackGenerator() {
+  packets_.reserve(kMaxPacketsPerReport);
+}
+
+CongestionControlFeedbackGenerator::~CongestionControlFeedbackGenerator() =
+    default;
+
+void CongestionControlFeedbackGenerator::OnReceivedPacket(
+    uint32_t ssrc,
+    uint16_t sequence_number,
+    Timestamp arrival_time,
+    rtc::EcnMarking ecn) {
+  Stream& stream = streams_[ssrc];
+  const int64_t seq = stream.unwrapper.Unwrap(sequence_number);
+  if (stream.last_arrival_time.IsInfinite()) {
+    stream.next_to_report = seq;
+    stream.end = seq;
+  }
+  stream.last_arrival_time = arrival_time;
+  if (seq < stream.next_to_report)
+    return;
+
+  Arrival& arrival = stream.arrivals[seq & kSlotMask];
+  // Only the first arrival of a packet is reported.
+  if (arrival.sequence_number == seq)
+    return;
+  arrival.sequence_number = seq;
+  arrival.arrival_time = arrival_time;
+  arrival.ecn = ecn;
+  if (seq >= stream.end) {
+    stream.end = seq + 1;
+    // Packets whose slots are reused can no longer be reported.
+    stream.next_to_report =
+        std::max<int64_t>(stream.next_to_report,
+                          stream.end - kMaxPendingPacketsPerSsrc);
+  }
+}
+
+std::unique_ptr<rtcp::CongestionControlFeedback>
+CongestionControlFeedbackGenerator::BuildFeedback(
+    Timestamp now,
+    uint32_t report_timestamp_compact_ntp) {
+  packets_.clear();
+  for (auto it = streams_.begin();
+       it != streams_.end() && packets_.size() < kMaxPacketsPerReport;) {
+    Stream& stream = it->second;
+    if (stream.next_to_report == stream.end) {
+      if (now - stream.last_arrival_time > kSsrcTimeout) {
+        it = streams_.erase(it);
+      } else {
+        ++it;
+      }
+      continue;
+    }
+    const int64_t end = std::min<int64_t>(
+        stream.end,
+        stream.next_to_report + (kMaxPacketsPerReport - packets_.size()));
+    for (int64_t seq = stream.next_to_report; seq < end; ++seq) {
+      const Arrival& arrival = stream.arrivals[seq & kSlotMask];
+      rtcp::CongestionControlFeedback::PacketInfo info;
+      info.ssrc = it->first;
+      info.sequence_number = static_cast<uint16_t>(seq);
+      if (arrival.sequence_number == seq) {
+        info.arrival_time_offset = now - arrival.arrival_time;
+        info.ecn = arrival.ecn;
+      }
+      packets_.push_back(info);
+    }
+    stream.next_to_report = end;
+    ++it;
+  }
+  if (packets_.empty())
+    return nullptr;
+  return std::make_unique<rtcp::CongestionControlFeedback>(
+      std::vector<rtcp::CongestionControlFeedback::PacketInfo>(packets_.begin(),
+                                                               packets_.end()),
+      report_timestamp_compact_ntp);
+}
+
+}  // namespace webrtc
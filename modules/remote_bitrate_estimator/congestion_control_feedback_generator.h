@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_CONGESTION_CONTROL_FEEDBACK_GENERATOR_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_CONGESTION_CONTROL_FEEDBACK_GENERATOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/congestion_control_feedback.h"
+#include "rtc_base/network/ecn_marking.h"
+#include "rtc_base/numerics/sequence_number_util.h"
+
+namespace webrtc {
+
+// Collects arrival time and ECN codepoint of received RTP packets and builds
+// RFC 8888 congestion control feedback from them. Each packet is reported
+// once; packets that arrive after a later packet of the same SSRC has been
+// reported were already reported as lost and are ignored.
+//
+// Arrivals are kept per SSRC in ring buffers indexed by sequence number, which
+// are allocated when the SSRC is first seen, so recording a packet doesn't
+// allocate.
+//
+// Not thread safe.
+class CongestionControlFeedbackGenerator {
+ public:
+  // Packets per SSRC that can be held between two reports. Older packets are
+  // not reported.
+  static constexpr size_t kMaxPendingPacketsPerSsrc = 4096;
+  // Keeps reports below a typical MTU.
+  static constexpr size_t kMaxPacketsPerReport = 512;
+  // SSRCs with no packets for this long are forgotten.
+  static constexpr TimeDelta kSsrcTimeout = TimeDelta::Seconds(10);
+
+  CongestionControlFeedbackGenerator();
+  ~CongestionControlFeedbackGenerator();
+
+  void OnReceivedPacket(uint32_t ssrc,
+                        uint16_t sequence_number,
+                        Timestamp arrival_time,
+                        rtc::EcnMarking ecn);
+
+  // Returns feedback for up to kMaxPacketsPerReport packets not yet reported,
+  // or null if there are none. |now| is on the clock of the arrival times,
+  // |report_timestamp_compact_ntp| is the same instant in compact NTP format.
+  std::unique_ptr<rtcp::CongestionControlFeedback> BuildFeedback(
+      Timestamp now,
+      uint32_t report_timestamp_compact_ntp);
+
+ private:
+  struct Arrival {
+    // Unwrapped sequence number, to tell the packet from older packets that
+    // used the same slot.
+    int64_t sequence_number;
+    Timestamp arrival_time;
+    rtc::EcnMarking ecn;
+  };
+
+  struct Stream {
+    Stream();
+    Stream(const Stream&) = delete;
+    Stream& operator=(const Stream&) = delete;
+    ~Stream();
+
+    SeqNumUnwrapper<uint16_t> unwrapper;
+    std::vector<Arrival> arrivals;
+    // Unwrapped sequence number of the first packet not yet reported.
+    int64_t next_to_report = 0;
+    // One past the highest unwrapped sequence number received.
+    int64_t end = 0;
+    Timestamp last_arrival_time = Timestamp::MinusInfinity();
+  };
+
+  std::map<uint32_t, Stream> streams_;
+  // Packets of the report being built, reserved once so that building a
+  // report allocates only the copy the report owns.
+  std::vector<rtcp::CongestionControlFeedback::PacketInfo> packets_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_CONGESTION_CONTROL_FEEDBACK_GENERATOR_H_
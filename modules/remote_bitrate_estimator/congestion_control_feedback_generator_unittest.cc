@@ -0,0 +1,159 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/congestion_control_feedback_generator.h"
+
+#include <memory>
+#include <vector>
+
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using PacketInfo = rtcp::CongestionControlFeedback::PacketInfo;
+
+constexpr uint32_t kSsrc = 1234;
+constexpr uint32_t kOtherSsrc = 5678;
+constexpr uint32_t kReportTimestamp = 0x10000;
+constexpr Timestamp kStartTime = Timestamp::Millis(1000);
+
+std::vector<uint16_t> SequenceNumbers(
+    const rtcp::CongestionControlFeedback& feedback) {
+  std::vector<uint16_t> sequence_numbers;
+  for (const PacketInfo& packet : feedback.packets())
+    sequence_numbers.push_back(packet.sequence_number);
+  return sequence_numbers;
+}
+
+std::vector<bool> Received(const rtcp::CongestionControlFeedback& feedback) {
+  std::vector<bool> received;
+  for (const PacketInfo& packet : feedback.packets())
+    received.push_back(packet.received());
+  return received;
+}
+
+TEST(CongestionControlFeedbackGeneratorTest, NoFeedbackWithoutPackets) {
+  CongestionControlFeedbackGenerator generator;
+  EXPECT_EQ(generator.BuildFeedback(kStartTime, kReportTimestamp), nullptr);
+}
+
+TEST(CongestionControlFeedbackGeneratorTest, ReportsArrivalTimeOffsetAndEcn) {
+  CongestionControlFeedbackGenerator generator;
+  generator.OnReceivedPacket(kSsrc, 10, kStartTime, rtc::EcnMarking::kEct1);
+  generator.OnReceivedPacket(kSsrc, 11, kStartTime + TimeDelta::Millis(20),
+                             rtc::EcnMarking::kCe);
+
+  auto feedback = generator.BuildFeedback(kStartTime + TimeDelta::Millis(50),
+                                          kReportTimestamp);
+  ASSERT_TRUE(feedback);
+  EXPECT_EQ(feedback->report_timestamp_compact_ntp(), kReportTimestamp);
+  ASSERT_EQ(feedback->packets().size(), 2u);
+  EXPECT_EQ(feedback->packets()[0].ssrc, kSsrc);
+  EXPECT_EQ(feedback->packets()[0].arrival_time_offset, TimeDelta::Millis(50));
+  EXPECT_EQ(feedback->packets()[0].ecn, rtc::EcnMarking::kEct1);
+  EXPECT_EQ(feedback->packets()[1].arrival_time_offset, TimeDelta::Millis(30));
+  EXPECT_EQ(feedback->packets()[1].ecn, rtc::EcnMarking::kCe);
+}
+
+TEST(CongestionControlFeedbackGeneratorTest, ReportsMissingPacketsAsLost) {
+  CongestionControlFeedbackGenerator generator;
+  generator.OnReceivedPacket(kSsrc, 0xfffe, kStartTime,
+                             rtc::EcnMarking::kNotEct);
+  generator.OnReceivedPacket(kSsrc, 0x0001, kStartTime,
+                             rtc::EcnMarking::kNotEct);
+
+  auto feedback = generator.BuildFeedback(kStartTime, kReportTimestamp);
+  ASSERT_TRUE(feedback);
+  EXPECT_THAT(SequenceNumbers(*feedback),
+              ElementsAre(0xfffe, 0xffff, 0x0000, 0x0001));
+  EXPECT_THAT(Received(*feedback), ElementsAre(true, false, false, true));
+}
+
+TEST(CongestionControlFeedbackGeneratorTest, ReportsEachPacketOnce) {
+  CongestionControlFeedbackGenerator generator;
+  generator.OnReceivedPacket(kSsrc, 1, kStartTime, rtc::EcnMarking::kNotEct);
+  ASSERT_TRUE(generator.BuildFeedback(kStartTime, kReportTimestamp));
+  EXPECT_EQ(generator.BuildFeedback(kStartTime, kReportTimestamp), nullptr);
+
+  // Duplicates and packets older than the last report are ignored.
+  generator.OnReceivedPacket(kSsrc, 1, kStartTime, rtc::EcnMarking::kNotEct);
+  generator.OnReceivedPacket(kSsrc, 0, kStartTime, rtc::EcnMarking::kNotEct);
+  EXPECT_EQ(generator.BuildFeedback(kStartTime, kReportTimestamp), nullptr);
+
+  generator.OnReceivedPacket(kSsrc, 2, kStartTime, rtc::EcnMarking::kNotEct);
+  generator.OnReceivedPacket(kSsrc, 2, kStartTime, rtc::EcnMarking::kNotEct);
+  auto feedback = generator.BuildFeedback(kStartTime, kReportTimestamp);
+  ASSERT_TRUE(feedback);
+  EXPECT_THAT(SequenceNumbers(*feedback), ElementsAre(2));
+}
+
+TEST(CongestionControlFeedbackGeneratorTest, ReportsReorderedPackets) {
+  CongestionControlFeedbackGenerator generator;
+  generator.OnReceivedPacket(kSsrc, 1, kStartTime, rtc::EcnMarking::kNotEct);
+  generator.OnReceivedPacket(kSsrc, 3, kStartTime, rtc::EcnMarking::kNotEct);
+  generator.OnReceivedPacket(kSsrc, 2, kStartTime, rtc::EcnMarking::kNotEct);
+
+  auto feedback = generator.BuildFeedback(kStartTime, kReportTimestamp);
+  ASSERT_TRUE(feedback);
+  EXPECT_THAT(SequenceNumbers(*feedback), ElementsAre(1, 2, 3));
+  EXPECT_THAT(Received(*feedback), ElementsAre(true, true, true));
+}
+
+TEST(CongestionControlFeedbackGeneratorTest, ReportsAllSsrcs) {
+  CongestionControlFeedbackGenerator generator;
+  generator.OnReceivedPacket(kSsrc, 1, kStartTime, rtc::EcnMarking::kNotEct);
+  generator.OnReceivedPacket(kOtherSsrc, 100, kStartTime,
+                             rtc::EcnMarking::kNotEct);
+
+  auto feedback = generator.BuildFeedback(kStartTime, kReportTimestamp);
+  ASSERT_TRUE(feedback);
+  ASSERT_EQ(feedback->packets().size(), 2u);
+  EXPECT_EQ(feedback->packets()[0].ssrc, kSsrc);
+  EXPECT_EQ(feedback->packets()[1].ssrc, kOtherSsrc);
+}
+
+TEST(CongestionControlFeedbackGeneratorTest, SplitsLargeReports) {
+  CongestionControlFeedbackGenerator generator;
+  const size_t kNumPackets =
+      CongestionControlFeedbackGenerator::kMaxPacketsPerReport + 10;
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    generator.OnReceivedPacket(kSsrc, static_cast<uint16_t>(i), kStartTime,
+                               rtc::EcnMarking::kNotEct);
+  }
+
+  auto first = generator.BuildFeedback(kStartTime, kReportTimestamp);
+  ASSERT_TRUE(first);
+  EXPECT_EQ(first->packets().size(),
+            CongestionControlFeedbackGenerator::kMaxPacketsPerReport);
+  auto second = generator.BuildFeedback(kStartTime, kReportTimestamp);
+  ASSERT_TRUE(second);
+  EXPECT_EQ(second->packets().size(), 10u);
+  EXPECT_EQ(second->packets()[0].sequence_number,
+            CongestionControlFeedbackGenerator::kMaxPacketsPerReport);
+}
+
+TEST(CongestionControlFeedbackGeneratorTest, DropsPacketsBeyondRingBuffer) {
+  CongestionControlFeedbackGenerator generator;
+  const size_t kPending =
+      CongestionControlFeedbackGenerator::kMaxPendingPacketsPerSsrc;
+  generator.OnReceivedPacket(kSsrc, 0, kStartTime, rtc::EcnMarking::kNotEct);
+  generator.OnReceivedPacket(kSsrc, kPending + 5, kStartTime,
+                             rtc::EcnMarking::kNotEct);
+
+  auto feedback = generator.BuildFeedback(kStartTime, kReportTimestamp);
+  ASSERT_TRUE(feedback);
+  EXPECT_EQ(feedback->packets()[0].sequence_number, 6);
+}
+
+}  // namespace
+}  // namespace webrtc
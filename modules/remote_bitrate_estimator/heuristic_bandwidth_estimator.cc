@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/heuristic_bandwidth_estimator.h"
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// Same as the learned estimators, until the rate controller has an estimate.
+constexpr float kInitialEstimateBps = 300000.f;
+constexpr int64_t kAbsSendTimeCycleUs = int64_t{64} * 1000000;
+
+uint32_t ToAbsSendTime(int64_t send_time_us) {
+  int64_t time_us = send_time_us % kAbsSendTimeCycleUs;
+  if (time_us < 0)
+    time_us += kAbsSendTimeCycleUs;
+  return static_cast<uint32_t>(
+      (time_us << RTPHeaderExtension::kAbsSendTimeFraction) / 1000000);
+}
+
+}  // namespace
+
+HeuristicBandwidthEstimator::HeuristicBandwidthEstimator()
+    : arrival_clock_(0),
+      estimator_(this, &arrival_clock_),
+      last_estimate_bps_(kInitialEstimateBps) {
+  header_.extension.hasAbsoluteSendTime = true;
+}
+
+HeuristicBandwidthEstimator::~HeuristicBandwidthEstimator() = default;
+
+void HeuristicBandwidthEstimator::OnReceived(int64_t arrival_time_ms,
+                                             int64_t send_time_us,
+                                             uint32_t ssrc,
+                                             size_t payload_size) {
+  // Reordered packets don't move time back.
+  if (arrival_time_ms > arrival_clock_.TimeInMilliseconds()) {
+    arrival_clock_.AdvanceTimeMilliseconds(arrival_time_ms -
+                                           arrival_clock_.TimeInMilliseconds());
+  }
+  header_.ssrc = ssrc;
+  header_.extension.absoluteSendTime = ToAbsSendTime(send_time_us);
+  estimator_.IncomingPacket(arrival_time_ms, payload_size, header_);
+}
+
+void HeuristicBandwidthEstimator::OnRttUpdate(int64_t avg_rtt_ms) {
+  estimator_.OnRttUpdate(avg_rtt_ms, avg_rtt_ms);
+}
+
+void HeuristicBandwidthEstimator::OnReceiveBitrateChanged(
+    const std::vector<uint32_t>& ssrcs,
+    uint32_t bitrate) {
+  RTC_DCHECK_GT(bitrate, 0);
+  last_estimate_bps_ = bitrate;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_HEURISTIC_BANDWIDTH_ESTIMATOR_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_HEURISTIC_BANDWIDTH_ESTIMATOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/rtp_headers.h"
+#include "modules/remote_bitrate_estimator/include/remote_bitrate_estimator.h"
+#include "modules/remote_bitrate_estimator/remote_bitrate_estimator_abs_send_time.h"
+#include "rtc_base/constructor_magic.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// Receive side bandwidth estimation with the REMB heuristics, i.e. the
+// abs-send-time overuse detector and the AIMD rate controller, for the packets
+// RemoteEstimatorProxy reports to the learned estimators. It needs neither a
+// model nor a Python estimator, so it can be used where those aren't
+// available and as a baseline for them. Time is the arrival time of the
+// latest packet, so packets can also be fed late, e.g. in batches.
+class HeuristicBandwidthEstimator : public RemoteBitrateObserver {
+ public:
+  HeuristicBandwidthEstimator();
+  ~HeuristicBandwidthEstimator() override;
+
+  // |send_time_us| is the send time on the sender's clock; only its value
+  // modulo 64 seconds is used, as for abs-send-time.
+  void OnReceived(int64_t arrival_time_ms,
+                  int64_t send_time_us,
+                  uint32_t ssrc,
+                  size_t payload_size);
+  void OnRttUpdate(int64_t avg_rtt_ms);
+
+  // Returns the estimate in bps.
+  float GetBweEstimate() const { return last_estimate_bps_; }
+
+  // Implements RemoteBitrateObserver.
+  void OnReceiveBitrateChanged(const std::vector<uint32_t>& ssrcs,
+                               uint32_t bitrate) override;
+
+ private:
+  SimulatedClock arrival_clock_;
+  RemoteBitrateEstimatorAbsSendTime estimator_;
+  // Reused for every packet, only the SSRC and abs-send-time are set.
+  RTPHeader header_;
+  float last_estimate_bps_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(HeuristicBandwidthEstimator);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_HEURISTIC_BANDWIDTH_ESTIMATOR_H_
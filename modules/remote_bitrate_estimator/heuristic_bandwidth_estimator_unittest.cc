@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/heuristic_bandwidth_estimator.h"
+
+#include <algorithm>
+
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kSsrc = 0x1234;
+constexpr size_t kPayloadSize = 1000;
+constexpr int64_t kSendIntervalMs = 10;  // 800 kbps.
+constexpr float kSendRateBps = kPayloadSize * 8 * 1000 / kSendIntervalMs;
+
+class HeuristicBandwidthEstimatorTest : public ::testing::Test {
+ protected:
+  HeuristicBandwidthEstimatorTest() : clock_(1000000) {}
+
+  // Sends a packet every 10 ms for |duration_ms| over a link that delivers one
+  // every |receive_interval_ms|, queuing what it can't deliver.
+  void SendPackets(int64_t duration_ms, int64_t receive_interval_ms) {
+    for (int64_t elapsed_ms = 0; elapsed_ms < duration_ms;
+         elapsed_ms += kSendIntervalMs) {
+      link_free_ms_ = std::max(link_free_ms_, clock_.TimeInMilliseconds()) +
+                      receive_interval_ms;
+      const int64_t send_time_us = send_time_us_;
+      clock_.AdvanceTimeMilliseconds(kSendIntervalMs);
+      send_time_us_ += kSendIntervalMs * 1000;
+      estimator_.OnReceived(link_free_ms_, send_time_us, kSsrc, kPayloadSize);
+      short_rtt_estimator_.OnReceived(link_free_ms_, send_time_us, kSsrc,
+                                      kPayloadSize);
+    }
+  }
+
+  SimulatedClock clock_;
+  HeuristicBandwidthEstimator estimator_;
+  // Fed the same packets as |estimator_|.
+  HeuristicBandwidthEstimator short_rtt_estimator_;
+  int64_t send_time_us_ = 0;
+  int64_t link_free_ms_ = 0;
+};
+
+TEST_F(HeuristicBandwidthEstimatorTest, StartsWithInitialEstimate) {
+  EXPECT_EQ(estimator_.GetBweEstimate(), 300000.f);
+}
+
+TEST_F(HeuristicBandwidthEstimatorTest, IncreasesWithoutQueuing) {
+  SendPackets(10000, kSendIntervalMs);
+  EXPECT_GT(estimator_.GetBweEstimate(), kSendRateBps);
+  // The rate controller doesn't go far beyond the incoming rate.
+  EXPECT_LT(estimator_.GetBweEstimate(), 1.6f * kSendRateBps);
+}
+
+TEST_F(HeuristicBandwidthEstimatorTest, DecreasesWhenQueuing) {
+  SendPackets(10000, kSendIntervalMs);
+  const float estimate_bps = estimator_.GetBweEstimate();
+  // The link drops to 640 kbps.
+  SendPackets(3000, kSendIntervalMs * 5 / 4);
+  EXPECT_LT(estimator_.GetBweEstimate(), estimate_bps);
+  EXPECT_LT(estimator_.GetBweEstimate(), kSendRateBps * 0.8f);
+}
+
+TEST_F(HeuristicBandwidthEstimatorTest, BacksOffSoonerWithShortRtt) {
+  short_rtt_estimator_.OnRttUpdate(10);
+  SendPackets(10000, kSendIntervalMs);
+  EXPECT_EQ(short_rtt_estimator_.GetBweEstimate(),
+            estimator_.GetBweEstimate());
+  // The link drops to 640 kbps. With a 10 ms RTT, the estimate is reduced
+  // again while the queue keeps growing, instead of waiting for the default
+  // 200 ms RTT to pass.
+  SendPackets(200, kSendIntervalMs * 5 / 4);
+  EXPECT_LT(short_rtt_estimator_.GetBweEstimate(),
+            estimator_.GetBweEstimate());
+}
+
+TEST_F(HeuristicBandwidthEstimatorTest, HandlesWrapInSendTime) {
+  SendPackets(10000, kSendIntervalMs);
+  const float estimate_bps = estimator_.GetBweEstimate();
+
+  SimulatedClock clock(1000000);
+  HeuristicBandwidthEstimator wrapping_estimator;
+  // Abs-send-time wraps every 64 seconds.
+  int64_t send_time_us = 59000000;
+  int64_t arrival_time_ms = 0;
+  for (int64_t elapsed_ms = 0; elapsed_ms < 10000;
+       elapsed_ms += kSendIntervalMs) {
+    arrival_time_ms = clock.TimeInMilliseconds() + kSendIntervalMs;
+    wrapping_estimator.OnReceived(arrival_time_ms, send_time_us, kSsrc,
+                                  kPayloadSize);
+    clock.AdvanceTimeMilliseconds(kSendIntervalMs);
+    send_time_us += kSendIntervalMs * 1000;
+  }
+  EXPECT_EQ(wrapping_estimator.GetBweEstimate(), estimate_bps);
+}
+
+}  // namespace
+}  // namespace webrtc
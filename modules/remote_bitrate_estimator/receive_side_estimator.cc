@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/receive_side_estimator.h"
+
+#include <utility>
+
+#include "modules/remote_bitrate_estimator/bwe_nn/nn_bandwidth_estimator.h"
+#include "modules/remote_bitrate_estimator/heuristic_bandwidth_estimator.h"
+#include "modules/third_party/cmdinfer/cmdinfer.h"
+#include "modules/third_party/onnxinfer/ONNXInferInterface.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace {
+
+class CmdInferEstimator : public ReceiveSideEstimator {
+ public:
+  void OnReceived(const Packet& packet) override {
+    cmdinfer::ReportStates(packet.send_time_ms, packet.send_time_us,
+                           packet.arrival_time_ms, packet.payload_size,
+                           packet.payload_type, packet.sequence_number,
+                           packet.ssrc, packet.padding_length,
+                           packet.header_length, packet.ecn_ce_count);
+  }
+  float GetBweEstimate(int64_t now_ms) override {
+    return cmdinfer::GetEstimatedBandwidth();
+  }
+};
+
+// lossCound and RTT field for onnxinfer::OnReceived() are set to -1 since
+// no available lossCound and RTT in webrtc. The ONNX model's ABI has no
+// input for CE marks, they only reach the cmdinfer estimator.
+class OnnxInferEstimator : public ReceiveSideEstimator {
+ public:
+  explicit OnnxInferEstimator(void* onnx_infer) : onnx_infer_(onnx_infer) {}
+  ~OnnxInferEstimator() override {
+    onnxinfer::DestroyONNXInferInterface(onnx_infer_);
+  }
+
+  void OnReceived(const Packet& packet) override {
+    onnxinfer::OnReceived(onnx_infer_, packet.payload_type,
+                          packet.sequence_number, packet.send_time_ms,
+                          packet.ssrc, packet.padding_length,
+                          packet.header_length, packet.arrival_time_ms,
+                          packet.payload_size, -1, -1);
+  }
+  float GetBweEstimate(int64_t now_ms) override {
+    return onnxinfer::GetBweEstimate(onnx_infer_);
+  }
+
+ private:
+  void* const onnx_infer_;
+};
+
+class BuiltinOnnxEstimator : public ReceiveSideEstimator {
+ public:
+  explicit BuiltinOnnxEstimator(
+      std::unique_ptr<bwe_nn::NnBandwidthEstimator> estimator)
+      : estimator_(std::move(estimator)) {}
+
+  void OnReceived(const Packet& packet) override {
+    estimator_->OnReceived(packet.arrival_time_ms, packet.send_time_us / 1000,
+                           packet.ssrc, packet.sequence_number,
+                           packet.payload_size);
+  }
+  float GetBweEstimate(int64_t now_ms) override {
+    return estimator_->GetBweEstimate(now_ms);
+  }
+
+ private:
+  const std::unique_ptr<bwe_nn::NnBandwidthEstimator> estimator_;
+};
+
+class HeuristicEstimator : public ReceiveSideEstimator {
+ public:
+  void OnReceived(const Packet& packet) override {
+    estimator_.OnReceived(packet.arrival_time_ms, packet.send_time_us,
+                          packet.ssrc, packet.payload_size);
+  }
+  float GetBweEstimate(int64_t now_ms) override {
+    return estimator_.GetBweEstimate();
+  }
+  void OnRttUpdate(int64_t avg_rtt_ms) override {
+    estimator_.OnRttUpdate(avg_rtt_ms);
+  }
+
+ private:
+  HeuristicBandwidthEstimator estimator_;
+};
+
+}  // namespace
+
+std::unique_ptr<ReceiveSideEstimator> ReceiveSideEstimator::Create(
+    const AlphaCCConfig::EstimatorConfig& config) {
+  if (!config.onnx_model_path.empty()) {
+    if (config.onnx_backend == AlphaCCConfig::OnnxBackend::kBuiltin) {
+      std::unique_ptr<bwe_nn::NnBandwidthEstimator> estimator =
+          bwe_nn::NnBandwidthEstimator::Create(config.onnx_model_path);
+      if (!estimator) {
+        RTC_LOG(LS_ERROR) << "Failed to load " << config.onnx_model_path
+                          << " with the built-in backend.";
+        return nullptr;
+      }
+      return std::make_unique<BuiltinOnnxEstimator>(std::move(estimator));
+    }
+    void* onnx_infer =
+        onnxinfer::CreateONNXInferInterface(config.onnx_model_path.c_str());
+    if (!onnxinfer::IsReady(onnx_infer)) {
+      RTC_LOG(LS_ERROR) << "Failed to load " << config.onnx_model_path
+                        << " with onnxinfer.";
+      onnxinfer::DestroyONNXInferInterface(onnx_infer);
+      return nullptr;
+    }
+    return std::make_unique<OnnxInferEstimator>(onnx_infer);
+  }
+  if (config.estimator == AlphaCCConfig::Estimator::kHeuristic)
+    return std::make_unique<HeuristicEstimator>();
+  return std::make_unique<CmdInferEstimator>();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,61 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_RECEIVE_SIDE_ESTIMATOR_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_RECEIVE_SIDE_ESTIMATOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include "api/alphacc_config.h"
+
+namespace webrtc {
+
+// A bandwidth estimator run by RemoteEstimatorProxy on the received packets:
+// PyInfer, ONNXInfer, the built-in ONNX engine or the REMB heuristics.
+class ReceiveSideEstimator {
+ public:
+  // What the estimators are told about a received packet.
+  struct Packet {
+    int64_t arrival_time_ms = 0;
+    // Abs-send-time in ms, modulo 64 seconds.
+    uint32_t send_time_ms = 0;
+    // Send time on the sender's clock, unwrapped.
+    int64_t send_time_us = 0;
+    size_t payload_size = 0;
+    uint8_t payload_type = 0;
+    uint16_t sequence_number = 0;
+    uint32_t ssrc = 0;
+    size_t padding_length = 0;
+    size_t header_length = 0;
+    // Packets marked Congestion Experienced so far.
+    size_t ecn_ce_count = 0;
+  };
+
+  // Returns the estimator selected by |config|, or null if it has an ONNX
+  // model that can't be loaded. PyInfer is a single Python process, so there
+  // must not be more than one PyInfer estimator.
+  static std::unique_ptr<ReceiveSideEstimator> Create(
+      const AlphaCCConfig::EstimatorConfig& config);
+
+  virtual ~ReceiveSideEstimator() = default;
+
+  virtual void OnReceived(const Packet& packet) = 0;
+  // Returns the estimate in bps.
+  virtual float GetBweEstimate(int64_t now_ms) = 0;
+  virtual void OnRttUpdate(int64_t avg_rtt_ms) {}
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_RECEIVE_SIDE_ESTIMATOR_H_
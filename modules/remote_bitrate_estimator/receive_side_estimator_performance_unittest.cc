@@ -0,0 +1,378 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/alphacc_config.h"
+#include "api/task_queue/default_task_queue_factory.h"
+#include "modules/remote_bitrate_estimator/bwe_nn/test_utils.h"
+#include "modules/remote_bitrate_estimator/receive_side_estimator.h"
+#include "modules/remote_bitrate_estimator/shadow_estimators.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kSsrc = 0x1234;
+constexpr size_t kPayloadSize = 1200;
+// Default of bwe_feedback_duration in the serverless examples.
+constexpr int64_t kEstimateIntervalMs = 200;
+
+ReceiveSideEstimator::Packet MakePacket(int64_t arrival_time_ms,
+                                        int64_t send_time_us,
+                                        uint16_t sequence_number) {
+  ReceiveSideEstimator::Packet packet;
+  packet.arrival_time_ms = arrival_time_ms;
+  packet.send_time_ms = (send_time_us / 1000) % (64 * 1000);
+  packet.send_time_us = send_time_us;
+  packet.payload_size = kPayloadSize;
+  packet.payload_type = 96;
+  packet.sequence_number = sequence_number;
+  packet.ssrc = kSsrc;
+  packet.header_length = 12;
+  return packet;
+}
+
+// Creates every backend available in this build but PyInfer, with the names
+// used in the results.
+std::vector<std::pair<std::string, std::unique_ptr<ReceiveSideEstimator>>>
+CreateBackends() {
+  AlphaCCConfig::EstimatorConfig heuristic;
+  heuristic.estimator = AlphaCCConfig::Estimator::kHeuristic;
+  AlphaCCConfig::EstimatorConfig builtin;
+  builtin.onnx_model_path = bwe_nn::test::GetCorpusModelPath();
+  builtin.onnx_backend = AlphaCCConfig::OnnxBackend::kBuiltin;
+  std::vector<std::pair<std::string, AlphaCCConfig::EstimatorConfig>> configs =
+      {{"heuristic", heuristic}, {"builtin", builtin}};
+#if defined(WEBRTC_BWE_NN_COMPARE_ONNXINFER)
+  AlphaCCConfig::EstimatorConfig onnx_infer = builtin;
+  onnx_infer.onnx_backend = AlphaCCConfig::OnnxBackend::kOnnxInfer;
+  configs.emplace_back("onnxinfer", onnx_infer);
+#endif
+
+  std::vector<std::pair<std::string, std::unique_ptr<ReceiveSideEstimator>>>
+      backends;
+  for (const auto& config : configs) {
+    std::unique_ptr<ReceiveSideEstimator> backend =
+        ReceiveSideEstimator::Create(config.second);
+    EXPECT_TRUE(backend) << config.first;
+    if (backend)
+      backends.emplace_back(config.first, std::move(backend));
+  }
+  return backends;
+}
+
+// A bottleneck with a drop-tail queue, a sender that paces at the latest
+// estimate it was sent and a receiver that estimates every 200 ms, like the
+// serverless example does.
+struct LinkSegment {
+  int64_t duration_ms;
+  int64_t capacity_bps;
+};
+
+struct ScenarioResult {
+  double utilization_percent = 0;
+  double mean_queuing_delay_ms = 0;
+  double p95_queuing_delay_ms = 0;
+  double loss_percent = 0;
+};
+
+constexpr int64_t kPropagationDelayUs = 20000;
+constexpr int64_t kMaxQueuingDelayUs = 300000;
+constexpr float kMinSendRateBps = 50000.f;
+constexpr float kMaxSendRateBps = 20000000.f;
+
+ScenarioResult RunScenario(ReceiveSideEstimator* backend,
+                           const std::vector<LinkSegment>& link,
+                           int64_t start_us) {
+  struct Feedback {
+    int64_t time_us;
+    float estimate_bps;
+  };
+  struct InFlight {
+    int64_t send_time_us;
+    int64_t arrival_time_us;
+    int64_t queuing_delay_us;
+    uint16_t sequence_number;
+  };
+
+  int64_t end_us = start_us;
+  double capacity_bits = 0;
+  for (const LinkSegment& segment : link) {
+    end_us += segment.duration_ms * 1000;
+    capacity_bits += segment.duration_ms / 1000.0 * segment.capacity_bps;
+  }
+  auto capacity_at = [&](int64_t time_us) {
+    int64_t segment_end_us = start_us;
+    for (const LinkSegment& segment : link) {
+      segment_end_us += segment.duration_ms * 1000;
+      if (time_us < segment_end_us)
+        return segment.capacity_bps;
+    }
+    return link.back().capacity_bps;
+  };
+
+  float send_rate_bps = 300000.f;
+  int64_t next_send_us = start_us;
+  int64_t link_free_us = start_us;
+  uint16_t sequence_number = 0;
+  std::deque<InFlight> in_flight;
+  std::deque<Feedback> feedback;
+  absl::optional<int64_t> last_estimate_ms;
+  std::vector<double> queuing_delays_ms;
+  double delivered_bits = 0;
+  int sent = 0;
+  int lost = 0;
+
+  while (next_send_us < end_us || !in_flight.empty()) {
+    const bool send = next_send_us < end_us &&
+                      (in_flight.empty() ||
+                       next_send_us < in_flight.front().arrival_time_us);
+    const int64_t now_us =
+        send ? next_send_us : in_flight.front().arrival_time_us;
+    while (!feedback.empty() && feedback.front().time_us <= now_us) {
+      send_rate_bps = std::min(
+          std::max(feedback.front().estimate_bps, kMinSendRateBps),
+          kMaxSendRateBps);
+      feedback.pop_front();
+    }
+    if (send) {
+      ++sent;
+      const int64_t queuing_delay_us = std::max<int64_t>(
+          link_free_us - now_us, 0);
+      if (queuing_delay_us > kMaxQueuingDelayUs) {
+        ++lost;
+      } else {
+        link_free_us = std::max(link_free_us, now_us) +
+                       kPayloadSize * 8 * 1000000 / capacity_at(now_us);
+        in_flight.push_back(InFlight{now_us, link_free_us + kPropagationDelayUs,
+                                     queuing_delay_us, sequence_number});
+      }
+      ++sequence_number;
+      next_send_us += static_cast<int64_t>(kPayloadSize * 8 * 1e6 /
+                                           send_rate_bps);
+      continue;
+    }
+
+    const InFlight packet = in_flight.front();
+    in_flight.pop_front();
+    const int64_t arrival_time_ms = packet.arrival_time_us / 1000;
+    backend->OnReceived(MakePacket(arrival_time_ms, packet.send_time_us,
+                                   packet.sequence_number));
+    if (packet.arrival_time_us <= end_us) {
+      delivered_bits += kPayloadSize * 8;
+      queuing_delays_ms.push_back(packet.queuing_delay_us / 1000.0);
+    }
+    if (!last_estimate_ms ||
+        arrival_time_ms - *last_estimate_ms >= kEstimateIntervalMs) {
+      last_estimate_ms = arrival_time_ms;
+      feedback.push_back(Feedback{packet.arrival_time_us + kPropagationDelayUs,
+                                  backend->GetBweEstimate(arrival_time_ms)});
+    }
+  }
+
+  ScenarioResult result;
+  result.utilization_percent = 100 * delivered_bits / capacity_bits;
+  result.loss_percent = sent ? 100.0 * lost / sent : 0;
+  if (!queuing_delays_ms.empty()) {
+    double sum_ms = 0;
+    for (double delay_ms : queuing_delays_ms)
+      sum_ms += delay_ms;
+    result.mean_queuing_delay_ms = sum_ms / queuing_delays_ms.size();
+    const size_t p95 = queuing_delays_ms.size() * 95 / 100;
+    std::nth_element(queuing_delays_ms.begin(),
+                     queuing_delays_ms.begin() + p95, queuing_delays_ms.end());
+    result.p95_queuing_delay_ms = queuing_delays_ms[p95];
+  }
+  return result;
+}
+
+}  // namespace
+
+// Time each receive side backend adds per packet, including its share of the
+// estimates, for 10 minutes of 1 Mbps media with jittery arrivals.
+TEST(ReceiveSideEstimatorPerformanceTest, PerPacketCost) {
+  constexpr int64_t kDurationMs = 10 * 60 * 1000;
+  constexpr int64_t kPacketIntervalUs = 9600;
+  constexpr int64_t kStartUs = 1000000;
+
+  for (auto& backend : CreateBackends()) {
+    Random random(0x5eed);
+    int64_t last_estimate_ms = kStartUs / 1000;
+    int packets = 0;
+    const int64_t start_ns = rtc::TimeNanos();
+    for (int64_t send_time_us = kStartUs;
+         send_time_us < kStartUs + kDurationMs * 1000;
+         send_time_us += kPacketIntervalUs) {
+      const int64_t arrival_time_ms =
+          (send_time_us + kPropagationDelayUs + random.Rand(0, 5000)) / 1000;
+      backend.second->OnReceived(MakePacket(arrival_time_ms, send_time_us,
+                                            static_cast<uint16_t>(packets)));
+      ++packets;
+      if (arrival_time_ms - last_estimate_ms >= kEstimateIntervalMs) {
+        last_estimate_ms = arrival_time_ms;
+        EXPECT_GT(backend.second->GetBweEstimate(arrival_time_ms), 0);
+      }
+    }
+    webrtc::test::PrintResult(
+        "receive_side_bwe_per_packet_cost", "", backend.first,
+        static_cast<double>(rtc::TimeNanos() - start_ns) / packets, "ns",
+        false, webrtc::test::ImproveDirection::kSmallerIsBetter);
+  }
+}
+
+// Closed loop behaviour of each backend on a bottleneck whose capacity stays,
+// drops or rises halfway through a 40 second call.
+TEST(ReceiveSideEstimatorPerformanceTest, Scenarios) {
+  const struct {
+    const char* name;
+    std::vector<LinkSegment> link;
+  } kScenarios[] = {
+      {"constant_2mbps", {{40000, 2000000}}},
+      {"step_down_2mbps_500kbps", {{20000, 2000000}, {20000, 500000}}},
+      {"step_up_500kbps_3mbps", {{20000, 500000}, {20000, 3000000}}},
+  };
+  constexpr int64_t kStartUs = 1000000;
+
+  for (const auto& scenario : kScenarios) {
+    for (auto& backend : CreateBackends()) {
+      const ScenarioResult result =
+          RunScenario(backend.second.get(), scenario.link, kStartUs);
+      const std::string trace = std::string("_") + scenario.name;
+      webrtc::test::PrintResult(
+          "receive_side_bwe_utilization", trace, backend.first,
+          result.utilization_percent, "%", false,
+          webrtc::test::ImproveDirection::kBiggerIsBetter);
+      webrtc::test::PrintResult(
+          "receive_side_bwe_mean_queuing_delay", trace, backend.first,
+          result.mean_queuing_delay_ms, "ms", false,
+          webrtc::test::ImproveDirection::kSmallerIsBetter);
+      webrtc::test::PrintResult(
+          "receive_side_bwe_p95_queuing_delay", trace, backend.first,
+          result.p95_queuing_delay_ms, "ms", false,
+          webrtc::test::ImproveDirection::kSmallerIsBetter);
+      webrtc::test::PrintResult(
+          "receive_side_bwe_loss", trace, backend.first, result.loss_percent,
+          "%", false, webrtc::test::ImproveDirection::kSmallerIsBetter);
+    }
+  }
+}
+
+// Time the primary path spends per packet with 0, 1, 2 and 4 shadow
+// estimators, alternately heuristic and built-in, and the time the shadow
+// task queue spends per packet and shadow. The packets are fed faster than
+// real time, so the feed waits for the shadows to finish each batch, without
+// counting the wait, instead of making them drop batches. The primary path is
+// timed in thread CPU time so that the task queue preempting it isn't counted
+// on a single core.
+TEST(ReceiveSideEstimatorPerformanceTest, ShadowOverhead) {
+  constexpr int64_t kDurationMs = 10 * 60 * 1000;
+  constexpr int64_t kPacketIntervalUs = 9600;
+  constexpr int64_t kStartUs = 1000000;
+  const std::unique_ptr<TaskQueueFactory> task_queue_factory =
+      CreateDefaultTaskQueueFactory();
+
+  for (int num_shadows : {0, 1, 2, 4}) {
+    AlphaCCConfig::EstimatorConfig heuristic;
+    heuristic.estimator = AlphaCCConfig::Estimator::kHeuristic;
+    AlphaCCConfig::EstimatorConfig builtin;
+    builtin.onnx_model_path = bwe_nn::test::GetCorpusModelPath();
+    builtin.onnx_backend = AlphaCCConfig::OnnxBackend::kBuiltin;
+    std::unique_ptr<ReceiveSideEstimator> primary =
+        ReceiveSideEstimator::Create(heuristic);
+    ASSERT_TRUE(primary);
+
+    std::atomic<int> processed_batches{0};
+    // Only written on the task queue, read once it's gone.
+    int64_t processing_time_us = 0;
+    int64_t processed_packets = 0;
+    std::unique_ptr<ShadowEstimators> shadows;
+    if (num_shadows > 0) {
+      std::vector<ShadowEstimators::NamedEstimator> estimators;
+      for (int i = 0; i < num_shadows; ++i) {
+        std::unique_ptr<ReceiveSideEstimator> estimator =
+            ReceiveSideEstimator::Create(i % 2 ? builtin : heuristic);
+        ASSERT_TRUE(estimator);
+        estimators.emplace_back("shadow" + std::to_string(i),
+                                std::move(estimator));
+      }
+      shadows = std::make_unique<ShadowEstimators>(
+          task_queue_factory.get(), std::move(estimators),
+          [&](const ShadowEstimators::Report& report) {
+            processing_time_us += report.processing_time_us;
+            processed_packets += report.packets;
+            processed_batches.fetch_add(1, std::memory_order_release);
+          });
+    }
+
+    Random random(0x5eed);
+    int64_t last_estimate_ms = kStartUs / 1000;
+    int packets = 0;
+    int batches = 0;
+    int64_t primary_ns = 0;
+    int64_t segment_start_ns = rtc::GetThreadCpuTimeNanos();
+    for (int64_t send_time_us = kStartUs;
+         send_time_us < kStartUs + kDurationMs * 1000;
+         send_time_us += kPacketIntervalUs) {
+      const int64_t arrival_time_ms =
+          (send_time_us + kPropagationDelayUs + random.Rand(0, 5000)) / 1000;
+      const ReceiveSideEstimator::Packet packet = MakePacket(
+          arrival_time_ms, send_time_us, static_cast<uint16_t>(packets));
+      primary->OnReceived(packet);
+      if (shadows)
+        shadows->OnReceived(packet);
+      ++packets;
+      if (arrival_time_ms - last_estimate_ms < kEstimateIntervalMs)
+        continue;
+      last_estimate_ms = arrival_time_ms;
+      const float estimate_bps = primary->GetBweEstimate(arrival_time_ms);
+      EXPECT_GT(estimate_bps, 0);
+      if (!shadows)
+        continue;
+      shadows->OnPrimaryEstimate(arrival_time_ms, estimate_bps);
+      ++batches;
+      primary_ns += rtc::GetThreadCpuTimeNanos() - segment_start_ns;
+      while (processed_batches.load(std::memory_order_acquire) < batches)
+        std::this_thread::yield();
+      segment_start_ns = rtc::GetThreadCpuTimeNanos();
+    }
+    primary_ns += rtc::GetThreadCpuTimeNanos() - segment_start_ns;
+    shadows.reset();
+
+    const std::string trace = std::to_string(num_shadows) + "_shadows";
+    webrtc::test::PrintResult(
+        "receive_side_bwe_shadow_primary_cost", "", trace,
+        static_cast<double>(primary_ns) / packets, "ns", false,
+        webrtc::test::ImproveDirection::kSmallerIsBetter);
+    if (num_shadows > 0) {
+      webrtc::test::PrintResult(
+          "receive_side_bwe_shadow_worker_cost", "", trace,
+          1000.0 * processing_time_us / processed_packets / num_shadows, "ns",
+          false, webrtc::test::ImproveDirection::kSmallerIsBetter);
+    }
+  }
+}
+
+}  // namespace webrtc
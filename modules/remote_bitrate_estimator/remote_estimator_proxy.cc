@@ -13,7 +13,6 @@
 #endif  //  WIN32
 
 #include "modules/remote_bitrate_estimator/remote_estimator_proxy.h"
-#include "modules/third_party/cmdinfer/cmdinfer.h"
 
 #include <algorithm>
 #include <limits>
@@ -21,8 +20,12 @@
 #include <utility>
 #include <iostream>
 
+#include "absl/strings/match.h"
 #include "api/alphacc_config.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/congestion_control_feedback.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/remote_estimate.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+#include "modules/rtp_rtcp/source/time_util.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_minmax.h"
@@ -38,14 +41,42 @@ const int RemoteEstimatorProxy::kMaxNumberOfPackets = (1 << 15);
 static constexpr int64_t kMaxTimeMs =
     std::numeric_limits<int64_t>::max() / 1000;
 
+// Name of a shadow estimator in the logs.
+static std::string EstimatorName(const AlphaCCConfig::EstimatorConfig& config) {
+  if (!config.onnx_model_path.empty()) {
+    return (config.onnx_backend == AlphaCCConfig::OnnxBackend::kBuiltin
+                ? "builtin:"
+                : "onnxinfer:") +
+           config.onnx_model_path;
+  }
+  if (config.estimator == AlphaCCConfig::Estimator::kHeuristic)
+    return "heuristic";
+  return "pyinfer";
+}
+
 RemoteEstimatorProxy::RemoteEstimatorProxy(
     Clock* clock,
     TransportFeedbackSenderInterface* feedback_sender,
     const WebRtcKeyValueConfig* key_value_config,
     NetworkStateEstimator* network_state_estimator)
+    : RemoteEstimatorProxy(clock,
+                           feedback_sender,
+                           key_value_config,
+                           network_state_estimator,
+                           nullptr) {}
+
+RemoteEstimatorProxy::RemoteEstimatorProxy(
+    Clock* clock,
+    TransportFeedbackSenderInterface* feedback_sender,
+    const WebRtcKeyValueConfig* key_value_config,
+    NetworkStateEstimator* network_state_estimator,
+    TaskQueueFactory* task_queue_factory)
     : clock_(clock),
       feedback_sender_(feedback_sender),
       send_config_(key_value_config),
+      send_congestion_control_feedback_(absl::StartsWith(
+          key_value_config->Lookup("WebRTC-RFC8888CongestionControlFeedback"),
+          "Enabled")),
       last_process_time_ms_(-1),
       network_state_estimator_(network_state_estimator),
       media_ssrc_(0),
@@ -56,14 +87,32 @@ RemoteEstimatorProxy::RemoteEstimatorProxy(
       last_bwe_sendback_ms_(clock->TimeInMilliseconds()),
       stats_collect_(StatCollect::SC_TYPE_STRUCT),
       cycles_(-1),
-      max_abs_send_time_(0),
-      onnx_infer_(nullptr) {
-
-  if (!GetAlphaCCConfig()->onnx_model_path.empty()) {
-    onnx_infer_ = onnxinfer::CreateONNXInferInterface(
-        GetAlphaCCConfig()->onnx_model_path.c_str());
-    if (!onnxinfer::IsReady(onnx_infer_)) {
-      RTC_LOG(LS_ERROR) << "Failed to create onnx_infer_.";
+      max_abs_send_time_(0) {
+  AlphaCCConfig::EstimatorConfig primary = GetAlphaCCConfig()->bwe_estimator;
+  estimator_ = ReceiveSideEstimator::Create(primary);
+  if (!estimator_) {
+    // Fall back to the estimator configured for running without a model.
+    primary.onnx_model_path.clear();
+    estimator_ = ReceiveSideEstimator::Create(primary);
+  }
+  const bool primary_is_pyinfer = EstimatorName(primary) == "pyinfer";
+  if (task_queue_factory && !GetAlphaCCConfig()->shadow_estimators.empty()) {
+    std::vector<ShadowEstimators::NamedEstimator> shadows;
+    for (const AlphaCCConfig::EstimatorConfig& config :
+         GetAlphaCCConfig()->shadow_estimators) {
+      const std::string name = EstimatorName(config);
+      if (primary_is_pyinfer && name == "pyinfer") {
+        RTC_LOG(LS_ERROR) << "PyInfer can't be a shadow of itself.";
+        continue;
+      }
+      std::unique_ptr<ReceiveSideEstimator> estimator =
+          ReceiveSideEstimator::Create(config);
+      if (estimator)
+        shadows.emplace_back(name, std::move(estimator));
+    }
+    if (!shadows.empty()) {
+      shadow_estimators_ = std::make_unique<ShadowEstimators>(
+          task_queue_factory, std::move(shadows));
     }
   }
   RTC_LOG(LS_INFO)
@@ -71,56 +120,64 @@ RemoteEstimatorProxy::RemoteEstimatorProxy(
       << send_config_.max_interval->ms();
 }
 
-RemoteEstimatorProxy::~RemoteEstimatorProxy() {
-  if (onnx_infer_) {
-    onnxinfer::DestroyONNXInferInterface(onnx_infer_);
-  }
-}
+RemoteEstimatorProxy::~RemoteEstimatorProxy() = default;
 
 void RemoteEstimatorProxy::IncomingPacket(int64_t arrival_time_ms,
                                           size_t payload_size,
                                           const RTPHeader& header) {
+  IncomingPacket(arrival_time_ms, payload_size, header,
+                 rtc::EcnMarking::kNotEct);
+}
+
+void RemoteEstimatorProxy::IncomingPacket(int64_t arrival_time_ms,
+                                          size_t payload_size,
+                                          const RTPHeader& header,
+                                          rtc::EcnMarking ecn) {
   if (arrival_time_ms < 0 || arrival_time_ms > kMaxTimeMs) {
     RTC_LOG(LS_WARNING) << "Arrival time out of bounds: " << arrival_time_ms;
     return;
   }
   rtc::CritScope cs(&lock_);
   media_ssrc_ = header.ssrc;
-  OnPacketArrival(header.extension.transportSequenceNumber, arrival_time_ms,
-                  header.extension.feedback_request);
+  if (ecn == rtc::EcnMarking::kCe)
+    ++ecn_ce_count_;
+  if (send_congestion_control_feedback_) {
+    congestion_control_feedback_generator_.OnReceivedPacket(
+        header.ssrc, header.sequenceNumber,
+        Timestamp::Millis(arrival_time_ms), ecn);
+  } else {
+    OnPacketArrival(header.extension.transportSequenceNumber, arrival_time_ms,
+                    header.extension.feedback_request);
+  }
 
-  //--- ONNXInfer: Input the per-packet info to ONNXInfer module ---
+  //--- Report the per-packet info to the bandwidth estimators ---
   uint32_t send_time_ms =
       GetTtimeFromAbsSendtime(header.extension.absoluteSendTime);
-
-  // lossCound and RTT field for onnxinfer::OnReceived() are set to -1 since
-  // no available lossCound and RTT in webrtc
-  if (onnx_infer_) {
-    onnxinfer::OnReceived(onnx_infer_, header.payloadType, header.sequenceNumber,
-                          send_time_ms, header.ssrc, header.paddingLength,
-                          header.headerLength, arrival_time_ms, payload_size, -1, -1);
-  } else {
-    cmdinfer::ReportStates(
-        send_time_ms,
-        arrival_time_ms,
-        payload_size,
-        header.payloadType,
-        header.sequenceNumber,
-        header.ssrc,
-        header.paddingLength,
-        header.headerLength);
-  }
+  const int64_t send_time_us = GetSendTimeUs(header);
+
+  ReceiveSideEstimator::Packet packet;
+  packet.arrival_time_ms = arrival_time_ms;
+  packet.send_time_ms = send_time_ms;
+  packet.send_time_us = send_time_us;
+  packet.payload_size = payload_size;
+  packet.payload_type = header.payloadType;
+  packet.sequence_number = header.sequenceNumber;
+  packet.ssrc = header.ssrc;
+  packet.padding_length = header.paddingLength;
+  packet.header_length = header.headerLength;
+  packet.ecn_ce_count = ecn_ce_count_;
+  estimator_->OnReceived(packet);
+  if (shadow_estimators_)
+    shadow_estimators_->OnReceived(packet);
 
   //--- BandWidthControl: Send back bandwidth estimation into to sender ---
   bool time_to_send_bew_message = TimeToSendBweMessage();
   float estimation = 0;
   if (time_to_send_bew_message) {
     BweMessage bwe;
-    if (onnx_infer_) {
-      estimation = onnxinfer::GetBweEstimate(onnx_infer_);
-    } else {
-      estimation = cmdinfer::GetEstimatedBandwidth();
-    }
+    estimation = estimator_->GetBweEstimate(arrival_time_ms);
+    if (shadow_estimators_)
+      shadow_estimators_->OnPrimaryEstimate(arrival_time_ms, estimation);
     bwe.pacing_rate = bwe.padding_rate = bwe.target_rate = estimation;
     bwe.timestamp_ms = clock_->TimeInMilliseconds();
     SendbackBweEstimation(bwe);
@@ -156,6 +213,14 @@ bool RemoteEstimatorProxy::LatestEstimate(std::vector<unsigned int>* ssrcs,
   return false;
 }
 
+void RemoteEstimatorProxy::OnRttUpdate(int64_t avg_rtt_ms,
+                                       int64_t max_rtt_ms) {
+  rtc::CritScope cs(&lock_);
+  estimator_->OnRttUpdate(avg_rtt_ms);
+  if (shadow_estimators_)
+    shadow_estimators_->OnRttUpdate(avg_rtt_ms);
+}
+
 int64_t RemoteEstimatorProxy::TimeUntilNextProcess() {
   rtc::CritScope cs(&lock_);
   if (!send_periodic_feedback_) {
@@ -179,6 +244,30 @@ void RemoteEstimatorProxy::Process() {
   SendPeriodicFeedbacks();
 }
 
+TimeDelta RemoteEstimatorProxy::Process(Timestamp now) {
+  rtc::CritScope cs(&lock_);
+  if (!send_periodic_feedback_) {
+    return TimeDelta::PlusInfinity();
+  }
+  const int64_t now_ms = now.ms();
+  if (last_process_time_ms_ != -1 &&
+      now_ms < last_process_time_ms_ + send_interval_ms_) {
+    return TimeDelta::Millis(last_process_time_ms_ + send_interval_ms_ -
+                             now_ms);
+  }
+  // Start over from |now| if a whole interval was missed.
+  if (last_process_time_ms_ == -1 ||
+      now_ms >= last_process_time_ms_ + 2 * send_interval_ms_) {
+    last_process_time_ms_ = now_ms;
+  } else {
+    last_process_time_ms_ += send_interval_ms_;
+  }
+
+  SendPeriodicFeedbacks();
+  return TimeDelta::Millis(
+      std::max<int64_t>(last_process_time_ms_ + send_interval_ms_ - now_ms, 0));
+}
+
 void RemoteEstimatorProxy::OnBitrateChanged(int bitrate_bps) {
   // TwccReportSize = Ipv4(20B) + UDP(8B) + SRTP(10B) +
   // AverageTwccReport(30B)
@@ -205,6 +294,12 @@ void RemoteEstimatorProxy::SetSendPeriodicFeedback(
   send_periodic_feedback_ = send_periodic_feedback;
 }
 
+void RemoteEstimatorProxy::SetEstimatorForTesting(
+    std::unique_ptr<ReceiveSideEstimator> estimator) {
+  rtc::CritScope cs(&lock_);
+  estimator_ = std::move(estimator);
+}
+
 void RemoteEstimatorProxy::OnPacketArrival(
     uint16_t sequence_number,
     int64_t arrival_time,
@@ -268,12 +363,6 @@ bool RemoteEstimatorProxy::TimeToSendBweMessage() {
 }
 
 void RemoteEstimatorProxy::SendPeriodicFeedbacks() {
-  // |periodic_window_start_seq_| is the first sequence number to include in the
-  // current feedback packet. Some older may still be in the map, in case a
-  // reordering happens and we need to retransmit them.
-  if (!periodic_window_start_seq_)
-    return;
-
   std::unique_ptr<rtcp::RemoteEstimate> remote_estimate;
   if (network_state_estimator_) {
     absl::optional<NetworkStateEstimate> state_estimate =
@@ -284,6 +373,17 @@ void RemoteEstimatorProxy::SendPeriodicFeedbacks() {
     }
   }
 
+  if (send_congestion_control_feedback_) {
+    SendCongestionControlFeedbacks(std::move(remote_estimate));
+    return;
+  }
+
+  // |periodic_window_start_seq_| is the first sequence number to include in the
+  // current feedback packet. Some older may still be in the map, in case a
+  // reordering happens and we need to retransmit them.
+  if (!periodic_window_start_seq_)
+    return;
+
   for (auto begin_iterator =
            packet_arrival_times_.lower_bound(*periodic_window_start_seq_);
        begin_iterator != packet_arrival_times_.cend();
@@ -309,6 +409,25 @@ void RemoteEstimatorProxy::SendPeriodicFeedbacks() {
   }
 }
 
+void RemoteEstimatorProxy::SendCongestionControlFeedbacks(
+    std::unique_ptr<rtcp::RemoteEstimate> remote_estimate) {
+  const Timestamp now = Timestamp::Millis(clock_->TimeInMilliseconds());
+  const uint32_t report_timestamp = CompactNtp(clock_->CurrentNtpTime());
+  while (std::unique_ptr<rtcp::CongestionControlFeedback> feedback_packet =
+             congestion_control_feedback_generator_.BuildFeedback(
+                 now, report_timestamp)) {
+    RTC_DCHECK(feedback_sender_ != nullptr);
+
+    std::vector<std::unique_ptr<rtcp::RtcpPacket>> packets;
+    if (remote_estimate) {
+      packets.push_back(std::move(remote_estimate));
+    }
+    packets.push_back(std::move(feedback_packet));
+
+    feedback_sender_->SendCombinedRtcpPacket(std::move(packets));
+  }
+}
+
 void RemoteEstimatorProxy::SendFeedbackOnRequest(
     int64_t sequence_number,
     const FeedbackRequest& feedback_request) {
@@ -414,4 +533,28 @@ uint32_t RemoteEstimatorProxy::GetTtimeFromAbsSendtime(
   return send_time_ms;
 }
 
+int64_t RemoteEstimatorProxy::GetSendTimeUs(const RTPHeader& header) {
+  if (header.extension.transport_send_time_us) {
+    last_transport_send_time_us_ = header.extension.transport_send_time_us;
+    return *last_transport_send_time_us_;
+  }
+  // Abs-send-time is the sender's clock modulo 64 seconds.
+  constexpr int64_t kAbsSendTimeCycleUs = int64_t{64} * 1000000;
+  const int64_t abs_send_time_us =
+      (int64_t{header.extension.absoluteSendTime} * 1000000) >>
+      RTPHeaderExtension::kAbsSendTimeFraction;
+  if (!last_transport_send_time_us_) {
+    return abs_send_time_us + cycles_ * kAbsSendTimeCycleUs;
+  }
+  // Streams without the transport send time are put on its time base, both
+  // come from the same clock.
+  int64_t delta_us =
+      abs_send_time_us - *last_transport_send_time_us_ % kAbsSendTimeCycleUs;
+  if (delta_us >= kAbsSendTimeCycleUs / 2)
+    delta_us -= kAbsSendTimeCycleUs;
+  if (delta_us < -kAbsSendTimeCycleUs / 2)
+    delta_us += kAbsSendTimeCycleUs;
+  return *last_transport_send_time_us_ + delta_us;
+}
+
 }  // namespace webrtc
@@ -12,14 +12,22 @@
 #define MODULES_REMOTE_BITRATE_ESTIMATOR_REMOTE_ESTIMATOR_PROXY_H_
 
 #include <map>
+#include <memory>
 #include <vector>
 
+#include "absl/types/optional.h"
+#include "api/task_queue/task_queue_factory.h"
 #include "api/transport/network_control.h"
 #include "api/transport/webrtc_key_value_config.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/remote_bitrate_estimator/congestion_control_feedback_generator.h"
 #include "modules/remote_bitrate_estimator/include/remote_bitrate_estimator.h"
-#include "modules/third_party/onnxinfer/ONNXInferInterface.h"
+#include "modules/remote_bitrate_estimator/receive_side_estimator.h"
+#include "modules/remote_bitrate_estimator/shadow_estimators.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/network/ecn_marking.h"
 #include "rtc_base/numerics/sequence_number_util.h"
 #include "modules/third_party/statcollect/StatCollect.h"
 
@@ -28,12 +36,18 @@ namespace webrtc {
 class Clock;
 class PacketRouter;
 namespace rtcp {
+class RemoteEstimate;
 class TransportFeedback;
 }
 
 // Class used when send-side BWE is enabled: This proxy is instantiated on the
 // receive side. It buffers a number of receive timestamps and then sends
 // transport feedback messages back too the send side.
+//
+// With the field trial WebRTC-RFC8888CongestionControlFeedback enabled, the
+// periodic feedback uses the RFC 8888 format, which reports packets by SSRC
+// and RTP sequence number together with their ECN codepoint, instead of
+// transport-wide sequence numbers.
 
 class RemoteEstimatorProxy : public RemoteBitrateEstimator {
  public:
@@ -41,20 +55,40 @@ class RemoteEstimatorProxy : public RemoteBitrateEstimator {
                        TransportFeedbackSenderInterface* feedback_sender,
                        const WebRtcKeyValueConfig* key_value_config,
                        NetworkStateEstimator* network_state_estimator);
+  // Runs the shadow estimators of the AlphaCC config on a task queue of
+  // |task_queue_factory|; without a factory there are none.
+  RemoteEstimatorProxy(Clock* clock,
+                       TransportFeedbackSenderInterface* feedback_sender,
+                       const WebRtcKeyValueConfig* key_value_config,
+                       NetworkStateEstimator* network_state_estimator,
+                       TaskQueueFactory* task_queue_factory);
   ~RemoteEstimatorProxy() override;
 
   void IncomingPacket(int64_t arrival_time_ms,
                       size_t payload_size,
                       const RTPHeader& header) override;
+  // As above, for a packet received with the IP ECN codepoint |ecn|.
+  void IncomingPacket(int64_t arrival_time_ms,
+                      size_t payload_size,
+                      const RTPHeader& header,
+                      rtc::EcnMarking ecn);
   void RemoveStream(uint32_t ssrc) override {}
   bool LatestEstimate(std::vector<unsigned int>* ssrcs,
                       unsigned int* bitrate_bps) const override;
-  void OnRttUpdate(int64_t avg_rtt_ms, int64_t max_rtt_ms) override {}
+  void OnRttUpdate(int64_t avg_rtt_ms, int64_t max_rtt_ms) override;
   void SetMinBitrate(int min_bitrate_bps) override {}
   int64_t TimeUntilNextProcess() override;
   void Process() override;
+  // Sends periodic feedback if it is due at |now|, for running the proxy from
+  // a repeating task instead of a ProcessThread. Returns the time left until
+  // feedback is due next. Deadlines advance by the send interval rather than
+  // from |now|, so a task that runs late doesn't push back the feedback after
+  // it.
+  TimeDelta Process(Timestamp now);
   void OnBitrateChanged(int bitrate);
   void SetSendPeriodicFeedback(bool send_periodic_feedback);
+  // Replaces the estimator whose estimates are sent back to the sender.
+  void SetEstimatorForTesting(std::unique_ptr<ReceiveSideEstimator> estimator);
 
  private:
   struct TransportWideFeedbackConfig {
@@ -79,6 +113,9 @@ class RemoteEstimatorProxy : public RemoteBitrateEstimator {
                        absl::optional<FeedbackRequest> feedback_request)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
   void SendPeriodicFeedbacks() RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
+  void SendCongestionControlFeedbacks(
+      std::unique_ptr<rtcp::RemoteEstimate> remote_estimate)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
   void SendFeedbackOnRequest(int64_t sequence_number,
                              const FeedbackRequest& feedback_request)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
@@ -99,10 +136,17 @@ class RemoteEstimatorProxy : public RemoteBitrateEstimator {
 
   uint32_t GetTtimeFromAbsSendtime(uint32_t absoluteSendTime)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
+  // Returns the send time in microseconds on the sender's clock. Prefers the
+  // transport send time extension, which unlike abs-send-time isn't limited
+  // to the millisecond clock of the sender. Must be called after
+  // GetTtimeFromAbsSendtime() for the same packet.
+  int64_t GetSendTimeUs(const RTPHeader& header)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
 
   Clock* const clock_;
   TransportFeedbackSenderInterface* const feedback_sender_;
   const TransportWideFeedbackConfig send_config_;
+  const bool send_congestion_control_feedback_;
   int64_t last_process_time_ms_;
 
   rtc::CriticalSection lock_;
@@ -115,6 +159,8 @@ class RemoteEstimatorProxy : public RemoteBitrateEstimator {
   absl::optional<int64_t> periodic_window_start_seq_ RTC_GUARDED_BY(&lock_);
   // Map unwrapped seq -> time.
   std::map<int64_t, int64_t> packet_arrival_times_ RTC_GUARDED_BY(&lock_);
+  CongestionControlFeedbackGenerator congestion_control_feedback_generator_
+      RTC_GUARDED_BY(&lock_);
   int64_t send_interval_ms_ RTC_GUARDED_BY(&lock_);
   bool send_periodic_feedback_ RTC_GUARDED_BY(&lock_);
 
@@ -126,7 +172,11 @@ class RemoteEstimatorProxy : public RemoteBitrateEstimator {
   StatCollect::StatsCollectModule stats_collect_;
   int cycles_ RTC_GUARDED_BY(&lock_);
   uint32_t max_abs_send_time_ RTC_GUARDED_BY(&lock_);
-  void* onnx_infer_;
+  absl::optional<int64_t> last_transport_send_time_us_ RTC_GUARDED_BY(&lock_);
+  // Number of packets received marked Congestion Experienced.
+  size_t ecn_ce_count_ RTC_GUARDED_BY(&lock_) = 0;
+  std::unique_ptr<ReceiveSideEstimator> estimator_ RTC_GUARDED_BY(&lock_);
+  std::unique_ptr<ShadowEstimators> shadow_estimators_ RTC_GUARDED_BY(&lock_);
 };
 
 }  // namespace webrtc
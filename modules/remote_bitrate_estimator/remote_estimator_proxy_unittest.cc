@@ -17,8 +17,10 @@
 #include "api/transport/network_types.h"
 #include "api/transport/test/mock_network_control.h"
 #include "modules/pacing/packet_router.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/congestion_control_feedback.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
 #include "system_wrappers/include/clock.h"
+#include "test/field_trial.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -482,6 +484,43 @@ TEST_F(RemoteEstimatorProxyTest, TwccReportsUse5PercentOfAvailableBandwidth) {
   EXPECT_EQ(136, proxy_.TimeUntilNextProcess());
 }
 
+TEST_F(RemoteEstimatorProxyTest, ProcessAtTimeReturnsDelayUntilNextFeedback) {
+  EXPECT_EQ(TimeDelta::Millis(kDefaultSendIntervalMs),
+            proxy_.Process(clock_.CurrentTime()));
+  clock_.AdvanceTimeMilliseconds(40);
+  EXPECT_EQ(TimeDelta::Millis(kDefaultSendIntervalMs - 40),
+            proxy_.Process(clock_.CurrentTime()));
+}
+
+TEST_F(RemoteEstimatorProxyTest, ProcessAtTimeKeepsDeadlinesWhenCalledLate) {
+  proxy_.Process(clock_.CurrentTime());
+  // The wakeup is 3 ms late; the next feedback is still due two intervals
+  // after the first.
+  clock_.AdvanceTimeMilliseconds(kDefaultSendIntervalMs + 3);
+  EXPECT_EQ(TimeDelta::Millis(kDefaultSendIntervalMs - 3),
+            proxy_.Process(clock_.CurrentTime()));
+  clock_.AdvanceTimeMilliseconds(kDefaultSendIntervalMs - 3);
+  EXPECT_EQ(TimeDelta::Millis(kDefaultSendIntervalMs),
+            proxy_.Process(clock_.CurrentTime()));
+}
+
+TEST_F(RemoteEstimatorProxyTest, ProcessAtTimeCatchesUpAfterDelayedWakeup) {
+  proxy_.Process(clock_.CurrentTime());
+  // Almost a whole interval late: feedback is sent and the next one is due
+  // right after.
+  clock_.AdvanceTimeMilliseconds(2 * kDefaultSendIntervalMs - 1);
+  EXPECT_EQ(TimeDelta::Millis(1), proxy_.Process(clock_.CurrentTime()));
+}
+
+TEST_F(RemoteEstimatorProxyTest, ProcessAtTimeStartsOverAfterMissedInterval) {
+  proxy_.Process(clock_.CurrentTime());
+  clock_.AdvanceTimeMilliseconds(2 * kDefaultSendIntervalMs + 50);
+  EXPECT_EQ(TimeDelta::Millis(kDefaultSendIntervalMs),
+            proxy_.Process(clock_.CurrentTime()));
+  clock_.AdvanceTimeMilliseconds(kDefaultSendIntervalMs - 1);
+  EXPECT_EQ(TimeDelta::Millis(1), proxy_.Process(clock_.CurrentTime()));
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // Tests for the extended protocol where the feedback is explicitly requested
 // by the sender.
@@ -492,6 +531,11 @@ TEST_F(RemoteEstimatorProxyOnRequestTest, TimeUntilNextProcessIsHigh) {
   EXPECT_GE(proxy_.TimeUntilNextProcess(), 60 * 60 * 1000);
 }
 
+TEST_F(RemoteEstimatorProxyOnRequestTest, ProcessAtTimeReturnsInfinity) {
+  proxy_.SetSendPeriodicFeedback(false);
+  EXPECT_TRUE(proxy_.Process(clock_.CurrentTime()).IsPlusInfinity());
+}
+
 TEST_F(RemoteEstimatorProxyOnRequestTest, ProcessDoesNotSendFeedback) {
   proxy_.SetSendPeriodicFeedback(false);
   IncomingPacket(kBaseSeq, kBaseTimeMs);
@@ -667,5 +711,46 @@ TEST_F(RemoteEstimatorProxyTest, SendTransportFeedbackAndNetworkStateUpdate) {
   Process();
 }
 
+TEST(RemoteEstimatorProxyCongestionControlFeedbackTest,
+     SendsCongestionControlFeedback) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-RFC8888CongestionControlFeedback/Enabled/");
+  FieldTrialBasedConfig field_trial_config;
+  SimulatedClock clock(0);
+  ::testing::StrictMock<MockTransportFeedbackSender> router;
+  RemoteEstimatorProxy proxy(&clock, &router, &field_trial_config, nullptr);
+
+  RTPHeader header;
+  header.ssrc = kMediaSsrc;
+  header.sequenceNumber = kBaseSeq;
+  proxy.IncomingPacket(kBaseTimeMs, kDefaultPacketSize, header,
+                       rtc::EcnMarking::kCe);
+  header.sequenceNumber = kBaseSeq + 2;
+  proxy.IncomingPacket(kBaseTimeMs + 10, kDefaultPacketSize, header,
+                       rtc::EcnMarking::kEct1);
+
+  EXPECT_CALL(router, SendCombinedRtcpPacket)
+      .WillOnce(
+          [](std::vector<std::unique_ptr<rtcp::RtcpPacket>> feedback_packets) {
+            EXPECT_THAT(feedback_packets, SizeIs(1));
+            const auto* feedback =
+                static_cast<const rtcp::CongestionControlFeedback*>(
+                    feedback_packets[0].get());
+            const auto& packets = feedback->packets();
+            EXPECT_THAT(packets, SizeIs(3));
+            EXPECT_EQ(packets[0].ssrc, kMediaSsrc);
+            EXPECT_EQ(packets[0].sequence_number, kBaseSeq);
+            EXPECT_EQ(packets[0].ecn, rtc::EcnMarking::kCe);
+            EXPECT_FALSE(packets[1].received());
+            EXPECT_EQ(packets[2].ecn, rtc::EcnMarking::kEct1);
+            EXPECT_EQ(packets[0].arrival_time_offset -
+                          packets[2].arrival_time_offset,
+                      TimeDelta::Millis(10));
+            return true;
+          });
+  clock.AdvanceTimeMilliseconds(kBaseTimeMs + kDefaultSendIntervalMs);
+  proxy.Process();
+}
+
 }  // namespace
 }  // namespace webrtc
@@ -0,0 +1,121 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/shadow_estimators.h"
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+namespace {
+
+// Batches handed over but not yet processed, beyond which batches are
+// dropped. At the default estimate interval of 200 ms that's 1.6 seconds.
+constexpr int kMaxPendingBatches = 8;
+
+}  // namespace
+
+ShadowEstimators::Report::Report() = default;
+ShadowEstimators::Report::Report(const Report&) = default;
+ShadowEstimators::Report::~Report() = default;
+
+ShadowEstimators::ShadowEstimators(
+    TaskQueueFactory* task_queue_factory,
+    std::vector<NamedEstimator> estimators,
+    std::function<void(const Report&)> on_report)
+    : num_estimators_(estimators.size()),
+      on_report_(std::move(on_report)),
+      estimators_(std::move(estimators)),
+      task_queue_(task_queue_factory->CreateTaskQueue(
+          "ShadowEstimators",
+          TaskQueueFactory::Priority::LOW)) {}
+
+ShadowEstimators::~ShadowEstimators() = default;
+
+void ShadowEstimators::OnReceived(const ReceiveSideEstimator::Packet& packet) {
+  batch_.push_back(packet);
+}
+
+void ShadowEstimators::OnPrimaryEstimate(int64_t now_ms, float estimate_bps) {
+  const absl::optional<int64_t> start_ms = last_estimate_time_ms_;
+  last_estimate_time_ms_ = now_ms;
+  if (pending_batches_.load(std::memory_order_relaxed) >= kMaxPendingBatches) {
+    batch_.clear();
+    dropped_batches_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  std::vector<ReceiveSideEstimator::Packet> batch;
+  batch.reserve(batch_.capacity());
+  batch.swap(batch_);
+  pending_batches_.fetch_add(1, std::memory_order_relaxed);
+  task_queue_.PostTask([this, batch = std::move(batch), start_ms, now_ms,
+                        estimate_bps]() mutable {
+    ProcessBatch(std::move(batch), start_ms, now_ms, estimate_bps);
+    pending_batches_.fetch_sub(1, std::memory_order_relaxed);
+  });
+}
+
+void ShadowEstimators::OnRttUpdate(int64_t avg_rtt_ms) {
+  task_queue_.PostTask([this, avg_rtt_ms] {
+    for (NamedEstimator& estimator : estimators_)
+      estimator.second->OnRttUpdate(avg_rtt_ms);
+  });
+}
+
+void ShadowEstimators::ProcessBatch(
+    std::vector<ReceiveSideEstimator::Packet> batch,
+    absl::optional<int64_t> start_ms,
+    int64_t now_ms,
+    float primary_estimate_bps) {
+  RTC_DCHECK(task_queue_.IsCurrent());
+  Report report;
+  report.time_ms = now_ms;
+  report.primary_estimate_bps = primary_estimate_bps;
+  report.packets = batch.size();
+  report.dropped_batches = dropped_batches_.load(std::memory_order_relaxed);
+
+  const int64_t start_us = rtc::TimeMicros();
+  report.estimates_bps.reserve(estimators_.size());
+  for (NamedEstimator& estimator : estimators_) {
+    for (const ReceiveSideEstimator::Packet& packet : batch)
+      estimator.second->OnReceived(packet);
+    report.estimates_bps.push_back(estimator.second->GetBweEstimate(now_ms));
+  }
+  report.processing_time_us = rtc::TimeMicros() - start_us;
+
+  if (start_ms && now_ms > *start_ms) {
+    size_t bytes = 0;
+    for (const ReceiveSideEstimator::Packet& packet : batch)
+      bytes += packet.payload_size;
+    report.receive_rate_bps = bytes * 8 * 1000.f / (now_ms - *start_ms);
+  }
+
+  rtc::StringBuilder log;
+  log << "{\"shadow_estimates\": {\"time_ms\": " << report.time_ms
+      << ", \"receive_rate\": ";
+  if (report.receive_rate_bps) {
+    log << *report.receive_rate_bps;
+  } else {
+    log << "null";
+  }
+  log << ", \"primary\": " << report.primary_estimate_bps;
+  for (size_t i = 0; i < estimators_.size(); ++i)
+    log << ", \"" << estimators_[i].first << "\": " << report.estimates_bps[i];
+  log << ", \"processing_time_us\": " << report.processing_time_us
+      << ", \"dropped_batches\": " << report.dropped_batches << "}}";
+  RTC_LOG(LS_INFO) << log.str();
+
+  if (on_report_)
+    on_report_(report);
+}
+
+}  // namespace webrtc
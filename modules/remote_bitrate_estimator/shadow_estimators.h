@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_SHADOW_ESTIMATORS_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_SHADOW_ESTIMATORS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "modules/remote_bitrate_estimator/receive_side_estimator.h"
+#include "rtc_base/constructor_magic.h"
+#include "rtc_base/task_queue.h"
+
+namespace webrtc {
+
+// Runs estimators in the shadow of the one whose estimates RemoteEstimatorProxy
+// sends, on the same packets, so that estimators can be compared under the
+// same network conditions. The packets are handed to a low priority task
+// queue in a batch per estimate of the primary estimator. There every shadow
+// estimator is fed the batch and asked for an estimate, and the estimates are
+// logged with the primary's and the receive rate of the batch. When the task
+// queue falls behind, batches are dropped instead of queued, so the shadows
+// never hold up the primary.
+class ShadowEstimators {
+ public:
+  // The estimates for a batch.
+  struct Report {
+    Report();
+    Report(const Report&);
+    ~Report();
+
+    int64_t time_ms = 0;
+    // Receive rate since the previous estimate of the primary, unset for the
+    // first one.
+    absl::optional<float> receive_rate_bps;
+    float primary_estimate_bps = 0;
+    // In the order of the estimators.
+    std::vector<float> estimates_bps;
+    size_t packets = 0;
+    // Time it took the shadow estimators to process the batch.
+    int64_t processing_time_us = 0;
+    // Batches dropped so far.
+    int dropped_batches = 0;
+  };
+  using NamedEstimator =
+      std::pair<std::string, std::unique_ptr<ReceiveSideEstimator>>;
+
+  // |on_report|, if set, is called on the task queue after each report is
+  // logged.
+  ShadowEstimators(TaskQueueFactory* task_queue_factory,
+                   std::vector<NamedEstimator> estimators,
+                   std::function<void(const Report&)> on_report = nullptr);
+  ~ShadowEstimators();
+
+  // Must be called on the packet path of the primary estimator.
+  void OnReceived(const ReceiveSideEstimator::Packet& packet);
+  void OnPrimaryEstimate(int64_t now_ms, float estimate_bps);
+  void OnRttUpdate(int64_t avg_rtt_ms);
+
+  size_t num_estimators() const { return num_estimators_; }
+
+ private:
+  void ProcessBatch(std::vector<ReceiveSideEstimator::Packet> batch,
+                    absl::optional<int64_t> start_ms,
+                    int64_t now_ms,
+                    float primary_estimate_bps);
+
+  const size_t num_estimators_;
+  const std::function<void(const Report&)> on_report_;
+  // Only used on the task queue.
+  std::vector<NamedEstimator> estimators_;
+
+  // Packets since the previous estimate of the primary.
+  std::vector<ReceiveSideEstimator::Packet> batch_;
+  absl::optional<int64_t> last_estimate_time_ms_;
+  std::atomic<int> pending_batches_{0};
+  std::atomic<int> dropped_batches_{0};
+
+  // Last, so that it's destroyed, and tasks stopped, first.
+  rtc::TaskQueue task_queue_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ShadowEstimators);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_SHADOW_ESTIMATORS_H_
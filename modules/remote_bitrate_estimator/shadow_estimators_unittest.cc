@@ -0,0 +1,154 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/shadow_estimators.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/task_queue/default_task_queue_factory.h"
+#include "rtc_base/event.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+
+constexpr int kWaitMs = 5000;
+
+// Records the sequence numbers and the RTT it's fed, and estimates the number
+// of packets.
+class FakeEstimator : public ReceiveSideEstimator {
+ public:
+  FakeEstimator(std::vector<uint16_t>* sequence_numbers,
+                int64_t* avg_rtt_ms,
+                rtc::Event* release = nullptr)
+      : sequence_numbers_(sequence_numbers),
+        avg_rtt_ms_(avg_rtt_ms),
+        release_(release) {}
+
+  void OnReceived(const Packet& packet) override {
+    sequence_numbers_->push_back(packet.sequence_number);
+  }
+  float GetBweEstimate(int64_t now_ms) override {
+    if (release_)
+      release_->Wait(rtc::Event::kForever);
+    return sequence_numbers_->size();
+  }
+  void OnRttUpdate(int64_t avg_rtt_ms) override { *avg_rtt_ms_ = avg_rtt_ms; }
+
+ private:
+  std::vector<uint16_t>* const sequence_numbers_;
+  int64_t* const avg_rtt_ms_;
+  rtc::Event* const release_;
+};
+
+ReceiveSideEstimator::Packet MakePacket(uint16_t sequence_number) {
+  ReceiveSideEstimator::Packet packet;
+  packet.sequence_number = sequence_number;
+  packet.payload_size = 1000;
+  return packet;
+}
+
+class ShadowEstimatorsTest : public ::testing::Test {
+ protected:
+  // Creates shadows that record into |first_| and |second_|, the second
+  // waiting for |release| if set, and signal |reported_| after
+  // |expected_reports|.
+  void CreateShadows(size_t expected_reports, rtc::Event* release = nullptr) {
+    std::vector<ShadowEstimators::NamedEstimator> estimators;
+    estimators.emplace_back(
+        "first", std::make_unique<FakeEstimator>(&first_, &first_rtt_ms_));
+    estimators.emplace_back(
+        "second",
+        std::make_unique<FakeEstimator>(&second_, &second_rtt_ms_, release));
+    shadows_ = std::make_unique<ShadowEstimators>(
+        task_queue_factory_.get(), std::move(estimators),
+        [this, expected_reports](const ShadowEstimators::Report& report) {
+          reports_.push_back(report);
+          if (reports_.size() == expected_reports)
+            reported_.Set();
+        });
+  }
+
+  const std::unique_ptr<TaskQueueFactory> task_queue_factory_ =
+      CreateDefaultTaskQueueFactory();
+  std::vector<uint16_t> first_;
+  std::vector<uint16_t> second_;
+  int64_t first_rtt_ms_ = -1;
+  int64_t second_rtt_ms_ = -1;
+  // Only read after |reported_|.
+  std::vector<ShadowEstimators::Report> reports_;
+  rtc::Event reported_;
+  std::unique_ptr<ShadowEstimators> shadows_;
+};
+
+TEST_F(ShadowEstimatorsTest, FeedsEveryShadowTheSamePackets) {
+  CreateShadows(2);
+  shadows_->OnReceived(MakePacket(1));
+  shadows_->OnReceived(MakePacket(2));
+  shadows_->OnPrimaryEstimate(1000, 300000.f);
+  shadows_->OnReceived(MakePacket(3));
+  shadows_->OnPrimaryEstimate(1100, 400000.f);
+  ASSERT_TRUE(reported_.Wait(kWaitMs));
+
+  EXPECT_THAT(first_, ElementsAre(1, 2, 3));
+  EXPECT_THAT(second_, ElementsAre(1, 2, 3));
+  EXPECT_EQ(reports_[0].time_ms, 1000);
+  EXPECT_EQ(reports_[0].primary_estimate_bps, 300000.f);
+  EXPECT_THAT(reports_[0].estimates_bps, ElementsAre(2.f, 2.f));
+  EXPECT_EQ(reports_[0].packets, 2u);
+  EXPECT_FALSE(reports_[0].receive_rate_bps);
+  EXPECT_EQ(reports_[1].primary_estimate_bps, 400000.f);
+  EXPECT_THAT(reports_[1].estimates_bps, ElementsAre(3.f, 3.f));
+  // 1000 bytes in 100 ms.
+  ASSERT_TRUE(reports_[1].receive_rate_bps);
+  EXPECT_FLOAT_EQ(*reports_[1].receive_rate_bps, 80000.f);
+}
+
+TEST_F(ShadowEstimatorsTest, ForwardsRttToEveryShadow) {
+  CreateShadows(1);
+  shadows_->OnRttUpdate(40);
+  shadows_->OnReceived(MakePacket(1));
+  shadows_->OnPrimaryEstimate(1000, 300000.f);
+  // The RTT is handed to the task queue before the batch.
+  ASSERT_TRUE(reported_.Wait(kWaitMs));
+
+  EXPECT_EQ(first_rtt_ms_, 40);
+  EXPECT_EQ(second_rtt_ms_, 40);
+}
+
+TEST_F(ShadowEstimatorsTest, DropsBatchesInsteadOfWaiting) {
+  rtc::Event release(/*manual_reset=*/true, /*initially_signaled=*/false);
+  CreateShadows(8, &release);
+  // The first batch blocks the task queue, the next seven wait for it and the
+  // rest are dropped without waiting.
+  constexpr int kBatches = 12;
+  for (int batch = 0; batch < kBatches; ++batch) {
+    shadows_->OnReceived(MakePacket(batch));
+    shadows_->OnPrimaryEstimate(1000 + 100 * batch, 300000.f);
+  }
+  release.Set();
+  ASSERT_TRUE(reported_.Wait(kWaitMs));
+
+  EXPECT_THAT(first_, ElementsAre(0, 1, 2, 3, 4, 5, 6, 7));
+  EXPECT_EQ(second_, first_);
+  EXPECT_EQ(reports_.back().dropped_batches, kBatches - 8);
+  // The receive rate covers the time since the previous primary estimate,
+  // whether or not its batch was dropped.
+  ASSERT_TRUE(reports_.back().receive_rate_bps);
+  EXPECT_FLOAT_EQ(*reports_.back().receive_rate_bps, 80000.f);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -35,6 +35,7 @@
 namespace webrtc {
 class RtpPacket;
 namespace rtcp {
+class CongestionControlFeedback;
 class TransportFeedback;
 class App;
 }  // namespace rtcp
@@ -78,6 +79,7 @@ enum RTPExtensionType : int {
   kRtpExtensionGenericFrameDescriptor = kRtpExtensionGenericFrameDescriptor00,
   kRtpExtensionGenericFrameDescriptor02,
   kRtpExtensionColorSpace,
+  kRtpExtensionTransportSendTime,
   kRtpExtensionNumberOfExtensions  // Must be the last entity in the enum.
 };
 
@@ -103,7 +105,8 @@ enum RTCPPacketType : uint32_t {
   kRtcpXrReceiverReferenceTime = 0x40000,
   kRtcpXrDlrrReportBlock = 0x80000,
   kRtcpTransportFeedback = 0x100000,
-  kRtcpXrTargetBitrate = 0x200000
+  kRtcpXrTargetBitrate = 0x200000,
+  kRtcpCongestionControlFeedback = 0x400000
 };
 
 enum RtxMode {
@@ -234,6 +237,9 @@ struct RtpPacketSendInfo {
 
   uint16_t transport_sequence_number = 0;
   uint32_t ssrc = 0;
+  // SSRC the packet was sent with, which differs from |ssrc| for RTX and
+  // FlexFEC packets. |rtp_sequence_number| belongs to this SSRC.
+  uint32_t rtp_ssrc = 0;
   uint16_t rtp_sequence_number = 0;
   size_t length = 0;
   absl::optional<RtpPacketMediaType> packet_type;
@@ -253,6 +259,8 @@ class TransportFeedbackObserver {
 
   virtual void OnAddPacket(const RtpPacketSendInfo& packet_info) = 0;
   virtual void OnTransportFeedback(const rtcp::TransportFeedback& feedback) = 0;
+  virtual void OnCongestionControlFeedback(
+      const rtcp::CongestionControlFeedback& feedback) {}
   virtual void OnApplicationPacket(const rtcp::App& app){}
 };
 
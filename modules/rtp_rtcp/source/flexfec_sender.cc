@@ -146,6 +146,7 @@ std::vector<std::unique_ptr<RtpPacketToSend>> FlexfecSender::GetFecPackets() {
     fec_packet_to_send->SetSsrc(ssrc_);
     // Reserve extensions, if registered. These will be set by the RTPSender.
     fec_packet_to_send->ReserveExtension<AbsoluteSendTime>();
+    fec_packet_to_send->ReserveExtension<TransportSendTime>();
     fec_packet_to_send->ReserveExtension<TransmissionOffset>();
     fec_packet_to_send->ReserveExtension<TransportSequenceNumber>();
     // Possibly include the MID header extension.
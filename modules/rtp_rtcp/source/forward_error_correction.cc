@@ -13,6 +13,7 @@
 #include <string.h>
 
 #include <algorithm>
+#include <iterator>
 #include <utility>
 
 #include "absl/algorithm/container.h"
@@ -31,6 +32,23 @@ namespace webrtc {
 namespace {
 // Transport header size in bytes. Assume UDP/IPv4 as a reasonable minimum.
 constexpr size_t kTransportOverhead = 28;
+
+// Returns the first position in |packets|, sorted by sequence number, that
+// holds a packet no older than |seq_num|. Searches from the back, since
+// packets mostly arrive in order and then belong at or near the end.
+template <typename T>
+typename std::list<std::unique_ptr<T>>::iterator LowerBoundFromBack(
+    std::list<std::unique_ptr<T>>* packets,
+    uint16_t seq_num) {
+  auto it = packets->end();
+  while (it != packets->begin()) {
+    auto prev = std::prev(it);
+    if (IsNewerSequenceNumber(seq_num, (*prev)->seq_num))
+      break;
+    it = prev;
+  }
+  return it;
+}
 }  // namespace
 
 ForwardErrorCorrection::Packet::Packet() : data(0), ref_count_(0) {}
@@ -48,16 +66,8 @@ int32_t ForwardErrorCorrection::Packet::Release() {
   return ref_count;
 }
 
-// This comparator is used to compare std::unique_ptr's pointing to
-// subclasses of SortablePackets. It needs to be parametric since
-// the std::unique_ptr's are not covariant w.r.t. the types that
-// they are pointing to.
-template <typename S, typename T>
-bool ForwardErrorCorrection::SortablePacket::LessThan::operator()(
-    const S& first,
-    const T& second) {
-  RTC_DCHECK_EQ(first->ssrc, second->ssrc);
-  return IsNewerSequenceNumber(second->seq_num, first->seq_num);
+bool ForwardErrorCorrection::Packet::HasOneRef() const {
+  return ref_count_ == 1;
 }
 
 ForwardErrorCorrection::ReceivedPacket::ReceivedPacket() = default;
@@ -69,7 +79,8 @@ ForwardErrorCorrection::RecoveredPacket::~RecoveredPacket() = default;
 ForwardErrorCorrection::ProtectedPacket::ProtectedPacket() = default;
 ForwardErrorCorrection::ProtectedPacket::~ProtectedPacket() = default;
 
-ForwardErrorCorrection::ReceivedFecPacket::ReceivedFecPacket() = default;
+ForwardErrorCorrection::ReceivedFecPacket::ReceivedFecPacket()
+    : num_missing_protected_packets(0) {}
 ForwardErrorCorrection::ReceivedFecPacket::~ReceivedFecPacket() = default;
 
 ForwardErrorCorrection::ForwardErrorCorrection(
@@ -354,6 +365,9 @@ void ForwardErrorCorrection::ResetState(
   // Free the memory for any existing recovered packets, if the caller hasn't.
   recovered_packets->clear();
   received_fec_packets_.clear();
+  received_fec_packet_pool_.clear();
+  recovered_packet_pool_.clear();
+  packet_pool_.clear();
 }
 
 void ForwardErrorCorrection::InsertMediaPacket(
@@ -361,16 +375,18 @@ void ForwardErrorCorrection::InsertMediaPacket(
     const ReceivedPacket& received_packet) {
   RTC_DCHECK_EQ(received_packet.ssrc, protected_media_ssrc_);
 
-  // Search for duplicate packets.
-  for (const auto& recovered_packet : *recovered_packets) {
-    RTC_DCHECK_EQ(recovered_packet->ssrc, received_packet.ssrc);
-    if (recovered_packet->seq_num == received_packet.seq_num) {
-      // Duplicate packet, no need to add to list.
-      return;
-    }
+  auto position =
+      LowerBoundFromBack(recovered_packets, received_packet.seq_num);
+  if (position != recovered_packets->end() &&
+      (*position)->seq_num == received_packet.seq_num) {
+    // Duplicate packet, no need to add to list.
+    RTC_DCHECK_EQ((*position)->ssrc, received_packet.ssrc);
+    return;
   }
 
-  std::unique_ptr<RecoveredPacket> recovered_packet(new RecoveredPacket());
+  RecoveredPacketList packets;
+  AddRecoveredPacket(&packets);
+  RecoveredPacket* recovered_packet = packets.front().get();
   // This "recovered packet" was not recovered using parity packets.
   recovered_packet->was_recovered = false;
   // This media packet has already been passed on.
@@ -378,24 +394,76 @@ void ForwardErrorCorrection::InsertMediaPacket(
   recovered_packet->ssrc = received_packet.ssrc;
   recovered_packet->seq_num = received_packet.seq_num;
   recovered_packet->pkt = received_packet.pkt;
-  // TODO(holmer): Consider replacing this with a binary search for the right
-  // position, and then just insert the new packet. Would get rid of the sort.
-  RecoveredPacket* recovered_packet_ptr = recovered_packet.get();
-  recovered_packets->push_back(std::move(recovered_packet));
-  recovered_packets->sort(SortablePacket::LessThan());
-  UpdateCoveringFecPackets(*recovered_packet_ptr);
+  recovered_packets->splice(position, packets);
+  UpdateCoveringFecPackets(*recovered_packet);
+}
+
+void ForwardErrorCorrection::AddRecoveredPacket(RecoveredPacketList* packets) {
+  if (recovered_packet_pool_.empty()) {
+    packets->emplace_back(new RecoveredPacket());
+  } else {
+    packets->splice(packets->end(), recovered_packet_pool_,
+                    recovered_packet_pool_.begin());
+  }
+}
+
+void ForwardErrorCorrection::RecycleRecoveredPacket(
+    RecoveredPacketList* packets,
+    RecoveredPacketList::iterator it) {
+  const size_t max_media_packets = fec_header_reader_->MaxMediaPackets();
+  RecoveredPacket* packet = it->get();
+  // Only recovered packets have storage of their own. That of media packets
+  // belongs to the caller.
+  if (packet->was_recovered && packet->pkt && packet->pkt->HasOneRef() &&
+      packet_pool_.size() < max_media_packets) {
+    packet_pool_.push_back(std::move(packet->pkt));
+  }
+  packet->pkt = nullptr;
+  if (recovered_packet_pool_.size() < max_media_packets) {
+    recovered_packet_pool_.splice(recovered_packet_pool_.end(), *packets, it);
+  } else {
+    packets->erase(it);
+  }
+}
+
+ForwardErrorCorrection::ReceivedFecPacketList::iterator
+ForwardErrorCorrection::RecycleFecPacket(ReceivedFecPacketList::iterator it) {
+  auto next = std::next(it);
+  (*it)->pkt = nullptr;
+  // Keep the capacity of |protected_packets|, drop the references.
+  (*it)->protected_packets.clear();
+  if (received_fec_packet_pool_.size() < fec_header_reader_->MaxFecPackets()) {
+    received_fec_packet_pool_.splice(received_fec_packet_pool_.end(),
+                                     received_fec_packets_, it);
+  } else {
+    received_fec_packets_.erase(it);
+  }
+  return next;
 }
 
 void ForwardErrorCorrection::UpdateCoveringFecPackets(
     const RecoveredPacket& packet) {
   for (auto& fec_packet : received_fec_packets_) {
-    // Is this FEC packet protecting the media packet |packet|?
+    // Is this FEC packet protecting the media packet |packet|? The protected
+    // packets are sorted, so first check that |packet| is within their range.
+    ProtectedPacketList& protected_packets = fec_packet->protected_packets;
+    if (IsNewerSequenceNumber(protected_packets.front().seq_num,
+                              packet.seq_num) ||
+        IsNewerSequenceNumber(packet.seq_num,
+                              protected_packets.back().seq_num)) {
+      continue;
+    }
     auto protected_it = absl::c_lower_bound(
-        fec_packet->protected_packets, &packet, SortablePacket::LessThan());
-    if (protected_it != fec_packet->protected_packets.end() &&
-        (*protected_it)->seq_num == packet.seq_num) {
+        protected_packets, packet.seq_num,
+        [](const ProtectedPacket& protected_packet, uint16_t seq_num) {
+          return IsNewerSequenceNumber(seq_num, protected_packet.seq_num);
+        });
+    if (protected_it != protected_packets.end() &&
+        protected_it->seq_num == packet.seq_num) {
       // Found an FEC packet which is protecting |packet|.
-      (*protected_it)->pkt = packet.pkt;
+      if (!protected_it->pkt)
+        --fec_packet->num_missing_protected_packets;
+      protected_it->pkt = packet.pkt;
     }
   }
 }
@@ -405,22 +473,37 @@ void ForwardErrorCorrection::InsertFecPacket(
     const ReceivedPacket& received_packet) {
   RTC_DCHECK_EQ(received_packet.ssrc, ssrc_);
 
-  // Check for duplicate.
-  for (const auto& existing_fec_packet : received_fec_packets_) {
-    RTC_DCHECK_EQ(existing_fec_packet->ssrc, received_packet.ssrc);
-    if (existing_fec_packet->seq_num == received_packet.seq_num) {
-      // Drop duplicate FEC packet data.
-      return;
-    }
+  auto position =
+      LowerBoundFromBack(&received_fec_packets_, received_packet.seq_num);
+  if (position != received_fec_packets_.end() &&
+      (*position)->seq_num == received_packet.seq_num) {
+    // Drop duplicate FEC packet data.
+    RTC_DCHECK_EQ((*position)->ssrc, received_packet.ssrc);
+    return;
   }
 
-  std::unique_ptr<ReceivedFecPacket> fec_packet(new ReceivedFecPacket());
+  // Parse the packet in a list of its own, where it's spliced from the pool
+  // and back on failure.
+  ReceivedFecPacketList fec_packets;
+  if (received_fec_packet_pool_.empty()) {
+    fec_packets.emplace_back(new ReceivedFecPacket());
+  } else {
+    fec_packets.splice(fec_packets.end(), received_fec_packet_pool_,
+                       received_fec_packet_pool_.begin());
+  }
+  ReceivedFecPacket* fec_packet = fec_packets.front().get();
   fec_packet->pkt = received_packet.pkt;
   fec_packet->ssrc = received_packet.ssrc;
   fec_packet->seq_num = received_packet.seq_num;
+  auto drop = [&] {
+    fec_packet->pkt = nullptr;
+    received_fec_packet_pool_.splice(received_fec_packet_pool_.end(),
+                                     fec_packets);
+  };
   // Parse ULPFEC/FlexFEC header specific info.
-  bool ret = fec_header_reader_->ReadFecHeader(fec_packet.get());
+  bool ret = fec_header_reader_->ReadFecHeader(fec_packet);
   if (!ret) {
+    drop();
     return;
   }
 
@@ -428,30 +511,33 @@ void ForwardErrorCorrection::InsertFecPacket(
   if (fec_packet->protected_ssrc != protected_media_ssrc_) {
     RTC_LOG(LS_INFO)
         << "Received FEC packet is protecting an unknown media SSRC; dropping.";
+    drop();
     return;
   }
 
   if (fec_packet->packet_mask_offset + fec_packet->packet_mask_size >
       fec_packet->pkt->data.size()) {
     RTC_LOG(LS_INFO) << "Received corrupted FEC packet; dropping.";
+    drop();
     return;
   }
 
   // Parse packet mask from header and represent as protected packets.
+  RTC_DCHECK(fec_packet->protected_packets.empty());
   for (uint16_t byte_idx = 0; byte_idx < fec_packet->packet_mask_size;
        ++byte_idx) {
     uint8_t packet_mask =
         fec_packet->pkt->data[fec_packet->packet_mask_offset + byte_idx];
     for (uint16_t bit_idx = 0; bit_idx < 8; ++bit_idx) {
       if (packet_mask & (1 << (7 - bit_idx))) {
-        std::unique_ptr<ProtectedPacket> protected_packet(
-            new ProtectedPacket());
+        fec_packet->protected_packets.emplace_back();
+        ProtectedPacket& protected_packet =
+            fec_packet->protected_packets.back();
         // This wraps naturally with the sequence number.
-        protected_packet->ssrc = protected_media_ssrc_;
-        protected_packet->seq_num = static_cast<uint16_t>(
+        protected_packet.ssrc = protected_media_ssrc_;
+        protected_packet.seq_num = static_cast<uint16_t>(
             fec_packet->seq_num_base + (byte_idx << 3) + bit_idx);
-        protected_packet->pkt = nullptr;
-        fec_packet->protected_packets.push_back(std::move(protected_packet));
+        protected_packet.pkt = nullptr;
       }
     }
   }
@@ -459,15 +545,13 @@ void ForwardErrorCorrection::InsertFecPacket(
   if (fec_packet->protected_packets.empty()) {
     // All-zero packet mask; we can discard this FEC packet.
     RTC_LOG(LS_WARNING) << "Received FEC packet has an all-zero packet mask.";
+    drop();
   } else {
-    AssignRecoveredPackets(recovered_packets, fec_packet.get());
-    // TODO(holmer): Consider replacing this with a binary search for the right
-    // position, and then just insert the new packet. Would get rid of the sort.
-    received_fec_packets_.push_back(std::move(fec_packet));
-    received_fec_packets_.sort(SortablePacket::LessThan());
+    AssignRecoveredPackets(recovered_packets, fec_packet);
+    received_fec_packets_.splice(position, fec_packets);
     const size_t max_fec_packets = fec_header_reader_->MaxFecPackets();
     if (received_fec_packets_.size() > max_fec_packets) {
-      received_fec_packets_.pop_front();
+      RecycleFecPacket(received_fec_packets_.begin());
     }
     RTC_DCHECK_LE(received_fec_packets_.size(), max_fec_packets);
   }
@@ -477,23 +561,24 @@ void ForwardErrorCorrection::AssignRecoveredPackets(
     const RecoveredPacketList& recovered_packets,
     ReceivedFecPacket* fec_packet) {
   ProtectedPacketList* protected_packets = &fec_packet->protected_packets;
-  std::vector<RecoveredPacket*> recovered_protected_packets;
+  fec_packet->num_missing_protected_packets = protected_packets->size();
 
   // Find intersection between the (sorted) containers |protected_packets|
   // and |recovered_packets|, i.e. all protected packets that have already
   // been recovered. Update the corresponding protected packets to point to
   // the recovered packets.
-  auto it_p = protected_packets->cbegin();
+  auto it_p = protected_packets->begin();
   auto it_r = recovered_packets.cbegin();
-  SortablePacket::LessThan less_than;
   while (it_p != protected_packets->end() && it_r != recovered_packets.end()) {
-    if (less_than(*it_p, *it_r)) {
+    RTC_DCHECK_EQ(it_p->ssrc, (*it_r)->ssrc);
+    if (IsNewerSequenceNumber((*it_r)->seq_num, it_p->seq_num)) {
       ++it_p;
-    } else if (less_than(*it_r, *it_p)) {
+    } else if (IsNewerSequenceNumber(it_p->seq_num, (*it_r)->seq_num)) {
       ++it_r;
     } else {  // *it_p == *it_r.
       // This protected packet has already been recovered.
-      (*it_p)->pkt = (*it_r)->pkt;
+      it_p->pkt = (*it_r)->pkt;
+      --fec_packet->num_missing_protected_packets;
       ++it_p;
       ++it_r;
     }
@@ -522,7 +607,7 @@ void ForwardErrorCorrection::InsertPacket(
     while (it != received_fec_packets_.end()) {
       uint16_t seq_num_diff = MinDiff(received_packet.seq_num, (*it)->seq_num);
       if (seq_num_diff > 0x3fff) {
-        it = received_fec_packets_.erase(it);
+        it = RecycleFecPacket(it);
       } else {
         // No need to keep iterating, since |received_fec_packets_| is sorted.
         break;
@@ -542,8 +627,7 @@ void ForwardErrorCorrection::InsertPacket(
 bool ForwardErrorCorrection::StartPacketRecovery(
     const ReceivedFecPacket& fec_packet,
     RecoveredPacket* recovered_packet) {
-  // Ensure pkt is initialized.
-  recovered_packet->pkt = new Packet();
+  RTC_DCHECK(recovered_packet->pkt);
   // Sanity check packet length.
   if (fec_packet.pkt->data.size() <
       fec_packet.fec_header_size + fec_packet.protection_length) {
@@ -648,13 +732,13 @@ bool ForwardErrorCorrection::RecoverPacket(const ReceivedFecPacket& fec_packet,
     return false;
   }
   for (const auto& protected_packet : fec_packet.protected_packets) {
-    if (protected_packet->pkt == nullptr) {
+    if (protected_packet.pkt == nullptr) {
       // This is the packet we're recovering.
-      recovered_packet->seq_num = protected_packet->seq_num;
+      recovered_packet->seq_num = protected_packet.seq_num;
     } else {
-      XorHeaders(*protected_packet->pkt, recovered_packet->pkt);
-      XorPayloads(*protected_packet->pkt,
-                  protected_packet->pkt->data.size() - kRtpHeaderSize,
+      XorHeaders(*protected_packet.pkt, recovered_packet->pkt);
+      XorPayloads(*protected_packet.pkt,
+                  protected_packet.pkt->data.size() - kRtpHeaderSize,
                   kRtpHeaderSize, recovered_packet->pkt);
     }
   }
@@ -673,26 +757,32 @@ void ForwardErrorCorrection::AttemptRecovery(
 
     // We can only recover one packet with an FEC packet.
     if (packets_missing == 1) {
-      // Recovery possible.
-      std::unique_ptr<RecoveredPacket> recovered_packet(new RecoveredPacket());
-      recovered_packet->pkt = nullptr;
-      if (!RecoverPacket(**fec_packet_it, recovered_packet.get())) {
+      // Recovery possible. Recover into a list of its own, with storage from
+      // the pool if there is any.
+      RecoveredPacketList packets;
+      AddRecoveredPacket(&packets);
+      RecoveredPacket* recovered_packet = packets.front().get();
+      if (packet_pool_.empty()) {
+        recovered_packet->pkt = new Packet();
+      } else {
+        recovered_packet->pkt = std::move(packet_pool_.back());
+        packet_pool_.pop_back();
+      }
+      if (!RecoverPacket(**fec_packet_it, recovered_packet)) {
         // Can't recover using this packet, drop it.
-        fec_packet_it = received_fec_packets_.erase(fec_packet_it);
+        RecycleRecoveredPacket(&packets, packets.begin());
+        fec_packet_it = RecycleFecPacket(fec_packet_it);
         continue;
       }
 
-      auto* recovered_packet_ptr = recovered_packet.get();
       // Add recovered packet to the list of recovered packets and update any
       // FEC packets covering this packet with a pointer to the data.
-      // TODO(holmer): Consider replacing this with a binary search for the
-      // right position, and then just insert the new packet. Would get rid of
-      // the sort.
-      recovered_packets->push_back(std::move(recovered_packet));
-      recovered_packets->sort(SortablePacket::LessThan());
-      UpdateCoveringFecPackets(*recovered_packet_ptr);
+      recovered_packets->splice(
+          LowerBoundFromBack(recovered_packets, recovered_packet->seq_num),
+          packets);
+      UpdateCoveringFecPackets(*recovered_packet);
       DiscardOldRecoveredPackets(recovered_packets);
-      fec_packet_it = received_fec_packets_.erase(fec_packet_it);
+      RecycleFecPacket(fec_packet_it);
 
       // A packet has been recovered. We need to check the FEC list again, as
       // this may allow additional packets to be recovered.
@@ -701,7 +791,7 @@ void ForwardErrorCorrection::AttemptRecovery(
     } else if (packets_missing == 0) {
       // Either all protected packets arrived or have been recovered. We can
       // discard this FEC packet.
-      fec_packet_it = received_fec_packets_.erase(fec_packet_it);
+      fec_packet_it = RecycleFecPacket(fec_packet_it);
     } else {
       fec_packet_it++;
     }
@@ -710,23 +800,21 @@ void ForwardErrorCorrection::AttemptRecovery(
 
 int ForwardErrorCorrection::NumCoveredPacketsMissing(
     const ReceivedFecPacket& fec_packet) {
-  int packets_missing = 0;
-  for (const auto& protected_packet : fec_packet.protected_packets) {
-    if (protected_packet->pkt == nullptr) {
-      ++packets_missing;
-      if (packets_missing > 1) {
-        break;  // We can't recover more than one packet.
-      }
-    }
-  }
-  return packets_missing;
+  RTC_DCHECK_EQ(fec_packet.num_missing_protected_packets,
+                absl::c_count_if(fec_packet.protected_packets,
+                                 [](const ProtectedPacket& protected_packet) {
+                                   return protected_packet.pkt == nullptr;
+                                 }));
+  // We can't recover more than one packet.
+  return static_cast<int>(
+      std::min<size_t>(fec_packet.num_missing_protected_packets, 2));
 }
 
 void ForwardErrorCorrection::DiscardOldRecoveredPackets(
     RecoveredPacketList* recovered_packets) {
   const size_t max_media_packets = fec_header_reader_->MaxMediaPackets();
   while (recovered_packets->size() > max_media_packets) {
-    recovered_packets->pop_front();
+    RecycleRecoveredPacket(recovered_packets, recovered_packets->begin());
   }
   RTC_DCHECK_LE(recovered_packets->size(), max_media_packets);
 }
@@ -53,6 +53,9 @@ class ForwardErrorCorrection {
     // reaches zero.
     virtual int32_t Release();
 
+    // True if the caller holds the only reference.
+    bool HasOneRef() const;
+
     rtc::CopyOnWriteBuffer data;  // Packet data.
 
    private:
@@ -62,14 +65,6 @@ class ForwardErrorCorrection {
   // TODO(holmer): Refactor into a proper class.
   class SortablePacket {
    public:
-    // Functor which returns true if the sequence number of |first|
-    // is < the sequence number of |second|. Should only ever be called for
-    // packets belonging to the same SSRC.
-    struct LessThan {
-      template <typename S, typename T>
-      bool operator()(const S& first, const T& second);
-    };
-
     uint32_t ssrc;
     uint16_t seq_num;
   };
@@ -116,7 +111,8 @@ class ForwardErrorCorrection {
     rtc::scoped_refptr<ForwardErrorCorrection::Packet> pkt;
   };
 
-  using ProtectedPacketList = std::list<std::unique_ptr<ProtectedPacket>>;
+  // Sorted by sequence number.
+  using ProtectedPacketList = std::vector<ProtectedPacket>;
 
   // Used for internal storage of received FEC packets in a list.
   //
@@ -128,6 +124,9 @@ class ForwardErrorCorrection {
 
     // List of media packets that this FEC packet protects.
     ProtectedPacketList protected_packets;
+    // Number of |protected_packets| that have neither been received nor
+    // recovered.
+    size_t num_missing_protected_packets;
     // RTP header fields.
     uint32_t ssrc;
     // FEC header fields.
@@ -230,7 +229,7 @@ class ForwardErrorCorrection {
   size_t MaxPacketOverhead() const;
 
   // Reset internal states from last frame and clear |recovered_packets|.
-  // Frees all memory allocated by this class.
+  // Frees all memory allocated by this class, including the pools.
   void ResetState(RecoveredPacketList* recovered_packets);
 
   // TODO(brandtr): Remove these functions when the Packet classes
@@ -273,6 +272,20 @@ class ForwardErrorCorrection {
   void InsertMediaPacket(RecoveredPacketList* recovered_packets,
                          const ReceivedPacket& received_packet);
 
+  // Moves a recovered packet from |recovered_packet_pool_|, or a new one if
+  // the pool is empty, to the end of |packets|.
+  void AddRecoveredPacket(RecoveredPacketList* packets);
+
+  // Moves the recovered packet at |it| in |packets| back to the pool, and its
+  // packet storage to |packet_pool_| if nobody else references it.
+  void RecycleRecoveredPacket(RecoveredPacketList* packets,
+                              RecoveredPacketList::iterator it);
+
+  // Removes the FEC packet at |it| from |received_fec_packets_| to
+  // |received_fec_packet_pool_|. Returns the iterator following it.
+  ReceivedFecPacketList::iterator RecycleFecPacket(
+      ReceivedFecPacketList::iterator it);
+
   // Assigns pointers to the recovered packet from all FEC packets which cover
   // it.
   // Note: This reduces the complexity when we want to try to recover a packet
@@ -316,7 +329,7 @@ class ForwardErrorCorrection {
   static bool FinishPacketRecovery(const ReceivedFecPacket& fec_packet,
                                    RecoveredPacket* recovered_packet);
 
-  // Recover a missing packet.
+  // Recover a missing packet into the packet storage of |recovered_packet|.
   static bool RecoverPacket(const ReceivedFecPacket& fec_packet,
                             RecoveredPacket* recovered_packet);
 
@@ -338,8 +351,17 @@ class ForwardErrorCorrection {
   std::unique_ptr<FecHeaderWriter> fec_header_writer_;
 
   std::vector<Packet> generated_fec_packets_;
+  // Sorted by sequence number.
   ReceivedFecPacketList received_fec_packets_;
 
+  // Storage of discarded packets, reused instead of allocating new ones for
+  // the next packets. The list nodes are spliced between the pools and the
+  // lists of packets in use. Each pool holds at most as many packets as the
+  // list it serves does.
+  ReceivedFecPacketList received_fec_packet_pool_;
+  RecoveredPacketList recovered_packet_pool_;
+  std::vector<rtc::scoped_refptr<Packet>> packet_pool_;
+
   // Arrays used to avoid dynamically allocating memory when generating
   // the packet masks.
   // (There are never more than |kUlpfecMaxMediaPackets| FEC packets generated.)
@@ -0,0 +1,146 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modules/rtp_rtcp/source/fec_test_helper.h"
+#include "modules/rtp_rtcp/source/forward_error_correction.h"
+#include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kMediaSsrc = 83542;
+constexpr uint32_t kFlexfecSsrc = 43245;
+
+// 2000 frames of 10 media packets, each frame protected by 5 FEC packets.
+constexpr int kNumFrames = 2000;
+constexpr int kNumMediaPacketsPerFrame = 10;
+constexpr uint8_t kProtectionFactor = 128;
+constexpr size_t kMinPacketSize = 500;
+constexpr size_t kMaxPacketSize = 1200;
+
+struct NetworkPacket {
+  bool is_fec;
+  uint32_t ssrc;
+  uint16_t seq_num;
+  rtc::CopyOnWriteBuffer data;
+};
+
+struct Stream {
+  std::vector<NetworkPacket> received_packets;
+  int lost_media_packets = 0;
+};
+
+// Encodes the frames with |fec| and drops every packet with probability
+// |loss_rate|. ULPFEC packets are numbered after the media packets of their
+// frame, FlexFEC packets have a sequence number space of their own.
+Stream CreateStream(ForwardErrorCorrection* fec,
+                    bool flexfec,
+                    double loss_rate) {
+  Random random(0xfec);
+  test::fec::MediaPacketGenerator media_packet_generator(
+      kMinPacketSize, kMaxPacketSize, kMediaSsrc, &random);
+  Stream stream;
+  uint16_t media_seq_num = 0x8000;
+  uint16_t flexfec_seq_num = 0;
+  for (int frame = 0; frame < kNumFrames; ++frame) {
+    ForwardErrorCorrection::PacketList media_packets =
+        media_packet_generator.ConstructMediaPackets(kNumMediaPacketsPerFrame,
+                                                     media_seq_num);
+    std::list<ForwardErrorCorrection::Packet*> fec_packets;
+    EXPECT_EQ(0, fec->EncodeFec(media_packets, kProtectionFactor, 0, false,
+                                kFecMaskRandom, &fec_packets));
+    for (const auto& media_packet : media_packets) {
+      if (random.Rand<double>() < loss_rate) {
+        ++stream.lost_media_packets;
+      } else {
+        stream.received_packets.push_back(
+            {false, kMediaSsrc, media_seq_num, media_packet->data});
+      }
+      ++media_seq_num;
+    }
+    for (const ForwardErrorCorrection::Packet* fec_packet : fec_packets) {
+      const uint16_t seq_num = flexfec ? flexfec_seq_num++ : media_seq_num++;
+      if (random.Rand<double>() >= loss_rate) {
+        // The generated FEC packets are reused by the next EncodeFec() call.
+        rtc::CopyOnWriteBuffer data(fec_packet->data.cdata(),
+                                    fec_packet->data.size());
+        stream.received_packets.push_back(
+            {true, flexfec ? kFlexfecSsrc : kMediaSsrc, seq_num, data});
+      }
+    }
+  }
+  return stream;
+}
+
+}  // namespace
+
+// Time DecodeFec() takes per received packet, including the walk over the
+// recovered packets that the receivers do after each call, at increasing
+// loss rates.
+TEST(ForwardErrorCorrectionPerformanceTest, DecodeThroughput) {
+  for (bool flexfec : {false, true}) {
+    for (int loss_percent : {0, 10, 20, 30}) {
+      std::unique_ptr<ForwardErrorCorrection> encoder =
+          flexfec ? ForwardErrorCorrection::CreateFlexfec(kFlexfecSsrc,
+                                                          kMediaSsrc)
+                  : ForwardErrorCorrection::CreateUlpfec(kMediaSsrc);
+      std::unique_ptr<ForwardErrorCorrection> decoder =
+          flexfec ? ForwardErrorCorrection::CreateFlexfec(kFlexfecSsrc,
+                                                          kMediaSsrc)
+                  : ForwardErrorCorrection::CreateUlpfec(kMediaSsrc);
+      const Stream stream =
+          CreateStream(encoder.get(), flexfec, loss_percent / 100.0);
+
+      ForwardErrorCorrection::RecoveredPacketList recovered_packets;
+      int num_recovered = 0;
+      const int64_t start_ns = rtc::TimeNanos();
+      for (const NetworkPacket& packet : stream.received_packets) {
+        ForwardErrorCorrection::ReceivedPacket received_packet;
+        received_packet.is_fec = packet.is_fec;
+        received_packet.ssrc = packet.ssrc;
+        received_packet.seq_num = packet.seq_num;
+        received_packet.pkt = new ForwardErrorCorrection::Packet();
+        received_packet.pkt->data = packet.data;
+        decoder->DecodeFec(received_packet, &recovered_packets);
+        for (const auto& recovered_packet : recovered_packets) {
+          if (!recovered_packet->returned) {
+            recovered_packet->returned = true;
+            ++num_recovered;
+          }
+        }
+      }
+      const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+
+      const std::string name = flexfec ? "flexfec" : "ulpfec";
+      const std::string trace =
+          "_" + std::to_string(loss_percent) + "pct_loss";
+      webrtc::test::PrintResult(
+          "fec_decode_time_per_packet", trace, name,
+          static_cast<double>(elapsed_ns) / stream.received_packets.size(),
+          "ns", false, webrtc::test::ImproveDirection::kSmallerIsBetter);
+      if (stream.lost_media_packets > 0) {
+        webrtc::test::PrintResult(
+            "fec_recovered_media_packets", trace, name,
+            100.0 * num_recovered / stream.lost_media_packets, "%", false,
+            webrtc::test::ImproveDirection::kBiggerIsBetter);
+      }
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,246 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtcp_packet/congestion_control_feedback.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace rtcp {
+constexpr uint8_t CongestionControlFeedback::kFeedbackMessageType;
+constexpr size_t CongestionControlFeedback::kMaxPacketsPerBlock;
+// RFC 8888, Section 3.1: RTCP Congestion Control Feedback Report.
+//
+//    0                   1                   2                   3
+//    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |V=2|P| FMT=11  |   PT = 205    |          length               |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 0 |                 SSRC of RTCP packet sender                    |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 4 |                   SSRC of 1st RTP Stream                      |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 8 |          begin_seq            |          num_reports          |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |R|ECN|  Arrival time offset    | ...                           .
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   .                                                               .
+//   .                                                               .
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |                   SSRC of nth RTP Stream                      |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |          begin_seq            |          num_reports          |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |R|ECN|  Arrival time offset    | ...                           |
+//   .                                                               .
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |                 Report Timestamp (32 bits)                    |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//
+// Each report block is padded to a multiple of 32 bits. The arrival time
+// offset is in units of 1/1024 seconds, counted backwards from the report
+// timestamp.
+namespace {
+using PacketInfo = CongestionControlFeedback::PacketInfo;
+
+constexpr size_t kSenderSsrcLength = 4;
+constexpr size_t kReportTimestampLength = 4;
+constexpr size_t kBlockHeaderLength = 8;
+constexpr size_t kMetricLength = 2;
+
+constexpr uint16_t kReceivedBit = 0x8000;
+constexpr int kEcnShift = 13;
+constexpr uint16_t kArrivalTimeOffsetMask = 0x1fff;
+// Offsets of this value and larger are sent as this value.
+constexpr uint16_t kArrivalTimeOffsetOverRange = 0x1ffe;
+constexpr uint16_t kArrivalTimeOffsetUnavailable = 0x1fff;
+constexpr int64_t kUnitsPerSecond = 1024;
+
+size_t BlockLengthForPackets(size_t num_packets) {
+  // Round up to an even number of metric blocks for 32 bit alignment.
+  return kBlockHeaderLength + kMetricLength * ((num_packets + 1) & ~1);
+}
+
+// Returns the index one past the last packet in the report block starting
+// at |begin|.
+size_t BlockEnd(const std::vector<PacketInfo>& packets, size_t begin) {
+  size_t end = begin + 1;
+  while (end < packets.size() &&
+         end - begin < CongestionControlFeedback::kMaxPacketsPerBlock &&
+         packets[end].ssrc == packets[begin].ssrc &&
+         packets[end].sequence_number ==
+             static_cast<uint16_t>(packets[end - 1].sequence_number + 1)) {
+    ++end;
+  }
+  return end;
+}
+
+size_t PayloadSizeBytes(const std::vector<PacketInfo>& packets) {
+  size_t size = kSenderSsrcLength + kReportTimestampLength;
+  for (size_t begin = 0; begin < packets.size();) {
+    size_t end = BlockEnd(packets, begin);
+    size += BlockLengthForPackets(end - begin);
+    begin = end;
+  }
+  return size;
+}
+
+uint16_t EncodeMetric(const PacketInfo& packet) {
+  if (!packet.received())
+    return 0;
+  uint16_t offset = kArrivalTimeOffsetOverRange;
+  if (packet.arrival_time_offset.IsFinite()) {
+    int64_t units =
+        (std::max<int64_t>(packet.arrival_time_offset.us(), 0) *
+             kUnitsPerSecond +
+         500000) /
+        1000000;
+    offset = static_cast<uint16_t>(
+        std::min<int64_t>(units, kArrivalTimeOffsetOverRange));
+  }
+  return kReceivedBit | (static_cast<uint16_t>(packet.ecn) << kEcnShift) |
+         offset;
+}
+
+void DecodeMetric(uint16_t metric, PacketInfo* packet) {
+  if ((metric & kReceivedBit) == 0) {
+    packet->arrival_time_offset = TimeDelta::MinusInfinity();
+    packet->ecn = rtc::EcnMarking::kNotEct;
+    return;
+  }
+  packet->ecn = static_cast<rtc::EcnMarking>((metric >> kEcnShift) & 0x03);
+  uint16_t offset = metric & kArrivalTimeOffsetMask;
+  if (offset == kArrivalTimeOffsetOverRange ||
+      offset == kArrivalTimeOffsetUnavailable) {
+    packet->arrival_time_offset = TimeDelta::PlusInfinity();
+  } else {
+    packet->arrival_time_offset = TimeDelta::Micros(
+        (offset * int64_t{1000000} + kUnitsPerSecond / 2) / kUnitsPerSecond);
+  }
+}
+}  // namespace
+
+CongestionControlFeedback::CongestionControlFeedback()
+    : size_bytes_(kHeaderLength + PayloadSizeBytes(packets_)) {}
+
+CongestionControlFeedback::CongestionControlFeedback(
+    std::vector<PacketInfo> packets,
+    uint32_t report_timestamp_compact_ntp)
+    : packets_(std::move(packets)),
+      report_timestamp_compact_ntp_(report_timestamp_compact_ntp),
+      size_bytes_(kHeaderLength + PayloadSizeBytes(packets_)) {}
+
+CongestionControlFeedback::~CongestionControlFeedback() = default;
+
+bool CongestionControlFeedback::Parse(const CommonHeader& packet) {
+  RTC_DCHECK_EQ(packet.type(), kPacketType);
+  RTC_DCHECK_EQ(packet.fmt(), kFeedbackMessageType);
+
+  const size_t payload_size = packet.payload_size_bytes();
+  if (payload_size < kSenderSsrcLength + kReportTimestampLength) {
+    RTC_LOG(LS_WARNING) << "Payload length " << payload_size
+                        << " is too small for congestion control feedback.";
+    return false;
+  }
+  const uint8_t* const payload = packet.payload();
+  SetSenderSsrc(ByteReader<uint32_t>::ReadBigEndian(payload));
+  const size_t blocks_end = payload_size - kReportTimestampLength;
+
+  packets_.clear();
+  size_t position = kSenderSsrcLength;
+  while (position < blocks_end) {
+    if (position + kBlockHeaderLength > blocks_end) {
+      RTC_LOG(LS_WARNING) << "Truncated congestion control feedback block.";
+      return false;
+    }
+    const uint32_t ssrc =
+        ByteReader<uint32_t>::ReadBigEndian(&payload[position]);
+    const uint16_t begin_seq =
+        ByteReader<uint16_t>::ReadBigEndian(&payload[position + 4]);
+    const uint16_t num_reports =
+        ByteReader<uint16_t>::ReadBigEndian(&payload[position + 6]);
+    if (num_reports > kMaxPacketsPerBlock ||
+        position + BlockLengthForPackets(num_reports) > blocks_end) {
+      RTC_LOG(LS_WARNING) << "Invalid congestion control feedback block with "
+                          << num_reports << " reports.";
+      return false;
+    }
+    const uint8_t* metric = &payload[position + kBlockHeaderLength];
+    for (uint16_t i = 0; i < num_reports; ++i) {
+      PacketInfo info;
+      info.ssrc = ssrc;
+      info.sequence_number = static_cast<uint16_t>(begin_seq + i);
+      DecodeMetric(ByteReader<uint16_t>::ReadBigEndian(metric), &info);
+      packets_.push_back(info);
+      metric += kMetricLength;
+    }
+    position += BlockLengthForPackets(num_reports);
+  }
+  report_timestamp_compact_ntp_ =
+      ByteReader<uint32_t>::ReadBigEndian(&payload[blocks_end]);
+  size_bytes_ = kHeaderLength + PayloadSizeBytes(packets_);
+  return true;
+}
+
+size_t CongestionControlFeedback::BlockLength() const {
+  return size_bytes_;
+}
+
+bool CongestionControlFeedback::Create(uint8_t* packet,
+                                       size_t* position,
+                                       size_t max_length,
+                                       PacketReadyCallback callback) const {
+  while (*position + BlockLength() > max_length) {
+    if (!OnBufferFull(packet, position, callback))
+      return false;
+  }
+  const size_t position_end = *position + BlockLength();
+
+  CreateHeader(kFeedbackMessageType, kPacketType, HeaderLength(), packet,
+               position);
+  ByteWriter<uint32_t>::WriteBigEndian(&packet[*position], sender_ssrc());
+  *position += kSenderSsrcLength;
+
+  for (size_t begin = 0; begin < packets_.size();) {
+    const size_t end = BlockEnd(packets_, begin);
+    ByteWriter<uint32_t>::WriteBigEndian(&packet[*position],
+                                         packets_[begin].ssrc);
+    ByteWriter<uint16_t>::WriteBigEndian(&packet[*position + 4],
+                                         packets_[begin].sequence_number);
+    ByteWriter<uint16_t>::WriteBigEndian(&packet[*position + 6],
+                                         static_cast<uint16_t>(end - begin));
+    *position += kBlockHeaderLength;
+    for (size_t i = begin; i < end; ++i) {
+      ByteWriter<uint16_t>::WriteBigEndian(&packet[*position],
+                                           EncodeMetric(packets_[i]));
+      *position += kMetricLength;
+    }
+    if ((end - begin) % 2 != 0) {
+      ByteWriter<uint16_t>::WriteBigEndian(&packet[*position], 0);
+      *position += kMetricLength;
+    }
+    begin = end;
+  }
+
+  ByteWriter<uint32_t>::WriteBigEndian(&packet[*position],
+                                       report_timestamp_compact_ntp_);
+  *position += kReportTimestampLength;
+  RTC_CHECK_EQ(position_end, *position);
+  return true;
+}
+
+}  // namespace rtcp
+}  // namespace webrtc
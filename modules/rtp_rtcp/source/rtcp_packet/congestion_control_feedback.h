@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_CONGESTION_CONTROL_FEEDBACK_H_
+#define MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_CONGESTION_CONTROL_FEEDBACK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/rtpfb.h"
+#include "rtc_base/network/ecn_marking.h"
+
+namespace webrtc {
+namespace rtcp {
+class CommonHeader;
+
+// Congestion control feedback (CCFB), RFC 8888. Reports arrival time and ECN
+// codepoint of RTP packets per SSRC and RTP sequence number, relative to the
+// time the report was generated.
+class CongestionControlFeedback : public Rtpfb {
+ public:
+  struct PacketInfo {
+    uint32_t ssrc = 0;
+    uint16_t sequence_number = 0;
+    // Time from the arrival of the packet until the report timestamp.
+    // Minus infinity if the packet was not received, plus infinity if it was
+    // received but the offset can't be represented.
+    TimeDelta arrival_time_offset = TimeDelta::MinusInfinity();
+    rtc::EcnMarking ecn = rtc::EcnMarking::kNotEct;
+
+    bool received() const {
+      return arrival_time_offset != TimeDelta::MinusInfinity();
+    }
+  };
+
+  static constexpr uint8_t kFeedbackMessageType = 11;
+  // A report block must not cover more than a quarter of the sequence number
+  // space.
+  static constexpr size_t kMaxPacketsPerBlock = 16384;
+
+  CongestionControlFeedback();
+  // Runs of |packets| with the same SSRC and consecutive sequence numbers are
+  // sent as one report block each. |report_timestamp_compact_ntp| is the time
+  // the report was generated.
+  CongestionControlFeedback(std::vector<PacketInfo> packets,
+                            uint32_t report_timestamp_compact_ntp);
+  ~CongestionControlFeedback() override;
+
+  const std::vector<PacketInfo>& packets() const { return packets_; }
+  uint32_t report_timestamp_compact_ntp() const {
+    return report_timestamp_compact_ntp_;
+  }
+
+  bool Parse(const CommonHeader& packet);
+
+  size_t BlockLength() const override;
+
+  bool Create(uint8_t* packet,
+              size_t* position,
+              size_t max_length,
+              PacketReadyCallback callback) const override;
+
+ private:
+  std::vector<PacketInfo> packets_;
+  uint32_t report_timestamp_compact_ntp_ = 0;
+  size_t size_bytes_;
+};
+
+}  // namespace rtcp
+}  // namespace webrtc
+#endif  // MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_CONGESTION_CONTROL_FEEDBACK_H_
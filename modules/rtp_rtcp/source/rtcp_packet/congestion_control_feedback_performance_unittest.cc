@@ -0,0 +1,161 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "modules/rtp_rtcp/source/rtcp_packet/congestion_control_feedback.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+#include "rtc_base/strings/string_builder.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+// Ten seconds of a 2.5 Mbps call with 1200 byte packets, split evenly over
+// the SSRCs, with every 50th packet lost.
+constexpr int kPacketsPerSecond = 260;
+constexpr int kDurationMs = 10000;
+constexpr int kLossInterval = 50;
+constexpr uint32_t kSenderSsrc = 0x10000;
+constexpr uint32_t kFirstMediaSsrc = 0x20000;
+
+struct ReceivedPacket {
+  uint32_t ssrc;
+  uint16_t sequence_number;
+  uint16_t transport_sequence_number;
+  int64_t arrival_time_us;
+  bool lost;
+};
+
+std::vector<ReceivedPacket> CreatePackets(int num_ssrcs) {
+  std::vector<ReceivedPacket> packets;
+  std::vector<uint16_t> sequence_numbers(num_ssrcs, 0);
+  const int num_packets = kPacketsPerSecond * kDurationMs / 1000;
+  for (int i = 0; i < num_packets; ++i) {
+    ReceivedPacket packet;
+    packet.ssrc = kFirstMediaSsrc + i % num_ssrcs;
+    packet.sequence_number = sequence_numbers[i % num_ssrcs]++;
+    packet.transport_sequence_number = static_cast<uint16_t>(i);
+    // Spread arrivals with a little jitter, so deltas aren't all equal.
+    packet.arrival_time_us =
+        int64_t{i} * 1000000 / kPacketsPerSecond + (i % 7) * 250;
+    packet.lost = i % kLossInterval == kLossInterval - 1;
+    packets.push_back(packet);
+  }
+  return packets;
+}
+
+// Total RTCP bytes of transport-wide feedback sent every |interval_ms|.
+size_t TransportFeedbackBytes(const std::vector<ReceivedPacket>& packets,
+                              int interval_ms) {
+  size_t bytes = 0;
+  size_t begin = 0;
+  uint8_t feedback_sequence = 0;
+  for (int64_t report_time_us = int64_t{interval_ms} * 1000;
+       begin < packets.size(); report_time_us += interval_ms * 1000) {
+    rtcp::TransportFeedback feedback;
+    feedback.SetSenderSsrc(kSenderSsrc);
+    feedback.SetMediaSsrc(kFirstMediaSsrc);
+    feedback.SetFeedbackSequenceNumber(feedback_sequence++);
+    bool has_base = false;
+    for (; begin < packets.size() &&
+           packets[begin].arrival_time_us < report_time_us;
+         ++begin) {
+      const ReceivedPacket& packet = packets[begin];
+      if (packet.lost)
+        continue;
+      if (!has_base) {
+        feedback.SetBase(packet.transport_sequence_number,
+                         packet.arrival_time_us);
+        has_base = true;
+      }
+      EXPECT_TRUE(feedback.AddReceivedPacket(packet.transport_sequence_number,
+                                             packet.arrival_time_us));
+    }
+    if (has_base)
+      bytes += feedback.BlockLength();
+  }
+  return bytes;
+}
+
+// Total RTCP bytes of RFC 8888 feedback sent every |interval_ms|.
+size_t CongestionControlFeedbackBytes(
+    const std::vector<ReceivedPacket>& packets,
+    int num_ssrcs,
+    int interval_ms) {
+  size_t bytes = 0;
+  size_t begin = 0;
+  for (int64_t report_time_us = int64_t{interval_ms} * 1000;
+       begin < packets.size(); report_time_us += interval_ms * 1000) {
+    // Reports are grouped by SSRC, like CongestionControlFeedbackGenerator
+    // builds them.
+    std::vector<rtcp::CongestionControlFeedback::PacketInfo> reports;
+    size_t end = begin;
+    while (end < packets.size() &&
+           packets[end].arrival_time_us < report_time_us) {
+      ++end;
+    }
+    for (int s = 0; s < num_ssrcs; ++s) {
+      for (size_t i = begin; i < end; ++i) {
+        const ReceivedPacket& packet = packets[i];
+        if (packet.ssrc != kFirstMediaSsrc + s)
+          continue;
+        rtcp::CongestionControlFeedback::PacketInfo info;
+        info.ssrc = packet.ssrc;
+        info.sequence_number = packet.sequence_number;
+        if (!packet.lost) {
+          info.arrival_time_offset =
+              TimeDelta::Micros(report_time_us - packet.arrival_time_us);
+        }
+        reports.push_back(info);
+      }
+    }
+    begin = end;
+    if (reports.empty())
+      continue;
+    rtcp::CongestionControlFeedback feedback(std::move(reports), 0);
+    feedback.SetSenderSsrc(kSenderSsrc);
+    bytes += feedback.BlockLength();
+  }
+  return bytes;
+}
+
+}  // namespace
+
+// RTCP bytes per second spent on congestion control feedback, for the same
+// packets reported at the same intervals.
+TEST(CongestionControlFeedbackPerformanceTest, FeedbackOverhead) {
+  for (int num_ssrcs : {1, 3}) {
+    const std::vector<ReceivedPacket> packets = CreatePackets(num_ssrcs);
+    for (int interval_ms : {50, 100, 250}) {
+      rtc::StringBuilder story;
+      story << num_ssrcs << "_ssrc_" << interval_ms << "ms";
+      const double twcc_bytes_per_second =
+          TransportFeedbackBytes(packets, interval_ms) * 1000.0 / kDurationMs;
+      const double ccfb_bytes_per_second =
+          CongestionControlFeedbackBytes(packets, num_ssrcs, interval_ms) *
+          1000.0 / kDurationMs;
+      webrtc::test::PrintResult(
+          "feedback_overhead_", story.str(), "transport_feedback",
+          twcc_bytes_per_second, "bytesPerSecond", false,
+          webrtc::test::ImproveDirection::kSmallerIsBetter);
+      webrtc::test::PrintResult(
+          "feedback_overhead_", story.str(), "congestion_control_feedback",
+          ccfb_bytes_per_second, "bytesPerSecond", false,
+          webrtc::test::ImproveDirection::kSmallerIsBetter);
+      EXPECT_GT(ccfb_bytes_per_second, 0);
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,143 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtcp_packet/congestion_control_feedback.h"
+
+#include <vector>
+
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/rtcp_packet_parser.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAreArray;
+using ::testing::make_tuple;
+using ::webrtc::rtcp::CongestionControlFeedback;
+
+constexpr uint32_t kSenderSsrc = 0x12345678;
+constexpr uint32_t kMediaSsrc = 0xabcdef01;
+constexpr uint32_t kOtherMediaSsrc = 0x23456789;
+constexpr uint32_t kReportTimestamp = 0x11223344;
+
+CongestionControlFeedback::PacketInfo Received(uint32_t ssrc,
+                                               uint16_t sequence_number,
+                                               TimeDelta offset,
+                                               rtc::EcnMarking ecn) {
+  CongestionControlFeedback::PacketInfo info;
+  info.ssrc = ssrc;
+  info.sequence_number = sequence_number;
+  info.arrival_time_offset = offset;
+  info.ecn = ecn;
+  return info;
+}
+
+CongestionControlFeedback::PacketInfo Lost(uint32_t ssrc,
+                                           uint16_t sequence_number) {
+  CongestionControlFeedback::PacketInfo info;
+  info.ssrc = ssrc;
+  info.sequence_number = sequence_number;
+  return info;
+}
+
+TEST(RtcpPacketCongestionControlFeedbackTest,
+     CreateProducesExpectedWireFormat) {
+  // 1/1024 s is 976.5625 us.
+  std::vector<CongestionControlFeedback::PacketInfo> packets = {
+      Received(kMediaSsrc, 0xfffe, TimeDelta::Micros(976 * 2),
+               rtc::EcnMarking::kEct1),
+      Lost(kMediaSsrc, 0xffff),
+      Received(kMediaSsrc, 0x0000, TimeDelta::Seconds(10),
+               rtc::EcnMarking::kCe)};
+  CongestionControlFeedback feedback(packets, kReportTimestamp);
+  feedback.SetSenderSsrc(kSenderSsrc);
+
+  const uint8_t kPacket[] = {0x8b, 205,  0x00, 0x06,  //
+                             0x12, 0x34, 0x56, 0x78,  //
+                             0xab, 0xcd, 0xef, 0x01,  //
+                             0xff, 0xfe, 0x00, 0x03,  //
+                             0xa0, 0x02, 0x00, 0x00,  //
+                             0xff, 0xfe, 0x00, 0x00,  //
+                             0x11, 0x22, 0x33, 0x44};
+
+  rtc::Buffer packet = feedback.Build();
+  EXPECT_EQ(feedback.BlockLength(), sizeof(kPacket));
+  EXPECT_THAT(make_tuple(packet.data(), packet.size()),
+              ElementsAreArray(kPacket));
+}
+
+TEST(RtcpPacketCongestionControlFeedbackTest, ParseCreatedPacket) {
+  std::vector<CongestionControlFeedback::PacketInfo> packets = {
+      Received(kMediaSsrc, 17, TimeDelta::Millis(100),
+               rtc::EcnMarking::kNotEct),
+      Lost(kMediaSsrc, 18),
+      Received(kMediaSsrc, 19, TimeDelta::Millis(30), rtc::EcnMarking::kEct0),
+      Received(kOtherMediaSsrc, 500, TimeDelta::Zero(),
+               rtc::EcnMarking::kEct1)};
+  CongestionControlFeedback feedback(packets, kReportTimestamp);
+  feedback.SetSenderSsrc(kSenderSsrc);
+  rtc::Buffer packet = feedback.Build();
+
+  CongestionControlFeedback parsed;
+  ASSERT_TRUE(test::ParseSinglePacket(packet, &parsed));
+  EXPECT_EQ(parsed.sender_ssrc(), kSenderSsrc);
+  EXPECT_EQ(parsed.report_timestamp_compact_ntp(), kReportTimestamp);
+  EXPECT_EQ(parsed.BlockLength(), packet.size());
+  ASSERT_EQ(parsed.packets().size(), packets.size());
+  for (size_t i = 0; i < packets.size(); ++i) {
+    const CongestionControlFeedback::PacketInfo& info = parsed.packets()[i];
+    EXPECT_EQ(info.ssrc, packets[i].ssrc);
+    EXPECT_EQ(info.sequence_number, packets[i].sequence_number);
+    EXPECT_EQ(info.received(), packets[i].received());
+    EXPECT_EQ(info.ecn, packets[i].ecn);
+    if (info.received()) {
+      // Offsets are rounded to 1/1024 s.
+      EXPECT_NEAR(info.arrival_time_offset.us(),
+                  packets[i].arrival_time_offset.us(), 500);
+    }
+  }
+}
+
+TEST(RtcpPacketCongestionControlFeedbackTest, SplitsBlocksOnSequenceGaps) {
+  std::vector<CongestionControlFeedback::PacketInfo> packets = {
+      Received(kMediaSsrc, 1, TimeDelta::Zero(), rtc::EcnMarking::kNotEct),
+      Received(kMediaSsrc, 2, TimeDelta::Zero(), rtc::EcnMarking::kNotEct),
+      Received(kMediaSsrc, 10, TimeDelta::Zero(), rtc::EcnMarking::kNotEct)};
+  CongestionControlFeedback feedback(packets, kReportTimestamp);
+  // Header, sender SSRC, two blocks of 8 + 4 bytes and the timestamp.
+  EXPECT_EQ(feedback.BlockLength(), 4u + 4u + 2 * 12u + 4u);
+}
+
+TEST(RtcpPacketCongestionControlFeedbackTest, ParseEmptyReport) {
+  CongestionControlFeedback feedback({}, kReportTimestamp);
+  feedback.SetSenderSsrc(kSenderSsrc);
+  rtc::Buffer packet = feedback.Build();
+
+  CongestionControlFeedback parsed;
+  ASSERT_TRUE(test::ParseSinglePacket(packet, &parsed));
+  EXPECT_TRUE(parsed.packets().empty());
+  EXPECT_EQ(parsed.report_timestamp_compact_ntp(), kReportTimestamp);
+}
+
+TEST(RtcpPacketCongestionControlFeedbackTest, ParseFailsOnTruncatedBlock) {
+  // Block claims three reports, but only has room for two.
+  uint8_t kPacket[] = {0x8b, 205,  0x00, 0x05,  //
+                       0x12, 0x34, 0x56, 0x78,  //
+                       0xab, 0xcd, 0xef, 0x01,  //
+                       0x00, 0x01, 0x00, 0x03,  //
+                       0x80, 0x00, 0x80, 0x00,  //
+                       0x11, 0x22, 0x33, 0x44};
+  CongestionControlFeedback parsed;
+  EXPECT_FALSE(test::ParseSinglePacket(kPacket, sizeof(kPacket), &parsed));
+}
+
+}  // namespace
+}  // namespace webrtc
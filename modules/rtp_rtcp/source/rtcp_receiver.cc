@@ -23,6 +23,7 @@
 #include "modules/rtp_rtcp/source/rtcp_packet/bye.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/compound_packet.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/congestion_control_feedback.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/extended_reports.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/fir.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/loss_notification.h"
@@ -93,6 +94,7 @@ struct RTCPReceiver::PacketInformation {
   int64_t rtt_ms = 0;
   uint32_t receiver_estimated_max_bitrate_bps = 0;
   std::unique_ptr<rtcp::TransportFeedback> transport_feedback;
+  std::unique_ptr<rtcp::CongestionControlFeedback> congestion_control_feedback;
   absl::optional<VideoBitrateAllocation> target_bitrate_allocation;
   absl::optional<NetworkStateEstimate> network_state_estimate;
   std::unique_ptr<rtcp::LossNotification> loss_notification;
@@ -384,6 +386,9 @@ bool RTCPReceiver::ParseCompoundPacket(rtc::ArrayView<const uint8_t> packet,
           case rtcp::TransportFeedback::kFeedbackMessageType:
             HandleTransportFeedback(rtcp_block, packet_information);
             break;
+          case rtcp::CongestionControlFeedback::kFeedbackMessageType:
+            HandleCongestionControlFeedback(rtcp_block, packet_information);
+            break;
           default:
             ++num_skipped_packets_;
             break;
@@ -973,6 +978,21 @@ void RTCPReceiver::HandleTransportFeedback(
   packet_information->transport_feedback = std::move(transport_feedback);
 }
 
+void RTCPReceiver::HandleCongestionControlFeedback(
+    const CommonHeader& rtcp_block,
+    PacketInformation* packet_information) {
+  auto congestion_control_feedback =
+      std::make_unique<rtcp::CongestionControlFeedback>();
+  if (!congestion_control_feedback->Parse(rtcp_block)) {
+    ++num_skipped_packets_;
+    return;
+  }
+
+  packet_information->packet_type_flags |= kRtcpCongestionControlFeedback;
+  packet_information->congestion_control_feedback =
+      std::move(congestion_control_feedback);
+}
+
 void RTCPReceiver::NotifyTmmbrUpdated() {
   // Find bounding set.
   std::vector<rtcp::TmmbItem> bounding =
@@ -1079,6 +1099,22 @@ void RTCPReceiver::TriggerCallbacksFromRtcpPacket(
     }
   }
 
+  if (transport_feedback_observer_ &&
+      (packet_information.packet_type_flags &
+       kRtcpCongestionControlFeedback)) {
+    // The feedback covers all SSRCs sharing the transport. Like transport-wide
+    // feedback, it is only forwarded by the module sending the SSRC of the
+    // first report block, so that it's handled once.
+    const auto& packets =
+        packet_information.congestion_control_feedback->packets();
+    if (!packets.empty() &&
+        (packets[0].ssrc == local_ssrc ||
+         registered_ssrcs.find(packets[0].ssrc) != registered_ssrcs.end())) {
+      transport_feedback_observer_->OnCongestionControlFeedback(
+          *packet_information.congestion_control_feedback);
+    }
+  }
+
   if (transport_feedback_observer_ &&
       (packet_information.packet_type_flags & kRtcpApp)) {
       transport_feedback_observer_->OnApplicationPacket(
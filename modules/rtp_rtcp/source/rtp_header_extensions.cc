@@ -58,6 +58,38 @@ bool AbsoluteSendTime::Write(rtc::ArrayView<uint8_t> data,
   return true;
 }
 
+// Transport send time in RTP streams.
+//
+// The payload is the sender's time in microseconds when the packet was
+// handed to the transport, as a 64-bit signed integer.
+//
+//    0                   1                   2                   3
+//    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |  ID   | len=7 |           send time in microseconds           |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |                  send time in microseconds (cont.)            |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |               |
+//   +-+-+-+-+-+-+-+-+
+constexpr RTPExtensionType TransportSendTime::kId;
+constexpr uint8_t TransportSendTime::kValueSizeBytes;
+constexpr const char TransportSendTime::kUri[];
+
+bool TransportSendTime::Parse(rtc::ArrayView<const uint8_t> data,
+                              int64_t* time_us) {
+  if (data.size() != kValueSizeBytes)
+    return false;
+  *time_us = ByteReader<int64_t>::ReadBigEndian(data.data());
+  return true;
+}
+
+bool TransportSendTime::Write(rtc::ArrayView<uint8_t> data, int64_t time_us) {
+  RTC_DCHECK_EQ(data.size(), kValueSizeBytes);
+  ByteWriter<int64_t>::WriteBigEndian(data.data(), time_us);
+  return true;
+}
+
 // Absolute Capture Time
 //
 // The Absolute Capture Time extension is used to stamp RTP packets with a NTP
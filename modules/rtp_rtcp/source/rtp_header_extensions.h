@@ -43,6 +43,22 @@ class AbsoluteSendTime {
   }
 };
 
+// Send time of the packet in microseconds on the sender's clock, written
+// when the packet is handed to the transport. Unlike AbsoluteSendTime it
+// neither wraps nor is limited to the millisecond clock of the sender.
+class TransportSendTime {
+ public:
+  using value_type = int64_t;
+  static constexpr RTPExtensionType kId = kRtpExtensionTransportSendTime;
+  static constexpr uint8_t kValueSizeBytes = 8;
+  static constexpr const char kUri[] =
+      "http://www.webrtc.org/experiments/rtp-hdrext/transport-send-time";
+
+  static bool Parse(rtc::ArrayView<const uint8_t> data, int64_t* time_us);
+  static size_t ValueSize(int64_t time_us) { return kValueSizeBytes; }
+  static bool Write(rtc::ArrayView<uint8_t> data, int64_t time_us);
+};
+
 class AbsoluteCaptureTimeExtension {
  public:
   using value_type = AbsoluteCaptureTime;
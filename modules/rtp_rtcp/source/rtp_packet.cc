@@ -180,7 +180,8 @@ void RtpPacket::ZeroMutableExtensions() {
       case RTPExtensionType::kRtpExtensionTransportSequenceNumber:
       case RTPExtensionType::kRtpExtensionTransportSequenceNumber02:
       case RTPExtensionType::kRtpExtensionTransmissionTimeOffset:
-      case RTPExtensionType::kRtpExtensionAbsoluteSendTime: {
+      case RTPExtensionType::kRtpExtensionAbsoluteSendTime:
+      case RTPExtensionType::kRtpExtensionTransportSendTime: {
         // Nullify whole extension, as it's filled in the pacer.
         memset(WriteAt(extension.offset), 0, extension.length);
         break;
@@ -54,6 +54,7 @@ void RtpPacketReceived::GetHeader(RTPHeader* header) const {
       GetExtension<AbsoluteSendTime>(&header->extension.absoluteSendTime);
   header->extension.absolute_capture_time =
       GetExtension<AbsoluteCaptureTimeExtension>();
+  header->extension.transport_send_time_us = GetExtension<TransportSendTime>();
   header->extension.hasTransportSequenceNumber =
       GetExtension<TransportSequenceNumberV2>(
           &header->extension.transportSequenceNumber,
@@ -17,6 +17,7 @@
 #include "api/array_view.h"
 #include "api/rtp_headers.h"
 #include "modules/rtp_rtcp/source/rtp_packet.h"
+#include "rtc_base/network/ecn_marking.h"
 #include "system_wrappers/include/ntp_time.h"
 
 namespace webrtc {
@@ -50,6 +51,10 @@ class RtpPacketReceived : public RtpPacket {
   bool recovered() const { return recovered_; }
   void set_recovered(bool value) { recovered_ = value; }
 
+  // ECN codepoint of the IP packet carrying this RTP packet.
+  rtc::EcnMarking ecn() const { return ecn_; }
+  void set_ecn(rtc::EcnMarking ecn) { ecn_ = ecn; }
+
   int payload_type_frequency() const { return payload_type_frequency_; }
   void set_payload_type_frequency(int value) {
     payload_type_frequency_ = value;
@@ -69,6 +74,7 @@ class RtpPacketReceived : public RtpPacket {
   int64_t arrival_time_ms_ = 0;
   int payload_type_frequency_ = 0;
   bool recovered_ = false;
+  rtc::EcnMarking ecn_ = rtc::EcnMarking::kNotEct;
   std::vector<uint8_t> application_data_;
 };
 
@@ -936,6 +936,30 @@ TEST(RtpPacketTest, CreateAndParseTransportSequenceNumber) {
   EXPECT_EQ(received_transport_sequeunce_number, kTransportSequenceNumber);
 }
 
+TEST(RtpPacketTest, CreateAndParseTransportSendTime) {
+  RtpPacketToSend::ExtensionManager extensions;
+  constexpr int kExtensionId = 1;
+  extensions.Register<TransportSendTime>(kExtensionId);
+  RtpPacketToSend send_packet(&extensions);
+  send_packet.SetPayloadType(kPayloadType);
+  send_packet.SetSequenceNumber(kSeqNum);
+  send_packet.SetTimestamp(kTimestamp);
+  send_packet.SetSsrc(kSsrc);
+
+  constexpr int64_t kTransportSendTimeUs = 0x123456789abcdef;
+  send_packet.SetExtension<TransportSendTime>(kTransportSendTimeUs);
+
+  // Serialize the packet and then parse it again.
+  RtpPacketReceived receive_packet(&extensions);
+  EXPECT_TRUE(receive_packet.Parse(send_packet.Buffer()));
+  EXPECT_EQ(receive_packet.GetExtension<TransportSendTime>(),
+            kTransportSendTimeUs);
+
+  RTPHeader header;
+  receive_packet.GetHeader(&header);
+  EXPECT_EQ(header.extension.transport_send_time_us, kTransportSendTimeUs);
+}
+
 TEST(RtpPacketTest, CreateAndParseTransportSequenceNumberV2) {
   // Create a packet with transport sequence number V2 extension populated.
   // No feedback request means that the extension will be two bytes unless it's
@@ -60,6 +60,7 @@ constexpr RtpExtensionSize CreateMaxExtensionSize() {
 // Size info for header extensions that might be used in padding or FEC packets.
 constexpr RtpExtensionSize kFecOrPaddingExtensionSizes[] = {
     CreateExtensionSize<AbsoluteSendTime>(),
+    CreateExtensionSize<TransportSendTime>(),
     CreateExtensionSize<TransmissionOffset>(),
     CreateExtensionSize<TransportSequenceNumber>(),
     CreateExtensionSize<PlayoutDelayLimits>(),
@@ -70,6 +71,7 @@ constexpr RtpExtensionSize kFecOrPaddingExtensionSizes[] = {
 // Size info for header extensions that might be used in video packets.
 constexpr RtpExtensionSize kVideoExtensionSizes[] = {
     CreateExtensionSize<AbsoluteSendTime>(),
+    CreateExtensionSize<TransportSendTime>(),
     CreateExtensionSize<AbsoluteCaptureTimeExtension>(),
     CreateExtensionSize<TransmissionOffset>(),
     CreateExtensionSize<TransportSequenceNumber>(),
@@ -87,6 +89,7 @@ constexpr RtpExtensionSize kVideoExtensionSizes[] = {
 // Size info for header extensions that might be used in audio packets.
 constexpr RtpExtensionSize kAudioExtensionSizes[] = {
     CreateExtensionSize<AbsoluteSendTime>(),
+    CreateExtensionSize<TransportSendTime>(),
     CreateExtensionSize<AbsoluteCaptureTimeExtension>(),
     CreateExtensionSize<AudioLevel>(),
     CreateExtensionSize<InbandComfortNoiseExtension>(),
@@ -106,6 +109,7 @@ bool IsNonVolatile(RTPExtensionType type) {
     case kRtpExtensionTransmissionTimeOffset:
     case kRtpExtensionAudioLevel:
     case kRtpExtensionAbsoluteSendTime:
+    case kRtpExtensionTransportSendTime:
     case kRtpExtensionTransportSequenceNumber:
     case kRtpExtensionTransportSequenceNumber02:
     case kRtpExtensionFrameMarking:
@@ -503,6 +507,9 @@ std::vector<std::unique_ptr<RtpPacketToSend>> RTPSender::GeneratePadding(
     if (rtp_header_extension_map_.IsRegistered(AbsoluteSendTime::kId)) {
       padding_packet->ReserveExtension<AbsoluteSendTime>();
     }
+    if (rtp_header_extension_map_.IsRegistered(TransportSendTime::kId)) {
+      padding_packet->ReserveExtension<TransportSendTime>();
+    }
 
     padding_packet->SetPadding(padding_bytes_in_packet);
     bytes_left -= std::min(bytes_left, padding_bytes_in_packet);
@@ -578,6 +585,7 @@ std::unique_ptr<RtpPacketToSend> RTPSender::AllocatePacket() const {
   packet->SetCsrcs(csrcs_);
   // Reserve extensions, if registered, RtpSender set in SendToNetwork.
   packet->ReserveExtension<AbsoluteSendTime>();
+  packet->ReserveExtension<TransportSendTime>();
   packet->ReserveExtension<TransmissionOffset>();
   packet->ReserveExtension<TransportSequenceNumber>();
 
@@ -49,6 +49,7 @@ void RtpSenderEgress::NonPacedPacketSender::EnqueuePackets(
     }
     packet->ReserveExtension<TransmissionOffset>();
     packet->ReserveExtension<AbsoluteSendTime>();
+    packet->ReserveExtension<TransportSendTime>();
     sender_->SendPacket(packet.get(), PacedPacketInfo());
   }
 }
@@ -183,6 +184,11 @@ void RtpSenderEgress::SendPacket(RtpPacketToSend* packet,
                        packet_ssrc);
   }
 
+  // Sampled last, as close to the socket send as the packet allows.
+  if (packet->HasExtension<TransportSendTime>()) {
+    packet->SetExtension<TransportSendTime>(clock_->TimeInMicroseconds());
+  }
+
   const bool send_success = SendPacketToNetwork(*packet, options, pacing_info);
 
   // Put packet in retransmission history or update pending status even if
@@ -309,6 +315,7 @@ void RtpSenderEgress::AddPacketToTransportFeedback(
 
     RtpPacketSendInfo packet_info;
     packet_info.ssrc = ssrc_;
+    packet_info.rtp_ssrc = packet.Ssrc();
     packet_info.transport_sequence_number = packet_id;
     packet_info.rtp_sequence_number = packet.SequenceNumber();
     packet_info.length = packet_size;
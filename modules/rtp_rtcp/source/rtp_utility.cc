@@ -224,6 +224,7 @@ bool RtpHeaderParser::Parse(RTPHeader* header,
   // May not be present in packet.
   header->extension.hasAbsoluteSendTime = false;
   header->extension.absoluteSendTime = 0;
+  header->extension.transport_send_time_us = absl::nullopt;
 
   // May not be present in packet.
   header->extension.hasAudioLevel = false;
@@ -401,6 +402,16 @@ void RtpHeaderParser::ParseOneByteExtensionHeader(
           header->extension.hasAbsoluteSendTime = true;
           break;
         }
+        case kRtpExtensionTransportSendTime: {
+          int64_t send_time_us;
+          if (!TransportSendTime::Parse(rtc::MakeArrayView(ptr, len + 1),
+                                        &send_time_us)) {
+            RTC_LOG(LS_WARNING) << "Incorrect transport send time len: " << len;
+            return;
+          }
+          header->extension.transport_send_time_us = send_time_us;
+          break;
+        }
         case kRtpExtensionAbsoluteCaptureTime: {
           AbsoluteCaptureTime extension;
           if (!AbsoluteCaptureTimeExtension::Parse(
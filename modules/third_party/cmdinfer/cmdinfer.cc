@@ -9,16 +9,19 @@ const char * RequestBandwidthCommand = "RequestBandwidth";
 
 void cmdinfer::ReportStates(
     std::uint64_t sendTimeMs,
+    std::int64_t sendTimeUs,
     std::uint64_t receiveTimeMs,
     std::size_t payloadSize,
     std::uint8_t payloadType,
     std::uint16_t sequenceNumber,
     std::uint32_t ssrc,
     std::size_t paddingLength,
-    std::size_t headerLength) {
+    std::size_t headerLength,
+    std::size_t ecnCeCount) {
 
     nlohmann::json j;
     j["send_time_ms"] = sendTimeMs;
+    j["send_time_us"] = sendTimeUs;
     j["arrival_time_ms"] = receiveTimeMs;
     j["payload_type"] = payloadType;
     j["sequence_number"] = sequenceNumber;
@@ -26,6 +29,7 @@ void cmdinfer::ReportStates(
     j["padding_length"] = paddingLength;
     j["header_length"] = headerLength;
     j["payload_size"] = payloadSize;
+    j["ecn_ce_count"] = ecnCeCount;
 
     std::cout << j.dump() << std::endl;
 }
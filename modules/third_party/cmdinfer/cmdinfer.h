@@ -7,13 +7,15 @@
 namespace cmdinfer {
     void ReportStates(
         std::uint64_t sendTimeMs,
+        std::int64_t sendTimeUs,
         std::uint64_t receiveTimeMs,
         std::size_t payloadSize,
         std::uint8_t payloadType,
         std::uint16_t sequenceNumber,
         std::uint32_t ssrc,
         std::size_t paddingLength,
-        std::size_t headerLength);
+        std::size_t headerLength,
+        std::size_t ecnCeCount);
 
     float GetEstimatedBandwidth();
 }
@@ -13,7 +13,11 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <atomic>
+
+#include "api/video/frame_processing_pool.h"
 #include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
 #include "api/video/video_frame_buffer.h"
 #include "common_video/libyuv/include/webrtc_libyuv.h"
 #include "modules/video_capture/video_capture_config.h"
@@ -133,8 +137,6 @@ int32_t VideoCaptureImpl::IncomingFrame(uint8_t* videoFrame,
     return -1;
   }
 
-  int stride_y = width;
-  int stride_uv = (width + 1) / 2;
   int target_width = width;
   int target_height = abs(height);
 
@@ -150,6 +152,51 @@ int32_t VideoCaptureImpl::IncomingFrame(uint8_t* videoFrame,
     }
   }
 
+  rtc::scoped_refptr<VideoFrameBuffer> frame_buffer;
+  if (frameInfo.videoType == VideoType::kNV12 && height > 0 &&
+      (!apply_rotation || _rotateFrame == kVideoRotation_0)) {
+    // Keep NV12 frames that need no rotation or flip in NV12. Sinks that can
+    // take NV12, e.g. some encoders, then avoid a conversion, and others
+    // convert when they call ToI420().
+    frame_buffer =
+        NV12Buffer::Copy(width, height, videoFrame, width,
+                         videoFrame + width * height, (width + 1) / 2 * 2);
+  } else {
+    rtc::scoped_refptr<I420Buffer> buffer =
+        ConvertToI420Buffer(videoFrame, videoFrameLength, frameInfo,
+                            target_width, target_height, apply_rotation);
+    if (!buffer) {
+      return -1;
+    }
+    frame_buffer = buffer;
+  }
+
+  VideoFrame captureFrame =
+      VideoFrame::Builder()
+          .set_video_frame_buffer(frame_buffer)
+          .set_timestamp_rtp(0)
+          .set_timestamp_ms(rtc::TimeMillis())
+          .set_rotation(!apply_rotation ? _rotateFrame : kVideoRotation_0)
+          .build();
+  captureFrame.set_ntp_time_ms(captureTime);
+
+  DeliverCapturedFrame(captureFrame);
+
+  return 0;
+}
+
+rtc::scoped_refptr<I420Buffer> VideoCaptureImpl::ConvertToI420Buffer(
+    uint8_t* videoFrame,
+    size_t videoFrameLength,
+    const VideoCaptureCapability& frameInfo,
+    int target_width,
+    int target_height,
+    bool apply_rotation) {
+  const int32_t width = frameInfo.width;
+  const int32_t height = frameInfo.height;
+  int stride_y = width;
+  int stride_uv = (width + 1) / 2;
+
   // Setting absolute height (in case it was negative).
   // In Windows, the image starts bottom left, instead of top left.
   // Setting a negative source height, inverts the image (within LibYuv).
@@ -176,31 +223,44 @@ int32_t VideoCaptureImpl::IncomingFrame(uint8_t* videoFrame,
     }
   }
 
-  const int conversionResult = libyuv::ConvertToI420(
-      videoFrame, videoFrameLength, buffer.get()->MutableDataY(),
-      buffer.get()->StrideY(), buffer.get()->MutableDataU(),
-      buffer.get()->StrideU(), buffer.get()->MutableDataV(),
-      buffer.get()->StrideV(), 0, 0,  // No Cropping
-      width, height, target_width, target_height, rotation_mode,
-      ConvertVideoType(frameInfo.videoType));
-  if (conversionResult < 0) {
+  std::atomic<int> conversionResult(0);
+  if (rotation_mode == libyuv::kRotate0 && height > 0 &&
+      frameInfo.videoType != VideoType::kMJPEG) {
+    // Uncompressed frames are converted in bands of rows in parallel if they
+    // are large, using the crop rectangle to select the rows of each band.
+    // MJPEG frames are decoded as a whole, and the rotated or flipped
+    // conversions do not map source rows to the same destination rows.
+    FrameProcessingPool::Default()->ProcessRows(
+        width * height, height, /*row_alignment=*/2,
+        [&](int row, int num_rows) {
+          const int result = libyuv::ConvertToI420(
+              videoFrame, videoFrameLength,
+              buffer->MutableDataY() + buffer->StrideY() * row,
+              buffer->StrideY(),
+              buffer->MutableDataU() + buffer->StrideU() * (row / 2),
+              buffer->StrideU(),
+              buffer->MutableDataV() + buffer->StrideV() * (row / 2),
+              buffer->StrideV(), 0, row, width, height, target_width,
+              num_rows, rotation_mode, ConvertVideoType(frameInfo.videoType));
+          if (result < 0) {
+            conversionResult.store(result);
+          }
+        });
+  } else {
+    conversionResult.store(libyuv::ConvertToI420(
+        videoFrame, videoFrameLength, buffer.get()->MutableDataY(),
+        buffer.get()->StrideY(), buffer.get()->MutableDataU(),
+        buffer.get()->StrideU(), buffer.get()->MutableDataV(),
+        buffer.get()->StrideV(), 0, 0,  // No Cropping
+        width, height, target_width, target_height, rotation_mode,
+        ConvertVideoType(frameInfo.videoType)));
+  }
+  if (conversionResult.load() < 0) {
     RTC_LOG(LS_ERROR) << "Failed to convert capture frame from type "
                       << static_cast<int>(frameInfo.videoType) << "to I420.";
-    return -1;
+    return nullptr;
   }
-
-  VideoFrame captureFrame =
-      VideoFrame::Builder()
-          .set_video_frame_buffer(buffer)
-          .set_timestamp_rtp(0)
-          .set_timestamp_ms(rtc::TimeMillis())
-          .set_rotation(!apply_rotation ? _rotateFrame : kVideoRotation_0)
-          .build();
-  captureFrame.set_ntp_time_ms(captureTime);
-
-  DeliverCapturedFrame(captureFrame);
-
-  return 0;
+  return buffer;
 }
 
 int32_t VideoCaptureImpl::StartCapture(
@@ -19,6 +19,7 @@
 #include <stdint.h>
 
 #include "api/scoped_refptr.h"
+#include "api/video/i420_buffer.h"
 #include "api/video/video_frame.h"
 #include "api/video/video_rotation.h"
 #include "api/video/video_sink_interface.h"
@@ -86,6 +87,15 @@ class VideoCaptureImpl : public VideoCaptureModule {
   void UpdateFrameCount();
   uint32_t CalculateFrameRate(int64_t now_ns);
   int32_t DeliverCapturedFrame(VideoFrame& captureFrame);
+  // Converts a raw or MJPEG frame to a new I420 buffer, rotated if
+  // |apply_rotation| is set. Returns null if the conversion fails.
+  rtc::scoped_refptr<I420Buffer> ConvertToI420Buffer(
+      uint8_t* videoFrame,
+      size_t videoFrameLength,
+      const VideoCaptureCapability& frameInfo,
+      int target_width,
+      int target_height,
+      bool apply_rotation);
 
   // last time the module process function was called.
   int64_t _lastProcessTimeNanos;
@@ -20,6 +20,7 @@
 #include "api/video/encoded_image.h"
 #include "api/video/i420_buffer.h"
 #include "api/video/video_frame.h"
+#include "api/video/video_frame_buffer.h"
 #include "api/video_codecs/video_codec.h"
 #include "api/video_codecs/video_encoder.h"
 #include "modules/video_coding/include/video_codec_interface.h"
@@ -66,6 +67,9 @@ class LibaomAv1Encoder final : public VideoEncoder {
   EncoderInfo GetEncoderInfo() const override;
 
  private:
+  // Re-creates |frame_for_encode_| with |fmt| if the input format changed.
+  void MaybeRewrapImgWithFormat(aom_img_fmt_t fmt);
+
   bool inited_;
   bool keyframe_required_;
   VideoCodec encoder_settings_;
@@ -165,7 +169,7 @@ int LibaomAv1Encoder::InitEncode(const VideoCodec* codec_settings,
   // pointer will be set in encode. Setting align to 1, as it is meaningless
   // (actual memory is not allocated).
   frame_for_encode_ =
-      aom_img_alloc(nullptr, AOM_IMG_FMT_I420, cfg_.g_w, cfg_.g_h, 1);
+      aom_img_wrap(nullptr, AOM_IMG_FMT_I420, cfg_.g_w, cfg_.g_h, 1, nullptr);
 
   // Flag options: AOM_CODEC_USE_PSNR and AOM_CODEC_USE_HIGHBITDEPTH
   aom_codec_flags_t flags = 0;
@@ -239,27 +243,44 @@ int32_t LibaomAv1Encoder::Encode(
       frame_types != nullptr &&
       absl::c_linear_search(*frame_types, VideoFrameType::kVideoFrameKey);
 
-  // Convert input frame to I420, if needed.
-  VideoFrame prepped_input_frame = frame;
-  if (prepped_input_frame.video_frame_buffer()->type() !=
-      VideoFrameBuffer::Type::kI420) {
-    rtc::scoped_refptr<I420BufferInterface> converted_buffer(
-        prepped_input_frame.video_frame_buffer()->ToI420());
-    prepped_input_frame = VideoFrame(converted_buffer, frame.timestamp(),
-                                     frame.render_time_ms(), frame.rotation());
+  // NV12 frames are passed to libaom as is, if supported. Convert other input
+  // frames to I420, if needed. Keep a reference to the buffer until encode
+  // completes.
+  rtc::scoped_refptr<VideoFrameBuffer> buffer = frame.video_frame_buffer();
+  bool nv12_input = false;
+#if defined(RTC_ENCODER_NV12_INPUT)
+  if (buffer->type() == VideoFrameBuffer::Type::kNV12) {
+    nv12_input = true;
+    const NV12BufferInterface* nv12_buffer = buffer->GetNV12();
+    MaybeRewrapImgWithFormat(AOM_IMG_FMT_NV12);
+    // Set frame_for_encode_ data pointers and strides.
+    frame_for_encode_->planes[AOM_PLANE_Y] =
+        const_cast<unsigned char*>(nv12_buffer->DataY());
+    frame_for_encode_->planes[AOM_PLANE_U] =
+        const_cast<unsigned char*>(nv12_buffer->DataUV());
+    frame_for_encode_->planes[AOM_PLANE_V] = nullptr;
+    frame_for_encode_->stride[AOM_PLANE_Y] = nv12_buffer->StrideY();
+    frame_for_encode_->stride[AOM_PLANE_U] = nv12_buffer->StrideUV();
+    frame_for_encode_->stride[AOM_PLANE_V] = 0;
+  }
+#endif  // defined(RTC_ENCODER_NV12_INPUT)
+  if (!nv12_input) {
+    if (buffer->type() != VideoFrameBuffer::Type::kI420) {
+      buffer = buffer->ToI420();
+    }
+    const I420BufferInterface* i420_buffer = buffer->GetI420();
+    MaybeRewrapImgWithFormat(AOM_IMG_FMT_I420);
+    // Set frame_for_encode_ data pointers and strides.
+    frame_for_encode_->planes[AOM_PLANE_Y] =
+        const_cast<unsigned char*>(i420_buffer->DataY());
+    frame_for_encode_->planes[AOM_PLANE_U] =
+        const_cast<unsigned char*>(i420_buffer->DataU());
+    frame_for_encode_->planes[AOM_PLANE_V] =
+        const_cast<unsigned char*>(i420_buffer->DataV());
+    frame_for_encode_->stride[AOM_PLANE_Y] = i420_buffer->StrideY();
+    frame_for_encode_->stride[AOM_PLANE_U] = i420_buffer->StrideU();
+    frame_for_encode_->stride[AOM_PLANE_V] = i420_buffer->StrideV();
   }
-
-  // Set frame_for_encode_ data pointers and strides.
-  auto i420_buffer = prepped_input_frame.video_frame_buffer()->GetI420();
-  frame_for_encode_->planes[AOM_PLANE_Y] =
-      const_cast<unsigned char*>(i420_buffer->DataY());
-  frame_for_encode_->planes[AOM_PLANE_U] =
-      const_cast<unsigned char*>(i420_buffer->DataU());
-  frame_for_encode_->planes[AOM_PLANE_V] =
-      const_cast<unsigned char*>(i420_buffer->DataV());
-  frame_for_encode_->stride[AOM_PLANE_Y] = i420_buffer->StrideY();
-  frame_for_encode_->stride[AOM_PLANE_U] = i420_buffer->StrideU();
-  frame_for_encode_->stride[AOM_PLANE_V] = i420_buffer->StrideV();
 
   const uint32_t duration =
       kRtpTicksPerSecond / static_cast<float>(encoder_settings_.maxFramerate);
@@ -381,9 +402,24 @@ VideoEncoder::EncoderInfo LibaomAv1Encoder::GetEncoderInfo() const {
   info.has_trusted_rate_controller = true;
   info.is_hardware_accelerated = false;
   info.scaling_settings = VideoEncoder::ScalingSettings(kMinQindex, kMaxQindex);
+#if defined(RTC_ENCODER_NV12_INPUT)
+  info.preferred_pixel_formats = {VideoFrameBuffer::Type::kNV12,
+                                  VideoFrameBuffer::Type::kI420};
+#endif
   return info;
 }
 
+void LibaomAv1Encoder::MaybeRewrapImgWithFormat(const aom_img_fmt_t fmt) {
+  if (frame_for_encode_->fmt == fmt) {
+    return;
+  }
+  RTC_LOG(LS_INFO) << "Switching AV1 encoder pixel format to "
+                   << (fmt == AOM_IMG_FMT_I420 ? "I420" : "NV12");
+  aom_img_free(frame_for_encode_);
+  frame_for_encode_ =
+      aom_img_wrap(nullptr, fmt, cfg_.g_w, cfg_.g_h, 1, nullptr);
+}
+
 }  // namespace
 
 const bool kIsLibaomAv1EncoderSupported = true;
@@ -88,8 +88,8 @@ VideoFrameType ConvertToVideoFrameType(EVideoFrameType type) {
 
 // Helper method used by H264EncoderImpl::Encode.
 // Copies the encoded bytes from |info| to |encoded_image| and updates the
-// fragmentation information of |frag_header|. The |encoded_image->_buffer| may
-// be deleted and reallocated if a bigger buffer is required.
+// fragmentation information of |frag_header|. The encoded data of
+// |encoded_image| is replaced with a buffer from |buffer_pool|.
 //
 // After OpenH264 encoding, the encoded bytes are stored in |info| spread out
 // over a number of layers and "NAL units". Each NAL unit is a fragment starting
@@ -97,7 +97,8 @@ VideoFrameType ConvertToVideoFrameType(EVideoFrameType type) {
 // start codes) is copied to the |encoded_image->_buffer| and the |frag_header|
 // is updated to point to each fragment, with offsets and lengths set as to
 // exclude the start codes.
-static void RtpFragmentize(EncodedImage* encoded_image,
+static void RtpFragmentize(EncodedImageBufferPool* buffer_pool,
+                           EncodedImage* encoded_image,
                            SFrameBSInfo* info,
                            RTPFragmentationHeader* frag_header) {
   // Calculate minimum buffer size required to hold encoded data.
@@ -113,8 +114,7 @@ static void RtpFragmentize(EncodedImage* encoded_image,
       required_capacity += layerInfo.pNalLengthInByte[nal];
     }
   }
-  // TODO(nisse): Use a cache or buffer pool to avoid allocation?
-  encoded_image->SetEncodedData(EncodedImageBuffer::Create(required_capacity));
+  encoded_image->SetEncodedData(buffer_pool->CreateBuffer(required_capacity));
 
   // Iterate layers and NAL units, note each NAL unit as a fragment and copy
   // the data to |encoded_image->_buffer|.
@@ -203,6 +203,8 @@ int32_t H264EncoderImpl::InitEncode(const VideoCodec* inst,
   }
   downscaled_buffers_.resize(number_of_streams - 1);
   encoded_images_.resize(number_of_streams);
+  encoded_buffer_pools_ =
+      std::vector<EncodedImageBufferPool>(number_of_streams);
   encoders_.resize(number_of_streams);
   pictures_.resize(number_of_streams);
   configurations_.resize(number_of_streams);
@@ -312,6 +314,7 @@ int32_t H264EncoderImpl::Release() {
   downscaled_buffers_.clear();
   configurations_.clear();
   encoded_images_.clear();
+  encoded_buffer_pools_.clear();
   pictures_.clear();
   tl0sync_limit_.clear();
   return WEBRTC_VIDEO_CODEC_OK;
@@ -486,7 +489,8 @@ int32_t H264EncoderImpl::Encode(
     // Split encoded image up into fragments. This also updates
     // |encoded_image_|.
     RTPFragmentationHeader frag_header;
-    RtpFragmentize(&encoded_images_[i], &info, &frag_header);
+    RtpFragmentize(&encoded_buffer_pools_[i], &encoded_images_[i], &info,
+                   &frag_header);
 
     // Encoder can skip frames to save bandwidth in which case
     // |encoded_images_[i]._length| == 0.
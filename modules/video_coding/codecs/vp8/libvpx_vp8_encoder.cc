@@ -306,6 +306,7 @@ int LibvpxVp8Encoder::Release() {
   int ret_val = WEBRTC_VIDEO_CODEC_OK;
 
   encoded_images_.clear();
+  encoded_buffer_pools_.clear();
 
   if (inited_) {
     for (auto it = encoders_.rbegin(); it != encoders_.rend(); ++it) {
@@ -514,6 +515,8 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
   }
 
   encoded_images_.resize(number_of_streams);
+  encoded_buffer_pools_ =
+      std::vector<EncodedImageBufferPool>(number_of_streams);
   encoders_.resize(number_of_streams);
   vpx_configs_.resize(number_of_streams);
   config_overrides_.resize(number_of_streams);
@@ -1147,9 +1150,7 @@ int LibvpxVp8Encoder::GetEncodedPartitions(const VideoFrame& input_image,
       }
     }
 
-    // TODO(nisse): Introduce some buffer cache or buffer pool, to reduce
-    // allocations and/or copy operations.
-    auto buffer = EncodedImageBuffer::Create(encoded_size);
+    auto buffer = encoded_buffer_pools_[encoder_idx].CreateBuffer(encoded_size);
 
     iter = NULL;
     size_t encoded_pos = 0;
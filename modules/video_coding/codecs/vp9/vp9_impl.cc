@@ -284,6 +284,7 @@ int VP9EncoderImpl::Release() {
     vpx_img_free(raw_);
     raw_ = nullptr;
   }
+  encoded_buffer_pool_.Release();
   inited_ = false;
   return ret_val;
 }
@@ -970,7 +971,25 @@ int VP9EncoderImpl::Encode(const VideoFrame& input_image,
   rtc::scoped_refptr<const I010BufferInterface> i010_copy;
   switch (profile_) {
     case VP9Profile::kProfile0: {
+#if defined(RTC_ENCODER_NV12_INPUT)
+      // NV12 frames are passed to libvpx as is. All other formats are
+      // converted to I420.
+      const VideoFrameBuffer* buffer = input_image.video_frame_buffer().get();
+      if (buffer->type() == VideoFrameBuffer::Type::kNV12) {
+        const NV12BufferInterface* nv12_buffer = buffer->GetNV12();
+        MaybeRewrapRawWithFormat(VPX_IMG_FMT_NV12);
+        // Input image is const. VPX's raw image is not defined as const.
+        raw_->planes[VPX_PLANE_Y] = const_cast<uint8_t*>(nv12_buffer->DataY());
+        raw_->planes[VPX_PLANE_U] = const_cast<uint8_t*>(nv12_buffer->DataUV());
+        raw_->planes[VPX_PLANE_V] = raw_->planes[VPX_PLANE_U] + 1;
+        raw_->stride[VPX_PLANE_Y] = nv12_buffer->StrideY();
+        raw_->stride[VPX_PLANE_U] = nv12_buffer->StrideUV();
+        raw_->stride[VPX_PLANE_V] = nv12_buffer->StrideUV();
+        break;
+      }
+#endif  // defined(RTC_ENCODER_NV12_INPUT)
       i420_buffer = input_image.video_frame_buffer()->ToI420();
+      MaybeRewrapRawWithFormat(VPX_IMG_FMT_I420);
       // Image in vpx_image_t format.
       // Input image is const. VPX's raw image is not defined as const.
       raw_->planes[VPX_PLANE_Y] = const_cast<uint8_t*>(i420_buffer->DataY());
@@ -1451,9 +1470,7 @@ int VP9EncoderImpl::GetEncodedLayerFrame(const vpx_codec_cx_pkt* pkt) {
     DeliverBufferedFrame(end_of_picture);
   }
 
-  // TODO(nisse): Introduce some buffer cache or buffer pool, to reduce
-  // allocations and/or copy operations.
-  encoded_image_.SetEncodedData(EncodedImageBuffer::Create(
+  encoded_image_.SetEncodedData(encoded_buffer_pool_.CreateBuffer(
       static_cast<const uint8_t*>(pkt->data.frame.buf), pkt->data.frame.sz));
 
   const bool is_key_frame =
@@ -1558,6 +1575,16 @@ VideoEncoder::EncoderInfo VP9EncoderImpl::GetEncoderInfo() const {
   info.has_trusted_rate_controller = trusted_rate_controller_;
   info.is_hardware_accelerated = false;
   info.has_internal_source = false;
+  if (profile_ == VP9Profile::kProfile2) {
+    info.preferred_pixel_formats = {VideoFrameBuffer::Type::kI010};
+  } else {
+#if defined(RTC_ENCODER_NV12_INPUT)
+    info.preferred_pixel_formats = {VideoFrameBuffer::Type::kNV12,
+                                    VideoFrameBuffer::Type::kI420};
+#else
+    info.preferred_pixel_formats = {VideoFrameBuffer::Type::kI420};
+#endif
+  }
   if (inited_) {
     // Find the max configured fps of any active spatial layer.
     float max_fps = 0.0;
@@ -1605,6 +1632,17 @@ size_t VP9EncoderImpl::SteadyStateSize(int sid, int tid) {
       0.5);
 }
 
+void VP9EncoderImpl::MaybeRewrapRawWithFormat(const vpx_img_fmt fmt) {
+  if (raw_->fmt == fmt) {
+    return;
+  }
+  RTC_LOG(LS_INFO) << "Switching VP9 encoder pixel format to "
+                   << (fmt == VPX_IMG_FMT_I420 ? "I420" : "NV12");
+  vpx_img_free(raw_);
+  // Only the image description is allocated, the planes are set in Encode().
+  raw_ = vpx_img_wrap(nullptr, fmt, codec_.width, codec_.height, 1, nullptr);
+}
+
 // static
 VP9EncoderImpl::VariableFramerateExperiment
 VP9EncoderImpl::ParseVariableFramerateConfig(std::string group_name) {
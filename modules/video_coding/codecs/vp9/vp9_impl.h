@@ -21,6 +21,7 @@
 
 #include "api/fec_controller_override.h"
 #include "api/video_codecs/video_encoder.h"
+#include "common_video/include/encoded_image_buffer_pool.h"
 #include "media/base/vp9_profile.h"
 #include "modules/video_coding/codecs/vp9/include/vp9.h"
 #include "modules/video_coding/codecs/vp9/vp9_frame_buffer_pool.h"
@@ -98,7 +99,12 @@ class VP9EncoderImpl : public VP9Encoder {
 
   size_t SteadyStateSize(int sid, int tid);
 
+  // Re-creates |raw_| with |fmt| if the input format changed, e.g. when the
+  // source switches between I420 and NV12 frames.
+  void MaybeRewrapRawWithFormat(vpx_img_fmt fmt);
+
   EncodedImage encoded_image_;
+  EncodedImageBufferPool encoded_buffer_pool_;
   CodecSpecificInfo codec_specific_;
   EncodedImageCallback* encoded_complete_callback_;
   VideoCodec codec_;
@@ -249,9 +249,9 @@ void ConnectionRequest::Prepare(StunMessage* request) {
   if (connection_->ShouldSendGoogPing(request)) {
     request->SetType(GOOG_PING_REQUEST);
     request->ClearAttributes();
-    request->AddMessageIntegrity32(connection_->remote_candidate().password());
+    request->AddMessageIntegrity32(connection_->remote_integrity_key());
   } else {
-    request->AddMessageIntegrity(connection_->remote_candidate().password());
+    request->AddMessageIntegrity(connection_->remote_integrity_key());
     request->AddFingerprint();
   }
 }
@@ -451,17 +451,30 @@ void Connection::OnSendStunPacket(const void* data,
 
 void Connection::OnReadPacket(const char* data,
                               size_t size,
-                              int64_t packet_time_us) {
+                              int64_t packet_time_us,
+                              rtc::EcnMarking ecn) {
   std::unique_ptr<IceMessage> msg;
   std::string remote_ufrag;
   const rtc::SocketAddress& addr(remote_candidate_.address());
-  if (!port_->GetStunMessage(data, size, addr, &msg, &remote_ufrag)) {
+  // A media packet can't be a STUN message, so when there is a sink to hand
+  // it to, it isn't parsed as one.
+  rtc::MediaPacketSinkInterface* const media_packet_sink =
+      rtc::IsMediaPacket(data, size) ? media_packet_sink_.get() : nullptr;
+  if (media_packet_sink ||
+      !port_->GetStunMessage(data, size, addr, &msg, &remote_ufrag)) {
     // The packet did not parse as a valid STUN message
     // This is a data packet, pass it along.
     last_data_received_ = rtc::TimeMillis();
     UpdateReceiving(last_data_received_);
     recv_rate_tracker_.AddSamples(size);
-    SignalReadPacket(this, data, size, packet_time_us);
+    if (media_packet_sink) {
+      media_packet_sink->OnMediaPacket(rtc::CopyOnWriteBuffer(data, size),
+                                       packet_time_us, ecn);
+    } else {
+      last_received_ecn_ = ecn;
+      SignalReadPacket(this, data, size, packet_time_us);
+      last_received_ecn_ = rtc::EcnMarking::kNotEct;
+    }
 
     // If timed out sending writability checks, start up again
     if (!pruned_ && (write_state_ == STATE_WRITE_TIMEOUT)) {
@@ -504,8 +517,7 @@ void Connection::OnReadPacket(const char* data,
       // id's match.
       case STUN_BINDING_RESPONSE:
       case STUN_BINDING_ERROR_RESPONSE:
-        if (msg->ValidateMessageIntegrity(data, size,
-                                          remote_candidate().password())) {
+        if (msg->ValidateMessageIntegrity(data, size, remote_integrity_key())) {
           requests_.CheckResponse(msg.get());
         }
         // Otherwise silently discard the response message.
@@ -523,7 +535,7 @@ void Connection::OnReadPacket(const char* data,
       case GOOG_PING_RESPONSE:
       case GOOG_PING_ERROR_RESPONSE:
         if (msg->ValidateMessageIntegrity32(data, size,
-                                            remote_candidate().password())) {
+                                            remote_integrity_key())) {
           requests_.CheckResponse(msg.get());
         }
         break;
@@ -683,7 +695,7 @@ void Connection::SendStunBindingResponse(const StunMessage* request) {
     }
   }
 
-  response.AddMessageIntegrity(local_candidate().password());
+  response.AddMessageIntegrity(local_integrity_key());
   response.AddFingerprint();
 
   SendResponseMessage(response);
@@ -696,7 +708,7 @@ void Connection::SendGoogPingResponse(const StunMessage* request) {
   StunMessage response;
   response.SetType(GOOG_PING_RESPONSE);
   response.SetTransactionID(request->transaction_id());
-  response.AddMessageIntegrity32(local_candidate().password());
+  response.AddMessageIntegrity32(local_integrity_key());
   SendResponseMessage(response);
 }
 
@@ -1351,6 +1363,16 @@ bool Connection::ShouldSendGoogPing(const StunMessage* message) {
   return false;
 }
 
+StunMessageIntegrityKey* Connection::local_integrity_key() {
+  local_integrity_key_.SetPassword(local_candidate().password());
+  return &local_integrity_key_;
+}
+
+StunMessageIntegrityKey* Connection::remote_integrity_key() {
+  remote_integrity_key_.SetPassword(remote_candidate().password());
+  return &remote_integrity_key_;
+}
+
 void Connection::ForgetLearnedState() {
   RTC_LOG(LS_INFO) << ToString() << ": Connection forget learned state";
   requests_.Clear();
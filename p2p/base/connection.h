@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/types/optional.h"
@@ -21,6 +22,7 @@
 #include "logging/rtc_event_log/ice_logger.h"
 #include "p2p/base/candidate_pair_interface.h"
 #include "p2p/base/connection_info.h"
+#include "p2p/base/media_packet_sink_interface.h"
 #include "p2p/base/p2p_transport_channel_ice_field_trials.h"
 #include "p2p/base/stun_request.h"
 #include "p2p/base/transport_description.h"
@@ -29,6 +31,7 @@
 #include "rtc_base/network.h"
 #include "rtc_base/numerics/event_based_exponential_moving_average.h"
 #include "rtc_base/rate_tracker.h"
+#include "rtc_base/weak_ptr.h"
 
 namespace cricket {
 
@@ -163,7 +166,10 @@ class Connection : public CandidatePairInterface,
   sigslot::signal1<Connection*> SignalReadyToSend;
 
   // Called when a packet is received on this connection.
-  void OnReadPacket(const char* data, size_t size, int64_t packet_time_us);
+  void OnReadPacket(const char* data,
+                    size_t size,
+                    int64_t packet_time_us,
+                    rtc::EcnMarking ecn = rtc::EcnMarking::kNotEct);
 
   // Called when the socket is currently able to send.
   void OnReadyToSend();
@@ -238,6 +244,8 @@ class Connection : public CandidatePairInterface,
   // connectivity check from the peer.
   void HandlePiggybackCheckAcknowledgementIfAny(StunMessage* msg);
   int64_t last_data_received() const { return last_data_received_; }
+  // ECN codepoint of the packet being signaled by SignalReadPacket.
+  rtc::EcnMarking last_received_ecn() const { return last_received_ecn_; }
 
   // Debugging description of this connection
   std::string ToDebugId() const;
@@ -259,6 +267,14 @@ class Connection : public CandidatePairInterface,
   bool selected() const { return selected_; }
   void set_selected(bool selected) { selected_ = selected; }
 
+  // Media packets received while |sink| is valid are handed to it instead of
+  // being signalled by SignalReadPacket. Set by P2PTransportChannel on its
+  // selected connection.
+  void set_media_packet_sink(
+      rtc::WeakPtr<rtc::MediaPacketSinkInterface> sink) {
+    media_packet_sink_ = std::move(sink);
+  }
+
   // This signal will be fired if this connection is nominated by the
   // controlling side.
   sigslot::signal1<Connection*> SignalNominated;
@@ -393,6 +409,10 @@ class Connection : public CandidatePairInterface,
   // to last message ack:ed STUN_BINDING_REQUEST.
   bool ShouldSendGoogPing(const StunMessage* message);
 
+  // Return the MESSAGE-INTEGRITY keys of the local and the remote passwords.
+  StunMessageIntegrityKey* local_integrity_key();
+  StunMessageIntegrityKey* remote_integrity_key();
+
   WriteState write_state_;
   bool receiving_;
   bool connected_;
@@ -428,6 +448,8 @@ class Connection : public CandidatePairInterface,
   int64_t last_ping_received_;  // last time we received a ping from the other
                                 // side
   int64_t last_data_received_;
+  rtc::EcnMarking last_received_ecn_ = rtc::EcnMarking::kNotEct;
+  rtc::WeakPtr<rtc::MediaPacketSinkInterface> media_packet_sink_;
   int64_t last_ping_response_received_;
   int64_t receiving_unchanged_since_ = 0;
   std::vector<SentPing> pings_since_last_response_;
@@ -456,6 +478,9 @@ class Connection : public CandidatePairInterface,
   absl::optional<bool> remote_support_goog_ping_;
   std::unique_ptr<StunMessage> cached_stun_binding_;
 
+  StunMessageIntegrityKey local_integrity_key_;
+  StunMessageIntegrityKey remote_integrity_key_;
+
   const IceFieldTrials* field_trials_;
   rtc::EventBasedExponentialMovingAverage rtt_estimate_;
 
@@ -479,6 +479,33 @@ int DtlsTransport::SetOption(rtc::Socket::Option opt, int value) {
   return ice_transport_->SetOption(opt, value);
 }
 
+void DtlsTransport::SetMediaPacketSink(
+    rtc::WeakPtr<rtc::MediaPacketSinkInterface> sink) {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  media_packet_sink_ = std::move(sink);
+  rtc::WeakPtr<rtc::MediaPacketSinkInterface> ice_sink;
+  if (media_packet_sink_) {
+    ice_sink = weak_factory_.GetWeakPtr();
+  }
+  ice_transport_->SetMediaPacketSink(std::move(ice_sink));
+}
+
+void DtlsTransport::OnMediaPacket(rtc::CopyOnWriteBuffer packet,
+                                  int64_t packet_time_us,
+                                  rtc::EcnMarking ecn) {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  rtc::MediaPacketSinkInterface* const sink = media_packet_sink_.get();
+  // Media packets are never DTLS, so once the handshake is complete they are
+  // all SRTP packets, which OnReadPacket() would pass through as well.
+  if (sink && (!dtls_active_ || dtls_state() == DTLS_TRANSPORT_CONNECTED)) {
+    RTC_DCHECK(!dtls_active_ || !srtp_ciphers_.empty());
+    sink->OnMediaPacket(std::move(packet), packet_time_us, ecn);
+    return;
+  }
+  OnReadPacket(ice_transport_, packet.cdata<char>(), packet.size(),
+               packet_time_us, PacketFlagsFromEcn(ecn));
+}
+
 void DtlsTransport::ConnectToIceTransport() {
   RTC_DCHECK(ice_transport_);
   ice_transport_->SignalWritableState.connect(this,
@@ -563,11 +590,11 @@ void DtlsTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
                                  int flags) {
   RTC_DCHECK_RUN_ON(&thread_checker_);
   RTC_DCHECK(transport == ice_transport_);
-  RTC_DCHECK(flags == 0);
+  RTC_DCHECK((flags & ~PF_ECN_MASK) == 0);
 
   if (!dtls_active_) {
     // Not doing DTLS.
-    SignalReadPacket(this, data, size, packet_time_us, 0);
+    SignalReadPacket(this, data, size, packet_time_us, flags);
     return;
   }
 
@@ -630,7 +657,8 @@ void DtlsTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
         RTC_DCHECK(!srtp_ciphers_.empty());
 
         // Signal this upwards as a bypass packet.
-        SignalReadPacket(this, data, size, packet_time_us, PF_SRTP_BYPASS);
+        SignalReadPacket(this, data, size, packet_time_us,
+                         PF_SRTP_BYPASS | (flags & PF_ECN_MASK));
       }
       break;
     case DTLS_TRANSPORT_FAILED:
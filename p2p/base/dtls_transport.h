@@ -18,6 +18,7 @@
 #include "api/crypto/crypto_options.h"
 #include "p2p/base/dtls_transport_internal.h"
 #include "p2p/base/ice_transport_internal.h"
+#include "p2p/base/media_packet_sink_interface.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/buffer_queue.h"
 #include "rtc_base/constructor_magic.h"
@@ -25,6 +26,7 @@
 #include "rtc_base/stream.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/thread_checker.h"
+#include "rtc_base/weak_ptr.h"
 
 namespace rtc {
 class PacketTransportInternal;
@@ -89,7 +91,8 @@ class StreamInterfaceChannel : public rtc::StreamInterface {
 //
 // This class is not thread safe; all methods must be called on the same thread
 // as the constructor.
-class DtlsTransport : public DtlsTransportInternal {
+class DtlsTransport : public DtlsTransportInternal,
+                      public rtc::MediaPacketSinkInterface {
  public:
   // |ice_transport| is the ICE transport this DTLS transport is wrapping.  It
   // must outlive this DTLS transport.
@@ -185,6 +188,15 @@ class DtlsTransport : public DtlsTransportInternal {
 
   int SetOption(rtc::Socket::Option opt, int value) override;
 
+  // Media packets are passed through to |sink| when not doing DTLS, or once
+  // the handshake is complete, as SRTP packets. Before that, they take the
+  // same path as the packets that are signalled by the ICE transport.
+  void SetMediaPacketSink(
+      rtc::WeakPtr<rtc::MediaPacketSinkInterface> sink) override;
+  void OnMediaPacket(rtc::CopyOnWriteBuffer packet,
+                     int64_t packet_time_us,
+                     rtc::EcnMarking ecn) override;
+
   std::string ToString() const {
     const absl::string_view RECEIVING_ABBREV[2] = {"_", "R"};
     const absl::string_view WRITABLE_ABBREV[2] = {"_", "W"};
@@ -249,6 +261,10 @@ class DtlsTransport : public DtlsTransportInternal {
 
   webrtc::RtcEventLog* const event_log_;
 
+  rtc::WeakPtr<rtc::MediaPacketSinkInterface> media_packet_sink_;
+  // Must be the last member, see rtc::WeakPtrFactory.
+  rtc::WeakPtrFactory<DtlsTransport> weak_factory_{this};
+
   RTC_DISALLOW_COPY_AND_ASSIGN(DtlsTransport);
 };
 
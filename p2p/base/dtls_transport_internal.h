@@ -23,6 +23,7 @@
 #include "p2p/base/ice_transport_internal.h"
 #include "p2p/base/packet_transport_internal.h"
 #include "rtc_base/constructor_magic.h"
+#include "rtc_base/network/ecn_marking.h"
 #include "rtc_base/ssl_certificate.h"
 #include "rtc_base/ssl_fingerprint.h"
 #include "rtc_base/ssl_stream_adapter.h"
@@ -50,8 +51,17 @@ enum PacketFlags {
   PF_NORMAL = 0x00,       // A normal packet.
   PF_SRTP_BYPASS = 0x01,  // An encrypted SRTP packet; bypass any additional
                           // crypto provided by the transport (e.g. DTLS)
+  PF_ECN_MASK = 0x06,     // The ECN codepoint the packet was received with.
 };
 
+inline int PacketFlagsFromEcn(rtc::EcnMarking ecn) {
+  return (static_cast<int>(ecn) << 1) & PF_ECN_MASK;
+}
+
+inline rtc::EcnMarking EcnFromPacketFlags(int flags) {
+  return static_cast<rtc::EcnMarking>((flags & PF_ECN_MASK) >> 1);
+}
+
 // DtlsTransportInternal is an internal interface that does DTLS, also
 // negotiating SRTP crypto suites so that it may be used for DTLS-SRTP.
 //
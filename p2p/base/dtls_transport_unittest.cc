@@ -16,6 +16,7 @@
 #include <utility>
 
 #include "p2p/base/fake_ice_transport.h"
+#include "p2p/base/media_packet_sink_interface.h"
 #include "p2p/base/packet_transport_internal.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/dscp.h"
@@ -25,6 +26,7 @@
 #include "rtc_base/ssl_adapter.h"
 #include "rtc_base/ssl_identity.h"
 #include "rtc_base/ssl_stream_adapter.h"
+#include "rtc_base/weak_ptr.h"
 
 #define MAYBE_SKIP_TEST(feature)                                  \
   if (!(rtc::SSLStreamAdapter::feature())) {                      \
@@ -61,7 +63,8 @@ void SetRemoteFingerprintFromCert(
       fingerprint->digest.size()));
 }
 
-class DtlsTestClient : public sigslot::has_slots<> {
+class DtlsTestClient : public sigslot::has_slots<>,
+                       public rtc::MediaPacketSinkInterface {
  public:
   explicit DtlsTestClient(const std::string& name) : name_(name) {}
   void CreateCertificate(rtc::KeyType key_type) {
@@ -194,6 +197,13 @@ class DtlsTestClient : public sigslot::has_slots<> {
 
   size_t NumPacketsReceived() { return received_.size(); }
 
+  // Makes the DTLS transport hand the SRTP packets to OnMediaPacket().
+  void SetMediaPacketSink() {
+    dtls_transport_->SetMediaPacketSink(weak_factory_.GetWeakPtr());
+  }
+
+  int num_media_packets_received() const { return num_media_packets_received_; }
+
   // Inverse of SendPackets.
   bool VerifyPacket(const char* data, size_t size, uint32_t* out_num) {
     if (size != packet_size_ ||
@@ -254,6 +264,15 @@ class DtlsTestClient : public sigslot::has_slots<> {
 
   rtc::SentPacket sent_packet() const { return sent_packet_; }
 
+  void OnMediaPacket(rtc::CopyOnWriteBuffer packet,
+                     int64_t packet_time_us,
+                     rtc::EcnMarking ecn) override {
+    uint32_t packet_num = 0;
+    ASSERT_TRUE(VerifyPacket(packet.cdata<char>(), packet.size(), &packet_num));
+    received_.insert(packet_num);
+    ++num_media_packets_received_;
+  }
+
   // Hook into the raw packet stream to make sure DTLS packets are encrypted.
   void OnFakeIceTransportReadPacket(rtc::PacketTransportInternal* transport,
                                     const char* data,
@@ -292,7 +311,9 @@ class DtlsTestClient : public sigslot::has_slots<> {
   rtc::SSLProtocolVersion ssl_max_version_ = rtc::SSL_PROTOCOL_DTLS_12;
   int received_dtls_client_hellos_ = 0;
   int received_dtls_server_hellos_ = 0;
+  int num_media_packets_received_ = 0;
   rtc::SentPacket sent_packet_;
+  rtc::WeakPtrFactory<DtlsTestClient> weak_factory_{this};
 };
 
 // Base class for DtlsTransportTest and DtlsEventOrderingTest, which
@@ -414,6 +435,14 @@ TEST_F(DtlsTransportTest, TestTransferSrtp) {
   TestTransfer(1000, 100, /*srtp=*/true);
 }
 
+// Connect without DTLS, and transfer SRTP data through the media packet sink.
+TEST_F(DtlsTransportTest, TestTransferSrtpToMediaPacketSink) {
+  ASSERT_TRUE(Connect());
+  client2_.SetMediaPacketSink();
+  TestTransfer(1000, 100, /*srtp=*/true);
+  EXPECT_EQ(100, client2_.num_media_packets_received());
+}
+
 // Connect with DTLS, and transfer data over DTLS.
 TEST_F(DtlsTransportTest, TestTransferDtls) {
   PrepareDtls(rtc::KT_DEFAULT);
@@ -469,6 +498,31 @@ TEST_F(DtlsTransportTest, TestTransferDtlsSrtp) {
   TestTransfer(1000, 100, /*srtp=*/true);
 }
 
+// Connect with DTLS-SRTP, and transfer SRTP data through the media packet
+// sink.
+TEST_F(DtlsTransportTest, TestTransferDtlsSrtpToMediaPacketSink) {
+  PrepareDtls(rtc::KT_DEFAULT);
+  ASSERT_TRUE(Connect());
+  client2_.SetMediaPacketSink();
+  TestTransfer(1000, 100, /*srtp=*/true);
+  EXPECT_EQ(100, client2_.num_media_packets_received());
+}
+
+// Test that media packets aren't handed to the sink before the DTLS handshake
+// is complete.
+TEST_F(DtlsTransportTest, MediaPacketSinkWaitsForDtlsHandshake) {
+  PrepareDtls(rtc::KT_DEFAULT);
+  Negotiate();
+  client2_.SetMediaPacketSink();
+  client2_.ExpectPackets(kPacketHeaderLen);
+  char packet[kPacketHeaderLen] = {static_cast<char>(0x80)};
+  client2_.dtls_transport()->OnMediaPacket(
+      rtc::CopyOnWriteBuffer(packet, sizeof(packet)), rtc::TimeMicros(),
+      rtc::EcnMarking::kNotEct);
+  EXPECT_EQ(0, client2_.num_media_packets_received());
+  EXPECT_EQ(0u, client2_.NumPacketsReceived());
+}
+
 // Connect with DTLS-SRTP, transfer an invalid SRTP packet, and expects -1
 // returned.
 TEST_F(DtlsTransportTest, TestTransferDtlsInvalidSrtpPacket) {
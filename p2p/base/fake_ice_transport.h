@@ -20,6 +20,7 @@
 #include "absl/types/optional.h"
 #include "api/ice_transport_interface.h"
 #include "p2p/base/ice_transport_internal.h"
+#include "p2p/base/media_packet_sink_interface.h"
 #include "rtc_base/async_invoker.h"
 #include "rtc_base/copy_on_write_buffer.h"
 
@@ -279,6 +280,13 @@ class FakeIceTransport : public IceTransportInternal {
         RTC_FROM_HERE, [this] { SignalNetworkRouteChanged(network_route_); });
   }
 
+  // Like P2PTransportChannel on its selected connection, hands the received
+  // media packets to the sink.
+  void SetMediaPacketSink(
+      rtc::WeakPtr<rtc::MediaPacketSinkInterface> sink) override {
+    media_packet_sink_ = std::move(sink);
+  }
+
  private:
   void set_writable(bool writable) {
     if (writable_ == writable) {
@@ -303,9 +311,18 @@ class FakeIceTransport : public IceTransportInternal {
   void SendPacketInternal(const rtc::CopyOnWriteBuffer& packet) {
     if (dest_) {
       last_sent_packet_ = packet;
-      dest_->SignalReadPacket(dest_, packet.data<char>(), packet.size(),
-                              rtc::TimeMicros(), 0);
+      dest_->ReceivePacketInternal(packet);
+    }
+  }
+
+  void ReceivePacketInternal(const rtc::CopyOnWriteBuffer& packet) {
+    rtc::MediaPacketSinkInterface* sink = media_packet_sink_.get();
+    if (sink && rtc::IsMediaPacket(packet.cdata<char>(), packet.size())) {
+      sink->OnMediaPacket(packet, rtc::TimeMicros(), rtc::EcnMarking::kNotEct);
+      return;
     }
+    SignalReadPacket(this, packet.data<char>(), packet.size(),
+                     rtc::TimeMicros(), 0);
   }
 
   rtc::AsyncInvoker invoker_;
@@ -333,6 +350,7 @@ class FakeIceTransport : public IceTransportInternal {
   absl::optional<rtc::NetworkRoute> network_route_;
   std::map<rtc::Socket::Option, int> socket_options_;
   rtc::CopyOnWriteBuffer last_sent_packet_;
+  rtc::WeakPtr<rtc::MediaPacketSinkInterface> media_packet_sink_;
   rtc::Thread* const network_thread_;
 };
 
@@ -0,0 +1,51 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_MEDIA_PACKET_SINK_INTERFACE_H_
+#define P2P_BASE_MEDIA_PACKET_SINK_INTERFACE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/network/ecn_marking.h"
+
+namespace rtc {
+
+// The size of a fixed RTP header. Shorter packets are never handed to a
+// MediaPacketSinkInterface; SRTCP packets are always longer than that.
+constexpr size_t kMinMediaPacketSize = 12;
+
+// Returns true if |data| looks like an RTP or RTCP packet, i.e. it starts with
+// version 2 (RFC 3550), which tells it apart from STUN, DTLS and TURN channel
+// data (RFC 7983).
+inline bool IsMediaPacket(const char* data, size_t size) {
+  return size >= kMinMediaPacketSize &&
+         (static_cast<uint8_t>(data[0]) & 0xC0) == 0x80;
+}
+
+// Receives the media packets of a PacketTransportInternal directly, rather
+// than through the SignalReadPacket chain of the transports that it is built
+// on. See PacketTransportInternal::SetMediaPacketSink().
+class MediaPacketSinkInterface {
+ public:
+  // Called on the network thread with a packet for which IsMediaPacket() is
+  // true. The packet is still SRTP protected when SRTP is in use.
+  virtual void OnMediaPacket(CopyOnWriteBuffer packet,
+                             int64_t packet_time_us,
+                             EcnMarking ecn) = 0;
+
+ protected:
+  virtual ~MediaPacketSinkInterface() = default;
+};
+
+}  // namespace rtc
+
+#endif  // P2P_BASE_MEDIA_PACKET_SINK_INTERFACE_H_
@@ -22,6 +22,7 @@
 #include "p2p/base/basic_ice_controller.h"
 #include "p2p/base/candidate_pair_interface.h"
 #include "p2p/base/connection.h"
+#include "p2p/base/dtls_transport_internal.h"
 #include "p2p/base/port.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/crc32.h"
@@ -191,6 +192,12 @@ P2PTransportChannel::P2PTransportChannel(
 }
 
 P2PTransportChannel::~P2PTransportChannel() {
+  // The connections are destroyed asynchronously, so make sure that they
+  // don't deliver packets to the sink in the meantime.
+  if (selected_connection_) {
+    selected_connection_->set_media_packet_sink(
+        rtc::WeakPtr<rtc::MediaPacketSinkInterface>());
+  }
   std::vector<Connection*> copy(connections().begin(), connections().end());
   for (Connection* con : copy) {
     con->Destroy();
@@ -1565,6 +1572,15 @@ absl::optional<rtc::NetworkRoute> P2PTransportChannel::network_route() const {
   return network_route_;
 }
 
+void P2PTransportChannel::SetMediaPacketSink(
+    rtc::WeakPtr<rtc::MediaPacketSinkInterface> sink) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  media_packet_sink_ = std::move(sink);
+  if (selected_connection_) {
+    selected_connection_->set_media_packet_sink(media_packet_sink_);
+  }
+}
+
 rtc::DiffServCodePoint P2PTransportChannel::DefaultDscpValue() const {
   RTC_DCHECK_RUN_ON(network_thread_);
   OptionMap::const_iterator it = options_.find(rtc::Socket::OPT_DSCP);
@@ -1720,10 +1736,13 @@ void P2PTransportChannel::SwitchSelectedConnection(Connection* conn,
   network_route_.reset();
   if (old_selected_connection) {
     old_selected_connection->set_selected(false);
+    old_selected_connection->set_media_packet_sink(
+        rtc::WeakPtr<rtc::MediaPacketSinkInterface>());
   }
   if (selected_connection_) {
     ++nomination_;
     selected_connection_->set_selected(true);
+    selected_connection_->set_media_packet_sink(media_packet_sink_);
     if (old_selected_connection) {
       RTC_LOG(LS_INFO) << ToString() << ": Previous selected connection: "
                        << old_selected_connection->ToString();
@@ -2096,9 +2115,10 @@ void P2PTransportChannel::OnReadPacket(Connection* connection,
                                        int64_t packet_time_us) {
   RTC_DCHECK_RUN_ON(network_thread_);
 
+  const int flags = PacketFlagsFromEcn(connection->last_received_ecn());
   if (connection == selected_connection_) {
     // Let the client know of an incoming packet
-    SignalReadPacket(this, data, len, packet_time_us, 0);
+    SignalReadPacket(this, data, len, packet_time_us, flags);
     return;
   }
 
@@ -2107,7 +2127,7 @@ void P2PTransportChannel::OnReadPacket(Connection* connection,
     return;
 
   // Let the client know of an incoming packet
-  SignalReadPacket(this, data, len, packet_time_us, 0);
+  SignalReadPacket(this, data, len, packet_time_us, flags);
 
   // May need to switch the sending connection based on the receiving media path
   // if this is the controlled side.
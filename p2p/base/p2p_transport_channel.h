@@ -48,6 +48,7 @@
 #include "rtc_base/system/rtc_export.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "rtc_base/thread_annotations.h"
+#include "rtc_base/weak_ptr.h"
 
 namespace webrtc {
 class RtcEventLog;
@@ -172,6 +173,10 @@ class RTC_EXPORT P2PTransportChannel : public IceTransportInternal {
   void PruneAllPorts();
   int check_receiving_interval() const;
   absl::optional<rtc::NetworkRoute> network_route() const override;
+  // The sink is installed on the selected connection, and follows it when
+  // another connection gets selected.
+  void SetMediaPacketSink(
+      rtc::WeakPtr<rtc::MediaPacketSinkInterface> sink) override;
 
   // Helper method used only in unittest.
   rtc::DiffServCodePoint DefaultDscpValue() const;
@@ -368,6 +373,8 @@ class RTC_EXPORT P2PTransportChannel : public IceTransportInternal {
   std::vector<PortInterface*> pruned_ports_ RTC_GUARDED_BY(network_thread_);
 
   Connection* selected_connection_ RTC_GUARDED_BY(network_thread_) = nullptr;
+  rtc::WeakPtr<rtc::MediaPacketSinkInterface> media_packet_sink_
+      RTC_GUARDED_BY(network_thread_);
 
   std::vector<RemoteCandidate> remote_candidates_
       RTC_GUARDED_BY(network_thread_);
@@ -18,6 +18,7 @@
 #include "p2p/base/connection.h"
 #include "p2p/base/fake_port_allocator.h"
 #include "p2p/base/ice_transport_internal.h"
+#include "p2p/base/media_packet_sink_interface.h"
 #include "p2p/base/mock_async_resolver.h"
 #include "p2p/base/packet_transport_internal.h"
 #include "p2p/base/test_stun_server.h"
@@ -40,6 +41,7 @@
 #include "rtc_base/ssl_adapter.h"
 #include "rtc_base/thread.h"
 #include "rtc_base/virtual_socket_server.h"
+#include "rtc_base/weak_ptr.h"
 #include "system_wrappers/include/metrics.h"
 #include "test/field_trial.h"
 
@@ -3951,6 +3953,87 @@ TEST_F(P2PTransportChannelPingTest, TestSelectConnectionBasedOnMediaReceived) {
   EXPECT_EQ_WAIT(conn3, ch.selected_connection(), kDefaultTimeout);
 }
 
+// Counts the packets that a transport hands to its media packet sink, and the
+// ones that it signals.
+class MediaPacketCounter : public rtc::MediaPacketSinkInterface,
+                           public sigslot::has_slots<> {
+ public:
+  explicit MediaPacketCounter(rtc::PacketTransportInternal* transport) {
+    transport->SignalReadPacket.connect(this,
+                                        &MediaPacketCounter::OnReadPacket);
+  }
+
+  rtc::WeakPtr<rtc::MediaPacketSinkInterface> GetWeakPtr() {
+    return weak_factory_.GetWeakPtr();
+  }
+
+  void OnMediaPacket(rtc::CopyOnWriteBuffer packet,
+                     int64_t packet_time_us,
+                     rtc::EcnMarking ecn) override {
+    ++num_sink_packets_;
+  }
+
+  int num_sink_packets() const { return num_sink_packets_; }
+  int num_signaled_packets() const { return num_signaled_packets_; }
+
+ private:
+  void OnReadPacket(rtc::PacketTransportInternal* transport,
+                    const char* data,
+                    size_t len,
+                    const int64_t& packet_time_us,
+                    int flags) {
+    ++num_signaled_packets_;
+  }
+
+  int num_sink_packets_ = 0;
+  int num_signaled_packets_ = 0;
+  rtc::WeakPtrFactory<MediaPacketCounter> weak_factory_{this};
+};
+
+// Test that the media packets received on the selected connection are handed
+// to the media packet sink, and that the sink follows the selected connection.
+TEST_F(P2PTransportChannelPingTest, TestMediaPacketSinkOnSelectedConnection) {
+  FakePortAllocator pa(rtc::Thread::Current(), nullptr);
+  P2PTransportChannel ch("media packet sink", 1, &pa);
+  PrepareChannel(&ch);
+  ch.MaybeStartGathering();
+  MediaPacketCounter counter(&ch);
+  ch.SetMediaPacketSink(counter.GetWeakPtr());
+  const char kRtpPacket[12] = {static_cast<char>(0x80)};
+
+  ch.AddRemoteCandidate(CreateUdpCandidate(LOCAL_PORT_TYPE, "1.1.1.1", 1, 1));
+  Connection* conn1 = WaitForConnectionTo(&ch, "1.1.1.1", 1);
+  ASSERT_TRUE(conn1 != nullptr);
+  conn1->OnReadPacket(kRtpPacket, sizeof(kRtpPacket), rtc::TimeMicros());
+  EXPECT_EQ(0, counter.num_sink_packets());
+  EXPECT_EQ(1, counter.num_signaled_packets());
+
+  conn1->ReceivedPingResponse(LOW_RTT, "id");
+  EXPECT_EQ_WAIT(conn1, ch.selected_connection(), kDefaultTimeout);
+  conn1->OnReadPacket(kRtpPacket, sizeof(kRtpPacket), rtc::TimeMicros());
+  EXPECT_EQ(1, counter.num_sink_packets());
+  EXPECT_EQ(1, counter.num_signaled_packets());
+  // Packets that don't look like RTP or RTCP are still signaled.
+  conn1->OnReadPacket("ABC", 3, rtc::TimeMicros());
+  EXPECT_EQ(1, counter.num_sink_packets());
+  EXPECT_EQ(2, counter.num_signaled_packets());
+
+  ch.AddRemoteCandidate(CreateUdpCandidate(LOCAL_PORT_TYPE, "2.2.2.2", 2, 10));
+  Connection* conn2 = WaitForConnectionTo(&ch, "2.2.2.2", 2);
+  ASSERT_TRUE(conn2 != nullptr);
+  conn2->ReceivedPingResponse(LOW_RTT, "id");
+  EXPECT_EQ_WAIT(conn2, ch.selected_connection(), kDefaultTimeout);
+  conn1->OnReadPacket(kRtpPacket, sizeof(kRtpPacket), rtc::TimeMicros());
+  conn2->OnReadPacket(kRtpPacket, sizeof(kRtpPacket), rtc::TimeMicros());
+  EXPECT_EQ(2, counter.num_sink_packets());
+  EXPECT_EQ(3, counter.num_signaled_packets());
+
+  ch.SetMediaPacketSink(rtc::WeakPtr<rtc::MediaPacketSinkInterface>());
+  conn2->OnReadPacket(kRtpPacket, sizeof(kRtpPacket), rtc::TimeMicros());
+  EXPECT_EQ(2, counter.num_sink_packets());
+  EXPECT_EQ(4, counter.num_signaled_packets());
+}
+
 TEST_F(P2PTransportChannelPingTest,
        TestControlledAgentDataReceivingTakesHigherPrecedenceThanPriority) {
   rtc::ScopedFakeClock clock;
@@ -24,4 +24,7 @@ absl::optional<NetworkRoute> PacketTransportInternal::network_route() const {
   return absl::optional<NetworkRoute>();
 }
 
+void PacketTransportInternal::SetMediaPacketSink(
+    WeakPtr<MediaPacketSinkInterface> sink) {}
+
 }  // namespace rtc
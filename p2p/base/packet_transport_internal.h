@@ -15,12 +15,14 @@
 #include <vector>
 
 #include "absl/types/optional.h"
+#include "p2p/base/media_packet_sink_interface.h"
 #include "p2p/base/port.h"
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/network_route.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/system/rtc_export.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/weak_ptr.h"
 
 namespace rtc {
 struct PacketOptions;
@@ -65,6 +67,14 @@ class RTC_EXPORT PacketTransportInternal : public sigslot::has_slots<> {
   // TODO(zhihuang): Make it pure virtual once the Chrome/remoting is updated.
   virtual absl::optional<NetworkRoute> network_route() const;
 
+  // Makes the transport hand the media packets that it receives (see
+  // IsMediaPacket()) to |sink| instead of emitting SignalReadPacket, whenever
+  // they need no further processing by the transport, e.g. once the DTLS
+  // handshake is done. All other packets are still signalled, as are all
+  // packets once |sink| is reset or destroyed. The default implementation
+  // ignores the sink.
+  virtual void SetMediaPacketSink(WeakPtr<MediaPacketSinkInterface> sink);
+
   // Emitted when the writable state, represented by |writable()|, changes.
   sigslot::signal1<PacketTransportInternal*> SignalWritableState;
 
@@ -490,7 +490,7 @@ bool Port::GetStunMessage(const char* data,
     }
 
     // If ICE, and the MESSAGE-INTEGRITY is bad, fail with a 401 Unauthorized
-    if (!stun_msg->ValidateMessageIntegrity(data, size, password_)) {
+    if (!stun_msg->ValidateMessageIntegrity(data, size, integrity_key())) {
       RTC_LOG(LS_ERROR) << ToString() << ": Received "
                         << StunMethodToString(stun_msg->type())
                         << " with bad M-I from " << addr.ToSensitiveString()
@@ -556,7 +556,7 @@ bool Port::GetStunMessage(const char* data,
     // No stun attributes will be verified, if it's stun indication message.
     // Returning from end of the this method.
   } else if (stun_msg->type() == GOOG_PING_REQUEST) {
-    if (!stun_msg->ValidateMessageIntegrity32(data, size, password_)) {
+    if (!stun_msg->ValidateMessageIntegrity32(data, size, integrity_key())) {
       RTC_LOG(LS_ERROR) << ToString() << ": Received "
                         << StunMethodToString(stun_msg->type())
                         << " with bad M-I from " << addr.ToSensitiveString()
@@ -745,9 +745,9 @@ void Port::SendBindingErrorResponse(StunMessage* request,
       error_code != STUN_ERROR_UNAUTHORIZED &&
       request->type() != GOOG_PING_REQUEST) {
     if (request->type() == STUN_BINDING_REQUEST) {
-      response.AddMessageIntegrity(password_);
+      response.AddMessageIntegrity(integrity_key());
     } else {
-      response.AddMessageIntegrity32(password_);
+      response.AddMessageIntegrity32(integrity_key());
     }
   }
 
@@ -791,7 +791,7 @@ void Port::SendUnknownAttributesErrorResponse(
   }
   response.AddAttribute(std::move(unknown_attr));
 
-  response.AddMessageIntegrity(password_);
+  response.AddMessageIntegrity(integrity_key());
   response.AddFingerprint();
 
   // Send the response message.
@@ -835,6 +835,11 @@ void Port::OnNetworkTypeChanged(const rtc::Network* network) {
   UpdateNetworkCost();
 }
 
+StunMessageIntegrityKey* Port::integrity_key() {
+  integrity_key_.SetPassword(password_);
+  return &integrity_key_;
+}
+
 std::string Port::ToString() const {
   rtc::StringBuilder ss;
   ss << "Port[" << rtc::ToHex(reinterpret_cast<uintptr_t>(this)) << ":"
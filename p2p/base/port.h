@@ -435,6 +435,9 @@ class Port : public PortInterface,
 
   void OnNetworkTypeChanged(const rtc::Network* network);
 
+  // Returns the MESSAGE-INTEGRITY key of |password_|.
+  StunMessageIntegrityKey* integrity_key();
+
   rtc::Thread* thread_;
   rtc::PacketSocketFactory* factory_;
   std::string type_;
@@ -455,6 +458,7 @@ class Port : public PortInterface,
   // username_fragment().
   std::string ice_username_fragment_;
   std::string password_;
+  StunMessageIntegrityKey integrity_key_;
   std::vector<Candidate> candidates_;
   AddressMap connections_;
   int timeout_delay_;
@@ -718,7 +718,7 @@ bool TurnPort::HandleIncomingPacket(rtc::AsyncPacketSocket* socket,
   // This must be a response for one of our requests.
   // Check success responses, but not errors, for MESSAGE-INTEGRITY.
   if (IsStunSuccessResponseType(msg_type) &&
-      !StunMessage::ValidateMessageIntegrity(data, size, hash())) {
+      !StunMessage::ValidateMessageIntegrity(data, size, integrity_key())) {
     RTC_LOG(LS_WARNING) << ToString()
                         << ": Received TURN message with invalid "
                            "message integrity, msg_type: "
@@ -1123,7 +1123,7 @@ void TurnPort::AddRequestAuthInfo(StunMessage* msg) {
       std::make_unique<StunByteStringAttribute>(STUN_ATTR_REALM, realm_));
   msg->AddAttribute(
       std::make_unique<StunByteStringAttribute>(STUN_ATTR_NONCE, nonce_));
-  const bool success = msg->AddMessageIntegrity(hash());
+  const bool success = msg->AddMessageIntegrity(integrity_key());
   RTC_DCHECK(success);
 }
 
@@ -1139,6 +1139,11 @@ void TurnPort::UpdateHash() {
   RTC_DCHECK(success);
 }
 
+StunMessageIntegrityKey* TurnPort::integrity_key() {
+  integrity_key_.SetPassword(hash_);
+  return &integrity_key_;
+}
+
 bool TurnPort::UpdateNonce(StunMessage* response) {
   // When stale nonce error received, we should update
   // hash and store realm and nonce.
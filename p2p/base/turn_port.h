@@ -330,6 +330,8 @@ class TurnPort : public Port {
   void SendRequest(StunRequest* request, int delay);
   int Send(const void* data, size_t size, const rtc::PacketOptions& options);
   void UpdateHash();
+  // Returns the MESSAGE-INTEGRITY key of |hash_|.
+  StunMessageIntegrityKey* integrity_key();
   bool UpdateNonce(StunMessage* response);
   void ResetNonce();
 
@@ -375,6 +377,7 @@ class TurnPort : public Port {
   std::string realm_;  // From 401/438 response message.
   std::string nonce_;  // From 401/438 response message.
   std::string hash_;   // Digest of username:realm:password
+  StunMessageIntegrityKey integrity_key_;
 
   int next_channel_number_;
   EntryList entries_;
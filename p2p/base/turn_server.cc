@@ -617,7 +617,8 @@ TurnServerAllocation::TurnServerAllocation(TurnServer* server,
       thread_(thread),
       conn_(conn),
       external_socket_(socket),
-      key_(key) {
+      key_(key),
+      integrity_key_(key) {
   external_socket_->SignalReadPacket.connect(
       this, &TurnServerAllocation::OnExternalPacket);
 }
@@ -932,7 +933,7 @@ TurnServerAllocation::Channel* TurnServerAllocation::FindChannel(
 
 void TurnServerAllocation::SendResponse(TurnMessage* msg) {
   // Success responses always have M-I.
-  msg->AddMessageIntegrity(key_);
+  msg->AddMessageIntegrity(&integrity_key_);
   server_->SendStun(&conn_, msg);
 }
 
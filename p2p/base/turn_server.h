@@ -19,6 +19,7 @@
 #include <utility>
 #include <vector>
 
+#include "api/transport/stun.h"
 #include "p2p/base/port_interface.h"
 #include "rtc_base/async_invoker.h"
 #include "rtc_base/async_packet_socket.h"
@@ -134,6 +135,7 @@ class TurnServerAllocation : public rtc::MessageHandler,
   TurnServerConnection conn_;
   std::unique_ptr<rtc::AsyncPacketSocket> external_socket_;
   std::string key_;
+  StunMessageIntegrityKey integrity_key_;
   std::string transaction_id_;
   std::string username_;
   std::string origin_;
@@ -438,13 +438,6 @@ bool BaseChannel::SendPacket(bool rtcp,
 }
 
 void BaseChannel::OnRtpPacket(const webrtc::RtpPacketReceived& parsed_packet) {
-  // Take packet time from the |parsed_packet|.
-  // RtpPacketReceived.arrival_time_ms = (timestamp_us + 500) / 1000;
-  int64_t packet_time_us = -1;
-  if (parsed_packet.arrival_time_ms() > 0) {
-    packet_time_us = parsed_packet.arrival_time_ms() * 1000;
-  }
-
   if (!has_received_packet_) {
     has_received_packet_ = true;
     signaling_thread()->Post(RTC_FROM_HERE, this, MSG_FIRSTPACKETRECEIVED);
@@ -467,13 +460,21 @@ void BaseChannel::OnRtpPacket(const webrtc::RtpPacketReceived& parsed_packet) {
     return;
   }
 
-  auto packet_buffer = parsed_packet.Buffer();
+  // The parsed packet, including its arrival time and the header extensions
+  // identified by the transport, is handed to the media channel so that it
+  // does not need to be parsed again by the call.
+  if (worker_thread_ == network_thread_) {
+    // Network and worker share a thread; deliver without posting a task.
+    media_channel_->OnRtpPacketReceived(parsed_packet);
+    return;
+  }
 
-  invoker_.AsyncInvoke<void>(
-      RTC_FROM_HERE, worker_thread_, [this, packet_buffer, packet_time_us] {
-        RTC_DCHECK(worker_thread_->IsCurrent());
-        media_channel_->OnPacketReceived(packet_buffer, packet_time_us);
-      });
+  invoker_.AsyncInvoke<void>(RTC_FROM_HERE, worker_thread_,
+                             [this, parsed_packet] {
+                               RTC_DCHECK(worker_thread_->IsCurrent());
+                               media_channel_->OnRtpPacketReceived(
+                                   parsed_packet);
+                             });
 }
 
 void BaseChannel::UpdateRtpHeaderExtensionMap(
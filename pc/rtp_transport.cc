@@ -19,6 +19,7 @@
 #include "api/rtp_parameters.h"
 #include "media/base/rtp_utils.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "p2p/base/dtls_transport_internal.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/logging.h"
@@ -58,6 +59,8 @@ void RtpTransport::SetRtpPacketTransport(
     rtp_packet_transport_->SignalNetworkRouteChanged.disconnect(this);
     rtp_packet_transport_->SignalWritableState.disconnect(this);
     rtp_packet_transport_->SignalSentPacket.disconnect(this);
+    rtp_packet_transport_->SetMediaPacketSink(
+        rtc::WeakPtr<rtc::MediaPacketSinkInterface>());
     // Reset the network route of the old transport.
     SignalNetworkRouteChanged(absl::optional<rtc::NetworkRoute>());
   }
@@ -72,6 +75,7 @@ void RtpTransport::SetRtpPacketTransport(
         this, &RtpTransport::OnWritableState);
     new_packet_transport->SignalSentPacket.connect(this,
                                                    &RtpTransport::OnSentPacket);
+    new_packet_transport->SetMediaPacketSink(weak_factory_.GetWeakPtr());
     // Set the network route for the new transport.
     SignalNetworkRouteChanged(new_packet_transport->network_route());
   }
@@ -94,6 +98,8 @@ void RtpTransport::SetRtcpPacketTransport(
     rtcp_packet_transport_->SignalNetworkRouteChanged.disconnect(this);
     rtcp_packet_transport_->SignalWritableState.disconnect(this);
     rtcp_packet_transport_->SignalSentPacket.disconnect(this);
+    rtcp_packet_transport_->SetMediaPacketSink(
+        rtc::WeakPtr<rtc::MediaPacketSinkInterface>());
     // Reset the network route of the old transport.
     SignalNetworkRouteChanged(absl::optional<rtc::NetworkRoute>());
   }
@@ -108,6 +114,7 @@ void RtpTransport::SetRtcpPacketTransport(
         this, &RtpTransport::OnWritableState);
     new_packet_transport->SignalSentPacket.connect(this,
                                                    &RtpTransport::OnSentPacket);
+    new_packet_transport->SetMediaPacketSink(weak_factory_.GetWeakPtr());
     // Set the network route for the new transport.
     SignalNetworkRouteChanged(new_packet_transport->network_route());
   }
@@ -181,7 +188,8 @@ bool RtpTransport::UnregisterRtpDemuxerSink(RtpPacketSinkInterface* sink) {
 }
 
 void RtpTransport::DemuxPacket(rtc::CopyOnWriteBuffer packet,
-                               int64_t packet_time_us) {
+                               int64_t packet_time_us,
+                               rtc::EcnMarking ecn) {
   webrtc::RtpPacketReceived parsed_packet(&header_extension_map_);
   if (!parsed_packet.Parse(std::move(packet))) {
     RTC_LOG(LS_ERROR)
@@ -192,6 +200,7 @@ void RtpTransport::DemuxPacket(rtc::CopyOnWriteBuffer packet,
   if (packet_time_us != -1) {
     parsed_packet.set_arrival_time_ms((packet_time_us + 500) / 1000);
   }
+  parsed_packet.set_ecn(ecn);
   if (!rtp_demuxer_.OnRtpPacket(parsed_packet)) {
     RTC_LOG(LS_WARNING) << "Failed to demux RTP packet: "
                         << RtpDemuxer::DescribePacket(parsed_packet);
@@ -229,8 +238,9 @@ void RtpTransport::OnSentPacket(rtc::PacketTransportInternal* packet_transport,
 }
 
 void RtpTransport::OnRtpPacketReceived(rtc::CopyOnWriteBuffer packet,
-                                       int64_t packet_time_us) {
-  DemuxPacket(packet, packet_time_us);
+                                       int64_t packet_time_us,
+                                       rtc::EcnMarking ecn) {
+  DemuxPacket(packet, packet_time_us, ecn);
 }
 
 void RtpTransport::OnRtcpPacketReceived(rtc::CopyOnWriteBuffer packet,
@@ -244,10 +254,23 @@ void RtpTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
                                 const int64_t& packet_time_us,
                                 int flags) {
   TRACE_EVENT0("webrtc", "RtpTransport::OnReadPacket");
+  OnReceivedPacket(rtc::CopyOnWriteBuffer(data, len), packet_time_us,
+                   cricket::EcnFromPacketFlags(flags));
+}
+
+void RtpTransport::OnMediaPacket(rtc::CopyOnWriteBuffer packet,
+                                 int64_t packet_time_us,
+                                 rtc::EcnMarking ecn) {
+  TRACE_EVENT0("webrtc", "RtpTransport::OnMediaPacket");
+  OnReceivedPacket(std::move(packet), packet_time_us, ecn);
+}
 
+void RtpTransport::OnReceivedPacket(rtc::CopyOnWriteBuffer packet,
+                                    int64_t packet_time_us,
+                                    rtc::EcnMarking ecn) {
   // When using RTCP multiplexing we might get RTCP packets on the RTP
   // transport. We check the RTP payload type to determine if it is RTCP.
-  auto array_view = rtc::MakeArrayView(data, len);
+  auto array_view = rtc::MakeArrayView(packet.cdata<char>(), packet.size());
   cricket::RtpPacketType packet_type = cricket::InferRtpPacketType(array_view);
   // Filter out the packet that is neither RTP nor RTCP.
   if (packet_type == cricket::RtpPacketType::kUnknown) {
@@ -255,18 +278,17 @@ void RtpTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
   }
 
   // Protect ourselves against crazy data.
-  if (!cricket::IsValidRtpPacketSize(packet_type, len)) {
+  if (!cricket::IsValidRtpPacketSize(packet_type, packet.size())) {
     RTC_LOG(LS_ERROR) << "Dropping incoming "
                       << cricket::RtpPacketTypeToString(packet_type)
-                      << " packet: wrong size=" << len;
+                      << " packet: wrong size=" << packet.size();
     return;
   }
 
-  rtc::CopyOnWriteBuffer packet(data, len);
   if (packet_type == cricket::RtpPacketType::kRtcp) {
     OnRtcpPacketReceived(std::move(packet), packet_time_us);
   } else {
-    OnRtpPacketReceived(std::move(packet), packet_time_us);
+    OnRtpPacketReceived(std::move(packet), packet_time_us, ecn);
   }
 }
 
@@ -15,8 +15,11 @@
 
 #include "call/rtp_demuxer.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "p2p/base/media_packet_sink_interface.h"
 #include "pc/rtp_transport_internal.h"
+#include "rtc_base/network/ecn_marking.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/weak_ptr.h"
 
 namespace rtc {
 
@@ -28,7 +31,8 @@ class PacketTransportInternal;
 
 namespace webrtc {
 
-class RtpTransport : public RtpTransportInternal {
+class RtpTransport : public RtpTransportInternal,
+                     public rtc::MediaPacketSinkInterface {
  public:
   RtpTransport(const RtpTransport&) = delete;
   RtpTransport& operator=(const RtpTransport&) = delete;
@@ -76,9 +80,17 @@ class RtpTransport : public RtpTransportInternal {
 
   bool UnregisterRtpDemuxerSink(RtpPacketSinkInterface* sink) override;
 
+  // Receives the media packets of the packet transports, which deliver them
+  // directly rather than through SignalReadPacket once they can.
+  void OnMediaPacket(rtc::CopyOnWriteBuffer packet,
+                     int64_t packet_time_us,
+                     rtc::EcnMarking ecn) override;
+
  protected:
   // These methods will be used in the subclasses.
-  void DemuxPacket(rtc::CopyOnWriteBuffer packet, int64_t packet_time_us);
+  void DemuxPacket(rtc::CopyOnWriteBuffer packet,
+                   int64_t packet_time_us,
+                   rtc::EcnMarking ecn);
 
   bool SendPacket(bool rtcp,
                   rtc::CopyOnWriteBuffer* packet,
@@ -89,7 +101,8 @@ class RtpTransport : public RtpTransportInternal {
   virtual void OnNetworkRouteChanged(
       absl::optional<rtc::NetworkRoute> network_route);
   virtual void OnRtpPacketReceived(rtc::CopyOnWriteBuffer packet,
-                                   int64_t packet_time_us);
+                                   int64_t packet_time_us,
+                                   rtc::EcnMarking ecn);
   virtual void OnRtcpPacketReceived(rtc::CopyOnWriteBuffer packet,
                                     int64_t packet_time_us);
   // Overridden by SrtpTransport and DtlsSrtpTransport.
@@ -104,6 +117,11 @@ class RtpTransport : public RtpTransportInternal {
                     size_t len,
                     const int64_t& packet_time_us,
                     int flags);
+  // Hands a packet received by either path to OnRtpPacketReceived or
+  // OnRtcpPacketReceived, after checking that it is a valid one.
+  void OnReceivedPacket(rtc::CopyOnWriteBuffer packet,
+                        int64_t packet_time_us,
+                        rtc::EcnMarking ecn);
 
   // Updates "ready to send" for an individual channel and fires
   // SignalReadyToSend.
@@ -126,6 +144,10 @@ class RtpTransport : public RtpTransportInternal {
 
   // Used for identifying the MID for RtpDemuxer.
   RtpHeaderExtensionMap header_extension_map_;
+
+  // Must be the last member, so that the packet transports stop delivering
+  // media packets before any other member is destroyed.
+  rtc::WeakPtrFactory<RtpTransport> weak_factory_{this};
 };
 
 }  // namespace webrtc
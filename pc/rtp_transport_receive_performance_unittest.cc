@@ -0,0 +1,238 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/crypto/crypto_options.h"
+#include "call/rtp_packet_sink_interface.h"
+#include "p2p/base/dtls_transport.h"
+#include "p2p/base/fake_port_allocator.h"
+#include "p2p/base/p2p_transport_channel.h"
+#include "pc/rtp_transport.h"
+#include "rtc_base/byte_order.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/event.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
+#include "rtc_base/weak_ptr.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumRuns = 5;
+constexpr int kNumPackets = 20000;
+// Small enough for a batch to fit in the receive buffer of the socket.
+constexpr int kBatchSize = 50;
+constexpr size_t kPacketSize = 1200;
+constexpr uint32_t kSsrc = 0x12345678;
+constexpr int kTimeoutMs = 10000;
+
+const cricket::IceParameters kIceParams[2] = {
+    {"UF00", "TESTICEPWD00000000000000", false},
+    {"UF01", "TESTICEPWD00000000000001", false}};
+
+// Counts the RTP packets demuxed by the RtpTransport.
+class CountingRtpSink : public RtpPacketSinkInterface {
+ public:
+  void OnRtpPacket(const RtpPacketReceived& packet) override {
+    if (++num_packets_ >= target_) {
+      event_.Set();
+    }
+  }
+
+  // Waits until |target| packets have been received in total.
+  bool WaitFor(int target) {
+    target_ = target;
+    while (num_packets_ < target) {
+      if (!event_.Wait(kTimeoutMs)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  std::atomic<int> num_packets_{0};
+  std::atomic<int> target_{0};
+  rtc::Event event_;
+};
+
+// One end of a loopback call: ICE over UDP sockets on the loopback interface,
+// DTLS in pass-through mode and an RtpTransport, on its own network thread.
+class LoopbackEndpoint : public sigslot::has_slots<> {
+ public:
+  LoopbackEndpoint(const std::string& name, int index)
+      : network_thread_(rtc::Thread::CreateWithSocketServer()) {
+    network_thread_->SetName(name, nullptr);
+    network_thread_->Start();
+    network_thread_->Invoke<void>(RTC_FROM_HERE, [&] {
+      allocator_ = std::make_unique<cricket::FakePortAllocator>(
+          network_thread_.get(), nullptr);
+      ice_ = std::make_unique<cricket::P2PTransportChannel>(name, 1,
+                                                            allocator_.get());
+      ice_->SetIceRole(index == 0 ? cricket::ICEROLE_CONTROLLING
+                                  : cricket::ICEROLE_CONTROLLED);
+      ice_->SetIceTiebreaker(index + 1);
+      ice_->SetIceParameters(kIceParams[index]);
+      ice_->SetRemoteIceParameters(kIceParams[1 - index]);
+      ice_->SignalCandidateGathered.connect(
+          this, &LoopbackEndpoint::OnCandidateGathered);
+      dtls_ = std::make_unique<cricket::DtlsTransport>(
+          ice_.get(), CryptoOptions(), /*event_log=*/nullptr);
+      rtp_transport_ = std::make_unique<RtpTransport>(/*rtcp_mux=*/true);
+      rtp_transport_->SetRtpPacketTransport(dtls_.get());
+      RtpDemuxerCriteria criteria;
+      criteria.ssrcs.insert(kSsrc);
+      rtp_transport_->RegisterRtpDemuxerSink(criteria, &rtp_sink_);
+      ice_->MaybeStartGathering();
+    });
+  }
+
+  ~LoopbackEndpoint() override {
+    network_thread_->Invoke<void>(RTC_FROM_HERE, [&] {
+      rtp_transport_->UnregisterRtpDemuxerSink(&rtp_sink_);
+      rtp_transport_.reset();
+      dtls_.reset();
+      ice_.reset();
+      allocator_.reset();
+    });
+  }
+
+  bool WaitForCandidates() {
+    const int64_t start_ms = rtc::TimeMillis();
+    while (rtc::TimeMillis() - start_ms < kTimeoutMs) {
+      if (network_thread_->Invoke<bool>(
+              RTC_FROM_HERE, [&] { return !candidates_.empty(); })) {
+        return true;
+      }
+      rtc::Thread::SleepMs(1);
+    }
+    return false;
+  }
+
+  void ConnectTo(LoopbackEndpoint* peer) {
+    std::vector<cricket::Candidate> candidates = network_thread_->Invoke<
+        std::vector<cricket::Candidate>>(RTC_FROM_HERE,
+                                         [&] { return candidates_; });
+    peer->network_thread_->Invoke<void>(RTC_FROM_HERE, [&] {
+      for (const cricket::Candidate& candidate : candidates) {
+        peer->ice_->AddRemoteCandidate(candidate);
+      }
+    });
+  }
+
+  bool WaitForSelectedConnection() {
+    const int64_t start_ms = rtc::TimeMillis();
+    while (rtc::TimeMillis() - start_ms < kTimeoutMs) {
+      if (network_thread_->Invoke<bool>(RTC_FROM_HERE, [&] {
+            return ice_->selected_connection() != nullptr && dtls_->writable();
+          })) {
+        return true;
+      }
+      rtc::Thread::SleepMs(1);
+    }
+    return false;
+  }
+
+  // Makes the packets go through the SignalReadPacket chain.
+  void DisableMediaPacketSink() {
+    network_thread_->Invoke<void>(RTC_FROM_HERE, [&] {
+      dtls_->SetMediaPacketSink(rtc::WeakPtr<rtc::MediaPacketSinkInterface>());
+    });
+  }
+
+  void SendPackets(int first_sequence_number, int count) {
+    network_thread_->Invoke<void>(RTC_FROM_HERE, [&] {
+      char packet[kPacketSize] = {};
+      packet[0] = static_cast<char>(0x80);
+      packet[1] = 96;
+      rtc::SetBE32(&packet[8], kSsrc);
+      for (int i = 0; i < count; ++i) {
+        const int sequence_number = first_sequence_number + i;
+        rtc::SetBE16(&packet[2], static_cast<uint16_t>(sequence_number));
+        rtc::SetBE32(&packet[4], static_cast<uint32_t>(sequence_number * 90));
+        dtls_->SendPacket(packet, kPacketSize, rtc::PacketOptions(), 0);
+      }
+    });
+  }
+
+  int64_t GetThreadCpuTimeNanos() {
+    return network_thread_->Invoke<int64_t>(
+        RTC_FROM_HERE, [] { return rtc::GetThreadCpuTimeNanos(); });
+  }
+
+  CountingRtpSink* rtp_sink() { return &rtp_sink_; }
+
+ private:
+  void OnCandidateGathered(cricket::IceTransportInternal* transport,
+                           const cricket::Candidate& candidate) {
+    candidates_.push_back(candidate);
+  }
+
+  const std::unique_ptr<rtc::Thread> network_thread_;
+  std::unique_ptr<cricket::FakePortAllocator> allocator_;
+  std::unique_ptr<cricket::P2PTransportChannel> ice_;
+  std::unique_ptr<cricket::DtlsTransport> dtls_;
+  std::unique_ptr<RtpTransport> rtp_transport_;
+  std::vector<cricket::Candidate> candidates_;
+  CountingRtpSink rtp_sink_;
+};
+
+// Returns the CPU time, in microseconds, that the network thread of the
+// receiver spends per RTP packet, from the socket to the RtpDemuxer.
+double ReceiveCpuTimePerPacketUs(bool use_media_packet_sink) {
+  LoopbackEndpoint sender("sender", 0);
+  LoopbackEndpoint receiver("receiver", 1);
+  EXPECT_TRUE(sender.WaitForCandidates());
+  EXPECT_TRUE(receiver.WaitForCandidates());
+  sender.ConnectTo(&receiver);
+  receiver.ConnectTo(&sender);
+  EXPECT_TRUE(sender.WaitForSelectedConnection());
+  EXPECT_TRUE(receiver.WaitForSelectedConnection());
+  if (!use_media_packet_sink) {
+    receiver.DisableMediaPacketSink();
+  }
+
+  const int64_t start_cpu_time_nanos = receiver.GetThreadCpuTimeNanos();
+  for (int sent = 0; sent < kNumPackets; sent += kBatchSize) {
+    sender.SendPackets(sent, kBatchSize);
+    if (!receiver.rtp_sink()->WaitFor(sent + kBatchSize)) {
+      ADD_FAILURE() << "Timed out waiting for packet " << sent + kBatchSize;
+      return 0.0;
+    }
+  }
+  return (receiver.GetThreadCpuTimeNanos() - start_cpu_time_nanos) /
+         static_cast<double>(rtc::kNumNanosecsPerMicrosec * kNumPackets);
+}
+
+}  // namespace
+
+TEST(RtpTransportReceivePerformanceTest, LoopbackCall) {
+  std::vector<double> signal_chain_us;
+  std::vector<double> media_packet_sink_us;
+  // The runs alternate, so that both paths see the same system noise.
+  for (int i = 0; i < kNumRuns; ++i) {
+    signal_chain_us.push_back(ReceiveCpuTimePerPacketUs(false));
+    media_packet_sink_us.push_back(ReceiveCpuTimePerPacketUs(true));
+  }
+  webrtc::test::PrintResultList("rtp_receive_cpu_time", "_loopback",
+                                "signal_chain", signal_chain_us, "us", false);
+  webrtc::test::PrintResultList("rtp_receive_cpu_time", "_loopback",
+                                "media_packet_sink", media_packet_sink_us,
+                                "us", false);
+}
+
+}  // namespace webrtc
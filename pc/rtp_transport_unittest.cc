@@ -18,9 +18,11 @@
 #include "api/rtp_headers.h"
 #include "api/rtp_parameters.h"
 #include "p2p/base/fake_packet_transport.h"
+#include "p2p/base/media_packet_sink_interface.h"
 #include "pc/test/rtp_transport_test_util.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/weak_ptr.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -322,4 +324,53 @@ TEST(RtpTransportTest, DontSignalUnhandledRtpPayloadType) {
   transport.UnregisterRtpDemuxerSink(&observer);
 }
 
+// A packet transport that keeps the media packet sink that it is given.
+class MediaPacketSinkTransport : public rtc::FakePacketTransport {
+ public:
+  using rtc::FakePacketTransport::FakePacketTransport;
+
+  void SetMediaPacketSink(
+      rtc::WeakPtr<rtc::MediaPacketSinkInterface> sink) override {
+    sink_ = std::move(sink);
+  }
+
+  rtc::MediaPacketSinkInterface* sink() { return sink_.get(); }
+
+ private:
+  rtc::WeakPtr<rtc::MediaPacketSinkInterface> sink_;
+};
+
+// Test that the RtpTransport is the media packet sink of its packet transport
+// for as long as it uses it, and that it demuxes the packets handed to it.
+TEST(RtpTransportTest, DemuxesPacketsFromMediaPacketSink) {
+  MediaPacketSinkTransport fake_rtp("fake_rtp");
+  {
+    RtpTransport transport(kMuxEnabled);
+    transport.SetRtpPacketTransport(&fake_rtp);
+    ASSERT_EQ(static_cast<rtc::MediaPacketSinkInterface*>(&transport),
+              fake_rtp.sink());
+    TransportObserver observer(&transport);
+    RtpDemuxerCriteria demuxer_criteria;
+    demuxer_criteria.payload_types = {0x11};
+    transport.RegisterRtpDemuxerSink(demuxer_criteria, &observer);
+
+    fake_rtp.sink()->OnMediaPacket(rtc::CopyOnWriteBuffer(kRtpData, kRtpLen),
+                                   /*packet_time_us=*/-1,
+                                   rtc::EcnMarking::kNotEct);
+    const unsigned char kRtcpData[] = {0x80, 73, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    fake_rtp.sink()->OnMediaPacket(
+        rtc::CopyOnWriteBuffer(kRtcpData, sizeof(kRtcpData)),
+        /*packet_time_us=*/-1, rtc::EcnMarking::kNotEct);
+    EXPECT_EQ(1, observer.rtp_count());
+    EXPECT_EQ(1, observer.rtcp_count());
+    transport.UnregisterRtpDemuxerSink(&observer);
+
+    transport.SetRtpPacketTransport(nullptr);
+    EXPECT_EQ(nullptr, fake_rtp.sink());
+    transport.SetRtpPacketTransport(&fake_rtp);
+    EXPECT_NE(nullptr, fake_rtp.sink());
+  }
+  EXPECT_EQ(nullptr, fake_rtp.sink());
+}
+
 }  // namespace webrtc
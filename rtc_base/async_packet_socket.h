@@ -15,6 +15,7 @@
 
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/dscp.h"
+#include "rtc_base/network/ecn_marking.h"
 #include "rtc_base/network/sent_packet.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/system/rtc_export.h"
@@ -98,6 +99,11 @@ class RTC_EXPORT AsyncPacketSocket : public sigslot::has_slots<> {
   virtual int GetError() const = 0;
   virtual void SetError(int error) = 0;
 
+  // Returns the ECN codepoint of the packet being signaled by
+  // SignalReadPacket. Only valid from within the handlers of that signal, and
+  // only reported once Socket::OPT_RECV_ECN is enabled.
+  virtual EcnMarking GetLastReceivedEcn() const { return EcnMarking::kNotEct; }
+
   // Emitted each time a packet is read. Used only for UDP and
   // connected TCP sockets.
   sigslot::signal5<AsyncPacketSocket*,
@@ -75,6 +75,10 @@ int AsyncSocketAdapter::RecvFrom(void* pv,
   return socket_->RecvFrom(pv, cb, paddr, timestamp);
 }
 
+EcnMarking AsyncSocketAdapter::GetLastReceivedEcn() const {
+  return socket_->GetLastReceivedEcn();
+}
+
 int AsyncSocketAdapter::Listen(int backlog) {
   return socket_->Listen(backlog);
 }
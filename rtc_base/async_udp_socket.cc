@@ -111,6 +111,10 @@ void AsyncUDPSocket::SetError(int error) {
   return socket_->SetError(error);
 }
 
+EcnMarking AsyncUDPSocket::GetLastReceivedEcn() const {
+  return socket_->GetLastReceivedEcn();
+}
+
 void AsyncUDPSocket::OnReadEvent(AsyncSocket* socket) {
   RTC_DCHECK(socket_.get() == socket);
 
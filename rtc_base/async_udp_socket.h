@@ -55,6 +55,7 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   int SetOption(Socket::Option opt, int value) override;
   int GetError() const override;
   void SetError(int error) override;
+  EcnMarking GetLastReceivedEcn() const override;
 
  private:
   // Called when the underlying socket is ready to be read from.
@@ -0,0 +1,52 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/deferred_log_processor.h"
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace rtc {
+
+constexpr int DeferredLogProcessor::kDefaultProcessIntervalMs;
+
+DeferredLogProcessor::DeferredLogProcessor(int process_interval_ms)
+    : process_interval_ms_(process_interval_ms),
+      process_thread_(&ProcessThreadFunc,
+                      this,
+                      "DeferredLogProcessor",
+                      kLowPriority) {
+  RTC_DCHECK_GT(process_interval_ms_, 0);
+  RTC_DCHECK(!LogMessage::IsDeferredLogging());
+  process_thread_.Start();
+  LogMessage::SetDeferredLogging(true);
+}
+
+DeferredLogProcessor::~DeferredLogProcessor() {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  LogMessage::SetDeferredLogging(false);
+  stop_event_.Set();
+  process_thread_.Stop();
+  // Output what was logged after the last round of the process thread.
+  LogMessage::ProcessDeferredLogs();
+}
+
+// static
+void DeferredLogProcessor::ProcessThreadFunc(void* obj) {
+  static_cast<DeferredLogProcessor*>(obj)->Process();
+}
+
+void DeferredLogProcessor::Process() {
+  while (!stop_event_.Wait(process_interval_ms_)) {
+    LogMessage::ProcessDeferredLogs();
+  }
+}
+
+}  // namespace rtc
@@ -0,0 +1,48 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_DEFERRED_LOG_PROCESSOR_H_
+#define RTC_BASE_DEFERRED_LOG_PROCESSOR_H_
+
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_checker.h"
+
+namespace rtc {
+
+// Enables deferred logging (see LogMessage::SetDeferredLogging()) for its
+// lifetime, and formats and outputs the deferred log messages on a low
+// priority background thread. Messages still pending when the processor is
+// destroyed are output by the destructor. At most one instance should exist at
+// a time.
+class DeferredLogProcessor {
+ public:
+  static constexpr int kDefaultProcessIntervalMs = 10;
+
+  explicit DeferredLogProcessor(
+      int process_interval_ms = kDefaultProcessIntervalMs);
+  ~DeferredLogProcessor();
+
+  DeferredLogProcessor(const DeferredLogProcessor&) = delete;
+  DeferredLogProcessor& operator=(const DeferredLogProcessor&) = delete;
+
+ private:
+  static void ProcessThreadFunc(void* obj);
+  void Process();
+
+  const int process_interval_ms_;
+  ThreadChecker thread_checker_;
+  Event stop_event_;
+  PlatformThread process_thread_;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_DEFERRED_LOG_PROCESSOR_H_
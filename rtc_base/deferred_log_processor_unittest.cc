@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/deferred_log_processor.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/base/config.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
+#include "test/gtest.h"
+
+#if RTC_LOG_ENABLED() && defined(ABSL_HAVE_THREAD_LOCAL)
+namespace rtc {
+namespace {
+
+constexpr int kNumThreads = 4;
+constexpr int kMessagesPerThread = 100;
+
+class StringSink : public LogSink {
+ public:
+  void OnLogMessage(const std::string& message) override {
+    CritScope lock(&crit_);
+    log_ += message;
+  }
+
+  std::string log() const {
+    CritScope lock(&crit_);
+    return log_;
+  }
+
+ private:
+  CriticalSection crit_;
+  std::string log_ RTC_GUARDED_BY(crit_);
+};
+
+void LogMessages(void* obj) {
+  const int thread_index = *static_cast<int*>(obj);
+  for (int i = 0; i < kMessagesPerThread; ++i) {
+    RTC_LOG(LS_INFO) << "<" << thread_index << ":" << i << ">";
+  }
+}
+
+}  // namespace
+
+TEST(DeferredLogProcessorTest, EnablesDeferredLoggingForItsLifetime) {
+  EXPECT_FALSE(LogMessage::IsDeferredLogging());
+  {
+    DeferredLogProcessor processor;
+    EXPECT_TRUE(LogMessage::IsDeferredLogging());
+  }
+  EXPECT_FALSE(LogMessage::IsDeferredLogging());
+}
+
+TEST(DeferredLogProcessorTest, OutputsMessagesFromAllThreads) {
+  StringSink sink;
+  LogMessage::AddLogToStream(&sink, LS_INFO);
+  {
+    DeferredLogProcessor processor(/*process_interval_ms=*/1);
+    std::vector<int> thread_indices(kNumThreads);
+    std::vector<std::unique_ptr<PlatformThread>> threads;
+    for (int i = 0; i < kNumThreads; ++i) {
+      thread_indices[i] = i;
+      threads.push_back(std::make_unique<PlatformThread>(
+          &LogMessages, &thread_indices[i], "DeferredLogTest"));
+      threads.back()->Start();
+    }
+    for (auto& thread : threads)
+      thread->Stop();
+  }
+  LogMessage::RemoveLogToStream(&sink);
+
+  const std::string log = sink.log();
+  for (int thread_index = 0; thread_index < kNumThreads; ++thread_index) {
+    for (int i = 0; i < kMessagesPerThread; ++i) {
+      EXPECT_NE(std::string::npos,
+                log.find("<" + std::to_string(thread_index) + ":" +
+                         std::to_string(i) + ">"));
+    }
+  }
+}
+
+}  // namespace rtc
+#endif  // RTC_LOG_ENABLED() && defined(ABSL_HAVE_THREAD_LOCAL)
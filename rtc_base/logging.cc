@@ -37,10 +37,12 @@ static const int kMaxLogLineSize = 1024 - 60;
 #include <time.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cstdarg>
 #include <vector>
 
 #include "absl/base/attributes.h"
+#include "absl/base/config.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/platform_thread_types.h"
@@ -73,6 +75,152 @@ const char* FilenameFromPath(const char* file) {
 
 // Global lock for log subsystem, only needed to serialize access to streams_.
 CriticalSection g_log_crit;
+
+std::atomic<bool> g_deferred_logging{false};
+
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+// Size of the deferred log record buffer of each logging thread.
+constexpr size_t kDeferredLogBufferSize = 1 << 16;
+
+// Single producer, single consumer ring of deferred log records. Each record is
+// its size as a uint32_t followed by the encoded log call, see
+// webrtc_logging_impl::Log(). Records may wrap around the end of the buffer.
+class DeferredLogBuffer {
+ public:
+  explicit DeferredLogBuffer(PlatformThreadId owner) : owner_(owner) {}
+
+  PlatformThreadId owner() const { return owner_; }
+  DeferredLogBuffer* next() const { return next_; }
+  void set_next(DeferredLogBuffer* next) { next_ = next; }
+
+  // Called on the owning thread.
+  void BeginRecord() {
+    record_pos_ = write_pos_.load(std::memory_order_relaxed);
+    pending_pos_ = record_pos_ + sizeof(uint32_t);
+    overflow_ = false;
+  }
+  void Append(const void* data, size_t size) {
+    if (overflow_ ||
+        pending_pos_ + size - read_pos_.load(std::memory_order_acquire) >
+            kDeferredLogBufferSize) {
+      overflow_ = true;
+      return;
+    }
+    CopyIn(pending_pos_, data, size);
+    pending_pos_ += size;
+  }
+  // Returns false if the record did not fit and has been discarded.
+  bool CommitRecord() {
+    if (overflow_)
+      return false;
+    const uint32_t size =
+        static_cast<uint32_t>(pending_pos_ - record_pos_ - sizeof(uint32_t));
+    CopyIn(record_pos_, &size, sizeof(size));
+    write_pos_.store(pending_pos_, std::memory_order_release);
+    return true;
+  }
+
+  // Called on the thread processing the deferred logs. Returns false if there
+  // is no complete record.
+  bool ReadRecord(std::vector<char>* record) {
+    const uint64_t read_pos = read_pos_.load(std::memory_order_relaxed);
+    if (read_pos == write_pos_.load(std::memory_order_acquire))
+      return false;
+    uint32_t size;
+    CopyOut(read_pos, &size, sizeof(size));
+    record->resize(size);
+    CopyOut(read_pos + sizeof(size), record->data(), size);
+    read_pos_.store(read_pos + sizeof(size) + size, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  void CopyIn(uint64_t pos, const void* data, size_t size) {
+    const size_t offset = pos % kDeferredLogBufferSize;
+    const size_t first = std::min(size, kDeferredLogBufferSize - offset);
+    memcpy(&buffer_[offset], data, first);
+    memcpy(&buffer_[0], static_cast<const char*>(data) + first, size - first);
+  }
+  void CopyOut(uint64_t pos, void* data, size_t size) const {
+    const size_t offset = pos % kDeferredLogBufferSize;
+    const size_t first = std::min(size, kDeferredLogBufferSize - offset);
+    memcpy(data, &buffer_[offset], first);
+    memcpy(static_cast<char*>(data) + first, &buffer_[0], size - first);
+  }
+
+  const PlatformThreadId owner_;
+  DeferredLogBuffer* next_ = nullptr;
+
+  // Positions are byte counts since the creation of the buffer.
+  std::atomic<uint64_t> write_pos_{0};
+  std::atomic<uint64_t> read_pos_{0};
+
+  // Owning thread only.
+  uint64_t record_pos_ = 0;
+  uint64_t pending_pos_ = 0;
+  bool overflow_ = false;
+
+  char buffer_[kDeferredLogBufferSize];
+};
+
+// All buffers ever created. Buffers are never deleted; a thread reuses the
+// buffer of an exited thread that had the same thread id.
+std::atomic<DeferredLogBuffer*> g_deferred_log_buffers{nullptr};
+std::atomic<int> g_dropped_deferred_logs{0};
+ABSL_CONST_INIT thread_local DeferredLogBuffer* g_thread_log_buffer = nullptr;
+
+// Serializes ProcessDeferredLogs(), the single consumer of all buffers.
+CriticalSection g_deferred_log_crit;
+
+DeferredLogBuffer* GetThreadLogBuffer() {
+  if (g_thread_log_buffer)
+    return g_thread_log_buffer;
+  const PlatformThreadId id = CurrentThreadId();
+  DeferredLogBuffer* head =
+      g_deferred_log_buffers.load(std::memory_order_acquire);
+  for (DeferredLogBuffer* buffer = head; buffer; buffer = buffer->next()) {
+    if (buffer->owner() == id) {
+      g_thread_log_buffer = buffer;
+      return buffer;
+    }
+  }
+  DeferredLogBuffer* buffer = new DeferredLogBuffer(id);
+  do {
+    buffer->set_next(head);
+  } while (!g_deferred_log_buffers.compare_exchange_weak(
+      head, buffer, std::memory_order_release, std::memory_order_acquire));
+  g_thread_log_buffer = buffer;
+  return buffer;
+}
+
+// Reads the encoding of a deferred log call.
+class DeferredLogReader {
+ public:
+  explicit DeferredLogReader(const std::vector<char>& record)
+      : pos_(record.data()), end_(record.data() + record.size()) {}
+
+  template <typename T>
+  T Read() {
+    T value;
+    RTC_DCHECK_LE(sizeof(T), static_cast<size_t>(end_ - pos_));
+    memcpy(&value, pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return value;
+  }
+  absl::string_view ReadString() {
+    const uint32_t size = Read<uint32_t>();
+    RTC_DCHECK_LE(size, static_cast<size_t>(end_ - pos_));
+    absl::string_view str(pos_, size);
+    pos_ += size;
+    return str;
+  }
+  bool AtEnd() const { return pos_ == end_; }
+
+ private:
+  const char* pos_;
+  const char* const end_;
+};
+#endif  // defined(ABSL_HAVE_THREAD_LOCAL)
 }  // namespace
 
 /////////////////////////////////////////////////////////////////////////////
@@ -99,11 +247,26 @@ LogMessage::LogMessage(const char* file,
                        LoggingSeverity sev,
                        LogErrorContext err_ctx,
                        int err)
-    : severity_(sev) {
-  if (timestamp_) {
     // Use SystemTimeMillis so that even if tests use fake clocks, the timestamp
     // in log messages represents the real system time.
-    int64_t time = TimeDiff(SystemTimeMillis(), LogStartTime());
+    : LogMessage(file,
+                 line,
+                 sev,
+                 err_ctx,
+                 err,
+                 timestamp_ ? SystemTimeMillis() : 0,
+                 thread_ ? CurrentThreadId() : 0) {}
+
+LogMessage::LogMessage(const char* file,
+                       int line,
+                       LoggingSeverity sev,
+                       LogErrorContext err_ctx,
+                       int err,
+                       int64_t log_time_ms,
+                       PlatformThreadId thread_id)
+    : severity_(sev) {
+  if (timestamp_) {
+    int64_t time = TimeDiff(log_time_ms, LogStartTime());
     // Also ensure WallClockStartTime is initialized, so that it matches
     // LogStartTime.
     WallClockStartTime();
@@ -113,8 +276,7 @@ LogMessage::LogMessage(const char* file,
   }
 
   if (thread_) {
-    PlatformThreadId id = CurrentThreadId();
-    print_stream_ << "[" << id << "] ";
+    print_stream_ << "[" << thread_id << "] ";
   }
 
   if (file != nullptr) {
@@ -433,14 +595,100 @@ void LogMessage::OutputToDebug(const std::string& str,
 
 // static
 bool LogMessage::IsNoop(LoggingSeverity severity) {
-  if (severity >= g_dbg_sev || severity >= g_min_sev)
-    return false;
+  // |g_min_sev| is the lowest severity accepted by the debug output or any of
+  // the streams, so this does not need to grab |g_log_crit|.
+  return severity < g_min_sev;
+}
 
-  // TODO(tommi): We're grabbing this lock for every LogMessage instance that
-  // is going to be logged. This introduces unnecessary synchronization for
-  // a feature that's mostly used for testing.
-  CritScope cs(&g_log_crit);
-  return streams_ == nullptr;
+// static
+void LogMessage::SetDeferredLogging(bool enabled) {
+  g_deferred_logging.store(enabled, std::memory_order_relaxed);
+}
+
+// static
+bool LogMessage::IsDeferredLogging() {
+  return g_deferred_logging.load(std::memory_order_relaxed);
+}
+
+// static
+int LogMessage::ProcessDeferredLogs() {
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+  using webrtc_logging_impl::LogArgType;
+  using webrtc_logging_impl::LogMetadataErr;
+
+  CritScope cs(&g_deferred_log_crit);
+  int num_messages = 0;
+  std::vector<char> record;
+  for (DeferredLogBuffer* buffer =
+           g_deferred_log_buffers.load(std::memory_order_acquire);
+       buffer; buffer = buffer->next()) {
+    while (buffer->ReadRecord(&record)) {
+      DeferredLogReader reader(record);
+      const LogMetadataErr meta = reader.Read<LogMetadataErr>();
+      const bool has_tag = reader.Read<bool>();
+      // Declared before |log_message|, which may refer to it until output.
+      std::string tag;
+      if (has_tag) {
+        tag = std::string(reader.ReadString());
+      }
+      const int64_t log_time_ms = reader.Read<int64_t>();
+      const PlatformThreadId thread_id = reader.Read<PlatformThreadId>();
+      LogMessage log_message(meta.meta.File(), meta.meta.Line(),
+                             meta.meta.Severity(), meta.err_ctx, meta.err,
+                             log_time_ms, thread_id);
+      if (has_tag) {
+        log_message.AddTag(tag.c_str());
+      }
+      while (!reader.AtEnd()) {
+        switch (reader.Read<LogArgType>()) {
+          case LogArgType::kInt:
+            log_message.stream() << reader.Read<int>();
+            break;
+          case LogArgType::kLong:
+            log_message.stream() << reader.Read<long>();
+            break;
+          case LogArgType::kLongLong:
+            log_message.stream() << reader.Read<long long>();
+            break;
+          case LogArgType::kUInt:
+            log_message.stream() << reader.Read<unsigned>();
+            break;
+          case LogArgType::kULong:
+            log_message.stream() << reader.Read<unsigned long>();
+            break;
+          case LogArgType::kULongLong:
+            log_message.stream() << reader.Read<unsigned long long>();
+            break;
+          case LogArgType::kDouble:
+            log_message.stream() << reader.Read<double>();
+            break;
+          case LogArgType::kLongDouble:
+            log_message.stream() << reader.Read<long double>();
+            break;
+          case LogArgType::kStringView:
+            log_message.stream() << reader.ReadString();
+            break;
+          case LogArgType::kVoidP:
+            log_message.stream() << rtc::ToHex(reader.Read<uintptr_t>());
+            break;
+          default:
+            RTC_NOTREACHED();
+            break;
+        }
+      }
+      ++num_messages;
+    }
+  }
+
+  const int dropped = g_dropped_deferred_logs.exchange(0);
+  if (dropped > 0) {
+    LogMessage(__FILE__, __LINE__, LS_WARNING).stream()
+        << dropped << " deferred log messages were dropped.";
+  }
+  return num_messages;
+#else
+  return 0;
+#endif  // defined(ABSL_HAVE_THREAD_LOCAL)
 }
 
 void LogMessage::FinishPrintStream() {
@@ -451,6 +699,100 @@ void LogMessage::FinishPrintStream() {
 
 namespace webrtc_logging_impl {
 
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+namespace {
+
+void AppendSizedString(DeferredLogBuffer* buffer, absl::string_view str) {
+  const uint32_t size = static_cast<uint32_t>(str.size());
+  buffer->Append(&size, sizeof(size));
+  buffer->Append(str.data(), size);
+}
+
+void AppendString(DeferredLogBuffer* buffer, absl::string_view str) {
+  const LogArgType type = LogArgType::kStringView;
+  buffer->Append(&type, sizeof(type));
+  AppendSizedString(buffer, str);
+}
+
+template <typename T>
+void AppendValue(DeferredLogBuffer* buffer, LogArgType type, T value) {
+  buffer->Append(&type, sizeof(type));
+  buffer->Append(&value, sizeof(value));
+}
+
+// Copies a log call into the buffer of the calling thread, to be output by
+// LogMessage::ProcessDeferredLogs(). Strings, including the tag, are copied,
+// since they may not outlive the call; all arguments are stored as
+// kStringView.
+void DeferLog(const LogMetadataErr& meta,
+              const char* tag,
+              const LogArgType* fmt,
+              va_list args) {
+  DeferredLogBuffer* buffer = GetThreadLogBuffer();
+  buffer->BeginRecord();
+  const int64_t log_time_ms = SystemTimeMillis();
+  const PlatformThreadId thread_id = buffer->owner();
+  buffer->Append(&meta, sizeof(meta));
+  const bool has_tag = tag != nullptr;
+  buffer->Append(&has_tag, sizeof(has_tag));
+  if (has_tag) {
+    AppendSizedString(buffer, tag);
+  }
+  buffer->Append(&log_time_ms, sizeof(log_time_ms));
+  buffer->Append(&thread_id, sizeof(thread_id));
+  for (; *fmt != LogArgType::kEnd; ++fmt) {
+    switch (*fmt) {
+      case LogArgType::kInt:
+        AppendValue(buffer, *fmt, va_arg(args, int));
+        break;
+      case LogArgType::kLong:
+        AppendValue(buffer, *fmt, va_arg(args, long));
+        break;
+      case LogArgType::kLongLong:
+        AppendValue(buffer, *fmt, va_arg(args, long long));
+        break;
+      case LogArgType::kUInt:
+        AppendValue(buffer, *fmt, va_arg(args, unsigned));
+        break;
+      case LogArgType::kULong:
+        AppendValue(buffer, *fmt, va_arg(args, unsigned long));
+        break;
+      case LogArgType::kULongLong:
+        AppendValue(buffer, *fmt, va_arg(args, unsigned long long));
+        break;
+      case LogArgType::kDouble:
+        AppendValue(buffer, *fmt, va_arg(args, double));
+        break;
+      case LogArgType::kLongDouble:
+        AppendValue(buffer, *fmt, va_arg(args, long double));
+        break;
+      case LogArgType::kCharP: {
+        const char* s = va_arg(args, const char*);
+        AppendString(buffer, s ? s : "(null)");
+        break;
+      }
+      case LogArgType::kStdString:
+        AppendString(buffer, *va_arg(args, const std::string*));
+        break;
+      case LogArgType::kStringView:
+        AppendString(buffer, *va_arg(args, const absl::string_view*));
+        break;
+      case LogArgType::kVoidP:
+        AppendValue(buffer, *fmt,
+                    reinterpret_cast<uintptr_t>(va_arg(args, const void*)));
+        break;
+      default:
+        RTC_NOTREACHED();
+        return;
+    }
+  }
+  if (!buffer->CommitRecord())
+    g_dropped_deferred_logs.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace
+#endif  // defined(ABSL_HAVE_THREAD_LOCAL)
+
 void Log(const LogArgType* fmt, ...) {
   va_list args;
   va_start(args, fmt);
@@ -486,6 +828,14 @@ void Log(const LogArgType* fmt, ...) {
     return;
   }
 
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+  if (g_deferred_logging.load(std::memory_order_relaxed)) {
+    DeferLog(meta, tag, fmt + 1, args);
+    va_end(args);
+    return;
+  }
+#endif
+
   LogMessage log_message(meta.meta.File(), meta.meta.Line(),
                          meta.meta.Severity(), meta.err_ctx, meta.err);
   if (tag) {
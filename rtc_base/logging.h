@@ -40,6 +40,12 @@
 // RTC_LOG_CHECK_LEVEL(sev) (and RTC_LOG_CHECK_LEVEL_V(sev)) can be used as a
 //     test before performing expensive or sensitive operations whose sole
 //     purpose is to output logging data at the desired level.
+//
+// The streamed arguments of the above are only evaluated if the message will
+// be output somewhere. Statements with a severity below RTC_LOG_MIN_SEVERITY
+// (set with the rtc_log_min_severity GN arg) are removed at compile time.
+// See LogMessage::SetDeferredLogging() for moving the formatting of messages
+// off the calling thread.
 
 #ifndef RTC_BASE_LOGGING_H_
 #define RTC_BASE_LOGGING_H_
@@ -54,6 +60,7 @@
 #include "absl/strings/string_view.h"
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/deprecation.h"
+#include "rtc_base/platform_thread_types.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/system/inline.h"
 
@@ -69,6 +76,12 @@
 #define RTC_LOG_ENABLED() 1
 #endif
 
+// Minimum LoggingSeverity, as an integer, of the log statements that are
+// compiled in. Defaults to LS_VERBOSE, i.e. all statements.
+#if !defined(RTC_LOG_MIN_SEVERITY)
+#define RTC_LOG_MIN_SEVERITY 0
+#endif
+
 namespace rtc {
 
 //////////////////////////////////////////////////////////////////////
@@ -476,11 +489,28 @@ class LogMessage {
   // Parses the provided parameter stream to configure the options above.
   // Useful for configuring logging from the command line.
   static void ConfigureLogging(const char* params);
-  // Checks the current global debug severity and if the |streams_| collection
-  // is empty. If |severity| is smaller than the global severity and if the
-  // |streams_| collection is empty, the LogMessage will be considered a noop
-  // LogMessage.
+  // Returns true if |severity| is below both the debug severity and the
+  // severities of all |streams_|, i.e. if a LogMessage of that severity would
+  // not be output anywhere. Does not take any locks; the logging macros call it
+  // before evaluating their arguments.
   static bool IsNoop(LoggingSeverity severity);
+  template <LoggingSeverity S>
+  RTC_NO_INLINE static bool IsNoop() {
+    return IsNoop(S);
+  }
+  // Deferred logging. While enabled, log calls that pass the severity checks
+  // only copy their arguments into a ring buffer owned by the calling thread.
+  // Formatting and output to the debug output and the streams happen when
+  // ProcessDeferredLogs() is called, normally on the background thread of a
+  // DeferredLogProcessor. Messages from different threads may then be output
+  // out of order, and messages that do not fit in the buffer of the calling
+  // thread are dropped (and counted). Without thread local storage support
+  // messages are always output directly.
+  static void SetDeferredLogging(bool enabled);
+  static bool IsDeferredLogging();
+  // Formats and outputs all messages deferred so far, on any thread. Returns
+  // the number of messages output.
+  static int ProcessDeferredLogs();
 #else
   // Next methods do nothing; no one will call these functions.
   LogMessage(const char* file, int line, LoggingSeverity sev) {}
@@ -520,12 +550,29 @@ class LogMessage {
   inline static int GetMinLogSeverity() { return 0; }
   inline static void ConfigureLogging(const char* params) {}
   inline static bool IsNoop(LoggingSeverity severity) { return true; }
+  template <LoggingSeverity S>
+  inline static bool IsNoop() {
+    return IsNoop(S);
+  }
+  inline static void SetDeferredLogging(bool enabled) {}
+  inline static bool IsDeferredLogging() { return false; }
+  inline static int ProcessDeferredLogs() { return 0; }
 #endif  // RTC_LOG_ENABLED()
 
  private:
   friend class LogMessageForTesting;
 
 #if RTC_LOG_ENABLED()
+  // Used for deferred messages, with the time (in SystemTimeMillis()) and
+  // thread of the original log call.
+  LogMessage(const char* file,
+             int line,
+             LoggingSeverity sev,
+             LogErrorContext err_ctx,
+             int err,
+             int64_t log_time_ms,
+             PlatformThreadId thread_id);
+
   // Updates min_sev_ appropriately when debug sinks change.
   static void UpdateMinLogSeverity();
 
@@ -586,13 +633,23 @@ class LogMessage {
 // Logging Helpers
 //////////////////////////////////////////////////////////////////////
 
-#define RTC_LOG_FILE_LINE(sev, file, line)            \
-  RTC_LOG_ENABLED() &&                                \
-      ::rtc::webrtc_logging_impl::LogCall() &         \
-          ::rtc::webrtc_logging_impl::LogStreamer<>() \
-              << ::rtc::webrtc_logging_impl::LogMetadata(file, line, sev)
+// True if log statements of severity |sev| are compiled in.
+#define RTC_LOG_SEVERITY_COMPILED_IN(sev) \
+  (static_cast<int>(sev) >= RTC_LOG_MIN_SEVERITY)
+
+#define RTC_LOG_STREAM(sev, file, line)           \
+  ::rtc::webrtc_logging_impl::LogCall() &         \
+      ::rtc::webrtc_logging_impl::LogStreamer<>() \
+          << ::rtc::webrtc_logging_impl::LogMetadata(file, line, sev)
+
+#define RTC_LOG_FILE_LINE(sev, file, line)                  \
+  RTC_LOG_ENABLED() && RTC_LOG_SEVERITY_COMPILED_IN(sev) && \
+      !::rtc::LogMessage::IsNoop(sev) && RTC_LOG_STREAM(sev, file, line)
 
-#define RTC_LOG(sev) RTC_LOG_FILE_LINE(::rtc::sev, __FILE__, __LINE__)
+#define RTC_LOG(sev)                                               \
+  RTC_LOG_ENABLED() && RTC_LOG_SEVERITY_COMPILED_IN(::rtc::sev) && \
+      !::rtc::LogMessage::IsNoop<::rtc::sev>() &&                  \
+      RTC_LOG_STREAM(::rtc::sev, __FILE__, __LINE__)
 
 // The _V version is for when a variable is passed in.
 #define RTC_LOG_V(sev) RTC_LOG_FILE_LINE(sev, __FILE__, __LINE__)
@@ -614,11 +671,13 @@ inline bool LogCheckLevel(LoggingSeverity sev) {
   return (LogMessage::GetMinLogSeverity() <= sev);
 }
 
-#define RTC_LOG_E(sev, ctx, err)                                               \
-  RTC_LOG_ENABLED() && ::rtc::webrtc_logging_impl::LogCall() &                 \
-                           ::rtc::webrtc_logging_impl::LogStreamer<>()         \
-                               << ::rtc::webrtc_logging_impl::LogMetadataErr { \
-    {__FILE__, __LINE__, ::rtc::sev}, ::rtc::ERRCTX_##ctx, (err)               \
+#define RTC_LOG_E(sev, ctx, err)                                             \
+  RTC_LOG_ENABLED() && RTC_LOG_SEVERITY_COMPILED_IN(::rtc::sev) &&           \
+      !::rtc::LogMessage::IsNoop<::rtc::sev>() &&                            \
+      ::rtc::webrtc_logging_impl::LogCall() &                                \
+          ::rtc::webrtc_logging_impl::LogStreamer<>()                        \
+              << ::rtc::webrtc_logging_impl::LogMetadataErr {                \
+    {__FILE__, __LINE__, ::rtc::sev}, ::rtc::ERRCTX_##ctx, (err)             \
   }
 
 #define RTC_LOG_T(sev) RTC_LOG(sev) << this << ": "
@@ -651,11 +710,13 @@ inline const char* AdaptString(const std::string& str) {
 }
 }  // namespace webrtc_logging_impl
 
-#define RTC_LOG_TAG(sev, tag)                                                  \
-  RTC_LOG_ENABLED() && ::rtc::webrtc_logging_impl::LogCall() &                 \
-                           ::rtc::webrtc_logging_impl::LogStreamer<>()         \
-                               << ::rtc::webrtc_logging_impl::LogMetadataTag { \
-    sev, ::rtc::webrtc_logging_impl::AdaptString(tag)                          \
+#define RTC_LOG_TAG(sev, tag)                                              \
+  RTC_LOG_ENABLED() && RTC_LOG_SEVERITY_COMPILED_IN(sev) &&                \
+      !::rtc::LogMessage::IsNoop(sev) &&                                   \
+      ::rtc::webrtc_logging_impl::LogCall() &                              \
+          ::rtc::webrtc_logging_impl::LogStreamer<>()                      \
+              << ::rtc::webrtc_logging_impl::LogMetadataTag {              \
+    sev, ::rtc::webrtc_logging_impl::AdaptString(tag)                      \
   }
 
 #else
@@ -0,0 +1,110 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+
+#include "absl/base/config.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+#if RTC_LOG_ENABLED()
+namespace rtc {
+namespace {
+
+constexpr int kNumCalls = 100000;
+// Deferred messages are processed in batches that fit in the thread's buffer.
+constexpr int kDeferredBatchSize = 200;
+
+class NullLogSink : public LogSink {
+ public:
+  void OnLogMessage(const std::string& message) override {}
+};
+
+// Fixture with a sink receiving LS_INFO and above, and no debug output.
+class LoggingPerformanceTest : public ::testing::Test {
+ protected:
+  LoggingPerformanceTest()
+      : debug_severity_(LogMessage::GetLogToDebug()),
+        payload_(80, 'X') {
+    LogMessage::LogToDebug(LS_NONE);
+    LogMessage::AddLogToStream(&sink_, LS_INFO);
+  }
+  ~LoggingPerformanceTest() override {
+    LogMessage::RemoveLogToStream(&sink_);
+    LogMessage::LogToDebug(debug_severity_);
+  }
+
+  // A log call with a typical mix of arguments, e.g. the per-packet logging
+  // on the receive side.
+  void LogPacket(int i) {
+    RTC_LOG(LS_INFO) << "Packet " << i << " ssrc " << 0x1234u << " rate "
+                     << 1.5 * i << " payload " << payload_;
+  }
+  void LogVerbosePacket(int i) {
+    RTC_LOG(LS_VERBOSE) << "Packet " << i << " ssrc " << 0x1234u << " rate "
+                        << 1.5 * i << " payload " << payload_;
+  }
+
+  void ReportCallCost(const std::string& modifier, int64_t elapsed_ns) {
+    webrtc::test::PrintResult(
+        "log_call_time_", modifier, "rtc_log",
+        static_cast<double>(elapsed_ns) / kNumCalls, "ns", false,
+        webrtc::test::ImproveDirection::kSmallerIsBetter);
+  }
+
+ private:
+  const LoggingSeverity debug_severity_;
+  const std::string payload_;
+  NullLogSink sink_;
+};
+
+}  // namespace
+
+TEST_F(LoggingPerformanceTest, DisabledSeverity) {
+  const int64_t start_ns = TimeNanos();
+  for (int i = 0; i < kNumCalls; ++i) {
+    LogVerbosePacket(i);
+  }
+  ReportCallCost("disabled_severity", TimeNanos() - start_ns);
+}
+
+TEST_F(LoggingPerformanceTest, EnabledSeverity) {
+  const int64_t start_ns = TimeNanos();
+  for (int i = 0; i < kNumCalls; ++i) {
+    LogPacket(i);
+  }
+  ReportCallCost("enabled_severity", TimeNanos() - start_ns);
+}
+
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+// Measures the cost on the logging thread only; the deferred messages are
+// formatted outside of the measured time.
+TEST_F(LoggingPerformanceTest, EnabledSeverityDeferred) {
+  LogMessage::SetDeferredLogging(true);
+  int64_t elapsed_ns = 0;
+  int num_output = 0;
+  for (int i = 0; i < kNumCalls; i += kDeferredBatchSize) {
+    const int64_t start_ns = TimeNanos();
+    for (int j = i; j < i + kDeferredBatchSize; ++j) {
+      LogPacket(j);
+    }
+    elapsed_ns += TimeNanos() - start_ns;
+    num_output += LogMessage::ProcessDeferredLogs();
+  }
+  LogMessage::SetDeferredLogging(false);
+  EXPECT_EQ(kNumCalls, num_output);
+  ReportCallCost("enabled_severity_deferred", elapsed_ns);
+}
+#endif  // defined(ABSL_HAVE_THREAD_LOCAL)
+
+}  // namespace rtc
+#endif  // RTC_LOG_ENABLED()
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 
+#include "absl/base/config.h"
 #include "rtc_base/arraysize.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/event.h"
@@ -359,5 +360,104 @@ TEST(LogTest, EnumsAreSupported) {
   stream.Close();
 }
 
+TEST(LogTest, ArgumentsAreNotEvaluatedForNoopMessages) {
+  std::string str;
+  LogSinkImpl<StringStream> stream(&str);
+  LogMessage::AddLogToStream(&stream, LS_INFO);
+  LoggingSeverity debug_severity = LogMessage::GetLogToDebug();
+  LogMessage::LogToDebug(LS_NONE);
+
+  int evaluations = 0;
+  auto evaluate = [&evaluations] { return ++evaluations; };
+  RTC_LOG(LS_VERBOSE) << "VERBOSE " << evaluate();
+  RTC_LOG_V(LS_VERBOSE) << "VERBOSE " << evaluate();
+  EXPECT_EQ(0, evaluations);
+  EXPECT_EQ(std::string::npos, str.find("VERBOSE"));
+
+  RTC_LOG(LS_INFO) << "INFO " << evaluate();
+  RTC_LOG_V(LS_INFO) << "INFO " << evaluate();
+  EXPECT_EQ(2, evaluations);
+  EXPECT_NE(std::string::npos, str.find("INFO 1"));
+  EXPECT_NE(std::string::npos, str.find("INFO 2"));
+
+  LogMessage::LogToDebug(debug_severity);
+  LogMessage::RemoveLogToStream(&stream);
+  stream.Close();
+}
+
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+TEST(LogTest, DeferredMessagesAreOutputWhenProcessed) {
+  std::string str;
+  LogSinkImpl<StringStream> stream(&str);
+  LogMessage::AddLogToStream(&stream, LS_INFO);
+  LogMessage::SetDeferredLogging(true);
+
+  const char* null_string = nullptr;
+  void* p = reinterpret_cast<void*>(0xabcd);
+  {
+    std::string temporary = "std::string";
+    RTC_LOG(LS_INFO) << "|" << 1 << "|" << 2l << "|" << 3ll << "|" << 4u << "|"
+                     << 5ul << "|" << 6ull << "|" << 7.5 << "|" << temporary
+                     << "|" << absl::string_view("absl::stringview") << "|"
+                     << p << "|" << null_string << "|";
+  }
+  EXPECT_EQ(std::string::npos, str.find("|1|"));
+
+  EXPECT_EQ(1, LogMessage::ProcessDeferredLogs());
+  LogMessage::SetDeferredLogging(false);
+  EXPECT_NE(std::string::npos,
+            str.find("|1|2|3|4|5|6|7.5|std::string|absl::stringview|abcd|"
+                     "(null)|"));
+  EXPECT_EQ(0, LogMessage::ProcessDeferredLogs());
+
+  LogMessage::RemoveLogToStream(&stream);
+  stream.Close();
+}
+
+TEST(LogTest, DeferredMessagesCopyTheirTag) {
+  std::string str;
+  LogSinkImpl<StringStream> stream(&str);
+  LogMessage::AddLogToStream(&stream, LS_INFO);
+  LogMessage::SetDeferredLogging(true);
+
+  {
+    // The tag is only guaranteed to live as long as the log call.
+    std::string tag = "TemporaryTag";
+    RTC_LOG_TAG(LS_INFO, tag.c_str()) << "tagged message";
+    tag.assign(tag.size(), 'X');
+  }
+
+  EXPECT_EQ(1, LogMessage::ProcessDeferredLogs());
+  LogMessage::SetDeferredLogging(false);
+  EXPECT_NE(std::string::npos, str.find("tagged message"));
+
+  LogMessage::RemoveLogToStream(&stream);
+  stream.Close();
+}
+
+TEST(LogTest, DeferredMessagesThatDoNotFitAreDropped) {
+  std::string str;
+  LogSinkImpl<StringStream> stream(&str);
+  LogMessage::AddLogToStream(&stream, LS_INFO);
+  LogMessage::SetDeferredLogging(true);
+
+  const std::string message(1000, 'X');
+  constexpr int kNumMessages = 1000;
+  for (int i = 0; i < kNumMessages; ++i) {
+    RTC_LOG(LS_INFO) << message;
+  }
+  const int num_output = LogMessage::ProcessDeferredLogs();
+  LogMessage::SetDeferredLogging(false);
+  EXPECT_GT(num_output, 0);
+  EXPECT_LT(num_output, kNumMessages);
+  EXPECT_NE(std::string::npos,
+            str.find(std::to_string(kNumMessages - num_output) +
+                     " deferred log messages were dropped"));
+
+  LogMessage::RemoveLogToStream(&stream);
+  stream.Close();
+}
+#endif  // defined(ABSL_HAVE_THREAD_LOCAL)
+
 }  // namespace rtc
 #endif
@@ -39,6 +39,17 @@ MessageDigest* MessageDigestFactory::Create(const std::string& alg) {
   return digest;
 }
 
+MessageDigest* MessageDigestFactory::CreateHmac(const std::string& alg,
+                                                const void* key,
+                                                size_t key_len) {
+  MessageDigest* digest = new OpenSSLHmac(alg, key, key_len);
+  if (digest->Size() == 0) {  // invalid algorithm
+    delete digest;
+    digest = nullptr;
+  }
+  return digest;
+}
+
 bool IsFips180DigestAlgorithm(const std::string& alg) {
   // These are the FIPS 180 algorithms.  According to RFC 4572 Section 5,
   // "Self-signed certificates (for which legacy certificates are not a
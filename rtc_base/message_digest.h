@@ -43,6 +43,12 @@ class MessageDigest {
 class MessageDigestFactory {
  public:
   static MessageDigest* Create(const std::string& alg);
+  // Creates a digest that outputs the HMAC (RFC 2104) of its input, keyed with
+  // |key|. The key schedule is computed once here, so that reusing the digest
+  // for many inputs with the same key does not hash the key pads again.
+  static MessageDigest* CreateHmac(const std::string& alg,
+                                   const void* key,
+                                   size_t key_len);
 };
 
 // A whitelist of approved digest algorithms from RFC 4572 (FIPS 180).
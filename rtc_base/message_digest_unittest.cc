@@ -10,6 +10,8 @@
 
 #include "rtc_base/message_digest.h"
 
+#include <memory>
+
 #include "rtc_base/string_encode.h"
 #include "test/gtest.h"
 
@@ -150,6 +152,38 @@ TEST(MessageDigestTest, TestBadHmac) {
   std::string output;
   EXPECT_FALSE(ComputeHmac("sha-9000", "key", "abc", &output));
   EXPECT_EQ("", ComputeHmac("sha-9000", "key", "abc"));
+  EXPECT_EQ(nullptr, MessageDigestFactory::CreateHmac("sha-9000", "key", 3));
+}
+
+// Test vectors from RFC 2202, computed with a keyed digest that is reused for
+// several inputs.
+TEST(MessageDigestTest, TestKeyedSha1Hmac) {
+  std::string key(80, '\xaa');
+  std::unique_ptr<MessageDigest> hmac(
+      MessageDigestFactory::CreateHmac(DIGEST_SHA_1, key.data(), key.size()));
+  ASSERT_TRUE(hmac);
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ("aa4ae5e15272d00e95705637ce8a3b55ed402112",
+              ComputeDigest(hmac.get(), "Test Using Larger Than Block-Size "
+                                        "Key - Hash Key First"));
+    EXPECT_EQ("e8e99d0f45237d786d6bbaa7965c7808bbff1a91",
+              ComputeDigest(hmac.get(), "Test Using Larger Than Block-Size "
+                                        "Key and Larger Than One Block-Size "
+                                        "Data"));
+  }
+
+  key = "Jefe";
+  hmac.reset(
+      MessageDigestFactory::CreateHmac(DIGEST_SHA_1, key.data(), key.size()));
+  ASSERT_TRUE(hmac);
+  // An input given in several updates.
+  hmac->Update("what do ya ", 11);
+  hmac->Update("want for nothing?", 17);
+  char output[20];
+  EXPECT_EQ(0U, hmac->Finish(output, sizeof(output) - 1));
+  EXPECT_EQ(sizeof(output), hmac->Finish(output, sizeof(output)));
+  EXPECT_EQ("effcdf6ae5eb2fa2d27416d5f184df9c259a7c79",
+            hex_encode(output, sizeof(output)));
 }
 
 }  // namespace rtc
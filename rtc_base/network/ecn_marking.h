@@ -0,0 +1,34 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_NETWORK_ECN_MARKING_H_
+#define RTC_BASE_NETWORK_ECN_MARKING_H_
+
+namespace rtc {
+
+// Explicit Congestion Notification codepoints, i.e. the two least significant
+// bits of the IPv4 TOS / IPv6 traffic class field, as defined in RFC 3168.
+// ECT(1) is used by L4S (RFC 9331) senders.
+enum class EcnMarking {
+  kNotEct = 0,  // Not ECN-capable transport.
+  kEct1 = 1,    // ECN-capable transport.
+  kEct0 = 2,    // ECN-capable transport.
+  kCe = 3,      // Congestion experienced.
+};
+
+// Returns true if |ecn| marks an ECN-capable packet, which a network node
+// may mark with CE instead of dropping.
+inline bool IsEcnCapable(EcnMarking ecn) {
+  return ecn != EcnMarking::kNotEct;
+}
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_NETWORK_ECN_MARKING_H_
@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/numerics/sliding_linear_regression.h"
+
+#include "rtc_base/checks.h"
+
+namespace rtc {
+namespace {
+constexpr double kRelativeEpsilon = 1e-9;
+}  // namespace
+
+SlidingLinearRegression::SlidingLinearRegression(size_t window_size)
+    : samples_(window_size) {
+  RTC_DCHECK_GT(window_size, 0);
+}
+
+SlidingLinearRegression::~SlidingLinearRegression() = default;
+
+void SlidingLinearRegression::AddSample(double x, double y) {
+  if (size_ == 0)
+    origin_ = {x, y};
+  const Sample& newest =
+      samples_[(next_ + samples_.size() - 1) % samples_.size()];
+  num_same_x_ = size_ > 0 && x == newest.x ? num_same_x_ + 1 : 1;
+  Sample& slot = samples_[next_];
+  if (size_ == samples_.size()) {
+    const double dx = slot.x - origin_.x;
+    const double dy = slot.y - origin_.y;
+    sum_x_ -= dx;
+    sum_y_ -= dy;
+    sum_xx_ -= dx * dx;
+    sum_xy_ -= dx * dy;
+  } else {
+    ++size_;
+  }
+  slot = {x, y};
+  next_ = (next_ + 1) % samples_.size();
+  const double dx = x - origin_.x;
+  const double dy = y - origin_.y;
+  sum_x_ += dx;
+  sum_y_ += dy;
+  sum_xx_ += dx * dx;
+  sum_xy_ += dx * dy;
+  if (++samples_since_recompute_ == samples_.size())
+    Recompute();
+}
+
+absl::optional<double> SlidingLinearRegression::Slope() const {
+  if (size_ < 2 || num_same_x_ >= size_)
+    return absl::nullopt;
+  // n * sum((x - x_avg)^2) and n * sum((x - x_avg) * (y - y_avg)).
+  const double n = static_cast<double>(size_);
+  const double denominator = n * sum_xx_ - sum_x_ * sum_x_;
+  // The terms cancel when the x values are close together compared to their
+  // distance from |origin_|, leaving rounding errors.
+  if (denominator <= kRelativeEpsilon * n * sum_xx_)
+    return absl::nullopt;
+  return (n * sum_xy_ - sum_x_ * sum_y_) / denominator;
+}
+
+void SlidingLinearRegression::Reset() {
+  next_ = 0;
+  size_ = 0;
+  samples_since_recompute_ = 0;
+  num_same_x_ = 0;
+  sum_x_ = sum_y_ = sum_xx_ = sum_xy_ = 0;
+}
+
+void SlidingLinearRegression::Recompute() {
+  samples_since_recompute_ = 0;
+  // The newest sample becomes the origin, it's the closest to the samples
+  // added until the next recompute.
+  const size_t newest = (next_ + samples_.size() - 1) % samples_.size();
+  origin_ = samples_[newest];
+  sum_x_ = sum_y_ = sum_xx_ = sum_xy_ = 0;
+  for (size_t i = 0; i < size_; ++i) {
+    const Sample& sample = samples_[(newest + samples_.size() - i) %
+                                    samples_.size()];
+    const double dx = sample.x - origin_.x;
+    const double dy = sample.y - origin_.y;
+    sum_x_ += dx;
+    sum_y_ += dy;
+    sum_xx_ += dx * dx;
+    sum_xy_ += dx * dy;
+  }
+}
+
+}  // namespace rtc
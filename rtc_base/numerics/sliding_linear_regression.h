@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_NUMERICS_SLIDING_LINEAR_REGRESSION_H_
+#define RTC_BASE_NUMERICS_SLIDING_LINEAR_REGRESSION_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "absl/types/optional.h"
+
+namespace rtc {
+
+// Least squares fit of a line to the last |window_size| (x, y) samples, e.g.
+// the delay gradient over the last packet groups. Adding a sample and getting
+// the slope are O(1): the sums are updated as samples enter and leave the
+// window, and recomputed once per window so that rounding errors don't build
+// up. The sums are relative to a sample in the window, so they stay small
+// even when x is a time that keeps growing.
+class SlidingLinearRegression {
+ public:
+  explicit SlidingLinearRegression(size_t window_size);
+  ~SlidingLinearRegression();
+  SlidingLinearRegression(const SlidingLinearRegression&) = delete;
+  SlidingLinearRegression& operator=(const SlidingLinearRegression&) = delete;
+
+  // Adds a sample. If the window is full, the oldest sample is pushed out.
+  void AddSample(double x, double y);
+
+  // Slope of the fitted line, or nullopt if there are less than two samples
+  // or all x values are the same.
+  absl::optional<double> Slope() const;
+
+  void Reset();
+
+  size_t Size() const { return size_; }
+  size_t window_size() const { return samples_.size(); }
+
+ private:
+  struct Sample {
+    double x = 0;
+    double y = 0;
+  };
+
+  void Recompute();
+
+  // Circular buffer of the window, |size_| samples ending before |next_|.
+  std::vector<Sample> samples_;
+  size_t next_ = 0;
+  size_t size_ = 0;
+  size_t samples_since_recompute_ = 0;
+  // Number of the newest samples with the same x. The sums can't tell when all
+  // x values are the same, since removed samples leave rounding errors.
+  size_t num_same_x_ = 0;
+  Sample origin_;
+  // Sums over the window, relative to |origin_|.
+  double sum_x_ = 0;
+  double sum_y_ = 0;
+  double sum_xx_ = 0;
+  double sum_xy_ = 0;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_NUMERICS_SLIDING_LINEAR_REGRESSION_H_
@@ -0,0 +1,102 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rtc_base/numerics/sliding_linear_regression.h"
+#include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace rtc {
+namespace {
+
+constexpr int kNumSamples = 1000000;
+// The window sizes TrendlineEstimator allows: default, common and largest.
+constexpr size_t kWindowSizes[] = {20, 60, 200};
+
+// Arrival times and delays of packet groups.
+std::vector<std::pair<double, double>> CreateSamples() {
+  webrtc::Random random(0x5eed);
+  std::vector<std::pair<double, double>> samples(kNumSamples);
+  double x = 0;
+  double y = 0;
+  for (auto& sample : samples) {
+    x += random.Rand(5, 50);
+    y += random.Gaussian(0, 0.5);
+    sample = {x, y};
+  }
+  return samples;
+}
+
+// The two pass fit TrendlineEstimator used before.
+double DirectFitSlope(const std::deque<std::pair<double, double>>& samples) {
+  double sum_x = 0;
+  double sum_y = 0;
+  for (const auto& sample : samples) {
+    sum_x += sample.first;
+    sum_y += sample.second;
+  }
+  double x_avg = sum_x / samples.size();
+  double y_avg = sum_y / samples.size();
+  double numerator = 0;
+  double denominator = 0;
+  for (const auto& sample : samples) {
+    numerator += (sample.first - x_avg) * (sample.second - y_avg);
+    denominator += (sample.first - x_avg) * (sample.first - x_avg);
+  }
+  return denominator == 0 ? 0 : numerator / denominator;
+}
+
+void ReportSlopeCost(const std::string& method,
+                     size_t window_size,
+                     int64_t elapsed_ns) {
+  const std::string story = method + "_window_" + std::to_string(window_size);
+  webrtc::test::PrintResult("slope_update_time", "", story,
+                            static_cast<double>(elapsed_ns) / kNumSamples,
+                            "ns", false,
+                            webrtc::test::ImproveDirection::kSmallerIsBetter);
+}
+
+}  // namespace
+
+TEST(SlidingLinearRegressionPerformanceTest, SlopePerSample) {
+  const std::vector<std::pair<double, double>> samples = CreateSamples();
+  for (size_t window_size : kWindowSizes) {
+    double direct_sum = 0;
+    std::deque<std::pair<double, double>> window;
+    int64_t start_ns = TimeNanos();
+    for (const auto& sample : samples) {
+      window.push_back(sample);
+      if (window.size() > window_size)
+        window.pop_front();
+      direct_sum += DirectFitSlope(window);
+    }
+    ReportSlopeCost("direct_fit", window_size, TimeNanos() - start_ns);
+
+    double sliding_sum = 0;
+    SlidingLinearRegression regression(window_size);
+    start_ns = TimeNanos();
+    for (const auto& sample : samples) {
+      regression.AddSample(sample.first, sample.second);
+      sliding_sum += regression.Slope().value_or(0);
+    }
+    ReportSlopeCost("sliding", window_size, TimeNanos() - start_ns);
+
+    // Also keeps the loops from being optimized away.
+    EXPECT_NEAR(direct_sum, sliding_sum, 1e-9 * kNumSamples);
+  }
+}
+
+}  // namespace rtc
@@ -0,0 +1,153 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/numerics/sliding_linear_regression.h"
+
+#include <cmath>
+#include <deque>
+#include <utility>
+
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+// The two pass fit TrendlineEstimator used before.
+absl::optional<double> DirectFitSlope(
+    const std::deque<std::pair<double, double>>& samples) {
+  double sum_x = 0;
+  double sum_y = 0;
+  for (const auto& sample : samples) {
+    sum_x += sample.first;
+    sum_y += sample.second;
+  }
+  double x_avg = sum_x / samples.size();
+  double y_avg = sum_y / samples.size();
+  double numerator = 0;
+  double denominator = 0;
+  for (const auto& sample : samples) {
+    numerator += (sample.first - x_avg) * (sample.second - y_avg);
+    denominator += (sample.first - x_avg) * (sample.first - x_avg);
+  }
+  if (denominator == 0)
+    return absl::nullopt;
+  return numerator / denominator;
+}
+
+// Feeds |num_samples| samples through a window of |window_size| and compares
+// each slope with the direct fit.
+void ExpectSameSlopes(size_t window_size,
+                      int num_samples,
+                      bool integer_x,
+                      double x_offset) {
+  webrtc::Random random(0x1234);
+  SlidingLinearRegression regression(window_size);
+  std::deque<std::pair<double, double>> window;
+  double x = x_offset;
+  double y = 0;
+  double max_error = 0;
+  for (int i = 0; i < num_samples; ++i) {
+    // Packet groups 5 to 50 ms apart, with a delay that drifts.
+    x += integer_x ? random.Rand(5, 50) : 5 + 45 * random.Rand<double>();
+    y += random.Gaussian(0, 0.5);
+    window.emplace_back(x, y);
+    regression.AddSample(x, y);
+    if (window.size() > window_size)
+      window.pop_front();
+    absl::optional<double> expected = DirectFitSlope(window);
+    absl::optional<double> slope = regression.Slope();
+    ASSERT_EQ(expected.has_value(), slope.has_value()) << i;
+    if (expected) {
+      max_error = std::max(max_error, std::fabs(*slope - *expected) /
+                                          (std::fabs(*expected) + 1e-3));
+    }
+  }
+  EXPECT_LT(max_error, 1e-12);
+}
+
+}  // namespace
+
+TEST(SlidingLinearRegressionTest, NeedsTwoDistinctX) {
+  SlidingLinearRegression regression(10);
+  EXPECT_FALSE(regression.Slope());
+  regression.AddSample(10, 1);
+  EXPECT_FALSE(regression.Slope());
+  regression.AddSample(10, 2);
+  EXPECT_FALSE(regression.Slope());
+  regression.AddSample(20, 3);
+  ASSERT_TRUE(regression.Slope());
+  EXPECT_DOUBLE_EQ(*regression.Slope(), 0.15);
+}
+
+TEST(SlidingLinearRegressionTest, FitsLineInWindow) {
+  SlidingLinearRegression regression(20);
+  for (int x = 0; x < 100; ++x)
+    regression.AddSample(x, 2 * x + 1);
+  EXPECT_EQ(regression.Size(), 20u);
+  EXPECT_DOUBLE_EQ(*regression.Slope(), 2.0);
+  // The line changes, the old samples are pushed out.
+  for (int x = 100; x < 120; ++x)
+    regression.AddSample(x, -x);
+  EXPECT_DOUBLE_EQ(*regression.Slope(), -1.0);
+}
+
+TEST(SlidingLinearRegressionTest, SameXAfterSlidingHasNoSlope) {
+  SlidingLinearRegression regression(20);
+  for (int x = 0; x < 1005; ++x)
+    regression.AddSample(x * 37.3, x);
+  for (int i = 0; i < 20; ++i)
+    regression.AddSample(5000.1, i);
+  EXPECT_FALSE(regression.Slope());
+}
+
+TEST(SlidingLinearRegressionTest, AllEqualXHasNoSlope) {
+  // The samples pushed out of the window leave rounding errors in the sums,
+  // which must not be taken for a spread in x.
+  for (size_t window_size = 2; window_size <= 20; ++window_size) {
+    for (int num_previous = 1; num_previous < 40; ++num_previous) {
+      SlidingLinearRegression regression(window_size);
+      for (int i = 0; i < num_previous; ++i)
+        regression.AddSample(1000 + i * 33.3, i);
+      for (size_t i = 0; i < 2 * window_size; ++i) {
+        regression.AddSample(5000.1, i);
+        if (i + 1 >= window_size) {
+          EXPECT_FALSE(regression.Slope())
+              << window_size << " " << num_previous << " " << i;
+        }
+      }
+    }
+  }
+}
+
+TEST(SlidingLinearRegressionTest, Reset) {
+  SlidingLinearRegression regression(10);
+  regression.AddSample(1e9, 5);
+  regression.AddSample(1e9 + 1, 6);
+  regression.Reset();
+  EXPECT_EQ(regression.Size(), 0u);
+  EXPECT_FALSE(regression.Slope());
+  regression.AddSample(0, 0);
+  regression.AddSample(1, 3);
+  EXPECT_DOUBLE_EQ(*regression.Slope(), 3.0);
+}
+
+// Ten hours of packet groups with arrival times in ms.
+TEST(SlidingLinearRegressionTest, MatchesDirectFitForIntegerX) {
+  ExpectSameSlopes(20, 1300000, /*integer_x=*/true, 0);
+  ExpectSameSlopes(200, 100000, /*integer_x=*/true, 1e7);
+}
+
+TEST(SlidingLinearRegressionTest, MatchesDirectFitForFractionalX) {
+  ExpectSameSlopes(20, 1300000, /*integer_x=*/false, 0);
+  ExpectSameSlopes(200, 100000, /*integer_x=*/false, 1e7);
+}
+
+}  // namespace rtc
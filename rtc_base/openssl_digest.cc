@@ -10,10 +10,18 @@
 
 #include "rtc_base/openssl_digest.h"
 
+#include <string.h>
+
 #include "rtc_base/checks.h"  // RTC_DCHECK, RTC_CHECK
 #include "rtc_base/openssl.h"
 
 namespace rtc {
+namespace {
+
+// The block size of SHA-384 and SHA-512, the largest of the supported digests.
+constexpr size_t kMaxBlockSize = 128;
+
+}  // namespace
 
 OpenSSLDigest::OpenSSLDigest(const std::string& algorithm) {
   ctx_ = EVP_MD_CTX_new();
@@ -55,6 +63,80 @@ size_t OpenSSLDigest::Finish(void* buf, size_t len) {
   return md_len;
 }
 
+OpenSSLHmac::OpenSSLHmac(const std::string& algorithm,
+                         const void* key,
+                         size_t key_len) {
+  if (!OpenSSLDigest::GetDigestEVP(algorithm, &md_)) {
+    md_ = nullptr;
+    return;
+  }
+  const size_t block_size = EVP_MD_block_size(md_);
+  ctx_ = EVP_MD_CTX_new();
+  inner_ctx_ = EVP_MD_CTX_new();
+  outer_ctx_ = EVP_MD_CTX_new();
+  RTC_CHECK(ctx_ != nullptr && inner_ctx_ != nullptr && outer_ctx_ != nullptr);
+
+  // Keys longer than a block are hashed first; shorter ones are zero padded.
+  unsigned char padded_key[kMaxBlockSize] = {};
+  RTC_DCHECK_LE(block_size, sizeof(padded_key));
+  if (key_len > block_size) {
+    unsigned int md_len;
+    EVP_DigestInit_ex(ctx_, md_, nullptr);
+    EVP_DigestUpdate(ctx_, key, key_len);
+    EVP_DigestFinal_ex(ctx_, padded_key, &md_len);
+  } else if (key_len > 0) {
+    memcpy(padded_key, key, key_len);
+  }
+
+  unsigned char pad[kMaxBlockSize];
+  for (size_t i = 0; i < block_size; ++i) {
+    pad[i] = 0x36 ^ padded_key[i];
+  }
+  EVP_DigestInit_ex(inner_ctx_, md_, nullptr);
+  EVP_DigestUpdate(inner_ctx_, pad, block_size);
+  for (size_t i = 0; i < block_size; ++i) {
+    pad[i] = 0x5c ^ padded_key[i];
+  }
+  EVP_DigestInit_ex(outer_ctx_, md_, nullptr);
+  EVP_DigestUpdate(outer_ctx_, pad, block_size);
+  EVP_MD_CTX_copy_ex(ctx_, inner_ctx_);
+}
+
+OpenSSLHmac::~OpenSSLHmac() {
+  EVP_MD_CTX_destroy(ctx_);
+  EVP_MD_CTX_destroy(inner_ctx_);
+  EVP_MD_CTX_destroy(outer_ctx_);
+}
+
+size_t OpenSSLHmac::Size() const {
+  if (!md_) {
+    return 0;
+  }
+  return EVP_MD_size(md_);
+}
+
+void OpenSSLHmac::Update(const void* buf, size_t len) {
+  if (!md_) {
+    return;
+  }
+  EVP_DigestUpdate(ctx_, buf, len);
+}
+
+size_t OpenSSLHmac::Finish(void* buf, size_t len) {
+  if (!md_ || len < Size()) {
+    return 0;
+  }
+  unsigned char inner[EVP_MAX_MD_SIZE];
+  unsigned int md_len;
+  EVP_DigestFinal_ex(ctx_, inner, &md_len);
+  EVP_MD_CTX_copy_ex(ctx_, outer_ctx_);
+  EVP_DigestUpdate(ctx_, inner, md_len);
+  EVP_DigestFinal_ex(ctx_, static_cast<unsigned char*>(buf), &md_len);
+  EVP_MD_CTX_copy_ex(ctx_, inner_ctx_);  // prepare for future Update()s
+  RTC_DCHECK(md_len == Size());
+  return md_len;
+}
+
 bool OpenSSLDigest::GetDigestEVP(const std::string& algorithm,
                                  const EVP_MD** mdp) {
   const EVP_MD* md;
@@ -45,6 +45,30 @@ class OpenSSLDigest final : public MessageDigest {
   const EVP_MD* md_;
 };
 
+// An HMAC (RFC 2104) digest that uses OpenSSL. It keeps the digest states
+// after the inner and the outer key pads, and starts from copies of them for
+// every input.
+class OpenSSLHmac final : public MessageDigest {
+ public:
+  // Creates an OpenSSLHmac with |algorithm| as the hash algorithm, keyed with
+  // |key|.
+  OpenSSLHmac(const std::string& algorithm, const void* key, size_t key_len);
+  ~OpenSSLHmac() override;
+  // Returns the digest output size (e.g. 20 bytes for SHA-1).
+  size_t Size() const override;
+  // Updates the digest with |len| bytes from |buf|.
+  void Update(const void* buf, size_t len) override;
+  // Outputs the HMAC of the input to |buf| with length |len|, and prepares for
+  // the next input with the same key.
+  size_t Finish(void* buf, size_t len) override;
+
+ private:
+  EVP_MD_CTX* ctx_ = nullptr;
+  EVP_MD_CTX* inner_ctx_ = nullptr;
+  EVP_MD_CTX* outer_ctx_ = nullptr;
+  const EVP_MD* md_ = nullptr;
+};
+
 }  // namespace rtc
 
 #endif  // RTC_BASE_OPENSSL_DIGEST_H_
@@ -0,0 +1,303 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/pcap_writer.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "rtc_base/byte_order.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace rtc {
+namespace {
+
+// See https://wiki.wireshark.org/Development/LibpcapFileFormat
+constexpr uint32_t kPcapMagic = 0xa1b2c3d4;
+constexpr uint16_t kPcapVersionMajor = 2;
+constexpr uint16_t kPcapVersionMinor = 4;
+constexpr uint32_t kLinktypeEthernet = 1;
+constexpr size_t kGlobalHeaderSize = 24;
+constexpr size_t kRecordHeaderSize = 16;
+
+constexpr size_t kEthernetHeaderSize = 14;
+constexpr size_t kIpv4HeaderSize = 20;
+constexpr size_t kIpv6HeaderSize = 40;
+constexpr size_t kUdpHeaderSize = 8;
+constexpr uint16_t kEthertypeIpv4 = 0x0800;
+constexpr uint16_t kEthertypeIpv6 = 0x86dd;
+constexpr uint8_t kProtocolUdp = 17;
+constexpr uint8_t kTtl = 64;
+constexpr size_t kMaxUdpPayloadSize = 65507;
+constexpr size_t kMaxFrameHeaderSize =
+    kEthernetHeaderSize + kIpv6HeaderSize + kUdpHeaderSize;
+// Snapshot length of files with whole packets. It is the default of tcpdump
+// and libpcap, and larger than the largest frame, kMaxFrameHeaderSize +
+// kMaxUdpPayloadSize, which readers reject if it exceeds the snapshot length.
+constexpr uint32_t kWholePacketSnapLength = 262144;
+static_assert(kMaxFrameHeaderSize + kMaxUdpPayloadSize <=
+                  kWholePacketSnapLength,
+              "Frames must fit in the snapshot length");
+
+// Large enough for any UDP packet.
+constexpr size_t kMinRingSize = 128 * 1024;
+
+size_t RoundUpToPowerOfTwo(size_t size) {
+  size_t result = kMinRingSize;
+  while (result < size)
+    result *= 2;
+  return result;
+}
+
+// Records are kept 8 byte aligned in the ring buffer.
+size_t AlignedSize(size_t size) {
+  return (size + 7) & ~static_cast<size_t>(7);
+}
+
+void CopyAddress(const IPAddress& ip, uint8_t ip_version, uint8_t* out) {
+  if (ip_version == 6) {
+    in6_addr address = ip.AsIPv6Address().ipv6_address();
+    memcpy(out, &address, 16);
+  } else if (ip.family() == AF_INET) {
+    in_addr address = ip.ipv4_address();
+    memcpy(out, &address, 4);
+  }
+}
+
+uint16_t Ipv4HeaderChecksum(const uint8_t* header) {
+  uint32_t sum = 0;
+  for (size_t i = 0; i < kIpv4HeaderSize; i += 2)
+    sum += GetBE16(header + i);
+  while (sum >> 16)
+    sum = (sum & 0xffff) + (sum >> 16);
+  return static_cast<uint16_t>(~sum);
+}
+
+}  // namespace
+
+std::unique_ptr<PcapWriter> PcapWriter::Create(const Config& config) {
+  std::unique_ptr<PcapWriter> writer(new PcapWriter(config));
+  {
+    CritScope lock(&writer->consumer_lock_);
+    if (!writer->OpenFile())
+      return nullptr;
+  }
+  writer->writer_thread_.Start();
+  return writer;
+}
+
+PcapWriter::PcapWriter(const Config& config)
+    : config_(config),
+      ring_size_(RoundUpToPowerOfTwo(config.buffer_size)),
+      ring_(ring_size_),
+      payload_(kMaxUdpPayloadSize),
+      writer_thread_(&WriterThreadFunc, this, "PcapWriter", kLowPriority) {}
+
+PcapWriter::~PcapWriter() {
+  stopping_.store(true);
+  wakeup_.Set();
+  writer_thread_.Stop();
+  Flush();
+}
+
+void PcapWriter::WritePacket(const SocketAddress& from,
+                             const SocketAddress& to,
+                             const void* data,
+                             size_t size,
+                             int64_t time_us) {
+  RecordHeader header;
+  memset(&header, 0, sizeof(header));
+  header.time_us = time_us;
+  header.original_size = std::min(size, kMaxUdpPayloadSize);
+  header.captured_size = header.original_size;
+  if (config_.snap_length > 0 && config_.snap_length < header.original_size)
+    header.captured_size = config_.snap_length;
+  header.from_port = from.port();
+  header.to_port = to.port();
+  header.ip_version = (from.ipaddr().family() == AF_INET6 ||
+                       to.ipaddr().family() == AF_INET6)
+                          ? 6
+                          : 4;
+  CopyAddress(from.ipaddr(), header.ip_version, header.from_ip);
+  CopyAddress(to.ipaddr(), header.ip_version, header.to_ip);
+
+  const size_t record_size = AlignedSize(sizeof(header) + header.captured_size);
+  bool wake_writer;
+  {
+    CritScope lock(&producer_lock_);
+    const uint64_t position = write_position_.load(std::memory_order_relaxed);
+    const uint64_t used =
+        position - read_position_.load(std::memory_order_acquire);
+    if (record_size > ring_size_ - used) {
+      packets_dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    CopyToRing(position, &header, sizeof(header));
+    CopyToRing(position + sizeof(header), data, header.captured_size);
+    write_position_.store(position + record_size, std::memory_order_release);
+    wake_writer = used + record_size > ring_size_ / 2;
+  }
+  packets_captured_.fetch_add(1, std::memory_order_relaxed);
+  if (wake_writer && !wakeup_pending_.exchange(true))
+    wakeup_.Set();
+}
+
+void PcapWriter::Flush() {
+  CritScope lock(&consumer_lock_);
+  Drain();
+  if (file_.is_open())
+    file_.Flush();
+}
+
+// static
+void PcapWriter::WriterThreadFunc(void* obj) {
+  static_cast<PcapWriter*>(obj)->WriterThread();
+}
+
+void PcapWriter::WriterThread() {
+  while (!stopping_.load()) {
+    wakeup_.Wait(config_.flush_interval_ms);
+    wakeup_pending_.store(false);
+    CritScope lock(&consumer_lock_);
+    Drain();
+  }
+}
+
+void PcapWriter::CopyToRing(uint64_t position, const void* data, size_t size) {
+  const size_t offset = position & (ring_size_ - 1);
+  const size_t first = std::min(size, ring_size_ - offset);
+  memcpy(&ring_[offset], data, first);
+  memcpy(&ring_[0], static_cast<const uint8_t*>(data) + first, size - first);
+}
+
+void PcapWriter::CopyFromRing(uint64_t position,
+                              void* data,
+                              size_t size) const {
+  const size_t offset = position & (ring_size_ - 1);
+  const size_t first = std::min(size, ring_size_ - offset);
+  memcpy(data, &ring_[offset], first);
+  memcpy(static_cast<uint8_t*>(data) + first, &ring_[0], size - first);
+}
+
+void PcapWriter::Drain() {
+  uint64_t position = read_position_.load(std::memory_order_relaxed);
+  const uint64_t end = write_position_.load(std::memory_order_acquire);
+  while (position < end) {
+    RecordHeader header;
+    CopyFromRing(position, &header, sizeof(header));
+    CopyFromRing(position + sizeof(header), payload_.data(),
+                 header.captured_size);
+    WriteRecord(header, payload_.data());
+    position += AlignedSize(sizeof(header) + header.captured_size);
+    // Make room for new packets as soon as possible.
+    read_position_.store(position, std::memory_order_release);
+  }
+}
+
+void PcapWriter::WriteRecord(const RecordHeader& header,
+                             const uint8_t* payload) {
+  const size_t ip_header_size =
+      header.ip_version == 6 ? kIpv6HeaderSize : kIpv4HeaderSize;
+  const size_t frame_header_size =
+      kEthernetHeaderSize + ip_header_size + kUdpHeaderSize;
+  const size_t record_size =
+      kRecordHeaderSize + frame_header_size + header.captured_size;
+
+  if (config_.max_file_size > 0 && file_size_ > kGlobalHeaderSize &&
+      file_size_ + record_size > config_.max_file_size) {
+    ++file_index_;
+    if (config_.max_files > 0 && file_index_ >= config_.max_files)
+      remove(FilePath(file_index_ - config_.max_files).c_str());
+    OpenFile();
+  }
+  if (!file_.is_open())
+    return;
+
+  uint8_t buffer[kRecordHeaderSize + kMaxFrameHeaderSize];
+  memset(buffer, 0, sizeof(buffer));
+  const int64_t time_us = std::max<int64_t>(header.time_us, 0);
+  const uint32_t record[4] = {
+      static_cast<uint32_t>(time_us / 1000000),
+      static_cast<uint32_t>(time_us % 1000000),
+      static_cast<uint32_t>(frame_header_size + header.captured_size),
+      static_cast<uint32_t>(frame_header_size + header.original_size)};
+  memcpy(buffer, record, sizeof(record));
+
+  // Ethernet header with zero MAC addresses.
+  uint8_t* ethernet = buffer + kRecordHeaderSize;
+  uint8_t* ip = ethernet + kEthernetHeaderSize;
+  uint8_t* udp = ip + ip_header_size;
+  const uint16_t udp_length =
+      static_cast<uint16_t>(kUdpHeaderSize + header.original_size);
+  if (header.ip_version == 6) {
+    SetBE16(ethernet + 12, kEthertypeIpv6);
+    SetBE32(ip, 0x60000000);
+    SetBE16(ip + 4, udp_length);
+    ip[6] = kProtocolUdp;
+    ip[7] = kTtl;
+    memcpy(ip + 8, header.from_ip, 16);
+    memcpy(ip + 24, header.to_ip, 16);
+  } else {
+    SetBE16(ethernet + 12, kEthertypeIpv4);
+    ip[0] = 0x45;
+    SetBE16(ip + 2, static_cast<uint16_t>(kIpv4HeaderSize + udp_length));
+    // Don't fragment.
+    SetBE16(ip + 6, 0x4000);
+    ip[8] = kTtl;
+    ip[9] = kProtocolUdp;
+    memcpy(ip + 12, header.from_ip, 4);
+    memcpy(ip + 16, header.to_ip, 4);
+    SetBE16(ip + 10, Ipv4HeaderChecksum(ip));
+  }
+  // The UDP checksum is left as zero, i.e. not computed.
+  SetBE16(udp, header.from_port);
+  SetBE16(udp + 2, header.to_port);
+  SetBE16(udp + 4, udp_length);
+
+  file_.Write(buffer, kRecordHeaderSize + frame_header_size);
+  file_.Write(payload, header.captured_size);
+  file_size_ += record_size;
+}
+
+bool PcapWriter::OpenFile() {
+  file_ = webrtc::FileWrapper::OpenWriteOnly(FilePath(file_index_));
+  file_size_ = 0;
+  if (!file_.is_open()) {
+    RTC_LOG(LS_WARNING) << "Failed to open pcap file "
+                        << FilePath(file_index_);
+    return false;
+  }
+  const uint32_t snap_length =
+      config_.snap_length > 0
+          ? static_cast<uint32_t>(kMaxFrameHeaderSize + config_.snap_length)
+          : kWholePacketSnapLength;
+  uint8_t header[kGlobalHeaderSize];
+  memcpy(header, &kPcapMagic, 4);
+  memcpy(header + 4, &kPcapVersionMajor, 2);
+  memcpy(header + 6, &kPcapVersionMinor, 2);
+  // Time zone offset and timestamp accuracy.
+  memset(header + 8, 0, 8);
+  memcpy(header + 16, &snap_length, 4);
+  memcpy(header + 20, &kLinktypeEthernet, 4);
+  file_.Write(header, sizeof(header));
+  file_size_ = kGlobalHeaderSize;
+  return true;
+}
+
+std::string PcapWriter::FilePath(int index) const {
+  if (index == 0)
+    return config_.path;
+  return config_.path + "." + std::to_string(index);
+}
+
+}  // namespace rtc
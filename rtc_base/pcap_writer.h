@@ -0,0 +1,136 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_PCAP_WRITER_H_
+#define RTC_BASE_PCAP_WRITER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/system/file_wrapper.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace rtc {
+
+// Captures UDP packets to libpcap files. Each packet is written as an
+// Ethernet frame with IPv4 or IPv6 and UDP headers made up from the packet's
+// addresses, so the files can be opened with Wireshark and with
+// test::RtpFileReader.
+//
+// WritePacket() only copies the packet into a preallocated ring buffer; the
+// files are written by a low priority background thread. Packets that don't
+// fit in the ring while the background thread is behind are dropped and
+// counted, so capturing never blocks the caller on file IO.
+class PcapWriter {
+ public:
+  struct Config {
+    // Name of the first file. Further files, when rotating, get ".1", ".2",
+    // etc. appended.
+    std::string path;
+    // Number of bytes of UDP payload to keep from each packet, or 0 to keep
+    // whole packets. Note that test::RtpFileReader needs whole packets.
+    size_t snap_length = 0;
+    // Size of the ring buffer holding packets not yet written to file.
+    size_t buffer_size = 4 * 1024 * 1024;
+    // Start a new file once the current one exceeds this size, if non-zero.
+    size_t max_file_size = 0;
+    // Delete the oldest files when rotating, to keep at most this many files,
+    // if non-zero.
+    int max_files = 0;
+    // How often the background thread writes captured packets to file. It
+    // also wakes up early if the ring buffer is half full.
+    int flush_interval_ms = 100;
+  };
+
+  // Returns null if the first file can't be opened.
+  static std::unique_ptr<PcapWriter> Create(const Config& config);
+  ~PcapWriter();
+
+  PcapWriter(const PcapWriter&) = delete;
+  PcapWriter& operator=(const PcapWriter&) = delete;
+
+  // Captures a UDP packet from |from| to |to|, with |time_us| as the
+  // timestamp in the file. Can be called from any thread.
+  void WritePacket(const SocketAddress& from,
+                   const SocketAddress& to,
+                   const void* data,
+                   size_t size,
+                   int64_t time_us);
+
+  // Writes all packets captured so far to file and flushes it.
+  void Flush();
+
+  int64_t packets_captured() const { return packets_captured_.load(); }
+  int64_t packets_dropped() const { return packets_dropped_.load(); }
+
+ private:
+  // Precedes each packet in the ring buffer.
+  struct RecordHeader {
+    int64_t time_us;
+    uint32_t original_size;
+    uint32_t captured_size;
+    uint16_t from_port;
+    uint16_t to_port;
+    // 4 or 6.
+    uint8_t ip_version;
+    uint8_t from_ip[16];
+    uint8_t to_ip[16];
+  };
+
+  explicit PcapWriter(const Config& config);
+
+  static void WriterThreadFunc(void* obj);
+  void WriterThread();
+
+  void CopyToRing(uint64_t position, const void* data, size_t size)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(producer_lock_);
+  void CopyFromRing(uint64_t position, void* data, size_t size) const;
+  // Writes all records in the ring buffer to file.
+  void Drain() RTC_EXCLUSIVE_LOCKS_REQUIRED(consumer_lock_);
+  void WriteRecord(const RecordHeader& header, const uint8_t* payload)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(consumer_lock_);
+  bool OpenFile() RTC_EXCLUSIVE_LOCKS_REQUIRED(consumer_lock_);
+  std::string FilePath(int index) const;
+
+  const Config config_;
+  // Power of two.
+  const size_t ring_size_;
+  std::vector<uint8_t> ring_;
+  // Total number of bytes ever written to and read from the ring buffer.
+  std::atomic<uint64_t> write_position_{0};
+  std::atomic<uint64_t> read_position_{0};
+  std::atomic<int64_t> packets_captured_{0};
+  std::atomic<int64_t> packets_dropped_{0};
+
+  CriticalSection producer_lock_;
+  CriticalSection consumer_lock_;
+  webrtc::FileWrapper file_ RTC_GUARDED_BY(consumer_lock_);
+  size_t file_size_ RTC_GUARDED_BY(consumer_lock_) = 0;
+  int file_index_ RTC_GUARDED_BY(consumer_lock_) = 0;
+  std::vector<uint8_t> payload_ RTC_GUARDED_BY(consumer_lock_);
+
+  std::atomic<bool> stopping_{false};
+  std::atomic<bool> wakeup_pending_{false};
+  Event wakeup_;
+  PlatformThread writer_thread_;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_PCAP_WRITER_H_
@@ -0,0 +1,100 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "rtc_base/pcap_writer.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+#include "test/testsupport/perf_test.h"
+
+namespace rtc {
+namespace {
+
+// One second of a busy media path.
+constexpr int kPacketsPerSecond = 50000;
+constexpr int kNumPackets = kPacketsPerSecond;
+constexpr size_t kPacketSize = 1200;
+
+class PcapWriterPerformanceTest : public ::testing::Test {
+ protected:
+  PcapWriterPerformanceTest()
+      : path_(webrtc::test::TempFilename(webrtc::test::OutputPath(),
+                                         "pcap_writer_perf")),
+        payload_(kPacketSize, 0x55),
+        from_("192.168.0.1", 5000),
+        to_("192.168.0.2", 6000) {}
+  ~PcapWriterPerformanceTest() override { remove(path_.c_str()); }
+
+  std::unique_ptr<PcapWriter> CreateWriter() {
+    PcapWriter::Config config;
+    config.path = path_;
+    return PcapWriter::Create(config);
+  }
+
+  void WritePacket(PcapWriter* writer, int i) {
+    writer->WritePacket(from_, to_, payload_.data(), payload_.size(), i);
+  }
+
+ private:
+  const std::string path_;
+  const std::vector<uint8_t> payload_;
+  const SocketAddress from_;
+  const SocketAddress to_;
+};
+
+}  // namespace
+
+// Cost on the capturing thread when packets arrive back to back.
+TEST_F(PcapWriterPerformanceTest, WritePacketCost) {
+  std::unique_ptr<PcapWriter> writer = CreateWriter();
+  ASSERT_TRUE(writer);
+  const int64_t start_ns = TimeNanos();
+  for (int i = 0; i < kNumPackets; ++i) {
+    WritePacket(writer.get(), i);
+  }
+  const int64_t elapsed_ns = TimeNanos() - start_ns;
+  webrtc::test::PrintResult(
+      "pcap_write_packet_time_", "unpaced", "pcap_writer",
+      static_cast<double>(elapsed_ns) / kNumPackets, "ns", false,
+      webrtc::test::ImproveDirection::kSmallerIsBetter);
+}
+
+// Packets paced at 50k packets per second for one second should all be
+// captured with the default buffer size.
+TEST_F(PcapWriterPerformanceTest, PacedCapture) {
+  std::unique_ptr<PcapWriter> writer = CreateWriter();
+  ASSERT_TRUE(writer);
+  const int64_t kIntervalNs = kNumNanosecsPerSec / kPacketsPerSecond;
+  const int64_t start_ns = TimeNanos();
+  int64_t busy_ns = 0;
+  for (int i = 0; i < kNumPackets; ++i) {
+    while (TimeNanos() < start_ns + i * kIntervalNs) {
+    }
+    const int64_t write_start_ns = TimeNanos();
+    WritePacket(writer.get(), i);
+    busy_ns += TimeNanos() - write_start_ns;
+  }
+  webrtc::test::PrintResult(
+      "pcap_write_packet_time_", "paced_50kpps", "pcap_writer",
+      static_cast<double>(busy_ns) / kNumPackets, "ns", false,
+      webrtc::test::ImproveDirection::kSmallerIsBetter);
+  webrtc::test::PrintResult("pcap_dropped_packets_", "paced_50kpps",
+                            "pcap_writer", writer->packets_dropped(),
+                            "count", false,
+                            webrtc::test::ImproveDirection::kSmallerIsBetter);
+  EXPECT_EQ(writer->packets_dropped(), 0);
+}
+
+}  // namespace rtc
@@ -0,0 +1,298 @@
+/*
+ *  Copyright 2020 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/pcap_writer.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "rtc_base/byte_order.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace rtc {
+namespace {
+
+constexpr size_t kGlobalHeaderSize = 24;
+constexpr size_t kRecordHeaderSize = 16;
+constexpr size_t kEthernetHeaderSize = 14;
+constexpr size_t kIpv4HeaderSize = 20;
+constexpr size_t kIpv6HeaderSize = 40;
+constexpr size_t kUdpHeaderSize = 8;
+
+struct CapturedPacket {
+  int64_t time_us;
+  uint32_t original_size;
+  std::vector<uint8_t> frame;
+};
+
+std::vector<uint8_t> ReadFile(const std::string& path) {
+  std::vector<uint8_t> contents;
+  FILE* file = fopen(path.c_str(), "rb");
+  if (!file)
+    return contents;
+  uint8_t buffer[4096];
+  size_t read;
+  while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    contents.insert(contents.end(), buffer, buffer + read);
+  fclose(file);
+  return contents;
+}
+
+// Parses a pcap file written by PcapWriter, in host byte order.
+std::vector<CapturedPacket> ReadPcapFile(const std::string& path,
+                                         uint32_t* snap_length) {
+  std::vector<CapturedPacket> packets;
+  std::vector<uint8_t> contents = ReadFile(path);
+  EXPECT_GE(contents.size(), kGlobalHeaderSize);
+  if (contents.size() < kGlobalHeaderSize)
+    return packets;
+  uint32_t header[6];
+  memcpy(header, contents.data(), sizeof(header));
+  EXPECT_EQ(header[0], 0xa1b2c3d4);
+  EXPECT_EQ(header[1], 0x00040002u);
+  EXPECT_EQ(header[5], 1u);
+  if (snap_length)
+    *snap_length = header[4];
+
+  size_t offset = kGlobalHeaderSize;
+  while (offset + kRecordHeaderSize <= contents.size()) {
+    uint32_t record[4];
+    memcpy(record, &contents[offset], sizeof(record));
+    offset += kRecordHeaderSize;
+    EXPECT_LE(record[2], header[4]);
+    EXPECT_LE(offset + record[2], contents.size());
+    if (offset + record[2] > contents.size())
+      break;
+    CapturedPacket packet;
+    packet.time_us = record[0] * int64_t{1000000} + record[1];
+    packet.original_size = record[3];
+    packet.frame.assign(contents.begin() + offset,
+                        contents.begin() + offset + record[2]);
+    packets.push_back(packet);
+    offset += record[2];
+  }
+  EXPECT_EQ(offset, contents.size());
+  return packets;
+}
+
+class PcapWriterTest : public ::testing::Test {
+ protected:
+  PcapWriterTest()
+      : path_(webrtc::test::TempFilename(webrtc::test::OutputPath(),
+                                         "pcap_writer_test")) {}
+  ~PcapWriterTest() override {
+    for (int i = 0; i < 10; ++i)
+      remove(FilePath(i).c_str());
+  }
+
+  std::string FilePath(int index) const {
+    return index == 0 ? path_ : path_ + "." + std::to_string(index);
+  }
+
+  PcapWriter::Config DefaultConfig() const {
+    PcapWriter::Config config;
+    config.path = path_;
+    return config;
+  }
+
+  const std::string path_;
+};
+
+}  // namespace
+
+TEST_F(PcapWriterTest, WritesIpv4UdpPackets) {
+  std::unique_ptr<PcapWriter> writer = PcapWriter::Create(DefaultConfig());
+  ASSERT_TRUE(writer);
+  const SocketAddress from("192.168.0.1", 1000);
+  const SocketAddress to("10.0.0.2", 2000);
+  const uint8_t kPayload[] = {1, 2, 3, 4, 5};
+  writer->WritePacket(from, to, kPayload, sizeof(kPayload), 3000001);
+  writer->WritePacket(to, from, kPayload, 2, 3000002);
+  writer->Flush();
+  EXPECT_EQ(writer->packets_captured(), 2);
+  EXPECT_EQ(writer->packets_dropped(), 0);
+
+  uint32_t snap_length = 0;
+  std::vector<CapturedPacket> packets = ReadPcapFile(path_, &snap_length);
+  EXPECT_EQ(snap_length, 262144u);
+  ASSERT_EQ(packets.size(), 2u);
+  const size_t kHeadersSize =
+      kEthernetHeaderSize + kIpv4HeaderSize + kUdpHeaderSize;
+
+  const CapturedPacket& packet = packets[0];
+  EXPECT_EQ(packet.time_us, 3000001);
+  EXPECT_EQ(packet.original_size, kHeadersSize + sizeof(kPayload));
+  ASSERT_EQ(packet.frame.size(), kHeadersSize + sizeof(kPayload));
+  EXPECT_EQ(GetBE16(&packet.frame[12]), 0x0800);
+  const uint8_t* ip = &packet.frame[kEthernetHeaderSize];
+  EXPECT_EQ(ip[0], 0x45);
+  EXPECT_EQ(GetBE16(ip + 2), kIpv4HeaderSize + kUdpHeaderSize + 5);
+  EXPECT_EQ(ip[9], 17);
+  EXPECT_EQ(GetBE32(ip + 12), from.ipaddr().v4AddressAsHostOrderInteger());
+  EXPECT_EQ(GetBE32(ip + 16), to.ipaddr().v4AddressAsHostOrderInteger());
+  // A valid header checksums to zero.
+  uint32_t sum = 0;
+  for (size_t i = 0; i < kIpv4HeaderSize; i += 2)
+    sum += GetBE16(ip + i);
+  while (sum >> 16)
+    sum = (sum & 0xffff) + (sum >> 16);
+  EXPECT_EQ(sum, 0xffffu);
+  const uint8_t* udp = ip + kIpv4HeaderSize;
+  EXPECT_EQ(GetBE16(udp), 1000);
+  EXPECT_EQ(GetBE16(udp + 2), 2000);
+  EXPECT_EQ(GetBE16(udp + 4), kUdpHeaderSize + 5);
+  EXPECT_EQ(memcmp(udp + kUdpHeaderSize, kPayload, sizeof(kPayload)), 0);
+
+  EXPECT_EQ(packets[1].time_us, 3000002);
+  EXPECT_EQ(GetBE16(&packets[1].frame[kEthernetHeaderSize + kIpv4HeaderSize]),
+            2000);
+}
+
+TEST_F(PcapWriterTest, WritesIpv6UdpPackets) {
+  std::unique_ptr<PcapWriter> writer = PcapWriter::Create(DefaultConfig());
+  ASSERT_TRUE(writer);
+  const SocketAddress from("2001:db8::1", 1000);
+  const SocketAddress to("2001:db8::2", 2000);
+  const uint8_t kPayload[] = {1, 2, 3};
+  writer->WritePacket(from, to, kPayload, sizeof(kPayload), 0);
+  writer->Flush();
+
+  std::vector<CapturedPacket> packets = ReadPcapFile(path_, nullptr);
+  ASSERT_EQ(packets.size(), 1u);
+  const std::vector<uint8_t>& frame = packets[0].frame;
+  ASSERT_EQ(frame.size(), kEthernetHeaderSize + kIpv6HeaderSize +
+                              kUdpHeaderSize + sizeof(kPayload));
+  EXPECT_EQ(GetBE16(&frame[12]), 0x86dd);
+  const uint8_t* ip = &frame[kEthernetHeaderSize];
+  EXPECT_EQ(ip[0] >> 4, 6);
+  EXPECT_EQ(GetBE16(ip + 4), kUdpHeaderSize + sizeof(kPayload));
+  EXPECT_EQ(ip[6], 17);
+  in6_addr address = from.ipaddr().ipv6_address();
+  EXPECT_EQ(memcmp(ip + 8, &address, 16), 0);
+  address = to.ipaddr().ipv6_address();
+  EXPECT_EQ(memcmp(ip + 24, &address, 16), 0);
+  EXPECT_EQ(GetBE16(ip + kIpv6HeaderSize + 2), 2000);
+}
+
+TEST_F(PcapWriterTest, SnapLengthCoversLargestIpv6Packet) {
+  std::unique_ptr<PcapWriter> writer = PcapWriter::Create(DefaultConfig());
+  ASSERT_TRUE(writer);
+  const std::vector<uint8_t> payload(65507, 0xab);
+  writer->WritePacket(SocketAddress("2001:db8::1", 1),
+                      SocketAddress("2001:db8::2", 2), payload.data(),
+                      payload.size(), 0);
+  writer->Flush();
+
+  uint32_t snap_length = 0;
+  std::vector<CapturedPacket> packets = ReadPcapFile(path_, &snap_length);
+  ASSERT_EQ(packets.size(), 1u);
+  const size_t kFrameSize = kEthernetHeaderSize + kIpv6HeaderSize +
+                            kUdpHeaderSize + payload.size();
+  EXPECT_EQ(packets[0].frame.size(), kFrameSize);
+  EXPECT_EQ(packets[0].original_size, kFrameSize);
+  EXPECT_GE(snap_length, kFrameSize);
+}
+
+TEST_F(PcapWriterTest, TruncatesToSnapLength) {
+  PcapWriter::Config config = DefaultConfig();
+  config.snap_length = 4;
+  std::unique_ptr<PcapWriter> writer = PcapWriter::Create(config);
+  ASSERT_TRUE(writer);
+  const std::vector<uint8_t> payload(100, 0xab);
+  writer->WritePacket(SocketAddress("1.1.1.1", 1), SocketAddress("2.2.2.2", 2),
+                      payload.data(), payload.size(), 0);
+  writer->Flush();
+
+  std::vector<CapturedPacket> packets = ReadPcapFile(path_, nullptr);
+  ASSERT_EQ(packets.size(), 1u);
+  const size_t kHeadersSize =
+      kEthernetHeaderSize + kIpv4HeaderSize + kUdpHeaderSize;
+  EXPECT_EQ(packets[0].frame.size(), kHeadersSize + 4);
+  EXPECT_EQ(packets[0].original_size, kHeadersSize + payload.size());
+}
+
+TEST_F(PcapWriterTest, WritesPacketsInBackground) {
+  PcapWriter::Config config = DefaultConfig();
+  config.flush_interval_ms = 1;
+  std::unique_ptr<PcapWriter> writer = PcapWriter::Create(config);
+  ASSERT_TRUE(writer);
+  const std::vector<uint8_t> payload(1000, 0);
+  const int kNumPackets = 1000;
+  for (int i = 0; i < kNumPackets; ++i) {
+    writer->WritePacket(SocketAddress("1.1.1.1", 1),
+                        SocketAddress("2.2.2.2", 2), payload.data(),
+                        payload.size(), i);
+  }
+  // Destroying the writer writes the remaining packets.
+  writer.reset();
+  EXPECT_EQ(ReadPcapFile(path_, nullptr).size(),
+            static_cast<size_t>(kNumPackets));
+}
+
+TEST_F(PcapWriterTest, DropsPacketsWhenBufferIsFull) {
+  PcapWriter::Config config = DefaultConfig();
+  // Use the minimum buffer size, 128 KiB, which holds two of the packets.
+  config.buffer_size = 0;
+  std::unique_ptr<PcapWriter> writer = PcapWriter::Create(config);
+  ASSERT_TRUE(writer);
+  const std::vector<uint8_t> payload(60000, 0);
+  const int kNumPackets = 100;
+  for (int i = 0; i < kNumPackets; ++i) {
+    writer->WritePacket(SocketAddress("1.1.1.1", 1),
+                        SocketAddress("2.2.2.2", 2), payload.data(),
+                        payload.size(), i);
+  }
+  // How many packets are dropped depends on how quickly the background
+  // thread writes them, but every packet is either captured or dropped.
+  EXPECT_GE(writer->packets_captured(), 2);
+  EXPECT_EQ(writer->packets_captured() + writer->packets_dropped(),
+            kNumPackets);
+  writer->Flush();
+  EXPECT_EQ(ReadPcapFile(path_, nullptr).size(),
+            static_cast<size_t>(writer->packets_captured()));
+}
+
+TEST_F(PcapWriterTest, RotatesFiles) {
+  PcapWriter::Config config = DefaultConfig();
+  // Room for two packets per file.
+  config.max_file_size = 2500;
+  config.max_files = 2;
+  std::unique_ptr<PcapWriter> writer = PcapWriter::Create(config);
+  ASSERT_TRUE(writer);
+  const std::vector<uint8_t> payload(1000, 0);
+  for (int i = 0; i < 7; ++i) {
+    writer->WritePacket(SocketAddress("1.1.1.1", 1),
+                        SocketAddress("2.2.2.2", 2), payload.data(),
+                        payload.size(), i);
+  }
+  writer->Flush();
+
+  // Files 0 and 1 were deleted to keep at most two files.
+  EXPECT_FALSE(webrtc::test::FileExists(FilePath(0)));
+  EXPECT_FALSE(webrtc::test::FileExists(FilePath(1)));
+  std::vector<CapturedPacket> packets = ReadPcapFile(FilePath(2), nullptr);
+  ASSERT_EQ(packets.size(), 2u);
+  EXPECT_EQ(packets[0].time_us, 4);
+  packets = ReadPcapFile(FilePath(3), nullptr);
+  ASSERT_EQ(packets.size(), 1u);
+  EXPECT_EQ(packets[0].time_us, 6);
+}
+
+TEST_F(PcapWriterTest, FailsToOpenFile) {
+  PcapWriter::Config config;
+  config.path = "/nonexistent/directory/capture.pcap";
+  EXPECT_FALSE(PcapWriter::Create(config));
+}
+
+}  // namespace rtc
@@ -93,6 +93,11 @@ int64_t GetSocketRecvTimestamp(int socket) {
 typedef char* SockOptArg;
 #endif
 
+#if defined(WEBRTC_POSIX) && defined(IP_RECVTOS) && defined(IPV6_RECVTCLASS)
+// The ECN codepoint of received packets can be read with ::recvmsg().
+#define WEBRTC_USE_RECV_ECN 1
+#endif
+
 #if defined(WEBRTC_USE_EPOLL)
 // POLLRDHUP / EPOLLRDHUP are only defined starting with Linux 2.6.17.
 #if !defined(POLLRDHUP)
@@ -215,6 +220,7 @@ int PhysicalSocket::Bind(const SocketAddress& bind_addr) {
   sockaddr* addr = reinterpret_cast<sockaddr*>(&addr_storage);
   int err = ::bind(s_, addr, static_cast<int>(len));
   UpdateLastError();
+  capture_local_addr_.Clear();
 #if !defined(NDEBUG)
   if (0 == err) {
     dbg_addr_ = "Bound @ ";
@@ -252,6 +258,8 @@ int PhysicalSocket::DoConnect(const SocketAddress& connect_addr) {
   sockaddr* addr = reinterpret_cast<sockaddr*>(&addr_storage);
   int err = ::connect(s_, addr, static_cast<int>(len));
   UpdateLastError();
+  capture_local_addr_.Clear();
+  capture_remote_addr_.Clear();
   uint8_t events = DE_READ | DE_WRITE;
   if (err == 0) {
     state_ = CS_CONNECTED;
@@ -281,6 +289,14 @@ AsyncSocket::ConnState PhysicalSocket::GetState() const {
 }
 
 int PhysicalSocket::GetOption(Option opt, int* value) {
+  if (opt == OPT_SEND_ECN) {
+    *value = static_cast<int>(send_ecn_);
+    return 0;
+  }
+  if (opt == OPT_RECV_ECN) {
+    *value = recv_ecn_ ? 1 : 0;
+    return 0;
+  }
   int slevel;
   int sopt;
   if (TranslateOption(opt, &slevel, &sopt) == -1)
@@ -304,6 +320,12 @@ int PhysicalSocket::GetOption(Option opt, int* value) {
 }
 
 int PhysicalSocket::SetOption(Option opt, int value) {
+  if (opt == OPT_SEND_ECN) {
+    send_ecn_ = static_cast<EcnMarking>(value & 0x3);
+    return SetTrafficClass();
+  }
+  if (opt == OPT_RECV_ECN)
+    return SetRecvEcn(value != 0);
   int slevel;
   int sopt;
   if (TranslateOption(opt, &slevel, &sopt) == -1)
@@ -313,11 +335,20 @@ int PhysicalSocket::SetOption(Option opt, int value) {
     value = (value) ? IP_PMTUDISC_DO : IP_PMTUDISC_DONT;
 #endif
   } else if (opt == OPT_DSCP) {
-#if defined(WEBRTC_POSIX)
-    // shift DSCP value to fit six most significant bits of IP DiffServ field
-    value <<= 2;
-#endif
+    dscp_ = value;
+    return SetTrafficClass();
   }
+  return ::setsockopt(s_, slevel, sopt, (SockOptArg)&value, sizeof(value));
+}
+
+int PhysicalSocket::SetTrafficClass() {
+  int slevel;
+  int sopt;
+  if (TranslateOption(OPT_DSCP, &slevel, &sopt) == -1)
+    return -1;
+  // DSCP is the six most significant bits of the IP DiffServ field and ECN
+  // the two least significant bits.
+  int value = (dscp_ << 2) | static_cast<int>(send_ecn_);
 #if defined(WEBRTC_POSIX)
   if (sopt == IPV6_TCLASS) {
     // Set the IPv4 option in all cases to support dual-stack sockets.
@@ -327,6 +358,27 @@ int PhysicalSocket::SetOption(Option opt, int value) {
   return ::setsockopt(s_, slevel, sopt, (SockOptArg)&value, sizeof(value));
 }
 
+int PhysicalSocket::SetRecvEcn(bool enable) {
+#if defined(WEBRTC_USE_RECV_ECN)
+  int value = enable ? 1 : 0;
+  int ret;
+  if (family_ == AF_INET6) {
+    ret = ::setsockopt(s_, IPPROTO_IPV6, IPV6_RECVTCLASS, &value,
+                       sizeof(value));
+    // Also for IPv4 packets on dual-stack sockets.
+    ::setsockopt(s_, IPPROTO_IP, IP_RECVTOS, &value, sizeof(value));
+  } else {
+    ret = ::setsockopt(s_, IPPROTO_IP, IP_RECVTOS, &value, sizeof(value));
+  }
+  if (ret == 0)
+    recv_ecn_ = enable;
+  return ret;
+#else
+  RTC_LOG(LS_WARNING) << "Socket::OPT_RECV_ECN not supported.";
+  return -1;
+#endif
+}
+
 int PhysicalSocket::Send(const void* pv, size_t cb) {
   int sent = DoSend(
       s_, reinterpret_cast<const char*>(pv), static_cast<int>(cb),
@@ -343,6 +395,7 @@ int PhysicalSocket::Send(const void* pv, size_t cb) {
   );
   UpdateLastError();
   MaybeRemapSendError();
+  MaybeCapturePacket(/*outgoing=*/true, nullptr, pv, sent);
   // We have seen minidumps where this may be false.
   RTC_DCHECK(sent <= static_cast<int>(cb));
   if ((sent > 0 && sent < static_cast<int>(cb)) ||
@@ -368,6 +421,7 @@ int PhysicalSocket::SendTo(const void* buffer,
                reinterpret_cast<sockaddr*>(&saddr), static_cast<int>(len));
   UpdateLastError();
   MaybeRemapSendError();
+  MaybeCapturePacket(/*outgoing=*/true, &addr, buffer, sent);
   // We have seen minidumps where this may be false.
   RTC_DCHECK(sent <= static_cast<int>(length));
   if ((sent > 0 && sent < static_cast<int>(length)) ||
@@ -379,7 +433,9 @@ int PhysicalSocket::SendTo(const void* buffer,
 
 int PhysicalSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
   int received =
-      ::recv(s_, static_cast<char*>(buffer), static_cast<int>(length), 0);
+      recv_ecn_
+          ? RecvWithEcn(buffer, length, nullptr, nullptr)
+          : ::recv(s_, static_cast<char*>(buffer), static_cast<int>(length), 0);
   if ((received == 0) && (length != 0)) {
     // Note: on graceful shutdown, recv can return 0.  In this case, we
     // pretend it is blocking, and then signal close, so that simplifying
@@ -395,6 +451,7 @@ int PhysicalSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
     *timestamp = GetSocketRecvTimestamp(s_);
   }
   UpdateLastError();
+  MaybeCapturePacket(/*outgoing=*/false, nullptr, buffer, received);
   int error = GetError();
   bool success = (received >= 0) || IsBlockingError(error);
   if (udp_ || success) {
@@ -413,14 +470,21 @@ int PhysicalSocket::RecvFrom(void* buffer,
   sockaddr_storage addr_storage;
   socklen_t addr_len = sizeof(addr_storage);
   sockaddr* addr = reinterpret_cast<sockaddr*>(&addr_storage);
-  int received = ::recvfrom(s_, static_cast<char*>(buffer),
-                            static_cast<int>(length), 0, addr, &addr_len);
+  int received =
+      recv_ecn_ ? RecvWithEcn(buffer, length, addr, &addr_len)
+                : ::recvfrom(s_, static_cast<char*>(buffer),
+                             static_cast<int>(length), 0, addr, &addr_len);
   if (timestamp) {
     *timestamp = GetSocketRecvTimestamp(s_);
   }
   UpdateLastError();
   if ((received >= 0) && (out_addr != nullptr))
     SocketAddressFromSockAddrStorage(addr_storage, out_addr);
+  if (received > 0 && ss_->packet_capture()) {
+    SocketAddress remote_addr;
+    SocketAddressFromSockAddrStorage(addr_storage, &remote_addr);
+    MaybeCapturePacket(/*outgoing=*/false, &remote_addr, buffer, received);
+  }
   int error = GetError();
   bool success = (received >= 0) || IsBlockingError(error);
   if (udp_ || success) {
@@ -432,6 +496,79 @@ int PhysicalSocket::RecvFrom(void* buffer,
   return received;
 }
 
+EcnMarking PhysicalSocket::GetLastReceivedEcn() const {
+  return last_received_ecn_;
+}
+
+int PhysicalSocket::RecvWithEcn(void* buffer,
+                                size_t length,
+                                sockaddr* addr,
+                                socklen_t* addr_len) {
+  last_received_ecn_ = EcnMarking::kNotEct;
+#if defined(WEBRTC_USE_RECV_ECN)
+  iovec iov;
+  iov.iov_base = buffer;
+  iov.iov_len = length;
+  // Room for the IP_TOS or IPV6_TCLASS control message.
+  alignas(cmsghdr) char control[2 * CMSG_SPACE(sizeof(int))];
+  msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_name = addr;
+  msg.msg_namelen = addr_len ? *addr_len : 0;
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  int received = ::recvmsg(s_, &msg, 0);
+  if (addr_len)
+    *addr_len = msg.msg_namelen;
+  if (received < 0)
+    return received;
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+    if (cmsg->cmsg_level == IPPROTO_IP &&
+        (cmsg->cmsg_type == IP_TOS || cmsg->cmsg_type == IP_RECVTOS)) {
+      // A single byte.
+      last_received_ecn_ = static_cast<EcnMarking>(*CMSG_DATA(cmsg) & 0x3);
+    } else if (cmsg->cmsg_level == IPPROTO_IPV6 &&
+               cmsg->cmsg_type == IPV6_TCLASS) {
+      int traffic_class;
+      memcpy(&traffic_class, CMSG_DATA(cmsg), sizeof(traffic_class));
+      last_received_ecn_ = static_cast<EcnMarking>(traffic_class & 0x3);
+    }
+  }
+  return received;
+#else
+  if (!addr)
+    return ::recv(s_, static_cast<char*>(buffer), static_cast<int>(length), 0);
+  return ::recvfrom(s_, static_cast<char*>(buffer), static_cast<int>(length),
+                    0, addr, addr_len);
+#endif
+}
+
+void PhysicalSocket::MaybeCapturePacket(bool outgoing,
+                                        const SocketAddress* remote,
+                                        const void* data,
+                                        int size) {
+  PcapWriter* capture = ss_->packet_capture();
+  if (!capture || !udp_ || size <= 0)
+    return;
+  if (capture_local_addr_.IsNil())
+    capture_local_addr_ = GetLocalAddress();
+  if (!remote) {
+    if (capture_remote_addr_.IsNil())
+      capture_remote_addr_ = GetRemoteAddress();
+    remote = &capture_remote_addr_;
+  }
+  if (outgoing) {
+    capture->WritePacket(capture_local_addr_, *remote, data, size,
+                         TimeUTCMicros());
+  } else {
+    capture->WritePacket(*remote, capture_local_addr_, data, size,
+                         TimeUTCMicros());
+  }
+}
+
 int PhysicalSocket::Listen(int backlog) {
   int err = ::listen(s_, backlog);
   UpdateLastError();
@@ -586,6 +723,9 @@ int PhysicalSocket::TranslateOption(Option opt, int* slevel, int* sopt) {
 #endif
     case OPT_RTP_SENDTIME_EXTN_ID:
       return -1;  // No logging is necessary as this not a OS socket option.
+    case OPT_SEND_ECN:
+    case OPT_RECV_ECN:
+      return -1;  // Handled by SetOption() and GetOption().
     default:
       RTC_NOTREACHED();
       return -1;
@@ -16,12 +16,14 @@
 #define WEBRTC_USE_EPOLL 1
 #endif
 
+#include <atomic>
 #include <memory>
 #include <set>
 #include <vector>
 
 #include "rtc_base/critical_section.h"
 #include "rtc_base/net_helpers.h"
+#include "rtc_base/pcap_writer.h"
 #include "rtc_base/socket_server.h"
 #include "rtc_base/system/rtc_export.h"
 
@@ -79,6 +81,14 @@ class RTC_EXPORT PhysicalSocketServer : public SocketServer {
   void Remove(Dispatcher* dispatcher);
   void Update(Dispatcher* dispatcher);
 
+  // Captures the UDP packets sent and received by all sockets of this server
+  // to |capture|, or stops capturing if null. |capture| must outlive its use
+  // by the sockets.
+  void SetPacketCapture(PcapWriter* capture) { packet_capture_ = capture; }
+  PcapWriter* packet_capture() const {
+    return packet_capture_.load(std::memory_order_relaxed);
+  }
+
  private:
   typedef std::set<Dispatcher*> DispatcherSet;
 
@@ -107,6 +117,7 @@ class RTC_EXPORT PhysicalSocketServer : public SocketServer {
   const WSAEVENT socket_ev_;
 #endif
   bool fWait_;
+  std::atomic<PcapWriter*> packet_capture_{nullptr};
 };
 
 class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
@@ -141,6 +152,7 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
                size_t length,
                SocketAddress* out_addr,
                int64_t* timestamp) override;
+  EcnMarking GetLastReceivedEcn() const override;
 
   int Listen(int backlog) override;
   AsyncSocket* Accept(SocketAddress* out_addr) override;
@@ -178,6 +190,23 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
 
   int TranslateOption(Option opt, int* slevel, int* sopt);
 
+  // Sets the IP TOS / traffic class field from |dscp_| and |send_ecn_|.
+  int SetTrafficClass();
+  int SetRecvEcn(bool enable);
+  // Receives with ::recvmsg() to read the ECN codepoint of the packet into
+  // |last_received_ecn_|. |addr| may be null.
+  int RecvWithEcn(void* buffer,
+                  size_t length,
+                  sockaddr* addr,
+                  socklen_t* addr_len);
+
+  // Passes a UDP packet to the packet capture of the socket server, if any.
+  // |remote| is null for packets on a connected socket.
+  void MaybeCapturePacket(bool outgoing,
+                          const SocketAddress* remote,
+                          const void* data,
+                          int size);
+
   PhysicalSocketServer* ss_;
   SOCKET s_;
   bool udp_;
@@ -186,6 +215,15 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
   int error_ RTC_GUARDED_BY(crit_);
   ConnState state_;
   AsyncResolver* resolver_;
+  // Addresses used for packet capture, looked up on the first captured packet
+  // to avoid a system call per packet.
+  SocketAddress capture_local_addr_;
+  SocketAddress capture_remote_addr_;
+  // Both make up the IP TOS / traffic class field of outgoing packets.
+  int dscp_ = 0;
+  EcnMarking send_ecn_ = EcnMarking::kNotEct;
+  bool recv_ecn_ = false;
+  EcnMarking last_received_ecn_ = EcnMarking::kNotEct;
 
 #if !defined(NDEBUG)
   std::string dbg_addr_;
@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <memory>
 
+#include "rtc_base/dscp.h"
 #include "rtc_base/gunit.h"
 #include "rtc_base/ip_address.h"
 #include "rtc_base/logging.h"
@@ -122,6 +123,7 @@ class PhysicalSocketTest : public SocketTest {
 
   void ConnectInternalAcceptError(const IPAddress& loopback);
   void WritableAfterPartialWrite(const IPAddress& loopback);
+  void SocketEcn(const IPAddress& loopback);
 
   std::unique_ptr<FakePhysicalSocketServer> server_;
   rtc::AutoSocketServerThread thread_;
@@ -461,6 +463,55 @@ TEST_F(PhysicalSocketTest, TestSocketRecvTimestampIPv6) {
 }
 #endif
 
+#if defined(WEBRTC_LINUX)
+void PhysicalSocketTest::SocketEcn(const IPAddress& loopback) {
+  std::unique_ptr<Socket> socket(
+      server_->CreateSocket(loopback.family(), SOCK_DGRAM));
+  ASSERT_EQ(0, socket->Bind(SocketAddress(loopback, 0)));
+  SocketAddress address = socket->GetLocalAddress();
+  char buffer[3];
+
+  // Not reported until enabled.
+  ASSERT_EQ(0, socket->SetOption(Socket::OPT_SEND_ECN,
+                                 static_cast<int>(EcnMarking::kEct1)));
+  socket->SendTo("foo", 3, address);
+  EXPECT_EQ(3, socket->RecvFrom(buffer, 3, nullptr, nullptr));
+  EXPECT_EQ(EcnMarking::kNotEct, socket->GetLastReceivedEcn());
+
+  ASSERT_EQ(0, socket->SetOption(Socket::OPT_RECV_ECN, 1));
+  int value;
+  ASSERT_EQ(0, socket->GetOption(Socket::OPT_RECV_ECN, &value));
+  EXPECT_EQ(1, value);
+  socket->SendTo("foo", 3, address);
+  EXPECT_EQ(3, socket->RecvFrom(buffer, 3, nullptr, nullptr));
+  EXPECT_EQ(EcnMarking::kEct1, socket->GetLastReceivedEcn());
+
+  // The ECN field is kept when DSCP is changed.
+  ASSERT_EQ(0, socket->SetOption(Socket::OPT_DSCP, DSCP_AF41));
+  ASSERT_EQ(0, socket->GetOption(Socket::OPT_DSCP, &value));
+  EXPECT_EQ(DSCP_AF41, value);
+  socket->SendTo("foo", 3, address);
+  EXPECT_EQ(3, socket->RecvFrom(buffer, 3, nullptr, nullptr));
+  EXPECT_EQ(EcnMarking::kEct1, socket->GetLastReceivedEcn());
+
+  ASSERT_EQ(0, socket->SetOption(Socket::OPT_SEND_ECN,
+                                 static_cast<int>(EcnMarking::kNotEct)));
+  socket->SendTo("foo", 3, address);
+  EXPECT_EQ(3, socket->RecvFrom(buffer, 3, nullptr, nullptr));
+  EXPECT_EQ(EcnMarking::kNotEct, socket->GetLastReceivedEcn());
+}
+
+TEST_F(PhysicalSocketTest, TestSocketEcnIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketEcn(kIPv4Loopback);
+}
+
+TEST_F(PhysicalSocketTest, TestSocketEcnIPv6) {
+  MAYBE_SKIP_IPV6;
+  SocketEcn(kIPv6Loopback);
+}
+#endif
+
 // Verify that if the socket was unable to be bound to a real network interface
 // (not loopback), Bind will return an error.
 TEST_F(PhysicalSocketTest,
@@ -26,6 +26,7 @@
 #endif
 
 #include "rtc_base/constructor_magic.h"
+#include "rtc_base/network/ecn_marking.h"
 #include "rtc_base/socket_address.h"
 
 // Rather than converting errors into a private namespace,
@@ -98,6 +99,10 @@ class Socket {
                        size_t cb,
                        SocketAddress* paddr,
                        int64_t* timestamp) = 0;
+  // Returns the ECN codepoint of the packet most recently returned by Recv()
+  // or RecvFrom(). Only reported when OPT_RECV_ECN is enabled, and otherwise
+  // kNotEct.
+  virtual EcnMarking GetLastReceivedEcn() const { return EcnMarking::kNotEct; }
   virtual int Listen(int backlog) = 0;
   virtual Socket* Accept(SocketAddress* paddr) = 0;
   virtual int Close() = 0;
@@ -118,6 +123,10 @@ class Socket {
     OPT_RTP_SENDTIME_EXTN_ID,  // This is a non-traditional socket option param.
                                // This is specific to libjingle and will be used
                                // if SendTime option is needed at socket level.
+    OPT_SEND_ECN,              // ECN codepoint set on outgoing packets, see
+                               // EcnMarking.
+    OPT_RECV_ECN,              // Whether to report the ECN codepoint of
+                               // received packets.
   };
   virtual int GetOption(Option opt, int* value) = 0;
   virtual int SetOption(Option opt, int value) = 0;
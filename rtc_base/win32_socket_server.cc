@@ -565,6 +565,12 @@ int Win32Socket::TranslateOption(Option opt, int* slevel, int* sopt) {
     case OPT_DSCP:
       RTC_LOG(LS_WARNING) << "Socket::OPT_DSCP not supported.";
       return -1;
+    case OPT_SEND_ECN:
+      RTC_LOG(LS_WARNING) << "Socket::OPT_SEND_ECN not supported.";
+      return -1;
+    case OPT_RECV_ECN:
+      RTC_LOG(LS_WARNING) << "Socket::OPT_RECV_ECN not supported.";
+      return -1;
     default:
       RTC_NOTREACHED();
       return -1;
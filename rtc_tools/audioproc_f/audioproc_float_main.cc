@@ -15,5 +15,6 @@
 
 int main(int argc, char* argv[]) {
   return webrtc::test::AudioprocFloat(
-      std::make_unique<webrtc::AudioProcessingBuilder>(), argc, argv);
+      [] { return std::make_unique<webrtc::AudioProcessingBuilder>(); }, argc,
+      argv);
 }
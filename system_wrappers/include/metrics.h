@@ -368,7 +368,10 @@ enum { kMinRunTimeInSeconds = 10 };
 class Histogram;
 
 // Functions for getting pointer to histogram (constructs or finds the named
-// histogram).
+// histogram). The returned pointer stays valid for the lifetime of the process,
+// so call sites that cannot use the caching RTC_HISTOGRAM_* macros (e.g.
+// because the name is built at runtime) can look the histogram up once and
+// keep the pointer for HistogramAdd().
 
 // Get histogram for counters.
 Histogram* HistogramFactoryGetCounts(const std::string& name,
@@ -392,7 +395,8 @@ Histogram* HistogramFactoryGetEnumeration(const std::string& name,
 Histogram* SparseHistogramFactoryGetEnumeration(const std::string& name,
                                                 int boundary);
 
-// Function for adding a |sample| to a histogram.
+// Function for adding a |sample| to a histogram. Does not allocate or take
+// locks in the default implementation.
 void HistogramAdd(Histogram* histogram_pointer, int sample);
 
 struct SampleInfo {
@@ -414,6 +418,11 @@ void Enable();
 void GetAndReset(
     std::map<std::string, std::unique_ptr<SampleInfo>>* histograms);
 
+// Gets a copy of the histograms without clearing any samples, e.g. for
+// periodic export. Samples added concurrently may or may not be included.
+void GetSnapshot(
+    std::map<std::string, std::unique_ptr<SampleInfo>>* histograms);
+
 // Functions below are mainly for testing.
 
 // Clears all samples.
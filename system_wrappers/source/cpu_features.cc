@@ -34,19 +34,34 @@ static inline void __cpuid(int cpu_info[4], int info_type) {
       "xchg %%edi, %%ebx\n"
       : "=a"(cpu_info[0]), "=D"(cpu_info[1]), "=c"(cpu_info[2]),
         "=d"(cpu_info[3])
-      : "a"(info_type));
+      : "a"(info_type), "c"(0));
 }
 #else
 static inline void __cpuid(int cpu_info[4], int info_type) {
   __asm__ volatile("cpuid\n"
                    : "=a"(cpu_info[0]), "=b"(cpu_info[1]), "=c"(cpu_info[2]),
                      "=d"(cpu_info[3])
-                   : "a"(info_type));
+                   : "a"(info_type), "c"(0));
 }
 #endif
 #endif  // _MSC_VER
 #endif  // WEBRTC_ARCH_X86_FAMILY
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// xgetbv returns the value of an Intel Extended Control Register (XCR).
+// Currently only XCR0 is defined by Intel so |xcr| should always be zero.
+static uint64_t xgetbv(uint32_t xcr) {
+#if defined(_MSC_VER)
+  return _xgetbv(xcr);
+#else
+  uint32_t eax, edx;
+
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(xcr));
+  return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif  // _MSC_VER
+}
+#endif  // WEBRTC_ARCH_X86_FAMILY
+
 #if defined(WEBRTC_ARCH_X86_FAMILY)
 // Actual feature detection for x86.
 static int GetCPUInfo(CPUFeature feature) {
@@ -58,6 +73,29 @@ static int GetCPUInfo(CPUFeature feature) {
   if (feature == kSSE3) {
     return 0 != (cpu_info[2] & 0x00000001);
   }
+  if (feature == kSSE4_1) {
+    return 0 != (cpu_info[2] & 0x00080000);
+  }
+  if (feature == kAVX2) {
+    int cpu_info7[4];
+    __cpuid(cpu_info7, 0);
+    if (cpu_info7[0] < 7) {
+      return 0;
+    }
+    // The leaf 7 feature flags depend on the subleaf, which is 0 here.
+#if defined(_MSC_VER)
+    __cpuidex(cpu_info7, 7, 0);
+#else
+    __cpuid(cpu_info7, 7);
+#endif
+    // AVX2 and FMA can be used when the CPU supports AVX, AVX2 and FMA and the
+    // OS saves the YMM registers on context switches (OSXSAVE and XCR0).
+    return 0 != (cpu_info[2] & 0x10000000) /* AVX */ &&
+           0 != (cpu_info[2] & 0x00001000) /* FMA */ &&
+           0 != (cpu_info[2] & 0x08000000) /* OSXSAVE */ &&
+           (xgetbv(0) & 0x00000006) == 6 /* YMM state enabled by the OS */ &&
+           0 != (cpu_info7[1] & 0x00000020) /* AVX2 */;
+  }
   return 0;
 }
 #else
@@ -11,8 +11,13 @@
 
 #include <stddef.h>
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "rtc_base/checks.h"
@@ -68,6 +73,60 @@ bool FieldTrialsStringIsValidInternal(const absl::string_view trials) {
 
   return true;
 }
+
+// Immutable lookup table built once from a field trial string. Tables are
+// published through |g_trials_table|, so FindFullName needs no locks: a reader
+// that loaded a table just before it was replaced keeps using a consistent
+// snapshot. Replaced tables are never freed, since a reader may still hold
+// them; trials are only replaced at startup and in tests.
+class FieldTrialTable {
+ public:
+  explicit FieldTrialTable(absl::string_view trials_string) {
+    // Mirrors the old scanning lookup: stop at the first malformed entry and
+    // let the first occurrence of a duplicated trial win.
+    size_t next_item = 0;
+    while (next_item < trials_string.length()) {
+      size_t field_name_end =
+          trials_string.find(kPersistentStringSeparator, next_item);
+      if (field_name_end == trials_string.npos || field_name_end == next_item)
+        break;
+      size_t field_value_end =
+          trials_string.find(kPersistentStringSeparator, field_name_end + 1);
+      if (field_value_end == trials_string.npos ||
+          field_value_end == field_name_end + 1)
+        break;
+      trials_.emplace(
+          std::string(
+              trials_string.substr(next_item, field_name_end - next_item)),
+          std::string(trials_string.substr(
+              field_name_end + 1, field_value_end - field_name_end - 1)));
+      next_item = field_value_end + 1;
+    }
+  }
+
+  const std::string* Find(const std::string& name) const {
+    auto it = trials_.find(name);
+    return it == trials_.end() ? nullptr : &it->second;
+  }
+
+ private:
+  std::unordered_map<std::string, std::string> trials_;
+};
+
+std::atomic<const FieldTrialTable*> g_trials_table{nullptr};
+
+// Not thread safe with respect to itself, like InitFieldTrialsFromString.
+void PublishFieldTrialTable(const char* trials_string) {
+  // Kept reachable, so that leak checkers don't report them.
+  static std::vector<std::unique_ptr<const FieldTrialTable>>* const
+      retired_tables = new std::vector<std::unique_ptr<const FieldTrialTable>>();
+  const FieldTrialTable* previous = g_trials_table.exchange(
+      new FieldTrialTable(trials_string ? trials_string : ""),
+      std::memory_order_acq_rel);
+  if (previous) {
+    retired_tables->emplace_back(previous);
+  }
+}
 }  // namespace
 
 bool FieldTrialsStringIsValid(const char* trials_string) {
@@ -103,35 +162,9 @@ std::string MergeFieldTrialsStrings(const char* first, const char* second) {
 }
 
 std::string FindFullName(const std::string& name) {
-  if (trials_init_string == NULL)
-    return std::string();
-
-  std::string trials_string(trials_init_string);
-  if (trials_string.empty())
-    return std::string();
-
-  size_t next_item = 0;
-  while (next_item < trials_string.length()) {
-    // Find next name/value pair in field trial configuration string.
-    size_t field_name_end =
-        trials_string.find(kPersistentStringSeparator, next_item);
-    if (field_name_end == trials_string.npos || field_name_end == next_item)
-      break;
-    size_t field_value_end =
-        trials_string.find(kPersistentStringSeparator, field_name_end + 1);
-    if (field_value_end == trials_string.npos ||
-        field_value_end == field_name_end + 1)
-      break;
-    std::string field_name(trials_string, next_item,
-                           field_name_end - next_item);
-    std::string field_value(trials_string, field_name_end + 1,
-                            field_value_end - field_name_end - 1);
-    next_item = field_value_end + 1;
-
-    if (name == field_name)
-      return field_value;
-  }
-  return std::string();
+  const FieldTrialTable* table = g_trials_table.load(std::memory_order_acquire);
+  const std::string* group_name = table ? table->Find(name) : nullptr;
+  return group_name ? *group_name : std::string();
 }
 #endif  // WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
 
@@ -143,6 +176,7 @@ void InitFieldTrialsFromString(const char* trials_string) {
     RTC_DCHECK(FieldTrialsStringIsValidInternal(trials_string))
         << "Invalid field trials string:" << trials_string;
   };
+  PublishFieldTrialTable(trials_string);
 #endif  // WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
   trials_init_string = trials_string;
 }
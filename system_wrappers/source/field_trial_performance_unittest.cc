@@ -0,0 +1,167 @@
+/*
+ *  Copyright 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/transport/field_trial_based_config.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/field_trial.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumTrials = 200;
+constexpr int kNumLookups = 1000000;
+
+std::string TrialName(int index) {
+  char buffer[64];
+  rtc::SimpleStringBuilder name(buffer);
+  name << "WebRTC-PerfTestTrial-" << index;
+  return name.str();
+}
+
+// Roughly the size of the trial strings pushed to production clients.
+std::string CreateTrialsString() {
+  std::string trials;
+  for (int i = 0; i < kNumTrials; ++i) {
+    trials += TrialName(i) + "/Enabled,param:" + std::to_string(i) + "/";
+  }
+  return trials;
+}
+
+// Looks up trials spread over the whole string, once all threads have been
+// started.
+class TrialReader {
+ public:
+  explicit TrialReader(rtc::Event* start) : start_(start) {}
+
+  static void Run(void* obj) { static_cast<TrialReader*>(obj)->LookUp(); }
+
+  size_t total_size() const { return total_size_; }
+
+ private:
+  void LookUp() {
+    std::vector<std::string> names;
+    for (int i = 0; i < kNumTrials; i += kNumTrials / 10) {
+      names.push_back(TrialName(i));
+    }
+    start_->Wait(rtc::Event::kForever);
+    for (int i = 0; i < kNumLookups; ++i) {
+      total_size_ += field_trial::FindFullName(names[i % names.size()]).size();
+    }
+  }
+
+  rtc::Event* const start_;
+  size_t total_size_ = 0;
+};
+
+class FieldTrialPerformanceTest : public ::testing::Test {
+ protected:
+  FieldTrialPerformanceTest()
+      : previous_trials_(field_trial::GetFieldTrialString()),
+        trials_(CreateTrialsString()) {
+    field_trial::InitFieldTrialsFromString(trials_.c_str());
+  }
+  ~FieldTrialPerformanceTest() override {
+    field_trial::InitFieldTrialsFromString(previous_trials_);
+  }
+
+  void ReportLookupCost(const std::string& modifier,
+                        int64_t elapsed_ns) const {
+    test::PrintResult("field_trial_lookup_time_", modifier,
+                      std::to_string(kNumTrials) + "_trials",
+                      static_cast<double>(elapsed_ns) / kNumLookups, "ns",
+                      false, test::ImproveDirection::kSmallerIsBetter);
+  }
+
+ private:
+  const char* const previous_trials_;
+  const std::string trials_;
+};
+
+}  // namespace
+
+TEST_F(FieldTrialPerformanceTest, FindFullName) {
+  // Look up trials spread over the whole string, plus trials that are absent.
+  std::vector<std::string> present;
+  std::vector<std::string> absent;
+  for (int i = 0; i < kNumTrials; i += kNumTrials / 10) {
+    present.push_back(TrialName(i));
+    absent.push_back(TrialName(i + kNumTrials));
+  }
+
+  size_t total_size = 0;
+  int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < kNumLookups; ++i) {
+    total_size += field_trial::FindFullName(present[i % present.size()]).size();
+  }
+  ReportLookupCost("present", rtc::TimeNanos() - start_ns);
+  EXPECT_GT(total_size, 0u);
+
+  start_ns = rtc::TimeNanos();
+  for (int i = 0; i < kNumLookups; ++i) {
+    total_size += field_trial::FindFullName(absent[i % absent.size()]).size();
+  }
+  ReportLookupCost("absent", rtc::TimeNanos() - start_ns);
+
+  start_ns = rtc::TimeNanos();
+  int enabled = 0;
+  for (int i = 0; i < kNumLookups; ++i) {
+    enabled += field_trial::IsEnabled(present[i % present.size()].c_str());
+  }
+  ReportLookupCost("is_enabled", rtc::TimeNanos() - start_ns);
+  EXPECT_EQ(kNumLookups, enabled);
+}
+
+TEST_F(FieldTrialPerformanceTest, FindFullNameFromConcurrentThreads) {
+  for (int num_threads : {1, 2, 4, 8}) {
+    rtc::Event start(/*manual_reset=*/true, /*initially_signaled=*/false);
+    std::vector<std::unique_ptr<TrialReader>> readers;
+    std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+    for (int i = 0; i < num_threads; ++i) {
+      readers.push_back(std::make_unique<TrialReader>(&start));
+      threads.push_back(std::make_unique<rtc::PlatformThread>(
+          &TrialReader::Run, readers.back().get(), "FieldTrialPerfTest"));
+      threads.back()->Start();
+    }
+
+    const int64_t start_ns = rtc::TimeNanos();
+    start.Set();
+    for (auto& thread : threads)
+      thread->Stop();
+    // Wall time per lookup of all threads together, which drops as threads
+    // are added unless they contend or share cores.
+    ReportLookupCost(std::to_string(num_threads) + "_threads",
+                     (rtc::TimeNanos() - start_ns) / num_threads);
+    for (const auto& reader : readers)
+      EXPECT_GT(reader->total_size(), 0u);
+  }
+}
+
+TEST_F(FieldTrialPerformanceTest, KeyValueConfigLookup) {
+  const FieldTrialBasedConfig config;
+  const std::string key = TrialName(kNumTrials / 2);
+  size_t total_size = 0;
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < kNumLookups; ++i) {
+    total_size += config.Lookup(key).size();
+  }
+  ReportLookupCost("key_value_config", rtc::TimeNanos() - start_ns);
+  EXPECT_GT(total_size, 0u);
+}
+
+}  // namespace webrtc
@@ -9,7 +9,13 @@
  */
 #include "system_wrappers/include/field_trial.h"
 
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "rtc_base/checks.h"
+#include "rtc_base/platform_thread.h"
 #include "test/gtest.h"
 #include "test/testsupport/rtc_expect_death.h"
 
@@ -103,5 +109,80 @@ TEST(FieldTrialMergingTest, HandlesEmptyInput) {
 #endif  // GTEST_HAS_DEATH_TEST && RTC_DCHECK_IS_ON && !defined(WEBRTC_ANDROID)
         // && !defined(WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT)
 
+#if !defined(WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT)
+class FieldTrialLookupTest : public ::testing::Test {
+ protected:
+  FieldTrialLookupTest() : previous_trials_(GetFieldTrialString()) {}
+  ~FieldTrialLookupTest() override {
+    InitFieldTrialsFromString(previous_trials_);
+  }
+
+ private:
+  const char* const previous_trials_;
+};
+
+TEST_F(FieldTrialLookupTest, FindsGroupNames) {
+  InitFieldTrialsFromString("Audio/Enabled/Video/Disabled-50/");
+  EXPECT_EQ("Enabled", FindFullName("Audio"));
+  EXPECT_EQ("Disabled-50", FindFullName("Video"));
+  EXPECT_EQ("", FindFullName("Data"));
+  EXPECT_EQ("", FindFullName("Audi"));
+  EXPECT_TRUE(IsEnabled("Audio"));
+  EXPECT_TRUE(IsDisabled("Video"));
+}
+
+TEST_F(FieldTrialLookupTest, FirstOccurrenceOfDuplicateWins) {
+  InitFieldTrialsFromString("Audio/Enabled/B/C/Audio/Enabled/");
+  EXPECT_EQ("Enabled", FindFullName("Audio"));
+  EXPECT_EQ("C", FindFullName("B"));
+}
+
+TEST_F(FieldTrialLookupTest, ReplacesTrialsOnReinitialization) {
+  InitFieldTrialsFromString("Audio/Enabled/");
+  EXPECT_EQ("Enabled", FindFullName("Audio"));
+  InitFieldTrialsFromString("Video/Enabled/");
+  EXPECT_EQ("", FindFullName("Audio"));
+  EXPECT_EQ("Enabled", FindFullName("Video"));
+  InitFieldTrialsFromString(nullptr);
+  EXPECT_EQ("", FindFullName("Video"));
+  InitFieldTrialsFromString("");
+  EXPECT_EQ("", FindFullName("Video"));
+}
+
+TEST_F(FieldTrialLookupTest, ReadersSeeWholeTablesWhileReinitialized) {
+  constexpr int kNumReaders = 4;
+  struct ReaderState {
+    std::atomic<bool> done{false};
+    std::atomic<int> num_inconsistent_lookups{0};
+  } state;
+  InitFieldTrialsFromString("Audio/Enabled/Video/Enabled/");
+  std::vector<std::unique_ptr<rtc::PlatformThread>> readers;
+  for (int i = 0; i < kNumReaders; ++i) {
+    readers.push_back(std::make_unique<rtc::PlatformThread>(
+        [](void* obj) {
+          ReaderState* state = static_cast<ReaderState*>(obj);
+          while (!state->done.load()) {
+            const std::string audio = FindFullName("Audio");
+            if (audio != "Enabled" && audio != "Disabled") {
+              ++state->num_inconsistent_lookups;
+            }
+          }
+        },
+        &state, "FieldTrialReader"));
+    readers.back()->Start();
+  }
+  // Each initialization replaces the table the readers are looking up.
+  for (int i = 0; i < 1000; ++i) {
+    InitFieldTrialsFromString(i % 2 ? "Audio/Enabled/Video/Enabled/"
+                                    : "Video/Disabled/Audio/Disabled/");
+  }
+  state.done.store(true);
+  for (auto& reader : readers) {
+    reader->Stop();
+  }
+  EXPECT_EQ(state.num_inconsistent_lookups.load(), 0);
+}
+#endif  // !defined(WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT)
+
 }  // namespace field_trial
 }  // namespace webrtc
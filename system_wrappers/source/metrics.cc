@@ -10,6 +10,8 @@
 #include "system_wrappers/include/metrics.h"
 
 #include <algorithm>
+#include <atomic>
+#include <limits>
 
 #include "rtc_base/critical_section.h"
 #include "rtc_base/thread_annotations.h"
@@ -26,78 +28,182 @@ namespace {
 // TODO(asapersson): Consider using bucket count (and set up
 // linearly/exponentially spaced buckets) if samples are logged more frequently.
 const int kMaxSampleMapSize = 300;
+const uint32_t kMaxEventsPerSample = std::numeric_limits<int>::max();
 
+// Histogram storing the number of events per sample value in a fixed array of
+// slots, so that Add() never allocates or takes a lock.
+//
+// Each slot is a single 64-bit word holding the slot key in the upper 32 bits
+// and the number of events in the lower 32 bits. The key is the clamped sample
+// offset by min - 2, so that an all-zero word is a free slot. Keeping key and
+// count in one word lets Add() claim or increment a slot with a relaxed
+// compare-and-swap, and lets the readers clear a slot with an exchange that
+// cannot race with a concurrent increment of the cleared key.
+//
+// Slots are found by linear probing from |key & slot_mask_|; consecutive
+// sample values therefore map to consecutive slots. Clearing slots may leave
+// holes in a probe sequence, in which case a sample value can end up in more
+// than one slot. Readers merge such duplicates.
 class RtcHistogram {
  public:
   RtcHistogram(const std::string& name, int min, int max, int bucket_count)
-      : min_(min), max_(max), info_(name, min, max, bucket_count) {
+      : min_(min),
+        max_(max),
+        name_(name),
+        bucket_count_(bucket_count),
+        max_keys_(std::min<int64_t>(kMaxSampleMapSize,
+                                    int64_t{max} - int64_t{min} + 2)),
+        num_slots_(NumSlots(max_keys_)),
+        slot_mask_(num_slots_ - 1),
+        slots_(new std::atomic<uint64_t>[num_slots_]) {
     RTC_DCHECK_GT(bucket_count, 0);
+    RTC_DCHECK_LE(min, max);
+    for (size_t i = 0; i < num_slots_; ++i)
+      slots_[i].store(0, std::memory_order_relaxed);
   }
 
   void Add(int sample) {
     sample = std::min(sample, max_);
     sample = std::max(sample, min_ - 1);  // Underflow bucket.
 
-    rtc::CritScope cs(&crit_);
-    if (info_.samples.size() == kMaxSampleMapSize &&
-        info_.samples.find(sample) == info_.samples.end()) {
-      return;
+    const uint32_t key = KeyFromSample(sample);
+    for (size_t i = 0, index = key & slot_mask_; i < num_slots_;
+         ++i, index = (index + 1) & slot_mask_) {
+      std::atomic<uint64_t>& slot = slots_[index];
+      uint64_t word = slot.load(std::memory_order_relaxed);
+      while (true) {
+        const uint32_t slot_key = static_cast<uint32_t>(word >> 32);
+        if (slot_key == 0) {
+          // Sample value not stored yet, unless in a slot past a hole left by
+          // a concurrent reset. Only a new value is dropped once full.
+          if (num_keys_.load(std::memory_order_relaxed) >= max_keys_)
+            break;  // Probe the next slot.
+          if (slot.compare_exchange_weak(word, (uint64_t{key} << 32) | 1,
+                                         std::memory_order_relaxed)) {
+            num_keys_.fetch_add(1, std::memory_order_relaxed);
+            return;
+          }
+        } else if (slot_key == key) {
+          if (static_cast<uint32_t>(word) == kMaxEventsPerSample)
+            return;  // Saturated.
+          if (slot.compare_exchange_weak(word, word + 1,
+                                         std::memory_order_relaxed)) {
+            return;
+          }
+        } else {
+          break;  // Probe the next slot.
+        }
+        // |word| was updated by the failed compare-and-swap, try again.
+      }
     }
-    ++info_.samples[sample];
   }
 
   // Returns a copy (or nullptr if there are no samples) and clears samples.
   std::unique_ptr<SampleInfo> GetAndReset() {
-    rtc::CritScope cs(&crit_);
-    if (info_.samples.empty())
+    std::unique_ptr<SampleInfo> info = CreateSampleInfo();
+    for (size_t i = 0; i < num_slots_; ++i)
+      AddSlotTo(ClearSlot(i), &info->samples);
+    if (info->samples.empty())
       return nullptr;
+    return info;
+  }
 
-    SampleInfo* copy =
-        new SampleInfo(info_.name, info_.min, info_.max, info_.bucket_count);
-
-    std::swap(info_.samples, copy->samples);
-
-    return std::unique_ptr<SampleInfo>(copy);
+  // Returns a copy (or nullptr if there are no samples) without clearing.
+  std::unique_ptr<SampleInfo> GetSnapshot() const {
+    std::unique_ptr<SampleInfo> info = CreateSampleInfo();
+    info->samples = Samples();
+    if (info->samples.empty())
+      return nullptr;
+    return info;
   }
 
-  const std::string& name() const { return info_.name; }
+  const std::string& name() const { return name_; }
 
   // Functions only for testing.
   void Reset() {
-    rtc::CritScope cs(&crit_);
-    info_.samples.clear();
+    for (size_t i = 0; i < num_slots_; ++i)
+      ClearSlot(i);
   }
 
   int NumEvents(int sample) const {
-    rtc::CritScope cs(&crit_);
-    const auto it = info_.samples.find(sample);
-    return (it == info_.samples.end()) ? 0 : it->second;
+    if (sample < min_ - 1 || sample > max_)
+      return 0;
+    const uint32_t key = KeyFromSample(sample);
+    int num_events = 0;
+    for (size_t i = 0; i < num_slots_; ++i) {
+      const uint64_t word = slots_[i].load(std::memory_order_relaxed);
+      if (static_cast<uint32_t>(word >> 32) == key)
+        num_events += static_cast<int>(static_cast<uint32_t>(word));
+    }
+    return num_events;
   }
 
   int NumSamples() const {
     int num_samples = 0;
-    rtc::CritScope cs(&crit_);
-    for (const auto& sample : info_.samples) {
-      num_samples += sample.second;
+    for (size_t i = 0; i < num_slots_; ++i) {
+      const uint64_t word = slots_[i].load(std::memory_order_relaxed);
+      num_samples += static_cast<int>(static_cast<uint32_t>(word));
     }
     return num_samples;
   }
 
   int MinSample() const {
-    rtc::CritScope cs(&crit_);
-    return (info_.samples.empty()) ? -1 : info_.samples.begin()->first;
+    const std::map<int, int> samples = Samples();
+    return samples.empty() ? -1 : samples.begin()->first;
   }
 
   std::map<int, int> Samples() const {
-    rtc::CritScope cs(&crit_);
-    return info_.samples;
+    std::map<int, int> samples;
+    for (size_t i = 0; i < num_slots_; ++i)
+      AddSlotTo(slots_[i].load(std::memory_order_relaxed), &samples);
+    return samples;
   }
 
  private:
-  rtc::CriticalSection crit_;
+  // Smallest power of two with room for |max_keys| keys at a load factor of
+  // at most 2/3.
+  static size_t NumSlots(int64_t max_keys) {
+    size_t num_slots = 4;
+    while (static_cast<int64_t>(num_slots) * 2 < max_keys * 3)
+      num_slots *= 2;
+    return num_slots;
+  }
+
+  uint32_t KeyFromSample(int sample) const {
+    return static_cast<uint32_t>(int64_t{sample} - int64_t{min_} + 2);
+  }
+
+  int SampleFromKey(uint32_t key) const {
+    return static_cast<int>(int64_t{key} + int64_t{min_} - 2);
+  }
+
+  uint64_t ClearSlot(size_t index) {
+    const uint64_t word = slots_[index].exchange(0, std::memory_order_relaxed);
+    if (word != 0)
+      num_keys_.fetch_sub(1, std::memory_order_relaxed);
+    return word;
+  }
+
+  void AddSlotTo(uint64_t word, std::map<int, int>* samples) const {
+    const uint32_t key = static_cast<uint32_t>(word >> 32);
+    const int count = static_cast<int>(static_cast<uint32_t>(word));
+    if (key != 0 && count > 0)
+      (*samples)[SampleFromKey(key)] += count;
+  }
+
+  std::unique_ptr<SampleInfo> CreateSampleInfo() const {
+    return std::make_unique<SampleInfo>(name_, min_, max_, bucket_count_);
+  }
+
   const int min_;
   const int max_;
-  SampleInfo info_ RTC_GUARDED_BY(crit_);
+  const std::string name_;
+  const int bucket_count_;
+  const int64_t max_keys_;
+  const size_t num_slots_;
+  const size_t slot_mask_;
+  const std::unique_ptr<std::atomic<uint64_t>[]> slots_;
+  std::atomic<int64_t> num_keys_{0};
 
   RTC_DISALLOW_COPY_AND_ASSIGN(RtcHistogram);
 };
@@ -142,6 +248,16 @@ class RtcHistogramMap {
     }
   }
 
+  void GetSnapshot(
+      std::map<std::string, std::unique_ptr<SampleInfo>>* histograms) const {
+    rtc::CritScope cs(&crit_);
+    for (const auto& kv : map_) {
+      std::unique_ptr<SampleInfo> info = kv.second->GetSnapshot();
+      if (info)
+        histograms->insert(std::make_pair(kv.first, std::move(info)));
+    }
+  }
+
   // Functions only for testing.
   void Reset() {
     rtc::CritScope cs(&crit_);
@@ -297,6 +413,14 @@ void GetAndReset(
     map->GetAndReset(histograms);
 }
 
+void GetSnapshot(
+    std::map<std::string, std::unique_ptr<SampleInfo>>* histograms) {
+  histograms->clear();
+  RtcHistogramMap* map = GetMap();
+  if (map)
+    map->GetSnapshot(histograms);
+}
+
 void Reset() {
   RtcHistogramMap* map = GetMap();
   if (map)
@@ -150,6 +150,54 @@ TEST_F(MetricsDefaultTest, GetAndReset) {
   EXPECT_EQ(1, metrics::NumEvents("Histogram2", 8));
 }
 
+TEST_F(MetricsDefaultTest, GetSnapshotKeepsSamples) {
+  std::map<std::string, std::unique_ptr<metrics::SampleInfo>> histograms;
+  metrics::GetSnapshot(&histograms);
+  EXPECT_EQ(0u, histograms.size());
+  RTC_HISTOGRAM_PERCENTAGE("Histogram1", 4);
+  RTC_HISTOGRAM_PERCENTAGE("Histogram1", 5);
+  RTC_HISTOGRAM_PERCENTAGE("Histogram1", 5);
+
+  metrics::GetSnapshot(&histograms);
+  EXPECT_EQ(1u, histograms.size());
+  EXPECT_EQ(3, NumSamples("Histogram1", histograms));
+  EXPECT_EQ(1, NumEvents("Histogram1", 4, histograms));
+  EXPECT_EQ(2, NumEvents("Histogram1", 5, histograms));
+  EXPECT_EQ(3, metrics::NumSamples("Histogram1"));
+
+  RTC_HISTOGRAM_PERCENTAGE("Histogram1", 4);
+  metrics::GetSnapshot(&histograms);
+  EXPECT_EQ(4, NumSamples("Histogram1", histograms));
+  EXPECT_EQ(2, NumEvents("Histogram1", 4, histograms));
+}
+
+TEST_F(MetricsDefaultTest, StoresValuesSharingSlotsAfterReset) {
+  // Counts histograms are stored in probed slots. Values added after a reset
+  // may end up in a different slot than before, but must still be merged.
+  const std::string kName = "SlotsCounts100000";
+  for (int sample : {1, 2, 3})
+    RTC_HISTOGRAM_COUNTS_100000(kName, sample);
+  metrics::Reset();
+  for (int sample : {3, 2, 1, 2})
+    RTC_HISTOGRAM_COUNTS_100000(kName, sample);
+  EXPECT_EQ(4, metrics::NumSamples(kName));
+  EXPECT_EQ(1, metrics::NumEvents(kName, 1));
+  EXPECT_EQ(2, metrics::NumEvents(kName, 2));
+  EXPECT_EQ(1, metrics::NumEvents(kName, 3));
+  EXPECT_EQ(1, metrics::MinSample(kName));
+}
+
+TEST_F(MetricsDefaultTest, LimitsNumberOfDistinctValues) {
+  const std::string kName = "DistinctCounts100000";
+  for (int sample = 1; sample <= 1000; ++sample)
+    RTC_HISTOGRAM_COUNTS_100000(kName, sample);
+  EXPECT_EQ(300u, metrics::Samples(kName).size());
+  // Values that are already stored are still counted.
+  RTC_HISTOGRAM_COUNTS_100000(kName, 1);
+  EXPECT_EQ(2, metrics::NumEvents(kName, 1));
+  EXPECT_EQ(0, metrics::NumEvents(kName, 1000));
+}
+
 TEST_F(MetricsDefaultTest, TestMinMaxBucket) {
   const std::string kName = "MinMaxCounts100";
   RTC_HISTOGRAM_COUNTS_100(kName, 4);
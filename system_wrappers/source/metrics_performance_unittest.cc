@@ -0,0 +1,90 @@
+/*
+ *  Copyright 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/metrics.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+#if RTC_METRICS_ENABLED
+namespace webrtc {
+namespace {
+
+constexpr int kSamplesPerThread = 1000000;
+constexpr char kCountsName[] = "WebRTC.PerfTest.Counts";
+constexpr char kEnumName[] = "WebRTC.PerfTest.Enumeration";
+
+// Adds samples to the same two histograms as every other thread, once all
+// threads have been started.
+class SampleAdder {
+ public:
+  explicit SampleAdder(rtc::Event* start) : start_(start) {}
+
+  static void Run(void* obj) { static_cast<SampleAdder*>(obj)->AddSamples(); }
+
+ private:
+  void AddSamples() {
+    start_->Wait(rtc::Event::kForever);
+    for (int i = 0; i < kSamplesPerThread; ++i) {
+      RTC_HISTOGRAM_COUNTS_10000(kCountsName, i % 100);
+      RTC_HISTOGRAM_ENUMERATION(kEnumName, i % 8, 10);
+    }
+  }
+
+  rtc::Event* const start_;
+};
+
+void AddSamplesConcurrently(int num_threads) {
+  rtc::Event start(/*manual_reset=*/true, /*initially_signaled=*/false);
+  std::vector<std::unique_ptr<SampleAdder>> adders;
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (int i = 0; i < num_threads; ++i) {
+    adders.push_back(std::make_unique<SampleAdder>(&start));
+    threads.push_back(std::make_unique<rtc::PlatformThread>(
+        &SampleAdder::Run, adders.back().get(), "MetricsPerfTest"));
+    threads.back()->Start();
+  }
+
+  const int64_t start_ns = rtc::TimeNanos();
+  start.Set();
+  for (auto& thread : threads)
+    thread->Stop();
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+
+  // Two samples are added per iteration.
+  const int64_t num_samples = 2 * static_cast<int64_t>(kSamplesPerThread) *
+                              num_threads;
+  test::PrintResult("histogram_add_time_",
+                    std::to_string(num_threads) + "_threads", "metrics",
+                    static_cast<double>(elapsed_ns) / num_samples, "ns", false,
+                    test::ImproveDirection::kSmallerIsBetter);
+  EXPECT_EQ(kSamplesPerThread * num_threads,
+            metrics::NumSamples(kCountsName));
+  EXPECT_EQ(kSamplesPerThread * num_threads, metrics::NumSamples(kEnumName));
+}
+
+}  // namespace
+
+TEST(MetricsPerformanceTest, AddSamplesFromContendingThreads) {
+  metrics::Enable();
+  for (int num_threads : {1, 2, 4, 8}) {
+    metrics::Reset();
+    AddSamplesConcurrently(num_threads);
+  }
+}
+
+}  // namespace webrtc
+#endif  // RTC_METRICS_ENABLED
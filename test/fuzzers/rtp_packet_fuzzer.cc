@@ -79,6 +79,10 @@ void FuzzOneInput(const uint8_t* data, size_t size) {
         uint32_t sendtime;
         packet.GetExtension<AbsoluteSendTime>(&sendtime);
         break;
+      case kRtpExtensionTransportSendTime:
+        int64_t transport_send_time;
+        packet.GetExtension<TransportSendTime>(&transport_send_time);
+        break;
       case kRtpExtensionAbsoluteCaptureTime: {
         AbsoluteCaptureTime extension;
         packet.GetExtension<AbsoluteCaptureTimeExtension>(&extension);
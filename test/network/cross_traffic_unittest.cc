@@ -17,7 +17,9 @@
 
 #include "absl/memory/memory.h"
 #include "api/test/simulated_network.h"
+#include "call/link_capacity_trace.h"
 #include "call/simulated_network.h"
+#include "call/trace_based_network.h"
 #include "rtc_base/event.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/network_constants.h"
@@ -151,5 +153,30 @@ TEST(TcpMessageRouteTest, DeliveredOnLossyNetwork) {
   EXPECT_EQ(deliver_count, 1);
 }
 
+TEST(TcpMessageRouteTest, DeliveredOverTraceBasedLink) {
+  NetworkEmulationManagerImpl net(TimeMode::kSimulated);
+  // The link carries 800 kbps for 500 ms out of every second, so at most
+  // 50 kB can get through in the first second.
+  LinkCapacityTrace trace = LinkCapacityTrace::Outage(
+      DataRate::KilobitsPerSec(800), TimeDelta::Millis(500),
+      TimeDelta::Millis(500));
+  auto send = std::make_unique<TraceBasedNetwork>(
+      trace, BuiltInNetworkBehaviorConfig());
+  BuiltInNetworkBehaviorConfig ret;
+  ret.queue_delay_ms = 10;
+
+  auto* tcp_route = net.CreateTcpRoute(
+      net.CreateRoute({net.CreateEmulatedNode(std::move(send))}),
+      net.CreateRoute({net.CreateEmulatedNode(ret)}));
+  int deliver_count = 0;
+  constexpr size_t kMessageSize = 100000;
+  tcp_route->SendMessage(kMessageSize, [&] { deliver_count++; });
+
+  net.time_controller()->AdvanceTime(TimeDelta::Seconds(1));
+  ASSERT_EQ(deliver_count, 0);
+  net.time_controller()->AdvanceTime(TimeDelta::Seconds(60));
+  EXPECT_EQ(deliver_count, 1);
+}
+
 }  // namespace test
 }  // namespace webrtc
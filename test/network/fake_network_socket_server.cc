@@ -62,6 +62,7 @@ class FakeNetworkSocket : public rtc::AsyncSocket,
   ConnState GetState() const override;
   int GetOption(Option opt, int* value) override;
   int SetOption(Option opt, int value) override;
+  rtc::EcnMarking GetLastReceivedEcn() const override;
 
  private:
   FakeNetworkSocketServer* const socket_server_;
@@ -72,6 +73,8 @@ class FakeNetworkSocket : public rtc::AsyncSocket,
   ConnState state_ RTC_GUARDED_BY(&thread_);
   int error_ RTC_GUARDED_BY(&thread_);
   std::map<Option, int> options_map_ RTC_GUARDED_BY(&thread_);
+  rtc::EcnMarking last_received_ecn_ RTC_GUARDED_BY(&thread_) =
+      rtc::EcnMarking::kNotEct;
 
   absl::optional<EmulatedIpPacket> pending_ RTC_GUARDED_BY(thread_);
   rtc::AsyncInvoker invoker_;
@@ -170,7 +173,11 @@ int FakeNetworkSocket::SendTo(const void* pv,
     return -1;
   }
   rtc::CopyOnWriteBuffer packet(static_cast<const uint8_t*>(pv), cb);
-  endpoint_->SendPacket(local_addr_, addr, packet);
+  auto ecn = options_map_.find(OPT_SEND_ECN);
+  endpoint_->SendPacket(local_addr_, addr, packet, /*application_overhead=*/0,
+                        ecn == options_map_.end()
+                            ? rtc::EcnMarking::kNotEct
+                            : static_cast<rtc::EcnMarking>(ecn->second & 0x3));
   return cb;
 }
 
@@ -196,6 +203,10 @@ int FakeNetworkSocket::RecvFrom(void* pv,
   size_t data_read = std::min(cb, pending_->size());
   memcpy(pv, pending_->cdata(), data_read);
   *timestamp = pending_->arrival_time.us();
+  auto recv_ecn = options_map_.find(OPT_RECV_ECN);
+  last_received_ecn_ = recv_ecn != options_map_.end() && recv_ecn->second
+                           ? pending_->ecn
+                           : rtc::EcnMarking::kNotEct;
 
   // According to RECV(2) Linux Man page
   // real socket will discard data, that won't fit into provided buffer,
@@ -213,6 +224,11 @@ int FakeNetworkSocket::RecvFrom(void* pv,
   return static_cast<int>(data_read);
 }
 
+rtc::EcnMarking FakeNetworkSocket::GetLastReceivedEcn() const {
+  RTC_DCHECK_RUN_ON(thread_);
+  return last_received_ecn_;
+}
+
 int FakeNetworkSocket::Listen(int backlog) {
   RTC_CHECK(false) << "Listen() isn't valid for SOCK_DGRAM";
 }
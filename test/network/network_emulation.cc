@@ -25,8 +25,9 @@ void LinkEmulation::OnPacketReceived(EmulatedIpPacket packet) {
     RTC_DCHECK_RUN_ON(task_queue_);
 
     uint64_t packet_id = next_packet_id_++;
-    bool sent = network_behavior_->EnqueuePacket(PacketInFlightInfo(
-        packet.ip_packet_size(), packet.arrival_time.us(), packet_id));
+    bool sent = network_behavior_->EnqueuePacket(
+        PacketInFlightInfo(packet.ip_packet_size(), packet.arrival_time.us(),
+                           packet_id, packet.ecn));
     if (sent) {
       packets_.emplace_back(StoredPacket{packet_id, std::move(packet), false});
     }
@@ -75,6 +76,7 @@ void LinkEmulation::Process(Timestamp at_time) {
     if (delivery_info.receive_time_us != PacketDeliveryInfo::kNotReceived) {
       packet->packet.arrival_time =
           Timestamp::Micros(delivery_info.receive_time_us);
+      packet->packet.ecn = delivery_info.ecn;
       receiver_->OnPacketReceived(std::move(packet->packet));
     }
     while (!packets_.empty() && packets_.front().removed) {
@@ -206,10 +208,16 @@ uint64_t EmulatedEndpointImpl::GetId() const {
 void EmulatedEndpointImpl::SendPacket(const rtc::SocketAddress& from,
                                       const rtc::SocketAddress& to,
                                       rtc::CopyOnWriteBuffer packet_data,
-                                      uint16_t application_overhead) {
+                                      uint16_t application_overhead,
+                                      rtc::EcnMarking ecn) {
   RTC_CHECK(from.ipaddr() == peer_local_addr_);
   EmulatedIpPacket packet(from, to, std::move(packet_data),
                           clock_->CurrentTime(), application_overhead);
+  packet.ecn = ecn;
+  if (rtc::PcapWriter* capture = packet_capture_.load()) {
+    capture->WritePacket(from, to, packet.cdata(), packet.size(),
+                         packet.arrival_time.us());
+  }
   task_queue_->PostTask([this, packet = std::move(packet)]() mutable {
     RTC_DCHECK_RUN_ON(task_queue_);
     Timestamp current_time = clock_->CurrentTime();
@@ -281,6 +289,10 @@ void EmulatedEndpointImpl::OnPacketReceived(EmulatedIpPacket packet) {
       << "Routing error: wrong destination endpoint. Packet.to.ipaddr()=: "
       << packet.to.ipaddr().ToString()
       << "; Receiver peer_local_addr_=" << peer_local_addr_.ToString();
+  if (rtc::PcapWriter* capture = packet_capture_.load()) {
+    capture->WritePacket(packet.from, packet.to, packet.cdata(), packet.size(),
+                         clock_->CurrentTime().us());
+  }
   rtc::CritScope crit(&receiver_lock_);
   UpdateReceiveStats(packet);
   auto it = port_to_receiver_.find(packet.to.port());
@@ -300,6 +312,10 @@ void EmulatedEndpointImpl::OnPacketReceived(EmulatedIpPacket packet) {
   it->second->OnPacketReceived(std::move(packet));
 }
 
+void EmulatedEndpointImpl::SetPacketCapture(rtc::PcapWriter* capture) {
+  packet_capture_ = capture;
+}
+
 void EmulatedEndpointImpl::Enable() {
   RTC_DCHECK_RUN_ON(&enabled_state_checker_);
   RTC_CHECK(!is_enabled_);
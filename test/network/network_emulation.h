@@ -11,6 +11,7 @@
 #ifndef TEST_NETWORK_NETWORK_EMULATION_H_
 #define TEST_NETWORK_NETWORK_EMULATION_H_
 
+#include <atomic>
 #include <cstdint>
 #include <deque>
 #include <map>
@@ -26,6 +27,7 @@
 #include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/network.h"
 #include "rtc_base/network_constants.h"
+#include "rtc_base/pcap_writer.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/task_queue_for_test.h"
 #include "rtc_base/task_utils/repeating_task.h"
@@ -143,7 +145,8 @@ class EmulatedEndpointImpl : public EmulatedEndpoint {
   void SendPacket(const rtc::SocketAddress& from,
                   const rtc::SocketAddress& to,
                   rtc::CopyOnWriteBuffer packet_data,
-                  uint16_t application_overhead = 0) override;
+                  uint16_t application_overhead = 0,
+                  rtc::EcnMarking ecn = rtc::EcnMarking::kNotEct) override;
 
   absl::optional<uint16_t> BindReceiver(
       uint16_t desired_port,
@@ -163,6 +166,10 @@ class EmulatedEndpointImpl : public EmulatedEndpoint {
 
   EmulatedNetworkStats stats() override;
 
+  // Captures the packets sent and received by this endpoint to |capture|, or
+  // stops capturing if null. |capture| must outlive its use by the endpoint.
+  void SetPacketCapture(rtc::PcapWriter* capture);
+
  private:
   static constexpr uint16_t kFirstEphemeralPort = 49152;
   uint16_t NextPort() RTC_EXCLUSIVE_LOCKS_REQUIRED(receiver_lock_);
@@ -186,6 +193,7 @@ class EmulatedEndpointImpl : public EmulatedEndpoint {
       RTC_GUARDED_BY(receiver_lock_);
 
   EmulatedNetworkStats stats_ RTC_GUARDED_BY(task_queue_);
+  std::atomic<rtc::PcapWriter*> packet_capture_{nullptr};
 };
 
 class EmulatedRoute {
@@ -35,6 +35,10 @@ absl::optional<std::string> CreateAdaptationString(
 #if WEBRTC_ENABLE_PROTOBUF
 
   audio_network_adaptor::config::ControllerManager cont_conf;
+  if (config.alpha_cc) {
+    cont_conf.add_controllers()->mutable_alpha_cc_controller();
+    return cont_conf.SerializeAsString();
+  }
   if (config.frame.max_rate_for_60_ms.IsFinite()) {
     auto controller =
         cont_conf.add_controllers()->mutable_frame_length_controller();
@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "test/field_trial.h"
+#include "test/gtest.h"
+#include "test/scenario/scenario.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+enum class Adaptation { kNone, kDefault, kAlphaCc };
+
+// Runs audio next to video over a link whose capacity collapses, with some
+// loss while it's collapsed, and returns the share of the received audio that
+// was concealed.
+double ConcealmentRateDuringRateCollapse(Adaptation adaptation) {
+  Scenario s;
+  CallClientConfig call_client_config;
+  call_client_config.transport.rates.start_rate = DataRate::KilobitsPerSec(300);
+  auto* caller = s.CreateClient("caller", call_client_config);
+  auto* callee = s.CreateClient("callee", call_client_config);
+  NetworkSimulationConfig network_config;
+  network_config.bandwidth = DataRate::KilobitsPerSec(1500);
+  network_config.delay = TimeDelta::Millis(50);
+  network_config.packet_queue_length_limit = 100;
+  auto* send_net = s.CreateSimulationNode(network_config);
+  auto route = s.CreateRoutes(caller, {send_net}, callee,
+                              {s.CreateSimulationNode(network_config)});
+
+  s.CreateVideoStream(route->forward(), VideoStreamConfig());
+  AudioStreamPair* audio =
+      s.CreateAudioStream(route->forward(), [&](AudioStreamConfig* c) {
+        c->encoder.min_rate = DataRate::KilobitsPerSec(6);
+        c->encoder.max_rate = DataRate::KilobitsPerSec(64);
+        c->encoder.allocate_bitrate = true;
+        c->stream.in_bandwidth_estimation = true;
+        c->network_adaptation = adaptation != Adaptation::kNone;
+        c->adapt.alpha_cc = adaptation == Adaptation::kAlphaCc;
+      });
+
+  s.RunFor(TimeDelta::Seconds(10));
+  send_net->UpdateConfig([](NetworkSimulationConfig* c) {
+    c->bandwidth = DataRate::KilobitsPerSec(150);
+    c->loss_rate = 0.05;
+  });
+  s.RunFor(TimeDelta::Seconds(15));
+  send_net->UpdateConfig([](NetworkSimulationConfig* c) {
+    c->bandwidth = DataRate::KilobitsPerSec(1500);
+    c->loss_rate = 0;
+  });
+  s.RunFor(TimeDelta::Seconds(10));
+
+  AudioReceiveStream::Stats stats = audio->receive()->GetStats();
+  EXPECT_GT(stats.total_samples_received, 0u);
+  return static_cast<double>(stats.concealed_samples) /
+         std::max<uint64_t>(stats.total_samples_received, 1);
+}
+}  // namespace
+
+TEST(AudioStreamTest, ReportsConcealmentRateDuringRateCollapse) {
+  // The bitrate controller of the default adaptation expects the overhead to
+  // be included in the audio target.
+  ScopedFieldTrials trial("WebRTC-SendSideBwe-WithOverhead/Enabled/");
+  const std::pair<Adaptation, std::string> kAdaptations[] = {
+      {Adaptation::kNone, "no_adaptation"},
+      {Adaptation::kDefault, "default_adaptation"},
+      {Adaptation::kAlphaCc, "alpha_cc_adaptation"}};
+  for (const auto& adaptation : kAdaptations) {
+    const double concealment_rate =
+        ConcealmentRateDuringRateCollapse(adaptation.first);
+    webrtc::test::PrintResult("audio_concealment_rate", "_rate_collapse",
+                              adaptation.second, 100 * concealment_rate, "%",
+                              false,
+                              webrtc::test::ImproveDirection::kSmallerIsBetter);
+  }
+}
+
+}  // namespace test
+}  // namespace webrtc
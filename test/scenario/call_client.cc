@@ -268,6 +268,11 @@ void CallClient::OnPacketReceived(EmulatedIpPacket packet) {
     auto ssrc = RtpHeaderParser::GetSsrc(packet.cdata(), packet.data.size());
     RTC_CHECK(ssrc.has_value());
     media_type = ssrc_media_types_[*ssrc];
+    RTPHeader header;
+    if (rtp_receive_observer_ &&
+        header_parser_->Parse(packet.cdata(), packet.data.size(), &header)) {
+      rtp_receive_observer_(header, packet.arrival_time);
+    }
   }
   task_queue_.PostTask(
       [call = call_.get(), media_type, packet = std::move(packet)]() mutable {
@@ -276,6 +281,11 @@ void CallClient::OnPacketReceived(EmulatedIpPacket packet) {
       });
 }
 
+void CallClient::SetRtpReceiveObserver(
+    std::function<void(const RTPHeader&, Timestamp)> observer) {
+  rtp_receive_observer_ = std::move(observer);
+}
+
 std::unique_ptr<RtcEventLogOutput> CallClient::GetLogWriter(std::string name) {
   if (!log_writer_factory_ || name.empty())
     return nullptr;
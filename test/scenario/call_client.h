@@ -10,6 +10,7 @@
 #ifndef TEST_SCENARIO_CALL_CLIENT_H_
 #define TEST_SCENARIO_CALL_CLIENT_H_
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -113,6 +114,12 @@ class CallClient : public EmulatedNetworkReceiverInterface {
   void OnPacketReceived(EmulatedIpPacket packet) override;
   std::unique_ptr<RtcEventLogOutput> GetLogWriter(std::string name);
 
+  // Called with the header and arrival time of each received RTP packet,
+  // before it's delivered to the call. The header is parsed with the
+  // extensions of the receive streams.
+  void SetRtpReceiveObserver(
+      std::function<void(const RTPHeader&, Timestamp)> observer);
+
   // Exposed publicly so that tests can execute tasks such as querying stats
   // for media streams in the expected runtime environment (essentially what
   // CallClient does internally for GetStats()).
@@ -154,6 +161,7 @@ class CallClient : public EmulatedNetworkReceiverInterface {
   int next_audio_ssrc_index_ = 0;
   int next_audio_local_ssrc_index_ = 0;
   std::map<uint32_t, MediaType> ssrc_media_types_;
+  std::function<void(const RTPHeader&, Timestamp)> rtp_receive_observer_;
   // Defined last so it's destroyed first.
   TaskQueueForTest task_queue_;
 
@@ -155,6 +155,7 @@ struct VideoStreamConfig {
     Stream(const Stream&);
     ~Stream();
     bool abs_send_time = false;
+    bool transport_send_time = false;
     bool packet_feedback = true;
     bool use_rtx = true;
     DataRate pad_to_rate = DataRate::Zero();
@@ -190,6 +191,9 @@ struct AudioStreamConfig {
       DataRate min_rate_for_60_ms = DataRate::Zero();
       DataRate max_rate_for_120_ms = DataRate::Infinity();
     } frame;
+    // Adapts frame length, FEC and bitrate to the network estimate with the
+    // AlphaCC controller instead of using the settings in |frame|.
+    bool alpha_cc = false;
     std::string binary_proto;
   } adapt;
   struct Encoder {
@@ -11,6 +11,7 @@
 
 #include <atomic>
 
+#include "rtc_base/numerics/sample_stats.h"
 #include "test/gtest.h"
 #include "test/logging/memory_log_writer.h"
 #include "test/scenario/stats_collection.h"
@@ -60,6 +61,53 @@ TEST(ScenarioTest, StartsAndStopsWithoutErrors) {
   EXPECT_TRUE(packet_received);
   EXPECT_TRUE(bitrate_changed);
 }
+TEST(ScenarioTest, TransportSendTimeGivesMoreAccurateDelayVariation) {
+  Scenario s;
+  CallClientConfig call_client_config;
+  auto* alice = s.CreateClient("alice", call_client_config);
+  auto* bob = s.CreateClient("bob", call_client_config);
+  NetworkSimulationConfig network_config;
+  network_config.delay = TimeDelta::Millis(50);
+  auto route =
+      s.CreateRoutes(alice, {s.CreateSimulationNode(network_config)}, bob,
+                     {s.CreateSimulationNode(NetworkSimulationConfig())});
+
+  VideoStreamConfig video_stream_config;
+  video_stream_config.stream.abs_send_time = true;
+  video_stream_config.stream.transport_send_time = true;
+  s.CreateVideoStream(route->forward(), video_stream_config);
+
+  // The one-way delay is constant, so any spread in the measured delay is
+  // error in the send time.
+  SampleStats<double> abs_send_time_delay_us;
+  SampleStats<double> transport_send_time_delay_us;
+  bob->SetRtpReceiveObserver([&](const RTPHeader& header,
+                                 Timestamp arrival_time) {
+    if (!header.extension.hasAbsoluteSendTime ||
+        !header.extension.transport_send_time_us) {
+      return;
+    }
+    const int64_t abs_send_time_us =
+        header.extension.GetAbsoluteSendTimestamp().us();
+    const int64_t transport_send_time_us =
+        *header.extension.transport_send_time_us;
+    // Both are from the sender's clock, but abs-send-time wraps every 64 s.
+    const int64_t kCycleUs = int64_t{64} * 1000000;
+    const int64_t offset_us =
+        transport_send_time_us - transport_send_time_us % kCycleUs;
+    abs_send_time_delay_us.AddSample(arrival_time.us() - offset_us -
+                                     abs_send_time_us);
+    transport_send_time_delay_us.AddSample(arrival_time.us() -
+                                           transport_send_time_us);
+  });
+  s.RunFor(TimeDelta::Seconds(5));
+
+  ASSERT_GT(transport_send_time_delay_us.Count(), 100);
+  EXPECT_NEAR(transport_send_time_delay_us.Mean(), 50000, 1000);
+  EXPECT_LT(transport_send_time_delay_us.StandardDeviation(),
+            abs_send_time_delay_us.StandardDeviation());
+}
+
 namespace {
 void SetupVideoCall(Scenario& s, VideoQualityAnalyzer* analyzer) {
   CallClientConfig call_config;
@@ -35,6 +35,7 @@ enum : int {  // The first valid value is 1.
   kAbsSendTimeExtensionId,
   kVideoContentTypeExtensionId,
   kVideoRotationRtpExtensionId,
+  kTransportSendTimeExtensionId,
 };
 
 constexpr int kDefaultMaxQp = cricket::WebRtcVideoChannel::kDefaultQpMax;
@@ -105,6 +106,10 @@ std::vector<RtpExtension> GetVideoRtpExtensions(
     res.push_back(
         RtpExtension(RtpExtension::kAbsSendTimeUri, kAbsSendTimeExtensionId));
   }
+  if (config.stream.transport_send_time) {
+    res.push_back(RtpExtension(RtpExtension::kTransportSendTimeUri,
+                               kTransportSendTimeExtensionId));
+  }
   return res;
 }
 
@@ -537,6 +542,7 @@ ReceiveVideoStream::ReceiveVideoStream(CallClient* receiver,
                                        Transport* feedback_transport,
                                        VideoFrameMatcher* matcher)
     : receiver_(receiver), config_(config) {
+  receiver_->AddExtensions(GetVideoRtpExtensions(config));
   if (config.encoder.codec ==
           VideoStreamConfig::Encoder::Codec::kVideoCodecGeneric ||
       config.encoder.implementation == VideoStreamConfig::Encoder::kFake) {
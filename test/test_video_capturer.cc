@@ -14,6 +14,7 @@
 
 #include "api/scoped_refptr.h"
 #include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
 #include "api/video/video_frame_buffer.h"
 #include "api/video/video_rotation.h"
 
@@ -39,10 +40,20 @@ void TestVideoCapturer::OnFrame(const VideoFrame& original_frame) {
   if (out_height != frame.height() || out_width != frame.width()) {
     // Video adapter has requested a down-scale. Allocate a new buffer and
     // return scaled version.
-    // For simplicity, only scale here without cropping.
-    rtc::scoped_refptr<I420Buffer> scaled_buffer =
-        I420Buffer::Create(out_width, out_height);
-    scaled_buffer->ScaleFrom(*frame.video_frame_buffer()->ToI420());
+    // For simplicity, only scale here without cropping. NV12 frames are
+    // scaled as NV12 to avoid a conversion to I420 before the encoder.
+    rtc::scoped_refptr<VideoFrameBuffer> scaled_buffer;
+    if (frame.video_frame_buffer()->type() == VideoFrameBuffer::Type::kNV12) {
+      rtc::scoped_refptr<NV12Buffer> nv12_buffer =
+          NV12Buffer::Create(out_width, out_height);
+      nv12_buffer->ScaleFrom(*frame.video_frame_buffer()->GetNV12());
+      scaled_buffer = nv12_buffer;
+    } else {
+      rtc::scoped_refptr<I420Buffer> i420_buffer =
+          I420Buffer::Create(out_width, out_height);
+      i420_buffer->ScaleFrom(*frame.video_frame_buffer()->ToI420());
+      scaled_buffer = i420_buffer;
+    }
     VideoFrame::Builder new_frame_builder =
         VideoFrame::Builder()
             .set_video_frame_buffer(scaled_buffer)
@@ -21,6 +21,7 @@
 #include "absl/types/optional.h"
 #include "api/video/encoded_image.h"
 #include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
 #include "api/video/video_adaptation_reason.h"
 #include "api/video/video_bitrate_allocator_factory.h"
 #include "api/video/video_codec_constants.h"
@@ -1229,7 +1230,8 @@ void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
   const bool is_buffer_type_supported =
       buffer_type == VideoFrameBuffer::Type::kI420 ||
       (buffer_type == VideoFrameBuffer::Type::kNative &&
-       info.supports_native_handle);
+       info.supports_native_handle) ||
+      absl::c_linear_search(info.preferred_pixel_formats, buffer_type);
 
   if (!is_buffer_type_supported) {
     // This module only supports software encoding.
@@ -1259,36 +1261,51 @@ void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
   if ((crop_width_ > 0 || crop_height_ > 0) &&
       out_frame.video_frame_buffer()->type() !=
           VideoFrameBuffer::Type::kNative) {
-    // If the frame can't be converted to I420, drop it.
-    auto i420_buffer = video_frame.video_frame_buffer()->ToI420();
-    if (!i420_buffer) {
-      RTC_LOG(LS_ERROR) << "Frame conversion for crop failed, dropping frame.";
-      return;
-    }
-    int cropped_width = video_frame.width() - crop_width_;
-    int cropped_height = video_frame.height() - crop_height_;
-    rtc::scoped_refptr<I420Buffer> cropped_buffer =
-        I420Buffer::Create(cropped_width, cropped_height);
+    const int cropped_width = video_frame.width() - crop_width_;
+    const int cropped_height = video_frame.height() - crop_height_;
     // TODO(ilnik): Remove scaling if cropping is too big, as it should never
     // happen after SinkWants signaled correctly from ReconfigureEncoder.
+    const bool crop_only = crop_width_ < 4 && crop_height_ < 4;
+    const int offset_x = crop_only ? crop_width_ / 2 : 0;
+    const int offset_y = crop_only ? crop_height_ / 2 : 0;
+    const int crop_width = crop_only ? cropped_width : video_frame.width();
+    const int crop_height = crop_only ? cropped_height : video_frame.height();
+    rtc::scoped_refptr<VideoFrameBuffer> cropped_buffer;
+    if (crop_only && out_frame.video_frame_buffer()->type() ==
+                         VideoFrameBuffer::Type::kNV12) {
+      // The encoder takes NV12, so crop without converting to I420. Scaling
+      // is done in I420 below, since it is slower on the interleaved UV
+      // plane.
+      rtc::scoped_refptr<NV12Buffer> nv12_buffer =
+          NV12Buffer::Create(cropped_width, cropped_height);
+      nv12_buffer->CropAndScaleFrom(*out_frame.video_frame_buffer()->GetNV12(),
+                                    offset_x, offset_y, crop_width,
+                                    crop_height);
+      cropped_buffer = nv12_buffer;
+    } else {
+      // If the frame can't be converted to I420, drop it.
+      auto i420_buffer = out_frame.video_frame_buffer()->ToI420();
+      if (!i420_buffer) {
+        RTC_LOG(LS_ERROR)
+            << "Frame conversion for crop failed, dropping frame.";
+        return;
+      }
+      rtc::scoped_refptr<I420Buffer> i420_cropped_buffer =
+          I420Buffer::Create(cropped_width, cropped_height);
+      i420_cropped_buffer->CropAndScaleFrom(*i420_buffer, offset_x, offset_y,
+                                            crop_width, crop_height);
+      cropped_buffer = i420_cropped_buffer;
+    }
     VideoFrame::UpdateRect update_rect = video_frame.update_rect();
-    if (crop_width_ < 4 && crop_height_ < 4) {
-      cropped_buffer->CropAndScaleFrom(*i420_buffer, crop_width_ / 2,
-                                       crop_height_ / 2, cropped_width,
-                                       cropped_height);
-      update_rect.offset_x -= crop_width_ / 2;
-      update_rect.offset_y -= crop_height_ / 2;
+    if (crop_only) {
+      update_rect.offset_x -= offset_x;
+      update_rect.offset_y -= offset_y;
       update_rect.Intersect(
           VideoFrame::UpdateRect{0, 0, cropped_width, cropped_height});
-
-    } else {
-      cropped_buffer->ScaleFrom(*i420_buffer);
-      if (!update_rect.IsEmpty()) {
-        // Since we can't reason about pixels after scaling, we invalidate whole
-        // picture, if anything changed.
-        update_rect =
-            VideoFrame::UpdateRect{0, 0, cropped_width, cropped_height};
-      }
+    } else if (!update_rect.IsEmpty()) {
+      // Since we can't reason about pixels after scaling, we invalidate whole
+      // picture, if anything changed.
+      update_rect = VideoFrame::UpdateRect{0, 0, cropped_width, cropped_height};
     }
     out_frame.set_video_frame_buffer(cropped_buffer);
     out_frame.set_update_rect(update_rect);
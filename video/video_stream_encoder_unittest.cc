@@ -21,6 +21,7 @@
 #include "api/test/mock_video_encoder.h"
 #include "api/video/builtin_video_bitrate_allocator_factory.h"
 #include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
 #include "api/video/video_adaptation_reason.h"
 #include "api/video/video_bitrate_allocation.h"
 #include "api/video_codecs/video_encoder.h"
@@ -392,6 +393,18 @@ class CroppingVideoStreamFactory
   const int framerate_;
 };
 
+// Creates streams of half the input size, so that frames are scaled.
+class HalfSizeVideoStreamFactory
+    : public VideoEncoderConfig::VideoStreamFactoryInterface {
+ private:
+  std::vector<VideoStream> CreateEncoderStreams(
+      int width,
+      int height,
+      const VideoEncoderConfig& encoder_config) override {
+    return test::CreateVideoStreams(width / 2, height / 2, encoder_config);
+  }
+};
+
 class AdaptingFrameForwarder : public test::FrameForwarder {
  public:
   AdaptingFrameForwarder() : adaptation_enabled_(false) {}
@@ -651,6 +664,19 @@ class VideoStreamEncoderTest : public ::testing::Test {
     return frame;
   }
 
+  VideoFrame CreateNV12Frame(int64_t ntp_time_ms, int width, int height) const {
+    rtc::scoped_refptr<NV12Buffer> buffer = NV12Buffer::Create(width, height);
+    buffer->InitializeData();
+    VideoFrame frame = VideoFrame::Builder()
+                           .set_video_frame_buffer(buffer)
+                           .set_timestamp_rtp(99)
+                           .set_timestamp_ms(99)
+                           .set_rotation(kVideoRotation_0)
+                           .build();
+    frame.set_ntp_time_ms(ntp_time_ms);
+    return frame;
+  }
+
   VideoFrame CreateFakeNativeFrame(int64_t ntp_time_ms,
                                    rtc::Event* destruction_event,
                                    int width,
@@ -849,6 +875,7 @@ class VideoStreamEncoderTest : public ::testing::Test {
 
       info.resolution_bitrate_limits = resolution_bitrate_limits_;
       info.requested_resolution_alignment = requested_resolution_alignment_;
+      info.preferred_pixel_formats = preferred_pixel_formats_;
       return info;
     }
 
@@ -883,6 +910,18 @@ class VideoStreamEncoderTest : public ::testing::Test {
       is_hardware_accelerated_ = is_hardware_accelerated;
     }
 
+    void SetPreferredPixelFormats(
+        absl::InlinedVector<VideoFrameBuffer::Type, kMaxPreferredPixelFormats>
+            pixel_formats) {
+      rtc::CritScope lock(&local_crit_sect_);
+      preferred_pixel_formats_ = std::move(pixel_formats);
+    }
+
+    absl::optional<VideoFrameBuffer::Type> GetLastInputBufferType() const {
+      rtc::CritScope lock(&local_crit_sect_);
+      return last_input_buffer_type_;
+    }
+
     void SetTemporalLayersSupported(size_t spatial_idx, bool supported) {
       RTC_DCHECK_LT(spatial_idx, kMaxSpatialLayers);
       rtc::CritScope lock(&local_crit_sect_);
@@ -987,6 +1026,7 @@ class VideoStreamEncoderTest : public ::testing::Test {
         ntp_time_ms_ = input_image.ntp_time_ms();
         last_input_width_ = input_image.width();
         last_input_height_ = input_image.height();
+        last_input_buffer_type_ = input_image.video_frame_buffer()->type();
         block_encode = block_next_encode_;
         block_next_encode_ = false;
         last_update_rect_ = input_image.update_rect();
@@ -1067,6 +1107,11 @@ class VideoStreamEncoderTest : public ::testing::Test {
     bool quality_scaling_ RTC_GUARDED_BY(local_crit_sect_) = true;
     int requested_resolution_alignment_ RTC_GUARDED_BY(local_crit_sect_) = 1;
     bool is_hardware_accelerated_ RTC_GUARDED_BY(local_crit_sect_) = false;
+    absl::InlinedVector<VideoFrameBuffer::Type, kMaxPreferredPixelFormats>
+        preferred_pixel_formats_ RTC_GUARDED_BY(local_crit_sect_) = {
+            VideoFrameBuffer::Type::kI420};
+    absl::optional<VideoFrameBuffer::Type> last_input_buffer_type_
+        RTC_GUARDED_BY(local_crit_sect_);
     std::unique_ptr<Vp8FrameBufferController> frame_buffer_controller_
         RTC_GUARDED_BY(local_crit_sect_);
     absl::optional<bool>
@@ -1449,6 +1494,85 @@ TEST_F(VideoStreamEncoderTest, DropFrameWithFailedI420ConversionWithCrop) {
   video_stream_encoder_->Stop();
 }
 
+TEST_F(VideoStreamEncoderTest, ConvertsNV12FrameToI420ByDefault) {
+  video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
+      DataRate::BitsPerSec(kTargetBitrateBps),
+      DataRate::BitsPerSec(kTargetBitrateBps),
+      DataRate::BitsPerSec(kTargetBitrateBps), 0, 0, 0);
+
+  video_source_.IncomingCapturedFrame(
+      CreateNV12Frame(1, codec_width_, codec_height_));
+  WaitForEncodedFrame(1);
+  EXPECT_EQ(VideoFrameBuffer::Type::kI420,
+            fake_encoder_.GetLastInputBufferType());
+  video_stream_encoder_->Stop();
+}
+
+TEST_F(VideoStreamEncoderTest, PassesNV12FrameToEncoderPreferringNV12) {
+  fake_encoder_.SetPreferredPixelFormats(
+      {VideoFrameBuffer::Type::kNV12, VideoFrameBuffer::Type::kI420});
+  video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
+      DataRate::BitsPerSec(kTargetBitrateBps),
+      DataRate::BitsPerSec(kTargetBitrateBps),
+      DataRate::BitsPerSec(kTargetBitrateBps), 0, 0, 0);
+
+  video_source_.IncomingCapturedFrame(
+      CreateNV12Frame(1, codec_width_, codec_height_));
+  WaitForEncodedFrame(1);
+  EXPECT_EQ(VideoFrameBuffer::Type::kNV12,
+            fake_encoder_.GetLastInputBufferType());
+  video_stream_encoder_->Stop();
+}
+
+TEST_F(VideoStreamEncoderTest, CropsNV12FrameWithoutConversion) {
+  fake_encoder_.SetPreferredPixelFormats(
+      {VideoFrameBuffer::Type::kNV12, VideoFrameBuffer::Type::kI420});
+  // Use the cropping factory.
+  video_encoder_config_.video_stream_factory =
+      new rtc::RefCountedObject<CroppingVideoStreamFactory>(1, 30);
+  video_stream_encoder_->ConfigureEncoder(std::move(video_encoder_config_),
+                                          kMaxPayloadLength);
+  video_stream_encoder_->WaitUntilTaskQueueIsIdle();
+  video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
+      DataRate::BitsPerSec(kTargetBitrateBps),
+      DataRate::BitsPerSec(kTargetBitrateBps),
+      DataRate::BitsPerSec(kTargetBitrateBps), 0, 0, 0);
+
+  // The width and height aren't divisible by 4 (see CreateEncoderStreams
+  // above), so the frame needs to be cropped.
+  video_source_.IncomingCapturedFrame(
+      CreateNV12Frame(1, codec_width_ + 1, codec_height_ + 1));
+  WaitForEncodedFrame(1);
+  EXPECT_EQ(VideoFrameBuffer::Type::kNV12,
+            fake_encoder_.GetLastInputBufferType());
+  EXPECT_EQ(codec_width_, fake_encoder_.codec_config().width);
+  EXPECT_EQ(codec_height_, fake_encoder_.codec_config().height);
+  video_stream_encoder_->Stop();
+}
+
+TEST_F(VideoStreamEncoderTest, ScalesNV12FrameInI420) {
+  fake_encoder_.SetPreferredPixelFormats(
+      {VideoFrameBuffer::Type::kNV12, VideoFrameBuffer::Type::kI420});
+  video_encoder_config_.video_stream_factory =
+      new rtc::RefCountedObject<HalfSizeVideoStreamFactory>();
+  video_stream_encoder_->ConfigureEncoder(std::move(video_encoder_config_),
+                                          kMaxPayloadLength);
+  video_stream_encoder_->WaitUntilTaskQueueIsIdle();
+  video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
+      DataRate::BitsPerSec(kTargetBitrateBps),
+      DataRate::BitsPerSec(kTargetBitrateBps),
+      DataRate::BitsPerSec(kTargetBitrateBps), 0, 0, 0);
+
+  video_source_.IncomingCapturedFrame(
+      CreateNV12Frame(1, codec_width_, codec_height_));
+  WaitForEncodedFrame(1);
+  EXPECT_EQ(VideoFrameBuffer::Type::kI420,
+            fake_encoder_.GetLastInputBufferType());
+  EXPECT_EQ(codec_width_ / 2, fake_encoder_.codec_config().width);
+  EXPECT_EQ(codec_height_ / 2, fake_encoder_.codec_config().height);
+  video_stream_encoder_->Stop();
+}
+
 TEST_F(VideoStreamEncoderTest, DropsFramesWhenCongestionWindowPushbackSet) {
   video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
       DataRate::BitsPerSec(kTargetBitrateBps),